@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+"""
+Pack a trained float MLP into the on-device model file (porkchop_model.bin).
+
+Train on the 32-feature vectors WARHOG exports, dump the weights as JSON,
+run this, and put the result on SPIFFS at /models/porkchop_model.bin (or
+push it through MLInference::updateModel). Weights go to int8 with one
+power-of-two scale per layer, biases to int32 (see src/ml/quant_model.h
+for the layout and arithmetic).
+
+JSON:
+    {
+      "version": "porkchop-1",                 # <= 15 chars
+      "input":  {"mean": [32 floats], "std": [32 floats]},
+      "layers": [
+        {"weights": [[in floats] x out], "bias": [out floats], "activation": "relu"},
+        ...
+        {"weights": ..., "bias": [5 floats], "activation": "softmax"}
+      ]
+    }
+
+Weights are [out][in]; transpose Keras Dense kernels ([in][out]) first.
+Classes follow MLLabel: normal, rogue_ap, evil_twin, deauth_target, vulnerable.
+
+Usage:
+    python scripts/build_ml_model.py model.json [porkchop_model.bin]
+"""
+
+import json
+import struct
+import sys
+import zlib
+from pathlib import Path
+
+FORMAT_VERSION = 1
+ACT_FRAC = 8           # Activations are Q7.8
+MAX_WIDTH = 64
+MAX_LAYERS = 8
+ACTIVATIONS = {"none": 0, "relu": 1, "softmax": 2}
+
+
+def weight_shift(weights):
+    peak = max((abs(w) for row in weights for w in row), default=0.0)
+    shift = 0
+    while shift < 15 and peak * (1 << (shift + 1)) <= 127.0:
+        shift += 1
+    return shift
+
+
+def pack_layer(layer, width, last):
+    weights, bias = layer["weights"], layer["bias"]
+    act = ACTIVATIONS[layer.get("activation", "none")]
+    out = len(weights)
+    if any(len(row) != width for row in weights) or len(bias) != out:
+        sys.exit(f"layer shapes don't chain ({width} in)")
+    if not 0 < out <= MAX_WIDTH:
+        sys.exit(f"layer too wide ({out} > {MAX_WIDTH})")
+    if (act == ACTIVATIONS["softmax"]) != last:
+        sys.exit("softmax must be the last layer, and only the last")
+
+    shift = weight_shift(weights)
+    data = struct.pack("<BBHHH", act, shift, width, out, 0)
+    q = bytes(max(-127, min(127, round(w * (1 << shift)))) & 0xFF for row in weights for w in row)
+    data += q + b"\0" * (-len(q) % 4)
+    bias_scale = 1 << (ACT_FRAC + shift)
+    data += struct.pack(f"<{out}i", *(max(-(1 << 30) + 1, min((1 << 30) - 1, round(b * bias_scale))) for b in bias))
+    return data, out
+
+
+def build(model):
+    mean, std = model["input"]["mean"], model["input"]["std"]
+    inputs = len(mean)
+    layers = model["layers"]
+    if len(std) != inputs or not 0 < inputs <= MAX_WIDTH:
+        sys.exit("input mean/std must be the same length, at most 64")
+    if not 0 < len(layers) <= MAX_LAYERS:
+        sys.exit(f"1 to {MAX_LAYERS} layers")
+
+    payload = b"".join(struct.pack("<ff", m, 1.0 / s if s else 0.0) for m, s in zip(mean, std))
+    width = inputs
+    for i, layer in enumerate(layers):
+        data, width = pack_layer(layer, width, i == len(layers) - 1)
+        payload += data
+
+    version = model.get("version", "custom").encode("ascii")[:15]
+    header = b"PKML" + bytes([FORMAT_VERSION, len(layers), inputs, width])
+    header += version + b"\0" * (16 - len(version))
+    header += struct.pack("<II", len(payload), zlib.crc32(payload) & 0xFFFFFFFF)
+    return header + payload
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__)
+        sys.exit(1)
+    src = Path(sys.argv[1])
+    dst = Path(sys.argv[2]) if len(sys.argv) > 2 else src.with_name("porkchop_model.bin")
+    blob = build(json.loads(src.read_text()))
+    dst.write_bytes(blob)
+    print(f"{dst}: {len(blob)} bytes")
+
+
+if __name__ == "__main__":
+    main()
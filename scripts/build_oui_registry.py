@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+"""
+Build the SD card vendor database (oui.bin) from the IEEE OUI registry.
+
+Download https://standards-oui.ieee.org/oui/oui.csv, run this, and copy
+the result to the root of the card. On boot the piglet finds /oui.bin and
+names devices the built-in table doesn't know (see src/core/oui_registry.h
+for the layout).
+
+Usage:
+    python scripts/build_oui_registry.py oui.csv [oui.bin]
+"""
+
+import csv
+import struct
+import sys
+from pathlib import Path
+
+RECORD = 32
+NAME_LEN = 28          # Record is prefix[3] + name[29]
+MAX_FENCES = 256       # OuiRegistry's default; 1KB of RAM on the device
+BLOCK = 512
+HEADER = 16
+
+
+def read_registry(path):
+    names = {}
+    with open(path, newline="", encoding="utf-8", errors="replace") as f:
+        for row in csv.DictReader(f):
+            assignment = (row.get("Assignment") or "").strip()
+            name = " ".join((row.get("Organization Name") or "").split())
+            if len(assignment) != 6 or not name:
+                continue
+            try:
+                prefix = int(assignment, 16)
+            except ValueError:
+                continue
+            names[prefix] = name
+    return sorted(names.items())
+
+
+def encode_name(name):
+    raw = name.encode("ascii", "replace")[:NAME_LEN]
+    return raw + b"\0" * (NAME_LEN + 1 - len(raw))
+
+
+def build(entries):
+    count = len(entries)
+    stride = max(1, -(-count // MAX_FENCES))
+    fences = [entries[i][0] for i in range(0, count, stride)]
+
+    out = bytearray(b"OUIR")
+    out += struct.pack("<BBHII", 1, RECORD, len(fences), count, stride)
+    for prefix in fences:
+        out += struct.pack("<I", prefix)
+    out += b"\0" * (-len(out) % BLOCK)
+    for prefix, name in entries:
+        out += prefix.to_bytes(3, "big") + encode_name(name)
+    return bytes(out), stride, len(fences)
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__)
+        sys.exit(1)
+    src = Path(sys.argv[1])
+    dst = Path(sys.argv[2]) if len(sys.argv) > 2 else src.with_name("oui.bin")
+    entries = read_registry(src)
+    if not entries:
+        sys.exit(f"no MA-L assignments in {src}")
+    data, stride, fences = build(entries)
+    dst.write_bytes(data)
+    print(f"{len(entries)} prefixes, {fences} fences every {stride} records, "
+          f"{len(data)} bytes -> {dst}")
+
+
+if __name__ == "__main__":
+    main()
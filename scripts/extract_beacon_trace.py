@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+"""
+Cut one AP's beacons out of a capture into a C fixture for the beacon
+timing tests (test/test_beacon_timing/beacon_trace.h).
+
+Each record is the receive time (u32 microseconds, little-endian, from the
+pcap timestamps) followed by the first 36 bytes of the beacon: 802.11
+header, TSF, beacon interval, capability. The expected statistics are
+worked out here the way BeaconTimingTracker does it (src/ml/beacon_timing.h),
+in double precision with a two-pass variance, so the test checks the
+tracker against an independent reference.
+
+Usage:
+    python scripts/extract_beacon_trace.py capture.pcap [--bssid aa:bb:..]
+        [--count 48] [--source "what the capture is"] [out.h]
+"""
+
+import argparse
+import math
+import struct
+import sys
+import textwrap
+from collections import Counter
+from pathlib import Path
+
+LINKTYPE_IEEE802_11 = 105
+LINKTYPE_RADIOTAP = 127
+HEAD = 36               # 802.11 header (24) + TSF (8) + interval (2) + capability (2)
+MAX_GAP_US = 10000000   # BeaconTimingTracker::MAX_GAP_US
+
+
+def read_beacons(path):
+    data = Path(path).read_bytes()
+    magic = struct.unpack_from("<I", data, 0)[0]
+    if magic == 0xA1B2C3D4:
+        endian, nano = "<", False
+    elif magic == 0xD4C3B2A1:
+        endian, nano = ">", False
+    elif magic == 0xA1B23C4D:
+        endian, nano = "<", True
+    else:
+        sys.exit("not a pcap file (pcapng: convert with editcap -F pcap)")
+    linktype = struct.unpack_from(endian + "I", data, 20)[0]
+    if linktype not in (LINKTYPE_IEEE802_11, LINKTYPE_RADIOTAP):
+        sys.exit("unsupported linktype %d (need 105 or 127)" % linktype)
+
+    off = 24
+    while off + 16 <= len(data):
+        sec, frac, incl, _ = struct.unpack_from(endian + "IIII", data, off)
+        off += 16
+        pkt = data[off:off + incl]
+        off += incl
+        if linktype == LINKTYPE_RADIOTAP:
+            if len(pkt) < 4:
+                continue
+            pkt = pkt[struct.unpack_from("<H", pkt, 2)[0]:]
+        if len(pkt) < HEAD or pkt[0] != 0x80:
+            continue
+        us = sec * 1000000 + (frac // 1000 if nano else frac)
+        yield us, pkt[:HEAD]
+
+
+def expected(trace):
+    """Residuals and drifts as BeaconTimingTracker computes them"""
+    residual, drift, resets = [], [], 0
+    last = None
+    for rx, head in trace:
+        tsf = struct.unpack_from("<Q", head, 24)[0]
+        interval_us = struct.unpack_from("<H", head, 32)[0] * 1024
+        if last:
+            tsf_delta = tsf - last[1]
+            rx_delta = (rx - last[0]) & 0xFFFFFFFF
+            if tsf <= last[1] or tsf_delta > MAX_GAP_US or rx_delta > MAX_GAP_US:
+                resets += 1
+            else:
+                k = (tsf_delta + interval_us // 2) // interval_us if interval_us else 1
+                if k:
+                    residual.append((tsf_delta - k * interval_us if interval_us else tsf_delta) / 1000.0)
+                    drift.append((rx_delta - tsf_delta) / 1000.0)
+        last = (rx, tsf)
+    return residual, drift, resets
+
+
+def mean_std(xs):
+    m = sum(xs) / len(xs)
+    v = sum((x - m) ** 2 for x in xs) / (len(xs) - 1) if len(xs) > 1 else 0.0
+    return m, math.sqrt(v)
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("pcap")
+    ap.add_argument("out", nargs="?", default="test/test_beacon_timing/beacon_trace.h")
+    ap.add_argument("--bssid", help="AP to keep (default: the one with the most beacons)")
+    ap.add_argument("--count", type=int, default=48)
+    ap.add_argument("--source", default="", help="Where the capture came from, for the header")
+    args = ap.parse_args()
+
+    beacons = list(read_beacons(args.pcap))
+    if not beacons:
+        sys.exit("no beacons in " + args.pcap)
+    if args.bssid:
+        bssid = bytes.fromhex(args.bssid.replace(":", ""))
+    else:
+        bssid = Counter(h[16:22] for _, h in beacons).most_common(1)[0][0]
+    trace = [(rx, h) for rx, h in beacons if h[16:22] == bssid][:args.count]
+    t0 = trace[0][0]
+    trace = [((rx - t0) & 0xFFFFFFFF, h) for rx, h in trace]
+
+    residual, drift, resets = expected(trace)
+    if len(residual) < 2:
+        sys.exit("fewer than two intervals for %s" % bssid.hex(":"))
+    rm, rs = mean_std(residual)
+    dm, ds = mean_std(drift)
+
+    lines = [
+        "// Beacon trace fixture - generated by scripts/extract_beacon_trace.py",
+        "// %d beacons from %s, %s" % (len(trace), bssid.hex(":"), Path(args.pcap).name),
+    ]
+    if args.source:
+        lines += ["// " + l for l in textwrap.wrap(args.source, 74)]
+    lines += [
+        "// Record: rx time (u32 us, LE) + the beacon's first 36 bytes",
+        "#pragma once",
+        "",
+        "#include <stddef.h>",
+        "#include <stdint.h>",
+        "",
+        "static const size_t BEACON_TRACE_RECORD = 40;",
+        "static const size_t BEACON_TRACE_COUNT = %d;" % len(trace),
+        "static const uint8_t BEACON_TRACE[] = {",
+    ]
+    for rx, head in trace:
+        rec = struct.pack("<I", rx) + head
+        for i in range(0, len(rec), 20):
+            lines.append("    " + " ".join("0x%02x," % b for b in rec[i:i + 20]))
+    lines += [
+        "};",
+        "",
+        "// What the tracker should report (ms)",
+        "static const uint32_t BEACON_TRACE_SAMPLES = %d;" % len(residual),
+        "static const uint32_t BEACON_TRACE_RESETS = %d;" % resets,
+        "static const float BEACON_TRACE_RESIDUAL_MEAN = %.6ff;" % rm,
+        "static const float BEACON_TRACE_RESIDUAL_STDDEV = %.6ff;" % rs,
+        "static const float BEACON_TRACE_DRIFT_MEAN = %.6ff;" % dm,
+        "static const float BEACON_TRACE_DRIFT_STDDEV = %.6ff;" % ds,
+        "",
+    ]
+    Path(args.out).write_text("\n".join(lines))
+    print("%s: %d beacons, %d samples, jitter %.4f ms" % (args.out, len(trace), len(residual), rs))
+
+
+if __name__ == "__main__":
+    main()
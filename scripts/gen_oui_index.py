@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+"""
+Generate the perfect-hash index for the built-in OUI table.
+
+Reads OUI_TABLE from src/core/oui_table.h and writes src/core/oui_index.h:
+a seed per bucket and a slot array, such that for every prefix k
+
+    slot = mix(k + seeds[bucket(k)] * 0x9E3779B9) & (SLOTS - 1)
+
+holds the index of k's entry (CHD: hash, bucket, displace). Run it after
+editing the table; the build's static_asserts catch a stale index.
+
+Usage:
+    python scripts/gen_oui_index.py
+"""
+
+import re
+import sys
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent.parent
+TABLE = ROOT / "src" / "core" / "oui_table.h"
+INDEX = ROOT / "src" / "core" / "oui_index.h"
+
+BUCKET_BITS = 7   # 128 buckets, ~3.5 prefixes each
+SLOT_BITS = 9     # 512 slots
+MAX_SEED = 0xFF    # Seeds are uint8_t
+NONE = 0xFFFF
+
+ENTRY = re.compile(r"\{\{0x([0-9A-Fa-f]{2}),\s*0x([0-9A-Fa-f]{2}),\s*0x([0-9A-Fa-f]{2})\},\s*\"")
+
+M32 = 0xFFFFFFFF
+
+
+def mix(h):
+    """murmur3 fmix32; must match OuiTable::mix"""
+    h ^= h >> 16
+    h = (h * 0x85EBCA6B) & M32
+    h ^= h >> 13
+    h = (h * 0xC2B2AE35) & M32
+    h ^= h >> 16
+    return h
+
+
+def bucket_of(k):
+    return mix(k) >> (32 - BUCKET_BITS)
+
+
+def slot_of(k, seed):
+    return mix((k + seed * 0x9E3779B9) & M32) & ((1 << SLOT_BITS) - 1)
+
+
+def read_keys():
+    keys = []
+    for m in ENTRY.finditer(TABLE.read_text()):
+        keys.append((int(m.group(1), 16) << 16) | (int(m.group(2), 16) << 8) | int(m.group(3), 16))
+    seen = {}
+    for i, k in enumerate(keys):
+        if k in seen:
+            sys.exit(f"duplicate prefix {k:06X} (entries {seen[k]} and {i})")
+        seen[k] = i
+    if len(keys) >= min(NONE, 1 << SLOT_BITS):
+        sys.exit(f"{len(keys)} entries don't fit {1 << SLOT_BITS} slots: raise SLOT_BITS")
+    return keys
+
+
+def build(keys):
+    buckets = [[] for _ in range(1 << BUCKET_BITS)]
+    for i, k in enumerate(keys):
+        buckets[bucket_of(k)].append(i)
+
+    seeds = [0] * (1 << BUCKET_BITS)
+    slots = [NONE] * (1 << SLOT_BITS)
+    # Biggest buckets first, while the slot array is still empty
+    for b in sorted(range(len(buckets)), key=lambda b: -len(buckets[b])):
+        members = buckets[b]
+        if not members:
+            continue
+        for seed in range(MAX_SEED + 1):
+            want = [slot_of(keys[i], seed) for i in members]
+            if len(set(want)) == len(want) and all(slots[s] == NONE for s in want):
+                break
+        else:
+            sys.exit(f"no seed for bucket {b}: raise SLOT_BITS")
+        seeds[b] = seed
+        for i, s in zip(members, want):
+            slots[s] = i
+    return seeds, slots
+
+
+def rows(values, per_line, digits):
+    out = []
+    for i in range(0, len(values), per_line):
+        out.append("    " + ", ".join(f"0x{v:0{digits}X}" for v in values[i:i + per_line]) + ",")
+    return "\n".join(out)
+
+
+def main():
+    keys = read_keys()
+    seeds, slots = build(keys)
+    INDEX.write_text(
+        "// OUI Index - perfect-hash seeds and slots for OUI_TABLE\n"
+        "// Generated by scripts/gen_oui_index.py from oui_table.h - do not edit.\n"
+        "#pragma once\n"
+        "\n"
+        "#include <stdint.h>\n"
+        "\n"
+        f"static constexpr uint16_t OUI_INDEX_ENTRIES = {len(keys)};\n"
+        f"static constexpr uint8_t OUI_BUCKET_BITS = {BUCKET_BITS};\n"
+        f"static constexpr uint8_t OUI_SLOT_BITS = {SLOT_BITS};\n"
+        "\n"
+        f"static constexpr uint8_t OUI_SEEDS[{len(seeds)}] = {{\n{rows(seeds, 12, 2)}\n}};\n"
+        "\n"
+        f"static constexpr uint16_t OUI_SLOTS[{len(slots)}] = {{\n{rows(slots, 8, 4)}\n}};\n"
+    )
+    print(f"{len(keys)} prefixes, {len(seeds)} buckets, {len(slots)} slots, max seed {max(seeds)}")
+
+
+if __name__ == "__main__":
+    main()
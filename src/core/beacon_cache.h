@@ -0,0 +1,219 @@
+// Beacon Cache - one stored beacon per BSSID, shared by reference by its captures
+// Referenced entries are never evicted, the rest go LRU. Main loop only.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct BeaconCacheStats {
+    uint16_t slots;       // Capacity
+    uint16_t entries;     // Slots in use (stored or reserved)
+    uint16_t stored;      // Entries holding a beacon
+    uint16_t pinned;      // Entries with refs > 0
+    uint32_t bytes;       // Beacon bytes stored
+    uint32_t allocated;   // Heap held by slot buffers
+    uint32_t hits;        // get() found a beacon
+    uint32_t misses;      // get() found none
+    uint16_t evictions;   // LRU entries dropped for a new BSSID
+    uint16_t rejected;    // put/retain with every slot pinned, or frame too big
+};
+
+template <size_t SLOTS>
+class BeaconCache {
+public:
+    static const uint16_t MAX_BEACON_LEN = 1500;
+
+    BeaconCache() { memset(slots, 0, sizeof(slots)); resetCounters(); }
+    ~BeaconCache() { clear(); }
+
+    BeaconCache(const BeaconCache&) = delete;
+    BeaconCache& operator=(const BeaconCache&) = delete;
+
+    // Store a beacon (BSSID taken from addr3). An AP that already has one
+    // is only touched: any beacon from it serves the PCAP equally well.
+    bool put(const uint8_t* frame, uint16_t len) {
+        if (!frame || len < 24) return false;
+        if (len > MAX_BEACON_LEN) {
+            countRejected();
+            return false;
+        }
+        const uint8_t* bssid = frame + 16;
+        Entry* e = find(bssid);
+        if (e && e->len) {
+            e->lastUsed = ++tick;
+            return true;
+        }
+        if (!e) {
+            e = claim(bssid);
+            if (!e) return false;
+        }
+        if (e->cap < len) {
+            uint8_t* buf = (uint8_t*)malloc(len);
+            if (!buf) {
+                countRejected();
+                return false;
+            }
+            free(e->data);
+            e->data = buf;
+            e->cap = len;
+        }
+        memcpy(e->data, frame, len);
+        e->len = len;
+        e->lastUsed = ++tick;
+        return true;
+    }
+
+    // Beacon bytes for bssid, nullptr if none stored
+    const uint8_t* get(const uint8_t* bssid, uint16_t* len) {
+        Entry* e = find(bssid);
+        if (!e || e->len == 0) {
+            misses++;
+            if (len) *len = 0;
+            return nullptr;
+        }
+        hits++;
+        e->lastUsed = ++tick;
+        if (len) *len = e->len;
+        return e->data;
+    }
+
+    bool has(const uint8_t* bssid) const {
+        const Entry* e = find(bssid);
+        return e && e->len;
+    }
+
+    // A capture references bssid and no beacon is stored yet
+    bool wants(const uint8_t* bssid) const {
+        const Entry* e = find(bssid);
+        return e && e->refs && e->len == 0;
+    }
+
+    // Take a reference, reserving a slot if the AP has none. False if no
+    // slot could be found; the caller must not release() in that case.
+    bool retain(const uint8_t* bssid) {
+        Entry* e = find(bssid);
+        if (!e) {
+            e = claim(bssid);
+            if (!e) return false;
+            e->lastUsed = ++tick;
+        }
+        if (e->refs == 0xFF) {
+            countRejected();
+            return false;
+        }
+        e->refs++;
+        return true;
+    }
+
+    // Drop a reference. The beacon stays cached until LRU needs the slot.
+    void release(const uint8_t* bssid) {
+        Entry* e = find(bssid);
+        if (e && e->refs) e->refs--;
+    }
+
+    // Free buffers of unreferenced entries (mode stop); pins survive
+    void trim() {
+        for (size_t i = 0; i < SLOTS; i++) {
+            if (slots[i].used && slots[i].refs == 0) drop(slots[i]);
+        }
+    }
+
+    // Free everything, references included
+    void clear() {
+        for (size_t i = 0; i < SLOTS; i++) drop(slots[i]);
+    }
+
+    BeaconCacheStats stats() const {
+        BeaconCacheStats s;
+        memset(&s, 0, sizeof(s));
+        s.slots = (uint16_t)SLOTS;
+        for (size_t i = 0; i < SLOTS; i++) {
+            const Entry& e = slots[i];
+            if (!e.used) continue;
+            s.entries++;
+            if (e.len) s.stored++;
+            if (e.refs) s.pinned++;
+            s.bytes += e.len;
+            s.allocated += e.cap;
+        }
+        s.hits = hits;
+        s.misses = misses;
+        s.evictions = evictions;
+        s.rejected = rejected;
+        return s;
+    }
+
+private:
+    struct Entry {
+        uint8_t bssid[6];
+        bool used;
+        uint8_t refs;
+        uint16_t len;       // 0 = reserved, no beacon yet
+        uint16_t cap;
+        uint32_t lastUsed;
+        uint8_t* data;
+    };
+
+    Entry* find(const uint8_t* bssid) {
+        for (size_t i = 0; i < SLOTS; i++) {
+            if (slots[i].used && memcmp(slots[i].bssid, bssid, 6) == 0) return &slots[i];
+        }
+        return nullptr;
+    }
+
+    const Entry* find(const uint8_t* bssid) const {
+        return const_cast<BeaconCache*>(this)->find(bssid);
+    }
+
+    // Free slot, else the least recently used unreferenced one. Its buffer
+    // is kept for reuse.
+    Entry* claim(const uint8_t* bssid) {
+        Entry* victim = nullptr;
+        for (size_t i = 0; i < SLOTS; i++) {
+            Entry& e = slots[i];
+            if (!e.used) {
+                victim = &e;
+                break;
+            }
+            if (e.refs == 0 && (!victim || (int32_t)(e.lastUsed - victim->lastUsed) < 0)) {
+                victim = &e;
+            }
+        }
+        if (!victim) {
+            countRejected();
+            return nullptr;
+        }
+        if (victim->used && evictions < 0xFFFF) evictions++;
+        memcpy(victim->bssid, bssid, 6);
+        victim->used = true;
+        victim->refs = 0;
+        victim->len = 0;
+        return victim;
+    }
+
+    void drop(Entry& e) {
+        free(e.data);
+        memset(&e, 0, sizeof(e));
+    }
+
+    void countRejected() {
+        if (rejected < 0xFFFF) rejected++;
+    }
+
+    void resetCounters() {
+        tick = 0;
+        hits = 0;
+        misses = 0;
+        evictions = 0;
+        rejected = 0;
+    }
+
+    Entry slots[SLOTS];
+    uint32_t tick;
+    uint32_t hits;
+    uint32_t misses;
+    uint16_t evictions;
+    uint16_t rejected;
+};
@@ -0,0 +1,355 @@
+// BOAR BROS List - excluded BSSIDs as a sorted key array with a name arena
+// /boar_bros.txt stays the source of truth, cached as a binary snapshot. Main loop only.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "bssid_index.h"
+#include "text_snapshot.h"
+
+template <typename FsT, typename FileT>
+class BoarBrosList {
+public:
+    static const size_t MAX_PATH = 48;
+    static const size_t MAX_LINE = 96;
+    static const size_t MAX_NAME = 32;        // SSID bytes kept
+    static const size_t MAX_ENTRIES = 2048;
+    static const uint32_t NO_NAME = 0xFFFFFFFF;
+
+    BoarBrosList() : fs(nullptr), ready(false) {
+        textPath[0] = snapshotPath[0] = '\0';
+        memset(&st, 0, sizeof(st));
+    }
+
+    BoarBrosList(const BoarBrosList&) = delete;
+    BoarBrosList& operator=(const BoarBrosList&) = delete;
+
+    // Snapshot if it matches the text file, else parse it and write one.
+    // A missing text file is an empty list.
+    bool load(FsT& fsys, const char* text, const char* snapshot) {
+        end();
+        if (!text || !snapshot || strlen(text) >= MAX_PATH || strlen(snapshot) >= MAX_PATH) {
+            return false;
+        }
+        fs = &fsys;
+        strcpy(textPath, text);
+        strcpy(snapshotPath, snapshot);
+
+        if (readSnapshot()) {
+            st.snapshotLoads++;
+            ready = true;
+            return true;
+        }
+
+        std::vector<Pending> parsed;
+        if (!parseFile(textPath, parsed)) {
+            end();
+            return false;
+        }
+        merge(parsed);
+        ready = true;
+        writeSnapshot();  // A failed write only costs the next boot a parse
+        return true;
+    }
+
+    void end() {
+        std::vector<uint64_t>().swap(keys);
+        std::vector<uint32_t>().swap(names);
+        arena.clear();
+        ready = false;
+        memset(&st, 0, sizeof(st));
+    }
+
+    bool isLoaded() const { return ready; }
+
+    // Position of key in the sorted list, or -1
+    int indexOf(uint64_t key) const {
+        size_t i = std::lower_bound(keys.begin(), keys.end(), key) - keys.begin();
+        return (i < keys.size() && keys[i] == key) ? (int)i : -1;
+    }
+
+    bool contains(uint64_t key) const { return indexOf(key) >= 0; }
+    bool contains(const uint8_t* bssid) const { return contains(bssidToKey(bssid)); }
+
+    size_t size() const { return keys.size(); }
+    bool full() const { return keys.size() >= MAX_ENTRIES; }
+
+    // Sorted by BSSID; names stay valid until the list changes
+    uint64_t keyAt(size_t i) const { return keys[i]; }
+    const char* nameAt(size_t i) const {
+        return names[i] == NO_NAME ? "" : arena.at(names[i]);
+    }
+
+    // Exclude key: one appended line plus a snapshot refresh. False if
+    // already listed, full, or the line couldn't be written.
+    bool add(uint64_t key, const char* name) {
+        if (!ready || full()) return false;
+        size_t i = std::lower_bound(keys.begin(), keys.end(), key) - keys.begin();
+        if (i < keys.size() && keys[i] == key) return false;
+
+        char line[1 + 13 + MAX_NAME + 1];
+        size_t n = needsNewline() ? 1 : 0;  // Hand-edited file without a final newline
+        line[0] = '\n';
+        formatBssidKey(key, line + n);
+        n += 12;
+        size_t nameLen = clampName(name);
+        if (nameLen) {
+            line[n++] = ' ';
+            memcpy(line + n, name, nameLen);
+            n += nameLen;
+        }
+        line[n++] = '\n';
+        FileT f = fs->open(textPath, "a");
+        if (!f) return false;
+        bool ok = f.write((const uint8_t*)line, n) == n;
+        f.close();
+        if (!ok) return false;
+
+        keys.insert(keys.begin() + i, key);
+        names.insert(names.begin() + i, storeName(name, nameLen));
+        writeSnapshot();
+        return true;
+    }
+
+    // Drop key and rewrite the text file
+    bool remove(uint64_t key) {
+        int i = ready ? indexOf(key) : -1;
+        if (i < 0) return false;
+        drop(names[i]);
+        keys.erase(keys.begin() + i);
+        names.erase(names.begin() + i);
+        return save();
+    }
+
+    // Merge every BSSID in path into the list and persist it; returns the
+    // number of networks added (0 for a missing or unreadable file)
+    size_t import(const char* path) {
+        if (!ready || !path) return 0;
+        std::vector<Pending> parsed;
+        if (!fs->exists(path) || !parseFile(path, parsed)) return 0;
+        size_t before = keys.size();
+        merge(parsed);
+        size_t added = keys.size() - before;
+        if (added) save();
+        return added;
+    }
+
+    // Rewrite the text file from the list, then the snapshot
+    bool save() {
+        if (!ready) return false;
+        char tmpPath[MAX_PATH + 4];
+        snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", textPath);
+        FileT f = fs->open(tmpPath, "w");
+        if (!f) return false;
+        static const char HEADER[] =
+            "# BOAR BROS - Networks to ignore\n"
+            "# Format: BSSID (12 hex chars) followed by optional SSID\n";
+        bool ok = f.write((const uint8_t*)HEADER, sizeof(HEADER) - 1) == sizeof(HEADER) - 1;
+        for (size_t i = 0; i < keys.size() && ok; i++) {
+            char line[13 + MAX_NAME + 1];
+            formatBssidKey(keys[i], line);
+            size_t n = 12;
+            const char* name = nameAt(i);
+            if (*name) {
+                line[n++] = ' ';
+                size_t len = strlen(name);
+                memcpy(line + n, name, len);
+                n += len;
+            }
+            line[n++] = '\n';
+            ok = f.write((const uint8_t*)line, n) == n;
+        }
+        f.close();
+        if (!ok) {
+            fs->remove(tmpPath);
+            return false;
+        }
+        if (fs->exists(textPath)) fs->remove(textPath);
+        if (!fs->rename(tmpPath, textPath)) return false;
+        return writeSnapshot();
+    }
+
+    // Heap held by the keys, name offsets and arena
+    size_t bytes() const {
+        return keys.capacity() * sizeof(uint64_t) + names.capacity() * sizeof(uint32_t) +
+               arena.capacity();
+    }
+
+    TextStoreStats stats() const { return st; }
+
+private:
+    struct Pending {
+        uint64_t key;
+        uint32_t name;
+    };
+
+    typedef TextSnapshot<FsT, FileT> Snapshot;
+
+    static size_t clampName(const char* name) {
+        if (!name) return 0;
+        size_t len = strnlen(name, MAX_NAME);
+        while (len > 0 && (name[len - 1] == ' ' || name[len - 1] == '\t')) len--;
+        for (size_t i = 0; i < len; i++) {
+            if (name[i] == '\n' || name[i] == '\r') return i;
+        }
+        return len;
+    }
+
+    bool needsNewline() const {
+        if (!fs->exists(textPath)) return false;
+        FileT f = fs->open(textPath, "r");
+        if (!f) return false;
+        size_t size = f.size();
+        uint8_t last = '\n';
+        if (size > 0 && f.seek(size - 1)) f.read(&last, 1);
+        f.close();
+        return last != '\n';
+    }
+
+    uint32_t storeName(const char* name, size_t len) {
+        return len ? arena.appendString(name, len) : NO_NAME;
+    }
+
+    // Fold sorted, deduplicated additions into the list in one linear pass;
+    // listed keys keep their names, additions stop at MAX_ENTRIES
+    void merge(std::vector<Pending>& add) {
+        std::stable_sort(add.begin(), add.end(),
+                         [](const Pending& a, const Pending& b) { return a.key < b.key; });
+        std::vector<uint64_t> mk;
+        std::vector<uint32_t> mn;
+        size_t room = MAX_ENTRIES > keys.size() ? MAX_ENTRIES - keys.size() : 0;
+        size_t total = keys.size() + (add.size() < room ? add.size() : room);
+        mk.reserve(total);
+        mn.reserve(total);
+
+        size_t i = 0, j = 0;
+        while (i < keys.size() || j < add.size()) {
+            bool takeAdd = i == keys.size() || (j < add.size() && add[j].key < keys[i]);
+            if (!takeAdd) {
+                if (j < add.size() && add[j].key == keys[i]) {
+                    drop(add[j++].name);  // Already listed
+                    continue;
+                }
+                mk.push_back(keys[i]);
+                mn.push_back(names[i++]);
+                continue;
+            }
+            const Pending& p = add[j++];
+            if ((!mk.empty() && mk.back() == p.key) || room == 0) {
+                drop(p.name);  // Repeat in the file, or no room left
+                continue;
+            }
+            mk.push_back(p.key);
+            mn.push_back(p.name);
+            room--;
+        }
+        keys.swap(mk);
+        names.swap(mn);
+        std::vector<Pending>().swap(add);
+        if (arena.garbage()) compactArena();
+    }
+
+    void drop(uint32_t name) {
+        if (name != NO_NAME) arena.release(strlen(arena.at(name)) + 1);
+    }
+
+    void compactArena() {
+        arena.compact(names.size(), [&](size_t i, size_t& len) -> uint32_t* {
+            if (names[i] == NO_NAME) return nullptr;
+            len = strlen(arena.at(names[i])) + 1;
+            return &names[i];
+        });
+    }
+
+    // ------------------------------------------------------------------------
+    // Text files
+    // ------------------------------------------------------------------------
+
+    // "BSSID [SSID]" per line into out (names go straight to the arena)
+    bool parseFile(const char* path, std::vector<Pending>& out) {
+        return Snapshot::template forEachLine<MAX_LINE>(
+            *fs, path, st.skippedLines, [&](const char* line, size_t) {
+                if (*line == '#') return;
+                size_t keyLen = strcspn(line, " \t,");
+                const char* name = line + keyLen;
+                while (*name == ' ' || *name == '\t' || *name == ',') name++;
+                Pending p;
+                if (!parseBssidKey(line, keyLen, p.key)) {
+                    st.skippedLines++;
+                    return;
+                }
+                p.name = storeName(name, clampName(name));
+                out.push_back(p);
+                st.parsedLines++;
+            });
+    }
+
+    // ------------------------------------------------------------------------
+    // Snapshot
+    // ------------------------------------------------------------------------
+
+    // Snapshot: the header, count u64 keys, count u32 name offsets, the arena
+    SnapshotHeader snapshotHeader() const {
+        SnapshotHeader h = Snapshot::header("BBRO", 2, sizeof(uint64_t) + sizeof(uint32_t));
+        h.sources[0] = Snapshot::stamp(*fs, textPath);
+        return h;
+    }
+
+    bool readSnapshot() {
+        bool ok = Snapshot::read(*fs, snapshotPath, snapshotHeader(), MAX_ENTRIES,
+                                 [&](const SnapshotHeader& h, SnapshotBlock* out) {
+                                     keys.resize(h.count);
+                                     names.resize(h.count);
+                                     out[0] = {keys.data(), h.count * sizeof(uint64_t)};
+                                     out[1] = {names.data(), h.count * sizeof(uint32_t)};
+                                     out[2] = {arena.resize(h.arenaBytes), h.arenaBytes};
+                                     return 3;
+                                 }) &&
+                  validEntries();
+        if (!ok) {
+            std::vector<uint64_t>().swap(keys);
+            std::vector<uint32_t>().swap(names);
+            arena.clear();
+        }
+        return ok;
+    }
+
+    // Sorted, unique, names in bounds and terminated
+    bool validEntries() const {
+        if (!arena.empty() && arena.back() != '\0') return false;
+        for (size_t i = 0; i < keys.size(); i++) {
+            if (keys[i] >> 48 || (i > 0 && keys[i - 1] >= keys[i])) return false;
+            if (names[i] != NO_NAME && names[i] >= arena.size()) return false;
+        }
+        return true;
+    }
+
+    bool writeSnapshot() {
+        if (arena.garbage()) compactArena();
+        SnapshotHeader h = snapshotHeader();
+        h.count = keys.size();
+        h.arenaBytes = arena.size();
+        SnapshotBlock blocks[3] = {
+            {keys.data(), keys.size() * sizeof(uint64_t)},
+            {names.data(), names.size() * sizeof(uint32_t)},
+            {arena.data(), arena.size()},
+        };
+        if (!Snapshot::write(*fs, snapshotPath, h, blocks, 3)) return false;
+        st.snapshotWrites++;
+        return true;
+    }
+
+    FsT* fs;
+    std::vector<uint64_t> keys;
+    std::vector<uint32_t> names;  // Arena offset per key, NO_NAME if none
+    StringArena arena;
+    bool ready;
+    char textPath[MAX_PATH];
+    char snapshotPath[MAX_PATH];
+    TextStoreStats st;
+};
@@ -0,0 +1,128 @@
+// BSSID Index - fixed-capacity hash from a BSSID to its entry in a std::vector
+// The vector stays the source of truth: rebuild() after erase, sort or clear.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+// BSSID as a big-endian 48-bit integer (also the BOAR BROS / WARHOG map key)
+inline uint64_t bssidToKey(const uint8_t* bssid) {
+    return ((uint64_t)bssid[0] << 40) | ((uint64_t)bssid[1] << 32) |
+           ((uint64_t)bssid[2] << 24) | ((uint64_t)bssid[3] << 16) |
+           ((uint64_t)bssid[4] << 8) | bssid[5];
+}
+
+// "64EEB7208286", "64:EE:B7:20:82:86" or "64-ee-..." (len chars) -> key
+inline bool parseBssidKey(const char* s, size_t len, uint64_t& key) {
+    uint64_t k = 0;
+    int digits = 0;
+    for (size_t i = 0; i < len; i++) {
+        char c = s[i];
+        if (c == ':' || c == '-') continue;
+        int v;
+        if (c >= '0' && c <= '9') v = c - '0';
+        else if (c >= 'A' && c <= 'F') v = c - 'A' + 10;
+        else if (c >= 'a' && c <= 'f') v = c - 'a' + 10;
+        else return false;
+        if (++digits > 12) return false;
+        k = (k << 4) | (uint64_t)v;
+    }
+    if (digits != 12) return false;
+    key = k;
+    return true;
+}
+
+// 12 uppercase hex digits, NUL-terminated (out needs 13 bytes)
+inline void formatBssidKey(uint64_t key, char* out) {
+    static const char hex[] = "0123456789ABCDEF";
+    for (int i = 11; i >= 0; i--) {
+        out[i] = hex[key & 0xF];
+        key >>= 4;
+    }
+    out[12] = '\0';
+}
+
+template <size_t SLOTS, typename Entry>
+class BssidIndex {
+    static_assert(SLOTS >= 16 && SLOTS < 0xFFFF && (SLOTS & (SLOTS - 1)) == 0,
+                  "BssidIndex slot count must be a power of two below 65535");
+
+public:
+    static constexpr uint16_t EMPTY = 0xFFFF;
+
+    // Most entries indexed before falling back to a linear scan (75% load)
+    static constexpr size_t capacity() { return SLOTS * 3 / 4; }
+
+    explicit BssidIndex(const std::vector<Entry>& entries) : entries(entries) { clear(); }
+
+    // Position of the entry with this BSSID, or -1
+    int find(const uint8_t* bssid) const {
+        if (overflowed) return linearFind(bssid);
+        size_t n = entries.size();
+        for (size_t i = home(bssid), probes = 0; probes < SLOTS; i = (i + 1) & (SLOTS - 1), probes++) {
+            uint16_t slot = slots[i];
+            if (slot == EMPTY) return -1;
+            if (slot < n && memcmp(entries[slot].bssid, bssid, 6) == 0) return slot;
+        }
+        return -1;
+    }
+
+    // Index entries[index]; call right after push_back(). If the BSSID is
+    // already indexed the existing entry wins.
+    void add(size_t index) {
+        if (overflowed || index >= entries.size()) return;
+        if (count >= capacity()) {
+            overflowed = true;  // Still correct, just linear until next rebuild()
+            return;
+        }
+        const uint8_t* bssid = entries[index].bssid;
+        size_t n = entries.size();
+        size_t i = home(bssid);
+        while (slots[i] != EMPTY) {
+            uint16_t slot = slots[i];
+            if (slot < n && memcmp(entries[slot].bssid, bssid, 6) == 0) return;
+            i = (i + 1) & (SLOTS - 1);
+        }
+        slots[i] = (uint16_t)index;
+        count++;
+    }
+
+    // Re-index the whole vector after entries moved
+    void rebuild() {
+        clear();
+        for (size_t i = 0; i < entries.size(); i++) add(i);
+    }
+
+    void clear() {
+        memset(slots, 0xFF, sizeof(slots));
+        count = 0;
+        overflowed = false;
+    }
+
+    size_t size() const { return count; }
+    bool isOverflowed() const { return overflowed; }
+
+private:
+    // Fold the 48-bit key so OUI-heavy neighbourhoods don't cluster
+    static size_t home(const uint8_t* bssid) {
+        uint64_t k = bssidToKey(bssid);
+        k ^= k >> 29;
+        k *= 0xBF58476D1CE4E5B9ULL;
+        k ^= k >> 32;
+        return (size_t)k & (SLOTS - 1);
+    }
+
+    int linearFind(const uint8_t* bssid) const {
+        for (size_t i = 0; i < entries.size(); i++) {
+            if (memcmp(entries[i].bssid, bssid, 6) == 0) return (int)i;
+        }
+        return -1;
+    }
+
+    const std::vector<Entry>& entries;
+    uint16_t slots[SLOTS];
+    size_t count;
+    bool overflowed;
+};
@@ -0,0 +1,180 @@
+// Buffered Writer - batches appended lines in RAM, one open/append/close per drain
+// Buffered lines are lost on power loss; flushIfDue() bounds that window. Main loop only.
+#pragma once
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct BufferedWriterStats {
+    uint32_t appended;   // Bytes accepted by print/printf/write
+    uint32_t written;    // Bytes the file accepted
+    uint32_t writes;     // File write() calls
+    uint32_t opens;      // File opens (one per drain)
+    uint32_t flushes;    // Buffer drains (full, due or close)
+    uint32_t errors;     // Short writes and failed opens
+    uint32_t busyUs;     // Time inside open + write + close, when a clock is set
+};
+
+template <typename FsT, typename FileT, size_t CAP>
+class BufferedWriter {
+    static_assert(CAP >= 256, "BufferedWriter buffer too small");
+
+public:
+    typedef uint32_t (*ClockFn)();  // Microseconds, for busyUs
+    static const size_t MAX_PATH = 64;
+
+    explicit BufferedWriter(ClockFn clock = nullptr)
+        : fs(nullptr), buf(nullptr), used(0), fileBytes(0), dirtySince(0), dirty(false),
+          clock(clock) {
+        memset(&st, 0, sizeof(st));
+        path[0] = '\0';
+    }
+    ~BufferedWriter() { close(); }
+
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    // Create (fresh) or append to the file at filePath. The file is opened
+    // once here to check it and read its size, then closed again. False if
+    // it cannot be opened, the path is too long, or on OOM.
+    bool begin(FsT& fsys, const char* filePath, bool fresh = true) {
+        close();
+        if (!filePath || strlen(filePath) >= MAX_PATH) return false;
+        FileT f = fsys.open(filePath, fresh ? "w" : "a");
+        if (!f) return false;
+        size_t existing = fresh ? 0 : f.size();
+        f.close();
+        buf = (char*)malloc(CAP);
+        if (!buf) return false;
+        fs = &fsys;
+        strcpy(path, filePath);
+        used = 0;
+        fileBytes = existing;
+        dirty = false;
+        memset(&st, 0, sizeof(st));
+        return true;
+    }
+
+    bool isOpen() const { return buf != nullptr; }
+
+    size_t write(const uint8_t* data, size_t len) {
+        if (!buf || !data) return 0;
+        st.appended += len;
+        if (used + len > CAP) {
+            drain();
+            if (len > CAP) {
+                // Bigger than the whole buffer: straight through
+                writeOut((const char*)data, len);
+                return len;
+            }
+        }
+        memcpy(buf + used, data, len);
+        used += len;
+        return len;
+    }
+
+    size_t print(const char* s) { return s ? write((const uint8_t*)s, strlen(s)) : 0; }
+    size_t print(char c) { return write((const uint8_t*)&c, 1); }
+    size_t println(const char* s = "") { return print(s) + print("\r\n"); }  // As Print::println
+
+    size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+        if (!buf) return 0;
+        char line[192];
+        va_list args;
+        va_start(args, fmt);
+        int n = vsnprintf(line, sizeof(line), fmt, args);
+        va_end(args);
+        if (n < 0) return 0;
+        if ((size_t)n < sizeof(line)) return write((const uint8_t*)line, n);
+
+        // Rare long line: format it on the heap
+        char* big = (char*)malloc(n + 1);
+        if (!big) return 0;
+        va_start(args, fmt);
+        vsnprintf(big, n + 1, fmt, args);
+        va_end(args);
+        size_t w = write((const uint8_t*)big, n);
+        free(big);
+        return w;
+    }
+
+    // Bytes in the file once everything buffered is written
+    size_t size() const { return fileBytes + used; }
+    size_t buffered() const { return used; }
+
+    // Write the buffer out if it holds minBytes or its oldest unwritten
+    // line is maxAgeMs old. True if it flushed.
+    bool flushIfDue(uint32_t nowMs, size_t minBytes, uint32_t maxAgeMs) {
+        if (!buf || used == 0) {
+            dirty = false;
+            return false;
+        }
+        if (!dirty) {
+            dirty = true;
+            dirtySince = nowMs;
+        }
+        if (used < minBytes && nowMs - dirtySince < maxAgeMs) return false;
+        return flush();
+    }
+
+    // Write everything buffered; the close syncs it. False on an error.
+    bool flush() {
+        if (!buf) return true;
+        uint32_t errorsBefore = st.errors;
+        drain();
+        return st.errors == errorsBefore;
+    }
+
+    // Flush and free the buffer
+    bool close() {
+        if (!buf) return true;
+        bool ok = flush();
+        free(buf);
+        buf = nullptr;
+        fs = nullptr;
+        used = 0;
+        dirty = false;
+        return ok;
+    }
+
+    BufferedWriterStats stats() const { return st; }
+
+private:
+    void drain() {
+        if (used == 0) return;
+        writeOut(buf, used);
+        used = 0;
+        dirty = false;
+        st.flushes++;
+    }
+
+    void writeOut(const char* data, size_t len) {
+        uint32_t t0 = clock ? clock() : 0;
+        FileT f = fs->open(path, "a");
+        st.opens++;
+        size_t w = 0;
+        if (f) {
+            w = f.write((const uint8_t*)data, len);
+            st.writes++;
+            f.close();
+        }
+        if (clock) st.busyUs += clock() - t0;
+        st.written += w;
+        fileBytes += w;
+        if (w != len) st.errors++;
+    }
+
+    FsT* fs;
+    char* buf;
+    size_t used;
+    size_t fileBytes;
+    uint32_t dirtySince;
+    bool dirty;
+    ClockFn clock;
+    char path[MAX_PATH];
+    BufferedWriterStats st;
+};
@@ -0,0 +1,151 @@
+// Capture Catalog implementation
+
+#include "capture_catalog.h"
+#include "config.h"
+#include <SD.h>
+
+static const char* CATALOG_FILE = "/capture_catalog.bin";
+static const char* CAPTURE_DIR = "/handshakes";
+
+static CatalogIndex<fs::FS, File> catalog;
+
+bool CaptureCatalog::stale = true;
+
+void CaptureCatalog::init() {
+    if (!Config::isSDAvailable()) return;
+    
+    uint32_t start = millis();
+    if (catalog.load(SD, CATALOG_FILE)) {
+        stale = false;
+        CatalogStats s = catalog.stats();
+        Serial.printf("[CATALOG] Loaded %lu captures (%lu dead records) in %lu ms\n",
+                      (unsigned long)s.live, (unsigned long)s.dead,
+                      (unsigned long)(millis() - start));
+        return;
+    }
+    
+    Serial.println("[CATALOG] Missing or stale, rebuilding from /handshakes");
+    ensureReady();
+}
+
+bool CaptureCatalog::ensureReady() {
+    if (!stale && catalog.loaded()) return true;
+    if (!Config::isSDAvailable()) return false;
+    
+    uint32_t start = millis();
+    if (!catalog.rebuild(SD, CATALOG_FILE, CAPTURE_DIR)) {
+        Serial.println("[CATALOG] Rebuild failed");
+        return false;
+    }
+    stale = false;
+    Serial.printf("[CATALOG] Rebuilt: %lu captures in %lu ms\n",
+                  (unsigned long)catalog.size(), (unsigned long)(millis() - start));
+    return true;
+}
+
+void CaptureCatalog::invalidate() {
+    if (stale) return;
+    stale = true;
+    catalog.end();
+    // Gone from the card too, so a reboot before the rebuild can't load it
+    if (SD.exists(CATALOG_FILE)) SD.remove(CATALOG_FILE);
+    Serial.println("[CATALOG] Invalidated");
+}
+
+void CaptureCatalog::capturePath(char* out, size_t len, const uint8_t* bssid, CaptureKind kind) {
+    const char* suffix = kind == CaptureKind::PCAP ? ".pcap" :
+                         kind == CaptureKind::HANDSHAKE ? "_hs.22000" : ".22000";
+    snprintf(out, len, "%s/%02X%02X%02X%02X%02X%02X%s", CAPTURE_DIR,
+             bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5], suffix);
+}
+
+void CaptureCatalog::noteSaved(const uint8_t* bssid, const uint8_t* station, CaptureKind kind,
+                               const char* ssid, const char* path) {
+    if (!ensureReady()) return;
+    
+    CatalogRecord rec;
+    memset(&rec, 0, sizeof(rec));
+    memcpy(rec.bssid, bssid, 6);
+    if (station) memcpy(rec.station, station, 6);
+    rec.kind = (uint8_t)kind;
+    if (ssid) strncpy(rec.ssid, ssid, 32);
+    File f = SD.open(path, FILE_READ);
+    if (f) {
+        rec.timestamp = (uint32_t)f.getLastWrite();  // Same as a rebuild
+        rec.fileSize = f.size();
+        f.close();
+    }
+    
+    if (!catalog.put(rec)) {
+        Serial.println("[CATALOG] Append failed, will rebuild");
+        invalidate();
+    }
+}
+
+void CaptureCatalog::noteRemoved(const uint8_t* bssid, CaptureKind kind) {
+    if (stale || !catalog.loaded()) return;  // Rebuild will see it's gone
+    if (catalog.has(bssid, kind) && !catalog.remove(bssid, kind)) {
+        invalidate();
+    }
+}
+
+void CaptureCatalog::clear() {
+    if (!Config::isSDAvailable()) return;
+    catalog.load(SD, CATALOG_FILE);  // Only to bind the path; contents are going
+    if (catalog.clear()) {
+        stale = false;
+    } else {
+        invalidate();
+    }
+}
+
+bool CaptureCatalog::has(const uint8_t* bssid, CaptureKind kind) {
+    if (ensureReady()) return catalog.has(bssid, kind);
+    char path[48];
+    capturePath(path, sizeof(path), bssid, kind);
+    return SD.exists(path);
+}
+
+bool CaptureCatalog::isSaved(const uint8_t* bssid, CaptureKind kind) {
+    if (!has(bssid, kind)) return false;
+    char path[48];
+    capturePath(path, sizeof(path), bssid, kind);
+    if (SD.exists(path)) return true;
+    Serial.printf("[CATALOG] %s gone from card, dropping stale record\n", path);
+    noteRemoved(bssid, kind);
+    return false;
+}
+
+bool CaptureCatalog::lookup(const uint8_t* bssid, CaptureKind kind, CatalogRecord& out) {
+    if (!ensureReady()) return false;
+    return catalog.get(bssid, kind, out);
+}
+
+bool CaptureCatalog::findSSID(const uint8_t* bssid, CaptureKind kind, char* ssidOut) {
+    CatalogRecord rec;
+    if (!lookup(bssid, kind, rec) || rec.ssid[0] == '\0') return false;
+    memcpy(ssidOut, rec.ssid, sizeof(rec.ssid));
+    ssidOut[32] = '\0';
+    return true;
+}
+
+bool CaptureCatalog::hasPMKID(const uint8_t* bssid, const uint8_t* station, const char* ssid) {
+    if (!ensureReady() || !catalog.has(bssid, CaptureKind::PMKID)) return false;
+    CatalogRecord rec;
+    if (!catalog.get(bssid, CaptureKind::PMKID, rec)) return false;
+    if (memcmp(rec.station, station, 6) != 0 || strncmp(rec.ssid, ssid, 32) != 0) return false;
+    return isSaved(bssid, CaptureKind::PMKID);
+}
+
+bool CaptureCatalog::forEach(void (*fn)(const CatalogRecord& rec)) {
+    if (!ensureReady()) return false;
+    return catalog.forEachLive(fn);
+}
+
+size_t CaptureCatalog::count() {
+    return catalog.loaded() ? catalog.size() : 0;
+}
+
+CatalogStats CaptureCatalog::getStats() {
+    return catalog.stats();
+}
@@ -0,0 +1,46 @@
+// Capture Catalog - persistent index of the captures in /handshakes
+// Every path that writes or deletes a capture reports it here (see catalog_index.h).
+#pragma once
+
+#include <Arduino.h>
+#include "catalog_index.h"
+
+class CaptureCatalog {
+public:
+    // Load the catalog; rebuild it from /handshakes if missing or stale
+    static void init();
+    
+    // Captures changed behind the catalog's back (web file manager):
+    // drop it, rebuild on next use
+    static void invalidate();
+    
+    // Save/delete hooks. station may be null; path is the file just written.
+    static void noteSaved(const uint8_t* bssid, const uint8_t* station, CaptureKind kind,
+                          const char* ssid, const char* path);
+    static void noteRemoved(const uint8_t* bssid, CaptureKind kind);
+    static void clear();
+    
+    // Queries (fall back to the card if the catalog is unavailable)
+    static bool has(const uint8_t* bssid, CaptureKind kind);
+    
+    // Dedup check: catalog hit confirmed on the card. A capture deleted
+    // off-device drops its stale record and reports false.
+    static bool isSaved(const uint8_t* bssid, CaptureKind kind);
+    static bool lookup(const uint8_t* bssid, CaptureKind kind, CatalogRecord& out);
+    static bool findSSID(const uint8_t* bssid, CaptureKind kind, char* ssidOut);  // 33 bytes
+    
+    // Same AP, client and SSID already saved: the PMKID would be identical.
+    // Confirmed on the card like isSaved().
+    static bool hasPMKID(const uint8_t* bssid, const uint8_t* station, const char* ssid);
+    
+    // Visit every capture (one sequential read of the catalog file)
+    static bool forEach(void (*fn)(const CatalogRecord& rec));
+    
+    static size_t count();
+    static CatalogStats getStats();
+    static void capturePath(char* out, size_t len, const uint8_t* bssid, CaptureKind kind);
+    
+private:
+    static bool stale;
+    static bool ensureReady();
+};
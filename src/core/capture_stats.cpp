@@ -0,0 +1,100 @@
+// Capture Stats implementation
+
+#include "capture_stats.h"
+#include "sdlog.h"
+
+#if CAPTURE_STATS_ENABLED
+CaptureStats CaptureTelemetry::stats = {};
+#endif
+
+void CaptureTelemetry::reset() {
+#if CAPTURE_STATS_ENABLED
+    memset(&stats, 0, sizeof(stats));
+#endif
+}
+
+CaptureStats CaptureTelemetry::snapshot() {
+#if CAPTURE_STATS_ENABLED
+    return stats;
+#else
+    CaptureStats s = {};
+    return s;
+#endif
+}
+
+const char* CaptureTelemetry::dropName(CaptureDrop reason) {
+    switch (reason) {
+        case CaptureDrop::TOO_SHORT:       return "short";
+        case CaptureDrop::MALFORMED:       return "malformed";
+        case CaptureDrop::OVERSIZE_BEACON: return "big beacon";
+        case CaptureDrop::TABLE_FULL:      return "table full";
+        case CaptureDrop::HEAP_GUARD:      return "heap guard";
+        case CaptureDrop::QUEUE_FULL:      return "queue full";
+        case CaptureDrop::EXCLUDED:        return "bro";
+        default:                           return "?";
+    }
+}
+
+const char* CaptureTelemetry::typeName(uint8_t type) {
+    static const char* names[CAPTURE_FRAME_TYPES] = {"mgmt", "ctrl", "data", "misc"};
+    return type < CAPTURE_FRAME_TYPES ? names[type] : "?";
+}
+
+// ============================================================
+// DUMP
+// press '2' in IDLE / OINK / DNH, or stop a capture mode
+// ============================================================
+
+void CaptureTelemetry::dump(const char* tag) {
+#if CAPTURE_STATS_ENABLED
+    CaptureStats s = snapshot();
+    char line[160];
+    int n;
+
+    SDLOG("STATS", "Capture telemetry (%s): %lu received, %lu dropped",
+          tag, (unsigned long)s.received, (unsigned long)s.totalDrops());
+
+    // Per type, then the subtypes that actually showed up
+    for (uint8_t t = 0; t < CAPTURE_FRAME_TYPES; t++) {
+        uint32_t total = 0;
+        for (uint8_t st = 0; st < 16; st++) total += s.frames[t][st];
+        if (total == 0) continue;
+        n = snprintf(line, sizeof(line), "%s %lu:", typeName(t), (unsigned long)total);
+        for (uint8_t st = 0; st < 16 && n < (int)sizeof(line); st++) {
+            if (s.frames[t][st] == 0) continue;
+            n += snprintf(line + n, sizeof(line) - n, " %u=%lu", st, (unsigned long)s.frames[t][st]);
+        }
+        SDLOG("STATS", "%s", line);
+    }
+
+    n = snprintf(line, sizeof(line), "drops:");
+    for (uint8_t i = 0; i < (uint8_t)CaptureDrop::COUNT && n < (int)sizeof(line); i++) {
+        n += snprintf(line + n, sizeof(line) - n, " %s=%lu",
+                      dropName((CaptureDrop)i), (unsigned long)s.drops[i]);
+    }
+    SDLOG("STATS", "%s", line);
+
+    if (s.queueCapacity) {
+        SDLOG("STATS", "queue high water %lu/%lu",
+              (unsigned long)s.queueHighWater, (unsigned long)s.queueCapacity);
+    }
+
+    if (s.cbCalls) {
+        SDLOG("STATS", "callback %lu calls, avg %lu cyc, max %lu cyc",
+              (unsigned long)s.cbCalls, (unsigned long)(s.cbTotalCycles / s.cbCalls),
+              (unsigned long)s.cbMaxCycles);
+        n = snprintf(line, sizeof(line), "callback cycles:");
+        for (uint8_t b = 0; b < CAPTURE_CB_BUCKETS && n < (int)sizeof(line); b++) {
+            if (s.cbHist[b] == 0) continue;
+            uint32_t limit = 1u << (CAPTURE_CB_FIRST_BIT + b);
+            n += snprintf(line + n, sizeof(line) - n, " %s%luK=%lu",
+                          b == CAPTURE_CB_BUCKETS - 1 ? ">=" : "<",
+                          (unsigned long)((b == CAPTURE_CB_BUCKETS - 1 ? limit / 2 : limit) >> 10),
+                          (unsigned long)s.cbHist[b]);
+        }
+        SDLOG("STATS", "%s", line);
+    }
+#else
+    SDLOG("STATS", "Capture telemetry compiled out (%s)", tag);
+#endif
+}
@@ -0,0 +1,108 @@
+// Capture Stats - counters for the promiscuous capture pipeline
+// One writer context per counter; -DCAPTURE_STATS_ENABLED=0 compiles the hooks out.
+#pragma once
+
+#include <Arduino.h>
+
+#ifndef CAPTURE_STATS_ENABLED
+#define CAPTURE_STATS_ENABLED 1
+#endif
+
+enum class CaptureDrop : uint8_t {
+    TOO_SHORT = 0,    // Callback: frame shorter than an 802.11 header
+    MALFORMED,        // update(): frame too short for its parser
+    OVERSIZE_BEACON,  // Beacon over the PCAP size limit
+    TABLE_FULL,       // networks / handshakes / PMKIDs at capacity
+    HEAP_GUARD,       // Free heap under the mode's floor
+    QUEUE_FULL,       // Frame ring or staging slot had no room
+    EXCLUDED,         // BOAR BRO: out of scope, never stored
+    COUNT
+};
+
+static const uint8_t CAPTURE_FRAME_TYPES = 4;  // wifi_promiscuous_pkt_type_t MGMT..MISC
+static const uint8_t CAPTURE_CB_BUCKETS = 12;  // <1K cycles, <2K, ... >=1M
+static const uint8_t CAPTURE_CB_FIRST_BIT = 10;
+
+struct CaptureStats {
+    uint32_t received;                               // Frames the callback saw while a mode listened
+    uint32_t frames[CAPTURE_FRAME_TYPES][16];        // [type][subtype]
+    uint32_t drops[(uint8_t)CaptureDrop::COUNT];
+    uint32_t queueHighWater;                         // Peak handoff depth (mode's unit)
+    uint32_t queueCapacity;
+    uint32_t cbCalls;
+    uint32_t cbMaxCycles;
+    uint64_t cbTotalCycles;
+    uint32_t cbHist[CAPTURE_CB_BUCKETS];             // Bucket i: < 2^(10+i) cycles, last is open-ended
+
+    uint32_t totalDrops() const {
+        uint32_t n = 0;
+        for (uint8_t i = 0; i < (uint8_t)CaptureDrop::COUNT; i++) n += drops[i];
+        return n;
+    }
+};
+
+class CaptureTelemetry {
+public:
+    static void reset();
+    static CaptureStats snapshot();
+
+    // Serial + SD log dump; tag names the trigger ("OINK stop", "key")
+    static void dump(const char* tag);
+
+    static const char* dropName(CaptureDrop reason);
+    static const char* typeName(uint8_t type);
+
+#if CAPTURE_STATS_ENABLED
+    static void frame(uint8_t type, uint8_t fc0) {
+        stats.received++;
+        if (type < CAPTURE_FRAME_TYPES) stats.frames[type][(fc0 >> 4) & 0x0F]++;
+    }
+
+    static void drop(CaptureDrop reason) {
+        stats.drops[(uint8_t)reason]++;
+    }
+
+    static void queueDepth(uint32_t depth, uint32_t capacity) {
+        if (depth > stats.queueHighWater) stats.queueHighWater = depth;
+        stats.queueCapacity = capacity;
+    }
+
+    static void callbackCycles(uint32_t cycles) {
+        stats.cbCalls++;
+        stats.cbTotalCycles += cycles;
+        if (cycles > stats.cbMaxCycles) stats.cbMaxCycles = cycles;
+        stats.cbHist[bucketFor(cycles)]++;
+    }
+
+    static uint8_t bucketFor(uint32_t cycles) {
+        if (cycles < (1u << CAPTURE_CB_FIRST_BIT)) return 0;
+        uint8_t bit = 31 - __builtin_clz(cycles);  // floor(log2)
+        uint8_t b = bit - CAPTURE_CB_FIRST_BIT + 1;
+        return b < CAPTURE_CB_BUCKETS ? b : CAPTURE_CB_BUCKETS - 1;
+    }
+
+private:
+    static CaptureStats stats;
+#endif
+};
+
+#if CAPTURE_STATS_ENABLED
+// Times the enclosing scope into the callback histogram (every return path)
+class CaptureCallbackTimer {
+public:
+    CaptureCallbackTimer() : start(ESP.getCycleCount()) {}
+    ~CaptureCallbackTimer() { CaptureTelemetry::callbackCycles(ESP.getCycleCount() - start); }
+private:
+    uint32_t start;
+};
+
+#define CAPTURE_CB_TIMER() CaptureCallbackTimer captureCbTimer_
+#define CAPTURE_FRAME(type, fc0) CaptureTelemetry::frame((uint8_t)(type), (fc0))
+#define CAPTURE_DROP(reason) CaptureTelemetry::drop(CaptureDrop::reason)
+#define CAPTURE_QUEUE(depth, capacity) CaptureTelemetry::queueDepth((depth), (capacity))
+#else
+#define CAPTURE_CB_TIMER() do {} while (0)
+#define CAPTURE_FRAME(type, fc0) do {} while (0)
+#define CAPTURE_DROP(reason) do {} while (0)
+#define CAPTURE_QUEUE(depth, capacity) do {} while (0)
+#endif
@@ -0,0 +1,663 @@
+// Capture Store implementation
+
+#include "capture_store.h"
+#include "capture_stats.h"
+#include "capture_catalog.h"
+#include "config.h"
+#include "sdlog.h"
+#include "../modes/oink.h"
+#include <SD.h>
+
+static const char* CAPTURE_DIR = "/handshakes";
+
+std::vector<DetectedNetwork> CaptureStore::networks;
+BssidIndex<512, DetectedNetwork> CaptureStore::networkIndex(CaptureStore::networks);
+std::vector<CapturedHandshake> CaptureStore::handshakes;
+BssidIndex<128, CapturedHandshake> CaptureStore::pwnedIndex(CaptureStore::handshakes);
+std::vector<CapturedPMKID> CaptureStore::pmkids;
+EapolPool CaptureStore::eapolPool;
+BeaconCache<CAPTURE_BEACON_CACHE_SLOTS> CaptureStore::beaconCache;
+FrameRing<CaptureStore::FRAME_RING_BYTES> CaptureStore::frames;
+uint32_t CaptureStore::holdUntil = 0;
+
+static_assert(CaptureStore::MAX_NETWORKS <= decltype(CaptureStore::networkIndex)::capacity(),
+              "networkIndex too small for MAX_NETWORKS");
+static_assert(CaptureStore::MAX_HANDSHAKES <= decltype(CaptureStore::pwnedIndex)::capacity(),
+              "pwnedIndex too small for MAX_HANDSHAKES");
+
+// Exponential backoff between save attempts: 0s, 2s, 5s, then give up
+static const uint32_t SAVE_BACKOFF_MS[] = {0, 2000, 5000};
+static const uint8_t SAVE_MAX_ATTEMPTS = 3;
+
+void CaptureStore::clear() {
+    networks.clear();
+    networks.shrink_to_fit();
+    networkIndex.clear();
+    handshakes.clear();
+    handshakes.shrink_to_fit();
+    pwnedIndex.clear();
+    pmkids.clear();
+    pmkids.shrink_to_fit();
+    eapolPool.end();
+    beaconCache.clear();
+    holdUntil = 0;
+}
+
+void CaptureStore::trim() {
+    // Free cached beacons nothing references; unsaved captures keep theirs
+    beaconCache.trim();
+
+    // Give the EAPOL arena back unless unsaved frames still live in it
+    if (eapolPool.frameCount() == 0) {
+        eapolPool.end();
+    }
+    holdUntil = 0;
+}
+
+// ============ Networks ============
+
+void CaptureStore::networkFromBeacon(const MgmtFrameView& beacon, int8_t rssi, uint8_t channel,
+                                     DetectedNetwork& net) {
+    memset(&net, 0, sizeof(net));
+    memcpy(net.bssid, beacon.bssid(), 6);
+    net.rssi = rssi;
+    net.lastSeen = millis();
+    net.beaconCount = 1;
+    net.hasPMF = beacon.pmfRequired;  // PMF required = deauth immune
+
+    // Zero-length / all-NUL SSID = hidden; oversized SSID IE ignored
+    beacon.copySSID(net.ssid);
+    net.isHidden = beacon.isHidden();
+
+    // Features for ML
+    net.features = FeatureExtractor::extractFromBeacon(beacon, rssi);
+    net.authmode = FeatureExtractor::authModeFromBeacon(beacon);
+    net.channel = beacon.dsChannel ? beacon.dsChannel : channel;
+}
+
+int CaptureStore::addNetwork(const DetectedNetwork& net) {
+    // The modes' cleanup passes free stale entries
+    if (networks.size() >= MAX_NETWORKS) {
+        CAPTURE_DROP(TABLE_FULL);
+        return -1;
+    }
+
+    // Check heap before allocating - skip if memory critically low
+    if (ESP.getFreeHeap() < HEAP_MIN_FREE) {
+        CAPTURE_DROP(HEAP_GUARD);
+        return -1;
+    }
+
+    networks.push_back(net);
+    int idx = networks.size() - 1;
+    networkIndex.add(idx);
+    networks[idx].hasHandshake = hasHandshakeFor(net.bssid);
+    if (net.ssid[0] != 0) backfillPMKIDs(net.bssid, net.ssid);
+    return idx;
+}
+
+void CaptureStore::refreshNetwork(int idx, const DetectedNetwork& seen) {
+    DetectedNetwork& net = networks[idx];
+    net.rssi = seen.rssi;
+    net.lastSeen = seen.lastSeen;
+    net.beaconCount++;
+    net.hasPMF = seen.hasPMF;
+
+    // Backfill SSID if we didn't have it before (critical for PMKID save)
+    if (net.ssid[0] == 0 && seen.ssid[0] != 0) {
+        strncpy(net.ssid, seen.ssid, 32);
+        net.ssid[32] = 0;
+        net.isHidden = false;
+    }
+    if (net.ssid[0] != 0) backfillPMKIDs(net.bssid, net.ssid);
+}
+
+void CaptureStore::backfillPMKIDs(const uint8_t* bssid, const char* ssid) {
+    for (auto& p : pmkids) {
+        if (p.ssid[0] == 0 && memcmp(p.bssid, bssid, 6) == 0) {
+            strncpy(p.ssid, ssid, 32);
+            p.ssid[32] = 0;
+            Serial.printf("[STORE] PMKID SSID backfill: %s\n", p.ssid);
+        }
+    }
+}
+
+// ============ Captures ============
+
+int CaptureStore::findOrCreateHandshake(const uint8_t* bssid, const uint8_t* station) {
+    // BOAR BROS are out of scope: never stored
+    if (OinkMode::isExcluded(bssid)) {
+        CAPTURE_DROP(EXCLUDED);
+        return -1;
+    }
+
+    for (size_t i = 0; i < handshakes.size(); i++) {
+        if (memcmp(handshakes[i].bssid, bssid, 6) == 0 &&
+            memcmp(handshakes[i].station, station, 6) == 0) {
+            return i;
+        }
+    }
+
+    if (handshakes.size() >= MAX_HANDSHAKES) {
+        CAPTURE_DROP(TABLE_FULL);
+        return -1;
+    }
+
+    CapturedHandshake hs = {};
+    memcpy(hs.bssid, bssid, 6);
+    memcpy(hs.station, station, 6);
+    hs.firstSeen = millis();
+    hs.lastSeen = hs.firstSeen;
+
+    // Reference the AP's cached beacon (or reserve a slot the next one fills)
+    hs.beaconRef = beaconCache.retain(bssid);
+
+    handshakes.push_back(hs);
+    return handshakes.size() - 1;
+}
+
+int CaptureStore::findOrCreatePMKID(const uint8_t* bssid, const uint8_t* station) {
+    // BOAR BROS are out of scope: never stored
+    if (OinkMode::isExcluded(bssid)) {
+        CAPTURE_DROP(EXCLUDED);
+        return -1;
+    }
+
+    for (size_t i = 0; i < pmkids.size(); i++) {
+        if (memcmp(pmkids[i].bssid, bssid, 6) == 0 &&
+            memcmp(pmkids[i].station, station, 6) == 0) {
+            return i;
+        }
+    }
+
+    if (pmkids.size() >= MAX_PMKIDS) {
+        CAPTURE_DROP(TABLE_FULL);
+        return -1;
+    }
+
+    CapturedPMKID p = {};
+    memcpy(p.bssid, bssid, 6);
+    memcpy(p.station, station, 6);
+    p.timestamp = millis();
+    p.beaconRef = beaconCache.retain(bssid);  // Beacon supplies the SSID if M1 beat it
+
+    pmkids.push_back(p);
+    return pmkids.size() - 1;
+}
+
+bool CaptureStore::addFrame(int idx, uint8_t msgNum, const uint8_t* frame, uint16_t len,
+                            uint16_t eapolOffset, int8_t rssi) {
+    CapturedHandshake& hs = handshakes[idx];
+    bool wasComplete = hs.isComplete();
+
+    // Full 802.11 frame for PCAP; EAPOL slice for hashcat 22000
+    EAPOLFrame& ef = hs.frames[msgNum - 1];
+    reserveEapolPool();  // First EAPOL frame of the session pays for the arena
+    if (!ef.store(eapolPool, frame, len, eapolOffset)) return false;
+    ef.messageNum = msgNum;
+    ef.timestamp = millis();
+    ef.rssi = rssi;
+
+    hs.capturedMask |= (1 << (msgNum - 1));
+    hs.lastSeen = ef.timestamp;
+
+    if (hs.ssid[0] == 0) {
+        int netIdx = findNetwork(hs.bssid);
+        if (netIdx >= 0) {
+            strncpy(hs.ssid, networks[netIdx].ssid, 32);
+            hs.ssid[32] = 0;
+        }
+    }
+
+    if (!wasComplete && hs.isComplete()) pwnedIndex.add(idx);
+    return true;
+}
+
+uint16_t CaptureStore::completeHandshakeCount() {
+    uint16_t count = 0;
+    for (const auto& hs : handshakes) {
+        if (hs.isComplete()) count++;
+    }
+    return count;
+}
+
+// EAPOL arena for handshake frames - allocated on first use
+void CaptureStore::reserveEapolPool() {
+    if (eapolPool.isReady()) return;
+    if (eapolPool.begin(EAPOL_POOL_BYTES)) {
+        Serial.printf("[STORE] EAPOL pool: %lu bytes\n", (unsigned long)eapolPool.stats().capacity);
+    } else {
+        Serial.println("[STORE] EAPOL pool allocation failed - handshakes won't be captured");
+    }
+}
+
+// Fresh handshake whose AP beacon isn't cached yet: hold the save (arming
+// the deadline holdExpired() reports) so the PCAP gets one. Never holds
+// once the mode has stopped capturing.
+bool CaptureStore::beaconPending(const CapturedHandshake& hs, bool live) {
+    if (!live || !hs.beaconRef || !beaconCache.wants(hs.bssid)) return false;
+    uint32_t deadline = hs.lastSeen + BEACON_WAIT_MS;
+    if ((int32_t)(millis() - deadline) >= 0) return false;
+    if (holdUntil == 0 || (int32_t)(deadline - holdUntil) > 0) holdUntil = deadline;
+    return true;
+}
+
+bool CaptureStore::holdExpired(uint32_t now) {
+    if (holdUntil == 0 || (int32_t)(now - holdUntil) < 0) return false;
+    holdUntil = 0;
+    return true;
+}
+
+// Drop a capture's hold on its AP's cached beacon (once it's on SD or given up)
+void CaptureStore::releaseBeacon(const uint8_t* bssid, bool& ref) {
+    if (!ref) return;
+    beaconCache.release(bssid);
+    ref = false;
+}
+
+// SSID for a capture whose AP's beacon it beat: the network table, then
+// the cached beacon (outlives an aged-out network), then an earlier save
+bool CaptureStore::backfillSSID(const uint8_t* bssid, char* ssid, CaptureKind kind) {
+    int netIdx = findNetwork(bssid);
+    if (netIdx >= 0 && networks[netIdx].ssid[0] != 0) {
+        strncpy(ssid, networks[netIdx].ssid, 32);
+        ssid[32] = 0;
+        return true;
+    }
+    uint16_t beaconLen = 0;
+    const uint8_t* beacon = beaconCache.get(bssid, &beaconLen);
+    MgmtFrameView view;
+    if (beacon && view.parse(beacon, beaconLen) && view.copySSID(ssid)) return true;
+    if (CaptureCatalog::findSSID(bssid, kind, ssid)) return true;
+    return kind == CaptureKind::HANDSHAKE && CaptureCatalog::findSSID(bssid, CaptureKind::PCAP, ssid);
+}
+
+// ============ Writers ============
+
+// PCAP file format structures
+#pragma pack(push, 1)
+struct PCAPHeader {
+    uint32_t magic;
+    uint16_t version_major;
+    uint16_t version_minor;
+    int32_t thiszone;
+    uint32_t sigfigs;
+    uint32_t snaplen;
+    uint32_t linktype;
+};
+
+struct PCAPPacketHeader {
+    uint32_t ts_sec;
+    uint32_t ts_usec;
+    uint32_t incl_len;
+    uint32_t orig_len;
+};
+#pragma pack(pop)
+
+// Minimal radiotap header (8 bytes) - no optional fields, required for WPA-SEC
+static const uint8_t RADIOTAP_HEADER[] = {
+    0x00,       // Header revision
+    0x00,       // Header pad
+    0x08, 0x00, // Header length (8, little-endian)
+    0x00, 0x00, 0x00, 0x00  // Present flags (no optional fields)
+};
+
+static void writePCAPHeader(File& f) {
+    PCAPHeader hdr = {
+        .magic = 0xA1B2C3D4,      // PCAP magic
+        .version_major = 2,
+        .version_minor = 4,
+        .thiszone = 0,
+        .sigfigs = 0,
+        .snaplen = 65535,
+        .linktype = 127           // LINKTYPE_IEEE802_11_RADIOTAP (with radiotap header)
+    };
+    f.write((uint8_t*)&hdr, sizeof(hdr));
+}
+
+static void writePCAPPacket(File& f, const uint8_t* data, uint16_t len, uint32_t ts) {
+    // Total packet length = radiotap header + 802.11 frame
+    uint32_t totalLen = sizeof(RADIOTAP_HEADER) + len;
+
+    PCAPPacketHeader pkt = {
+        .ts_sec = ts / 1000,
+        .ts_usec = (ts % 1000) * 1000,
+        .incl_len = totalLen,
+        .orig_len = totalLen
+    };
+    f.write((uint8_t*)&pkt, sizeof(pkt));
+    f.write(RADIOTAP_HEADER, sizeof(RADIOTAP_HEADER));
+    f.write(data, len);
+}
+
+// Beacon first (hashcat needs it), then every captured EAPOL message
+static bool saveHandshakePCAP(const CapturedHandshake& hs, const char* path, const char* tag) {
+    File f = SD.open(path, FILE_WRITE);
+    if (!f) {
+        Serial.printf("[%s] Failed to create PCAP: %s\n", tag, path);
+        return false;
+    }
+
+    writePCAPHeader(f);
+
+    int packetCount = 0;
+    uint16_t beaconLen = 0;
+    const uint8_t* beacon = CaptureStore::beaconCache.get(hs.bssid, &beaconLen);
+    if (beacon) {
+        writePCAPPacket(f, beacon, beaconLen, hs.firstSeen);
+        packetCount++;
+    }
+
+    for (int i = 0; i < 4; i++) {
+        if (!(hs.capturedMask & (1 << i))) continue;
+
+        const EAPOLFrame& frame = hs.frames[i];
+        if (frame.len == 0) continue;
+
+        const uint8_t* full = frame.fullFrame(CaptureStore::eapolPool);
+        if (!full) continue;
+
+        // Prefer stored fullFrame (real 802.11 capture) over reconstruction
+        if (frame.eapolOffset > 0) {
+            writePCAPPacket(f, full, frame.frame.len, frame.timestamp);
+            packetCount++;
+            continue;
+        }
+
+        // Fallback: reconstruct frame from EAPOL payload (legacy path)
+        uint8_t pkt[600];
+
+        // 802.11 Data frame header (24 bytes)
+        memset(pkt, 0, 24);
+        pkt[0] = 0x08;
+        if (i == 0 || i == 2) {  // M1, M3: AP->Station (FromDS=1, ToDS=0)
+            pkt[1] = 0x02;
+            memcpy(pkt + 4, hs.station, 6);
+            memcpy(pkt + 10, hs.bssid, 6);
+        } else {  // M2, M4: Station->AP (ToDS=1, FromDS=0)
+            pkt[1] = 0x01;
+            memcpy(pkt + 4, hs.bssid, 6);
+            memcpy(pkt + 10, hs.station, 6);
+        }
+        memcpy(pkt + 16, hs.bssid, 6);
+
+        // LLC/SNAP header (8 bytes)
+        static const uint8_t LLC_SNAP_EAPOL[] = {0xAA, 0xAA, 0x03, 0x00, 0x00, 0x00, 0x88, 0x8E};
+        memcpy(pkt + 24, LLC_SNAP_EAPOL, sizeof(LLC_SNAP_EAPOL));
+
+        if (32u + frame.len > sizeof(pkt)) continue;
+        memcpy(pkt + 32, full + frame.eapolOffset, frame.len);
+        writePCAPPacket(f, pkt, 32 + frame.len, frame.timestamp);
+        packetCount++;
+    }
+
+    f.close();
+    Serial.printf("[%s] PCAP saved: %s (%d packets%s, mask: %s%s%s%s)\n",
+                  tag, path, packetCount, beacon ? " incl. beacon" : "",
+                  hs.hasM1() ? "M1" : "", hs.hasM2() ? "M2" : "",
+                  hs.hasM3() ? "M3" : "", hs.hasM4() ? "M4" : "");
+    return true;
+}
+
+static void hexEncode(char* out, const uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        sprintf(out + i*2, "%02x", data[i]);
+    }
+    out[len * 2] = 0;
+}
+
+// ESSID (hex-encoded, max 32 chars = 64 hex + null)
+static void essidHexEncode(char* out, const char* ssid) {
+    size_t ssidLen = strlen(ssid);
+    if (ssidLen > 32) ssidLen = 32;  // Cap to max SSID length
+    hexEncode(out, (const uint8_t*)ssid, ssidLen);
+}
+
+// Hashcat 22000 handshake line:
+// WPA*02*MIC*MAC_AP*MAC_CLIENT*ESSID*NONCE_AP*EAPOL_CLIENT*MESSAGEPAIR
+//
+// Supported message pairs:
+// - 0x00: M1+M2 (ANonce from M1, EAPOL+MIC from M2) - most common
+// - 0x02: M2+M3 (ANonce from M3, EAPOL+MIC from M2) - fallback
+static bool saveHandshake22000(const CapturedHandshake& hs, const char* path, const char* tag) {
+    uint8_t msgPair = hs.getMessagePair();
+    if (msgPair == 0xFF) {
+        Serial.printf("[%s] No valid message pair for 22000 export\n", tag);
+        return false;
+    }
+
+    const EAPOLFrame* nonceFrame = &hs.frames[msgPair == 0x00 ? 0 : 2];  // M1 or M3 (ANonce)
+    const EAPOLFrame* eapolFrame = &hs.frames[1];                        // M2 (MIC + full EAPOL)
+
+    const uint8_t* nonceData = nonceFrame->eapol(CaptureStore::eapolPool);
+    const uint8_t* eapolData = eapolFrame->eapol(CaptureStore::eapolPool);
+
+    // MIC field is at offset 81-96 (16 bytes), so we need len >= 97 to read it safely
+    if (!nonceData || !eapolData || nonceFrame->len < 51 || eapolFrame->len < 97) {
+        Serial.printf("[%s] Frame too short for 22000 export (nonce:%d eapol:%d)\n",
+                      tag, nonceFrame->len, eapolFrame->len);
+        return false;
+    }
+
+    File f = SD.open(path, FILE_WRITE);
+    if (!f) {
+        Serial.printf("[%s] Failed to create 22000 file: %s\n", tag, path);
+        return false;
+    }
+
+    // EAPOL-Key: ver(1)+type(1)+len(2)+desc(1)+keyinfo(2)+keylen(2)+replay(8)+nonce(32)+iv(16)+rsc(8)+reserved(8)+MIC(16)
+    // Offsets: 0-3=EAPOL hdr, 4=desc, 5-6=keyinfo, 7-8=keylen, 9-16=replay, 17-48=nonce, 49-64=iv, 65-72=rsc, 73-80=reserved, 81-96=MIC
+    char micHex[33];
+    hexEncode(micHex, eapolData + 81, 16);
+    char macAP[13];
+    hexEncode(macAP, hs.bssid, 6);
+    char macClient[13];
+    hexEncode(macClient, hs.station, 6);
+    char essidHex[65];
+    essidHexEncode(essidHex, hs.ssid);
+    char nonceHex[65];
+    hexEncode(nonceHex, nonceData + 17, 32);  // ANonce from M1 or M3
+
+    // Full EAPOL frame from M2: length in bytes 2-3 (big-endian) + 4 bytes header
+    uint16_t eapolLen = (eapolData[2] << 8) | eapolData[3];
+    eapolLen += 4;
+    if (eapolLen > eapolFrame->len) eapolLen = eapolFrame->len;
+
+    // Zero the MIC in a copy for hashcat
+    uint8_t eapolCopy[512];
+    memcpy(eapolCopy, eapolData, eapolLen);
+    memset(eapolCopy + 81, 0, 16);
+
+    char* eapolHex = (char*)malloc(eapolLen * 2 + 1);
+    if (!eapolHex) {
+        f.close();
+        Serial.printf("[%s] OOM allocating EAPOL hex buffer\n", tag);
+        return false;
+    }
+    hexEncode(eapolHex, eapolCopy, eapolLen);
+
+    f.printf("WPA*02*%s*%s*%s*%s*%s*%s*%02x\n",
+             micHex, macAP, macClient, essidHex, nonceHex, eapolHex, msgPair);
+
+    free(eapolHex);
+    f.close();
+
+    Serial.printf("[%s] Handshake saved to %s (WPA*02, pair:%02x, hashcat -m 22000)\n",
+                  tag, path, msgPair);
+    return true;
+}
+
+// Hashcat 22000 PMKID line: WPA*01*PMKID*MAC_AP*MAC_CLIENT*ESSID***01
+// (MESSAGEPAIR 01 = PMKID taken from AP)
+static bool savePMKID22000(const CapturedPMKID& p, const char* path, const char* tag) {
+    File f = SD.open(path, FILE_WRITE);
+    if (!f) {
+        Serial.printf("[%s] Failed to create PMKID file: %s\n", tag, path);
+        return false;
+    }
+
+    char pmkidHex[33];
+    hexEncode(pmkidHex, p.pmkid, 16);
+    char macAP[13];
+    hexEncode(macAP, p.bssid, 6);
+    char macClient[13];
+    hexEncode(macClient, p.station, 6);
+    char essidHex[65];
+    essidHexEncode(essidHex, p.ssid);
+
+    f.printf("WPA*01*%s*%s*%s*%s***01\n", pmkidHex, macAP, macClient, essidHex);
+    f.close();
+    Serial.printf("[%s] PMKID saved to %s (hashcat -m 22000)\n", tag, path);
+    return true;
+}
+
+// SSID companion file next to a capture
+static void saveCompanionSSID(const uint8_t* bssid, const char* suffix, const char* ssid) {
+    char txtFilename[64];
+    snprintf(txtFilename, sizeof(txtFilename), "%s/%02X%02X%02X%02X%02X%02X%s.txt", CAPTURE_DIR,
+             bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5], suffix);
+    // Delete existing file first to ensure clean overwrite (FILE_WRITE appends on ESP32)
+    if (SD.exists(txtFilename)) {
+        SD.remove(txtFilename);
+    }
+    File txtFile = SD.open(txtFilename, FILE_WRITE);
+    if (txtFile) {
+        txtFile.println(ssid);
+        txtFile.close();
+    }
+}
+
+// ============ Save Pipeline ============
+
+bool CaptureStore::hasUnsaved(bool live) {
+    for (const auto& hs : handshakes) {
+        if (hs.isComplete() && !hs.saved && hs.saveAttempts < SAVE_MAX_ATTEMPTS &&
+            !beaconPending(hs, live)) {
+            return true;
+        }
+    }
+    // An SSID-less PMKID can't be saved yet; it waits for a beacon
+    for (const auto& p : pmkids) {
+        if (!p.saved && p.ssid[0] != 0 && p.saveAttempts < SAVE_MAX_ATTEMPTS) return true;
+    }
+    return false;
+}
+
+void CaptureStore::saveHandshakes(const char* tag, bool live) {
+    if (!Config::isSDAvailable()) return;
+
+    for (auto& hs : handshakes) {
+        if (hs.saved || !hs.isComplete() || hs.saveAttempts >= SAVE_MAX_ATTEMPTS) continue;
+        if (beaconPending(hs, live)) continue;  // Saved once the beacon lands
+        if (millis() - hs.lastSeen < SAVE_BACKOFF_MS[hs.saveAttempts]) continue;
+
+        if (hs.ssid[0] == 0 && backfillSSID(hs.bssid, hs.ssid, CaptureKind::HANDSHAKE)) {
+            Serial.printf("[%s] Handshake SSID backfill: %s\n", tag, hs.ssid);
+        }
+
+        hs.saveAttempts++;  // Increment before attempt
+
+        if (!SD.exists(CAPTURE_DIR)) {
+            SD.mkdir(CAPTURE_DIR);
+        }
+
+        // PCAP (WPA-SEC upload, wireshark) and 22000 (hashcat-ready, no conversion)
+        char pcapPath[64];
+        CaptureCatalog::capturePath(pcapPath, sizeof(pcapPath), hs.bssid, CaptureKind::PCAP);
+        bool pcapOk = saveHandshakePCAP(hs, pcapPath, tag);
+        char hsPath[64];
+        CaptureCatalog::capturePath(hsPath, sizeof(hsPath), hs.bssid, CaptureKind::HANDSHAKE);
+        bool hs22kOk = saveHandshake22000(hs, hsPath, tag);
+
+        if (pcapOk || hs22kOk) {
+            hs.saved = true;
+            hs.releaseFrames(eapolPool);  // On SD now; capturedMask keeps it counted
+            releaseBeacon(hs.bssid, hs.beaconRef);
+            saveCompanionSSID(hs.bssid, "", hs.ssid);
+            if (pcapOk) CaptureCatalog::noteSaved(hs.bssid, hs.station, CaptureKind::PCAP, hs.ssid, pcapPath);
+            if (hs22kOk) CaptureCatalog::noteSaved(hs.bssid, hs.station, CaptureKind::HANDSHAKE, hs.ssid, hsPath);
+            Serial.printf("[%s] Handshake saved: %s (pcap:%s 22000:%s)\n",
+                          tag, hs.ssid, pcapOk ? "OK" : "FAIL", hs22kOk ? "OK" : "FAIL");
+            SDLog::log(tag, "Handshake saved: %s (pcap:%s 22000:%s)",
+                       hs.ssid, pcapOk ? "OK" : "FAIL", hs22kOk ? "OK" : "FAIL");
+        } else if (hs.saveAttempts >= SAVE_MAX_ATTEMPTS) {
+            // Failed 3 times - give up to prevent infinite retry
+            Serial.printf("[%s] Failed to save %s after 3 attempts (SD issue?)\n", tag, hs.ssid);
+            SDLog::log(tag, "Save failed after 3 attempts: %s (kept in RAM)", hs.ssid);
+            hs.saved = true;  // Mark as done to stop retries (data still in RAM)
+            releaseBeacon(hs.bssid, hs.beaconRef);
+        }
+
+        // Yield to watchdog/scheduler after each save (prevents WDT during mass saves)
+        delay(1);
+    }
+}
+
+bool CaptureStore::savePMKIDs(const char* tag) {
+    if (!Config::isSDAvailable()) return false;
+
+    bool success = true;
+    for (auto& p : pmkids) {
+        if (p.saved || p.saveAttempts >= SAVE_MAX_ATTEMPTS) continue;
+
+        // SSID is REQUIRED for PMKID cracking - it's the salt for
+        // PBKDF2(passphrase, SSID). M1 may beat the beacon, so try again now;
+        // without one the PMKID stays in RAM until an SSID turns up.
+        if (p.ssid[0] == 0 && backfillSSID(p.bssid, p.ssid, CaptureKind::PMKID)) {
+            Serial.printf("[%s] PMKID SSID backfill: %s\n", tag, p.ssid);
+        }
+        if (p.ssid[0] == 0) continue;
+
+        if (millis() - p.timestamp < SAVE_BACKOFF_MS[p.saveAttempts]) continue;
+
+        // Some APs send an empty PMKID KDE: nothing to crack
+        bool allZeros = true;
+        for (int i = 0; i < 16; i++) {
+            if (p.pmkid[i] != 0) { allZeros = false; break; }
+        }
+        if (allZeros) {
+            p.saved = true;
+            releaseBeacon(p.bssid, p.beaconRef);
+            continue;
+        }
+
+        // Same PMKID from the same client already on the card (earlier
+        // session, or the other mode before a switch): nothing new to write
+        if (CaptureCatalog::hasPMKID(p.bssid, p.station, p.ssid)) {
+            p.saved = true;
+            releaseBeacon(p.bssid, p.beaconRef);
+            Serial.printf("[%s] PMKID already saved: %s\n", tag, p.ssid);
+            continue;
+        }
+
+        p.saveAttempts++;  // Increment before attempt
+
+        if (!SD.exists(CAPTURE_DIR)) {
+            SD.mkdir(CAPTURE_DIR);
+        }
+
+        char path[64];
+        CaptureCatalog::capturePath(path, sizeof(path), p.bssid, CaptureKind::PMKID);
+        if (savePMKID22000(p, path, tag)) {
+            p.saved = true;
+            releaseBeacon(p.bssid, p.beaconRef);
+            saveCompanionSSID(p.bssid, "_pmkid", p.ssid);
+            CaptureCatalog::noteSaved(p.bssid, p.station, CaptureKind::PMKID, p.ssid, path);
+            Serial.printf("[%s] PMKID saved: %s\n", tag, p.ssid);
+            SDLog::log(tag, "PMKID saved: %s (%s)", p.ssid, path);
+        } else {
+            if (p.saveAttempts >= SAVE_MAX_ATTEMPTS) {
+                // Failed 3 times - give up to prevent infinite retry
+                Serial.printf("[%s] Failed to save PMKID %s after 3 attempts (SD issue?)\n", tag, p.ssid);
+                SDLog::log(tag, "PMKID save failed after 3 attempts: %s (kept in RAM)", p.ssid);
+                p.saved = true;  // Mark as done to stop retries (data still in RAM)
+                releaseBeacon(p.bssid, p.beaconRef);
+            }
+            success = false;
+        }
+
+        // Yield to watchdog/scheduler after each save
+        delay(1);
+    }
+    return success;
+}
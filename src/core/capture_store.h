@@ -0,0 +1,198 @@
+// Capture Store - the capture tables and save pipeline OINK and DO NO HAM share
+// Main loop only, except frames.push() from the promiscuous callback.
+#pragma once
+
+#include <Arduino.h>
+#include <esp_wifi.h>
+#include <vector>
+#include "../ml/features.h"
+#include "bssid_index.h"
+#include "frame_ring.h"
+#include "eapol_pool.h"
+#include "beacon_cache.h"
+#include "mgmt_frame.h"
+#include "catalog_index.h"
+
+// Maximum clients to track per network
+#define MAX_CLIENTS_PER_NETWORK 20  // Dense environment support (conferences, airports)
+
+struct DetectedClient {
+    uint8_t mac[6];
+    int8_t rssi;
+    uint32_t lastSeen;
+};
+
+struct DetectedNetwork {
+    uint8_t bssid[6];
+    char ssid[33];
+    int8_t rssi;
+    uint8_t channel;
+    wifi_auth_mode_t authmode;
+    WiFiFeatures features;
+    uint32_t lastSeen;
+    uint16_t beaconCount;
+    bool isTarget;
+    bool hasPMF;  // Protected Management Frames (immune to deauth)
+    bool hasHandshake;  // Already captured handshake for this network
+    uint8_t attackAttempts;  // Number of attack attempts (for retry logic)
+    bool isHidden;  // Hidden SSID (needs probe response)
+    DetectedClient clients[MAX_CLIENTS_PER_NETWORK];
+    uint8_t clientCount;
+};
+
+// Longest 802.11 EAPOL frame kept: MAC header (<=30) + LLC (8) + 512 EAPOL + FCS
+static const uint16_t EAPOL_MAX_FRAME_LEN = 560;
+
+// Beacons kept for PCAP export (one per AP, ~300B each when full)
+static const size_t CAPTURE_BEACON_CACHE_SLOTS = 24;
+
+// Captured EAPOL-Key message. The full 802.11 frame (header + LLC + EAPOL)
+// lives in CaptureStore's EapolPool at its exact length; the EAPOL payload
+// hashcat 22000 needs is a slice of it.
+struct EAPOLFrame {
+    EapolHandle frame;       // Full 802.11 frame for PCAP
+    uint16_t eapolOffset;    // EAPOL payload start within the frame
+    uint16_t len;            // EAPOL payload length (0 = not captured)
+    uint8_t messageNum;      // 1-4
+    uint32_t timestamp;
+    int8_t rssi;             // Signal strength for radiotap header
+
+    const uint8_t* fullFrame(const EapolPool& pool) const { return pool.data(frame); }
+    const uint8_t* eapol(const EapolPool& pool) const {
+        const uint8_t* f = pool.data(frame);
+        return f ? f + eapolOffset : nullptr;
+    }
+
+    // Copy a received frame into the pool; EAPOL starts eapolOffset bytes in.
+    // False (frame left as it was) if the pool is full or the frame is bogus.
+    bool store(EapolPool& pool, const uint8_t* full, uint16_t fullLen, uint16_t eapolOff) {
+        if (fullLen > EAPOL_MAX_FRAME_LEN) fullLen = EAPOL_MAX_FRAME_LEN;
+        if (eapolOff >= fullLen) return false;
+        if (!pool.replace(frame, full, fullLen)) return false;
+        eapolOffset = eapolOff;
+        len = min((uint16_t)512, (uint16_t)(fullLen - eapolOff));
+        return true;
+    }
+
+    void release(EapolPool& pool) {
+        pool.release(frame);
+        len = 0;
+    }
+};
+
+struct CapturedHandshake {
+    uint8_t bssid[6];
+    uint8_t station[6];
+    char ssid[33];
+    EAPOLFrame frames[4];  // M1, M2, M3, M4 (bytes in CaptureStore's EapolPool)
+    uint8_t capturedMask;  // Bits 0-3 for M1-M4
+    uint32_t firstSeen;
+    uint32_t lastSeen;
+    bool saved;  // Already saved to SD
+    uint8_t saveAttempts;  // Number of save attempts (0-3, then give up)
+    bool beaconRef;  // Holds a reference on this BSSID in CaptureStore's BeaconCache
+
+    bool hasM1() const { return capturedMask & 0x01; }
+    bool hasM2() const { return capturedMask & 0x02; }
+    bool hasM3() const { return capturedMask & 0x04; }
+    bool hasM4() const { return capturedMask & 0x08; }
+
+    // Valid crackable pairs: M1+M2 (preferred) or M2+M3 (fallback if M1 missed)
+    bool hasValidPair() const { return (hasM1() && hasM2()) || (hasM2() && hasM3()); }
+    bool isComplete() const { return hasValidPair(); }  // Alias for backward compat
+    bool isFull() const { return (capturedMask & 0x0F) == 0x0F; }
+
+    // Hand the frames back to the pool once they're on SD; capturedMask stays
+    void releaseFrames(EapolPool& pool) {
+        for (int i = 0; i < 4; i++) frames[i].release(pool);
+    }
+
+    // Get message pair type for hashcat 22000 format:
+    // Returns 0x00 for M1+M2, 0x02 for M2+M3, 0xFF for invalid
+    uint8_t getMessagePair() const {
+        if (hasM1() && hasM2()) return 0x00;  // M1+M2: EAPOL from M2 (challenge)
+        if (hasM2() && hasM3()) return 0x02;  // M2+M3: EAPOL from M2 (authorized)
+        return 0xFF;  // Invalid
+    }
+};
+
+// PMKID capture - clientless attack, extracted from EAPOL M1
+struct CapturedPMKID {
+    uint8_t bssid[6];
+    uint8_t station[6];
+    char ssid[33];
+    uint8_t pmkid[16];
+    uint32_t timestamp;
+    bool saved;
+    uint8_t saveAttempts;  // Number of save attempts (0-3, then give up)
+    bool beaconRef;  // Holds a reference on this BSSID in the BeaconCache
+};
+
+class CaptureStore {
+public:
+    // One budget for both modes
+    static const size_t MAX_NETWORKS = 200;
+    static const size_t MAX_HANDSHAKES = 96;         // Frames live in eapolPool
+    static const size_t MAX_PMKIDS = 50;
+    static const size_t EAPOL_POOL_BYTES = 16 * 1024;  // ~50 unsaved M1+M2 pairs
+    static const size_t HEAP_MIN_FREE = 30000;       // No new networks below this
+    static const uint32_t BEACON_WAIT_MS = 1500;     // Max save delay while an AP's beacon is missing
+    static const size_t FRAME_RING_BYTES = 16384;    // ~50 typical beacons
+
+    // The tables. Modes index them directly; grow/erase from update() only.
+    static std::vector<DetectedNetwork> networks;
+    static BssidIndex<512, DetectedNetwork> networkIndex;   // networks by BSSID
+    static std::vector<CapturedHandshake> handshakes;
+    static BssidIndex<128, CapturedHandshake> pwnedIndex;   // First complete handshake per BSSID
+    static std::vector<CapturedPMKID> pmkids;
+    static EapolPool eapolPool;  // EAPOL frame bytes for handshakes
+    static BeaconCache<CAPTURE_BEACON_CACHE_SLOTS> beaconCache;  // Target + every AP a capture waits on
+    static FrameRing<FRAME_RING_BYTES> frames;  // Callback -> update(), SPSC
+
+    // Drop everything and give the memory back
+    static void clear();
+    // Between sessions: unsaved captures keep their frames and beacons
+    static void trim();
+
+    // Networks
+    static int findNetwork(const uint8_t* bssid) { return networkIndex.find(bssid); }
+    static bool hasHandshakeFor(const uint8_t* bssid) { return pwnedIndex.find(bssid) >= 0; }
+    // Fill a network record from a parsed beacon (no table access: callback safe)
+    static void networkFromBeacon(const MgmtFrameView& beacon, int8_t rssi, uint8_t channel,
+                                  DetectedNetwork& net);
+    // Append a new network; -1 when the table is full or the heap is low
+    static int addNetwork(const DetectedNetwork& net);
+    // Another beacon from networks[idx]: signal, time, PMF, missing SSID
+    static void refreshNetwork(int idx, const DetectedNetwork& seen);
+    // Give a PMKID that was captured before its AP's SSID was known the SSID
+    static void backfillPMKIDs(const uint8_t* bssid, const char* ssid);
+
+    // Captures. -1 when the table is full or the AP is a BOAR BRO.
+    static int findOrCreateHandshake(const uint8_t* bssid, const uint8_t* station);
+    static int findOrCreatePMKID(const uint8_t* bssid, const uint8_t* station);
+    // Store EAPOL message msgNum (1-4) of handshakes[idx]; false if the pool is full
+    static bool addFrame(int idx, uint8_t msgNum, const uint8_t* frame, uint16_t len,
+                         uint16_t eapolOffset, int8_t rssi);
+    static uint16_t completeHandshakeCount();
+
+    // Save pipeline (SD; callers pause promiscuous mode around it). tag is
+    // the calling mode's log prefix. live = the mode is still capturing, so
+    // a fresh handshake may wait up to BEACON_WAIT_MS for its AP's beacon.
+    static bool hasUnsaved(bool live);
+    static void saveHandshakes(const char* tag, bool live);
+    static bool savePMKIDs(const char* tag);
+
+    // A save is being held for a beacon. holdExpired() reports (once) that
+    // the deadline passed; saving re-arms it for anything still waiting.
+    static bool holding() { return holdUntil != 0; }
+    static bool holdExpired(uint32_t now);
+    static void releaseHold() { holdUntil = 0; }
+
+private:
+    static uint32_t holdUntil;  // Nonzero: a handshake save is holding for its beacon
+
+    static void reserveEapolPool();
+    static bool beaconPending(const CapturedHandshake& hs, bool live);
+    static void releaseBeacon(const uint8_t* bssid, bool& ref);
+    static bool backfillSSID(const uint8_t* bssid, char* ssid, CaptureKind kind);
+};
@@ -0,0 +1,480 @@
+// Catalog Index - append-only record file + sorted RAM index of saved captures
+// Main loop only. rebuild() regenerates it from a directory scan.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+enum class CaptureKind : uint8_t {
+    PCAP = 0,       // BSSID.pcap
+    HANDSHAKE = 1,  // BSSID_hs.22000
+    PMKID = 2       // BSSID.22000
+};
+
+#pragma pack(push, 1)
+struct CatalogRecord {
+    uint8_t bssid[6];
+    uint8_t station[6];     // Zero when unknown
+    uint8_t kind;           // CaptureKind
+    uint8_t flags;          // CatalogRecord::TOMBSTONE
+    char ssid[33];          // NUL-terminated
+    uint8_t pad;
+    uint32_t timestamp;     // Capture file mtime
+    uint32_t fileSize;
+    uint8_t reserved[8];
+
+    static const uint8_t TOMBSTONE = 0x01;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(CatalogRecord) == 64, "CatalogRecord must stay 64 bytes on the card");
+
+struct CatalogEntry {
+    uint8_t bssid[6];
+    uint8_t kind;
+    uint8_t flags;
+    uint32_t timestamp;
+    uint32_t offset;        // Record position in the catalog file
+};
+
+struct CatalogStats {
+    uint32_t live;          // Captures in the index
+    uint32_t dead;          // Superseded records + tombstones in the file
+    uint32_t appends;       // Records written since load
+    uint32_t compactions;   // File rewrites
+    uint32_t rebuildFiles;  // Capture files found by the last rebuild
+    uint32_t skipped;       // Torn records ignored at load
+};
+
+template <typename FsT, typename FileT>
+class CatalogIndex {
+public:
+    static const uint32_t MAGIC = 0x54414B50;  // "PKAT"
+    static const uint16_t VERSION = 1;
+    static const size_t HEADER_SIZE = 16;
+    static const size_t RECORD_SIZE = sizeof(CatalogRecord);
+    static const size_t MAX_PATH = 48;
+    static const uint32_t COMPACT_MIN_DEAD = 64;
+
+    CatalogIndex() : fs(nullptr), fileBytes(0) { reset(); }
+
+    CatalogIndex(const CatalogIndex&) = delete;
+    CatalogIndex& operator=(const CatalogIndex&) = delete;
+
+    // Read the catalog at path into the index. False when it is missing,
+    // from another version or unreadable: the caller should rebuild().
+    bool load(FsT& fsys, const char* path) {
+        end();
+        if (!setPath(fsys, path)) return false;
+        FileT f = fs->open(catalogPath, "r");
+        if (!f) return false;
+        uint8_t hdr[HEADER_SIZE];
+        if (f.read(hdr, HEADER_SIZE) != HEADER_SIZE || !headerValid(hdr)) {
+            f.close();
+            return false;
+        }
+        size_t total = f.size();
+        size_t records = (total - HEADER_SIZE) / RECORD_SIZE;
+        st.skipped = ((total - HEADER_SIZE) % RECORD_SIZE) ? 1 : 0;
+
+        std::vector<CatalogEntry> raw;
+        raw.reserve(records);
+        bool ok = readRecords(f, records, [&](const CatalogRecord& r, uint32_t off) {
+            CatalogEntry e;
+            memcpy(e.bssid, r.bssid, 6);
+            e.kind = r.kind;
+            e.flags = r.flags;
+            e.timestamp = r.timestamp;
+            e.offset = off;
+            raw.push_back(e);
+        });
+        f.close();
+        if (!ok) return false;
+
+        // Newest record per key wins; tombstones then drop out
+        std::stable_sort(raw.begin(), raw.end(), keyLess);
+        entries.clear();
+        for (size_t i = 0; i < raw.size(); i++) {
+            if (i + 1 < raw.size() && sameKey(raw[i], raw[i + 1])) continue;
+            if (raw[i].flags & CatalogRecord::TOMBSTONE) continue;
+            entries.push_back(raw[i]);
+        }
+        entries.shrink_to_fit();
+        fileBytes = HEADER_SIZE + records * RECORD_SIZE;  // A torn tail gets overwritten
+        st.live = entries.size();
+        st.dead = records - entries.size();
+        ready = true;
+        return true;
+    }
+
+    // Scan dir for capture files and write a fresh catalog at path. SSIDs
+    // come from the companion .txt files, stations from the .22000 lines.
+    bool rebuild(FsT& fsys, const char* path, const char* dir) {
+        end();
+        if (!setPath(fsys, path)) return false;
+        char tmpPath[MAX_PATH + 4];
+        snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", catalogPath);
+        FileT out = fs->open(tmpPath, "w");
+        if (!out) return false;
+        bool ok = writeHeader(out);
+        uint32_t off = HEADER_SIZE;
+        std::vector<CatalogEntry> found;
+
+        FileT d = fs->open(dir, "r");
+        if (d && d.isDirectory()) {
+            FileT file = d.openNextFile();
+            while (file && ok) {
+                CatalogRecord r;
+                memset(&r, 0, sizeof(r));
+                CaptureKind kind;
+                if (!file.isDirectory() && parseName(file.name(), r.bssid, kind)) {
+                    r.kind = (uint8_t)kind;
+                    r.timestamp = (uint32_t)file.getLastWrite();
+                    r.fileSize = (uint32_t)file.size();
+                    if (kind != CaptureKind::PCAP) readStation(file, r.station);
+                    file.close();
+                    readCompanionSSID(dir, r);
+                    ok = out.write((const uint8_t*)&r, RECORD_SIZE) == RECORD_SIZE;
+                    found.push_back(entryFor(r, off));
+                    off += RECORD_SIZE;
+                }
+                file = d.openNextFile();
+            }
+        }
+        if (d) d.close();
+        out.close();
+        if (!ok) {
+            fs->remove(tmpPath);
+            return false;
+        }
+        if (fs->exists(catalogPath)) fs->remove(catalogPath);
+        if (!fs->rename(tmpPath, catalogPath)) return false;
+
+        std::sort(found.begin(), found.end(), keyLess);
+        entries.swap(found);
+        fileBytes = off;
+        st.rebuildFiles = entries.size();
+        st.live = entries.size();
+        ready = true;
+        return true;
+    }
+
+    // Drop the index (the file stays)
+    void end() {
+        entries.clear();
+        entries.shrink_to_fit();
+        fs = nullptr;
+        fileBytes = 0;
+        reset();
+    }
+
+    bool loaded() const { return ready; }
+    size_t size() const { return entries.size(); }
+    const CatalogEntry& entry(size_t i) const { return entries[i]; }
+
+    // Index of the capture, or -1
+    int find(const uint8_t* bssid, CaptureKind kind) const {
+        CatalogEntry key;
+        memcpy(key.bssid, bssid, 6);
+        key.kind = (uint8_t)kind;
+        auto it = std::lower_bound(entries.begin(), entries.end(), key, keyLess);
+        if (it == entries.end() || !sameKey(*it, key)) return -1;
+        return (int)(it - entries.begin());
+    }
+
+    bool has(const uint8_t* bssid, CaptureKind kind) const { return find(bssid, kind) >= 0; }
+
+    // Full record for one capture (one seek + read on the card)
+    bool get(const uint8_t* bssid, CaptureKind kind, CatalogRecord& out) {
+        int i = find(bssid, kind);
+        if (i < 0) return false;
+        FileT f = fs->open(catalogPath, "r");
+        if (!f) return false;
+        bool ok = f.seek(entries[i].offset) &&
+                  f.read((uint8_t*)&out, RECORD_SIZE) == RECORD_SIZE;
+        f.close();
+        return ok;
+    }
+
+    // Add or replace the record for rec's BSSID+kind
+    bool put(const CatalogRecord& rec) {
+        if (!ready) return false;
+        CatalogRecord r = rec;
+        r.flags &= ~CatalogRecord::TOMBSTONE;
+        r.ssid[32] = '\0';
+        if (!append(r)) return false;
+        CatalogEntry e = entryFor(r, fileBytes - RECORD_SIZE);
+        auto it = std::lower_bound(entries.begin(), entries.end(), e, keyLess);
+        if (it != entries.end() && sameKey(*it, e)) {
+            *it = e;
+            st.dead++;
+        } else {
+            entries.insert(it, e);
+        }
+        st.live = entries.size();
+        compactIfNeeded();
+        return true;
+    }
+
+    // Forget one capture; false if it was not in the index
+    bool remove(const uint8_t* bssid, CaptureKind kind) {
+        int i = find(bssid, kind);
+        if (i < 0) return false;
+        CatalogRecord r;
+        memset(&r, 0, sizeof(r));
+        memcpy(r.bssid, bssid, 6);
+        r.kind = (uint8_t)kind;
+        r.flags = CatalogRecord::TOMBSTONE;
+        if (!append(r)) return false;
+        entries.erase(entries.begin() + i);
+        st.live = entries.size();
+        st.dead += 2;
+        compactIfNeeded();
+        return true;
+    }
+
+    // Empty catalog (everything deleted)
+    bool clear() {
+        if (!fs) return false;
+        FileT f = fs->open(catalogPath, "w");
+        if (!f) return false;
+        bool ok = writeHeader(f);
+        f.close();
+        entries.clear();
+        entries.shrink_to_fit();
+        fileBytes = HEADER_SIZE;
+        st.live = st.dead = 0;
+        ready = ok;
+        return ok;
+    }
+
+    // Call fn(const CatalogRecord&) for every live capture, in file order,
+    // reading the catalog sequentially once
+    template <typename Fn>
+    bool forEachLive(Fn fn) {
+        if (!ready) return false;
+        FileT f = fs->open(catalogPath, "r");
+        if (!f) return false;
+        bool ok = f.seek(HEADER_SIZE) &&
+                  readRecords(f, (fileBytes - HEADER_SIZE) / RECORD_SIZE,
+                              [&](const CatalogRecord& r, uint32_t off) {
+            if (isLive(r, off)) fn(r);
+        });
+        f.close();
+        return ok;
+    }
+
+    // Rewrite the file without superseded records once they outnumber
+    // the live ones
+    bool compactIfNeeded() {
+        if (st.dead < COMPACT_MIN_DEAD || st.dead <= st.live) return false;
+        return compact();
+    }
+
+    bool compact() {
+        if (!ready) return false;
+        char tmpPath[MAX_PATH + 4];
+        snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", catalogPath);
+        FileT out = fs->open(tmpPath, "w");
+        if (!out) return false;
+        bool ok = writeHeader(out);
+        uint32_t off = HEADER_SIZE;
+        std::vector<uint32_t> newOffsets(entries.size(), 0);
+        bool wrote = ok;
+        ok = ok && forEachLive([&](const CatalogRecord& r) {
+            if (!wrote) return;
+            wrote = out.write((const uint8_t*)&r, RECORD_SIZE) == RECORD_SIZE;
+            newOffsets[find(r.bssid, (CaptureKind)r.kind)] = off;
+            off += RECORD_SIZE;
+        });
+        ok = ok && wrote;
+        out.close();
+        if (!ok) {
+            fs->remove(tmpPath);
+            return false;
+        }
+        fs->remove(catalogPath);
+        if (!fs->rename(tmpPath, catalogPath)) {
+            ready = false;  // Old file gone, new one stranded: force a rebuild
+            return false;
+        }
+        for (size_t i = 0; i < entries.size(); i++) entries[i].offset = newOffsets[i];
+        fileBytes = off;
+        st.dead = 0;
+        st.compactions++;
+        return true;
+    }
+
+    CatalogStats stats() const { return st; }
+
+    // "64EEB7208286.pcap" / "64EEB7208286_hs.22000" / "64EEB7208286.22000"
+    static bool parseName(const char* name, uint8_t bssid[6], CaptureKind& kind) {
+        if (!name) return false;
+        const char* slash = strrchr(name, '/');
+        if (slash) name = slash + 1;
+        for (int i = 0; i < 6; i++) {
+            int hi = hexVal(name[i * 2]);
+            int lo = hi < 0 ? -1 : hexVal(name[i * 2 + 1]);
+            if (lo < 0) return false;
+            bssid[i] = (uint8_t)(hi << 4 | lo);
+        }
+        const char* ext = name + 12;
+        if (strcmp(ext, ".pcap") == 0) kind = CaptureKind::PCAP;
+        else if (strcmp(ext, "_hs.22000") == 0) kind = CaptureKind::HANDSHAKE;
+        else if (strcmp(ext, ".22000") == 0) kind = CaptureKind::PMKID;
+        else return false;
+        return true;
+    }
+
+private:
+    static bool keyLess(const CatalogEntry& a, const CatalogEntry& b) {
+        int c = memcmp(a.bssid, b.bssid, 6);
+        return c < 0 || (c == 0 && a.kind < b.kind);
+    }
+
+    static bool sameKey(const CatalogEntry& a, const CatalogEntry& b) {
+        return a.kind == b.kind && memcmp(a.bssid, b.bssid, 6) == 0;
+    }
+
+    static CatalogEntry entryFor(const CatalogRecord& r, uint32_t off) {
+        CatalogEntry e;
+        memcpy(e.bssid, r.bssid, 6);
+        e.kind = r.kind;
+        e.flags = r.flags;
+        e.timestamp = r.timestamp;
+        e.offset = off;
+        return e;
+    }
+
+    static int hexVal(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        return -1;
+    }
+
+    bool isLive(const CatalogRecord& r, uint32_t off) const {
+        if (r.flags & CatalogRecord::TOMBSTONE) return false;
+        int i = find(r.bssid, (CaptureKind)r.kind);
+        return i >= 0 && entries[i].offset == off;
+    }
+
+    bool setPath(FsT& fsys, const char* path) {
+        if (!path || strlen(path) >= MAX_PATH) return false;
+        fs = &fsys;
+        strcpy(catalogPath, path);
+        return true;
+    }
+
+    bool headerValid(const uint8_t* hdr) const {
+        uint32_t magic;
+        uint16_t version, recSize;
+        memcpy(&magic, hdr, 4);
+        memcpy(&version, hdr + 4, 2);
+        memcpy(&recSize, hdr + 6, 2);
+        return magic == MAGIC && version == VERSION && recSize == RECORD_SIZE;
+    }
+
+    bool writeHeader(FileT& f) {
+        uint8_t hdr[HEADER_SIZE];
+        memset(hdr, 0, sizeof(hdr));
+        uint32_t magic = MAGIC;
+        uint16_t version = VERSION, recSize = RECORD_SIZE;
+        memcpy(hdr, &magic, 4);
+        memcpy(hdr + 4, &version, 2);
+        memcpy(hdr + 6, &recSize, 2);
+        return f.write(hdr, HEADER_SIZE) == HEADER_SIZE;
+    }
+
+    // Sequential read in 32-record chunks; fn(record, offset)
+    template <typename Fn>
+    bool readRecords(FileT& f, size_t count, Fn fn) {
+        const size_t CHUNK = 32;
+        CatalogRecord* chunk = (CatalogRecord*)malloc(CHUNK * RECORD_SIZE);
+        if (!chunk) return false;
+        uint32_t off = HEADER_SIZE;
+        bool ok = true;
+        while (count > 0) {
+            size_t n = count < CHUNK ? count : CHUNK;
+            if (f.read((uint8_t*)chunk, n * RECORD_SIZE) != n * RECORD_SIZE) {
+                ok = false;
+                break;
+            }
+            for (size_t i = 0; i < n; i++) {
+                fn(chunk[i], off);
+                off += RECORD_SIZE;
+            }
+            count -= n;
+        }
+        free(chunk);
+        return ok;
+    }
+
+    bool append(const CatalogRecord& r) {
+        FileT f = fs->open(catalogPath, "r+");
+        if (!f) return false;
+        bool ok = f.seek(fileBytes) &&
+                  f.write((const uint8_t*)&r, RECORD_SIZE) == RECORD_SIZE;
+        f.close();
+        if (!ok) return false;
+        fileBytes += RECORD_SIZE;
+        st.appends++;
+        return true;
+    }
+
+    // WPA*01*PMKID*MAC_AP*MAC_CLIENT*... / WPA*02*MIC*MAC_AP*MAC_CLIENT*...
+    static void readStation(FileT& f, uint8_t station[6]) {
+        char line[112];
+        size_t n = f.read((uint8_t*)line, sizeof(line) - 1);
+        line[n] = '\0';
+        const char* p = line;
+        for (int field = 0; field < 4 && p; field++) {
+            p = strchr(p, '*');
+            if (p) p++;
+        }
+        if (!p || strlen(p) < 12) return;
+        for (int i = 0; i < 6; i++) {
+            int hi = hexVal(p[i * 2]);
+            int lo = hexVal(p[i * 2 + 1]);
+            if (hi < 0 || lo < 0) {
+                memset(station, 0, 6);
+                return;
+            }
+            station[i] = (uint8_t)(hi << 4 | lo);
+        }
+    }
+
+    // PMKIDs keep their SSID in BSSID_pmkid.txt, handshakes in BSSID.txt
+    void readCompanionSSID(const char* dir, CatalogRecord& r) {
+        char txtPath[MAX_PATH + 24];
+        snprintf(txtPath, sizeof(txtPath), "%s/%02X%02X%02X%02X%02X%02X%s.txt", dir,
+                 r.bssid[0], r.bssid[1], r.bssid[2], r.bssid[3], r.bssid[4], r.bssid[5],
+                 r.kind == (uint8_t)CaptureKind::PMKID ? "_pmkid" : "");
+        if (!fs->exists(txtPath)) return;
+        FileT t = fs->open(txtPath, "r");
+        if (!t) return;
+        size_t n = t.read((uint8_t*)r.ssid, sizeof(r.ssid) - 1);
+        t.close();
+        r.ssid[n] = '\0';
+        char* eol = strpbrk(r.ssid, "\r\n");
+        if (eol) *eol = '\0';
+    }
+
+    void reset() {
+        memset(&st, 0, sizeof(st));
+        ready = false;
+        catalogPath[0] = '\0';
+    }
+
+    FsT* fs;
+    std::vector<CatalogEntry> entries;
+    size_t fileBytes;
+    bool ready;
+    char catalogPath[MAX_PATH];
+    CatalogStats st;
+};
@@ -28,6 +28,9 @@ bool Config::init() {
     // M5Cardputer handles SD initialization via M5.begin()
     // SD is on the built-in SD card slot (GPIO 12 for CS)
     // Retry with progressive SPI speeds for reliability
+    // SD.begin leaves max_files at 5. Held for a session: the SD log file,
+    // plus OINK's .pcapng with session capture on. WARHOG's writers and
+    // /oui.bin are only open for one write or lookup.
     sdAvailable = false;
     const int maxRetries = 3;
     const uint32_t speeds[] = {10000000, 20000000, 25000000};  // 10MHz, 20MHz, 25MHz
@@ -179,6 +182,7 @@ bool Config::load() {
         wifiConfig.lockTime = doc["wifi"]["lockTime"] | 12000;
         wifiConfig.enableDeauth = doc["wifi"]["enableDeauth"] | true;
         wifiConfig.randomizeMAC = doc["wifi"]["randomizeMAC"] | true;
+        wifiConfig.sessionCapture = doc["wifi"]["sessionCapture"] | false;
         wifiConfig.otaSSID = doc["wifi"]["otaSSID"] | "";
         wifiConfig.otaPassword = doc["wifi"]["otaPassword"] | "";
         wifiConfig.autoConnect = doc["wifi"]["autoConnect"] | false;
@@ -292,6 +296,7 @@ bool Config::save() {
     doc["wifi"]["lockTime"] = wifiConfig.lockTime;
     doc["wifi"]["enableDeauth"] = wifiConfig.enableDeauth;
     doc["wifi"]["randomizeMAC"] = wifiConfig.randomizeMAC;
+    doc["wifi"]["sessionCapture"] = wifiConfig.sessionCapture;
     doc["wifi"]["otaSSID"] = wifiConfig.otaSSID;
     doc["wifi"]["otaPassword"] = wifiConfig.otaPassword;
     doc["wifi"]["autoConnect"] = wifiConfig.autoConnect;
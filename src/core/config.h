@@ -43,6 +43,7 @@ struct WiFiConfig {
     uint16_t lockTime = 12000;          // Time to discover clients before attacking (12s optimal, buffed 13s)
     bool enableDeauth = true;
     bool randomizeMAC = true;           // Randomize MAC on mode start for stealth
+    bool sessionCapture = false;        // OINK appends beacons/probe resp/EAPOL to one .pcapng per session
     String otaSSID = "";
     String otaPassword = "";
     bool autoConnect = false;
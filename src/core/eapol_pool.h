@@ -0,0 +1,203 @@
+// EAPOL Pool - fixed arena for captured EAPOL frames, addressed by 4-byte handles
+// First-fit over 32-byte chunks. Main loop only.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Handle into an EapolPool: first chunk + exact byte length (len 0 = empty)
+struct EapolHandle {
+    uint16_t chunk;
+    uint16_t len;
+
+    bool valid() const { return len != 0; }
+};
+
+struct EapolPoolStats {
+    uint32_t capacity;      // Arena bytes (0 = no arena)
+    uint32_t used;          // Bytes in allocated chunks, rounding included
+    uint32_t payload;       // Exact frame bytes stored
+    uint32_t peakUsed;      // High water of used
+    uint32_t largestFree;   // Biggest contiguous free run in bytes
+    uint16_t frames;        // Live allocations
+    uint16_t failed;        // Stores that did not fit
+    uint8_t fragmentation;  // % of free bytes outside the largest run
+};
+
+class EapolPool {
+public:
+    static const uint16_t CHUNK_SIZE = 32;
+
+    EapolPool() : arena(nullptr), bitmap(nullptr), chunkCount(0) { resetCounters(); }
+    ~EapolPool() { end(); }
+
+    EapolPool(const EapolPool&) = delete;
+    EapolPool& operator=(const EapolPool&) = delete;
+
+    // Allocate the arena. Halves the request on OOM down to minBytes; true
+    // if any arena is available (an existing one is kept as is).
+    bool begin(size_t bytes, size_t minBytes = 4096) {
+        if (arena) return true;
+        size_t maxBytes = (size_t)0xFFFF * CHUNK_SIZE;
+        if (bytes > maxBytes) bytes = maxBytes;
+        while (bytes >= minBytes && bytes >= CHUNK_SIZE) {
+            size_t chunks = bytes / CHUNK_SIZE;
+            size_t words = (chunks + 31) / 32;
+            uint8_t* mem = (uint8_t*)malloc(chunks * CHUNK_SIZE + words * sizeof(uint32_t));
+            if (mem) {
+                arena = mem;
+                bitmap = (uint32_t*)(mem + chunks * CHUNK_SIZE);
+                chunkCount = (uint16_t)chunks;
+                reset();
+                return true;
+            }
+            bytes /= 2;
+        }
+        return false;
+    }
+
+    // Free the arena; every outstanding handle becomes invalid
+    void end() {
+        free(arena);
+        arena = nullptr;
+        bitmap = nullptr;
+        chunkCount = 0;
+        resetCounters();
+    }
+
+    // Drop all frames, keep the arena
+    void reset() {
+        if (bitmap) memset(bitmap, 0, ((chunkCount + 31) / 32) * sizeof(uint32_t));
+        resetCounters();
+    }
+
+    bool isReady() const { return arena != nullptr; }
+    uint16_t frameCount() const { return liveFrames; }
+
+    // Store len bytes into h, replacing whatever h held. Shrinks in place
+    // when the new frame fits the old chunks. On failure h is untouched, so
+    // a retransmitted frame that doesn't fit never costs the one we had.
+    bool replace(EapolHandle& h, const uint8_t* data, uint16_t len) {
+        if (!arena || len == 0) return false;
+        uint16_t need = chunksFor(len);
+
+        if (h.valid()) {
+            uint16_t have = chunksFor(h.len);
+            if (need <= have) {
+                markRange(h.chunk + need, have - need, false);
+                memcpy(arena + (size_t)h.chunk * CHUNK_SIZE, data, len);
+                payloadBytes = payloadBytes - h.len + len;
+                usedChunks -= have - need;
+                h.len = len;
+                return true;
+            }
+        }
+
+        int start = findRun(need);
+        if (start < 0) {
+            if (failedStores < 0xFFFF) failedStores++;
+            return false;
+        }
+        markRange((uint16_t)start, need, true);
+        memcpy(arena + (size_t)start * CHUNK_SIZE, data, len);
+        usedChunks += need;
+        payloadBytes += len;
+        liveFrames++;
+        if (usedChunks > peakChunks) peakChunks = usedChunks;
+
+        release(h);
+        h.chunk = (uint16_t)start;
+        h.len = len;
+        return true;
+    }
+
+    void release(EapolHandle& h) {
+        if (!h.valid()) return;
+        if (arena) {
+            uint16_t n = chunksFor(h.len);
+            markRange(h.chunk, n, false);
+            usedChunks -= n;
+            payloadBytes -= h.len;
+            liveFrames--;
+        }
+        h.chunk = 0;
+        h.len = 0;
+    }
+
+    // Bytes behind a handle, nullptr if empty
+    const uint8_t* data(const EapolHandle& h) const {
+        if (!arena || !h.valid()) return nullptr;
+        return arena + (size_t)h.chunk * CHUNK_SIZE;
+    }
+
+    EapolPoolStats stats() const {
+        EapolPoolStats s;
+        s.capacity = (uint32_t)chunkCount * CHUNK_SIZE;
+        s.used = usedChunks * CHUNK_SIZE;
+        s.payload = payloadBytes;
+        s.peakUsed = peakChunks * CHUNK_SIZE;
+        s.frames = liveFrames;
+        s.failed = failedStores;
+
+        uint32_t run = 0, best = 0;
+        for (uint16_t c = 0; c < chunkCount; c++) {
+            if (isSet(c)) {
+                run = 0;
+            } else if (++run > best) {
+                best = run;
+            }
+        }
+        s.largestFree = best * CHUNK_SIZE;
+        uint32_t freeBytes = s.capacity - s.used;
+        s.fragmentation = freeBytes ? (uint8_t)(100 - (uint64_t)s.largestFree * 100 / freeBytes) : 0;
+        return s;
+    }
+
+private:
+    static uint16_t chunksFor(uint16_t len) { return (uint16_t)((len + CHUNK_SIZE - 1) / CHUNK_SIZE); }
+
+    bool isSet(uint16_t c) const { return (bitmap[c >> 5] >> (c & 31)) & 1; }
+
+    void markRange(uint16_t start, uint16_t count, bool used) {
+        for (uint16_t c = start; c < start + count; c++) {
+            if (used) bitmap[c >> 5] |= (1u << (c & 31));
+            else bitmap[c >> 5] &= ~(1u << (c & 31));
+        }
+    }
+
+    // First free run of n chunks, skipping full words
+    int findRun(uint16_t n) const {
+        uint32_t run = 0;
+        for (uint32_t c = 0; c < chunkCount; c++) {
+            if ((c & 31) == 0 && run == 0 && bitmap[c >> 5] == 0xFFFFFFFFu) {
+                c += 31;
+                continue;
+            }
+            if (isSet((uint16_t)c)) {
+                run = 0;
+            } else if (++run == n) {
+                return (int)(c + 1 - n);
+            }
+        }
+        return -1;
+    }
+
+    void resetCounters() {
+        usedChunks = 0;
+        peakChunks = 0;
+        payloadBytes = 0;
+        liveFrames = 0;
+        failedStores = 0;
+    }
+
+    uint8_t* arena;
+    uint32_t* bitmap;
+    uint16_t chunkCount;
+    uint32_t usedChunks;
+    uint32_t peakChunks;
+    uint32_t payloadBytes;
+    uint16_t liveFrames;
+    uint16_t failedStores;
+};
@@ -0,0 +1,195 @@
+// Frame Ring - lock-free SPSC frame handoff, WiFi callback -> main loop update()
+// Variable-length records back to back in a fixed buffer; no heap, no locks.
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Compact per-frame header stored in front of the frame bytes
+struct FrameRecord {
+    uint16_t len;        // Bytes stored after this header
+    uint16_t origLen;    // Frame length on air (>= len when snapshot was truncated)
+    int8_t rssi;
+    uint8_t type;        // wifi_promiscuous_pkt_type_t
+    uint8_t channel;
+    uint8_t flags;       // Producer-defined
+    uint32_t timestamp;  // millis() when captured
+
+    const uint8_t* data() const { return reinterpret_cast<const uint8_t*>(this + 1); }
+};
+
+// Counters are written by one side only, so plain 32-bit loads are tear-free
+struct FrameRingStats {
+    uint32_t pushed;         // Records accepted by push()
+    uint32_t popped;         // Records consumed by pop()/drain()
+    uint32_t droppedFull;    // push() rejected: not enough free space
+    uint32_t droppedBytes;   // Payload bytes lost to droppedFull
+    uint32_t droppedOversize; // push() rejected: record larger than maxRecordSize()
+    uint32_t highWater;      // Peak bytes in use
+};
+
+template <size_t CAPACITY>
+class FrameRing {
+    static_assert(CAPACITY >= 256 && (CAPACITY & (CAPACITY - 1)) == 0,
+                  "FrameRing capacity must be a power of two >= 256");
+
+public:
+    static constexpr size_t ALIGN = 4;
+    static constexpr uint16_t WRAP_MARKER = 0xFFFF;
+
+    FrameRing() : head(0), tail(0) { resetStats(); }
+
+    // Largest record accepted, header included. A quarter of the ring keeps
+    // one oversized frame from starving everything queued behind it.
+    static constexpr size_t maxRecordSize() { return CAPACITY / 4; }
+    static constexpr size_t capacity() { return CAPACITY; }
+
+    static constexpr size_t recordSize(uint16_t len) {
+        return (sizeof(FrameRecord) + len + ALIGN - 1) & ~(ALIGN - 1);
+    }
+
+    // ---- Producer side ----
+
+    // Copy `len` bytes of `data` plus the metadata in `meta` into the ring.
+    // `reserve` bytes must remain free after the push; low-priority frames
+    // (beacons) use this to leave headroom for EAPOL.
+    bool push(const FrameRecord& meta, const uint8_t* data, uint16_t len, size_t reserve = 0) {
+        size_t need = recordSize(len);
+        if (len == WRAP_MARKER || need > maxRecordSize()) {
+            bump(statOversize);
+            return false;
+        }
+
+        uint32_t h = head.load(std::memory_order_relaxed);
+        uint32_t t = tail.load(std::memory_order_acquire);
+        size_t used = h - t;
+        size_t pos = h & (CAPACITY - 1);
+        size_t contiguous = CAPACITY - pos;
+        size_t pad = (contiguous < need) ? contiguous : 0;
+
+        if (used + pad + need + reserve > CAPACITY) {
+            bump(statFull);
+            statFullBytes.store(statFullBytes.load(std::memory_order_relaxed) + len,
+                                std::memory_order_relaxed);
+            return false;
+        }
+
+        if (pad) {
+            // Tail end too short for this record: mark it skipped and wrap.
+            // Gaps smaller than a header are skipped implicitly by the consumer.
+            if (pad >= sizeof(FrameRecord)) {
+                FrameRecord* marker = reinterpret_cast<FrameRecord*>(buffer + pos);
+                marker->len = WRAP_MARKER;
+            }
+            h += pad;
+            pos = 0;
+        }
+
+        FrameRecord* rec = reinterpret_cast<FrameRecord*>(buffer + pos);
+        *rec = meta;
+        rec->len = len;
+        if (rec->origLen < len) rec->origLen = len;
+        if (len) memcpy(buffer + pos + sizeof(FrameRecord), data, len);
+
+        head.store(h + need, std::memory_order_release);
+
+        bump(statPushed);
+        uint32_t inUse = used + pad + need;
+        if (inUse > statHighWater.load(std::memory_order_relaxed)) {
+            statHighWater.store(inUse, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    // ---- Consumer side ----
+
+    // Oldest record, or nullptr if empty. Valid until pop()/clear().
+    const FrameRecord* peek() {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        uint32_t h = head.load(std::memory_order_acquire);
+        while (t != h) {
+            size_t pos = t & (CAPACITY - 1);
+            size_t contiguous = CAPACITY - pos;
+            const FrameRecord* rec = reinterpret_cast<const FrameRecord*>(buffer + pos);
+            if (contiguous < sizeof(FrameRecord) || rec->len == WRAP_MARKER) {
+                t += contiguous;
+                tail.store(t, std::memory_order_release);
+                continue;
+            }
+            return rec;
+        }
+        return nullptr;
+    }
+
+    void pop() {
+        const FrameRecord* rec = peek();
+        if (!rec) return;
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        tail.store(t + recordSize(rec->len), std::memory_order_release);
+        bump(statPopped);
+    }
+
+    // Hand up to maxFrames records to fn(const FrameRecord&), oldest first.
+    // Returns the number of records consumed.
+    template <typename Fn>
+    size_t drain(Fn&& fn, size_t maxFrames) {
+        size_t n = 0;
+        while (n < maxFrames) {
+            const FrameRecord* rec = peek();
+            if (!rec) break;
+            fn(*rec);
+            pop();
+            n++;
+        }
+        return n;
+    }
+
+    // Discard everything queued so far (consumer-side, safe while producing)
+    void clear() {
+        tail.store(head.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+    size_t usedBytes() const {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+
+    FrameRingStats stats() const {
+        FrameRingStats s;
+        s.pushed = statPushed.load(std::memory_order_relaxed);
+        s.popped = statPopped.load(std::memory_order_relaxed);
+        s.droppedFull = statFull.load(std::memory_order_relaxed);
+        s.droppedBytes = statFullBytes.load(std::memory_order_relaxed);
+        s.droppedOversize = statOversize.load(std::memory_order_relaxed);
+        s.highWater = statHighWater.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    // Only call while the producer is stopped (e.g. before installing the callback)
+    void resetStats() {
+        statPushed.store(0); statPopped.store(0); statFull.store(0);
+        statFullBytes.store(0); statOversize.store(0); statHighWater.store(0);
+    }
+
+private:
+    // Single-writer increment: no RMW needed, just a relaxed load/store pair
+    static void bump(std::atomic<uint32_t>& c) {
+        c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    alignas(4) uint8_t buffer[CAPACITY];
+    std::atomic<uint32_t> head;  // Producer-owned, monotonically increasing byte offset
+    std::atomic<uint32_t> tail;  // Consumer-owned
+
+    std::atomic<uint32_t> statPushed;
+    std::atomic<uint32_t> statPopped;
+    std::atomic<uint32_t> statFull;
+    std::atomic<uint32_t> statFullBytes;
+    std::atomic<uint32_t> statOversize;
+    std::atomic<uint32_t> statHighWater;
+};
@@ -0,0 +1,247 @@
+// Log Ring - SD debug log lines held in a fixed RAM ring, drained in bulk
+// push() may run on any task (LockT guards the ring); update/flush/close on one task.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct LogRingStats {
+    uint32_t lines;       // Lines accepted by push()
+    uint32_t dropped;     // Lines rejected because the ring was full
+    uint32_t written;     // Bytes the file accepted
+    uint32_t writes;      // File write() calls
+    uint32_t errors;      // Short writes and failed (re)opens
+    uint32_t rotations;   // Times the file was rolled over to oldPath
+    uint32_t highWater;   // Most bytes ever waiting in the ring
+};
+
+struct NoLogLock {
+    static void lock() {}
+    static void unlock() {}
+};
+
+template <typename FsT, typename FileT, size_t CAP, typename LockT = NoLogLock>
+class LogRing {
+    static_assert(CAP >= 512, "LogRing buffer too small");
+
+public:
+    static const size_t MAX_PATH = 48;
+
+    LogRing() : fs(nullptr), buf(nullptr) { reset(); }
+    ~LogRing() { end(); }
+
+    LogRing(const LogRing&) = delete;
+    LogRing& operator=(const LogRing&) = delete;
+
+    // Allocate the ring and open path (appending, or truncated when fresh).
+    // False on OOM or if the file cannot be opened.
+    bool begin(FsT& fsys, const char* path, const char* oldPath,
+               uint32_t rotateBytes, bool fresh) {
+        end();
+        if (!path || strlen(path) >= MAX_PATH) return false;
+        if (!oldPath || strlen(oldPath) >= MAX_PATH) return false;
+        char* ring = (char*)malloc(CAP);
+        if (!ring) return false;
+        LockT::lock();
+        buf = ring;
+        LockT::unlock();
+        fs = &fsys;
+        strcpy(livePath, path);
+        strcpy(rolledPath, oldPath);
+        rotateAt = rotateBytes;
+        if (!openFile(fresh)) {
+            end();
+            return false;
+        }
+        return true;
+    }
+
+    // Close the file and free the ring; anything not drained is discarded.
+    // The ring is unhooked under the lock so a concurrent push() sees null.
+    void end() {
+        if (file) file.close();
+        LockT::lock();
+        char* ring = buf;
+        buf = nullptr;
+        reset();
+        LockT::unlock();
+        free(ring);
+        fs = nullptr;
+    }
+
+    bool active() const { return buf != nullptr; }
+
+    // Queue one complete line (caller includes the '\n'). False if dropped.
+    bool push(const char* line, size_t len) {
+        if (!line || len == 0) return false;
+        LockT::lock();
+        if (!buf) {
+            LockT::unlock();
+            return false;
+        }
+        bool ok = true;
+        if (missed) {
+            char note[48];
+            int n = snprintf(note, sizeof(note), "*** %lu log lines dropped ***\n",
+                             (unsigned long)missed);
+            if (n > 0 && (size_t)n + len <= CAP - used) {
+                copyIn(note, n);
+                missed = 0;
+            }
+        }
+        if (missed || len > CAP - used) {
+            missed++;
+            st.dropped++;
+            ok = false;
+        } else {
+            copyIn(line, len);
+            st.lines++;
+            if (used > st.highWater) st.highWater = used;
+        }
+        LockT::unlock();
+        return ok;
+    }
+
+    size_t pending() const {
+        LockT::lock();
+        size_t n = used;
+        LockT::unlock();
+        return n;
+    }
+
+    // Drain and sync if the ring holds minBytes or its oldest line has
+    // waited maxAgeMs. The age clock starts the first time update() sees
+    // data. True if it wrote.
+    bool update(uint32_t nowMs, size_t minBytes, uint32_t maxAgeMs) {
+        size_t n = pending();
+        if (!buf || n == 0) {
+            waiting = false;
+            return false;
+        }
+        if (!waiting) {
+            waiting = true;
+            waitingSince = nowMs;
+        }
+        if (n < minBytes && nowMs - waitingSince < maxAgeMs) return false;
+        flush();
+        return true;
+    }
+
+    // Write everything queued and sync the file. False on a write error.
+    bool flush() {
+        if (!buf) return true;
+        uint32_t errorsBefore = st.errors;
+        drain();
+        if (file) file.flush();
+        return st.errors == errorsBefore;
+    }
+
+    // Flush and close the file; the ring stays allocated and the next
+    // drain reopens the file for append
+    bool close() {
+        if (!buf) return true;
+        bool ok = flush();
+        if (file) file.close();
+        return ok;
+    }
+
+    // Bytes in the current file
+    size_t fileSize() const { return fileBytes; }
+
+    LogRingStats stats() const {
+        LockT::lock();
+        LogRingStats s = st;
+        LockT::unlock();
+        return s;
+    }
+
+private:
+    void copyIn(const char* src, size_t len) {
+        size_t first = CAP - head;
+        if (first > len) first = len;
+        memcpy(buf + head, src, first);
+        memcpy(buf, src + first, len - first);
+        head = (head + len) % CAP;
+        used += len;
+    }
+
+    // Producers only fill free space, so the queued bytes can be written
+    // from the ring without holding the lock
+    void drain() {
+        waiting = false;
+        for (int pass = 0; pass < 2; pass++) {
+            LockT::lock();
+            size_t start = tail;
+            size_t n = used;
+            LockT::unlock();
+            if (n == 0) return;
+            if (n > CAP - start) n = CAP - start;  // Up to the wrap
+
+            if (!file && !openFile(false)) return;  // Keep it queued, retry next drain
+            if (rotateAt && fileBytes >= rotateAt && lineDone) rotate();
+            if (!file) return;
+
+            size_t w = file.write((const uint8_t*)(buf + start), n);
+            st.writes++;
+            st.written += w;
+            fileBytes += w;
+            if (w != n) st.errors++;  // Card trouble: drop the span, don't wedge
+            lineDone = buf[start + n - 1] == '\n';
+
+            LockT::lock();
+            tail = (tail + n) % CAP;
+            used -= n;
+            LockT::unlock();
+        }
+    }
+
+    bool openFile(bool fresh) {
+        file = fs->open(livePath, fresh ? "w" : "a");
+        if (!file) {
+            st.errors++;
+            return false;
+        }
+        fileBytes = fresh ? 0 : file.size();
+        lineDone = true;
+        return true;
+    }
+
+    void rotate() {
+        file.close();
+        if (fs->exists(rolledPath)) fs->remove(rolledPath);
+        fs->rename(livePath, rolledPath);
+        st.rotations++;
+        openFile(true);
+    }
+
+    void reset() {
+        memset(&st, 0, sizeof(st));
+        head = tail = used = 0;
+        missed = 0;
+        fileBytes = 0;
+        rotateAt = 0;
+        waiting = false;
+        waitingSince = 0;
+        lineDone = true;
+        livePath[0] = rolledPath[0] = '\0';
+    }
+
+    FsT* fs;
+    FileT file;
+    char* buf;
+    size_t head;
+    size_t tail;
+    size_t used;
+    uint32_t missed;
+    size_t fileBytes;
+    uint32_t rotateAt;
+    uint32_t waitingSince;
+    bool waiting;
+    bool lineDone;
+    char livePath[MAX_PATH];
+    char rolledPath[MAX_PATH];
+    LogRingStats st;
+};
@@ -0,0 +1,171 @@
+// Mgmt Frame - single-pass, zero-copy view over a beacon / probe response
+// Points into the caller's buffer: valid only while it is.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Beacon / probe response layout (after the 24-byte MAC header):
+// timestamp(8) + beacon interval(2) + capability(2), then tagged parameters
+static const uint16_t MGMT_HDR_LEN = 24;
+static const uint16_t MGMT_FIXED_LEN = 12;
+static const uint16_t MGMT_IE_OFFSET = MGMT_HDR_LEN + MGMT_FIXED_LEN;  // 36
+
+static const uint8_t MGMT_SUBTYPE_PROBE_RESP = 0x05;
+static const uint8_t MGMT_SUBTYPE_BEACON = 0x08;
+
+// Element IDs
+static const uint8_t IE_SSID = 0;
+static const uint8_t IE_SUPPORTED_RATES = 1;
+static const uint8_t IE_DS_PARAMS = 3;
+static const uint8_t IE_HT_CAPS = 45;
+static const uint8_t IE_RSN = 48;
+static const uint8_t IE_EXT_RATES = 50;
+static const uint8_t IE_VHT_CAPS = 191;
+static const uint8_t IE_VENDOR = 221;
+
+// RSN capabilities (IEEE 802.11-2016 9.4.2.25.4)
+static const uint16_t RSN_CAP_MFPR = 0x0080;  // Bit 7: PMF required
+static const uint16_t RSN_CAP_MFPC = 0x0040;  // Bit 6: PMF capable
+
+struct MgmtFrameView {
+    const uint8_t* frame;
+    uint16_t len;
+    uint8_t subtype;          // MGMT_SUBTYPE_*
+
+    uint64_t tsf;             // AP's timing synchronization function, microseconds
+    uint16_t beaconInterval;  // TUs
+    uint16_t capability;
+
+    // SSID: first SSID element as sent (length may be 0 or, if malformed, > 32)
+    const uint8_t* ssid;
+    uint8_t ssidLen;
+    bool hasSSIDElement;
+
+    uint8_t dsChannel;        // 0 = no DS Parameter Set
+
+    // Offsets of the element header within frame, 0 = absent
+    uint16_t rsnOffset;
+    uint16_t wpaOffset;       // Vendor 00:50:F2 type 1
+    uint16_t wpsOffset;       // Vendor 00:50:F2 type 4
+
+    // From the RSN element; 0 if absent or too short to carry capabilities
+    uint16_t rsnCaps;
+    bool pmfCapable;
+    bool pmfRequired;
+
+    bool hasHT;
+    bool hasVHT;
+
+    uint8_t supportedRates;   // Supported + extended rate element lengths
+    uint8_t vendorIECount;
+    bool truncated;           // Walk stopped at an element overrunning the frame
+
+    const uint8_t* bssid() const { return frame + 16; }
+    bool hasRSN() const { return rsnOffset != 0; }
+    bool hasWPA() const { return wpaOffset != 0; }
+    bool hasWPS() const { return wpsOffset != 0; }
+
+    // SSID element present but zero-length or all-NUL (no element = unknown, not hidden)
+    bool isHidden() const {
+        if (!hasSSIDElement) return false;
+        if (ssidLen == 0) return true;
+        uint8_t n = ssidLen > 32 ? 32 : ssidLen;
+        for (uint8_t i = 0; i < n; i++) {
+            if (ssid[i] != 0) return false;
+        }
+        return true;
+    }
+
+    // Copy a usable SSID into out[33]; false (and "") if absent, hidden or > 32 bytes
+    bool copySSID(char* out) const {
+        out[0] = 0;
+        if (!hasSSIDElement || ssidLen == 0 || ssidLen > 32 || ssid[0] == 0) return false;
+        memcpy(out, ssid, ssidLen);
+        out[ssidLen] = 0;
+        return true;
+    }
+
+    // Parse a beacon or probe response. Returns false if the frame is too
+    // short for the fixed fields; any other malformation just ends the walk.
+    bool parse(const uint8_t* f, uint16_t length) {
+        memset(this, 0, sizeof(*this));
+        frame = f;
+        len = length;
+        if (!f || length < MGMT_IE_OFFSET) return false;
+
+        subtype = (f[0] >> 4) & 0x0F;
+        for (int i = 7; i >= 0; i--) tsf = (tsf << 8) | f[MGMT_HDR_LEN + i];  // Little-endian
+        beaconInterval = f[32] | (f[33] << 8);
+        capability = f[34] | (f[35] << 8);
+
+        size_t offset = MGMT_IE_OFFSET;
+        while (offset + 2 <= length) {  // Zero-length last element still counts
+            uint8_t id = f[offset];
+            uint8_t ieLen = f[offset + 1];
+            if (offset + 2 + ieLen > length) {
+                truncated = true;
+                break;
+            }
+            const uint8_t* ie = f + offset + 2;
+
+            switch (id) {
+                case IE_SSID:
+                    if (!hasSSIDElement) {
+                        hasSSIDElement = true;
+                        ssid = ie;
+                        ssidLen = ieLen;
+                    }
+                    break;
+                case IE_SUPPORTED_RATES:
+                case IE_EXT_RATES:
+                    supportedRates += ieLen;
+                    break;
+                case IE_DS_PARAMS:
+                    if (ieLen >= 1 && dsChannel == 0) dsChannel = ie[0];
+                    break;
+                case IE_HT_CAPS:
+                    hasHT = true;
+                    break;
+                case IE_RSN:
+                    if (rsnOffset == 0) {
+                        rsnOffset = (uint16_t)offset;
+                        rsnCaps = parseRSNCaps(ie, ieLen);
+                        pmfCapable = (rsnCaps & RSN_CAP_MFPC) != 0;
+                        pmfRequired = (rsnCaps & RSN_CAP_MFPR) != 0;
+                    }
+                    break;
+                case IE_VHT_CAPS:
+                    hasVHT = true;
+                    break;
+                case IE_VENDOR:
+                    vendorIECount++;
+                    if (ieLen >= 4 && ie[0] == 0x00 && ie[1] == 0x50 && ie[2] == 0xF2) {
+                        if (ie[3] == 0x01 && wpaOffset == 0) wpaOffset = (uint16_t)offset;
+                        else if (ie[3] == 0x04 && wpsOffset == 0) wpsOffset = (uint16_t)offset;
+                    }
+                    break;
+                default:
+                    break;
+            }
+
+            offset += 2 + ieLen;
+        }
+        return true;
+    }
+
+private:
+    // RSN body: version(2) group cipher(4) pairwise count(2)+4n AKM count(2)+4n caps(2)
+    static uint16_t parseRSNCaps(const uint8_t* rsn, uint8_t rsnLen) {
+        size_t pos = 6;
+        if (pos + 2 > rsnLen) return 0;
+        size_t pairwise = rsn[pos] | (rsn[pos + 1] << 8);
+        pos += 2 + pairwise * 4;
+        if (pos + 2 > rsnLen) return 0;
+        size_t akm = rsn[pos] | (rsn[pos + 1] << 8);
+        pos += 2 + akm * 4;
+        if (pos + 2 > rsnLen) return 0;
+        return rsn[pos] | (rsn[pos + 1] << 8);
+    }
+};
@@ -1,536 +1,61 @@
 // OUI (Organizationally Unique Identifier) Lookup Implementation
-// Embedded table of top ~200 vendors covering 90%+ of consumer devices
+// Built-in table in oui_table.h (perfect-hashed), optional full IEEE
+// database on the card in oui_registry.h
 
 #include "oui.h"
-#include <pgmspace.h>
+#include <SD.h>
+#include "oui_table.h"
+#include "oui_registry.h"
 
-// OUI entry: 3-byte prefix + 9-char vendor name (10 bytes total)
-struct OUIEntry {
-    uint8_t oui[3];
-    char vendor[10];  // 9 chars + null [P9]
-};
+static const char* REGISTRY_FILE = "/oui.bin";
 
-// Table MUST be sorted by OUI for binary search (or linear is fine for ~200 entries)
-// Vendor names truncated to 9 chars max
-static const OUIEntry OUI_TABLE[] PROGMEM = {
-    // Apple - many prefixes
-    {{0x00, 0x03, 0x93}, "Apple"},
-    {{0x00, 0x0A, 0x27}, "Apple"},
-    {{0x00, 0x0A, 0x95}, "Apple"},
-    {{0x00, 0x0D, 0x93}, "Apple"},
-    {{0x00, 0x10, 0xFA}, "Apple"},
-    {{0x00, 0x11, 0x24}, "Apple"},
-    {{0x00, 0x14, 0x51}, "Apple"},
-    {{0x00, 0x16, 0xCB}, "Apple"},
-    {{0x00, 0x17, 0xF2}, "Apple"},
-    {{0x00, 0x19, 0xE3}, "Apple"},
-    {{0x00, 0x1B, 0x63}, "Apple"},
-    {{0x00, 0x1C, 0xB3}, "Apple"},
-    {{0x00, 0x1D, 0x4F}, "Apple"},
-    {{0x00, 0x1E, 0x52}, "Apple"},
-    {{0x00, 0x1E, 0xC2}, "Apple"},
-    {{0x00, 0x1F, 0x5B}, "Apple"},
-    {{0x00, 0x1F, 0xF3}, "Apple"},
-    {{0x00, 0x21, 0xE9}, "Apple"},
-    {{0x00, 0x22, 0x41}, "Apple"},
-    {{0x00, 0x23, 0x12}, "Apple"},
-    {{0x00, 0x23, 0x32}, "Apple"},
-    {{0x00, 0x23, 0x6C}, "Apple"},
-    {{0x00, 0x23, 0xDF}, "Apple"},
-    {{0x00, 0x24, 0x36}, "Apple"},
-    {{0x00, 0x25, 0x00}, "Apple"},
-    {{0x00, 0x25, 0x4B}, "Apple"},
-    {{0x00, 0x25, 0xBC}, "Apple"},
-    {{0x00, 0x26, 0x08}, "Apple"},
-    {{0x00, 0x26, 0x4A}, "Apple"},
-    {{0x00, 0x26, 0xB0}, "Apple"},
-    {{0x00, 0x26, 0xBB}, "Apple"},
-    
-    // Samsung
-    {{0x00, 0x00, 0xF0}, "Samsung"},
-    {{0x00, 0x02, 0x78}, "Samsung"},
-    {{0x00, 0x07, 0xAB}, "Samsung"},
-    {{0x00, 0x09, 0x18}, "Samsung"},
-    {{0x00, 0x0D, 0xAE}, "Samsung"},
-    {{0x00, 0x0D, 0xE5}, "Samsung"},
-    {{0x00, 0x12, 0x47}, "Samsung"},
-    {{0x00, 0x12, 0xFB}, "Samsung"},
-    {{0x00, 0x13, 0x77}, "Samsung"},
-    {{0x00, 0x15, 0x99}, "Samsung"},
-    {{0x00, 0x15, 0xB9}, "Samsung"},
-    {{0x00, 0x16, 0x32}, "Samsung"},
-    {{0x00, 0x16, 0x6B}, "Samsung"},
-    {{0x00, 0x16, 0x6C}, "Samsung"},
-    {{0x00, 0x16, 0xDB}, "Samsung"},
-    {{0x00, 0x17, 0xC9}, "Samsung"},
-    {{0x00, 0x17, 0xD5}, "Samsung"},
-    {{0x00, 0x18, 0xAF}, "Samsung"},
-    {{0x00, 0x1A, 0x8A}, "Samsung"},
-    {{0x00, 0x1B, 0x98}, "Samsung"},
-    {{0x00, 0x1C, 0x43}, "Samsung"},
-    {{0x00, 0x1D, 0x25}, "Samsung"},
-    {{0x00, 0x1D, 0xF6}, "Samsung"},
-    {{0x00, 0x1E, 0x7D}, "Samsung"},
-    {{0x00, 0x1E, 0xE1}, "Samsung"},
-    {{0x00, 0x1E, 0xE2}, "Samsung"},
-    {{0x00, 0x1F, 0xCC}, "Samsung"},
-    {{0x00, 0x1F, 0xCD}, "Samsung"},
-    {{0x00, 0x21, 0x19}, "Samsung"},
-    {{0x00, 0x21, 0x4C}, "Samsung"},
-    {{0x00, 0x21, 0xD1}, "Samsung"},
-    {{0x00, 0x21, 0xD2}, "Samsung"},
-    {{0x00, 0x23, 0x39}, "Samsung"},
-    {{0x00, 0x23, 0x99}, "Samsung"},
-    {{0x00, 0x23, 0xD6}, "Samsung"},
-    {{0x00, 0x23, 0xD7}, "Samsung"},
-    {{0x00, 0x24, 0x54}, "Samsung"},
-    {{0x00, 0x24, 0x90}, "Samsung"},
-    {{0x00, 0x24, 0x91}, "Samsung"},
-    {{0x00, 0x25, 0x66}, "Samsung"},
-    {{0x00, 0x25, 0x67}, "Samsung"},
-    {{0x00, 0x26, 0x37}, "Samsung"},
-    {{0x00, 0x26, 0x5D}, "Samsung"},
-    {{0x00, 0x26, 0x5F}, "Samsung"},
-    
-    // Google/Nest
-    {{0x00, 0x1A, 0x11}, "Google"},
-    {{0x18, 0xD6, 0xC7}, "Google"},
-    {{0x1C, 0xF2, 0x9A}, "Google"},
-    {{0x20, 0xDF, 0xB9}, "Google"},
-    {{0x30, 0xFD, 0x38}, "Google"},
-    {{0x3C, 0x5A, 0xB4}, "Google"},
-    {{0x54, 0x60, 0x09}, "Google"},
-    {{0x58, 0xCB, 0x52}, "Google"},
-    {{0x94, 0xEB, 0x2C}, "Google"},
-    {{0xA4, 0x77, 0x33}, "Google"},
-    {{0xD8, 0x6C, 0x63}, "Google"},
-    {{0xF4, 0xF5, 0xD8}, "Google"},
-    {{0xF4, 0xF5, 0xE8}, "Google"},
-    
-    // Intel
-    {{0x00, 0x02, 0xB3}, "Intel"},
-    {{0x00, 0x03, 0x47}, "Intel"},
-    {{0x00, 0x04, 0x23}, "Intel"},
-    {{0x00, 0x07, 0xE9}, "Intel"},
-    {{0x00, 0x0C, 0xF1}, "Intel"},
-    {{0x00, 0x0E, 0x35}, "Intel"},
-    {{0x00, 0x0E, 0x0C}, "Intel"},
-    {{0x00, 0x11, 0x11}, "Intel"},
-    {{0x00, 0x12, 0xF0}, "Intel"},
-    {{0x00, 0x13, 0x02}, "Intel"},
-    {{0x00, 0x13, 0x20}, "Intel"},
-    {{0x00, 0x13, 0xCE}, "Intel"},
-    {{0x00, 0x13, 0xE8}, "Intel"},
-    {{0x00, 0x15, 0x00}, "Intel"},
-    {{0x00, 0x15, 0x17}, "Intel"},
-    {{0x00, 0x16, 0x6F}, "Intel"},
-    {{0x00, 0x16, 0x76}, "Intel"},
-    {{0x00, 0x16, 0xEA}, "Intel"},
-    {{0x00, 0x16, 0xEB}, "Intel"},
-    {{0x00, 0x18, 0xDE}, "Intel"},
-    {{0x00, 0x19, 0xD1}, "Intel"},
-    {{0x00, 0x19, 0xD2}, "Intel"},
-    {{0x00, 0x1B, 0x21}, "Intel"},
-    {{0x00, 0x1B, 0x77}, "Intel"},
-    {{0x00, 0x1C, 0xBF}, "Intel"},
-    {{0x00, 0x1C, 0xC0}, "Intel"},
-    {{0x00, 0x1D, 0xE0}, "Intel"},
-    {{0x00, 0x1D, 0xE1}, "Intel"},
-    {{0x00, 0x1E, 0x64}, "Intel"},
-    {{0x00, 0x1E, 0x65}, "Intel"},
-    {{0x00, 0x1E, 0x67}, "Intel"},
-    {{0x00, 0x1F, 0x3B}, "Intel"},
-    {{0x00, 0x1F, 0x3C}, "Intel"},
-    {{0x00, 0x20, 0xA6}, "Intel"},
-    {{0x00, 0x21, 0x5C}, "Intel"},
-    {{0x00, 0x21, 0x5D}, "Intel"},
-    {{0x00, 0x21, 0x6A}, "Intel"},
-    {{0x00, 0x21, 0x6B}, "Intel"},
-    {{0x00, 0x22, 0xFA}, "Intel"},
-    {{0x00, 0x22, 0xFB}, "Intel"},
-    {{0x00, 0x24, 0xD6}, "Intel"},
-    {{0x00, 0x24, 0xD7}, "Intel"},
-    {{0x00, 0x26, 0xC6}, "Intel"},
-    {{0x00, 0x26, 0xC7}, "Intel"},
-    
-    // Cisco/Linksys
-    {{0x00, 0x00, 0x0C}, "Cisco"},
-    {{0x00, 0x01, 0x42}, "Cisco"},
-    {{0x00, 0x01, 0x43}, "Cisco"},
-    {{0x00, 0x01, 0x63}, "Cisco"},
-    {{0x00, 0x01, 0x64}, "Cisco"},
-    {{0x00, 0x01, 0x96}, "Cisco"},
-    {{0x00, 0x01, 0x97}, "Cisco"},
-    {{0x00, 0x01, 0xC7}, "Cisco"},
-    {{0x00, 0x01, 0xC9}, "Cisco"},
-    {{0x00, 0x02, 0x16}, "Cisco"},
-    {{0x00, 0x02, 0x17}, "Cisco"},
-    {{0x00, 0x02, 0x3D}, "Cisco"},
-    {{0x00, 0x02, 0x4A}, "Cisco"},
-    {{0x00, 0x02, 0x4B}, "Cisco"},
-    {{0x00, 0x02, 0x7D}, "Cisco"},
-    {{0x00, 0x02, 0x7E}, "Cisco"},
-    {{0x00, 0x02, 0xB9}, "Cisco"},
-    {{0x00, 0x02, 0xBA}, "Cisco"},
-    {{0x00, 0x02, 0xFC}, "Cisco"},
-    {{0x00, 0x02, 0xFD}, "Cisco"},
-    
-    // Huawei
-    {{0x00, 0x0F, 0xE2}, "Huawei"},
-    {{0x00, 0x18, 0x82}, "Huawei"},
-    {{0x00, 0x1E, 0x10}, "Huawei"},
-    {{0x00, 0x22, 0xA1}, "Huawei"},
-    {{0x00, 0x25, 0x68}, "Huawei"},
-    {{0x00, 0x25, 0x9E}, "Huawei"},
-    {{0x00, 0x34, 0xFE}, "Huawei"},
-    {{0x00, 0x46, 0x4B}, "Huawei"},
-    {{0x00, 0x66, 0x4B}, "Huawei"},
-    {{0x00, 0x9A, 0xCD}, "Huawei"},
-    {{0x00, 0xE0, 0xFC}, "Huawei"},
-    {{0x04, 0x02, 0x1F}, "Huawei"},
-    {{0x04, 0xB0, 0xE7}, "Huawei"},
-    {{0x04, 0xC0, 0x6F}, "Huawei"},
-    {{0x04, 0xF9, 0x38}, "Huawei"},
-    {{0x08, 0x19, 0xA6}, "Huawei"},
-    {{0x08, 0x63, 0x61}, "Huawei"},
-    {{0x08, 0x7A, 0x4C}, "Huawei"},
-    {{0x08, 0xE8, 0x4F}, "Huawei"},
-    
-    // Microsoft/Xbox
-    {{0x00, 0x03, 0xFF}, "Microsoft"},
-    {{0x00, 0x0D, 0x3A}, "Microsoft"},
-    {{0x00, 0x12, 0x5A}, "Microsoft"},
-    {{0x00, 0x15, 0x5D}, "Microsoft"},
-    {{0x00, 0x17, 0xFA}, "Microsoft"},
-    {{0x00, 0x1D, 0xD8}, "Microsoft"},
-    {{0x00, 0x22, 0x48}, "Microsoft"},
-    {{0x00, 0x25, 0xAE}, "Microsoft"},
-    {{0x00, 0x50, 0xF2}, "Microsoft"},
-    {{0x28, 0x18, 0x78}, "Microsoft"},
-    {{0x30, 0x59, 0xB7}, "Microsoft"},
-    {{0x50, 0x1A, 0xC5}, "Microsoft"},
-    {{0x60, 0x45, 0xBD}, "Microsoft"},
-    {{0x7C, 0x1E, 0x52}, "Microsoft"},
-    {{0x7C, 0xED, 0x8D}, "Microsoft"},
-    
-    // Amazon (Echo, Fire, Ring)
-    {{0x00, 0xFC, 0x8B}, "Amazon"},
-    {{0x0C, 0x47, 0xC9}, "Amazon"},
-    {{0x10, 0xCE, 0xA9}, "Amazon"},
-    {{0x18, 0x74, 0x2E}, "Amazon"},
-    {{0x34, 0xD2, 0x70}, "Amazon"},
-    {{0x38, 0xF7, 0x3D}, "Amazon"},
-    {{0x40, 0xB4, 0xCD}, "Amazon"},
-    {{0x44, 0x65, 0x0D}, "Amazon"},
-    {{0x4C, 0xEF, 0xC0}, "Amazon"},
-    {{0x50, 0xDC, 0xE7}, "Amazon"},
-    {{0x5C, 0x41, 0x5A}, "Amazon"},
-    {{0x68, 0x37, 0xE9}, "Amazon"},
-    {{0x68, 0x54, 0xFD}, "Amazon"},
-    {{0x74, 0xC2, 0x46}, "Amazon"},
-    {{0x78, 0xE1, 0x03}, "Amazon"},
-    {{0x84, 0xD6, 0xD0}, "Amazon"},
-    {{0xA0, 0x02, 0xDC}, "Amazon"},
-    {{0xAC, 0x63, 0xBE}, "Amazon"},
-    {{0xB4, 0x7C, 0x9C}, "Amazon"},
-    {{0xB8, 0x6C, 0xE4}, "Amazon"},
-    {{0xF0, 0x27, 0x2D}, "Amazon"},
-    {{0xFC, 0x65, 0xDE}, "Amazon"},
-    
-    // TP-Link
-    {{0x00, 0x1D, 0x0F}, "TP-Link"},
-    {{0x00, 0x27, 0x19}, "TP-Link"},
-    {{0x10, 0xFE, 0xED}, "TP-Link"},
-    {{0x14, 0xCC, 0x20}, "TP-Link"},
-    {{0x14, 0xCF, 0x92}, "TP-Link"},
-    {{0x18, 0xA6, 0xF7}, "TP-Link"},
-    {{0x1C, 0x3B, 0xF3}, "TP-Link"},
-    {{0x30, 0xB4, 0x9E}, "TP-Link"},
-    {{0x50, 0xC7, 0xBF}, "TP-Link"},
-    {{0x54, 0xC8, 0x0F}, "TP-Link"},
-    {{0x5C, 0x89, 0x9A}, "TP-Link"},
-    {{0x60, 0xE3, 0x27}, "TP-Link"},
-    {{0x64, 0x56, 0x01}, "TP-Link"},
-    {{0x64, 0x70, 0x02}, "TP-Link"},
-    {{0x6C, 0xB0, 0xCE}, "TP-Link"},
-    {{0x78, 0x44, 0x76}, "TP-Link"},
-    {{0x90, 0xF6, 0x52}, "TP-Link"},
-    {{0x98, 0xDE, 0xD0}, "TP-Link"},
-    {{0xA4, 0x2B, 0xB0}, "TP-Link"},
-    {{0xAC, 0x84, 0xC6}, "TP-Link"},
-    {{0xB0, 0x4E, 0x26}, "TP-Link"},
-    {{0xB0, 0xBE, 0x76}, "TP-Link"},
-    {{0xC0, 0x25, 0xE9}, "TP-Link"},
-    {{0xC4, 0xE9, 0x84}, "TP-Link"},
-    {{0xD8, 0x07, 0xB6}, "TP-Link"},
-    {{0xE8, 0x94, 0xF6}, "TP-Link"},
-    {{0xEC, 0x08, 0x6B}, "TP-Link"},
-    {{0xF4, 0xEC, 0x38}, "TP-Link"},
-    {{0xF8, 0x1A, 0x67}, "TP-Link"},
-    
-    // Netgear
-    {{0x00, 0x09, 0x5B}, "Netgear"},
-    {{0x00, 0x0F, 0xB5}, "Netgear"},
-    {{0x00, 0x14, 0x6C}, "Netgear"},
-    {{0x00, 0x18, 0x4D}, "Netgear"},
-    {{0x00, 0x1B, 0x2F}, "Netgear"},
-    {{0x00, 0x1E, 0x2A}, "Netgear"},
-    {{0x00, 0x1F, 0x33}, "Netgear"},
-    {{0x00, 0x22, 0x3F}, "Netgear"},
-    {{0x00, 0x24, 0xB2}, "Netgear"},
-    {{0x00, 0x26, 0xF2}, "Netgear"},
-    {{0x20, 0x4E, 0x7F}, "Netgear"},
-    {{0x28, 0xC6, 0x8E}, "Netgear"},
-    {{0x30, 0x46, 0x9A}, "Netgear"},
-    {{0x44, 0x94, 0xFC}, "Netgear"},
-    {{0x4C, 0x60, 0xDE}, "Netgear"},
-    {{0x6C, 0xB0, 0xCE}, "Netgear"},
-    {{0x84, 0x1B, 0x5E}, "Netgear"},
-    {{0x9C, 0x3D, 0xCF}, "Netgear"},
-    {{0xA0, 0x04, 0x60}, "Netgear"},
-    {{0xA4, 0x2B, 0x8C}, "Netgear"},
-    {{0xC0, 0x3F, 0x0E}, "Netgear"},
-    {{0xC4, 0x04, 0x15}, "Netgear"},
-    {{0xE0, 0x46, 0x9A}, "Netgear"},
-    {{0xE4, 0xF4, 0xC6}, "Netgear"},
-    
-    // Xiaomi
-    {{0x00, 0x9E, 0xC8}, "Xiaomi"},
-    {{0x04, 0xCF, 0x8C}, "Xiaomi"},
-    {{0x0C, 0x1D, 0xAF}, "Xiaomi"},
-    {{0x10, 0x2A, 0xB3}, "Xiaomi"},
-    {{0x14, 0xF6, 0x5A}, "Xiaomi"},
-    {{0x18, 0x59, 0x36}, "Xiaomi"},
-    {{0x20, 0x34, 0xFB}, "Xiaomi"},
-    {{0x28, 0x6C, 0x07}, "Xiaomi"},
-    {{0x34, 0x80, 0xB3}, "Xiaomi"},
-    {{0x38, 0xA4, 0xED}, "Xiaomi"},
-    {{0x3C, 0xBD, 0x3E}, "Xiaomi"},
-    {{0x50, 0x64, 0x2B}, "Xiaomi"},
-    {{0x58, 0x44, 0x98}, "Xiaomi"},
-    {{0x64, 0x09, 0x80}, "Xiaomi"},
-    {{0x64, 0xB4, 0x73}, "Xiaomi"},
-    {{0x68, 0xDF, 0xDD}, "Xiaomi"},
-    {{0x74, 0x23, 0x44}, "Xiaomi"},
-    {{0x78, 0x02, 0xF8}, "Xiaomi"},
-    {{0x78, 0x11, 0xDC}, "Xiaomi"},
-    {{0x7C, 0x1D, 0xD9}, "Xiaomi"},
-    {{0x84, 0x24, 0x8D}, "Xiaomi"},
-    {{0x8C, 0xBE, 0xBE}, "Xiaomi"},
-    {{0x98, 0xFA, 0xE3}, "Xiaomi"},
-    {{0xA8, 0x9C, 0xED}, "Xiaomi"},
-    {{0xAC, 0xF7, 0xF3}, "Xiaomi"},
-    {{0xB0, 0xE2, 0x35}, "Xiaomi"},
-    {{0xC4, 0x0B, 0xCB}, "Xiaomi"},
-    {{0xC8, 0x02, 0x8F}, "Xiaomi"},
-    {{0xD4, 0x97, 0x0B}, "Xiaomi"},
-    {{0xE4, 0x46, 0xDA}, "Xiaomi"},
-    {{0xF0, 0xB4, 0x29}, "Xiaomi"},
-    {{0xF8, 0xA4, 0x5F}, "Xiaomi"},
-    {{0xFC, 0x64, 0xBA}, "Xiaomi"},
-    
-    // Sony/PlayStation
-    {{0x00, 0x01, 0x4A}, "Sony"},
-    {{0x00, 0x04, 0x1F}, "Sony"},
-    {{0x00, 0x13, 0xA9}, "Sony"},
-    {{0x00, 0x15, 0xC1}, "Sony"},
-    {{0x00, 0x19, 0x63}, "Sony"},
-    {{0x00, 0x19, 0xC5}, "Sony"},
-    {{0x00, 0x1A, 0x80}, "Sony"},
-    {{0x00, 0x1D, 0x0D}, "Sony"},
-    {{0x00, 0x1D, 0xBA}, "Sony"},
-    {{0x00, 0x1E, 0xA4}, "Sony"},
-    {{0x00, 0x24, 0xBE}, "Sony"},
-    {{0x00, 0x26, 0x43}, "Sony"},
-    {{0x28, 0x0D, 0xFC}, "Sony"},
-    {{0x2C, 0xCC, 0x44}, "Sony"},
-    {{0x30, 0xEB, 0x25}, "Sony"},
-    {{0x40, 0xB8, 0x37}, "Sony"},
-    {{0x78, 0x84, 0x3C}, "Sony"},
-    {{0xA8, 0xE3, 0xEE}, "Sony"},
-    {{0xAC, 0x89, 0x95}, "Sony"},
-    {{0xF8, 0x46, 0x1C}, "Sony"},
-    {{0xFC, 0x0F, 0xE6}, "Sony"},
-    
-    // Dell
-    {{0x00, 0x06, 0x5B}, "Dell"},
-    {{0x00, 0x08, 0x74}, "Dell"},
-    {{0x00, 0x0B, 0xDB}, "Dell"},
-    {{0x00, 0x0D, 0x56}, "Dell"},
-    {{0x00, 0x0F, 0x1F}, "Dell"},
-    {{0x00, 0x11, 0x43}, "Dell"},
-    {{0x00, 0x12, 0x3F}, "Dell"},
-    {{0x00, 0x13, 0x72}, "Dell"},
-    {{0x00, 0x14, 0x22}, "Dell"},
-    {{0x00, 0x15, 0xC5}, "Dell"},
-    {{0x00, 0x16, 0xF0}, "Dell"},
-    {{0x00, 0x18, 0x8B}, "Dell"},
-    {{0x00, 0x19, 0xB9}, "Dell"},
-    {{0x00, 0x1A, 0xA0}, "Dell"},
-    {{0x00, 0x1C, 0x23}, "Dell"},
-    {{0x00, 0x1D, 0x09}, "Dell"},
-    {{0x00, 0x1E, 0x4F}, "Dell"},
-    {{0x00, 0x1E, 0xC9}, "Dell"},
-    {{0x00, 0x21, 0x70}, "Dell"},
-    {{0x00, 0x21, 0x9B}, "Dell"},
-    {{0x00, 0x22, 0x19}, "Dell"},
-    {{0x00, 0x23, 0xAE}, "Dell"},
-    {{0x00, 0x24, 0xE8}, "Dell"},
-    {{0x00, 0x25, 0x64}, "Dell"},
-    {{0x00, 0x26, 0xB9}, "Dell"},
-    
-    // Lenovo
-    {{0x00, 0x06, 0x1B}, "Lenovo"},
-    {{0x00, 0x09, 0x2D}, "Lenovo"},
-    {{0x00, 0x0A, 0xE4}, "Lenovo"},
-    {{0x00, 0x12, 0xFE}, "Lenovo"},
-    {{0x00, 0x16, 0x41}, "Lenovo"},
-    {{0x00, 0x1A, 0x6B}, "Lenovo"},
-    {{0x00, 0x1E, 0x37}, "Lenovo"},
-    {{0x00, 0x1F, 0x16}, "Lenovo"},
-    {{0x00, 0x21, 0x5E}, "Lenovo"},
-    {{0x00, 0x22, 0x68}, "Lenovo"},
-    {{0x00, 0x24, 0x7E}, "Lenovo"},
-    {{0x00, 0x26, 0x6C}, "Lenovo"},
-    {{0x28, 0xD2, 0x44}, "Lenovo"},
-    {{0x2C, 0x59, 0xE5}, "Lenovo"},
-    {{0x40, 0x1C, 0x83}, "Lenovo"},
-    {{0x54, 0xE1, 0xAD}, "Lenovo"},
-    {{0x60, 0x02, 0x92}, "Lenovo"},
-    {{0x6C, 0x0B, 0x84}, "Lenovo"},
-    {{0x70, 0xF1, 0xA1}, "Lenovo"},
-    {{0x84, 0x7B, 0xEB}, "Lenovo"},
-    {{0x98, 0xFA, 0x9B}, "Lenovo"},
-    {{0xB8, 0x70, 0xF4}, "Lenovo"},
-    {{0xC4, 0x34, 0x6B}, "Lenovo"},
-    {{0xD8, 0xD3, 0x85}, "Lenovo"},
-    {{0xE8, 0x40, 0xF2}, "Lenovo"},
-    {{0xF0, 0x4D, 0xA2}, "Lenovo"},
-    
-    // LG
-    {{0x00, 0x05, 0xC9}, "LG"},
-    {{0x00, 0x1C, 0x62}, "LG"},
-    {{0x00, 0x1E, 0x75}, "LG"},
-    {{0x00, 0x1F, 0x6B}, "LG"},
-    {{0x00, 0x1F, 0xE3}, "LG"},
-    {{0x00, 0x22, 0xA9}, "LG"},
-    {{0x00, 0x24, 0x83}, "LG"},
-    {{0x00, 0x25, 0xE5}, "LG"},
-    {{0x00, 0x26, 0xE2}, "LG"},
-    {{0x10, 0x68, 0x3F}, "LG"},
-    {{0x14, 0xC9, 0x13}, "LG"},
-    {{0x20, 0x21, 0xA5}, "LG"},
-    {{0x30, 0x76, 0x6F}, "LG"},
-    {{0x34, 0x4D, 0xF7}, "LG"},
-    {{0x38, 0x8C, 0x50}, "LG"},
-    {{0x40, 0xB0, 0xFA}, "LG"},
-    {{0x58, 0x3F, 0x54}, "LG"},
-    {{0x64, 0x99, 0x5D}, "LG"},
-    {{0x6C, 0xDC, 0x6A}, "LG"},
-    {{0x78, 0x5D, 0xC8}, "LG"},
-    {{0x88, 0xC9, 0xD0}, "LG"},
-    {{0xA0, 0x39, 0xF7}, "LG"},
-    {{0xBC, 0xF5, 0xAC}, "LG"},
-    {{0xC4, 0x36, 0x6C}, "LG"},
-    {{0xCC, 0x2D, 0x8C}, "LG"},
-    {{0xE8, 0x5B, 0x5B}, "LG"},
-    {{0xF8, 0x0D, 0xAC}, "LG"},
-    
-    // Raspberry Pi
-    {{0xB8, 0x27, 0xEB}, "RaspbPi"},
-    {{0xDC, 0xA6, 0x32}, "RaspbPi"},
-    {{0xE4, 0x5F, 0x01}, "RaspbPi"},
-    
-    // Espressif (ESP32/ESP8266)
-    {{0x24, 0x0A, 0xC4}, "Espressif"},
-    {{0x24, 0x62, 0xAB}, "Espressif"},
-    {{0x24, 0x6F, 0x28}, "Espressif"},
-    {{0x24, 0xB2, 0xDE}, "Espressif"},
-    {{0x30, 0xAE, 0xA4}, "Espressif"},
-    {{0x3C, 0x61, 0x05}, "Espressif"},
-    {{0x3C, 0x71, 0xBF}, "Espressif"},
-    {{0x4C, 0x11, 0xAE}, "Espressif"},
-    {{0x4C, 0x75, 0x25}, "Espressif"},
-    {{0x5C, 0xCF, 0x7F}, "Espressif"},
-    {{0x60, 0x01, 0x94}, "Espressif"},
-    {{0x68, 0xC6, 0x3A}, "Espressif"},
-    {{0x80, 0x7D, 0x3A}, "Espressif"},
-    {{0x84, 0x0D, 0x8E}, "Espressif"},
-    {{0x84, 0xCC, 0xA8}, "Espressif"},
-    {{0x84, 0xF3, 0xEB}, "Espressif"},
-    {{0x8C, 0xAA, 0xB5}, "Espressif"},
-    {{0x94, 0xB9, 0x7E}, "Espressif"},
-    {{0x98, 0xCD, 0xAC}, "Espressif"},
-    {{0xA0, 0x20, 0xA6}, "Espressif"},
-    {{0xA4, 0x7B, 0x9D}, "Espressif"},
-    {{0xA4, 0xCF, 0x12}, "Espressif"},
-    {{0xAC, 0x67, 0xB2}, "Espressif"},
-    {{0xB4, 0xE6, 0x2D}, "Espressif"},
-    {{0xBC, 0xDD, 0xC2}, "Espressif"},
-    {{0xC4, 0x4F, 0x33}, "Espressif"},
-    {{0xC8, 0x2B, 0x96}, "Espressif"},
-    {{0xCC, 0x50, 0xE3}, "Espressif"},
-    {{0xD8, 0xA0, 0x1D}, "Espressif"},
-    {{0xD8, 0xBF, 0xC0}, "Espressif"},
-    {{0xDC, 0x4F, 0x22}, "Espressif"},
-    {{0xE0, 0x98, 0x06}, "Espressif"},
-    {{0xE8, 0xDB, 0x84}, "Espressif"},
-    {{0xEC, 0x94, 0xCB}, "Espressif"},
-    {{0xEC, 0xFA, 0xBC}, "Espressif"},
-    {{0xF4, 0xCF, 0xA2}, "Espressif"},
-    {{0xFC, 0xF5, 0xC4}, "Espressif"},
-    
-    // HonHai (Foxconn - makes many devices for other brands)
-    {{0x00, 0x01, 0x6C}, "HonHai"},
-    {{0x00, 0x16, 0xEA}, "HonHai"},
-    {{0x00, 0x19, 0x7D}, "HonHai"},
-    {{0x00, 0x19, 0x7E}, "HonHai"},
-    {{0x00, 0x1C, 0x26}, "HonHai"},
-    {{0x00, 0x1F, 0x3A}, "HonHai"},
-    {{0x00, 0x22, 0x68}, "HonHai"},
-    {{0x00, 0x23, 0x4D}, "HonHai"},
-    {{0x00, 0x24, 0x2B}, "HonHai"},
-    {{0x00, 0x24, 0x2C}, "HonHai"},
-    {{0x04, 0x4B, 0xED}, "HonHai"},
-    {{0x48, 0x5D, 0x60}, "HonHai"},
-    {{0x4C, 0xBB, 0x58}, "HonHai"},
-    {{0x60, 0xD8, 0x19}, "HonHai"},
-    {{0x64, 0xD9, 0x54}, "HonHai"},
-    {{0x68, 0x94, 0x23}, "HonHai"},
-    {{0x74, 0x2F, 0x68}, "HonHai"},
-    {{0x9C, 0xD2, 0x1E}, "HonHai"},
-    {{0xA0, 0xC5, 0x89}, "HonHai"},
-    {{0xB4, 0xB6, 0x76}, "HonHai"},
-    {{0xBC, 0xEE, 0x7B}, "HonHai"},
-    {{0xDC, 0x85, 0xDE}, "HonHai"},
-    {{0xE8, 0x2A, 0xEA}, "HonHai"},
-    {{0xF4, 0x8C, 0x50}, "HonHai"},
-};
+static OuiRegistry<fs::FS, File> registry;
+static_assert(OUI::NAME_LEN == OuiRegistry<fs::FS, File>::NAME_LEN, "OUI::NAME_LEN out of step with the database");
 
-#define OUI_TABLE_SIZE (sizeof(OUI_TABLE) / sizeof(OUI_TABLE[0]))
+static bool copyName(const char* name, char* out, size_t outLen, bool found) {
+    if (outLen == 0) return found;
+    strncpy(out, name, outLen - 1);
+    out[outLen - 1] = '\0';
+    return found;
+}
+
+void OUI::init() {
+    if (!SD.exists(REGISTRY_FILE)) return;
+    if (registry.open(SD, REGISTRY_FILE)) {
+        Serial.printf("[OUI] Vendor database loaded: %lu prefixes\n",
+                      (unsigned long)registry.count());
+    } else {
+        Serial.printf("[OUI] %s unreadable or wrong format, ignoring\n", REGISTRY_FILE);
+    }
+}
 
-// Linear search for vendor (simple and reliable for ~450 entries) [P7]
+// Perfect-hash lookup: one probe whatever the table size [P7]
 const char* OUI::getVendor(const uint8_t* mac) {
-    // Static buffer to return vendor name (thread-safe for single-threaded use)
-    static char vendorBuf[10];
-    
     // Check for locally-administered address (randomized MAC)
     // Bit 1 of first byte = 1 means locally administered (not from manufacturer)
     if (mac[0] & 0x02) {
         return "RANDOM";
     }
     
-    for (size_t i = 0; i < OUI_TABLE_SIZE; i++) {
-        if (mac[0] == pgm_read_byte(&OUI_TABLE[i].oui[0]) &&
-            mac[1] == pgm_read_byte(&OUI_TABLE[i].oui[1]) &&
-            mac[2] == pgm_read_byte(&OUI_TABLE[i].oui[2])) {
-            // Copy vendor string from PROGMEM to static buffer
-            strncpy_P(vendorBuf, OUI_TABLE[i].vendor, sizeof(vendorBuf) - 1);
-            vendorBuf[sizeof(vendorBuf) - 1] = '\0';
-            return vendorBuf;
-        }
+    const char* vendor = OuiTable::vendor(mac);
+    return vendor ? vendor : "UNKNOWN";
+}
+
+bool OUI::lookup(const uint8_t* mac, char* out, size_t outLen) {
+    if (mac[0] & 0x02) return copyName("RANDOM", out, outLen, false);
+    
+    const char* vendor = OuiTable::vendor(mac);
+    if (vendor) return copyName(vendor, out, outLen, true);
+    
+    char name[NAME_LEN + 1];
+    if (registry.isOpen() && registry.lookup(OuiTable::key(mac), name, sizeof(name))) {
+        return copyName(name, out, outLen, true);
     }
-    return "UNKNOWN";
+    return copyName("UNKNOWN", out, outLen, false);
+}
+
+bool OUI::hasRegistry() {
+    return registry.isOpen();
 }
 
 // Self-test: verify table has entries [P7]
@@ -540,16 +65,14 @@ bool OUI::selfTest() {
         return false;
     }
     
-    // Quick sanity check - first and last entries should be readable
-    uint8_t firstOUI[3];
-    firstOUI[0] = pgm_read_byte(&OUI_TABLE[0].oui[0]);
-    firstOUI[1] = pgm_read_byte(&OUI_TABLE[0].oui[1]);
-    firstOUI[2] = pgm_read_byte(&OUI_TABLE[0].oui[2]);
-    
-    if (firstOUI[0] == 0 && firstOUI[1] == 0 && firstOUI[2] == 0) {
-        Serial.println("[OUI] WARNING: First entry is all zeros");
+    // Index consistency is a static_assert; check the runtime path agrees
+    for (size_t i = 0; i < OUI_TABLE_SIZE; i++) {
+        if (OuiTable::find(OuiTable::keyAt(i)) != i) {
+            Serial.printf("[OUI] ERROR: Entry %u not found by index\n", (unsigned)i);
+            return false;
+        }
     }
     
-    Serial.printf("[OUI] Self-test passed, %d vendors loaded\n", OUI_TABLE_SIZE);
+    Serial.printf("[OUI] Self-test passed, %u vendors loaded\n", (unsigned)OUI_TABLE_SIZE);
     return true;
 }
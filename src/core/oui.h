@@ -5,9 +5,25 @@
 #include <Arduino.h>
 
 namespace OUI {
-    // Get vendor name for MAC address (returns "Unknown" if not found)
+    // Open the SD vendor database (/oui.bin) if the card has one
+    void init();
+    
+    // Built-in table only: no card access, safe from WiFi callbacks.
+    // Returns "RANDOM" for locally administered MACs, "UNKNOWN" if not found.
+    // The pointer stays valid, so callers may cache it.
     const char* getVendor(const uint8_t* mac);
     
+    // Longest vendor name lookup() can copy out (SD database names)
+    const size_t NAME_LEN = 28;
+    
+    // Built-in table, then the SD database. Main loop only (reads the card).
+    // Copies the name, "RANDOM" or "UNKNOWN" into out (NAME_LEN + 1 fits
+    // any); true if a vendor was found.
+    bool lookup(const uint8_t* mac, char* out, size_t outLen);
+    
+    // SD database loaded
+    bool hasRegistry();
+    
     // Self-test: verify table integrity at startup [P7]
     bool selfTest();
 }
@@ -0,0 +1,90 @@
+// OUI Index - perfect-hash seeds and slots for OUI_TABLE
+// Generated by scripts/gen_oui_index.py from oui_table.h - do not edit.
+#pragma once
+
+#include <stdint.h>
+
+static constexpr uint16_t OUI_INDEX_ENTRIES = 454;
+static constexpr uint8_t OUI_BUCKET_BITS = 7;
+static constexpr uint8_t OUI_SLOT_BITS = 9;
+
+static constexpr uint8_t OUI_SEEDS[128] = {
+    0x01, 0x00, 0x02, 0x09, 0x0C, 0x18, 0x00, 0x08, 0x22, 0x04, 0x00, 0x06,
+    0x26, 0x01, 0x00, 0x02, 0x01, 0x04, 0x3D, 0x01, 0x00, 0x02, 0x05, 0x11,
+    0x00, 0x00, 0x05, 0x0A, 0x08, 0x1A, 0x08, 0x02, 0x01, 0x0C, 0x24, 0x16,
+    0x1C, 0x00, 0x05, 0x01, 0x03, 0x05, 0x04, 0x0A, 0x3B, 0x00, 0x23, 0x31,
+    0x06, 0x28, 0x07, 0x03, 0x1B, 0x17, 0x02, 0x27, 0x03, 0x01, 0x0B, 0x00,
+    0x3E, 0x45, 0x12, 0x07, 0x01, 0x10, 0x09, 0x01, 0x14, 0x69, 0x0A, 0x04,
+    0x04, 0x00, 0x07, 0x19, 0x0F, 0x0D, 0x13, 0x4C, 0x04, 0x00, 0x12, 0x1D,
+    0x44, 0x03, 0x18, 0x0A, 0x01, 0x00, 0x1E, 0x1A, 0x04, 0x02, 0x18, 0x02,
+    0x17, 0x0F, 0x24, 0x03, 0x01, 0x48, 0x3A, 0x24, 0x00, 0x1A, 0x05, 0x00,
+    0x05, 0x04, 0x1F, 0x00, 0x00, 0x00, 0x00, 0xAA, 0x00, 0x17, 0x00, 0x11,
+    0x27, 0x0E, 0x27, 0x17, 0x3D, 0x9A, 0x07, 0x00,
+};
+
+static constexpr uint16_t OUI_SLOTS[512] = {
+    0x0061, 0x0099, 0x001D, 0x0136, 0xFFFF, 0x012E, 0x001F, 0xFFFF,
+    0x015C, 0x0147, 0x00B2, 0x01AD, 0x00E3, 0x0059, 0x007C, 0xFFFF,
+    0x00AB, 0x0094, 0x0162, 0x0032, 0x0157, 0x0180, 0x01C2, 0x00E9,
+    0x018B, 0x0193, 0x0042, 0x00C4, 0x00A9, 0x0170, 0x00B5, 0x00C0,
+    0x0077, 0x00B4, 0x017E, 0x0101, 0x0069, 0x0179, 0x00BE, 0x0150,
+    0x010B, 0x0123, 0x005F, 0x00F6, 0xFFFF, 0x0070, 0x0171, 0x0165,
+    0x005D, 0x0028, 0x0119, 0xFFFF, 0x007E, 0x012B, 0x016A, 0x0006,
+    0x006A, 0x00FC, 0x0134, 0x01B6, 0x0074, 0xFFFF, 0x0067, 0x015F,
+    0x007D, 0x0141, 0x01A6, 0xFFFF, 0x0036, 0xFFFF, 0x00FB, 0x018C,
+    0x00A1, 0x003A, 0x00D6, 0x01BA, 0x009D, 0x0056, 0x0114, 0x00F1,
+    0x001C, 0x01A9, 0x004B, 0x0110, 0x0160, 0x016F, 0x0105, 0xFFFF,
+    0x0156, 0x00A0, 0x00D7, 0x010F, 0x01A5, 0x00F0, 0x0003, 0x013B,
+    0x0113, 0x0082, 0x0172, 0x008C, 0x013F, 0xFFFF, 0x00E1, 0x0152,
+    0x00C2, 0x0087, 0x0075, 0x012D, 0x00CC, 0x0197, 0x0060, 0x0000,
+    0xFFFF, 0x00FE, 0x00D8, 0x0004, 0x019F, 0x0068, 0x0062, 0x0100,
+    0x009C, 0x01BF, 0x0015, 0x004A, 0x00A6, 0x0007, 0x01AE, 0x0018,
+    0xFFFF, 0x01BD, 0x01BC, 0x000F, 0x0045, 0x00E6, 0x0158, 0xFFFF,
+    0x01A0, 0x012C, 0x0023, 0x011C, 0x0126, 0x0083, 0x0027, 0x009F,
+    0x0109, 0x017D, 0x010D, 0x015B, 0xFFFF, 0x0176, 0x0107, 0x014A,
+    0x00BB, 0x002C, 0x01A7, 0x0098, 0x00CF, 0x006B, 0x016D, 0xFFFF,
+    0x00AC, 0x0173, 0x013E, 0x0133, 0x0121, 0xFFFF, 0x0096, 0x002B,
+    0x0030, 0x00B7, 0xFFFF, 0x0064, 0x016B, 0x004D, 0x0112, 0x002F,
+    0xFFFF, 0x011F, 0x00F9, 0x00DE, 0x0144, 0x0174, 0x00FD, 0x0132,
+    0x0049, 0x01C1, 0x010E, 0x01B8, 0x000C, 0x0159, 0x00D2, 0xFFFF,
+    0x011E, 0x017B, 0x00DD, 0x0043, 0x008D, 0x00FF, 0x017A, 0x0065,
+    0x0135, 0x0187, 0x00F3, 0xFFFF, 0x00DF, 0x00EE, 0x006C, 0x0058,
+    0xFFFF, 0xFFFF, 0x0168, 0xFFFF, 0x0097, 0xFFFF, 0x0073, 0x0002,
+    0xFFFF, 0x00BF, 0x016E, 0x0044, 0x00FA, 0xFFFF, 0xFFFF, 0x0016,
+    0x0079, 0x000A, 0xFFFF, 0x0066, 0x0161, 0x0053, 0x008F, 0x003E,
+    0x002E, 0x00DA, 0x01C4, 0xFFFF, 0x00B1, 0x00EB, 0x005C, 0x0076,
+    0x0081, 0x01B1, 0x0188, 0x012A, 0x0019, 0x000D, 0x0137, 0x0117,
+    0x00F5, 0x0012, 0x007F, 0x009B, 0x0182, 0xFFFF, 0x00E5, 0xFFFF,
+    0xFFFF, 0x00E7, 0x00DC, 0x006F, 0x0175, 0x01B5, 0x0149, 0x006D,
+    0x0080, 0x010A, 0x0054, 0x014B, 0x0139, 0x001E, 0x0151, 0x018D,
+    0xFFFF, 0x009A, 0x005A, 0x019B, 0x00C5, 0x0095, 0x013D, 0x0050,
+    0x007B, 0xFFFF, 0x012F, 0x00CA, 0x01B4, 0x0072, 0x0153, 0xFFFF,
+    0x00E2, 0x0029, 0x001B, 0xFFFF, 0x00C1, 0x0078, 0x0167, 0x00B8,
+    0x0104, 0x0017, 0x00D9, 0xFFFF, 0x0154, 0x00AE, 0x0124, 0x0127,
+    0x00F8, 0x01AB, 0x00A4, 0x0183, 0x0024, 0x0118, 0x00CE, 0xFFFF,
+    0xFFFF, 0x018F, 0x0037, 0x0125, 0x0091, 0x019D, 0x0192, 0x01AC,
+    0x0010, 0x000E, 0x00AF, 0xFFFF, 0x017F, 0x014E, 0x0148, 0x0185,
+    0x01BE, 0x0026, 0xFFFF, 0x0186, 0x00A8, 0x0084, 0x01A2, 0x00C7,
+    0xFFFF, 0x00C6, 0x0196, 0x01B7, 0x01A4, 0x00F4, 0x01AF, 0x00C9,
+    0x0199, 0x015E, 0x003F, 0x0143, 0xFFFF, 0x0194, 0x0166, 0xFFFF,
+    0x0120, 0x0031, 0xFFFF, 0x0138, 0x0189, 0x001A, 0xFFFF, 0xFFFF,
+    0x014C, 0x00E0, 0x0033, 0x00EC, 0x00D3, 0x019A, 0x0145, 0x0129,
+    0x006E, 0x0131, 0x01B3, 0x0021, 0x014D, 0x00BD, 0x003C, 0x00E8,
+    0x003B, 0x005E, 0x0034, 0x0198, 0x01B0, 0x0155, 0x00CD, 0x00D5,
+    0x0048, 0x00ED, 0x0055, 0x0164, 0x0195, 0xFFFF, 0x01C3, 0x01A8,
+    0x0092, 0x0038, 0x01A3, 0xFFFF, 0x002A, 0x00E4, 0x01BB, 0x011B,
+    0x00A7, 0x00BC, 0x0190, 0x00EF, 0x009E, 0xFFFF, 0x0001, 0x0022,
+    0x019E, 0x0085, 0x0011, 0x0035, 0x00C3, 0x0057, 0x0122, 0x003D,
+    0x0090, 0x0106, 0x010C, 0x0184, 0x016C, 0xFFFF, 0x0102, 0x0039,
+    0x00F7, 0x00B9, 0xFFFF, 0x0088, 0x00D0, 0x011A, 0x01B2, 0x0041,
+    0x00D4, 0xFFFF, 0x002D, 0x013A, 0x00AD, 0x011D, 0x019C, 0x004F,
+    0x0142, 0x0163, 0x0009, 0x0013, 0x0025, 0x004C, 0x0177, 0x01C5,
+    0xFFFF, 0x00BA, 0x00EA, 0x008E, 0x015A, 0x00A3, 0x0111, 0x0181,
+    0x00CB, 0x00DB, 0xFFFF, 0x0051, 0x018E, 0x00B6, 0x015D, 0xFFFF,
+    0x008A, 0x01A1, 0x0128, 0x0063, 0x0052, 0x0046, 0x00F2, 0x0005,
+    0x0191, 0xFFFF, 0x00A5, 0x0178, 0x014F, 0x0086, 0x0071, 0x00AA,
+    0x000B, 0x00B0, 0x0115, 0x00D1, 0x0130, 0x0020, 0x00C8, 0x0089,
+    0x0169, 0x0146, 0x01AA, 0x00B3, 0x01C0, 0x0040, 0x0116, 0x00A2,
+    0x0093, 0x013C, 0x0008, 0x0047, 0x008B, 0x004E, 0x0103, 0x017C,
+    0x0140, 0x0108, 0x018A, 0x007A, 0x01B9, 0xFFFF, 0x005B, 0x0014,
+};
@@ -0,0 +1,224 @@
+// OUI Registry - optional full IEEE vendor database (/oui.bin) read from the SD card
+// Built by scripts/build_oui_registry.py. Main loop only, never from a WiFi callback.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct OuiRegistryStats {
+    uint32_t lookups;    // lookup() calls
+    uint32_t hits;       // ... that found a name
+    uint32_t reads;      // 512-byte block reads from the card
+    uint32_t cacheHits;  // Record probes served from the block cache
+};
+
+template <typename FsT, typename FileT, uint8_t BLOCKS = 2, uint16_t MAX_FENCES = 256>
+class OuiRegistry {
+    static_assert(BLOCKS >= 1, "OuiRegistry needs a cache block");
+
+public:
+    // Layout (little-endian):
+    //   0   "OUIR", version (1), record size (32), fence count (u16)
+    //   8   record count (u32), stride (u32)
+    //   16  fence count x u32 prefix (every stride-th record's)
+    //   ... records from the next 512-byte boundary: prefix[3], name[29]
+    static const size_t MAX_PATH = 48;
+    static const uint32_t BLOCK = 512;
+    static const uint32_t RECORD = 32;
+    static const size_t NAME_LEN = 28;  // Chars, plus a NUL in the record
+    static const uint32_t HEADER = 16;
+
+    OuiRegistry() : fs(nullptr), fences(nullptr), cache(nullptr), fenceCount(0), records(0),
+                    stride(0), dataOffset(0), clock(0), lastPrefix(0), lastRecord(NONE),
+                    opened(false) {
+        memset(slots, 0, sizeof(slots));
+        memset(&st, 0, sizeof(st));
+        path[0] = '\0';
+    }
+    ~OuiRegistry() { close(); }
+
+    OuiRegistry(const OuiRegistry&) = delete;
+    OuiRegistry& operator=(const OuiRegistry&) = delete;
+
+    bool open(FsT& fsys, const char* filePath) {
+        close();
+        if (!filePath || strlen(filePath) >= MAX_PATH) return false;
+        FileT f = fsys.open(filePath, "r");
+        if (!f) return false;
+
+        uint8_t h[HEADER];
+        if (f.read(h, HEADER) != HEADER || memcmp(h, "OUIR", 4) != 0 ||
+            h[4] != 1 || h[5] != RECORD) {
+            f.close();
+            return false;
+        }
+        fenceCount = h[6] | (h[7] << 8);
+        records = le32(h + 8);
+        stride = le32(h + 12);
+        dataOffset = (HEADER + fenceCount * 4 + BLOCK - 1) / BLOCK * BLOCK;
+        if (records == 0 || stride == 0 || fenceCount == 0 || fenceCount > MAX_FENCES ||
+            fenceCount != (records + stride - 1) / stride ||
+            (uint32_t)f.size() < dataOffset + records * RECORD) {
+            f.close();
+            return false;
+        }
+
+        fences = (uint32_t*)malloc(fenceCount * sizeof(uint32_t));
+        cache = (uint8_t*)malloc(BLOCKS * BLOCK);
+        bool ok = fences && cache && readFences(f);
+        f.close();
+        if (!ok) {
+            close();
+            return false;
+        }
+        fs = &fsys;
+        strcpy(path, filePath);
+        opened = true;
+        return true;
+    }
+
+    void close() {
+        if (file) file.close();
+        free(fences);
+        free(cache);
+        fences = nullptr;
+        cache = nullptr;
+        memset(slots, 0, sizeof(slots));
+        lastRecord = NONE;
+        fs = nullptr;
+        path[0] = '\0';
+        opened = false;
+    }
+
+    bool isOpen() const { return opened; }
+    uint32_t count() const { return records; }
+
+    // Name for a 24-bit prefix into name (n bytes, NUL-terminated)
+    bool lookup(uint32_t prefix, char* name, size_t n) {
+        bool found = find(prefix, name, n);
+        if (file) file.close();
+        return found;
+    }
+
+    OuiRegistryStats stats() const { return st; }
+
+private:
+    struct Slot {
+        bool valid;
+        uint32_t block;
+        uint32_t lastUse;
+    };
+
+    static const uint32_t NONE = 0xFFFFFFFF;  // Nothing remembered
+    static const uint32_t MISS = 0xFFFFFFFE;  // lastPrefix isn't in the file
+
+    bool find(uint32_t prefix, char* name, size_t n) {
+        if (!opened || n == 0) return false;
+        st.lookups++;
+        if (prefix == lastPrefix && lastRecord != NONE) {
+            return copyName(lastRecord, name, n);
+        }
+        lastPrefix = prefix;
+        lastRecord = MISS;
+
+        // Last fence <= prefix bounds the span
+        uint32_t lo = 0, hi = fenceCount;
+        while (lo < hi) {
+            uint32_t mid = (lo + hi) / 2;
+            if (fences[mid] <= prefix) lo = mid + 1;
+            else hi = mid;
+        }
+        if (lo == 0) return false;
+        lo = (lo - 1) * stride;
+        hi = lo + stride < records ? lo + stride : records;
+
+        while (lo < hi) {
+            uint32_t mid = (lo + hi) / 2;
+            const uint8_t* rec = record(mid);
+            if (!rec) {
+                lastRecord = NONE;  // Card error: don't remember a miss
+                return false;
+            }
+            uint32_t k = ((uint32_t)rec[0] << 16) | ((uint32_t)rec[1] << 8) | rec[2];
+            if (k == prefix) {
+                lastRecord = mid;
+                return copyName(mid, name, n);
+            }
+            if (k < prefix) lo = mid + 1;
+            else hi = mid;
+        }
+        return false;
+    }
+
+    bool copyName(uint32_t i, char* name, size_t n) {
+        if (i == MISS) return false;
+        const uint8_t* rec = record(i);
+        if (!rec) return false;
+        size_t len = strnlen((const char*)rec + 3, NAME_LEN);
+        if (len > n - 1) len = n - 1;
+        memcpy(name, rec + 3, len);
+        name[len] = '\0';
+        st.hits++;
+        return true;
+    }
+
+    static uint32_t le32(const uint8_t* p) {
+        return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+    }
+
+    bool readFences(FileT& f) {
+        if (!f.seek(HEADER)) return false;
+        for (uint16_t i = 0; i < fenceCount; i++) {
+            uint8_t b[4];
+            if (f.read(b, 4) != 4) return false;
+            fences[i] = le32(b);
+        }
+        return true;
+    }
+
+    // Record i through the block cache (records never straddle a block)
+    const uint8_t* record(uint32_t i) {
+        uint32_t off = dataOffset + i * RECORD;
+        uint32_t block = off / BLOCK;
+        Slot* victim = &slots[0];
+        for (uint8_t s = 0; s < BLOCKS; s++) {
+            if (slots[s].valid && slots[s].block == block) {
+                slots[s].lastUse = ++clock;
+                st.cacheHits++;
+                return cache + s * BLOCK + off % BLOCK;
+            }
+            if (!slots[s].valid || (victim->valid && slots[s].lastUse < victim->lastUse)) {
+                victim = &slots[s];
+            }
+        }
+        uint8_t* data = cache + (victim - slots) * BLOCK;
+        victim->valid = false;
+        if (!file) file = fs->open(path, "r");  // Closed again by lookup()
+        if (!file) return nullptr;
+        size_t want = off % BLOCK + RECORD;
+        if (!file.seek(block * BLOCK) || (size_t)file.read(data, BLOCK) < want) return nullptr;
+        st.reads++;
+        victim->valid = true;
+        victim->block = block;
+        victim->lastUse = ++clock;
+        return data + off % BLOCK;
+    }
+
+    FsT* fs;
+    FileT file;
+    char path[MAX_PATH];
+    uint32_t* fences;
+    uint8_t* cache;
+    Slot slots[BLOCKS];
+    uint16_t fenceCount;
+    uint32_t records;
+    uint32_t stride;
+    uint32_t dataOffset;
+    uint32_t clock;
+    uint32_t lastPrefix;
+    uint32_t lastRecord;
+    bool opened;
+    OuiRegistryStats st;
+};
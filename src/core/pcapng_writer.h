@@ -0,0 +1,233 @@
+// PCAPNG Writer - one capture file per session, double-buffered, written in whole blocks
+// Main loop only. The sink is anything with write(const uint8_t*, size_t).
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct PcapngStats {
+    uint32_t frames;        // Enhanced Packet Blocks appended
+    uint32_t dropped;       // append() with both buffers waiting on the card
+    uint32_t bytes;         // Bytes handed to the sink
+    uint32_t writes;        // Sink write() calls
+    uint32_t writeErrors;   // Short writes (the data is lost, the file may be torn)
+    uint32_t buffered;      // Bytes formatted but not yet written
+};
+
+template <size_t BLOCK_SIZE>
+class PcapngWriter {
+    static_assert(BLOCK_SIZE >= 2048 && BLOCK_SIZE % 512 == 0,
+                  "PcapngWriter block must be a multiple of the 512-byte SD sector");
+
+public:
+    static const uint16_t LINKTYPE_RADIOTAP = 127;
+    static const uint16_t RADIOTAP_LEN = 13;  // Header + channel + dBm antenna signal
+    static const uint16_t MAX_FRAME_LEN = 2304;
+
+    PcapngWriter() : mem(nullptr) { resetState(); }
+    ~PcapngWriter() { end(); }
+
+    PcapngWriter(const PcapngWriter&) = delete;
+    PcapngWriter& operator=(const PcapngWriter&) = delete;
+
+    // Allocate both buffers and queue the section + interface header.
+    // appName goes into shb_userappl; false on OOM.
+    bool begin(const char* appName) {
+        end();
+        mem = (uint8_t*)malloc(BLOCK_SIZE * 2);
+        if (!mem) return false;
+        resetState();
+        writeSectionHeader(appName);
+        writeInterfaceDescription();
+        return true;
+    }
+
+    // Free the buffers; anything not flushed is discarded
+    void end() {
+        free(mem);
+        mem = nullptr;
+        resetState();
+    }
+
+    bool active() const { return mem != nullptr; }
+
+    // Queue one 802.11 frame. tsUs is microseconds on the session clock.
+    bool append(const uint8_t* frame, uint16_t len, uint32_t origLen,
+                uint64_t tsUs, uint8_t channel, int8_t rssi) {
+        if (!mem || !frame || len == 0 || len > MAX_FRAME_LEN) return false;
+        uint32_t capLen = RADIOTAP_LEN + len;
+        uint32_t blockLen = 28 + pad4(capLen) + 4;
+        if (blockLen > room()) {
+            st.dropped++;
+            return false;
+        }
+        if (origLen < len) origLen = len;
+
+        put32(6);  // Enhanced Packet Block
+        put32(blockLen);
+        put32(0);  // Interface 0
+        put32((uint32_t)(tsUs >> 32));
+        put32((uint32_t)tsUs);
+        put32(capLen);
+        put32(RADIOTAP_LEN + origLen);
+
+        uint8_t rt[RADIOTAP_LEN];
+        rt[0] = 0;                        // Revision
+        rt[1] = 0;                        // Pad
+        rt[2] = RADIOTAP_LEN; rt[3] = 0;  // Length
+        rt[4] = 0x28; rt[5] = 0; rt[6] = 0; rt[7] = 0;  // Present: channel (3), dBm signal (5)
+        uint16_t freq = channelFreq(channel);
+        rt[8] = freq & 0xFF; rt[9] = freq >> 8;
+        rt[10] = 0x80; rt[11] = 0x00;     // 2 GHz spectrum
+        rt[12] = (uint8_t)rssi;
+        put(rt, RADIOTAP_LEN);
+        put(frame, len);
+        putPad(capLen);
+        put32(blockLen);
+        st.frames++;
+        return true;
+    }
+
+    // A full buffer is waiting for flush()
+    bool pending() const { return queued[0] || queued[1]; }
+
+    // Write queued full buffers, oldest first. False on a short write.
+    template <typename Sink>
+    bool flush(Sink& out) {
+        bool ok = true;
+        int other = cur ^ 1;
+        if (queued[other]) ok &= writeBuffer(out, other, BLOCK_SIZE);
+        if (queued[cur]) {
+            // Both filled while the card was busy: cur held its place
+            ok &= writeBuffer(out, cur, BLOCK_SIZE);
+            used = 0;
+        }
+        return ok;
+    }
+
+    // flush() plus the partial active buffer (session end)
+    template <typename Sink>
+    bool finish(Sink& out) {
+        bool ok = flush(out);
+        if (used) {
+            ok &= writeBuffer(out, cur, used);
+            used = 0;
+        }
+        return ok;
+    }
+
+    PcapngStats stats() const {
+        PcapngStats s = st;
+        s.buffered = used + (queued[cur ^ 1] ? BLOCK_SIZE : 0);
+        return s;
+    }
+
+    static size_t blockSize() { return BLOCK_SIZE; }
+
+private:
+    static uint32_t pad4(uint32_t n) { return (n + 3) & ~3u; }
+
+    static uint16_t channelFreq(uint8_t ch) {
+        if (ch == 14) return 2484;
+        if (ch >= 1 && ch <= 13) return 2407 + 5 * ch;
+        return 0;
+    }
+
+    // Bytes that can be formatted before both buffers are queued
+    size_t room() const {
+        if (queued[cur]) return 0;
+        return (BLOCK_SIZE - used) + (queued[cur ^ 1] ? 0 : BLOCK_SIZE);
+    }
+
+    void writeSectionHeader(const char* appName) {
+        size_t appLen = appName ? strlen(appName) : 0;
+        if (appLen > 64) appLen = 64;
+        uint32_t optLen = appLen ? 4 + pad4(appLen) : 0;
+        uint32_t blockLen = 24 + optLen + 4 + 4;
+
+        put32(0x0A0D0D0A);  // Section Header Block
+        put32(blockLen);
+        put32(0x1A2B3C4D);  // Byte-order magic (written native: little-endian)
+        put16(1);           // Major
+        put16(0);           // Minor
+        put32(0xFFFFFFFF);  // Section length unknown
+        put32(0xFFFFFFFF);
+        if (appLen) {
+            put16(4);       // shb_userappl
+            put16((uint16_t)appLen);
+            put((const uint8_t*)appName, appLen);
+            putPad(appLen);
+        }
+        put32(0);           // opt_endofopt
+        put32(blockLen);
+    }
+
+    void writeInterfaceDescription() {
+        uint32_t blockLen = 16 + 8 + 4 + 4;
+        put32(1);           // Interface Description Block
+        put32(blockLen);
+        put16(LINKTYPE_RADIOTAP);
+        put16(0);
+        put32(RADIOTAP_LEN + MAX_FRAME_LEN);  // Snaplen
+        put16(9);           // if_tsresol
+        put16(1);
+        put32(6);           // 10^-6 s, then 3 pad bytes
+        put32(0);           // opt_endofopt
+        put32(blockLen);
+    }
+
+    void put16(uint16_t v) { put((const uint8_t*)&v, 2); }
+    void put32(uint32_t v) { put((const uint8_t*)&v, 4); }
+
+    void putPad(uint32_t n) {
+        static const uint8_t zeros[3] = {0, 0, 0};
+        put(zeros, pad4(n) - n);
+    }
+
+    // Caller checked room(): everything fits across cur and the other buffer
+    void put(const uint8_t* src, size_t n) {
+        while (n) {
+            size_t chunk = BLOCK_SIZE - used;
+            if (chunk > n) chunk = n;
+            memcpy(mem + cur * BLOCK_SIZE + used, src, chunk);
+            used += chunk;
+            src += chunk;
+            n -= chunk;
+            if (used == BLOCK_SIZE) {
+                queued[cur] = true;
+                if (!queued[cur ^ 1]) {
+                    cur ^= 1;
+                    used = 0;
+                }
+            }
+        }
+    }
+
+    template <typename Sink>
+    bool writeBuffer(Sink& out, int which, size_t n) {
+        size_t w = out.write(mem + which * BLOCK_SIZE, n);
+        st.writes++;
+        st.bytes += w;
+        queued[which] = false;
+        if (w != n) {
+            st.writeErrors++;
+            return false;
+        }
+        return true;
+    }
+
+    void resetState() {
+        memset(&st, 0, sizeof(st));
+        cur = 0;
+        used = 0;
+        queued[0] = queued[1] = false;
+    }
+
+    uint8_t* mem;
+    int cur;
+    size_t used;
+    bool queued[2];
+    PcapngStats st;
+};
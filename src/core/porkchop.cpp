@@ -25,6 +25,7 @@
 #include "xp.h"
 #include "sdlog.h"
 #include "challenges.h"
+#include "capture_stats.h"
 
 Porkchop::Porkchop() 
     : currentMode(PorkchopMode::IDLE)
@@ -431,6 +432,14 @@ void Porkchop::handleInput() {
         }
     }
     
+    // 2 key - dump capture telemetry to Serial + SD log (IDLE, OINK, DNH)
+    if (currentMode == PorkchopMode::IDLE || currentMode == PorkchopMode::OINK_MODE ||
+        currentMode == PorkchopMode::DNH_MODE) {
+        for (auto c : keys.word) {
+            if (c == '2') CaptureTelemetry::dump("key");
+        }
+    }
+    
     // Mode shortcuts when in IDLE
     if (currentMode == PorkchopMode::IDLE) {
         for (auto c : keys.word) {
@@ -5,6 +5,24 @@
 #include <SD.h>
 #include <stdarg.h>
 
+// Ring and drain policy: lines wait in RAM until 1KB has piled up or the
+// oldest is 2s old, then go to the card in one append
+static const size_t LOG_RING_BYTES = 4096;
+static const size_t LOG_DRAIN_BYTES = 1024;
+static const uint32_t LOG_FLUSH_MS = 2000;
+static const uint32_t LOG_ROTATE_BYTES = 512 * 1024;
+static const char* LOG_PATH = "/logs/porkchop.log";
+static const char* LOG_OLD_PATH = "/logs/porkchop.1.log";
+
+// log() can be reached from callbacks on other tasks
+static portMUX_TYPE logMux = portMUX_INITIALIZER_UNLOCKED;
+struct SDLogLock {
+    static void lock() { portENTER_CRITICAL(&logMux); }
+    static void unlock() { portEXIT_CRITICAL(&logMux); }
+};
+
+static LogRing<fs::FS, File, LOG_RING_BYTES, SDLogLock> ring;
+
 bool SDLog::logEnabled = false;
 bool SDLog::initialized = false;
 String SDLog::currentLogFile = "";
@@ -29,6 +47,8 @@ void SDLog::setEnabled(bool enabled) {
         Serial.printf("[SDLOG] Logging now ENABLED to: %s\n", currentLogFile.c_str());
         log("SDLOG", "SD logging enabled");
     } else {
+        // Don't strand what's already queued
+        ring.flush();
         Serial.printf("[SDLOG] Logging DISABLED\n");
     }
 }
@@ -42,21 +62,20 @@ void SDLog::ensureLogFile() {
         SD.mkdir("/logs");
     }
     
-    // Use fixed filename - easier to find and read
-    currentLogFile = "/logs/porkchop.log";
-    
-    // Create file with header
-    File f = SD.open(currentLogFile.c_str(), FILE_WRITE);
-    if (f) {
-        f.println("=== PORKCHOP LOG ===");
-        f.printf("Started at millis: %lu\n", millis());
-        f.println("====================");
-        f.close();
-        Serial.printf("[SDLOG] Log file: %s\n", currentLogFile.c_str());
-    } else {
-        Serial.printf("[SDLOG] Failed to create: %s\n", currentLogFile.c_str());
-        currentLogFile = "";
+    // Use fixed filename - easier to find and read. Fresh file each boot,
+    // the previous one survives only through rotation.
+    if (!ring.begin(SD, LOG_PATH, LOG_OLD_PATH, LOG_ROTATE_BYTES, true)) {
+        Serial.printf("[SDLOG] Failed to create: %s\n", LOG_PATH);
+        return;
     }
+    currentLogFile = LOG_PATH;
+    
+    char header[48];
+    logRaw("=== PORKCHOP LOG ===");
+    snprintf(header, sizeof(header), "Started at millis: %lu", millis());
+    logRaw(header);
+    logRaw("====================");
+    Serial.printf("[SDLOG] Log file: %s\n", currentLogFile.c_str());
 }
 
 void SDLog::log(const char* tag, const char* format, ...) {
@@ -73,32 +92,20 @@ void SDLog::log(const char* tag, const char* format, ...) {
         }
     }
     
-    // Format the message first (before SD operations)
-    char buffer[256];
+    // Timestamp, tag, then the message (capped at 256 like before)
+    char line[320];
+    int n = snprintf(line, sizeof(line), "[%lu][%s] ", millis(), tag);
+    if (n < 0) return;
+    if (n > (int)sizeof(line) - 258) n = sizeof(line) - 258;
     va_list args;
     va_start(args, format);
-    vsnprintf(buffer, sizeof(buffer), format, args);
+    int m = vsnprintf(line + n, 256, format, args);
     va_end(args);
+    if (m < 0) return;
+    n += (m < 256) ? m : 255;
+    line[n++] = '\n';
     
-    // Debug: show what we're logging
-    Serial.printf("[SDLOG->SD] [%s] %s\n", tag, buffer);
-    
-    // Try to open file with retry on failure (SD can be busy with other operations)
-    File f;
-    for (int retry = 0; retry < 3; retry++) {
-        f = SD.open(currentLogFile.c_str(), FILE_APPEND);
-        if (f) break;
-        delay(5);  // Brief delay before retry
-    }
-    
-    if (!f) {
-        Serial.printf("[SDLOG] Failed to open log file for append\n");
-        return;
-    }
-    
-    // Write timestamp, tag, and message
-    f.printf("[%lu][%s] %s\n", millis(), tag, buffer);
-    f.close();
+    ring.push(line, n);  // Full ring: counted, noted in the log later
 }
 
 void SDLog::logRaw(const char* message) {
@@ -108,27 +115,41 @@ void SDLog::logRaw(const char* message) {
         if (currentLogFile.length() == 0) return;
     }
     
-    // Try to open file with retry on failure
-    File f;
-    for (int retry = 0; retry < 3; retry++) {
-        f = SD.open(currentLogFile.c_str(), FILE_APPEND);
-        if (f) break;
-        delay(5);
-    }
-    
-    if (f) {
-        f.println(message);
-        f.close();
-    }
+    size_t len = strlen(message);
+    char line[258];
+    if (len > sizeof(line) - 1) len = sizeof(line) - 1;
+    memcpy(line, message, len);
+    line[len++] = '\n';
+    ring.push(line, len);
+}
+
+void SDLog::update() {
+    if (!ring.active()) return;
+    ring.update(millis(), LOG_DRAIN_BYTES, LOG_FLUSH_MS);
 }
 
 void SDLog::flush() {
-    // Files are closed after each write, so nothing to flush
+    if (!ring.flush()) {
+        Serial.printf("[SDLOG] Flush hit write errors\n");
+    }
 }
 
 void SDLog::close() {
     if (logEnabled && currentLogFile.length() > 0) {
         log("SDLOG", "Log closed");
     }
+    if (ring.active()) {
+        ring.close();
+        LogRingStats s = ring.stats();
+        Serial.printf("[SDLOG] Closed: %lu lines, %lu dropped, %lu bytes in %lu writes, %lu rotations\n",
+                      (unsigned long)s.lines, (unsigned long)s.dropped,
+                      (unsigned long)s.written, (unsigned long)s.writes,
+                      (unsigned long)s.rotations);
+        ring.end();
+    }
     currentLogFile = "";
 }
+
+LogRingStats SDLog::getStats() {
+    return ring.stats();
+}
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <Arduino.h>
+#include "log_ring.h"
 
 class SDLog {
 public:
@@ -10,15 +11,21 @@ public:
     static bool isEnabled() { return logEnabled; }
     
     // Log functions - mirror Serial.printf behavior
+    // Lines are queued in RAM; update() writes them to the card
     static void log(const char* tag, const char* format, ...);
     static void logRaw(const char* message);
     
-    // Flush to ensure data is written
+    // Drain queued lines when enough have piled up or waited (call from loop)
+    static void update();
+    
+    // Write everything queued and sync the file
     static void flush();
     
-    // Close current log file (call on shutdown)
+    // Flush and close current log file (call on shutdown)
     static void close();
     
+    static LogRingStats getStats();
+    
 private:
     static bool logEnabled;
     static bool initialized;
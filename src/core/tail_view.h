@@ -0,0 +1,227 @@
+// Tail View - a fixed window of lines over a text file, found by seeking from EOF
+// Memory is LINES x COLS plus two read blocks, whatever the file's size.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+struct TailViewStats {
+    uint32_t reads;      // Block reads from the file
+    uint32_t bytesRead;  // Bytes those reads returned
+};
+
+template <typename FileT, uint8_t LINES, uint8_t COLS, size_t BLOCK = 512>
+class TailView {
+    static_assert(LINES > 0 && COLS > 0, "TailView needs a window");
+
+public:
+    TailView() { reset(); }
+
+    // Take over an open file and show its last lines
+    bool open(FileT f) {
+        close();
+        if (!f) return false;
+        file = f;
+        fileSize = file.size();
+        tail();
+        return true;
+    }
+
+    void close() {
+        if (file) file.close();
+        reset();
+    }
+
+    bool isOpen() const { return (bool)file; }
+
+    // Swap in a fresh handle to the same file (follow mode). True if the
+    // window changed.
+    bool refresh(FileT f) {
+        if (!f) return false;
+        if (file) file.close();
+        file = f;
+        uint32_t newSize = file.size();
+        dropBlocks();
+        if (newSize == fileSize) return false;
+        bool wasAtEnd = atEnd();
+        bool shrank = newSize < fileSize;
+        fileSize = newSize;
+        if (shrank || wasAtEnd) {
+            tail();
+            return true;
+        }
+        return false;
+    }
+
+    // Move the window by delta lines (negative = up). Returns lines moved.
+    int scroll(int delta) {
+        int moved = 0;
+        while (delta < 0 && scrollUp()) { delta++; moved--; }
+        while (delta > 0 && scrollDown()) { delta--; moved++; }
+        return moved;
+    }
+
+    uint8_t count() const { return used; }
+    const char* line(uint8_t i) const { return i < used ? text[i] : ""; }
+
+    // Window sits on the last line of the file
+    bool atEnd() const { return used == 0 || next[used - 1] >= fileSize; }
+    bool atStart() const { return used == 0 || !findPrev(start[0], nullptr); }
+
+    uint32_t size() const { return fileSize; }
+    // Byte span of the window: first line's start, just past the last line
+    uint32_t position() const { return used ? start[0] : 0; }
+    uint32_t windowEnd() const { return used ? next[used - 1] : 0; }
+
+    TailViewStats stats() const { return st; }
+
+private:
+    void reset() {
+        used = 0;
+        fileSize = 0;
+        dropBlocks();
+        memset(&st, 0, sizeof(st));
+    }
+
+    // Fill the window with the last LINES lines, oldest first
+    void tail() {
+        used = 0;
+        uint32_t lineStart;
+        uint32_t end = fileSize;
+        uint32_t starts[LINES];
+        uint8_t n = 0;
+        while (n < LINES && findPrev(end, &lineStart)) {
+            starts[LINES - 1 - n] = lineStart;
+            end = lineStart;
+            n++;
+        }
+        for (uint8_t i = 0; i < n; i++) {
+            start[i] = starts[LINES - n + i];
+            readLine(start[i], next[i], text[i]);
+        }
+        used = n;
+    }
+
+    bool scrollUp() {
+        uint32_t prev;
+        if (used == 0 || !findPrev(start[0], &prev)) return false;
+        uint8_t keep = used < LINES ? used : LINES - 1;
+        memmove(&start[1], &start[0], keep * sizeof(start[0]));
+        memmove(&next[1], &next[0], keep * sizeof(next[0]));
+        memmove(&text[1], &text[0], keep * sizeof(text[0]));
+        used = keep + 1;
+        start[0] = prev;
+        readLine(prev, next[0], text[0]);
+        return true;
+    }
+
+    bool scrollDown() {
+        if (used == 0) return false;
+        uint32_t s = next[used - 1];
+        uint32_t nx;
+        char buf[COLS + 1];
+        while (s < fileSize) {
+            if (readLine(s, nx, buf)) break;
+            s = nx;  // Blank line
+        }
+        if (s >= fileSize) return false;
+        if (used == LINES) {
+            memmove(&start[0], &start[1], (LINES - 1) * sizeof(start[0]));
+            memmove(&next[0], &next[1], (LINES - 1) * sizeof(next[0]));
+            memmove(&text[0], &text[1], (LINES - 1) * sizeof(text[0]));
+            used--;
+        }
+        start[used] = s;
+        next[used] = nx;
+        memcpy(text[used], buf, sizeof(buf));
+        used++;
+        return true;
+    }
+
+    // Start of the last non-blank line ending before end (a line start or EOF)
+    bool findPrev(uint32_t end, uint32_t* out) const {
+        while (end > 0) {
+            uint32_t p = end;
+            if (byteAt(p - 1) == '\n') p--;  // That line's terminator
+            uint32_t s = p;
+            bool blank = true;
+            while (s > 0) {
+                int c = byteAt(s - 1);
+                if (c == '\n' || c < 0) break;
+                if (c != ' ' && c != '\t' && c != '\r') blank = false;
+                s--;
+            }
+            if (!blank) {
+                if (out) *out = s;
+                return true;
+            }
+            if (s == end) return false;  // Read failure, no progress
+            end = s;
+        }
+        return false;
+    }
+
+    // Copy the line at s (leading/trailing whitespace trimmed, COLS max)
+    // into out, set nx to the next line's start. False if it's blank.
+    bool readLine(uint32_t s, uint32_t& nx, char* out) const {
+        size_t n = 0;
+        size_t lastSolid = 0;
+        uint32_t p = s;
+        int c;
+        while (p < fileSize && (c = byteAt(p)) >= 0 && c != '\n') {
+            p++;
+            if (n == 0 && (c == ' ' || c == '\t' || c == '\r')) continue;
+            if (n < COLS) {
+                out[n++] = (char)c;
+                if (c != ' ' && c != '\t' && c != '\r') lastSolid = n;
+            }
+        }
+        nx = p < fileSize ? p + 1 : fileSize;
+        out[lastSolid] = '\0';
+        return lastSolid > 0;
+    }
+
+    // One byte through the block cache; -1 on a read failure. Two blocks so
+    // a line straddling a boundary doesn't reload one each way per byte.
+    int byteAt(uint32_t pos) const {
+        for (uint8_t i = 0; i < 2; i++) {
+            if (blockValid[i] && pos >= blockOff[i] && pos < blockOff[i] + blockLen[i]) {
+                older = i ^ 1;
+                return block[i][pos - blockOff[i]];
+            }
+        }
+        uint8_t i = older;
+        uint32_t off = pos - pos % BLOCK;
+        blockValid[i] = false;
+        if (!file.seek(off)) return -1;
+        size_t n = file.read(block[i], BLOCK);
+        st.reads++;
+        st.bytesRead += n;
+        blockOff[i] = off;
+        blockLen[i] = n;
+        blockValid[i] = true;
+        older = i ^ 1;
+        if (pos >= off + n) return -1;
+        return block[i][pos - off];
+    }
+
+    void dropBlocks() {
+        blockValid[0] = blockValid[1] = false;
+        older = 0;
+    }
+
+    mutable FileT file;
+    uint32_t fileSize;
+    uint8_t used;
+    uint32_t start[LINES];
+    uint32_t next[LINES];
+    char text[LINES][COLS + 1];
+
+    mutable uint8_t block[2][BLOCK];
+    mutable uint32_t blockOff[2];
+    mutable size_t blockLen[2];
+    mutable bool blockValid[2];
+    mutable uint8_t older;
+    mutable TailViewStats st;
+};
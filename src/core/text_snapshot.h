@@ -0,0 +1,217 @@
+// Text Snapshot - stamped binary cache and string arena for text-file stores
+// The text files stay the source of truth: a snapshot is used only while their stamps match.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+struct TextStoreStats {
+    uint32_t parsedLines;     // Text lines turned into entries
+    uint32_t skippedLines;    // Text lines that weren't a record
+    uint32_t snapshotLoads;   // Loads served from the binary snapshot
+    uint32_t snapshotWrites;  // Snapshot rewrites
+};
+
+// Size and mtime of a source text file, zero if missing
+struct FileStamp {
+    uint32_t size;
+    uint32_t time;
+};
+
+// Snapshot file: this header, count records (one or more parallel arrays),
+// then the arena
+struct SnapshotHeader {
+    char magic[4];
+    uint8_t version;
+    uint8_t recordSize;    // Bytes per record across all arrays
+    uint16_t reserved;
+    uint32_t count;
+    uint32_t arenaBytes;
+    FileStamp sources[2];  // Unused slots stay zero
+};
+
+static_assert(sizeof(SnapshotHeader) == 32, "Snapshot header is 32 bytes");
+
+struct SnapshotBlock {
+    void* data;
+    size_t bytes;
+};
+
+// Append-only text storage addressed by offset. Replaced or dropped text is
+// counted as garbage until compact() repacks the live spans.
+class StringArena {
+public:
+    StringArena() : dead(0) {}
+
+    uint32_t append(const char* s, size_t len) {
+        uint32_t off = buf.size();
+        buf.insert(buf.end(), s, s + len);
+        return off;
+    }
+
+    // NUL-terminated copy
+    uint32_t appendString(const char* s, size_t len) {
+        uint32_t off = append(s, len);
+        buf.push_back('\0');
+        return off;
+    }
+
+    void release(size_t len) { dead += len; }
+    size_t garbage() const { return dead; }
+
+    // span(i, len) returns record i's offset field and its length, or nullptr
+    // for a record without text
+    template <typename SpanFn>
+    void compact(size_t count, SpanFn span) {
+        std::vector<char> packed;
+        packed.reserve(buf.size() - dead);
+        for (size_t i = 0; i < count; i++) {
+            size_t len = 0;
+            uint32_t* off = span(i, len);
+            if (!off) continue;
+            uint32_t at = packed.size();
+            packed.insert(packed.end(), buf.begin() + *off, buf.begin() + *off + len);
+            *off = at;
+        }
+        buf.swap(packed);
+        dead = 0;
+    }
+
+    char* resize(size_t n) {
+        buf.resize(n);
+        return buf.data();
+    }
+
+    void clear() {
+        std::vector<char>().swap(buf);
+        dead = 0;
+    }
+
+    void shrink() { buf.shrink_to_fit(); }
+
+    const char* at(uint32_t off) const { return &buf[off]; }
+    char* data() { return buf.data(); }
+    const char* data() const { return buf.data(); }
+    size_t size() const { return buf.size(); }
+    size_t capacity() const { return buf.capacity(); }
+    bool empty() const { return buf.empty(); }
+    char back() const { return buf.back(); }
+
+private:
+    std::vector<char> buf;
+    size_t dead;  // Bytes no record points at
+};
+
+template <typename FsT, typename FileT>
+struct TextSnapshot {
+    static SnapshotHeader header(const char* magic, uint8_t version, uint8_t recordSize) {
+        SnapshotHeader h;
+        memset(&h, 0, sizeof(h));
+        memcpy(h.magic, magic, 4);
+        h.version = version;
+        h.recordSize = recordSize;
+        return h;
+    }
+
+    static FileStamp stamp(FsT& fs, const char* path) {
+        FileStamp s = {0, 0};
+        if (!fs.exists(path)) return s;
+        FileT f = fs.open(path, "r");
+        if (!f) return s;
+        s.size = f.size();
+        s.time = (uint32_t)f.getLastWrite();
+        f.close();
+        return s;
+    }
+
+    // Fills the caller's arrays if path matches want (magic, version, record
+    // size, sources) and its size adds up. blocks(h, out) sizes the arrays for
+    // h.count and h.arenaBytes and returns how many spans it put in out (max 4).
+    // The caller still validates the records: a snapshot is never trusted.
+    template <typename BlocksFn>
+    static bool read(FsT& fs, const char* path, const SnapshotHeader& want, uint32_t maxCount,
+                     BlocksFn blocks) {
+        if (!fs.exists(path)) return false;
+        FileT f = fs.open(path, "r");
+        if (!f) return false;
+        SnapshotHeader h;
+        bool ok = f.read((uint8_t*)&h, sizeof(h)) == sizeof(h) &&
+                  memcmp(h.magic, want.magic, 4) == 0 && h.version == want.version &&
+                  h.recordSize == want.recordSize && h.count <= maxCount &&
+                  memcmp(h.sources, want.sources, sizeof(h.sources)) == 0 &&
+                  (size_t)f.size() == sizeof(h) + (size_t)h.count * h.recordSize + h.arenaBytes;
+        if (ok) {
+            SnapshotBlock out[4];
+            size_t n = blocks(h, out);
+            for (size_t i = 0; i < n && ok; i++) ok = readAll(f, out[i].data, out[i].bytes);
+        }
+        f.close();
+        return ok;
+    }
+
+    // A failed write removes the file: half a snapshot must not outlive this boot
+    static bool write(FsT& fs, const char* path, const SnapshotHeader& h,
+                      const SnapshotBlock* blocks, size_t n) {
+        FileT f = fs.open(path, "w");
+        if (!f) return false;
+        bool ok = writeAll(f, &h, sizeof(h));
+        for (size_t i = 0; i < n && ok; i++) ok = writeAll(f, blocks[i].data, blocks[i].bytes);
+        f.close();
+        if (!ok) fs.remove(path);
+        return ok;
+    }
+
+    // fn(line, len) for each non-empty line, trimmed and NUL-terminated;
+    // over-long lines are counted in skipped. A missing file has no lines.
+    template <size_t MAX_LINE, typename Fn>
+    static bool forEachLine(FsT& fs, const char* path, uint32_t& skipped, Fn fn) {
+        if (!fs.exists(path)) return true;
+        FileT f = fs.open(path, "r");
+        if (!f) return false;
+        uint8_t chunk[256];
+        char line[MAX_LINE + 1];
+        size_t len = 0;
+        bool tooLong = false;
+        for (;;) {
+            size_t n = f.read(chunk, sizeof(chunk));
+            for (size_t i = 0; i < n; i++) {
+                if (chunk[i] != '\n') {
+                    if (len < MAX_LINE) line[len++] = (char)chunk[i];
+                    else tooLong = true;
+                    continue;
+                }
+                if (tooLong) skipped++;
+                else emitLine(line, len, fn);
+                len = 0;
+                tooLong = false;
+            }
+            if (n < sizeof(chunk)) break;
+        }
+        if (tooLong) skipped++;
+        else emitLine(line, len, fn);  // Unterminated last line
+        f.close();
+        return true;
+    }
+
+private:
+    static bool readAll(FileT& f, void* dst, size_t n) {
+        return n == 0 || (size_t)f.read((uint8_t*)dst, n) == n;
+    }
+
+    static bool writeAll(FileT& f, const void* src, size_t n) {
+        return n == 0 || (size_t)f.write((const uint8_t*)src, n) == n;
+    }
+
+    template <typename Fn>
+    static void emitLine(char* line, size_t len, Fn& fn) {
+        while (len > 0 && strchr(" \t\r", line[len - 1])) len--;
+        size_t start = 0;
+        while (start < len && strchr(" \t", line[start])) start++;
+        len -= start;
+        if (len == 0) return;
+        line[start + len] = '\0';
+        fn(line + start, len);
+    }
+};
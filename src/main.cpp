@@ -7,6 +7,8 @@
 #include "core/porkchop.h"
 #include "core/config.h"
 #include "core/sdlog.h"
+#include "core/capture_catalog.h"
+#include "core/oui.h"
 #include "ui/display.h"
 #include "gps/gps.h"
 #include "piglet/avatar.h"
@@ -40,6 +42,12 @@ void setup() {
     // Init SD logging (will be enabled via settings if user wants)
     SDLog::init();
     
+    // Load the capture catalog (rebuilds from /handshakes if missing)
+    CaptureCatalog::init();
+    
+    // Full vendor database, if /oui.bin is on the card
+    OUI::init();
+    
     // Init display system
     Display::init();
     
@@ -98,6 +106,9 @@ void loop() {
     // Update ML (process any pending callbacks)
     MLInference::update();
     
+    // Write queued SD log lines
+    SDLog::update();
+    
     // Update display
     Display::update();
     
@@ -0,0 +1,258 @@
+// Async Classifier - inference on a worker task, results handed back by drain()
+// SPSC rings both ways, at most DEPTH in flight; no heap or locks on the data path.
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef ARDUINO
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#else
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+struct AsyncClassifierStats {
+    uint32_t submitted;     // Accepted
+    uint32_t rejected;      // DEPTH already in flight
+    uint32_t delivered;     // Drained to the caller
+    uint16_t depth;         // In flight now
+    uint16_t highWater;     // Most ever in flight
+    uint32_t avgLatencyUs;  // Submit to drain
+    uint32_t maxLatencyUs;
+};
+
+template <size_t DEPTH, size_t FEATURES, typename Result>
+class AsyncClassifier {
+    static_assert(DEPTH >= 2 && DEPTH <= 256 && (DEPTH & (DEPTH - 1)) == 0,
+                  "AsyncClassifier depth must be a power of two, 2..256");
+
+public:
+    typedef Result (*ClassifyFn)(const float* features, size_t count);
+
+    // Worker task on the device
+    static const uint32_t WORKER_STACK = 6144;   // Bytes; EI SDK builds need the room
+    static const int WORKER_CORE = 0;            // Arduino loop() is on core 1
+    static const uint32_t IDLE_WAIT_MS = 100;    // Wake-up check when stopping
+
+    AsyncClassifier() : classifyFn(nullptr), reqHead(0), reqTail(0), doneHead(0), doneTail(0),
+                        running(false), exited(true), lastTicket(0), submitted(0), delivered(0) {
+#ifdef ARDUINO
+        task = NULL;
+#else
+        pending = false;
+#endif
+        resetStats();
+    }
+
+    ~AsyncClassifier() { stop(); }
+
+    // ---- Lifecycle (main side) ----
+
+    // Start the worker over fn. False if it couldn't be created.
+    bool start(ClassifyFn fn) {
+        if (running.load(std::memory_order_acquire)) return true;
+        classifyFn = fn;
+        exited.store(false, std::memory_order_relaxed);
+        running.store(true, std::memory_order_release);
+#ifdef ARDUINO
+        if (xTaskCreatePinnedToCore(workerEntry, "mlWorker", WORKER_STACK, this, 1, &task,
+                                    WORKER_CORE) != pdPASS) {
+            task = NULL;
+            running.store(false, std::memory_order_release);
+            exited.store(true, std::memory_order_release);
+            return false;
+        }
+#else
+        worker = std::thread(workerEntry, this);
+#endif
+        return true;
+    }
+
+    // Stop the worker after the request it's on. Queued requests stay for
+    // the next start(); finished ones can still be drained.
+    void stop() {
+        if (!running.exchange(false, std::memory_order_acq_rel)) return;
+        wake();
+#ifdef ARDUINO
+        while (!exited.load(std::memory_order_acquire)) vTaskDelay(1);
+        task = NULL;
+#else
+        if (worker.joinable()) worker.join();
+#endif
+    }
+
+    bool isRunning() const { return running.load(std::memory_order_acquire); }
+
+    // ---- Main side ----
+
+    // Queue features[0..count) (at most FEATURES kept). False if DEPTH are
+    // already in flight; never blocks. ticket, if given, gets the request's.
+    bool submit(const float* features, size_t count, uint32_t nowUs, uint32_t* ticket = nullptr) {
+        if (submitted - delivered >= DEPTH) {
+            rejected++;
+            return false;
+        }
+        if (count > FEATURES) count = FEATURES;
+
+        uint32_t h = reqHead.load(std::memory_order_relaxed);
+        Request& r = requests[h & (DEPTH - 1)];
+        r.ticket = ++lastTicket;
+        r.submitUs = nowUs;
+        r.count = (uint16_t)count;
+        memcpy(r.features, features, count * sizeof(float));
+        reqHead.store(h + 1, std::memory_order_release);
+
+        submitted++;
+        uint32_t depth = submitted - delivered;
+        if (depth > highWater) highWater = depth;
+        if (ticket) *ticket = r.ticket;
+        if (running.load(std::memory_order_acquire)) wake();
+        return true;
+    }
+
+    // Hand up to max finished results to deliver(ticket, const Result&),
+    // oldest first. deliver may submit again.
+    template <typename Deliver>
+    size_t drain(uint32_t nowUs, Deliver deliver, size_t max = DEPTH) {
+        size_t n = 0;
+        while (n < max) {
+            uint32_t t = doneTail.load(std::memory_order_relaxed);
+            if (t == doneHead.load(std::memory_order_acquire)) break;
+            Completion c = completions[t & (DEPTH - 1)];
+            doneTail.store(t + 1, std::memory_order_release);
+
+            delivered++;
+            uint32_t latency = nowUs - c.submitUs;
+            latencySum += latency;
+            latencyCount++;
+            if (latency > maxLatency) maxLatency = latency;
+            deliver(c.ticket, c.result);
+            n++;
+        }
+        return n;
+    }
+
+    size_t depth() const { return submitted - delivered; }
+
+    AsyncClassifierStats stats() const {
+        AsyncClassifierStats s;
+        s.submitted = submitted;
+        s.rejected = rejected;
+        s.delivered = delivered;
+        s.depth = (uint16_t)(submitted - delivered);
+        s.highWater = (uint16_t)highWater;
+        s.avgLatencyUs = latencyCount ? (uint32_t)(latencySum / latencyCount) : 0;
+        s.maxLatencyUs = maxLatency;
+        return s;
+    }
+
+    // submitted/delivered carry on: they are also what depth() counts
+    void resetStats() {
+        rejected = 0;
+        highWater = submitted - delivered;
+        latencySum = 0;
+        latencyCount = 0;
+        maxLatency = 0;
+    }
+
+    // ---- Worker side ----
+
+    // Classify one queued request with fn. False if there was none. The
+    // worker loop calls this; tests may call it directly instead of start().
+    bool serviceOne(ClassifyFn fn) {
+        uint32_t t = reqTail.load(std::memory_order_relaxed);
+        if (t == reqHead.load(std::memory_order_acquire)) return false;
+        const Request& r = requests[t & (DEPTH - 1)];
+
+        uint32_t h = doneHead.load(std::memory_order_relaxed);
+        Completion& c = completions[h & (DEPTH - 1)];
+        c.ticket = r.ticket;
+        c.submitUs = r.submitUs;
+        c.result = fn(r.features, r.count);
+        reqTail.store(t + 1, std::memory_order_release);
+        doneHead.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    struct Request {
+        uint32_t ticket;
+        uint32_t submitUs;
+        uint16_t count;
+        float features[FEATURES];
+    };
+
+    struct Completion {
+        uint32_t ticket;
+        uint32_t submitUs;
+        Result result;
+    };
+
+    Request requests[DEPTH];
+    Completion completions[DEPTH];
+    ClassifyFn classifyFn;
+    std::atomic<uint32_t> reqHead;   // Main writes
+    std::atomic<uint32_t> reqTail;   // Worker writes
+    std::atomic<uint32_t> doneHead;  // Worker writes
+    std::atomic<uint32_t> doneTail;  // Main writes
+    std::atomic<bool> running;
+    std::atomic<bool> exited;        // Worker loop has returned
+
+    // Main side only
+    uint32_t lastTicket;
+    uint32_t submitted;
+    uint32_t rejected;
+    uint32_t delivered;
+    uint32_t highWater;
+    uint64_t latencySum;
+    uint32_t latencyCount;
+    uint32_t maxLatency;
+
+#ifdef ARDUINO
+    TaskHandle_t task;
+
+    void wake() {
+        xTaskNotifyGive(task);
+    }
+
+    void idle() {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(IDLE_WAIT_MS));
+    }
+#else
+    std::thread worker;
+    std::mutex wakeLock;
+    std::condition_variable wakeUp;
+    bool pending;  // Guarded by wakeLock
+
+    void wake() {
+        {
+            std::lock_guard<std::mutex> lock(wakeLock);
+            pending = true;
+        }
+        wakeUp.notify_one();
+    }
+
+    void idle() {
+        std::unique_lock<std::mutex> lock(wakeLock);
+        wakeUp.wait_for(lock, std::chrono::milliseconds((uint32_t)IDLE_WAIT_MS), [this] { return pending; });
+        pending = false;
+    }
+#endif
+
+    static void workerEntry(void* arg) {
+        AsyncClassifier* self = static_cast<AsyncClassifier*>(arg);
+        while (self->running.load(std::memory_order_acquire)) {
+            if (!self->serviceOne(self->classifyFn)) self->idle();
+        }
+        self->exited.store(true, std::memory_order_release);
+#ifdef ARDUINO
+        vTaskDelete(NULL);
+#endif
+    }
+};
@@ -0,0 +1,48 @@
+// Batch Classifier - a sweep of networks through a caller-owned arena
+// The loop behind MLInference::classifyBatch, with feature extraction and inference passed in.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Caller-owned memory for a batch: the feature matrix, one row per network
+// (feature f of row r at features[r * FEATURES + f]), and one result per row
+template <typename Result>
+struct BatchArena {
+    float* features;   // FEATURES * capacity floats
+    Result* results;   // capacity results
+    size_t capacity;
+};
+
+class BatchClassifier {
+public:
+    // Up to arena.capacity of networks into arena.results, with no heap;
+    // returns how many:
+    //   toVector(network, float[FEATURES])  model-ready feature vector
+    //   infer(const float* row)             -> Result
+    //   react(confidence)                   once, for the most confident valid
+    //                                       result, if there is one
+    template <size_t FEATURES, typename Network, typename Result,
+              typename ToVector, typename Infer, typename React>
+    static size_t run(const Network* networks, size_t count, BatchArena<Result>& arena,
+                      ToVector toVector, Infer infer, React react) {
+        size_t rows = count < arena.capacity ? count : arena.capacity;
+        if (rows == 0 || !arena.features || !arena.results) return 0;
+
+        float bestConfidence = 0.0f;
+        bool anyValid = false;
+        for (size_t r = 0; r < rows; r++) {
+            // Extracted straight into its row and classified there
+            float* row = arena.features + r * FEATURES;
+            toVector(networks[r], row);
+            Result& result = arena.results[r];
+            result = infer(row);
+            if (!result.valid) continue;
+            anyValid = true;
+            if (result.confidence > bestConfidence) bestConfidence = result.confidence;
+        }
+
+        if (anyValid) react(bestConfidence);
+        return rows;
+    }
+};
@@ -0,0 +1,266 @@
+// Beacon Timing - per-BSSID streaming statistics for the ML timing features
+// SLOTS APs, least recently heard evicted, no heap. Not thread-safe.
+#pragma once
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "../core/mgmt_frame.h"
+
+// Welford running mean / variance
+struct RunningStats {
+    uint32_t n;
+    float mean;
+    float m2;
+
+    void reset() { n = 0; mean = 0.0f; m2 = 0.0f; }
+    void add(float x) {
+        n++;
+        float d = x - mean;
+        mean += d / (float)n;
+        m2 += d * (x - mean);
+    }
+    float variance() const { return n > 1 ? m2 / (float)(n - 1) : 0.0f; }
+    float stddev() const { return sqrtf(variance()); }
+};
+
+struct BeaconTiming {
+    uint8_t bssid[6];
+    uint16_t intervalTU;        // Advertised beacon interval (last beacon)
+    uint64_t lastTsf;
+    uint32_t lastRxUs;
+    uint32_t beacons;           // Beacons seen, including ones that restarted a baseline
+    RunningStats tsfResidual;   // ms, TSF delta minus the nearest whole intervals
+    RunningStats arrivalDrift;  // ms, receive delta minus TSF delta
+    RunningStats probeDelay;    // ms, probe request to its probe response
+    bool respondsToProbe;
+
+    float jitterMs() const { return tsfResidual.stddev(); }
+};
+
+struct BeaconTimingStats {
+    uint16_t slots;
+    uint16_t tracked;
+    uint32_t samples;      // Intervals that went into the statistics
+    uint32_t resets;       // Baselines restarted (TSF went back, gap too long)
+    uint32_t evictions;    // APs dropped for a new one
+};
+
+template <size_t SLOTS>
+class BeaconTimingTracker {
+    static_assert(SLOTS >= 2 && SLOTS <= 1024, "BeaconTimingTracker holds 2..1024 APs");
+
+public:
+    // Longest gap between two beacons still measured (longer = new baseline)
+    static const uint32_t MAX_GAP_US = 10000000;
+    // Probe requests remembered for matching responses
+    static const size_t PROBE_SLOTS = 4;
+    static const uint32_t PROBE_WINDOW_US = 200000;
+
+    BeaconTimingTracker() { clear(); }
+
+    void clear() {
+        memset(buckets, 0xFF, sizeof(buckets));
+        memset(probes, 0, sizeof(probes));
+        count = 0;
+        head = tail = NONE;
+        probeNext = 0;
+        samples = resets = evictions = 0;
+    }
+
+    size_t size() const { return count; }
+    static constexpr size_t bytes() { return sizeof(BeaconTimingTracker<SLOTS>); }
+
+    const BeaconTiming* find(const uint8_t* bssid) const {
+        uint16_t b = lookup(bssid);
+        return b == NONE ? nullptr : &entries[buckets[b]];
+    }
+
+    // One beacon from bssid, stamped with the AP's TSF
+    void onBeacon(const uint8_t* bssid, uint64_t tsf, uint16_t intervalTU, uint32_t rxUs) {
+        bool fresh;
+        uint16_t i = touch(bssid, fresh);
+        BeaconTiming& t = entries[i];
+        t.beacons++;
+        t.intervalTU = intervalTU;
+
+        if (!fresh) {
+            uint64_t tsfDelta = tsf - t.lastTsf;
+            uint32_t rxDelta = rxUs - t.lastRxUs;
+            if (tsf <= t.lastTsf || tsfDelta > MAX_GAP_US || rxDelta > MAX_GAP_US) {
+                resets++;  // AP rebooted, TSF reset, or we lost it for a while
+            } else {
+                addSample(t, (uint32_t)tsfDelta, rxDelta);
+            }
+        }
+        t.lastTsf = tsf;
+        t.lastRxUs = rxUs;
+    }
+
+    void onBeacon(const MgmtFrameView& beacon, uint32_t rxUs) {
+        onBeacon(beacon.bssid(), beacon.tsf, beacon.beaconInterval, rxUs);
+    }
+
+    // Probe request (SA = station). Remembered briefly for the response.
+    void onProbeRequest(const uint8_t* station, uint32_t rxUs) {
+        PendingProbe& p = probes[probeNext];
+        probeNext = (probeNext + 1) % PROBE_SLOTS;
+        memcpy(p.station, station, 6);
+        p.rxUs = rxUs;
+        p.used = true;
+    }
+
+    // Probe response from an AP we track (DA = station). Doesn't add APs:
+    // a probe response alone carries no beacon schedule.
+    void onProbeResponse(const MgmtFrameView& resp, uint32_t rxUs) {
+        uint16_t b = lookup(resp.bssid());
+        if (b == NONE) return;
+        BeaconTiming& t = entries[buckets[b]];
+        t.respondsToProbe = true;
+        const uint8_t* station = resp.frame + 4;
+        for (size_t k = 0; k < PROBE_SLOTS; k++) {
+            PendingProbe& p = probes[k];
+            if (!p.used || memcmp(p.station, station, 6) != 0) continue;
+            uint32_t delay = rxUs - p.rxUs;
+            if (delay <= PROBE_WINDOW_US) t.probeDelay.add(delay / 1000.0f);
+            p.used = false;  // One response per request
+            break;
+        }
+    }
+
+    BeaconTimingStats stats() const {
+        BeaconTimingStats s;
+        s.slots = SLOTS;
+        s.tracked = count;
+        s.samples = samples;
+        s.resets = resets;
+        s.evictions = evictions;
+        return s;
+    }
+
+private:
+    static constexpr size_t nextPow2(size_t n, size_t p = 1) {
+        return p >= n ? p : nextPow2(n, p << 1);
+    }
+
+    static const uint16_t NONE = 0xFFFF;
+    static const size_t BUCKETS = SLOTS * 2 <= 16 ? 16 : nextPow2(SLOTS * 2);  // Load <= 1/2
+
+    struct PendingProbe {
+        uint8_t station[6];
+        uint32_t rxUs;
+        bool used;
+    };
+
+    BeaconTiming entries[SLOTS];
+    uint16_t prev[SLOTS];
+    uint16_t next[SLOTS];
+    uint16_t buckets[BUCKETS];  // Entry index or NONE; linear probing
+    PendingProbe probes[PROBE_SLOTS];
+    uint16_t count;
+    uint16_t head;  // Most recently heard
+    uint16_t tail;  // Least recently heard (eviction victim)
+    size_t probeNext;
+    uint32_t samples;
+    uint32_t resets;
+    uint32_t evictions;
+
+    void addSample(BeaconTiming& t, uint32_t tsfDelta, uint32_t rxDelta) {
+        uint32_t intervalUs = (uint32_t)t.intervalTU * 1024;
+        float residualUs;
+        if (intervalUs) {
+            uint32_t k = (tsfDelta + intervalUs / 2) / intervalUs;
+            if (k == 0) return;  // Retransmitted beacon, same slot
+            residualUs = (float)tsfDelta - (float)k * (float)intervalUs;
+        } else {
+            residualUs = (float)tsfDelta;  // No interval advertised: raw spacing
+        }
+        t.tsfResidual.add(residualUs / 1000.0f);
+        t.arrivalDrift.add(((float)rxDelta - (float)tsfDelta) / 1000.0f);
+        samples++;
+    }
+
+    static size_t home(const uint8_t* bssid) {
+        uint64_t k = 0;
+        for (int i = 0; i < 6; i++) k = (k << 8) | bssid[i];
+        return (size_t)((k * 0x9E3779B97F4A7C15ULL) >> 40) & (BUCKETS - 1);
+    }
+
+    uint16_t lookup(const uint8_t* bssid) const {
+        for (size_t b = home(bssid), n = 0; n < BUCKETS; b = (b + 1) & (BUCKETS - 1), n++) {
+            uint16_t i = buckets[b];
+            if (i == NONE) return NONE;
+            if (memcmp(entries[i].bssid, bssid, 6) == 0) return (uint16_t)b;
+        }
+        return NONE;
+    }
+
+    // Entry for bssid, moved to the front of the LRU list; a new AP takes a
+    // free slot or the least recently heard one
+    uint16_t touch(const uint8_t* bssid, bool& fresh) {
+        uint16_t b = lookup(bssid);
+        if (b != NONE) {
+            uint16_t i = buckets[b];
+            unlink(i);
+            pushFront(i);
+            fresh = false;
+            return i;
+        }
+
+        uint16_t i;
+        if (count < SLOTS) {
+            i = count++;
+        } else {
+            i = tail;
+            unlink(i);
+            erase(lookup(entries[i].bssid));
+            evictions++;
+        }
+        BeaconTiming& t = entries[i];
+        memset(&t, 0, sizeof(t));
+        memcpy(t.bssid, bssid, 6);
+        insert(i);
+        pushFront(i);
+        fresh = true;
+        return i;
+    }
+
+    void insert(uint16_t i) {
+        size_t b = home(entries[i].bssid);
+        while (buckets[b] != NONE) b = (b + 1) & (BUCKETS - 1);
+        buckets[b] = i;
+    }
+
+    // Backward-shift delete keeps probe chains intact without tombstones
+    void erase(uint16_t b) {
+        if (b == NONE) return;
+        size_t hole = b;
+        buckets[hole] = NONE;
+        for (size_t j = (hole + 1) & (BUCKETS - 1); buckets[j] != NONE; j = (j + 1) & (BUCKETS - 1)) {
+            size_t h = home(entries[buckets[j]].bssid);
+            // Move j into the hole unless its home lies cyclically in (hole, j]
+            bool stays = hole <= j ? (hole < h && h <= j) : (hole < h || h <= j);
+            if (stays) continue;
+            buckets[hole] = buckets[j];
+            buckets[j] = NONE;
+            hole = j;
+        }
+    }
+
+    void unlink(uint16_t i) {
+        if (prev[i] != NONE) next[prev[i]] = next[i];
+        else if (head == i) head = next[i];
+        if (next[i] != NONE) prev[next[i]] = prev[i];
+        else if (tail == i) tail = prev[i];
+        prev[i] = next[i] = NONE;
+    }
+
+    void pushFront(uint16_t i) {
+        prev[i] = NONE;
+        next[i] = head;
+        if (head != NONE) prev[head] = i;
+        head = i;
+        if (tail == NONE) tail = i;
+    }
+};
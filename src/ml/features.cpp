@@ -187,33 +187,38 @@ WiFiFeatures FeatureExtractor::extractBasic(int8_t rssi, uint8_t channel, wifi_a
     return f;
 }
 
+void FeatureExtractor::applyTiming(const BeaconTiming& timing, WiFiFeatures& features) {
+    if (timing.tsfResidual.n > 1) {
+        features.beaconJitter = timing.jitterMs();
+        features.responseTime = (uint32_t)(timing.arrivalDrift.stddev() * 1000.0f);
+    }
+    features.respondsToProbe = timing.respondsToProbe;
+    if (timing.probeDelay.n > 0) {
+        float ms = timing.probeDelay.mean + 0.5f;
+        features.probeResponseTime = ms > 65535.0f ? 65535 : (uint16_t)ms;
+    }
+}
+
 WiFiFeatures FeatureExtractor::extractFromBeacon(const uint8_t* frame, uint16_t len, int8_t rssi) {
+    MgmtFrameView beacon;
+    beacon.parse(frame, len);
+    return extractFromBeacon(beacon, rssi);
+}
+
+WiFiFeatures FeatureExtractor::extractFromBeacon(const MgmtFrameView& beacon, int8_t rssi) {
     WiFiFeatures f = {0};
     
-    if (len < 36) return f;  // Minimum beacon frame size
-    
-    // Frame control is first 2 bytes, skip to fixed params at offset 24
-    // Fixed params: timestamp(8) + beacon_interval(2) + capability(2)
+    if (beacon.len < MGMT_IE_OFFSET) return f;  // Minimum beacon frame size
     
     f.rssi = rssi;
     f.noise = -95;
     f.snr = (float)(f.rssi - f.noise);
     
-    f.beaconInterval = parseBeaconInterval(frame, len);
-    f.capability = parseCapability(frame, len);
-    
-    // isHidden is determined from SSID IE in parseIEs, initialize to false
-    f.isHidden = false;
-    f.hasWPS = false;  // Determined from IEs
-    f.hasWPA = false;
-    f.hasWPA2 = false;
-    f.hasWPA3 = false;
-    
-    // Parse Information Elements (SSID, WPA, WPS, etc.)
-    parseIEs(frame, len, f);
+    f.beaconInterval = beacon.beaconInterval;
+    f.capability = beacon.capability;
     
-    // Extract channel from DS Parameter Set IE if available (done in parseIEs)
-    // If not found, channel remains 0
+    // Information Elements (SSID, WPA, WPS, etc.) - channel stays 0 without DS Parameter Set
+    applyIEs(beacon, f);
     
     // Calculate anomaly score based on available data (same as extractFromScan)
     f.anomalyScore = 0.0f;
@@ -340,94 +345,24 @@ void FeatureExtractor::setNormalizationParams(const float* means, const float* s
     Serial.println("[ML] Normalization parameters loaded");
 }
 
-uint16_t FeatureExtractor::parseBeaconInterval(const uint8_t* frame, uint16_t len) {
-    if (len < 34) return 100;  // Default beacon interval
-    // Beacon interval at offset 32 (after 24 byte header + 8 byte timestamp)
-    return frame[32] | (frame[33] << 8);
+void FeatureExtractor::applyIEs(const MgmtFrameView& beacon, WiFiFeatures& features) {
+    features.isHidden = beacon.isHidden();
+    features.supportedRates = beacon.supportedRates;
+    features.channel = beacon.dsChannel;
+    if (beacon.hasHT) features.htCapabilities |= 0x04;  // 11n flag
+    features.hasWPA2 = beacon.hasRSN();  // SAE AKM not distinguished yet
+    features.vhtCapabilities = beacon.hasVHT ? 1 : 0;
+    features.vendorIECount = beacon.vendorIECount;
+    features.hasWPS = beacon.hasWPS();
+    features.hasWPA = beacon.hasWPA();
 }
 
-uint16_t FeatureExtractor::parseCapability(const uint8_t* frame, uint16_t len) {
-    if (len < 36) return 0;
-    // Capability at offset 34
-    return frame[34] | (frame[35] << 8);
-}
-
-void FeatureExtractor::parseIEs(const uint8_t* frame, uint16_t len, WiFiFeatures& features) {
-    // IEs start at offset 36 (after fixed params)
-    uint16_t offset = 36;
-    
-    while (offset + 2 < len) {
-        uint8_t id = frame[offset];
-        uint8_t ieLen = frame[offset + 1];
-        
-        if (offset + 2 + ieLen > len) break;
-        
-        const uint8_t* ieData = frame + offset + 2;
-        
-        switch (id) {
-            case 0:  // SSID
-                // Check for hidden SSID (zero-length or all nulls)
-                if (ieLen == 0) {
-                    features.isHidden = true;
-                } else {
-                    bool allNull = true;
-                    for (uint8_t i = 0; i < ieLen && i < 32; i++) {
-                        if (ieData[i] != 0) { allNull = false; break; }
-                    }
-                    features.isHidden = allNull;
-                }
-                break;
-                
-            case 1:  // Supported Rates
-                features.supportedRates = ieLen;
-                break;
-                
-            case 3:  // DS Parameter Set (channel)
-                if (ieLen >= 1) {
-                    features.channel = ieData[0];
-                }
-                break;
-                
-            case 45:  // HT Capabilities (802.11n)
-                features.htCapabilities |= 0x04;  // Set 11n flag
-                break;
-                
-            case 48:  // RSN (WPA2/WPA3)
-                features.hasWPA2 = true;
-                // Check for WPA3 SAE in RSN
-                if (ieLen >= 8) {
-                    // Parse AKM suite to detect SAE (WPA3)
-                    // Simplified: just mark WPA2 for now
-                }
-                break;
-                
-            case 50:  // Extended Supported Rates
-                features.supportedRates += ieLen;  // Add to existing count
-                break;
-                
-            case 191:  // VHT Capabilities (802.11ac)
-                features.vhtCapabilities = 1;
-                break;
-                
-            case 221:  // Vendor Specific
-                features.vendorIECount++;
-                // Check for WPS OUI: 00:50:F2:04
-                if (ieLen >= 4) {
-                    if (ieData[0] == 0x00 && ieData[1] == 0x50 &&
-                        ieData[2] == 0xF2 && ieData[3] == 0x04) {
-                        features.hasWPS = true;
-                    }
-                    // Check for WPA OUI: 00:50:F2:01
-                    if (ieData[0] == 0x00 && ieData[1] == 0x50 &&
-                        ieData[2] == 0xF2 && ieData[3] == 0x01) {
-                        features.hasWPA = true;
-                    }
-                }
-                break;
-        }
-        
-        offset += 2 + ieLen;
+wifi_auth_mode_t FeatureExtractor::authModeFromBeacon(const MgmtFrameView& beacon) {
+    if (beacon.hasRSN()) {
+        if (beacon.pmfRequired) return WIFI_AUTH_WPA3_PSK;
+        return beacon.hasWPA() ? WIFI_AUTH_WPA_WPA2_PSK : WIFI_AUTH_WPA2_PSK;
     }
+    return beacon.hasWPA() ? WIFI_AUTH_WPA_PSK : WIFI_AUTH_OPEN;
 }
 
 bool FeatureExtractor::isRandomMAC(const uint8_t* mac) {
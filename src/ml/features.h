@@ -4,6 +4,8 @@
 #include <Arduino.h>
 #include <esp_wifi.h>
 #include <vector>
+#include "../core/mgmt_frame.h"
+#include "beacon_timing.h"
 
 // Feature vector size for Edge Impulse model
 #define FEATURE_VECTOR_SIZE 32
@@ -27,14 +29,14 @@ struct WiFiFeatures {
     bool hasWPA3;
     bool isHidden;
     
-    // Timing features
-    uint32_t responseTime;
+    // Timing features (from BeaconTimingTracker, 0 until an AP has 2 beacons)
+    uint32_t responseTime;      // Arrival drift stddev, microseconds
     uint16_t beaconCount;
-    float beaconJitter;
+    float beaconJitter;         // TSF residual stddev, milliseconds
     
     // Probe response analysis
     bool respondsToProbe;
-    uint16_t probeResponseTime;
+    uint16_t probeResponseTime; // Mean probe request -> response, milliseconds
     
     // IEs (Information Elements)
     uint8_t vendorIECount;
@@ -62,10 +64,17 @@ public:
     // Extract features from raw WiFi scan
     static WiFiFeatures extractFromScan(const wifi_ap_record_t* ap);
     static WiFiFeatures extractFromBeacon(const uint8_t* frame, uint16_t len, int8_t rssi);
+    static WiFiFeatures extractFromBeacon(const MgmtFrameView& beacon, int8_t rssi);  // Already parsed
+    
+    // Auth mode as advertised in a parsed beacon (RSN + PMF required = WPA3)
+    static wifi_auth_mode_t authModeFromBeacon(const MgmtFrameView& beacon);
     
     // Extract basic features when only Arduino WiFi accessors are available
     static WiFiFeatures extractBasic(int8_t rssi, uint8_t channel, wifi_auth_mode_t authmode);
     
+    // Fill the timing features from an AP's tracked beacon timing
+    static void applyTiming(const BeaconTiming& timing, WiFiFeatures& features);
+    
     // Extract probe request features
     static ProbeFeatures extractFromProbe(const uint8_t* frame, uint16_t len, int8_t rssi);
     
@@ -84,9 +93,7 @@ private:
     static float featureStds[FEATURE_VECTOR_SIZE];
     static bool normParamsLoaded;
     
-    static uint16_t parseBeaconInterval(const uint8_t* frame, uint16_t len);
-    static uint16_t parseCapability(const uint8_t* frame, uint16_t len);
-    static void parseIEs(const uint8_t* frame, uint16_t len, WiFiFeatures& features);
+    static void applyIEs(const MgmtFrameView& beacon, WiFiFeatures& features);
     static bool isRandomMAC(const uint8_t* mac);
     static float normalize(float value, float mean, float std);
 };
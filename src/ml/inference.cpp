@@ -4,10 +4,13 @@
 
 #include "inference.h"
 #include "edge_impulse.h"
+#include "heuristic.h"
 #include "../core/config.h"
 #include "../ui/display.h"
 #include "../piglet/mood.h"
 #include <SPIFFS.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
 
 // Static members
 bool MLInference::modelLoaded = false;
@@ -16,6 +19,27 @@ size_t MLInference::modelSize = 0;
 uint32_t MLInference::inferenceCount = 0;
 uint32_t MLInference::avgInferenceTime = 0;
 const char* MLInference::MODEL_PATH = "/models/porkchop_model.bin";
+QuantModel MLInference::quantModel;
+uint8_t* MLInference::modelBlob = nullptr;
+AsyncClassifier<MLInference::ASYNC_DEPTH, FEATURE_VECTOR_SIZE, MLResult> MLInference::asyncQueue;
+MLCallback MLInference::asyncCallbacks[MLInference::ASYNC_DEPTH];
+uint32_t MLInference::lastAsyncReport = 0;
+uint32_t MLInference::reportedAsyncRequests = 0;
+bool MLInference::asyncStartFailed = false;
+
+// One inference at a time: the async worker and the main loop share the
+// model's workspace (and the EI SDK isn't reentrant). Held for one
+// classification, or while a new model is swapped in. Only exists once
+// the worker does; until then everything runs on the main loop.
+static SemaphoreHandle_t inferLock = NULL;
+
+static void lockInference() {
+    if (inferLock) xSemaphoreTake(inferLock, portMAX_DELAY);
+}
+
+static void unlockInference() {
+    if (inferLock) xSemaphoreGive(inferLock);
+}
 
 // Edge Impulse will generate these - placeholder structure
 struct ei_impulse_result_t {
@@ -48,11 +72,40 @@ void MLInference::init() {
 }
 
 void MLInference::update() {
-    // Process any pending async inference callbacks
-    // In real implementation, check for completed inference tasks
+    // Finished async requests reach their callbacks here, on the main loop
+    asyncQueue.drain(micros(), deliverAsync);
+    
+    // Queue health once a minute, if anything was asked of it
+    uint32_t now = millis();
+    if (now - lastAsyncReport < ASYNC_REPORT_MS) return;
+    lastAsyncReport = now;
+    AsyncClassifierStats s = asyncQueue.stats();
+    uint32_t requests = s.submitted + s.rejected;
+    if (requests == reportedAsyncRequests) return;
+    reportedAsyncRequests = requests;
+    Serial.printf("[ML] Async: %lu done, depth %u (peak %u/%u), %lu rejected, latency avg %lu us, max %lu us\n",
+                  (unsigned long)s.delivered, s.depth, s.highWater, (unsigned)ASYNC_DEPTH,
+                  (unsigned long)s.rejected, (unsigned long)s.avgLatencyUs, (unsigned long)s.maxLatencyUs);
 }
 
 MLResult MLInference::classify(const float* features, size_t featureCount) {
+    MLResult result = infer(features, featureCount);
+    
+    inferenceCount++;
+    avgInferenceTime = (avgInferenceTime * (inferenceCount - 1) + result.inferenceTimeUs) / inferenceCount;
+    
+    // Trigger mood based on result
+    if (result.valid) {
+        Mood::onMLPrediction(result.confidence);
+    }
+    
+    return result;
+}
+
+// One feature vector through whichever classifier is available
+MLResult MLInference::infer(const float* features, size_t featureCount) {
+    lockInference();
+    
     MLResult result = {
         .label = MLLabel::UNKNOWN,
         .confidence = 0.0f,
@@ -78,19 +131,18 @@ MLResult MLInference::classify(const float* features, size_t featureCount) {
             // Fallback to heuristic classifier
             result = runInference(features, featureCount);
         }
+    } else if (quantModel.loaded()) {
+        // Fixed-point model from SPIFFS
+        result = runModel(features, featureCount);
+        if (!result.valid) {
+            result = runInference(features, featureCount);
+        }
     } else {
         // Use heuristic classifier
         result = runInference(features, featureCount);
     }
     
-    inferenceCount++;
-    avgInferenceTime = (avgInferenceTime * (inferenceCount - 1) + result.inferenceTimeUs) / inferenceCount;
-    
-    // Trigger mood based on result
-    if (result.valid) {
-        Mood::onMLPrediction(result.confidence);
-    }
-    
+    unlockInference();
     return result;
 }
 
@@ -100,174 +152,135 @@ MLResult MLInference::classifyNetwork(const WiFiFeatures& network) {
     return classify(features, FEATURE_VECTOR_SIZE);
 }
 
-void MLInference::classifyAsync(const float* features, size_t featureCount, MLCallback callback) {
-    // For ESP32 without PSRAM, we do sync inference
-    // A real async implementation would use a task queue
-    MLResult result = classify(features, featureCount);
+size_t MLInference::classifyBatch(const WiFiFeatures* networks, size_t count, MLBatchArena& arena) {
+    uint32_t startTime = micros();
+    size_t rows = BatchClassifier::run<FEATURE_VECTOR_SIZE>(
+        networks, count, arena,
+        [](const WiFiFeatures& network, float* vec) { FeatureExtractor::toFeatureVector(network, vec); },
+        [](const float* row) { return infer(row, FEATURE_VECTOR_SIZE); },
+        // One mood reaction per sweep, to its most confident call
+        [](float confidence) { Mood::onMLPrediction(confidence); });
+    if (rows == 0) return 0;
+    
+    // Stats count the batch once
+    uint32_t elapsed = micros() - startTime;
+    uint32_t before = inferenceCount;
+    inferenceCount += rows;
+    avgInferenceTime = (uint32_t)(((uint64_t)avgInferenceTime * before + elapsed) / inferenceCount);
+    
+    return rows;
+}
+
+// Worker and inference lock on first use, so builds that never ask for
+// async inference keep the task stack and skip the lock
+bool MLInference::startAsync() {
+    if (asyncQueue.isRunning()) return true;
+    if (asyncStartFailed) return false;
+    if (!inferLock) inferLock = xSemaphoreCreateMutex();
+    if (inferLock && asyncQueue.start(inferOnWorker)) return true;
+    
+    if (inferLock) {
+        vSemaphoreDelete(inferLock);
+        inferLock = NULL;
+    }
+    asyncStartFailed = true;
+    Serial.println("[ML] Failed to start async worker, classifyAsync runs inline");
+    return false;
+}
+
+bool MLInference::classifyAsync(const float* features, size_t featureCount, MLCallback callback) {
+    if (!startAsync()) {
+        // No worker: classify inline, as before
+        MLResult result = classify(features, featureCount);
+        if (callback) {
+            callback(result);
+        }
+        return true;
+    }
+    
+    uint32_t ticket;
+    if (!asyncQueue.submit(features, featureCount, micros(), &ticket)) {
+        return false;  // Full: retry next loop, or classify() inline
+    }
+    // Can't be delivered before this: drain() runs on this same loop
+    asyncCallbacks[ticket % ASYNC_DEPTH] = callback;
+    return true;
+}
+
+MLResult MLInference::inferOnWorker(const float* input, size_t size) {
+    return infer(input, size);
+}
+
+// Main loop side of an async result: stats and mood as classify() does
+// them, then the caller's callback
+void MLInference::deliverAsync(uint32_t ticket, const MLResult& result) {
+    inferenceCount++;
+    avgInferenceTime = (avgInferenceTime * (inferenceCount - 1) + result.inferenceTimeUs) / inferenceCount;
+    if (result.valid) {
+        Mood::onMLPrediction(result.confidence);
+    }
+    
+    // Moved out first: the callback may queue another request into this slot
+    MLCallback callback = std::move(asyncCallbacks[ticket % ASYNC_DEPTH]);
+    asyncCallbacks[ticket % ASYNC_DEPTH] = nullptr;
     if (callback) {
         callback(result);
     }
 }
 
-MLResult MLInference::runInference(const float* input, size_t size) {
+AsyncClassifierStats MLInference::getAsyncStats() {
+    return asyncQueue.stats();
+}
+
+MLResult MLInference::runModel(const float* input, size_t size) {
     uint32_t startTime = micros();
     
     MLResult result = {
-        .label = MLLabel::NORMAL,
+        .label = MLLabel::UNKNOWN,
         .confidence = 0.0f,
-        .scores = {0.8f, 0.05f, 0.05f, 0.05f, 0.05f},
+        .scores = {0},
         .inferenceTimeUs = 0,
-        .valid = true
+        .valid = false
     };
     
-    if (size < FEATURE_VECTOR_SIZE) {
-        result.valid = false;
+    // Class count was checked against scores[] in validateModel
+    if (!quantModel.run(input, size, result.scores)) {
         return result;
     }
     
-    // ========================================
-    // ENHANCED HEURISTIC CLASSIFIER
-    // Feature indices from features.cpp:
-    //  0: rssi, 1: noise, 2: snr, 3: channel, 4: secondary_ch
-    //  5: beacon_interval, 6: capability_lo, 7: capability_hi
-    //  8: hasWPS, 9: hasWPA, 10: hasWPA2, 11: hasWPA3
-    // 12: isHidden, 13: responseTime, 14: beaconCount, 15: beaconJitter
-    // 16: respondsToProbe, 17: probeResponseTime, 18: vendorIECount
-    // 19: supportedRates, 20: htCapabilities, 21: vhtCapabilities
-    // 22: anomalyScore
-    // ========================================
-    
-    float rssi = input[0];
-    float snr = input[2];
-    uint8_t channel = (uint8_t)input[3];
-    float beaconInterval = input[5];
-    bool hasWPS = input[8] > 0.5f;
-    bool hasWPA = input[9] > 0.5f;
-    bool hasWPA2 = input[10] > 0.5f;
-    bool hasWPA3 = input[11] > 0.5f;
-    bool isHidden = input[12] > 0.5f;
-    float beaconJitter = input[15];
-    uint8_t vendorIECount = (uint8_t)input[18];
-    uint8_t supportedRates = (uint8_t)input[19];
-    bool hasHT = input[20] > 0.5f;
-    bool hasVHT = input[21] > 0.5f;
-    
-    float anomalyScore = 0.0f;
-    
-    // ---- ROGUE AP DETECTION ----
-    // 1. Suspiciously strong signal (someone nearby with laptop hotspot)
-    if (rssi > -30) {
-        anomalyScore += 0.3f;
-    }
-    
-    // 2. Non-standard beacon interval (default is 100ms, 102.4 TU)
-    if (beaconInterval < 50 || beaconInterval > 200) {
-        anomalyScore += 0.2f;
-    }
-    
-    // 3. High beacon jitter (inconsistent timing = software AP)
-    if (beaconJitter > 10.0f) {
-        anomalyScore += 0.15f;
-    }
-    
-    // 4. Missing vendor-specific IEs (real routers have many)
-    if (vendorIECount < 2) {
-        anomalyScore += 0.1f;
-    }
-    
-    // 5. Open network with WPS enabled (honeypot pattern)
-    if (!hasWPA && !hasWPA2 && !hasWPA3 && hasWPS) {
-        anomalyScore += 0.25f;
-    }
-    
-    // 6. Channel anomaly - using unusual channels (non-1,6,11 for 2.4GHz)
-    if (channel <= 14 && channel != 1 && channel != 6 && channel != 11) {
-        anomalyScore += 0.05f;
-    }
-    
-    // 7. Claims VHT (WiFi 5) but no HT (WiFi 4) - inconsistent
-    if (hasVHT && !hasHT) {
-        anomalyScore += 0.2f;
-    }
-    
-    // 8. Very few supported rates (minimal AP implementation)
-    if (supportedRates < 4) {
-        anomalyScore += 0.1f;
-    }
-    
-    // ---- EVIL TWIN DETECTION ----
-    // Would need SSID comparison with known networks
-    // For now, flag hidden networks copying popular names
-    float evilTwinScore = 0.0f;
-    if (isHidden && rssi > -50) {
-        evilTwinScore += 0.2f;
-    }
-    
-    // ---- VULNERABLE NETWORK DETECTION ----
-    float vulnScore = 0.0f;
-    
-    // Open network
-    if (!hasWPA && !hasWPA2 && !hasWPA3) {
-        vulnScore += 0.5f;
-    }
-    
-    // WPA1 only (TKIP vulnerable)
-    if (hasWPA && !hasWPA2 && !hasWPA3) {
-        vulnScore += 0.4f;
-    }
-    
-    // WPS enabled (PIN attack vulnerable)
-    if (hasWPS) {
-        vulnScore += 0.2f;
-    }
-    
-    // Hidden SSID with weak security
-    if (isHidden && vulnScore > 0.3f) {
-        vulnScore += 0.1f;
+    int maxIdx = 0;
+    for (int i = 1; i < 5; i++) {
+        if (result.scores[i] > result.scores[maxIdx]) maxIdx = i;
     }
     
-    // ---- DEAUTH TARGET SCORING ----
-    float deauthScore = 0.0f;
+    result.label = (MLLabel)maxIdx;
+    result.confidence = result.scores[maxIdx];
+    result.inferenceTimeUs = micros() - startTime;
+    result.valid = true;
     
-    // Good signal for reliable deauth
-    if (rssi > -70 && rssi < -30) {
-        deauthScore += 0.2f;
-    }
+    return result;
+}
+
+MLResult MLInference::runInference(const float* input, size_t size) {
+    uint32_t startTime = micros();
     
-    // Not WPA3 (PMF protected)
-    if (!hasWPA3) {
-        deauthScore += 0.3f;
-    }
+    MLResult result = {
+        .label = MLLabel::NORMAL,
+        .confidence = 0.0f,
+        .scores = {0.8f, 0.05f, 0.05f, 0.05f, 0.05f},
+        .inferenceTimeUs = 0,
+        .valid = true
+    };
     
-    // Has active clients (would need client tracking)
-    // deauthScore += clientCount > 0 ? 0.2f : 0.0f;
-    
-    // ---- CLASSIFICATION ----
-    result.scores[0] = 1.0f - (anomalyScore + evilTwinScore + vulnScore) / 3.0f;  // NORMAL
-    result.scores[1] = min(1.0f, anomalyScore);  // ROGUE_AP
-    result.scores[2] = min(1.0f, evilTwinScore);  // EVIL_TWIN
-    result.scores[3] = min(1.0f, deauthScore);  // DEAUTH_TARGET
-    result.scores[4] = min(1.0f, vulnScore);  // VULNERABLE
-    
-    // Normalize scores
-    float sum = 0.0f;
-    for (int i = 0; i < 5; i++) sum += result.scores[i];
-    if (sum > 0) {
-        for (int i = 0; i < 5; i++) result.scores[i] /= sum;
+    if (size < FEATURE_VECTOR_SIZE) {
+        result.valid = false;
+        return result;
     }
     
-    // Find highest score
-    int maxIdx = 0;
-    float maxScore = result.scores[0];
-    for (int i = 1; i < 5; i++) {
-        if (result.scores[i] > maxScore) {
-            maxScore = result.scores[i];
-            maxIdx = i;
-        }
-    }
+    uint8_t label = HeuristicClassifier::classify(input, result.scores);
     
-    result.label = (MLLabel)maxIdx;
-    result.confidence = maxScore;
+    result.label = (MLLabel)label;
+    result.confidence = result.scores[label];
     result.inferenceTimeUs = micros() - startTime;
     
     return result;
@@ -280,26 +293,50 @@ bool MLInference::loadModel(const char* path) {
         return false;
     }
     
-    modelSize = f.size();
-    
-    // Read model header (version info)
-    char header[32];
-    f.readBytes(header, min((size_t)31, modelSize));
-    header[31] = 0;
+    size_t size = f.size();
+    if (size < QuantModel::HEADER_BYTES || size > MODEL_MAX_BYTES) {
+        f.close();
+        Serial.printf("[ML] Model size out of range: %u bytes\n", (unsigned)size);
+        return false;
+    }
     
-    // Parse version from header
-    strncpy(modelVersion, header, 15);
-    modelVersion[15] = 0;
+    // One allocation per load; inference runs in place over it
+    uint8_t* data = (uint8_t*)malloc(size);
+    if (!data) {
+        f.close();
+        Serial.printf("[ML] No memory for model (%u bytes)\n", (unsigned)size);
+        return false;
+    }
+    size_t got = f.read(data, size);
+    f.close();
     
-    // In real implementation:
-    // - Validate model format
-    // - Load weights into inference engine
-    // - Initialize Edge Impulse runtime
+    if (got != size || !validateModel(data, size)) {
+        free(data);
+        return false;
+    }
     
-    f.close();
+    // Swapped under the inference lock: the async worker may be mid-run
+    lockInference();
+    bool bound = quantModel.bind(data, size);
+    if (bound) {
+        free(modelBlob);
+        modelBlob = data;
+        modelSize = size;
+    } else if (modelBlob) {
+        // A rejected file leaves the previous model bound, if there was one
+        quantModel.bind(modelBlob, modelSize);
+    }
+    unlockInference();
+    if (!bound) {
+        free(data);
+        return false;
+    }
+    strncpy(modelVersion, quantModel.version(), 15);
+    modelVersion[15] = 0;
     modelLoaded = true;
     
-    Serial.printf("[ML] Model loaded: %s (%d bytes)\n", modelVersion, modelSize);
+    Serial.printf("[ML] Model loaded: %s (%u bytes, %u layers)\n",
+                  modelVersion, (unsigned)modelSize, quantModel.layerTotal());
     return true;
 }
 
@@ -332,10 +369,14 @@ bool MLInference::updateModel(const uint8_t* modelData, size_t size) {
 bool MLInference::validateModel(const uint8_t* data, size_t size) {
     // Basic validation
     if (size < 64) return false;  // Too small
-    if (size > 100000) return false;  // Too large for ESP32
+    if (size > MODEL_MAX_BYTES) return false;  // Too large for ESP32
     
-    // Check magic header (Edge Impulse format)
-    // Real implementation would verify model integrity
+    // Header, CRC-32 and layer shapes; must take our features and give MLResult's classes
+    const char* problem = QuantModel::check(data, size, FEATURE_VECTOR_SIZE, 5);
+    if (problem) {
+        Serial.printf("[ML] Model rejected: %s\n", problem);
+        return false;
+    }
     
     return true;
 }
@@ -4,6 +4,9 @@
 #include <Arduino.h>
 #include <functional>
 #include "features.h"
+#include "quant_model.h"
+#include "batch_classifier.h"
+#include "async_classifier.h"
 
 // Model labels
 enum class MLLabel {
@@ -25,6 +28,21 @@ struct MLResult {
 
 typedef std::function<void(MLResult)> MLCallback;
 
+// Caller-owned memory for MLInference::classifyBatch (batch_classifier.h)
+typedef BatchArena<MLResult> MLBatchArena;
+
+// Static storage for an arena of ROWS networks (~164 bytes per row)
+template <size_t ROWS>
+struct MLBatchBuffer {
+    float features[FEATURE_VECTOR_SIZE * ROWS];
+    MLResult results[ROWS];
+    
+    MLBatchArena arena() {
+        MLBatchArena a = {features, results, ROWS};
+        return a;
+    }
+};
+
 class MLInference {
 public:
     static void init();
@@ -34,8 +52,17 @@ public:
     static MLResult classify(const float* features, size_t featureCount);
     static MLResult classifyNetwork(const WiFiFeatures& network);
     
-    // Async inference with callback
-    static void classifyAsync(const float* features, size_t featureCount, MLCallback callback);
+    // Classify a sweep in one pass with no heap: up to arena.capacity of
+    // networks into arena.results, returns how many. Stats and mood are
+    // updated once for the batch (mood from its most confident result).
+    static size_t classifyBatch(const WiFiFeatures* networks, size_t count, MLBatchArena& arena);
+    
+    // Async inference with callback: queued for the worker on core 0 (started
+    // by the first call), and the callback runs from update() on the main
+    // loop. Never waits. False if ASYNC_DEPTH requests are already in flight:
+    // nothing was queued and the callback won't run, so submit again on a
+    // later loop, once update() has delivered some, or classify() inline.
+    static bool classifyAsync(const float* features, size_t featureCount, MLCallback callback);
     
     // Model management
     static bool loadModel(const char* path);
@@ -55,6 +82,9 @@ public:
     static uint32_t getInferenceCount() { return inferenceCount; }
     static uint32_t getAvgInferenceTimeUs() { return avgInferenceTime; }
     
+    // Async queue: depth, rejections, submit-to-callback latency
+    static AsyncClassifierStats getAsyncStats();
+    
 private:
     static bool modelLoaded;
     static char modelVersion[16];
@@ -64,7 +94,25 @@ private:
     
     // Model weights stored in SPIFFS
     static const char* MODEL_PATH;
+    static const size_t MODEL_MAX_BYTES = 100000;  // Too large for ESP32 above this
+    static QuantModel quantModel;  // Runs in place over modelBlob
+    static uint8_t* modelBlob;     // Model file, read once per load
+    
+    // Async requests (~1.5KB) and their callbacks, by ticket % ASYNC_DEPTH.
+    // Callbacks stay on the main loop's side; the worker never sees them.
+    static const size_t ASYNC_DEPTH = 8;
+    static const uint32_t ASYNC_REPORT_MS = 60000;
+    static AsyncClassifier<ASYNC_DEPTH, FEATURE_VECTOR_SIZE, MLResult> asyncQueue;
+    static MLCallback asyncCallbacks[ASYNC_DEPTH];
+    static uint32_t lastAsyncReport;
+    static uint32_t reportedAsyncRequests;
     
+    static MLResult infer(const float* input, size_t size);
+    static MLResult runModel(const float* input, size_t size);
     static MLResult runInference(const float* input, size_t size);
     static bool validateModel(const uint8_t* data, size_t size);
+    static bool asyncStartFailed;
+    static bool startAsync();
+    static MLResult inferOnWorker(const float* input, size_t size);
+    static void deliverAsync(uint32_t ticket, const MLResult& result);
 };
@@ -0,0 +1,198 @@
+// Quant Model - fixed-point MLP for the on-device classifier
+// run() uses the model's own workspace: no heap, but one call at a time.
+#pragma once
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "../core/crc32.h"
+
+class QuantModel {
+public:
+    // Layout (little-endian, every section 4-byte aligned):
+    //   0   "PKML", format, layer count, input count, class count
+    //   8   model version, 16 chars NUL-padded
+    //   24  payload length (u32), CRC-32 of the payload (u32)
+    //   32  input count x (f32 offset, f32 scale), then per layer:
+    //       activation, weight shift, in, out, reserved, int8 weights [out][in]
+    //       padded to 4, int32 bias [out] at scale 2^(8 + shift)
+    static const uint8_t FORMAT_VERSION = 1;
+    static const size_t HEADER_BYTES = 32;
+    static const size_t LAYER_HEADER_BYTES = 8;
+    static const size_t MAX_LAYERS = 8;
+    static const size_t MAX_WIDTH = 64;    // Widest layer (in or out)
+    static const size_t MAX_CLASSES = 8;
+    static const int ACT_FRAC = 8;         // Activations are Q7.8
+
+    enum Activation : uint8_t { ACT_NONE = 0, ACT_RELU = 1, ACT_SOFTMAX = 2 };
+
+    QuantModel() { unbind(); }
+
+    // nullptr if blob is a usable model, else why not. inputs/classes of 0
+    // accept any count; otherwise the model must match.
+    static const char* check(const uint8_t* blob, size_t size, uint8_t inputs = 0, uint8_t classes = 0) {
+        if (!blob || size < HEADER_BYTES) return "too short";
+        if (memcmp(blob, "PKML", 4) != 0) return "bad magic";
+        if (blob[4] != FORMAT_VERSION) return "unsupported format";
+        uint8_t layerCount = blob[5], inCount = blob[6], classCount = blob[7];
+        if (layerCount == 0 || layerCount > MAX_LAYERS) return "bad layer count";
+        if (inCount == 0 || inCount > MAX_WIDTH) return "bad input count";
+        if (classCount < 2 || classCount > MAX_CLASSES) return "bad class count";
+        if (inputs && inCount != inputs) return "input count mismatch";
+        if (classes && classCount != classes) return "class count mismatch";
+        if (blob[8 + 15] != 0) return "version not terminated";
+
+        uint32_t payload = get32(blob + 24);
+        if (payload != size - HEADER_BYTES) return "length mismatch";
+        if (Crc32::update(0, blob + HEADER_BYTES, payload) != get32(blob + 28)) return "checksum mismatch";
+
+        size_t off = HEADER_BYTES + (size_t)inCount * 8;
+        uint16_t width = inCount;
+        for (uint8_t l = 0; l < layerCount; l++) {
+            if (off + LAYER_HEADER_BYTES > size) return "truncated layer";
+            const uint8_t* h = blob + off;
+            uint8_t act = h[0], shift = h[1];
+            uint16_t in = get16(h + 2), out = get16(h + 4);
+            bool last = l == layerCount - 1;
+            if (in != width) return "layer shapes don't chain";
+            if (out == 0 || out > MAX_WIDTH) return "layer too wide";
+            if (shift > 15) return "bad weight shift";
+            if (act > ACT_SOFTMAX || (act == ACT_SOFTMAX) != last) return "softmax must end the model";
+            size_t biasOff = off + LAYER_HEADER_BYTES + weightBytes(in, out);
+            off = biasOff + (size_t)out * 4;
+            if (off > size) return "truncated layer";
+            // |bias| < 2^30 and |w * a| sums < 2^28: the int32 accumulator can't overflow
+            for (uint16_t o = 0; o < out; o++) {
+                int32_t b = (int32_t)get32(blob + biasOff + (size_t)o * 4);
+                if (b >= (1 << 30) || b <= -(1 << 30)) return "bias out of range";
+            }
+            width = out;
+        }
+        if (width != classCount) return "output count mismatch";
+        if (off != size) return "trailing bytes";
+        return nullptr;
+    }
+
+    // Points into blob (keep it alive, 4-byte aligned); copies only the input scales
+    bool bind(const uint8_t* blob, size_t size) {
+        unbind();
+        if (check(blob, size) || ((uintptr_t)blob & 3)) return false;
+        layerCount = blob[5];
+        inputCount = blob[6];
+        classCount = blob[7];
+        memcpy(modelVersion, blob + 8, 16);
+
+        size_t off = HEADER_BYTES;
+        for (uint8_t i = 0; i < inputCount; i++, off += 8) {
+            memcpy(&inOffset[i], blob + off, 4);
+            memcpy(&inScale[i], blob + off + 4, 4);
+        }
+        for (uint8_t l = 0; l < layerCount; l++) {
+            const uint8_t* h = blob + off;
+            Layer& L = layers[l];
+            L.act = h[0];
+            L.shift = h[1];
+            L.in = get16(h + 2);
+            L.out = get16(h + 4);
+            L.weights = (const int8_t*)(h + LAYER_HEADER_BYTES);
+            L.bias = (const int32_t*)(h + LAYER_HEADER_BYTES + weightBytes(L.in, L.out));
+            off += LAYER_HEADER_BYTES + weightBytes(L.in, L.out) + (size_t)L.out * 4;
+        }
+        return true;
+    }
+
+    void unbind() {
+        layerCount = inputCount = classCount = 0;
+        memset(modelVersion, 0, sizeof(modelVersion));
+    }
+
+    bool loaded() const { return layerCount != 0; }
+    const char* version() const { return modelVersion; }
+    uint8_t inputs() const { return inputCount; }
+    uint8_t classes() const { return classCount; }
+    uint8_t layerTotal() const { return layerCount; }
+
+    // Class probabilities into out[classes()]. False if nothing is bound or
+    // n < inputs() (extra inputs are ignored).
+    bool run(const float* in, size_t n, float* out) {
+        if (!loaded() || n < inputCount) return false;
+
+        int16_t* cur = work[0];
+        int16_t* nxt = work[1];
+        for (uint8_t i = 0; i < inputCount; i++) {
+            float q = (in[i] - inOffset[i]) * inScale[i] * (float)(1 << ACT_FRAC);
+            if (!(q > -32768.0f)) q = -32768.0f;  // Also NaN
+            if (q > 32767.0f) q = 32767.0f;
+            cur[i] = (int16_t)lroundf(q);
+        }
+
+        int32_t logits[MAX_CLASSES];
+        for (uint8_t l = 0; l < layerCount; l++) {
+            const Layer& L = layers[l];
+            bool last = l == layerCount - 1;
+            const int8_t* w = L.weights;
+            for (uint16_t o = 0; o < L.out; o++, w += L.in) {
+                int32_t acc = L.bias[o];
+                for (uint16_t i = 0; i < L.in; i++) acc += (int32_t)w[i] * cur[i];
+                int32_t v = rescale(acc, L.shift);
+                if (last) {
+                    logits[o] = v;
+                } else {
+                    if (L.act == ACT_RELU && v < 0) v = 0;
+                    nxt[o] = saturate(v);
+                }
+            }
+            int16_t* t = cur; cur = nxt; nxt = t;
+        }
+
+        // Softmax over the dequantized logits, minus the largest for stability.
+        // Logits reach about +/-2^30 with shift 0, so the gap needs 64 bits.
+        int32_t top = logits[0];
+        for (uint8_t c = 1; c < classCount; c++) if (logits[c] > top) top = logits[c];
+        float sum = 0.0f;
+        for (uint8_t c = 0; c < classCount; c++) {
+            out[c] = expf((float)((int64_t)logits[c] - top) / (float)(1 << ACT_FRAC));
+            sum += out[c];
+        }
+        for (uint8_t c = 0; c < classCount; c++) out[c] /= sum;
+        return true;
+    }
+
+    static size_t weightBytes(uint16_t in, uint16_t out) { return ((size_t)in * out + 3) & ~(size_t)3; }
+
+private:
+    struct Layer {
+        const int8_t* weights;   // [out][in]
+        const int32_t* bias;     // [out], scale 2^(ACT_FRAC + shift)
+        uint16_t in;
+        uint16_t out;
+        uint8_t act;
+        uint8_t shift;
+    };
+
+    Layer layers[MAX_LAYERS];
+    float inOffset[MAX_WIDTH];
+    float inScale[MAX_WIDTH];
+    int16_t work[2][MAX_WIDTH];  // Ping-pong activations
+    char modelVersion[16];
+    uint8_t layerCount;
+    uint8_t inputCount;
+    uint8_t classCount;
+
+    static uint16_t get16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+    static uint32_t get32(const uint8_t* p) {
+        return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+    }
+
+    // Accumulator back to Q7.8: divide by 2^shift, rounding half away from zero
+    static int32_t rescale(int32_t acc, uint8_t shift) {
+        if (shift == 0) return acc;
+        int32_t half = 1 << (shift - 1);
+        return acc >= 0 ? (acc + half) >> shift : -((-acc + half) >> shift);
+    }
+
+    static int16_t saturate(long v) {
+        return v > 32767 ? 32767 : (v < -32768 ? -32768 : (int16_t)v);
+    }
+};
@@ -14,6 +14,7 @@
 #include <atomic>
 #include "../core/config.h"
 #include "../core/sdlog.h"
+#include "../core/capture_catalog.h"
 #include "../piglet/mood.h"
 #include "../ui/display.h"
 
@@ -1432,7 +1433,7 @@ bool CallPapaMode::savePMKID(const uint8_t* data, uint16_t len) {
              bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5]);
     
     // Check for duplicate
-    if (SD.exists(filename)) {
+    if (CaptureCatalog::isSaved(bssid, CaptureKind::PMKID)) {
         Serial.printf("[SON-OF-PIG] PMKID already exists: %s\n", filename);
         return true;  // Consider as success (already have it)
     }
@@ -1472,15 +1473,17 @@ bool CallPapaMode::savePMKID(const uint8_t* data, uint16_t len) {
     snprintf(txtFilename, sizeof(txtFilename), "/handshakes/%02X%02X%02X%02X%02X%02X_pmkid.txt",
              bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5]);
     
+    char ssidCopy[33];
+    strncpy(ssidCopy, ssid, ssidLen);
+    ssidCopy[ssidLen] = '\0';
     File txtFile = SD.open(txtFilename, FILE_WRITE);
     if (txtFile) {
-        char ssidCopy[33];
-        strncpy(ssidCopy, ssid, ssidLen);
-        ssidCopy[ssidLen] = '\0';
         txtFile.println(ssidCopy);
         txtFile.close();
     }
     
+    CaptureCatalog::noteSaved(bssid, station, CaptureKind::PMKID, ssidCopy, filename);
+    
     Serial.printf("[SON-OF-PIG] PMKID saved: %s (SSID: %.*s)\n", filename, ssidLen, ssid);
     SDLog::log("SON-OF-PIG", "PMKID synced from Sirloin: %.*s", ssidLen, ssid);
     
@@ -1515,7 +1518,7 @@ bool CallPapaMode::saveHandshake(const uint8_t* data, uint16_t len) {
              bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5]);
     
     // Check for duplicate
-    if (SD.exists(pcapFilename)) {
+    if (CaptureCatalog::isSaved(bssid, CaptureKind::PCAP)) {
         Serial.printf("[SON-OF-PIG] Handshake already exists: %s\n", pcapFilename);
         return true;
     }
@@ -1654,15 +1657,17 @@ bool CallPapaMode::saveHandshake(const uint8_t* data, uint16_t len) {
     snprintf(txtFilename, sizeof(txtFilename), "/handshakes/%02X%02X%02X%02X%02X%02X.txt",
              bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5]);
     
+    char ssidCopy[33];
+    strncpy(ssidCopy, ssid, ssidLen);
+    ssidCopy[ssidLen] = '\0';
     File txtFile = SD.open(txtFilename, FILE_WRITE);
     if (txtFile) {
-        char ssidCopy[33];
-        strncpy(ssidCopy, ssid, ssidLen);
-        ssidCopy[ssidLen] = '\0';
         txtFile.println(ssidCopy);
         txtFile.close();
     }
     
+    CaptureCatalog::noteSaved(bssid, station, CaptureKind::PCAP, ssidCopy, pcapFilename);
+    
     Serial.printf("[SON-OF-PIG] Handshake saved: %s (SSID: %.*s)\n", pcapFilename, ssidLen, ssid);
     SDLog::log("SON-OF-PIG", "Handshake synced from Sirloin: %.*s", ssidLen, ssid);
     
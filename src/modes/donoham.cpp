@@ -6,7 +6,10 @@
 #include <M5Unified.h>
 #include <WiFi.h>
 #include "../core/config.h"
+#include "../core/mgmt_frame.h"
 #include "../core/sdlog.h"
+#include "../core/capture_stats.h"
+#include "../core/capture_store.h"
 #include "../core/xp.h"
 #include "../core/wsl_bypasser.h"
 #include "../ui/display.h"
@@ -14,34 +17,6 @@
 #include "../piglet/avatar.h"
 #include <SD.h>
 
-// PCAP file format structures (same as OINK for WPA-SEC compatibility)
-#pragma pack(push, 1)
-struct DNH_PCAPHeader {
-    uint32_t magic;
-    uint16_t version_major;
-    uint16_t version_minor;
-    int32_t thiszone;
-    uint32_t sigfigs;
-    uint32_t snaplen;
-    uint32_t linktype;
-};
-
-struct DNH_PCAPPacketHeader {
-    uint32_t ts_sec;
-    uint32_t ts_usec;
-    uint32_t incl_len;
-    uint32_t orig_len;
-};
-#pragma pack(pop)
-
-// Minimal radiotap header (8 bytes) - required for WPA-SEC
-static const uint8_t DNH_RADIOTAP_HEADER[] = {
-    0x00,       // Header revision
-    0x00,       // Header pad
-    0x08, 0x00, // Header length (8, little-endian)
-    0x00, 0x00, 0x00, 0x00  // Present flags (no optional fields)
-};
-
 // Static member initialization
 bool DoNoHamMode::running = false;
 DNHState DoNoHamMode::state = DNHState::HOPPING;
@@ -51,9 +26,11 @@ uint32_t DoNoHamMode::lastHopTime = 0;
 uint32_t DoNoHamMode::dwellStartTime = 0;
 bool DoNoHamMode::dwellResolved = false;
 
-std::vector<DetectedNetwork> DoNoHamMode::networks;
-std::vector<CapturedPMKID> DoNoHamMode::pmkids;
-std::vector<CapturedHandshake> DoNoHamMode::handshakes;
+// Capture tables live in CaptureStore, shared with OINK
+static std::vector<DetectedNetwork>& networks = CaptureStore::networks;
+static std::vector<CapturedPMKID>& pmkids = CaptureStore::pmkids;
+static std::vector<CapturedHandshake>& handshakes = CaptureStore::handshakes;
+static BeaconCache<CAPTURE_BEACON_CACHE_SLOTS>& beaconCache = CaptureStore::beaconCache;
 
 // Adaptive state machine
 ChannelStats DoNoHamMode::channelStats[13] = {};
@@ -64,45 +41,30 @@ uint8_t DoNoHamMode::lastHuntChannel = 0;
 uint32_t DoNoHamMode::lastStatsDecay = 0;
 uint8_t DoNoHamMode::lastCycleActivity = 0;
 
-// Guard flag for race condition prevention
-static volatile bool dnhBusy = false;
-
-// Single-slot deferred network add (same pattern as OINK)
-static volatile bool pendingNetworkAdd = false;
-static DetectedNetwork pendingNetwork;
+// Frames come through CaptureStore::frames (filled by OINK's callback)
+static FrameRing<CaptureStore::FRAME_RING_BYTES>& frameRing = CaptureStore::frames;
 
-// Single-slot deferred PMKID create
-static volatile bool pendingPMKIDCreateReady = false;
-static volatile bool pendingPMKIDCreateBusy = false;
-struct PendingPMKIDCreate {
-    uint8_t bssid[6];
-    uint8_t station[6];
-    uint8_t pmkid[16];
-    char ssid[33];
-    uint8_t channel;
-};
-static PendingPMKIDCreate pendingPMKIDCreate;
+// PMKID waiting on a beacon for its SSID (DWELLING)
+static uint8_t dwellBssid[6] = {0};
 
-// Single-slot deferred handshake frame add (now stores all 4 frames)
-static volatile bool pendingHandshakeAdd = false;
-static volatile bool pendingHandshakeBusy = false;
-struct PendingHandshakeFrame {
-    uint8_t bssid[6];
-    uint8_t station[6];
-    uint8_t messageNum;  // DEPRECATED - kept for compatibility
-    EAPOLFrame frames[4];  // Store all 4 EAPOL frames (M1-M4)
-    uint8_t capturedMask;  // Bitmask: bit0=M1, bit1=M2, bit2=M3, bit3=M4
-};
-static PendingHandshakeFrame pendingHandshake;
+// PMKID capture event for UI
+static bool pendingPMKIDCapture = false;
+static char pendingPMKIDSSID[33] = {0};
 
 // Handshake capture event for UI
-static volatile bool pendingHandshakeCapture = false;
+static bool pendingHandshakeCapture = false;
 static char pendingHandshakeSSID[33] = {0};
 
 // Deferred save flag - set during update(), processed in stop() after promiscuous disabled
 // Avoids SD/WiFi SPI bus contention that can cause crashes
 static volatile bool pendingSaveFlag = false;
 
+// Everything unsaved to SD (promiscuous mode must be off)
+static void saveCaptures(bool live) {
+    CaptureStore::savePMKIDs("DNH");
+    CaptureStore::saveHandshakes("DNH", live);
+}
+
 // Channel order: 1, 6, 11 first (non-overlapping), then fill in
 static const uint8_t CHANNEL_ORDER[] = {1, 6, 11, 2, 7, 12, 3, 8, 13, 4, 9, 5, 10};
 
@@ -120,14 +82,13 @@ void DoNoHamMode::start() {
     
     Serial.println("[DNH] Starting passive mode");
     SDLog::log("DNH", "Starting passive mode");
+    CaptureTelemetry::reset();
     
-    // Clear previous session data
-    networks.clear();
-    networks.shrink_to_fit();
-    pmkids.clear();
-    pmkids.shrink_to_fit();
-    handshakes.clear();
-    handshakes.shrink_to_fit();
+    // Clear previous session data. The tables are OINK's too: anything it
+    // left unsaved goes to SD first.
+    esp_wifi_set_promiscuous(false);
+    saveCaptures(false);
+    CaptureStore::clear();
     incompleteHandshakes.clear();
     incompleteHandshakes.shrink_to_fit();
     
@@ -157,13 +118,10 @@ void DoNoHamMode::start() {
     lastHuntChannel = 0;
     dwellResolved = false;
     
-    // Reset deferred flags
-    pendingNetworkAdd = false;
-    pendingPMKIDCreateReady = false;
-    pendingPMKIDCreateBusy = false;
-    pendingHandshakeAdd = false;
-    pendingHandshakeBusy = false;
+    // Reset capture events
+    pendingPMKIDCapture = false;
     pendingHandshakeCapture = false;
+    frameRing.clear();
     
     // Randomize MAC if configured
     if (Config::wifi().randomizeMAC) {
@@ -215,13 +173,11 @@ void DoNoHamMode::startSeamless() {
     lastMoodTime = millis();
     dwellResolved = false;
     
-    // Reset deferred flags
-    pendingNetworkAdd = false;
-    pendingPMKIDCreateReady = false;
-    pendingPMKIDCreateBusy = false;
-    pendingHandshakeAdd = false;
-    pendingHandshakeBusy = false;
+    // Reset capture events; OINK's leftover frames aren't ours to parse
+    pendingPMKIDCapture = false;
     pendingHandshakeCapture = false;
+    frameRing.clear();
+    CaptureStore::releaseHold();
     
     running = true;
     
@@ -244,36 +200,19 @@ void DoNoHamMode::stop() {
     // Process any deferred XP saves now that WiFi is off
     XP::processPendingSave();
     
+    CaptureTelemetry::dump("DNH stop");
+    
     // Process deferred capture saves now that WiFi is off (SPI bus safe)
     pendingSaveFlag = false;  // Clear flag before processing
-    saveAllPMKIDs();
-    saveAllHandshakes();
-    
-    // Free per-handshake beacon memory to prevent leaks
-    for (auto& hs : handshakes) {
-        if (hs.beaconData) {
-            free(hs.beaconData);
-            hs.beaconData = nullptr;
-        }
-    }
+    saveCaptures(false);
     
     // Clear vectors
-    dnhBusy = true;
-    networks.clear();
-    networks.shrink_to_fit();
-    pmkids.clear();
-    pmkids.shrink_to_fit();
-    handshakes.clear();
-    handshakes.shrink_to_fit();
-    dnhBusy = false;
-    
-    // Reset deferred flags
-    pendingNetworkAdd = false;
-    pendingPMKIDCreateReady = false;
-    pendingPMKIDCreateBusy = false;
-    pendingHandshakeAdd = false;
-    pendingHandshakeBusy = false;
+    CaptureStore::clear();
+    
+    // Reset capture events
+    pendingPMKIDCapture = false;
     pendingHandshakeCapture = false;
+    frameRing.clear();
     
     Serial.println("[DNH] Stopped");
 }
@@ -285,21 +224,14 @@ void DoNoHamMode::stopSeamless() {
     SDLog::log("DNH", "Seamless stop");
     
     running = false;
-    dnhBusy = false;  // Reset busy flag for clean handoff
+    frameRing.clear();  // OINK owns the ring from here on
     
     // DON'T disable promiscuous mode - OINK will take over
-    // DON'T clear vectors - let them die naturally
+    // DON'T clear CaptureStore - OINK carries on with the same tables
     // DON'T save to SD - promiscuous still active, SPI bus contention risk
-    // Data remains in RAM, will be saved when mode fully exits via stop()
+    // Unsaved captures stay in CaptureStore; OINK's auto-save picks them up
     pendingSaveFlag = true;  // Mark for save when WiFi eventually stops
-    
-    // Free beacon memory since OINK will recapture its own
-    for (auto& hs : handshakes) {
-        if (hs.beaconData) {
-            free(hs.beaconData);
-            hs.beaconData = nullptr;
-        }
-    }
+    // Cached beacons stay too: the deferred save writes them into the PCAPs
 }
 
 void DoNoHamMode::update() {
@@ -307,162 +239,45 @@ void DoNoHamMode::update() {
     
     uint32_t now = millis();
     
-    // Set busy flag for race protection
-    dnhBusy = true;
-    
-    // Process deferred network add
-    if (pendingNetworkAdd) {
-        if (networks.size() < DNH_MAX_NETWORKS) {
-            // Check if already exists
-            int idx = findNetwork(pendingNetwork.bssid);
-            if (idx >= 0) {
-                // Update existing
-                networks[idx].rssi = pendingNetwork.rssi;
-                networks[idx].lastSeen = pendingNetwork.lastSeen;
-                networks[idx].beaconCount++;
-                // Backfill SSID if we didn't have it before (critical for PMKID save)
-                if (networks[idx].ssid[0] == 0 && pendingNetwork.ssid[0] != 0) {
-                    strncpy(networks[idx].ssid, pendingNetwork.ssid, 32);
-                    networks[idx].ssid[32] = 0;
-                    Serial.printf("[DNH] SSID backfilled for existing network: %s\n", networks[idx].ssid);
-                }
-            } else {
-                // Add new
-                networks.push_back(pendingNetwork);
-                XP::addXP(XPEvent::DNH_NETWORK_PASSIVE);
+    // ============ Drain Frames Queued by Callback ============
+    // Same ring and bounds as OINK: parsing and table work happen here,
+    // and whatever is left stays queued for the next update()
+    CAPTURE_QUEUE(frameRing.usedBytes(), frameRing.capacity());
+    bool heldSaveDue = false;
+    size_t drained = 0;
+    while (drained < DNH_DRAIN_MAX) {
+        size_t n = frameRing.drain([&heldSaveDue](const FrameRecord& rec) {
+            if (rec.type == WIFI_PKT_MGMT) {
+                if (handleBeacon(rec.data(), rec.len, rec.rssi, rec.channel)) heldSaveDue = true;
+            } else if (rec.type == WIFI_PKT_DATA) {
+                handleEAPOL(rec.data(), rec.len, rec.rssi, rec.channel);
             }
-        }
-        pendingNetworkAdd = false;
+        }, DNH_DRAIN_BATCH);
+        if (n == 0) break;
+        drained += n;
     }
     
-    // Process deferred PMKID create
-    if (pendingPMKIDCreateReady && !pendingPMKIDCreateBusy) {
-        // Check if dwell is complete (if we needed one)
-        bool canProcess = true;
-        if (pendingPMKIDCreate.ssid[0] == 0 && state == DNHState::DWELLING) {
-            // Still dwelling, wait for beacon or timeout
-            if (!dwellResolved && (now - dwellStartTime < DNH_DWELL_TIME)) {
-                canProcess = false;
-            }
-        }
-        
-        if (canProcess) {
-            pendingPMKIDCreateBusy = true;
-            
-            // Try to find SSID if we don't have it
-            if (pendingPMKIDCreate.ssid[0] == 0) {
-                int netIdx = findNetwork(pendingPMKIDCreate.bssid);
-                if (netIdx >= 0 && networks[netIdx].ssid[0] != 0) {
-                    strncpy(pendingPMKIDCreate.ssid, networks[netIdx].ssid, 32);
-                    pendingPMKIDCreate.ssid[32] = 0;
-                }
-            }
-            
-            // Create or update PMKID entry
-            if (pmkids.size() < DNH_MAX_PMKIDS) {
-                int idx = findOrCreatePMKID(pendingPMKIDCreate.bssid);
-                if (idx >= 0) {
-                    memcpy(pmkids[idx].pmkid, pendingPMKIDCreate.pmkid, 16);
-                    memcpy(pmkids[idx].station, pendingPMKIDCreate.station, 6);
-                    strncpy(pmkids[idx].ssid, pendingPMKIDCreate.ssid, 32);
-                    pmkids[idx].ssid[32] = 0;
-                    pmkids[idx].timestamp = now;
-                    
-                    // Announce capture + immediate safe save
-                    if (pendingPMKIDCreate.ssid[0] != 0) {
-                        Serial.printf("[DNH] PMKID captured: %s\n", pendingPMKIDCreate.ssid);
-                        Display::showToast("BOOMBOCLAAT! PMKID");
-                        if (Config::personality().soundEnabled) {
-                            M5.Speaker.tone(880, 100);
-                        }
-                        // XP awarded via Mood::onPMKIDCaptured (don't double award)
-                        Mood::onPMKIDCaptured(pendingPMKIDCreate.ssid);
-                        
-                        // Immediate save with brief promiscuous pause (safe SD access)
-                        esp_wifi_set_promiscuous(false);
-                        delay(5);
-                        saveAllPMKIDs();
-                        esp_wifi_set_promiscuous(true);
-                    } else {
-                        Serial.println("[DNH] PMKID captured but SSID unknown");
-                    }
-                }
-            }
-            
-            pendingPMKIDCreateReady = false;
-            pendingPMKIDCreateBusy = false;
-            
-            // Return to hopping if we were dwelling
-            if (state == DNHState::DWELLING) {
-                state = DNHState::HOPPING;
-                dwellResolved = false;
-            }
-        }
+    // A save held for a beacon that never came goes ahead without it
+    if (CaptureStore::holdExpired(now)) {
+        heldSaveDue = true;
     }
     
-    // Process deferred handshake frame add (batch process all queued frames)
-    if (pendingHandshakeAdd && !pendingHandshakeBusy) {
-        pendingHandshakeBusy = true;
-        
-        // Find or create handshake entry
-        int hsIdx = findOrCreateHandshake(pendingHandshake.bssid, pendingHandshake.station);
-        if (hsIdx >= 0) {
-            CapturedHandshake& hs = handshakes[hsIdx];
-            
-            // Process ALL queued frames (M1-M4) from capturedMask
-            for (int msgIdx = 0; msgIdx < 4; msgIdx++) {
-                if (pendingHandshake.capturedMask & (1 << msgIdx)) {
-                    // Frame is present in the queued data
-                    if (hs.frames[msgIdx].len == 0) {  // Not already captured
-                        uint16_t copyLen = pendingHandshake.frames[msgIdx].len;
-                        if (copyLen > 0 && copyLen <= 512) {
-                            // EAPOL payload for hashcat 22000
-                            memcpy(hs.frames[msgIdx].data, pendingHandshake.frames[msgIdx].data, copyLen);
-                            hs.frames[msgIdx].len = copyLen;
-                            hs.frames[msgIdx].messageNum = msgIdx + 1;
-                            hs.frames[msgIdx].timestamp = now;
-                            
-                            // Full 802.11 frame for PCAP export (radiotap + WPA-SEC)
-                            uint16_t fullCopyLen = pendingHandshake.frames[msgIdx].fullFrameLen;
-                            if (fullCopyLen > 0 && fullCopyLen <= 300) {
-                                memcpy(hs.frames[msgIdx].fullFrame, pendingHandshake.frames[msgIdx].fullFrame, fullCopyLen);
-                                hs.frames[msgIdx].fullFrameLen = fullCopyLen;
-                                hs.frames[msgIdx].rssi = pendingHandshake.frames[msgIdx].rssi;
-                            }
-                            
-                            hs.capturedMask |= (1 << msgIdx);
-                            hs.lastSeen = now;
-                            
-                            Serial.printf("[DNH] M%d captured (deferred)\n", msgIdx + 1);
-                        }
-                    }
-                }
-            }
-            
-            // Look up SSID if missing
-            if (hs.ssid[0] == 0) {
-                int netIdx = findNetwork(hs.bssid);
-                if (netIdx >= 0 && networks[netIdx].ssid[0] != 0) {
-                    strncpy(hs.ssid, networks[netIdx].ssid, 32);
-                    hs.ssid[32] = 0;
-                }
-            }
-            
-            // Check if we just completed a valid pair
-            if (hs.hasValidPair() && !hs.saved && !pendingHandshakeCapture) {
-                strncpy(pendingHandshakeSSID, hs.ssid, 32);
-                pendingHandshakeSSID[32] = 0;
-                pendingHandshakeCapture = true;
-                
-                Serial.printf("[DNH] Handshake complete: %s\n", 
-                    hs.ssid[0] ? hs.ssid : "?");
-            }
+    // Process PMKID capture event (UI update + immediate safe save)
+    if (pendingPMKIDCapture) {
+        Serial.printf("[DNH] PMKID captured: %s\n", pendingPMKIDSSID);
+        Display::showToast("BOOMBOCLAAT! PMKID");
+        if (Config::personality().soundEnabled) {
+            M5.Speaker.tone(880, 100);
         }
+        // XP awarded via Mood::onPMKIDCaptured (don't double award)
+        Mood::onPMKIDCaptured(pendingPMKIDSSID);
+        pendingPMKIDCapture = false;
         
-        // Clear slot for next handshake
-        pendingHandshake.capturedMask = 0;
-        pendingHandshakeAdd = false;
-        pendingHandshakeBusy = false;
+        // Immediate save with brief promiscuous pause (safe SD access)
+        esp_wifi_set_promiscuous(false);
+        delay(5);
+        CaptureStore::savePMKIDs("DNH");
+        esp_wifi_set_promiscuous(true);
     }
     
     // Process handshake capture event (UI update + immediate safe save)
@@ -474,12 +289,16 @@ void DoNoHamMode::update() {
         // XP awarded via Mood::onHandshakeCaptured (don't double award)
         Mood::onHandshakeCaptured(pendingHandshakeSSID);
         pendingHandshakeCapture = false;
-        
+        heldSaveDue = true;
+    }
+    
+    if (heldSaveDue) {
         // Immediate save with brief promiscuous pause (safe SD access)
         // ~50ms gap is acceptable - we just captured what we needed
+        CaptureStore::releaseHold();  // Re-armed by any handshake still waiting
         esp_wifi_set_promiscuous(false);
         delay(5);  // Let SPI bus settle
-        saveAllHandshakes();
+        CaptureStore::saveHandshakes("DNH", running);
         esp_wifi_set_promiscuous(true);
     }
     
@@ -504,6 +323,7 @@ void DoNoHamMode::update() {
             
         case DNHState::DWELLING:
             if (dwellResolved || (now - dwellStartTime > DNH_DWELL_TIME)) {
+                if (!dwellResolved) Serial.println("[DNH] PMKID captured but SSID unknown");
                 state = DNHState::HOPPING;
                 dwellResolved = false;
             }
@@ -563,8 +383,6 @@ void DoNoHamMode::update() {
         Mood::onPassiveRecon(networks.size(), currentChannel);
         lastMoodTime = now;
     }
-    
-    dnhBusy = false;
 }
 
 void DoNoHamMode::hopToNextChannel() {
@@ -711,491 +529,66 @@ void DoNoHamMode::ageOutStaleNetworks() {
             ++it;
         }
     }
+    CaptureStore::networkIndex.rebuild();  // Erase shifted positions
 }
 
-void DoNoHamMode::saveAllPMKIDs() {
-    // Save PMKIDs in hashcat 22000 format
-    for (auto& p : pmkids) {
-        if (p.saved) continue;
-        if (p.saveAttempts >= 3) continue;  // Give up after 3 failures
-        
-        // Exponential backoff: 0s, 2s, 5s
-        static const uint32_t backoffMs[] = {0, 2000, 5000};
-        uint32_t timeSinceCapture = millis() - p.timestamp;
-        if (timeSinceCapture < backoffMs[p.saveAttempts]) continue;
-        
-        // Try to backfill SSID if missing
-        if (p.ssid[0] == 0) {
-            int netIdx = findNetwork(p.bssid);
-            if (netIdx >= 0 && networks[netIdx].ssid[0] != 0) {
-                strncpy(p.ssid, networks[netIdx].ssid, 32);
-                p.ssid[32] = 0;
-            }
-        }
-        
-        // Try to backfill SSID from companion txt file (cross-mode compatibility)
-        if (p.ssid[0] == 0) {
-            char txtPath[64];
-            snprintf(txtPath, sizeof(txtPath), "/handshakes/%02X%02X%02X%02X%02X%02X_pmkid.txt",
-                     p.bssid[0], p.bssid[1], p.bssid[2], p.bssid[3], p.bssid[4], p.bssid[5]);
-            if (SD.exists(txtPath)) {
-                File txtFile = SD.open(txtPath, FILE_READ);
-                if (txtFile) {
-                    String ssid = txtFile.readStringUntil('\n');
-                    ssid.trim();
-                    if (ssid.length() > 0) {
-                        strncpy(p.ssid, ssid.c_str(), 32);
-                        p.ssid[32] = 0;
-                        Serial.printf("[DNH] PMKID SSID backfilled from txt: %s\\n", p.ssid);
-                    }
-                    txtFile.close();
-                }
-            }
-        }
-        
-        // Can only save if we have SSID (don't count as attempt - will retry when SSID arrives)
-        if (p.ssid[0] == 0) continue;
-        
-        // Check for all-zero PMKID (invalid - don't count as attempt)
-        bool allZeros = true;
-        for (int i = 0; i < 16; i++) {
-            if (p.pmkid[i] != 0) { allZeros = false; break; }
-        }
-        if (allZeros) {
-            p.saved = true;  // Mark invalid PMKID as done
-            continue;
-        }
-        
-        // Now we actually attempt to save - increment counter
-        p.saveAttempts++;
-        
-        // Build filename: /handshakes/BSSID.22000
-        char filename[64];
-        snprintf(filename, sizeof(filename), "/handshakes/%02X%02X%02X%02X%02X%02X.22000",
-            p.bssid[0], p.bssid[1], p.bssid[2], p.bssid[3], p.bssid[4], p.bssid[5]);
-        
-        // Ensure directory exists
-        if (!SD.exists("/handshakes")) {
-            SD.mkdir("/handshakes");
-        }
-        
-        File f = SD.open(filename, FILE_WRITE);
-        if (!f) {
-            Serial.printf("[DNH] Failed to create PMKID file: %s (attempt %d)\\n", filename, p.saveAttempts);
-            if (p.saveAttempts >= 3) {
-                p.saved = true;  // Give up
-            }
-            continue;
-        }
-        
-        // Build hex strings
-        char pmkidHex[33];
-        for (int i = 0; i < 16; i++) {
-            sprintf(pmkidHex + i*2, "%02x", p.pmkid[i]);
-        }
-        
-        char macAP[13];
-        sprintf(macAP, "%02x%02x%02x%02x%02x%02x",
-            p.bssid[0], p.bssid[1], p.bssid[2], 
-            p.bssid[3], p.bssid[4], p.bssid[5]);
-        
-        char macClient[13];
-        sprintf(macClient, "%02x%02x%02x%02x%02x%02x",
-            p.station[0], p.station[1], p.station[2], 
-            p.station[3], p.station[4], p.station[5]);
-        
-        char essidHex[65];
-        int ssidLen = strlen(p.ssid);
-        if (ssidLen > 32) ssidLen = 32;  // Cap to max SSID length
-        for (int i = 0; i < ssidLen; i++) {
-            sprintf(essidHex + i*2, "%02x", (uint8_t)p.ssid[i]);
-        }
-        essidHex[ssidLen * 2] = 0;
-        
-        // WPA*01*PMKID*MAC_AP*MAC_CLIENT*ESSID***01
-        f.printf("WPA*01*%s*%s*%s*%s***01\\n", pmkidHex, macAP, macClient, essidHex);
-        f.close();
-        
-        // Save SSID to companion txt file (matches OINK pattern)
-        char txtFilename[64];
-        snprintf(txtFilename, sizeof(txtFilename), "/handshakes/%02X%02X%02X%02X%02X%02X_pmkid.txt",
-                 p.bssid[0], p.bssid[1], p.bssid[2], p.bssid[3], p.bssid[4], p.bssid[5]);
-        // Delete existing file first to ensure clean overwrite (FILE_WRITE appends on ESP32)
-        if (SD.exists(txtFilename)) {
-            SD.remove(txtFilename);
-        }
-        File txtFile = SD.open(txtFilename, FILE_WRITE);
-        if (txtFile) {
-            txtFile.println(p.ssid);
-            txtFile.close();
-        }
-        
-        p.saved = true;
-        Serial.printf("[DNH] PMKID saved: %s\\n", filename);
-        SDLog::log("DNH", "PMKID saved: %s (%s)", p.ssid, filename);
-    }
-}
-
-void DoNoHamMode::saveAllHandshakes() {
-    // Save handshakes in hashcat 22000 format (WPA*02)
-    for (auto& hs : handshakes) {
-        if (hs.saved) continue;
-        if (!hs.hasValidPair()) continue;  // Need M1+M2 or M2+M3
-        if (hs.saveAttempts >= 3) continue;  // Give up after 3 failures
-        
-        // Exponential backoff: 0s, 2s, 5s
-        static const uint32_t backoffMs[] = {0, 2000, 5000};
-        uint32_t timeSinceCapture = millis() - hs.lastSeen;
-        if (timeSinceCapture < backoffMs[hs.saveAttempts]) continue;
-        
-        // Try to backfill SSID if missing
-        if (hs.ssid[0] == 0) {
-            int netIdx = findNetwork(hs.bssid);
-            if (netIdx >= 0 && networks[netIdx].ssid[0] != 0) {
-                strncpy(hs.ssid, networks[netIdx].ssid, 32);
-                hs.ssid[32] = 0;
-            }
-        }
-        
-        // Try to backfill SSID from companion txt file (cross-mode compatibility)
-        if (hs.ssid[0] == 0) {
-            char txtPath[64];
-            snprintf(txtPath, sizeof(txtPath), "/handshakes/%02X%02X%02X%02X%02X%02X.txt",
-                     hs.bssid[0], hs.bssid[1], hs.bssid[2], hs.bssid[3], hs.bssid[4], hs.bssid[5]);
-            if (SD.exists(txtPath)) {
-                File txtFile = SD.open(txtPath, FILE_READ);
-                if (txtFile) {
-                    String ssid = txtFile.readStringUntil('\n');
-                    ssid.trim();
-                    if (ssid.length() > 0) {
-                        strncpy(hs.ssid, ssid.c_str(), 32);
-                        hs.ssid[32] = 0;
-                        Serial.printf("[DNH] Handshake SSID backfilled from txt: %s\\n", hs.ssid);
-                    }
-                    txtFile.close();
-                }
-            }
-        }
-        
-        // Can only save if we have SSID (don't count as attempt - will retry when SSID arrives)
-        if (hs.ssid[0] == 0) continue;
-        
-        // Determine message pair
-        uint8_t msgPair = hs.getMessagePair();
-        if (msgPair == 0xFF) continue;
-        
-        // Get frames
-        const EAPOLFrame* nonceFrame = nullptr;
-        const EAPOLFrame* eapolFrame = nullptr;
-        
-        if (msgPair == 0x00) {
-            nonceFrame = &hs.frames[0];  // M1
-            eapolFrame = &hs.frames[1];  // M2
-        } else {
-            nonceFrame = &hs.frames[2];  // M3
-            eapolFrame = &hs.frames[1];  // M2
-        }
-        
-        // Frame length validation (don't count as attempt if malformed)
-        if (nonceFrame->len < 51 || eapolFrame->len < 97) continue;
-        
-        // Now we actually attempt to save - increment counter
-        hs.saveAttempts++;
-        
-        // Build filename: /handshakes/BSSID_hs.22000
-        char filename[64];
-        snprintf(filename, sizeof(filename), "/handshakes/%02X%02X%02X%02X%02X%02X_hs.22000",
-            hs.bssid[0], hs.bssid[1], hs.bssid[2], hs.bssid[3], hs.bssid[4], hs.bssid[5]);
-        
-        // Ensure directory exists
-        if (!SD.exists("/handshakes")) {
-            SD.mkdir("/handshakes");
-        }
-        
-        File f = SD.open(filename, FILE_WRITE);
-        if (!f) {
-            Serial.printf("[DNH] Failed to create handshake file: %s (attempt %d)\\n", filename, hs.saveAttempts);
-            if (hs.saveAttempts >= 3) {
-                hs.saved = true;  // Give up
-            }
-            continue;
-        }
-        
-        // Extract MIC from M2 (offset 81, 16 bytes)
-        char micHex[33];
-        for (int i = 0; i < 16; i++) {
-            sprintf(micHex + i*2, "%02x", eapolFrame->data[81 + i]);
-        }
-        
-        // MAC_AP
-        char macAP[13];
-        sprintf(macAP, "%02x%02x%02x%02x%02x%02x",
-            hs.bssid[0], hs.bssid[1], hs.bssid[2],
-            hs.bssid[3], hs.bssid[4], hs.bssid[5]);
-        
-        // MAC_CLIENT
-        char macClient[13];
-        sprintf(macClient, "%02x%02x%02x%02x%02x%02x",
-            hs.station[0], hs.station[1], hs.station[2],
-            hs.station[3], hs.station[4], hs.station[5]);
-        
-        // ESSID (hex-encoded, max 32 chars = 64 hex + null)
-        char essidHex[65];
-        int ssidLen = strlen(hs.ssid);
-        if (ssidLen > 32) ssidLen = 32;  // Cap to max SSID length
-        for (int i = 0; i < ssidLen; i++) {
-            sprintf(essidHex + i*2, "%02x", (uint8_t)hs.ssid[i]);
-        }
-        essidHex[ssidLen * 2] = 0;
-        
-        // ANonce from M1 or M3 (offset 17, 32 bytes)
-        char nonceHex[65];
-        for (int i = 0; i < 32; i++) {
-            sprintf(nonceHex + i*2, "%02x", nonceFrame->data[17 + i]);
-        }
-        
-        // EAPOL frame with MIC zeroed
-        uint16_t eapolLen = (eapolFrame->data[2] << 8) | eapolFrame->data[3];
-        eapolLen += 4;
-        if (eapolLen > eapolFrame->len) eapolLen = eapolFrame->len;
-        
-        char* eapolHex = (char*)malloc(eapolLen * 2 + 1);
-        if (!eapolHex) {
-            f.close();
-            continue;
-        }
-        
-        // Copy and zero MIC
-        uint8_t eapolCopy[512];
-        memcpy(eapolCopy, eapolFrame->data, eapolLen);
-        memset(eapolCopy + 81, 0, 16);
-        
-        for (int i = 0; i < eapolLen; i++) {
-            sprintf(eapolHex + i*2, "%02x", eapolCopy[i]);
-        }
-        eapolHex[eapolLen * 2] = 0;
-        
-        // WPA*02*MIC*MAC_AP*MAC_CLIENT*ESSID*ANONCE*EAPOL*MESSAGEPAIR
-        f.printf("WPA*02*%s*%s*%s*%s*%s*%s*%02x\n",
-            micHex, macAP, macClient, essidHex, nonceHex, eapolHex, msgPair);
-        
-        free(eapolHex);
-        f.close();
-        
-        // Save SSID to companion txt file (matches OINK pattern)
-        char txtFilename[64];
-        snprintf(txtFilename, sizeof(txtFilename), "/handshakes/%02X%02X%02X%02X%02X%02X.txt",
-                 hs.bssid[0], hs.bssid[1], hs.bssid[2], hs.bssid[3], hs.bssid[4], hs.bssid[5]);
-        File txtFile = SD.open(txtFilename, FILE_WRITE);
-        if (txtFile) {
-            txtFile.println(hs.ssid);
-            txtFile.close();
-        }
-        
-        // Also save PCAP (for WPA-SEC upload and wireshark analysis)
-        char pcapFilename[64];
-        snprintf(pcapFilename, sizeof(pcapFilename), "/handshakes/%02X%02X%02X%02X%02X%02X.pcap",
-            hs.bssid[0], hs.bssid[1], hs.bssid[2], hs.bssid[3], hs.bssid[4], hs.bssid[5]);
-        
-        File pcapFile = SD.open(pcapFilename, FILE_WRITE);
-        if (pcapFile) {
-            // Write PCAP global header
-            DNH_PCAPHeader hdr = {
-                .magic = 0xA1B2C3D4,
-                .version_major = 2,
-                .version_minor = 4,
-                .thiszone = 0,
-                .sigfigs = 0,
-                .snaplen = 65535,
-                .linktype = 127  // IEEE802_11_RADIOTAP
-            };
-            pcapFile.write((uint8_t*)&hdr, sizeof(hdr));
-            
-            int packetCount = 0;
-            
-            // Write beacon if available
-            if (hs.hasBeacon()) {
-                uint32_t beaconTotalLen = sizeof(DNH_RADIOTAP_HEADER) + hs.beaconLen;
-                DNH_PCAPPacketHeader beaconPkt = {
-                    .ts_sec = hs.firstSeen / 1000,
-                    .ts_usec = (hs.firstSeen % 1000) * 1000,
-                    .incl_len = beaconTotalLen,
-                    .orig_len = beaconTotalLen
-                };
-                pcapFile.write((uint8_t*)&beaconPkt, sizeof(beaconPkt));
-                pcapFile.write(DNH_RADIOTAP_HEADER, sizeof(DNH_RADIOTAP_HEADER));
-                pcapFile.write(hs.beaconData, hs.beaconLen);
-                packetCount++;
-            }
-            
-            // Write EAPOL frames
-            for (int i = 0; i < 4; i++) {
-                if (!(hs.capturedMask & (1 << i))) continue;
-                const EAPOLFrame& frame = hs.frames[i];
-                if (frame.len == 0) continue;
-                
-                // Prefer fullFrame if available
-                if (frame.fullFrameLen > 0 && frame.fullFrameLen <= 300) {
-                    uint32_t totalLen = sizeof(DNH_RADIOTAP_HEADER) + frame.fullFrameLen;
-                    DNH_PCAPPacketHeader pkt = {
-                        .ts_sec = frame.timestamp / 1000,
-                        .ts_usec = (frame.timestamp % 1000) * 1000,
-                        .incl_len = totalLen,
-                        .orig_len = totalLen
-                    };
-                    pcapFile.write((uint8_t*)&pkt, sizeof(pkt));
-                    pcapFile.write(DNH_RADIOTAP_HEADER, sizeof(DNH_RADIOTAP_HEADER));
-                    pcapFile.write(frame.fullFrame, frame.fullFrameLen);
-                    packetCount++;
-                }
-            }
-            
-            pcapFile.close();
-            Serial.printf("[DNH] PCAP saved: %s (%d packets)\n", pcapFilename, packetCount);
-        }
-        
-        hs.saved = true;
-        Serial.printf("[DNH] Handshake saved: %s\\n", filename);
-        SDLog::log("DNH", "Handshake saved: %s (%s)", hs.ssid, filename);
-    }
-}
-
-int DoNoHamMode::findNetwork(const uint8_t* bssid) {
-    for (size_t i = 0; i < networks.size(); i++) {
-        if (memcmp(networks[i].bssid, bssid, 6) == 0) {
-            return i;
-        }
-    }
-    return -1;
-}
-
-int DoNoHamMode::findOrCreatePMKID(const uint8_t* bssid) {
-    // Find existing
-    for (size_t i = 0; i < pmkids.size(); i++) {
-        if (memcmp(pmkids[i].bssid, bssid, 6) == 0) {
-            return i;
-        }
-    }
-    // Create new
-    if (pmkids.size() < DNH_MAX_PMKIDS) {
-        CapturedPMKID p = {};
-        memcpy(p.bssid, bssid, 6);
-        pmkids.push_back(p);
-        return pmkids.size() - 1;
-    }
-    return -1;
-}
-
-int DoNoHamMode::findOrCreateHandshake(const uint8_t* bssid, const uint8_t* station) {
-    // Find existing with matching BSSID and station
-    for (size_t i = 0; i < handshakes.size(); i++) {
-        if (memcmp(handshakes[i].bssid, bssid, 6) == 0 &&
-            memcmp(handshakes[i].station, station, 6) == 0) {
-            return i;
-        }
-    }
-    // Create new
-    if (handshakes.size() < DNH_MAX_HANDSHAKES) {
-        CapturedHandshake hs = {};
-        memcpy(hs.bssid, bssid, 6);
-        memcpy(hs.station, station, 6);
-        hs.capturedMask = 0;
-        hs.firstSeen = millis();
-        hs.lastSeen = hs.firstSeen;
-        hs.saved = false;
-        hs.beaconData = nullptr;
-        hs.beaconLen = 0;
-        handshakes.push_back(hs);
-        return handshakes.size() - 1;
+// Frame handlers - called from update() while draining the frame ring
+bool DoNoHamMode::handleBeacon(const uint8_t* frame, uint16_t len, int8_t rssi, uint8_t channel) {
+    if (len < 40) {
+        CAPTURE_DROP(MALFORMED);
+        return false;
     }
-    return -1;
-}
-
-// Frame handlers - called from shared promiscuous callback
-void DoNoHamMode::handleBeacon(const uint8_t* frame, uint16_t len, int8_t rssi) {
-    if (!running) return;
-    if (dnhBusy) return;  // Skip if update() is processing vectors
-    
-    // Beacon frame structure:
-    // [0-1] Frame Control, [2-3] Duration, [4-9] DA, [10-15] SA (BSSID), [16-21] BSSID
-    // [22-23] Seq, [24-35] Timestamp, [36-37] Beacon Interval, [38-39] Capability
-    // [40+] IEs
-    
-    if (len < 40) return;
     
-    const uint8_t* bssid = frame + 16;
+    // Single pass over the IEs (tagged parameters start at 36, after
+    // timestamp + beacon interval + capability)
+    MgmtFrameView beacon;
+    if (!beacon.parse(frame, len)) return false;
     
-    // Parse SSID from IE 0
-    char ssid[33] = {0};
-    uint16_t offset = 36;  // Start of fixed fields after header
-    offset += 12;  // Skip timestamp(8) + beacon_interval(2) + capability(2)
+    const uint8_t* bssid = beacon.bssid();
     
-    while (offset + 2 < len) {
-        uint8_t ieType = frame[offset];
-        uint8_t ieLen = frame[offset + 1];
-        if (offset + 2 + ieLen > len) break;
-        
-        if (ieType == 0 && ieLen > 0 && ieLen <= 32) {
-            memcpy(ssid, frame + offset + 2, ieLen);
-            ssid[ieLen] = 0;
-            break;
-        }
-        offset += 2 + ieLen;
-    }
-    
-    // Check if this resolves a pending PMKID dwell
-    if (state == DNHState::DWELLING && ssid[0] != 0) {
-        if (memcmp(bssid, pendingPMKIDCreate.bssid, 6) == 0) {
-            strncpy(pendingPMKIDCreate.ssid, ssid, 32);
-            pendingPMKIDCreate.ssid[32] = 0;
-            dwellResolved = true;
-            Serial.printf("[DNH] Dwell resolved: %s\n", ssid);
+    // Add or refresh the network (full record: OINK targets from the same table)
+    DetectedNetwork seen;
+    CaptureStore::networkFromBeacon(beacon, rssi, channel, seen);
+    int netIdx = CaptureStore::findNetwork(bssid);
+    if (netIdx >= 0) {
+        bool hadSSID = networks[netIdx].ssid[0] != 0;
+        CaptureStore::refreshNetwork(netIdx, seen);
+        if (!hadSSID && networks[netIdx].ssid[0] != 0) {
+            Serial.printf("[DNH] SSID backfilled for existing network: %s\n", networks[netIdx].ssid);
         }
+    } else if (CaptureStore::addNetwork(seen) >= 0) {
+        XP::addXP(XPEvent::DNH_NETWORK_PASSIVE);
     }
     
-    // Queue network for deferred add
-    if (!pendingNetworkAdd) {
-        memset(&pendingNetwork, 0, sizeof(pendingNetwork));
-        memcpy(pendingNetwork.bssid, bssid, 6);
-        strncpy(pendingNetwork.ssid, ssid, 32);
-        pendingNetwork.ssid[32] = 0;
-        pendingNetwork.rssi = rssi;
-        pendingNetwork.channel = currentChannel;
-        pendingNetwork.lastSeen = millis();
-        pendingNetwork.beaconCount = 1;
-        pendingNetworkAdd = true;
-    }
-    
-    // Store beacon for any in-progress handshakes from this BSSID
-    // (needed for PCAP export / WPA-SEC upload)
-    for (auto& hs : handshakes) {
-        if (!hs.saved && hs.beaconData == nullptr && memcmp(hs.bssid, bssid, 6) == 0) {
-            // Allocate and copy beacon data
-            uint16_t copyLen = (len > 512) ? 512 : len;  // Cap at reasonable size
-            hs.beaconData = (uint8_t*)malloc(copyLen);
-            if (hs.beaconData) {
-                memcpy(hs.beaconData, frame, copyLen);
-                hs.beaconLen = copyLen;
-                Serial.printf("[DNH] Beacon stored for handshake: %02X:%02X:%02X:%02X:%02X:%02X\n",
-                    bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5]);
-            }
-            break;  // One beacon per handshake is enough
-        }
+    // The add/refresh backfilled the SSID into a PMKID we dwelled for
+    if (state == DNHState::DWELLING && !dwellResolved && seen.ssid[0] != 0 &&
+        memcmp(bssid, dwellBssid, 6) == 0) {
+        dwellResolved = true;
+        Serial.printf("[DNH] Dwell resolved: %s\n", seen.ssid);
+        strncpy(pendingPMKIDSSID, seen.ssid, 32);
+        pendingPMKIDSSID[32] = 0;
+        pendingPMKIDCapture = true;
     }
     
     // Track channel activity for adaptive hopping
-    int idx = currentChannel - 1;
+    int idx = channel - 1;
     if (idx >= 0 && idx < 13) {
         channelStats[idx].beaconCount++;
         channelStats[idx].lifetimeBeacons++;
         channelStats[idx].lastActivity = millis();
     }
+    
+    // Cache a beacon for in-progress handshakes from this BSSID
+    // (needed for PCAP export / WPA-SEC upload)
+    if (beaconCache.wants(bssid) && beaconCache.put(frame, len)) {
+        Serial.printf("[DNH] Beacon stored for handshake: %02X:%02X:%02X:%02X:%02X:%02X\n",
+            bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5]);
+        return CaptureStore::holding();
+    }
+    return false;
 }
 
-void DoNoHamMode::handleEAPOL(const uint8_t* frame, uint16_t len, int8_t rssi) {
-    if (!running) return;
-    if (dnhBusy) return;  // Skip if update() is processing vectors
-    
+void DoNoHamMode::handleEAPOL(const uint8_t* frame, uint16_t len, int8_t rssi, uint8_t channel) {
     // Parse 802.11 data frame to find EAPOL
     // Frame: FC(2) + Duration(2) + Addr1(6) + Addr2(6) + Addr3(6) + Seq(2) = 24 bytes
     // Then QoS(2) if present, then LLC/SNAP(8), then EAPOL payload
@@ -1209,23 +602,11 @@ void DoNoHamMode::handleEAPOL(const uint8_t* frame, uint16_t len, int8_t rssi) {
     // Extract MACs based on To/From DS
     const uint8_t* srcMac;
     const uint8_t* dstMac;
-    const uint8_t* bssid;
     
-    if (toDs && !fromDs) {
-        // To DS: RA=BSSID, TA=SA
-        dstMac = frame + 4;
-        srcMac = frame + 10;
-        bssid = frame + 4;
-    } else if (!toDs && fromDs) {
-        // From DS: RA=DA, TA=BSSID
+    if (!(toDs && fromDs)) {
+        // To DS, From DS, IBSS: RA and TA; the message number says which is the AP
         dstMac = frame + 4;
         srcMac = frame + 10;
-        bssid = frame + 10;
-    } else if (!toDs && !fromDs) {
-        // IBSS or Direct Link
-        dstMac = frame + 4;
-        srcMac = frame + 10;
-        bssid = frame + 16;
     } else {
         // WDS (both set) - skip
         return;
@@ -1318,29 +699,27 @@ void DoNoHamMode::handleEAPOL(const uint8_t* frame, uint16_t len, int8_t rssi) {
                             break;
                         }
                         
-                        // Queue PMKID for creation in main thread
-                        if (!pendingPMKIDCreateBusy && !pendingPMKIDCreateReady) {
-                            memcpy(pendingPMKIDCreate.bssid, apBssid, 6);
-                            memcpy(pendingPMKIDCreate.station, station, 6);
-                            memcpy(pendingPMKIDCreate.pmkid, pmkidData, 16);
+                        int pIdx = CaptureStore::findOrCreatePMKID(apBssid, station);
+                        if (pIdx >= 0 && !pmkids[pIdx].saved) {
+                            memcpy(pmkids[pIdx].pmkid, pmkidData, 16);
+                            pmkids[pIdx].timestamp = millis();
                             
                             // Try to get SSID from known networks
-                            int netIdx = findNetwork(apBssid);
+                            int netIdx = CaptureStore::findNetwork(apBssid);
                             if (netIdx >= 0 && networks[netIdx].ssid[0] != 0) {
-                                strncpy(pendingPMKIDCreate.ssid, networks[netIdx].ssid, 32);
-                                pendingPMKIDCreate.ssid[32] = 0;
-                            } else {
-                                // No SSID - trigger dwell to catch beacon
-                                pendingPMKIDCreate.ssid[0] = 0;
-                                state = DNHState::DWELLING;
-                                dwellStartTime = millis();
-                                dwellResolved = false;
-                                Serial.println("[DNH] PMKID needs SSID - dwelling for beacon");
+                                strncpy(pmkids[pIdx].ssid, networks[netIdx].ssid, 32);
+                                pmkids[pIdx].ssid[32] = 0;
                             }
                             
-                            pendingPMKIDCreateReady = true;
-                            Serial.printf("[DNH] PMKID queued from %02X:%02X:%02X:%02X:%02X:%02X\n",
-                                apBssid[0], apBssid[1], apBssid[2], apBssid[3], apBssid[4], apBssid[5]);
+                            if (pmkids[pIdx].ssid[0] != 0) {
+                                strncpy(pendingPMKIDSSID, pmkids[pIdx].ssid, 32);
+                                pendingPMKIDSSID[32] = 0;
+                                pendingPMKIDCapture = true;
+                            } else if (state != DNHState::DWELLING) {
+                                // No SSID - dwell to catch beacon; handleBeacon announces it
+                                memcpy(dwellBssid, apBssid, 6);
+                                startDwell();
+                            }
                         }
                         break;  // Found PMKID, stop searching
                     }
@@ -1350,50 +729,33 @@ void DoNoHamMode::handleEAPOL(const uint8_t* frame, uint16_t len, int8_t rssi) {
     }
     
     // ========== HANDSHAKE FRAME CAPTURE (M1-M4) ==========
-    // Queue frame for deferred processing (natural client reconnects)
-    // Batch accumulate if frames arrive in quick succession
-    if (!pendingHandshakeBusy) {
-        // Check if slot already has a frame for this handshake
-        bool sameHandshake = pendingHandshakeAdd &&
-                             memcmp(pendingHandshake.bssid, apBssid, 6) == 0 &&
-                             memcmp(pendingHandshake.station, station, 6) == 0;
+    // Natural client reconnects; saved handshakes already gave their
+    // frames back to the pool
+    int hsIdx = CaptureStore::findOrCreateHandshake(apBssid, station);
+    if (hsIdx >= 0 && !handshakes[hsIdx].saved &&
+        !(handshakes[hsIdx].capturedMask & (1 << (messageNum - 1)))) {
+        CapturedHandshake& hs = handshakes[hsIdx];
+        uint16_t copyLen = min(EAPOL_MAX_FRAME_LEN, len);
+        if (CaptureStore::addFrame(hsIdx, messageNum, frame, copyLen, (uint16_t)(eapol - frame), rssi)) {
+            Serial.printf("[DNH] M%d captured from %02X:%02X:%02X:%02X:%02X:%02X\n",
+                messageNum, apBssid[0], apBssid[1], apBssid[2], apBssid[3], apBssid[4], apBssid[5]);
+        } else {
+            Serial.printf("[DNH] EAPOL pool full, M%d dropped\n", messageNum);
+        }
         
-        if (!pendingHandshakeAdd || sameHandshake) {
-            // Either slot is free, or it's for the same handshake (update it)
-            if (!pendingHandshakeAdd) {
-                // First frame for this handshake - init the slot
-                memcpy(pendingHandshake.bssid, apBssid, 6);
-                memcpy(pendingHandshake.station, station, 6);
-                pendingHandshake.messageNum = messageNum;  // DEPRECATED
-                pendingHandshake.capturedMask = 0;
-            }
-            
-            // Store this frame in the appropriate slot (M1-M4 → index 0-3)
-            uint8_t frameIdx = messageNum - 1;
-            if (frameIdx < 4) {
-                // EAPOL payload for hashcat 22000
-                uint16_t copyLen = min((uint16_t)512, eapolLen);
-                memcpy(pendingHandshake.frames[frameIdx].data, eapol, copyLen);
-                pendingHandshake.frames[frameIdx].len = copyLen;
-                
-                // Full 802.11 frame for PCAP export (radiotap + WPA-SEC compatibility)
-                uint16_t fullCopyLen = min((uint16_t)300, len);
-                memcpy(pendingHandshake.frames[frameIdx].fullFrame, frame, fullCopyLen);
-                pendingHandshake.frames[frameIdx].fullFrameLen = fullCopyLen;
-                pendingHandshake.frames[frameIdx].rssi = rssi;
-                
-                pendingHandshake.capturedMask |= (1 << frameIdx);
-            }
+        // Check if we just completed a valid pair
+        if (hs.hasValidPair() && !pendingHandshakeCapture) {
+            strncpy(pendingHandshakeSSID, hs.ssid, 32);
+            pendingHandshakeSSID[32] = 0;
+            pendingHandshakeCapture = true;
             
-            pendingHandshakeAdd = true;
-            Serial.printf("[DNH] EAPOL M%d queued from %02X:%02X:%02X:%02X:%02X:%02X\n",
-                messageNum, apBssid[0], apBssid[1], apBssid[2], apBssid[3], apBssid[4], apBssid[5]);
+            Serial.printf("[DNH] Handshake complete: %s\n", 
+                hs.ssid[0] ? hs.ssid : "?");
         }
-        // else: slot full with different handshake, drop this frame (rare race)
     }
     
     // Track channel activity for adaptive hopping
-    int idx = currentChannel - 1;
+    int idx = channel - 1;
     if (idx >= 0 && idx < 13) {
         channelStats[idx].eapolCount++;
         channelStats[idx].lastActivity = millis();
@@ -1401,5 +763,5 @@ void DoNoHamMode::handleEAPOL(const uint8_t* frame, uint16_t len, int8_t rssi) {
     
     // Track incomplete handshakes for future hunting
     uint8_t captureMask = (1 << (messageNum - 1));
-    trackIncompleteHandshake(apBssid, captureMask, currentChannel);
+    trackIncompleteHandshake(apBssid, captureMask, channel);
 }
@@ -5,12 +5,13 @@
 #include <Arduino.h>
 #include <esp_wifi.h>
 #include <vector>
-#include "oink.h"  // Reuse DetectedNetwork, CapturedPMKID, CapturedHandshake
+#include "oink.h"
+#include "../core/capture_store.h"  // Tables shared with OINK
 
 // DNH-specific constants
-static const size_t DNH_MAX_NETWORKS = 100;
-static const size_t DNH_MAX_PMKIDS = 50;
-static const size_t DNH_MAX_HANDSHAKES = 25;
+// Table limits are CaptureStore's (one budget for OINK and DNH)
+static const size_t DNH_DRAIN_BATCH = 32;         // Ring frames per drain() call
+static const size_t DNH_DRAIN_MAX = 256;          // Per update() - keeps UI responsive
 static const uint32_t DNH_STALE_TIMEOUT = 30000;  // 30s
 static const uint16_t DNH_HOP_INTERVAL = 200;     // Legacy default (now adaptive)
 static const uint16_t DNH_DWELL_TIME = 300;       // 300ms dwell for SSID
@@ -71,13 +72,11 @@ public:
     static uint8_t getCurrentChannel() { return currentChannel; }
     
     // Stats for display
-    static size_t getNetworkCount() { return networks.size(); }
-    static size_t getPMKIDCount() { return pmkids.size(); }
-    static size_t getHandshakeCount() { return handshakes.size(); }
-    
-    // Frame handlers (called from shared callback)
-    static void handleBeacon(const uint8_t* frame, uint16_t len, int8_t rssi);
-    static void handleEAPOL(const uint8_t* frame, uint16_t len, int8_t rssi);
+    static size_t getNetworkCount() { return CaptureStore::networks.size(); }
+    static size_t getPMKIDCount() { return CaptureStore::pmkids.size(); }
+    static size_t getHandshakeCount() { return CaptureStore::handshakes.size(); }
+    static EapolPoolStats getEapolPoolStats() { return CaptureStore::eapolPool.stats(); }
+    static BeaconCacheStats getBeaconCacheStats() { return CaptureStore::beaconCache.stats(); }
     
 private:
     static bool running;
@@ -88,11 +87,6 @@ private:
     static uint32_t dwellStartTime;
     static bool dwellResolved;
     
-    // Data storage (separate from OINK)
-    static std::vector<DetectedNetwork> networks;
-    static std::vector<CapturedPMKID> pmkids;
-    static std::vector<CapturedHandshake> handshakes;
-    
     // Adaptive state machine
     static ChannelStats channelStats[13];
     static std::vector<IncompleteHS> incompleteHandshakes;
@@ -113,13 +107,10 @@ private:
     static void trackIncompleteHandshake(const uint8_t* bssid, uint8_t mask, uint8_t ch);
     static void pruneIncompleteHandshakes();
     
+    // Frame handlers (called from update() while draining the frame ring)
+    static bool handleBeacon(const uint8_t* frame, uint16_t len, int8_t rssi, uint8_t channel);
+    static void handleEAPOL(const uint8_t* frame, uint16_t len, int8_t rssi, uint8_t channel);
+    
     // Cleanup
     static void ageOutStaleNetworks();
-    static void saveAllPMKIDs();
-    static void saveAllHandshakes();
-    
-    // Network lookup
-    static int findNetwork(const uint8_t* bssid);
-    static int findOrCreatePMKID(const uint8_t* bssid);
-    static int findOrCreateHandshake(const uint8_t* bssid, const uint8_t* station);
 };
@@ -6,6 +6,7 @@
 #include "../core/oui.h"
 #include "../core/wsl_bypasser.h"
 #include "../core/xp.h"
+#include "../ml/features.h"
 #include "../ui/display.h"
 #include <M5Cardputer.h>
 #include <WiFi.h>
@@ -43,6 +44,7 @@ const size_t MAX_SPECTRUM_NETWORKS = 100;  // Cap networks to prevent OOM
 bool SpectrumMode::running = false;
 volatile bool SpectrumMode::busy = false;
 std::vector<SpectrumNetwork> SpectrumMode::networks;
+BssidIndex<256, SpectrumNetwork> SpectrumMode::networkIndex(SpectrumMode::networks);
 float SpectrumMode::viewCenterMHz = DEFAULT_CENTER_MHZ;
 float SpectrumMode::viewWidthMHz = DEFAULT_WIDTH_MHZ;
 int SpectrumMode::selectedIndex = -1;
@@ -63,6 +65,7 @@ int SpectrumMode::clientScrollOffset = 0;
 int SpectrumMode::selectedClientIndex = 0;
 uint32_t SpectrumMode::lastClientPrune = 0;
 uint8_t SpectrumMode::clientsDiscoveredThisSession = 0;
+char SpectrumMode::clientVendors[MAX_SPECTRUM_CLIENTS][OUI::NAME_LEN + 1] = {{0}};
 volatile bool SpectrumMode::pendingClientBeep = false;
 volatile uint8_t SpectrumMode::pendingNetworkXP = 0;  // Deferred XP for new networks (avoids callback crash)
 
@@ -76,8 +79,10 @@ bool SpectrumMode::clientDetailActive = false;
 uint8_t SpectrumMode::detailClientMAC[6] = {0};  // MAC of client being viewed
 
 void SpectrumMode::init() {
+    static_assert(MAX_SPECTRUM_NETWORKS <= decltype(networkIndex)::capacity(), "networkIndex too small for MAX_SPECTRUM_NETWORKS");
     networks.clear();
     networks.shrink_to_fit();  // Release vector capacity
+    networkIndex.clear();
     viewCenterMHz = DEFAULT_CENTER_MHZ;
     viewWidthMHz = DEFAULT_WIDTH_MHZ;
     selectedIndex = -1;
@@ -241,6 +246,11 @@ void SpectrumMode::update() {
         pruneStaleClients();
     }
     
+    // Callback can't read the card: look up new clients' vendors here
+    if (monitoringNetwork && OUI::hasRegistry()) {
+        resolveClientVendors();
+    }
+    
     // N13TZSCH3 achievement - stare into the ether for 15 minutes
     if (startTime > 0 && (now - startTime) >= 15 * 60 * 1000) {
         if (!XP::hasAchievement(ACH_NIETZSWINE)) {
@@ -793,6 +803,7 @@ void SpectrumMode::pruneStale() {
             }),
         networks.end()
     );
+    networkIndex.rebuild();  // Erase shifted positions
     
     // Restore selection by finding BSSID in new vector
     if (hadSelection) {
@@ -818,33 +829,33 @@ void SpectrumMode::onBeacon(const uint8_t* bssid, uint8_t channel, int8_t rssi,
     bool hasSSID = (ssid && ssid[0] != 0);
     
     // Look for existing network
-    for (auto& net : networks) {
-        if (memcmp(net.bssid, bssid, 6) == 0) {
-            // Update existing
-            net.rssi = rssi;
-            net.lastSeen = millis();
-            net.authmode = authmode;  // Update auth mode
-            net.hasPMF = hasPMF;      // Update PMF status
-            
-            // Probe response can reveal hidden SSID
-            if (hasSSID && net.isHidden && net.ssid[0] == 0) {
-                strncpy(net.ssid, ssid, 32);
-                net.ssid[32] = 0;
-                net.wasRevealed = true;
-                // Defer logging to main thread (avoid Serial in WiFi callback)
-                if (!pendingReveal) {
-                    strncpy(pendingRevealSSID, ssid, 32);
-                    pendingRevealSSID[32] = 0;
-                    pendingReveal = true;
-                }
-            }
-            // Also update if we had no SSID before
-            else if (hasSSID && net.ssid[0] == 0) {
-                strncpy(net.ssid, ssid, 32);
-                net.ssid[32] = 0;
+    int idx = networkIndex.find(bssid);
+    if (idx >= 0) {
+        SpectrumNetwork& net = networks[idx];
+        // Update existing
+        net.rssi = rssi;
+        net.lastSeen = millis();
+        net.authmode = authmode;  // Update auth mode
+        net.hasPMF = hasPMF;      // Update PMF status
+        
+        // Probe response can reveal hidden SSID
+        if (hasSSID && net.isHidden && net.ssid[0] == 0) {
+            strncpy(net.ssid, ssid, 32);
+            net.ssid[32] = 0;
+            net.wasRevealed = true;
+            // Defer logging to main thread (avoid Serial in WiFi callback)
+            if (!pendingReveal) {
+                strncpy(pendingRevealSSID, ssid, 32);
+                pendingRevealSSID[32] = 0;
+                pendingReveal = true;
             }
-            return;
         }
+        // Also update if we had no SSID before
+        else if (hasSSID && net.ssid[0] == 0) {
+            strncpy(net.ssid, ssid, 32);
+            net.ssid[32] = 0;
+        }
+        return;
     }
     
     // Add new network (limit to prevent OOM)
@@ -873,6 +884,7 @@ void SpectrumMode::onBeacon(const uint8_t* bssid, uint8_t channel, int8_t rssi,
     }
     
     networks.push_back(net);
+    networkIndex.add(networks.size() - 1);
     
     // Defer XP to main loop (onBeacon runs in WiFi callback - can't call Display::showLevelUp)
     // If pendingNetworkXP overflows (255), we just miss some +1 XP - acceptable
@@ -952,72 +964,24 @@ void SpectrumMode::promiscuousCallback(void* buf, wifi_promiscuous_pkt_type_t ty
     
     if (type != WIFI_PKT_MGMT) return;
     
-    if (len < 36) return;
-    
     // Check frame type - beacon (0x80) or probe response (0x50)
+    if (len < 1) return;
     uint8_t frameType = payload[0];
     if (frameType != 0x80 && frameType != 0x50) return;
     
     bool isProbeResponse = (frameType == 0x50);
     
-    // BSSID is at offset 16
-    const uint8_t* bssid = payload + 16;
-    
-    // Parse SSID from tagged parameters (starts at offset 36)
-    char ssid[33] = {0};
-    uint16_t offset = 36;
-    
-    while (offset + 2 < len) {
-        uint8_t tagNum = payload[offset];
-        uint8_t tagLen = payload[offset + 1];
-        
-        if (offset + 2 + tagLen > len) break;
-        
-        if (tagNum == 0 && tagLen <= 32) {  // SSID tag
-            memcpy(ssid, payload + offset + 2, tagLen);
-            ssid[tagLen] = 0;
-            break;
-        }
-        
-        offset += 2 + tagLen;
-    }
-    
-    // Parse auth mode from RSN (0x30) and WPA (0xDD) IEs
-    wifi_auth_mode_t authmode = WIFI_AUTH_OPEN;  // Default to open
-    bool hasRSN = false;
-    offset = 36;
-    while (offset + 2 < len) {
-        uint8_t tagNum = payload[offset];
-        uint8_t tagLen = payload[offset + 1];
-        
-        if (offset + 2 + tagLen > len) break;
-        
-        if (tagNum == 0x30 && tagLen >= 2) {  // RSN IE = WPA2/WPA3
-            hasRSN = true;
-            authmode = WIFI_AUTH_WPA2_PSK;
-        } else if (tagNum == 0xDD && tagLen >= 8) {  // Vendor specific
-            // Check for WPA1 OUI: 00:50:F2:01
-            if (payload[offset + 2] == 0x00 && payload[offset + 3] == 0x50 &&
-                payload[offset + 4] == 0xF2 && payload[offset + 5] == 0x01) {
-                // WPA1 - only set if not already WPA2
-                if (!hasRSN) {
-                    authmode = WIFI_AUTH_WPA_PSK;
-                } else {
-                    authmode = WIFI_AUTH_WPA_WPA2_PSK;
-                }
-            }
-        }
-        
-        offset += 2 + tagLen;
-    }
+    // One pass over the tagged parameters
+    MgmtFrameView beacon;
+    if (!beacon.parse(payload, len)) return;
     
-    // Detect PMF (Protected Management Frames)
-    bool hasPMF = detectPMF(payload, len);
+    const uint8_t* bssid = beacon.bssid();
+    char ssid[33];
+    beacon.copySSID(ssid);
     
-    // If PMF is required and we have RSN, it's WPA3 (or WPA2/3 transitional)
-    if (hasPMF && authmode == WIFI_AUTH_WPA2_PSK) {
-        authmode = WIFI_AUTH_WPA3_PSK;
-    }
+    // PMF required = deauth immune; RSN + PMF required is reported as WPA3
+    bool hasPMF = beacon.pmfRequired;
+    wifi_auth_mode_t authmode = FeatureExtractor::authModeFromBeacon(beacon);
     
     // Update spectrum data
     onBeacon(bssid, channel, rssi, ssid, authmode, hasPMF, isProbeResponse);
@@ -1050,53 +1014,6 @@ const char* SpectrumMode::authModeToShortString(wifi_auth_mode_t mode) {
     }
 }
 
-// Detect PMF (Protected Management Frames) from RSN IE
-// Networks with PMF required (MFPR=1) are immune to deauth attacks
-bool SpectrumMode::detectPMF(const uint8_t* payload, uint16_t len) {
-    uint16_t offset = 36;  // After fixed beacon fields
-    
-    while (offset + 2 < len) {
-        uint8_t tag = payload[offset];
-        uint8_t tagLen = payload[offset + 1];
-        
-        if (offset + 2 + tagLen > len) break;
-        
-        if (tag == 0x30 && tagLen >= 8) {  // RSN IE
-            // RSN IE structure: version(2) + group cipher(4) + pairwise count(2) + ...
-            uint16_t rsnOffset = offset + 2;
-            uint16_t rsnEnd = rsnOffset + tagLen;
-            
-            // Skip version (2), group cipher (4)
-            rsnOffset += 6;
-            if (rsnOffset + 2 > rsnEnd) break;
-            
-            // Pairwise cipher count and suites
-            uint16_t pairwiseCount = payload[rsnOffset] | (payload[rsnOffset + 1] << 8);
-            rsnOffset += 2 + (pairwiseCount * 4);
-            if (rsnOffset + 2 > rsnEnd) break;
-            
-            // AKM count and suites
-            uint16_t akmCount = payload[rsnOffset] | (payload[rsnOffset + 1] << 8);
-            rsnOffset += 2 + (akmCount * 4);
-            if (rsnOffset + 2 > rsnEnd) break;
-            
-            // RSN Capabilities (2 bytes)
-            uint16_t rsnCaps = payload[rsnOffset] | (payload[rsnOffset + 1] << 8);
-            
-            // Bit 7: MFPR (Management Frame Protection Required)
-            bool mfpr = (rsnCaps >> 7) & 0x01;
-            
-            if (mfpr) {
-                return true;  // PMF required - deauth won't work
-            }
-        }
-        
-        offset += 2 + tagLen;
-    }
-    
-    return false;
-}
-
 // Process data frame to extract client MAC
 void SpectrumMode::processDataFrame(const uint8_t* payload, uint16_t len, int8_t rssi) {
     if (len < 24) return;  // Too short for valid data frame
@@ -1168,7 +1085,8 @@ void SpectrumMode::trackClient(const uint8_t* bssid, const uint8_t* clientMac, i
         memcpy(newClient.mac, clientMac, 6);
         newClient.rssi = rssi;
         newClient.lastSeen = now;
-        newClient.vendor = OUI::getVendor(clientMac);  // Cache once
+        newClient.vendor = OUI::getVendor(clientMac);  // Cache once (built-in table, no SD)
+        newClient.vendorResolved = false;
         net.clientCount++;
         
         // Request beep for first few clients (avoid spamming)
@@ -1258,6 +1176,71 @@ void SpectrumMode::exitClientMonitor() {
     // Channel hopping resumes automatically in next update()
 }
 
+// Card vendor lookups for new clients [P1]: MACs copied out under busy,
+// SD reads with the callback running, names written back under busy by MAC
+void SpectrumMode::resolveClientVendors() {
+    uint8_t macs[MAX_SPECTRUM_CLIENTS][6];
+    int pending = 0;
+    
+    busy = true;
+    if (monitoredNetworkIndex < 0 || monitoredNetworkIndex >= (int)networks.size()) {
+        busy = false;
+        return;
+    }
+    SpectrumNetwork& net = networks[monitoredNetworkIndex];
+    for (int i = 0; i < net.clientCount; i++) {
+        SpectrumClient& client = net.clients[i];
+        if (client.vendorResolved) continue;
+        if (strcmp(client.vendor, "UNKNOWN") != 0) {
+            client.vendorResolved = true;  // Built-in table already knew it
+            continue;
+        }
+        memcpy(macs[pending++], client.mac, 6);
+    }
+    busy = false;
+    if (pending == 0) return;
+    
+    char vendors[MAX_SPECTRUM_CLIENTS][OUI::NAME_LEN + 1];
+    bool found[MAX_SPECTRUM_CLIENTS];
+    for (int k = 0; k < pending; k++) {
+        found[k] = OUI::lookup(macs[k], vendors[k], sizeof(vendors[k]));
+    }
+    
+    busy = true;
+    // [P3] The monitored network may have changed during the reads
+    if (monitoredNetworkIndex < 0 || monitoredNetworkIndex >= (int)networks.size()) {
+        busy = false;
+        return;
+    }
+    SpectrumNetwork& after = networks[monitoredNetworkIndex];
+    for (int k = 0; k < pending; k++) {
+        for (int i = 0; i < after.clientCount; i++) {
+            if (!macEqual(after.clients[i].mac, macs[k])) continue;
+            if (found[k]) after.clients[i].vendor = keepVendor(after, vendors[k]);
+            after.clients[i].vendorResolved = true;
+            break;
+        }
+    }
+    busy = false;
+}
+
+// Copy a card vendor name into a clientVendors slot no client of net
+// points at. Clients hold the slot until pruned; there are as many slots
+// as clients, and the one being named doesn't hold one yet.
+const char* SpectrumMode::keepVendor(const SpectrumNetwork& net, const char* name) {
+    for (int slot = 0; slot < MAX_SPECTRUM_CLIENTS; slot++) {
+        bool taken = false;
+        for (int i = 0; i < net.clientCount && !taken; i++) {
+            taken = net.clients[i].vendor == clientVendors[slot];
+        }
+        if (taken) continue;
+        strncpy(clientVendors[slot], name, OUI::NAME_LEN);
+        clientVendors[slot][OUI::NAME_LEN] = '\0';
+        return clientVendors[slot];
+    }
+    return "UNKNOWN";
+}
+
 // Prune stale clients [P1] [P3] [P10]
 void SpectrumMode::pruneStaleClients() {
     busy = true;  // [P1] Block callback
@@ -1344,6 +1327,13 @@ void SpectrumMode::deauthClient(int idx) {
     const SpectrumNetwork& net = networks[monitoredNetworkIndex];
     const SpectrumClient& client = net.clients[idx];
     
+    // BOAR BROS are out of scope here too (same list OINK and DNH honour)
+    if (OinkMode::isExcluded(net.bssid)) {
+        busy = false;
+        Display::showToast("BOAR BRO - NO DEAUTH");
+        return;
+    }
+    
     // Send deauth burst (5 frames with jitter)
     int sent = 0;
     for (int i = 0; i < 5; i++) {
@@ -5,6 +5,8 @@
 #include <M5Unified.h>
 #include <vector>
 #include <esp_wifi_types.h>
+#include "../core/bssid_index.h"
+#include "../core/oui.h"
 
 // Client monitoring constants
 #define MAX_SPECTRUM_CLIENTS 8
@@ -18,7 +20,8 @@ struct SpectrumClient {
     uint8_t mac[6];
     int8_t rssi;
     uint32_t lastSeen;
-    const char* vendor;  // Cached OUI lookup
+    const char* vendor;  // Built-in OUI name, or a SpectrumMode::clientVendors slot
+    bool vendorResolved; // SD vendor database consulted (main loop)
 };
 
 struct SpectrumNetwork {
@@ -66,6 +69,7 @@ private:
     static bool running;
     static volatile bool busy;       // Guard against callback race
     static std::vector<SpectrumNetwork> networks;
+    static BssidIndex<256, SpectrumNetwork> networkIndex;  // networks by BSSID (callback lookup)
     static float viewCenterMHz;      // Center of visible spectrum
     static float viewWidthMHz;       // Visible bandwidth
     static int selectedIndex;        // Currently highlighted network
@@ -88,6 +92,7 @@ private:
     static int selectedClientIndex;      // Currently highlighted client
     static uint32_t lastClientPrune;     // Last stale client cleanup
     static uint8_t clientsDiscoveredThisSession;  // For limiting beeps
+    static char clientVendors[MAX_SPECTRUM_CLIENTS][OUI::NAME_LEN + 1];  // SD names, one per client at most
     static volatile bool pendingClientBeep;       // Deferred beep for new client
     static volatile uint8_t pendingNetworkXP;     // Deferred XP for new networks (avoids callback crash)
     
@@ -110,6 +115,8 @@ private:
     static void drawChannelMarkers(M5Canvas& canvas);
     static void pruneStale();            // Remove networks not seen recently
     static void pruneStaleClients();     // Remove clients not seen recently
+    static void resolveClientVendors();  // Name UNKNOWN clients from the SD database
+    static const char* keepVendor(const SpectrumNetwork& net, const char* name);
     
     // Client monitoring control
     static void enterClientMonitor();    // Enter overlay mode
@@ -128,7 +135,6 @@ private:
     // Security helpers
     static bool isVulnerable(wifi_auth_mode_t mode);
     static const char* authModeToShortString(wifi_auth_mode_t mode);
-    static bool detectPMF(const uint8_t* payload, uint16_t len);
     
     // Promiscuous mode
     static void promiscuousCallback(void* buf, wifi_promiscuous_pkt_type_t type);
@@ -4,13 +4,14 @@
 // - No entries[] vector - data goes directly to disk
 // - No "waiting for GPS" state - either GPS or ML-only
 // - Simpler memory management - just seenBSSIDs for duplicate detection
-// - Per-network file writes instead of batch saves
+// - Per-network lines into open, buffered session files
 
 #include "warhog.h"
 #include "../build_info.h"
 #include "../core/config.h"
 #include "../core/wsl_bypasser.h"
 #include "../core/sdlog.h"
+#include "../core/buffered_writer.h"
 #include "../core/xp.h"
 #include "../ui/display.h"
 #include "../piglet/mood.h"
@@ -41,18 +42,49 @@ static const int SD_RETRY_DELAY_MS = 10;
 // Files larger than this will be rotated to a new file
 static const size_t WIGLE_FILE_MAX_SIZE = 400000;
 
+// Session files (CSV, WiGLE, ML): lines are collected per file and written
+// in bulk once this much is waiting, or once the oldest line has waited this
+// long (checked after every scan). Each drain opens, appends and closes its
+// file, so WARHOG holds no SD handle between drains and at most one during
+// one.
+static const size_t LOG_BUFFER_BYTES = 2048;
+static const size_t LOG_FLUSH_BYTES = 1024;
+static const uint32_t LOG_FLUSH_MS = 10000;
+
+static uint32_t logClockMicros() { return (uint32_t)micros(); }
+
+typedef BufferedWriter<fs::FS, File, LOG_BUFFER_BYTES> LogWriter;
+static LogWriter csvLog(logClockMicros);
+static LogWriter wigleLog(logClockMicros);
+static LogWriter mlLog(logClockMicros);
+static BufferedWriterStats logTotals = {};  // Files already closed this session
+
+static void addLogStats(BufferedWriterStats& total, const BufferedWriterStats& s) {
+    total.appended += s.appended;
+    total.written += s.written;
+    total.writes += s.writes;
+    total.opens += s.opens;
+    total.flushes += s.flushes;
+    total.errors += s.errors;
+    total.busyUs += s.busyUs;
+}
+
+static void closeLog(LogWriter& log) {
+    if (!log.isOpen()) return;
+    log.close();
+    addLogStats(logTotals, log.stats());
+}
+
 // Graceful stop request flag for background scan task
 static volatile bool stopRequested = false;
 
-// Helper: Open SD file with retry logic
-static File openFileWithRetry(const char* path, const char* mode) {
-    File f;
+// Helper: Create a session file with retry logic
+static bool beginLogWithRetry(LogWriter& log, const char* path) {
     for (int retry = 0; retry < SD_RETRY_COUNT; retry++) {
-        f = SD.open(path, mode);
-        if (f) return f;
+        if (log.begin(SD, path)) return true;
         delay(SD_RETRY_DELAY_MS);
     }
-    return f;  // Returns invalid File if all retries failed
+    return false;
 }
 
 // Haversine formula for GPS distance calculation
@@ -98,6 +130,7 @@ bool WarhogMode::enhancedMode = false;
 std::map<uint64_t, WiFiFeatures> WarhogMode::beaconFeatures;
 uint32_t WarhogMode::beaconCount = 0;
 volatile bool WarhogMode::beaconMapBusy = false;
+BeaconTimingTracker<128> WarhogMode::beaconTiming;
 
 // Background scan task statics
 TaskHandle_t WarhogMode::scanTaskHandle = NULL;
@@ -109,7 +142,7 @@ static inline bool shouldAbortScan() {
 }
 
 // Helper to write CSV-escaped SSID field (quoted, doubles internal quotes, strips control chars)
-static void writeCSVField(File& f, const char* ssid) {
+static void writeCSVField(LogWriter& f, const char* ssid) {
     f.print("\"");
     for (int i = 0; i < 32 && ssid[i]; i++) {
         if (ssid[i] == '"') {
@@ -138,6 +171,7 @@ void WarhogMode::init() {
     // Guard beacon map in case callback still registered from abnormal shutdown
     beaconMapBusy = true;
     beaconFeatures.clear();
+    beaconTiming.clear();
     beaconMapBusy = false;
     beaconCount = 0;
     
@@ -160,6 +194,10 @@ void WarhogMode::start() {
     wpaNetworks = 0;
     savedCount = 0;
     mlOnlyCount = 0;
+    closeLog(csvLog);
+    closeLog(wigleLog);
+    closeLog(mlLog);
+    memset(&logTotals, 0, sizeof(logTotals));
     currentFilename = "";
     currentMLFilename = "";
     currentWigleFilename = "";
@@ -167,6 +205,7 @@ void WarhogMode::start() {
     // Guard beacon map in case callback still registered from previous session
     beaconMapBusy = true;
     beaconFeatures.clear();
+    beaconTiming.clear();
     beaconMapBusy = false;
     beaconCount = 0;
     
@@ -266,6 +305,17 @@ void WarhogMode::stop() {
     Serial.printf("[WARHOG] Session complete - Total: %lu, Geotagged: %lu, ML-only: %lu\n",
                   totalNetworks, savedCount, mlOnlyCount);
     
+    // Write out whatever is still buffered and close the session files
+    closeLog(csvLog);
+    closeLog(wigleLog);
+    closeLog(mlLog);
+    if (logTotals.appended > 0) {
+        SDLOG("WARHOG", "File writes: %lu bytes in %lu writes, %lu ms busy (%lu KB/s)",
+              (unsigned long)logTotals.written, (unsigned long)logTotals.writes,
+              (unsigned long)(logTotals.busyUs / 1000),
+              (unsigned long)(logTotals.busyUs ? (uint64_t)logTotals.written * 1000 / logTotals.busyUs : 0));
+    }
+    
     // Put GPS to sleep if power management enabled
     if (Config::gps().powerSave) {
         GPS::sleep();
@@ -362,6 +412,7 @@ void WarhogMode::update() {
             beaconMapBusy = true;
             seenBSSIDs.clear();
             beaconFeatures.clear();
+            beaconTiming.clear();
             beaconMapBusy = false;
         } else if (freeHeap < HEAP_WARNING_THRESHOLD) {
             Serial.println("[WARHOG] WARNING: Heap getting low");
@@ -480,7 +531,7 @@ void WarhogMode::performScan() {
 
 // Ensure CSV file exists with header
 bool WarhogMode::ensureCSVFileReady() {
-    if (currentFilename.length() > 0) return true;
+    if (csvLog.isOpen()) return true;
     
     // Ensure wardriving directory exists
     if (!SD.exists("/wardriving")) {
@@ -492,15 +543,13 @@ bool WarhogMode::ensureCSVFileReady() {
     
     currentFilename = generateFilename("csv");
     
-    File f = openFileWithRetry(currentFilename.c_str(), FILE_WRITE);
-    if (!f) {
+    if (!beginLogWithRetry(csvLog, currentFilename.c_str())) {
         Serial.printf("[WARHOG] Failed to create CSV: %s\n", currentFilename.c_str());
         currentFilename = "";
         return false;
     }
     
-    f.println("BSSID,SSID,RSSI,Channel,AuthMode,Latitude,Longitude,Altitude,Timestamp");
-    f.close();
+    csvLog.println("BSSID,SSID,RSSI,Channel,AuthMode,Latitude,Longitude,Altitude,Timestamp");
     
     Serial.printf("[WARHOG] Created CSV: %s\n", currentFilename.c_str());
     return true;
@@ -508,7 +557,7 @@ bool WarhogMode::ensureCSVFileReady() {
 
 // Ensure ML file exists with header
 bool WarhogMode::ensureMLFileReady() {
-    if (currentMLFilename.length() > 0) return true;
+    if (mlLog.isOpen()) return true;
     
     // Ensure mldata directory exists
     if (!SD.exists("/mldata")) {
@@ -522,23 +571,21 @@ bool WarhogMode::ensureMLFileReady() {
     // Put ML files in /mldata folder
     currentMLFilename.replace("/wardriving/warhog_", "/mldata/ml_training_");
     
-    File f = openFileWithRetry(currentMLFilename.c_str(), FILE_WRITE);
-    if (!f) {
+    if (!beginLogWithRetry(mlLog, currentMLFilename.c_str())) {
         Serial.printf("[WARHOG] Failed to create ML file: %s\n", currentMLFilename.c_str());
         currentMLFilename = "";
         return false;
     }
     
     // CSV header - all 32 feature vector values + label + metadata
-    f.print("bssid,ssid,");
-    f.print("rssi,noise,snr,channel,secondary_ch,beacon_interval,");
-    f.print("capability_lo,capability_hi,has_wps,has_wpa,has_wpa2,has_wpa3,");
-    f.print("is_hidden,response_time,beacon_count,beacon_jitter,");
-    f.print("responds_probe,probe_response_time,vendor_ie_count,");
-    f.print("supported_rates,ht_cap,vht_cap,anomaly_score,");
-    f.print("f23,f24,f25,f26,f27,f28,f29,f30,f31,");
-    f.println("label,latitude,longitude");
-    f.close();
+    mlLog.print("bssid,ssid,");
+    mlLog.print("rssi,noise,snr,channel,secondary_ch,beacon_interval,");
+    mlLog.print("capability_lo,capability_hi,has_wps,has_wpa,has_wpa2,has_wpa3,");
+    mlLog.print("is_hidden,response_time,beacon_count,beacon_jitter,");
+    mlLog.print("responds_probe,probe_response_time,vendor_ie_count,");
+    mlLog.print("supported_rates,ht_cap,vht_cap,anomaly_score,");
+    mlLog.print("f23,f24,f25,f26,f27,f28,f29,f30,f31,");
+    mlLog.println("label,latitude,longitude");
     
     Serial.printf("[WARHOG] Created ML file: %s\n", currentMLFilename.c_str());
     return true;
@@ -550,8 +597,7 @@ void WarhogMode::appendCSVEntry(const uint8_t* bssid, const char* ssid,
                                  double lat, double lon, double alt) {
     if (!ensureCSVFileReady()) return;
     
-    File f = openFileWithRetry(currentFilename.c_str(), FILE_APPEND);
-    if (!f) return;
+    LogWriter& f = csvLog;
     
     f.printf("%02X:%02X:%02X:%02X:%02X:%02X,",
             bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5]);
@@ -560,7 +606,6 @@ void WarhogMode::appendCSVEntry(const uint8_t* bssid, const char* ssid,
     f.printf("%d,%d,%s,%.6f,%.6f,%.1f,%lu\n",
             rssi, channel, authModeToString(auth).c_str(),
             lat, lon, alt, millis());
-    f.close();
 }
 
 // Append single network to ML file
@@ -569,8 +614,7 @@ void WarhogMode::appendMLEntry(const uint8_t* bssid, const char* ssid,
                                 double lat, double lon) {
     if (!ensureMLFileReady()) return;
     
-    File f = openFileWithRetry(currentMLFilename.c_str(), FILE_APPEND);
-    if (!f) return;
+    LogWriter& f = mlLog;
     
     // BSSID
     f.printf("%02X:%02X:%02X:%02X:%02X:%02X,",
@@ -590,21 +634,16 @@ void WarhogMode::appendMLEntry(const uint8_t* bssid, const char* ssid,
     
     // Label and GPS
     f.printf("%d,%.6f,%.6f\n", label, lat, lon);
-    f.close();
 }
 
-// Check if WiGLE file needs rotation due to size
+// Check if WiGLE file needs rotation due to size (tracked by the writer, no reopen)
 void WarhogMode::checkWigleFileRotation() {
-    if (currentWigleFilename.length() == 0) return;
-    
-    File f = SD.open(currentWigleFilename.c_str(), FILE_READ);
-    if (!f) return;
-    
-    size_t fileSize = f.size();
-    f.close();
+    if (!wigleLog.isOpen()) return;
     
+    size_t fileSize = wigleLog.size();
     if (fileSize >= WIGLE_FILE_MAX_SIZE) {
-        Serial.printf("[WARHOG] WiGLE file rotated at %d bytes\n", fileSize);
+        Serial.printf("[WARHOG] WiGLE file rotated at %u bytes\n", (unsigned)fileSize);
+        closeLog(wigleLog);
         currentWigleFilename = "";  // Force new file creation on next append
     }
 }
@@ -614,7 +653,7 @@ bool WarhogMode::ensureWigleFileReady() {
     // Check if current file needs rotation
     checkWigleFileRotation();
     
-    if (currentWigleFilename.length() > 0) return true;
+    if (wigleLog.isOpen()) return true;
     
     // Ensure wardriving directory exists
     if (!SD.exists("/wardriving")) {
@@ -626,25 +665,23 @@ bool WarhogMode::ensureWigleFileReady() {
     
     currentWigleFilename = generateFilename("wigle.csv");
     
-    File f = openFileWithRetry(currentWigleFilename.c_str(), FILE_WRITE);
-    if (!f) {
+    if (!beginLogWithRetry(wigleLog, currentWigleFilename.c_str())) {
         Serial.printf("[WARHOG] Failed to create WiGLE CSV: %s\n", currentWigleFilename.c_str());
         currentWigleFilename = "";
         return false;
     }
     
     // WiGLE format v1.6 pre-header
-    f.print("WigleWifi-1.6,appRelease=");
+    wigleLog.print("WigleWifi-1.6,appRelease=");
     #ifdef BUILD_VERSION
-    f.print(BUILD_VERSION);
+    wigleLog.print(BUILD_VERSION);
     #else
-    f.print("0.1.x");
+    wigleLog.print("0.1.x");
     #endif
-    f.print(",model=M5Cardputer,release=ESP32-S3,device=PORKCHOP,display=240x135,board=m5stack,brand=M5Stack,star=Sol,body=3,subBody=0\n");
+    wigleLog.print(",model=M5Cardputer,release=ESP32-S3,device=PORKCHOP,display=240x135,board=m5stack,brand=M5Stack,star=Sol,body=3,subBody=0\n");
     
     // WiGLE format header
-    f.println("MAC,SSID,AuthMode,FirstSeen,Channel,Frequency,RSSI,CurrentLatitude,CurrentLongitude,AltitudeMeters,AccuracyMeters,RCOIs,MfgrId,Type");
-    f.close();
+    wigleLog.println("MAC,SSID,AuthMode,FirstSeen,Channel,Frequency,RSSI,CurrentLatitude,CurrentLongitude,AltitudeMeters,AccuracyMeters,RCOIs,MfgrId,Type");
     
     Serial.printf("[WARHOG] Created WiGLE CSV: %s\n", currentWigleFilename.c_str());
     return true;
@@ -680,8 +717,7 @@ void WarhogMode::appendWigleEntry(const uint8_t* bssid, const char* ssid,
                                    double lat, double lon, double alt, double accuracy) {
     if (!ensureWigleFileReady()) return;
     
-    File f = openFileWithRetry(currentWigleFilename.c_str(), FILE_APPEND);
-    if (!f) return;
+    LogWriter& f = wigleLog;
     
     // MAC (BSSID with colons)
     f.printf("%02X:%02X:%02X:%02X:%02X:%02X,",
@@ -692,7 +728,7 @@ void WarhogMode::appendWigleEntry(const uint8_t* bssid, const char* ssid,
     f.print(",");
     
     // AuthMode (WiGLE capability string)
-    f.print(authModeToWigleString(auth));
+    f.print(authModeToWigleString(auth).c_str());
     f.print(",");
     
     // FirstSeen (timestamp) - use GPS time if available, else millis
@@ -730,8 +766,6 @@ void WarhogMode::appendWigleEntry(const uint8_t* bssid, const char* ssid,
     
     // RCOIs (empty), MfgrId (empty), Type (WIFI)
     f.println(",,WIFI");
-    
-    f.close();
 }
 
 void WarhogMode::processScanResults() {
@@ -779,19 +813,7 @@ void WarhogMode::processScanResults() {
         wifi_auth_mode_t authmode = WiFi.encryptionType(i);
         
         // Extract ML features
-        WiFiFeatures features;
-        if (enhancedMode) {
-            auto it = beaconFeatures.find(bssidKey);
-            if (it != beaconFeatures.end()) {
-                features = it->second;
-                features.rssi = rssi;
-                features.snr = (float)(rssi - features.noise);
-            } else {
-                features = FeatureExtractor::extractBasic(rssi, channel, authmode);
-            }
-        } else {
-            features = FeatureExtractor::extractBasic(rssi, channel, authmode);
-        }
+        WiFiFeatures features = scanFeatures(i, bssidKey);
         
         // Update statistics
         totalNetworks++;
@@ -855,6 +877,12 @@ void WarhogMode::processScanResults() {
     // Release beacon map guard
     beaconMapBusy = false;
     
+    // One bulk write per file once enough lines (or time) have piled up
+    uint32_t now = millis();
+    csvLog.flushIfDue(now, LOG_FLUSH_BYTES, LOG_FLUSH_MS);
+    wigleLog.flushIfDue(now, LOG_FLUSH_BYTES, LOG_FLUSH_MS);
+    mlLog.flushIfDue(now, LOG_FLUSH_BYTES, LOG_FLUSH_MS);
+    
     // Trigger mood update if we found new networks
     if (newThisScan > 0) {
         Mood::onWarhogFound(nullptr, 0);
@@ -869,6 +897,22 @@ void WarhogMode::processScanResults() {
     }
 }
 
+// ML features for scan result i: its captured beacon's in Enhanced mode,
+// else what the scan itself tells
+WiFiFeatures WarhogMode::scanFeatures(int index, uint64_t bssidKey) {
+    int8_t rssi = WiFi.RSSI(index);
+    if (enhancedMode) {
+        auto it = beaconFeatures.find(bssidKey);
+        if (it != beaconFeatures.end()) {
+            WiFiFeatures features = it->second;
+            features.rssi = rssi;
+            features.snr = (float)(rssi - features.noise);
+            return features;
+        }
+    }
+    return FeatureExtractor::extractBasic(rssi, WiFi.channel(index), WiFi.encryptionType(index));
+}
+
 bool WarhogMode::hasGPSFix() {
     return GPS::hasFix();
 }
@@ -965,19 +1009,36 @@ void WarhogMode::promiscuousCallback(void* buf, wifi_promiscuous_pkt_type_t type
     uint8_t frameSubtype = (frameControl >> 4) & 0x0F;
     
     if (frameType != 0) return;
+    uint32_t rxUs = pkt->rx_ctrl.timestamp;
+    
+    // Probe requests only start the clock for the AP's probe response
+    if (frameSubtype == 4) {
+        beaconTiming.onProbeRequest(frame + 10, rxUs);
+        return;
+    }
     if (frameSubtype != 8 && frameSubtype != 5) return;
     
+    MgmtFrameView view;
+    view.parse(frame, len);
+    if (frameSubtype == 8) {
+        beaconTiming.onBeacon(view, rxUs);
+    } else {
+        beaconTiming.onProbeResponse(view, rxUs);
+    }
+    
     const uint8_t* bssid = frame + 16;
     uint64_t key = bssidToKey(bssid);
-    
-    WiFiFeatures features = FeatureExtractor::extractFromBeacon(frame, len, rssi);
+    const BeaconTiming* timing = beaconTiming.find(bssid);
     
     if (beaconFeatures.size() < 500) {
         auto it = beaconFeatures.find(key);
         if (it != beaconFeatures.end()) {
             it->second.beaconCount++;
+            if (timing) FeatureExtractor::applyTiming(*timing, it->second);
         } else {
+            WiFiFeatures features = FeatureExtractor::extractFromBeacon(view, rssi);
             features.beaconCount = 1;
+            if (timing) FeatureExtractor::applyTiming(*timing, features);
             beaconFeatures[key] = features;
         }
         beaconCount++;
@@ -988,6 +1049,7 @@ void WarhogMode::startEnhancedCapture() {
     Serial.println("[WARHOG] Starting Enhanced ML capture (promiscuous mode)");
     
     beaconFeatures.clear();
+    beaconTiming.clear();
     beaconCount = 0;
     
     wifi_promiscuous_filter_t filter = {
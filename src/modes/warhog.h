@@ -10,13 +10,7 @@
 #include <freertos/task.h>
 #include "../gps/gps.h"
 #include "../ml/features.h"
-
-// BSSID key for map lookup (6 bytes as uint64_t)
-inline uint64_t bssidToKey(const uint8_t* bssid) {
-    return ((uint64_t)bssid[0] << 40) | ((uint64_t)bssid[1] << 32) |
-           ((uint64_t)bssid[2] << 24) | ((uint64_t)bssid[3] << 16) |
-           ((uint64_t)bssid[4] << 8) | bssid[5];
-}
+#include "../core/bssid_index.h"  // bssidToKey()
 
 class WarhogMode {
 public:
@@ -45,6 +39,9 @@ public:
     static uint32_t getWPANetworks() { return wpaNetworks; }
     static uint32_t getSavedCount() { return savedCount; }  // Geotagged networks (CSV)
     static uint32_t getMLOnlyCount() { return mlOnlyCount; } // ML-only networks (no GPS)
+    static uint32_t getBeaconCount() { return beaconCount; }    // Enhanced mode beacons captured
+    static size_t getBeaconCacheSize() { return beaconFeatures.size(); }
+    static BeaconTimingStats getTimingStats() { return beaconTiming.stats(); }
     
 private:
     static bool running;
@@ -71,6 +68,7 @@ private:
     static std::map<uint64_t, WiFiFeatures> beaconFeatures;
     static uint32_t beaconCount;
     static volatile bool beaconMapBusy;
+    static BeaconTimingTracker<128> beaconTiming;  // Jitter / probe timing per AP (~9KB)
     
     // Background scan task
     static TaskHandle_t scanTaskHandle;
@@ -79,6 +77,7 @@ private:
     static void performScan();
     static void scanTask(void* pvParameters);
     static void processScanResults();
+    static WiFiFeatures scanFeatures(int index, uint64_t bssidKey);
     
     // File helpers - write directly per-network
     static bool ensureCSVFileReady();
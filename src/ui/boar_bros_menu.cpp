@@ -2,22 +2,17 @@
 
 #include "boar_bros_menu.h"
 #include <M5Cardputer.h>
-#include <SD.h>
 #include "display.h"
 #include "../modes/oink.h"
 
 // Static member initialization
-std::vector<BroInfo> BoarBrosMenu::bros;
-uint8_t BoarBrosMenu::selectedIndex = 0;
-uint8_t BoarBrosMenu::scrollOffset = 0;
+uint16_t BoarBrosMenu::selectedIndex = 0;
+uint16_t BoarBrosMenu::scrollOffset = 0;
 bool BoarBrosMenu::active = false;
 bool BoarBrosMenu::keyWasPressed = false;
 bool BoarBrosMenu::deleteConfirmActive = false;
 
-static const char* BOAR_BROS_FILE = "/boar_bros.txt";
-
 void BoarBrosMenu::init() {
-    bros.clear();
     selectedIndex = 0;
     scrollOffset = 0;
 }
@@ -28,74 +23,11 @@ void BoarBrosMenu::show() {
     scrollOffset = 0;
     keyWasPressed = true;  // Ignore the Enter that selected us from menu
     deleteConfirmActive = false;
-    loadBros();
 }
 
 void BoarBrosMenu::hide() {
     active = false;
     deleteConfirmActive = false;
-    bros.clear();
-    bros.shrink_to_fit();  // Release vector memory
-}
-
-void BoarBrosMenu::loadBros() {
-    bros.clear();
-    
-    if (!SD.exists(BOAR_BROS_FILE)) {
-        Serial.println("[BOAR_BROS] No file found");
-        return;
-    }
-    
-    File f = SD.open(BOAR_BROS_FILE, FILE_READ);
-    if (!f) {
-        Serial.println("[BOAR_BROS] Failed to open file");
-        return;
-    }
-    
-    // Cap at 50 entries (same as MAX_BOAR_BROS in oink.cpp)
-    while (f.available() && bros.size() < 50) {
-        String line = f.readStringUntil('\n');
-        line.trim();
-        
-        // Skip empty lines and comments
-        if (line.length() == 0 || line.startsWith("#")) continue;
-        
-        // Format: AABBCCDDEEFF [SSID]
-        if (line.length() >= 12) {
-            String hexBssid = line.substring(0, 12);
-            hexBssid.toUpperCase();
-            
-            uint64_t bssid = 0;
-            bool valid = true;
-            for (int i = 0; i < 12; i++) {
-                char c = hexBssid.charAt(i);
-                uint8_t nibble;
-                if (c >= '0' && c <= '9') nibble = c - '0';
-                else if (c >= 'A' && c <= 'F') nibble = c - 'A' + 10;
-                else { valid = false; break; }
-                bssid = (bssid << 4) | nibble;
-            }
-            
-            if (valid) {
-                BroInfo info;
-                info.bssid = bssid;
-                info.bssidStr = formatBSSID(bssid);
-                
-                // Extract SSID from rest of line (after space)
-                if (line.length() > 13) {
-                    info.ssid = line.substring(13);
-                    info.ssid.trim();
-                } else {
-                    info.ssid = "";
-                }
-                
-                bros.push_back(info);
-            }
-        }
-    }
-    
-    f.close();
-    Serial.printf("[BOAR_BROS] Loaded %d bros\n", (int)bros.size());
 }
 
 String BoarBrosMenu::formatBSSID(uint64_t bssid) {
@@ -115,9 +47,10 @@ size_t BoarBrosMenu::getCount() {
 }
 
 String BoarBrosMenu::getSelectedInfo() {
-    if (bros.empty()) return "[B] ADD FROM OINK MODE";
+    const auto& bros = OinkMode::getBoarBros();
+    if (bros.size() == 0) return "[B] ADD FROM OINK MODE";
     if (selectedIndex < bros.size()) {
-        return bros[selectedIndex].bssidStr;
+        return formatBSSID(bros.keyAt(selectedIndex));
     }
     return "";
 }
@@ -162,8 +95,9 @@ void BoarBrosMenu::handleInput() {
         }
     }
     
+    size_t count = OinkMode::getBoarBros().size();
     if (M5Cardputer.Keyboard.isKeyPressed('.')) {
-        if (!bros.empty() && selectedIndex < bros.size() - 1) {
+        if (count > 0 && selectedIndex < count - 1) {
             selectedIndex++;
             if (selectedIndex >= scrollOffset + VISIBLE_ITEMS) {
                 scrollOffset = selectedIndex - VISIBLE_ITEMS + 1;
@@ -172,7 +106,7 @@ void BoarBrosMenu::handleInput() {
     }
     
     // D key - delete selected
-    if ((M5Cardputer.Keyboard.isKeyPressed('d') || M5Cardputer.Keyboard.isKeyPressed('D')) && !bros.empty()) {
+    if ((M5Cardputer.Keyboard.isKeyPressed('d') || M5Cardputer.Keyboard.isKeyPressed('D')) && count > 0) {
         deleteConfirmActive = true;
     }
     
@@ -184,15 +118,11 @@ void BoarBrosMenu::handleInput() {
 }
 
 void BoarBrosMenu::deleteSelected() {
+    const auto& bros = OinkMode::getBoarBros();
     if (selectedIndex >= bros.size()) return;
     
-    uint64_t targetBssid = bros[selectedIndex].bssid;
-    
-    // Remove from OinkMode's set and save
-    OinkMode::removeBoarBro(targetBssid);
-    
-    // Refresh our list
-    loadBros();
+    // Remove from OinkMode's list and save (the list is what we draw)
+    OinkMode::removeBoarBro(bros.keyAt(selectedIndex));
     
     // Adjust selection if needed
     if (selectedIndex >= bros.size() && selectedIndex > 0) {
@@ -213,7 +143,8 @@ void BoarBrosMenu::draw(M5Canvas& canvas) {
     canvas.setTextColor(COLOR_FG);
     canvas.setTextSize(1);
     
-    if (bros.empty()) {
+    const auto& bros = OinkMode::getBoarBros();
+    if (bros.size() == 0) {
         canvas.setCursor(4, 35);
         canvas.print("NO BOAR BROS YET!");
         canvas.setCursor(4, 50);
@@ -227,8 +158,8 @@ void BoarBrosMenu::draw(M5Canvas& canvas) {
     int y = 2;
     int lineHeight = 18;
     
-    for (uint8_t i = scrollOffset; i < bros.size() && i < scrollOffset + VISIBLE_ITEMS; i++) {
-        const BroInfo& bro = bros[i];
+    for (size_t i = scrollOffset; i < bros.size() && i < (size_t)scrollOffset + VISIBLE_ITEMS; i++) {
+        const char* ssid = bros.nameAt(i);
         
         // Highlight selected
         if (i == selectedIndex) {
@@ -240,7 +171,7 @@ void BoarBrosMenu::draw(M5Canvas& canvas) {
         
         // SSID or "NONAME BRO" for hidden networks
         canvas.setCursor(4, y);
-        String displayName = bro.ssid.length() > 0 ? bro.ssid : "NONAME BRO";
+        String displayName = ssid[0] ? ssid : "NONAME BRO";
         displayName.toUpperCase();
         if (displayName.length() > 14) {
             displayName = displayName.substring(0, 12) + "..";
@@ -250,7 +181,7 @@ void BoarBrosMenu::draw(M5Canvas& canvas) {
         
         // Full BSSID (fits at x=80, 17 chars * 6px = 102px, ends at 182px)
         canvas.setCursor(80, y);
-        canvas.print(bro.bssidStr);
+        canvas.print(formatBSSID(bros.keyAt(i)));
         
         y += lineHeight;
     }
@@ -261,7 +192,7 @@ void BoarBrosMenu::draw(M5Canvas& canvas) {
         canvas.setTextColor(COLOR_FG);
         canvas.print("^");
     }
-    if (scrollOffset + VISIBLE_ITEMS < bros.size()) {
+    if ((size_t)scrollOffset + VISIBLE_ITEMS < bros.size()) {
         canvas.setCursor(canvas.width() - 10, 2 + (VISIBLE_ITEMS - 1) * lineHeight);
         canvas.setTextColor(COLOR_FG);
         canvas.print("v");
@@ -274,6 +205,9 @@ void BoarBrosMenu::draw(M5Canvas& canvas) {
 }
 
 void BoarBrosMenu::drawDeleteConfirm(M5Canvas& canvas) {
+    const auto& bros = OinkMode::getBoarBros();
+    if (selectedIndex >= bros.size()) return;
+    
     // Modal box dimensions - matches other confirmation dialogs
     const int boxW = 180;
     const int boxH = 55;
@@ -290,8 +224,8 @@ void BoarBrosMenu::drawDeleteConfirm(M5Canvas& canvas) {
     
     canvas.drawString("REMOVE THIS BRO?", boxX + boxW / 2, boxY + 10);
     
-    String broName = bros[selectedIndex].ssid.length() > 0 ? 
-                     bros[selectedIndex].ssid : bros[selectedIndex].bssidStr;
+    const char* ssid = bros.nameAt(selectedIndex);
+    String broName = ssid[0] ? String(ssid) : formatBSSID(bros.keyAt(selectedIndex));
     broName.toUpperCase();
     if (broName.length() > 18) broName = broName.substring(0, 16) + "..";
     canvas.drawString(broName, boxX + boxW / 2, boxY + 24);
@@ -3,14 +3,9 @@
 
 #include <Arduino.h>
 #include <M5Unified.h>
-#include <vector>
-
-struct BroInfo {
-    uint64_t bssid;      // BSSID as uint64
-    String bssidStr;     // Formatted BSSID (AA:BB:CC:DD:EE:FF)
-    String ssid;         // SSID if known (from file comment)
-};
 
+// Pages straight through OinkMode's BOAR BROS list (sorted by BSSID): no
+// copy of the list, so thousands of bros cost the menu nothing
 class BoarBrosMenu {
 public:
     static void init();
@@ -23,9 +18,8 @@ public:
     static String getSelectedInfo();
     
 private:
-    static std::vector<BroInfo> bros;
-    static uint8_t selectedIndex;
-    static uint8_t scrollOffset;
+    static uint16_t selectedIndex;
+    static uint16_t scrollOffset;
     static bool active;
     static bool keyWasPressed;
     static bool deleteConfirmActive;
@@ -33,7 +27,6 @@ private:
     static const uint8_t VISIBLE_ITEMS = 5;
     
     static void handleInput();
-    static void loadBros();
     static void deleteSelected();
     static void drawDeleteConfirm(M5Canvas& canvas);
     static String formatBSSID(uint64_t bssid);
@@ -7,6 +7,7 @@
 #include "display.h"
 #include "../web/wpasec.h"
 #include "../core/config.h"
+#include "../core/capture_catalog.h"
 
 // Static member initialization
 std::vector<CaptureInfo> CapturesMenu::captures;
@@ -43,85 +44,42 @@ void CapturesMenu::hide() {
 void CapturesMenu::scanCaptures() {
     captures.clear();
     
-    if (!SD.exists("/handshakes")) {
-        Serial.println("[CAPTURES] No handshakes directory");
-        return;
-    }
-    
-    File dir = SD.open("/handshakes");
-    if (!dir || !dir.isDirectory()) {
-        Serial.println("[CAPTURES] Failed to open handshakes directory");
-        return;
-    }
-    
-    File file = dir.openNextFile();
-    while (file) {
-        String name = file.name();
-        bool isPCAP = name.endsWith(".pcap");
-        bool isPMKID = name.endsWith(".22000") && !name.endsWith("_hs.22000");
-        bool isHS22000 = name.endsWith("_hs.22000");
+    // One sequential read of the capture catalog instead of walking
+    // /handshakes and opening a companion .txt per capture
+    bool ok = CaptureCatalog::forEach([](const CatalogRecord& rec) {
+        CaptureKind kind = (CaptureKind)rec.kind;
         
         // Skip PCAP if we have the corresponding _hs.22000 (avoid duplicates)
         // We prefer showing _hs.22000 because it's hashcat-ready
-        if (isPCAP) {
-            String baseName = name.substring(0, name.indexOf('.'));
-            String hs22kPath = "/handshakes/" + baseName + "_hs.22000";
-            if (SD.exists(hs22kPath)) {
-                file = dir.openNextFile();
-                continue;  // Skip this PCAP, _hs.22000 will be shown instead
-            }
+        if (kind == CaptureKind::PCAP && CaptureCatalog::has(rec.bssid, CaptureKind::HANDSHAKE)) {
+            return;
         }
         
-        if (isPCAP || isPMKID || isHS22000) {
-            CaptureInfo info;
-            info.filename = name;
-            info.fileSize = file.size();
-            info.captureTime = file.getLastWrite();
-            info.isPMKID = isPMKID;  // Only true for actual PMKID files
-            
-            // Extract BSSID from filename (e.g., "64EEB7208286.pcap" or "64EEB7208286_hs.22000")
-            String baseName = name.substring(0, name.indexOf('.'));
-            // Handle _hs suffix for handshake 22000 files
-            if (baseName.endsWith("_hs")) {
-                baseName = baseName.substring(0, baseName.length() - 3);
-            }
-            if (baseName.length() >= 12) {
-                info.bssid = baseName.substring(0, 2) + ":" +
-                             baseName.substring(2, 4) + ":" +
-                             baseName.substring(4, 6) + ":" +
-                             baseName.substring(6, 8) + ":" +
-                             baseName.substring(8, 10) + ":" +
-                             baseName.substring(10, 12);
-            } else {
-                info.bssid = baseName;
-            }
-            
-            // Try to get SSID from companion .txt file if exists
-            // PMKID uses _pmkid.txt suffix, handshake uses .txt
-            String txtPath = isPMKID ? 
-                "/handshakes/" + baseName + "_pmkid.txt" :
-                "/handshakes/" + baseName + ".txt";
-            if (SD.exists(txtPath)) {
-                File txtFile = SD.open(txtPath, FILE_READ);
-                if (txtFile) {
-                    info.ssid = txtFile.readStringUntil('\n');
-                    info.ssid.trim();
-                    txtFile.close();
-                }
-            }
-            if (info.ssid.isEmpty()) {
-                info.ssid = "[UNKNOWN]";
-            }
-            
-            // Check WPA-SEC status
-            info.status = CaptureStatus::LOCAL;
-            info.password = "";
-            
-            captures.push_back(info);
-        }
-        file = dir.openNextFile();
+        char path[48];
+        CaptureCatalog::capturePath(path, sizeof(path), rec.bssid, kind);
+        char bssidStr[18];
+        snprintf(bssidStr, sizeof(bssidStr), "%02X:%02X:%02X:%02X:%02X:%02X",
+                 rec.bssid[0], rec.bssid[1], rec.bssid[2],
+                 rec.bssid[3], rec.bssid[4], rec.bssid[5]);
+        
+        CaptureInfo info;
+        info.filename = strrchr(path, '/') + 1;
+        info.fileSize = rec.fileSize;
+        info.captureTime = rec.timestamp;
+        info.isPMKID = kind == CaptureKind::PMKID;  // Only true for actual PMKID files
+        info.bssid = bssidStr;
+        info.ssid = rec.ssid[0] ? String(rec.ssid) : String("[UNKNOWN]");
+        
+        // Check WPA-SEC status
+        info.status = CaptureStatus::LOCAL;
+        info.password = "";
+        
+        captures.push_back(info);
+    });
+    if (!ok) {
+        Serial.println("[CAPTURES] Capture catalog unavailable");
+        return;
     }
-    dir.close();
     
     // Update WPA-SEC status for all captures
     updateWPASecStatus();
@@ -139,14 +97,13 @@ void CapturesMenu::updateWPASecStatus() {
     WPASec::loadCache();
     
     for (auto& cap : captures) {
-        // Normalize BSSID for lookup (remove colons)
-        String normalBssid = cap.bssid;
-        normalBssid.replace(":", "");
+        // Lookups take the BSSID with or without colons: no String copy per capture
+        const char* bssid = cap.bssid.c_str();
         
-        if (WPASec::isCracked(normalBssid.c_str())) {
+        if (WPASec::isCracked(bssid)) {
             cap.status = CaptureStatus::CRACKED;
-            cap.password = WPASec::getPassword(normalBssid.c_str());
-        } else if (WPASec::isUploaded(normalBssid.c_str())) {
+            cap.password = WPASec::getPassword(bssid);
+        } else if (WPASec::isUploaded(bssid)) {
             cap.status = CaptureStatus::UPLOADED;
         } else {
             cap.status = CaptureStatus::LOCAL;
@@ -418,6 +375,7 @@ void CapturesMenu::nukeLoot() {
     }
     
     Serial.printf("[CAPTURES] Nuked %d files\n", deleted);
+    CaptureCatalog::clear();
     
     // Reset selection
     selectedIndex = 0;
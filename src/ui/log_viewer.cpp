@@ -3,23 +3,30 @@
 #include "log_viewer.h"
 #include "display.h"
 #include "../core/config.h"
+#include "../core/sdlog.h"
+#include "../core/tail_view.h"
 #include <M5Cardputer.h>
 #include <SD.h>
 
+static const uint8_t VISIBLE_LINES = 9;  // Lines visible on screen (no header now)
+static const uint8_t LINE_CHARS = 40;    // Kept per line; render truncates to 39
+static const uint32_t FOLLOW_POLL_MS = 1000;
+
+// Only the visible window is ever in RAM, whatever the log's size
+static TailView<File, VISIBLE_LINES, LINE_CHARS> view;
+static String logPath;
+
 // Static members
 bool LogViewer::active = false;
-std::vector<String> LogViewer::logLines;
-uint16_t LogViewer::scrollOffset = 0;
-uint16_t LogViewer::totalLines = 0;
+bool LogViewer::following = false;
+uint32_t LogViewer::lastPollMs = 0;
+const char* LogViewer::notice[2] = {nullptr, nullptr};
 bool LogViewer::keyWasPressed = false;
 
-static const uint16_t MAX_LOG_LINES = 100;
-static const uint8_t VISIBLE_LINES = 9;  // Lines visible on screen (no header now)
-
 void LogViewer::init() {
-    logLines.clear();
-    scrollOffset = 0;
-    totalLines = 0;
+    view.close();
+    following = false;
+    notice[0] = notice[1] = nullptr;
 }
 
 String LogViewer::findLatestLogFile() {
@@ -27,129 +34,143 @@ String LogViewer::findLatestLogFile() {
         Serial.println("[LOGVIEW] SD not available");
         return "";
     }
-    
+
     // Use fixed filename - always the same file
     const char* logFile = "/logs/porkchop.log";
-    
+
     if (SD.exists(logFile)) {
         Serial.printf("[LOGVIEW] Found: %s\n", logFile);
         return String(logFile);
     }
-    
+
     Serial.println("[LOGVIEW] Log file not found");
     return "";
 }
 
 void LogViewer::loadLogFile() {
-    logLines.clear();
-    
-    String filename = findLatestLogFile();
-    if (filename.length() == 0) {
-        logLines.push_back("No log files found");
-        logLines.push_back("Enable SD Log in Settings");
-        totalLines = logLines.size();
-        Serial.printf("[LOGVIEW] No log files, totalLines=%d\n", totalLines);
+    view.close();
+    notice[0] = notice[1] = nullptr;
+
+    logPath = findLatestLogFile();
+    if (logPath.length() == 0) {
+        notice[0] = "No log files found";
+        notice[1] = "Enable SD Log in Settings";
         return;
     }
-    
-    Serial.printf("[LOGVIEW] Opening: %s\n", filename.c_str());
-    File f = SD.open(filename.c_str(), FILE_READ);
-    if (!f) {
-        logLines.push_back("Failed to open log file");
-        logLines.push_back(filename);
-        totalLines = logLines.size();
-        Serial.printf("[LOGVIEW] Failed to open, totalLines=%d\n", totalLines);
+
+    // Queued lines would otherwise be missing from the tail
+    SDLog::flush();
+
+    Serial.printf("[LOGVIEW] Opening: %s\n", logPath.c_str());
+    if (!view.open(SD.open(logPath.c_str(), FILE_READ))) {
+        notice[0] = "Failed to open log file";
+        notice[1] = logPath.c_str();
         return;
     }
-    
-    Serial.printf("[LOGVIEW] File size: %d bytes\n", f.size());
-    
-    // Read all lines into a circular buffer (keep last MAX_LOG_LINES)
-    std::vector<String> allLines;
-    while (f.available()) {
-        String line = f.readStringUntil('\n');
-        line.trim();
-        if (line.length() > 0) {
-            allLines.push_back(line);
-            // Keep only last MAX_LOG_LINES
-            if (allLines.size() > MAX_LOG_LINES) {
-                allLines.erase(allLines.begin());
-            }
-        }
-    }
-    f.close();
-    
-    Serial.printf("[LOGVIEW] Read %d lines\n", allLines.size());
-    
-    logLines = allLines;
-    totalLines = logLines.size();
-    
-    // Start scrolled to bottom (most recent)
-    if (totalLines > VISIBLE_LINES) {
-        scrollOffset = totalLines - VISIBLE_LINES;
-    } else {
-        scrollOffset = 0;
-    }
-    
-    if (logLines.empty()) {
-        logLines.push_back("Log file is empty");
-        totalLines = 1;
+
+    TailViewStats st = view.stats();
+    Serial.printf("[LOGVIEW] %lu bytes, tail in %lu reads\n",
+                  (unsigned long)view.size(), (unsigned long)st.reads);
+
+    if (view.count() == 0) {
+        notice[0] = "Log file is empty";
     }
 }
 
 void LogViewer::show() {
     active = true;
     keyWasPressed = true;  // Ignore the key that opened us
+    following = false;
     loadLogFile();
     render();
 }
 
 void LogViewer::hide() {
     active = false;
-    logLines.clear();
-    logLines.shrink_to_fit();  // Release vector memory
+    following = false;
+    view.close();
+    logPath = "";
+}
+
+// Reopen the log to see what was appended: a read handle's size is fixed
+// at open, so the same handle would never notice
+void LogViewer::pollFollow() {
+    uint32_t now = millis();
+    if (now - lastPollMs < FOLLOW_POLL_MS) return;
+    lastPollMs = now;
+    if (logPath.length() == 0) return;
+
+    SDLog::flush();
+    File f = SD.open(logPath.c_str(), FILE_READ);
+    if (!f) return;
+    if (!view.isOpen()) {
+        // Log showed up (or came back) since we opened
+        if (view.open(f) && view.count() > 0) {
+            notice[0] = notice[1] = nullptr;
+            render();
+        }
+        return;
+    }
+    if (view.refresh(f)) {
+        notice[0] = notice[1] = nullptr;
+        render();
+    }
 }
 
 void LogViewer::render() {
     M5Canvas& canvas = Display::getMain();
-    
+
     // Clear and setup canvas
     canvas.fillSprite(COLOR_BG);
     canvas.setTextColor(COLOR_FG, COLOR_BG);
     canvas.setTextSize(1);
     canvas.setFont(&fonts::Font0);
-    
+
     // Draw log lines (title is in top bar now)
     canvas.setTextDatum(TL_DATUM);
     uint8_t y = 2;
     uint8_t lineHeight = 11;
-    
-    Serial.printf("[LOGVIEW] Rendering %d lines from offset %d\n", totalLines, scrollOffset);
-    
-    for (uint8_t i = 0; i < VISIBLE_LINES && (scrollOffset + i) < totalLines; i++) {
-        String& line = logLines[scrollOffset + i];
-        
+
+    if (view.count() == 0) {
+        for (uint8_t i = 0; i < 2 && notice[i]; i++) {
+            canvas.drawString(notice[i], 2, y);
+            y += lineHeight;
+        }
+    }
+
+    for (uint8_t i = 0; i < view.count(); i++) {
+        const char* line = view.line(i);
+
         // Truncate long lines to fit screen
-        String displayLine = line;
-        if (displayLine.length() > 39) {
-            displayLine = displayLine.substring(0, 38) + "~";
+        char displayLine[LINE_CHARS + 1];
+        if (strlen(line) > 39) {
+            memcpy(displayLine, line, 38);
+            displayLine[38] = '~';
+            displayLine[39] = '\0';
+        } else {
+            strcpy(displayLine, line);
         }
-        
+
         canvas.drawString(displayLine, 2, y);
         y += lineHeight;
     }
-    
-    // Scroll indicator
-    if (totalLines > VISIBLE_LINES) {
+
+    // Scroll indicator - by byte position, the line count is never known
+    uint32_t size = view.size();
+    uint32_t winStart = view.position();
+    uint32_t winEnd = view.windowEnd();
+    bool whole = winStart == 0 && winEnd >= size && view.atStart();
+    if (size > 0 && view.count() > 0 && !whole) {
         int barHeight = MAIN_H - 14;
         int barY = 12;
-        int thumbHeight = max(10, (int)(barHeight * VISIBLE_LINES / totalLines));
-        int thumbY = barY + (barHeight - thumbHeight) * scrollOffset / (totalLines - VISIBLE_LINES);
-        
+        int thumbHeight = max(10, (int)((uint64_t)barHeight * (winEnd - winStart) / size));
+        int thumbY = barY + (int)((uint64_t)(barHeight - thumbHeight) * winStart / size);
+        if (view.atEnd()) thumbY = barY + barHeight - thumbHeight;
+
         canvas.fillRect(DISPLAY_W - 4, barY, 3, barHeight, 0x2104);  // Dark gray track
         canvas.fillRect(DISPLAY_W - 4, thumbY, 3, thumbHeight, COLOR_FG);  // Pink thumb
     }
-    
+
     // Instructions in bottom bar
     M5Canvas& bottom = Display::getBottomBar();
     bottom.fillSprite(COLOR_BG);
@@ -157,59 +178,76 @@ void LogViewer::render() {
     bottom.setTextColor(COLOR_FG);
     bottom.setTextDatum(TL_DATUM);
     char info[24];
-    snprintf(info, sizeof(info), "L:%d", totalLines);
+    if (view.atEnd()) {
+        snprintf(info, sizeof(info), "END %luK%s", (unsigned long)(size / 1024),
+                 following ? " FOLLOW" : "");
+    } else {
+        snprintf(info, sizeof(info), "%lu%% %luK%s",
+                 (unsigned long)((uint64_t)winStart * 100 / size),
+                 (unsigned long)(size / 1024), following ? " FOLLOW" : "");
+    }
     bottom.drawString(info, 2, 3);
     bottom.setTextDatum(TR_DATUM);
-    bottom.drawString(";/. `/Ent", DISPLAY_W - 2, 3);
-    
+    bottom.drawString(";/. ,// F `", DISPLAY_W - 2, 3);
+
     Display::pushAll();
 }
 
 void LogViewer::update() {
     if (!active) return;
-    
+
+    if (following) pollFollow();
+
     // Note: M5Cardputer.update() is called in main loop, don't call it again
-    
+
     if (!M5Cardputer.Keyboard.isPressed()) {
         keyWasPressed = false;
         return;
     }
-    
+
     if (keyWasPressed) return;  // Debounce
-    
+
     Keyboard_Class::KeysState keys = M5Cardputer.Keyboard.keysState();
-    
+
     bool needsRender = false;
-    
+
     for (auto key : keys.word) {
         keyWasPressed = true;
-        
+
         if (key == ';') {
             // Scroll up
-            if (scrollOffset > 0) {
-                scrollOffset--;
-                needsRender = true;
-            }
+            if (view.scroll(-1) != 0) needsRender = true;
         } else if (key == '.') {
-            // Scroll down - only if we have more lines than visible
-            if (totalLines > VISIBLE_LINES && scrollOffset < totalLines - VISIBLE_LINES) {
-                scrollOffset++;
-                needsRender = true;
+            // Scroll down
+            if (view.scroll(1) != 0) needsRender = true;
+        } else if (key == ',') {
+            // Page up
+            if (view.scroll(-(int)VISIBLE_LINES) != 0) needsRender = true;
+        } else if (key == '/') {
+            // Page down
+            if (view.scroll(VISIBLE_LINES) != 0) needsRender = true;
+        } else if (key == 'f' || key == 'F') {
+            // Follow: jump to the end and keep reading what gets appended
+            following = !following;
+            if (following) {
+                lastPollMs = millis() - FOLLOW_POLL_MS;  // Poll right away
+                if (!view.atEnd()) loadLogFile();
             }
+            needsRender = true;
         } else if (key == '`' || key == 0x1B) {
             // Exit
             hide();
             return;
         }
     }
-    
+
     // Also check for Enter to exit
     if (keys.enter) {
         keyWasPressed = true;
         hide();
         return;
     }
-    
+
     if (needsRender) {
         render();
     }
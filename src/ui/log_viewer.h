@@ -2,7 +2,6 @@
 #pragma once
 
 #include <Arduino.h>
-#include <vector>
 
 class LogViewer {
 public:
@@ -11,15 +10,16 @@ public:
     static void hide();
     static void update();
     static bool isActive() { return active; }
-    
+
 private:
     static bool active;
-    static std::vector<String> logLines;
-    static uint16_t scrollOffset;
-    static uint16_t totalLines;
+    static bool following;           // Re-read the tail as the log grows
+    static uint32_t lastPollMs;
+    static const char* notice[2];    // Shown instead of lines when there's no log
     static bool keyWasPressed;
-    
+
     static void loadLogFile();
+    static void pollFollow();
     static void render();
     static String findLatestLogFile();
 };
@@ -0,0 +1,140 @@
+// Dir Lister - streams a directory listing as JSON in fixed-size chunks
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+struct DirListOptions {
+    uint32_t offset;      // Matches to skip
+    uint32_t limit;       // Matches to send, 0 = all
+    const char* filter;   // Name substring, case-insensitive; null/"" = all
+    bool full;            // Include isDir
+};
+
+struct DirListResult {
+    uint32_t scanned;     // Directory entries visited
+    uint32_t sent;        // Entries written out
+    uint32_t chunks;      // Sink calls
+    bool more;            // Matches remain past offset + limit
+};
+
+template <typename FileT, size_t BUF = 1024>
+class DirLister {
+    static_assert(BUF >= 64, "DirLister buffer too small");
+
+public:
+    // Stream dir's listing to sink(const char* data, size_t len) as
+    //   {"entries":[{"name":"a.pcap","size":12,"isDir":false},...],
+    //    "offset":0,"next":200,"more":true}
+    // isDir only with opt.full; one match past the limit is peeked for "more".
+    template <typename Sink>
+    DirListResult list(FileT& dir, const DirListOptions& opt, Sink sink) {
+        DirListResult res;
+        memset(&res, 0, sizeof(res));
+        used = 0;
+
+        put("{\"entries\":[", sink, res);
+        uint32_t matched = 0;
+        FileT entry = dir.openNextFile();
+        while (entry) {
+            res.scanned++;
+            const char* name = entry.name();
+            if (matches(name, opt.filter)) {
+                if (opt.limit && res.sent >= opt.limit) {
+                    res.more = true;
+                    entry.close();
+                    break;
+                }
+                if (matched >= opt.offset) {
+                    writeEntry(entry, name, res.sent > 0, opt.full, sink, res);
+                    res.sent++;
+                }
+                matched++;
+            }
+            entry.close();
+            entry = dir.openNextFile();
+        }
+
+        char tail[64];
+        snprintf(tail, sizeof(tail), "],\"offset\":%lu,\"next\":%lu,\"more\":%s}",
+                 (unsigned long)opt.offset, (unsigned long)(opt.offset + res.sent),
+                 res.more ? "true" : "false");
+        put(tail, sink, res);
+        if (used) {
+            sink(buf, used);
+            res.chunks++;
+            used = 0;
+        }
+        return res;
+    }
+
+    // Entries whose name matches filter, nothing formatted
+    static uint32_t count(FileT& dir, const char* filter) {
+        uint32_t n = 0;
+        FileT entry = dir.openNextFile();
+        while (entry) {
+            if (matches(entry.name(), filter)) n++;
+            entry.close();
+            entry = dir.openNextFile();
+        }
+        return n;
+    }
+
+    static bool matches(const char* name, const char* filter) {
+        if (!filter || !*filter) return true;
+        if (!name) return false;
+        size_t fl = strlen(filter);
+        for (const char* p = name; *p; p++) {
+            size_t i = 0;
+            while (i < fl && p[i] && lower(p[i]) == lower(filter[i])) i++;
+            if (i == fl) return true;
+        }
+        return false;
+    }
+
+private:
+    static char lower(char c) { return (c >= 'A' && c <= 'Z') ? c + 32 : c; }
+
+    template <typename Sink>
+    void writeEntry(FileT& entry, const char* name, bool comma, bool full,
+                    Sink& sink, DirListResult& res) {
+        put(comma ? ",{\"name\":\"" : "{\"name\":\"", sink, res);
+        for (const char* p = name ? name : ""; *p; p++) {
+            unsigned char c = (unsigned char)*p;
+            char esc[8];
+            if (c == '"' || c == '\\') {
+                esc[0] = '\\';
+                esc[1] = (char)c;
+                esc[2] = '\0';
+            } else if (c < 0x20) {
+                snprintf(esc, sizeof(esc), "\\u%04x", c);
+            } else {
+                esc[0] = (char)c;
+                esc[1] = '\0';
+            }
+            put(esc, sink, res);
+        }
+        char meta[48];
+        snprintf(meta, sizeof(meta), "\",\"size\":%lu", (unsigned long)entry.size());
+        put(meta, sink, res);
+        if (full) put(entry.isDirectory() ? ",\"isDir\":true" : ",\"isDir\":false", sink, res);
+        put("}", sink, res);
+    }
+
+    template <typename Sink>
+    void put(const char* s, Sink& sink, DirListResult& res) {
+        size_t len = strlen(s);
+        if (used + len > BUF) {
+            sink(buf, used);
+            res.chunks++;
+            used = 0;
+        }
+        memcpy(buf + used, s, len);
+        used += len;
+    }
+
+    char buf[BUF];
+    size_t used = 0;
+};
@@ -2,6 +2,11 @@
 
 #include "fileserver.h"
 #include <SD.h>
+#include "dir_lister.h"
+#include "zip_stream.h"
+#include "http_range.h"
+#include "upload_resume.h"
+#include "../core/capture_catalog.h"
 #include <ESPmDNS.h>
 
 // Static members
@@ -17,6 +22,39 @@ uint32_t FileServer::lastReconnectCheck = 0;
 static File uploadFile;
 static String uploadDir;
 
+// /api/ls formats into this and sends it chunk by chunk
+static DirLister<File> dirLister;
+
+// ZIP downloads: 1KB send buffer, entry table only while streaming
+static ZipStream<fs::FS, File> zipStream;
+
+// Resumable uploads: 4KB write-behind only while a slice is arriving
+static UploadResume<fs::FS, File> resumeUploads;
+static bool uploadResumable = false;
+static UploadStatus uploadResult = UploadStatus::OK;
+static uint32_t uploadOffset = 0;
+
+// Captures changed outside the capture modes: the catalog rebuilds on next use.
+// Also covers "/" and other parents of /handshakes.
+static void noteCaptureChange(const String& path) {
+    if (path.startsWith("/handshakes") || String("/handshakes").startsWith(path)) {
+        CaptureCatalog::invalidate();
+    }
+}
+
+// One file deleted: a capture file just drops its catalog record, anything
+// else under /handshakes (companion .txt) rebuilds it
+static void noteCaptureRemoved(const String& path) {
+    uint8_t bssid[6];
+    CaptureKind kind;
+    if (path.startsWith("/handshakes/") && path.lastIndexOf('/') == 11 &&
+        CatalogIndex<fs::FS, File>::parseName(path.c_str(), bssid, kind)) {
+        CaptureCatalog::noteRemoved(bssid, kind);
+    } else {
+        noteCaptureChange(path);
+    }
+}
+
 // Black & white HTML interface - Midnight Commander style dual-pane
 static const char HTML_TEMPLATE[] PROGMEM = R"rawliteral(
 <!DOCTYPE html>
@@ -335,8 +373,8 @@ Backspace      Parent folder
 <script>
 // Pane state
 const panes = {
-    L: { path: '/', items: [], selected: new Set(), focusIdx: 0 },
-    R: { path: '/', items: [], selected: new Set(), focusIdx: 0 }
+    L: { path: '/', items: [], selected: new Set(), focusIdx: 0, next: 0, more: false },
+    R: { path: '/', items: [], selected: new Set(), focusIdx: 0, next: 0, more: false }
 };
 let activePane = 'L';
 
@@ -366,36 +404,30 @@ async function loadSDInfo() {
     }
 }
 
+// Entries per /api/ls request - big dirs come in pages, not one huge reply
+const PAGE = 200;
+
 async function loadPane(id, path) {
     const pane = panes[id];
     pane.path = path;
     pane.selected.clear();
     pane.focusIdx = 0;
+    pane.next = 0;
+    pane.more = false;
     
     document.getElementById('path' + id).textContent = path || '/';
     const list = document.getElementById('list' + id);
     list.innerHTML = '<div style="padding:20px;opacity:0.5">jacking in...</div>';
     
+    pane.items = [];
+    
+    // Parent directory entry
+    if (path !== '/') {
+        pane.items.push({ name: '..', isDir: true, isParent: true, size: 0 });
+    }
+    
     try {
-        const r = await fetch('/api/ls?dir=' + encodeURIComponent(path) + '&full=1');
-        const items = await r.json();
-        
-        // Sort: directories first, then alphabetically
-        pane.items = [];
-        
-        // Parent directory entry
-        if (path !== '/') {
-            pane.items.push({ name: '..', isDir: true, isParent: true, size: 0 });
-        }
-        
-        // Directories
-        items.filter(i => i.isDir).sort((a,b) => a.name.localeCompare(b.name))
-            .forEach(i => pane.items.push(i));
-        
-        // Files
-        items.filter(i => !i.isDir).sort((a,b) => a.name.localeCompare(b.name))
-            .forEach(i => pane.items.push(i));
-        
+        await fetchPage(id);
         renderPane(id);
     } catch(e) {
         list.innerHTML = '<div style="padding:20px;opacity:0.5">load failed</div>';
@@ -403,11 +435,47 @@ async function loadPane(id, path) {
     updateSelectionInfo(id);
 }
 
+// Append the next page. Sorted within the page (dirs first, then
+// alphabetically) so indexes of what's already listed never move.
+async function fetchPage(id) {
+    const pane = panes[id];
+    const r = await fetch('/api/ls?dir=' + encodeURIComponent(pane.path) + '&full=1' +
+                          '&offset=' + pane.next + '&limit=' + PAGE);
+    const d = await r.json();
+    const items = d.entries;
+    
+    // Directories
+    items.filter(i => i.isDir).sort((a,b) => a.name.localeCompare(b.name))
+        .forEach(i => pane.items.push(i));
+    
+    // Files
+    items.filter(i => !i.isDir).sort((a,b) => a.name.localeCompare(b.name))
+        .forEach(i => pane.items.push(i));
+    
+    pane.next = d.next;
+    pane.more = d.more;
+}
+
+async function loadMore(id) {
+    const pane = panes[id];
+    if (!pane.more || pane.loading) return;
+    pane.loading = true;
+    setStatus('loading more...');
+    try {
+        await fetchPage(id);
+        setStatus(pane.items.length + ' loaded');
+    } catch(e) {
+        setStatus('load failed');
+    }
+    pane.loading = false;
+    renderPane(id);
+}
+
 function renderPane(id) {
     const pane = panes[id];
     const list = document.getElementById('list' + id);
     
-    if (pane.items.length === 0) {
+    if (pane.items.length === 0 && !pane.more) {
         list.innerHTML = '<div style="padding:20px;opacity:0.4;text-align:center">void</div>';
         return;
     }
@@ -431,6 +499,12 @@ function renderPane(id) {
         html += '<div class="file-size">' + size + '</div>';
         html += '</div>';
     });
+    if (pane.more) {
+        html += '<div class="file-item" onclick="loadMore(\'' + id + '\')">';
+        html += '<div class="file-check"></div><div class="file-icon">+</div>';
+        html += '<div class="file-name">more... (' + pane.next + ' shown)</div>';
+        html += '<div class="file-size"></div></div>';
+    }
     list.innerHTML = html;
     
     // Scroll focused item into view
@@ -528,6 +602,8 @@ function handleKeydown(e) {
             if (pane.focusIdx < pane.items.length - 1) {
                 pane.focusIdx++;
                 renderPane(activePane);
+            } else if (pane.more) {
+                loadMore(activePane);
             }
             break;
         case 'Enter':
@@ -634,26 +710,22 @@ async function deleteSelected() {
 }
 
 async function downloadSelected() {
-    const items = getSelectedPaths().filter(i => !i.isDir);
+    const items = getSelectedPaths();
     if (items.length === 0) {
-        setStatus('no files marked. dirs need zip. we aint got zip.');
+        setStatus('mark something first');
         return;
     }
     
-    setStatus('exfiltrating ' + items.length + ' file(s)...');
-    
-    // Download files sequentially (browser limitation)
-    for (let i = 0; i < items.length; i++) {
-        await new Promise(resolve => {
-            const a = document.createElement('a');
-            a.href = '/download?f=' + encodeURIComponent(items[i].path);
-            a.download = items[i].path.split('/').pop();
-            a.click();
-            setTimeout(resolve, 300); // Small delay between downloads
-        });
+    // One plain file downloads as-is, anything else comes as one ZIP
+    if (items.length === 1 && !items[0].isDir) {
+        window.location.href = '/download?f=' + encodeURIComponent(items[0].path);
+        setStatus('exfiltrating ' + items[0].path.split('/').pop());
+        return;
     }
     
-    setStatus('exfil complete: ' + items.length);
+    const q = items.map(i => 'zip=' + encodeURIComponent(i.path)).join('&');
+    window.location.href = '/download?' + q;
+    setStatus('zipping ' + items.length + ' item(s) on the fly...');
 }
 
 function downloadFile(paneId, idx) {
@@ -823,6 +895,50 @@ async function createFolder() {
     }
 }
 
+// Files go up in slices; a dropped slice resumes from what the pig kept
+const SLICE = 64 * 1024;
+
+function postSlice(url, blob, name, onProgress) {
+    return new Promise((resolve, reject) => {
+        const formData = new FormData();
+        formData.append('file', blob, name);
+        const xhr = new XMLHttpRequest();
+        xhr.upload.onprogress = (e) => { if (e.lengthComputable) onProgress(e.loaded); };
+        xhr.onload = () => xhr.status === 200 ? resolve(JSON.parse(xhr.responseText)) : reject(xhr.status);
+        xhr.onerror = () => reject(0);
+        xhr.open('POST', url);
+        xhr.send(formData);
+    });
+}
+
+async function uploadOne(file, dir, fill) {
+    const beginUrl = '/api/upload/begin?dir=' + encodeURIComponent(dir) +
+                     '&name=' + encodeURIComponent(file.name) + '&size=' + file.size;
+    let tries = 0;
+    for (;;) {
+        // Ask where to (re)start: the server's part file is the truth
+        const b = await (await fetch(beginUrl)).json();
+        if (!b.id) throw new Error(b.error || 'begin failed');
+        let offset = b.offset;
+        try {
+            do {
+                const end = Math.min(offset + SLICE, file.size);
+                const r = await postSlice('/upload?id=' + b.id + '&offset=' + offset,
+                                          file.slice(offset, end), file.name,
+                                          (n) => fill.style.width = ((offset + n) / Math.max(file.size, 1) * 100) + '%');
+                offset = r.offset;
+                tries = 0;
+                if (r.done) return;
+            } while (offset < file.size);
+            return;
+        } catch(e) {
+            if (++tries > 5) throw e;
+            setStatus('link dropped. resuming ' + file.name + '...');
+            await new Promise(res => setTimeout(res, 1000 * tries));
+        }
+    }
+}
+
 async function uploadFiles(files) {
     if (!files || !files.length) return;
     
@@ -836,20 +952,8 @@ async function uploadFiles(files) {
         setStatus('injecting ' + (i+1) + '/' + files.length + ': ' + files[i].name);
         fill.style.width = '0%';
         
-        const formData = new FormData();
-        formData.append('file', files[i]);
-        
         try {
-            await new Promise((resolve, reject) => {
-                const xhr = new XMLHttpRequest();
-                xhr.upload.onprogress = (e) => {
-                    if (e.lengthComputable) fill.style.width = (e.loaded/e.total*100) + '%';
-                };
-                xhr.onload = () => xhr.status === 200 ? resolve() : reject();
-                xhr.onerror = () => reject();
-                xhr.open('POST', '/upload?dir=' + encodeURIComponent(pane.path));
-                xhr.send(formData);
-            });
+            await uploadOne(files[i], pane.path, fill);
             uploaded++;
         } catch(e) {
             setStatus('inject failed: ' + files[i].name);
@@ -935,11 +1039,16 @@ void FileServer::startServer() {
     server->on("/api/move", HTTP_POST, handleMove);
     server->on("/download", HTTP_GET, handleDownload);
     server->on("/upload", HTTP_POST, handleUpload, handleUploadProcess);
+    server->on("/api/upload/begin", HTTP_GET, handleUploadBegin);
     server->on("/delete", HTTP_GET, handleDelete);
     server->on("/rmdir", HTTP_GET, handleDelete);  // Same handler, will detect folder
     server->on("/mkdir", HTTP_GET, handleMkdir);
     server->onNotFound(handleNotFound);
     
+    // Only headers asked for are kept by WebServer
+    static const char* rangeHeaders[] = {"Range", "If-Range"};
+    server->collectHeaders(rangeHeaders, 2);
+    
     server->begin();
     state = FileServerState::RUNNING;
     lastReconnectCheck = millis();
@@ -955,6 +1064,7 @@ void FileServer::stop() {
         uploadFile.close();
         Serial.println("[FILESERVER] Closed pending upload file");
     }
+    resumeUploads.abort();  // Keeps what arrived for a later resume
     
     if (server) {
         server->stop();
@@ -1069,58 +1179,55 @@ void FileServer::handleFileList() {
     
     // Security: prevent directory traversal
     if (dir.indexOf("..") >= 0) {
-        server->send(400, "application/json", "[]");
+        server->send(400, "application/json", "{\"error\":\"Invalid path\"}");
         return;
     }
     
+    String filter = server->arg("filter");
+    
     File root = SD.open(dir);
     if (!root || !root.isDirectory()) {
-        server->send(200, "application/json", "[]");
+        if (root) root.close();
+        server->send(200, "application/json",
+                     server->arg("count") == "1" ? "{\"count\":0}"
+                                                 : "{\"entries\":[],\"offset\":0,\"next\":0,\"more\":false}");
         return;
     }
     
-    String json = "[";
-    bool first = true;
-    
-    File file = root.openNextFile();
-    while (file) {
-        if (!first) json += ",";
-        first = false;
-        
-        // Escape filename for JSON
-        String fname = file.name();
-        fname.replace("\\", "\\\\");
-        fname.replace("\"", "\\\"");
-        
-        json += "{\"name\":\"";
-        json += fname;
-        json += "\",\"size\":";
-        json += String(file.size());
-        if (full) {
-            json += ",\"isDir\":";
-            json += file.isDirectory() ? "true" : "false";
-        }
-        json += "}";
-        
-        file.close();
-        file = root.openNextFile();
+    // Cheap total: walk without formatting anything
+    if (server->arg("count") == "1") {
+        uint32_t n = DirLister<File>::count(root, filter.c_str());
+        root.close();
+        server->send(200, "application/json", "{\"count\":" + String((unsigned long)n) + "}");
+        return;
     }
     
+    DirListOptions opt;
+    opt.offset = (uint32_t)server->arg("offset").toInt();
+    opt.limit = (uint32_t)server->arg("limit").toInt();
+    opt.filter = filter.c_str();
+    opt.full = full;
+    
+    // Chunked transfer: one 1KB buffer however big the directory is
+    server->setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server->send(200, "application/json", "");
+    DirListResult res = dirLister.list(root, opt, [](const char* data, size_t len) {
+        server->sendContent(data, len);
+    });
+    server->sendContent("");  // Terminating chunk
     root.close();
-    json += "]";
-    server->send(200, "application/json", json);
+    
+    Serial.printf("[FILESERVER] ls %s: %lu sent of %lu scanned, %lu chunks\n",
+                  dir.c_str(), (unsigned long)res.sent, (unsigned long)res.scanned,
+                  (unsigned long)res.chunks);
 }
 
 void FileServer::handleDownload() {
     String path = server->arg("f");
-    String dir = server->arg("dir");  // For ZIP download
-    
-    // ZIP download of folder
-    if (!dir.isEmpty()) {
-        // Simple implementation: send files one by one is not possible
-        // Instead, we'll create a simple text manifest for now
-        // Full ZIP requires external library
-        server->send(501, "text/plain", "ZIP download not yet implemented - download files individually");
+    
+    // ZIP of folders and/or files: /download?zip=/a&zip=/b/c.txt
+    if (server->hasArg("zip")) {
+        handleZipDownload();
         return;
     }
     
@@ -1156,17 +1263,203 @@ void FileServer::handleDownload() {
     else if (path.endsWith(".pcap")) contentType = "application/vnd.tcpdump.pcap";
     
     server->sendHeader("Content-Disposition", "attachment; filename=\"" + filename + "\"");
-    server->streamFile(file, contentType);
+    
+    // Validators so a resumed download can tell the file hasn't changed
+    uint32_t size = file.size();
+    char etag[32];
+    char lastModified[32];
+    HttpRange::etag(size, file.getLastWrite(), etag, sizeof(etag));
+    bool haveDate = HttpRange::httpDate(file.getLastWrite(), lastModified, sizeof(lastModified));
+    server->sendHeader("Accept-Ranges", "bytes");
+    server->sendHeader("ETag", etag);
+    if (haveDate) server->sendHeader("Last-Modified", lastModified);
+    
+    uint32_t start = 0, end = 0;
+    RangeResult range = RangeResult::FULL;
+    if (HttpRange::ifRangeMatches(server->header("If-Range").c_str(), etag,
+                                  haveDate ? lastModified : "")) {
+        range = HttpRange::parse(server->header("Range").c_str(), size, start, end);
+    }
+    
+    if (range == RangeResult::UNSATISFIABLE) {
+        server->sendHeader("Content-Range", "bytes */" + String((unsigned long)size));
+        server->send(416, "text/plain", "Range not satisfiable");
+        file.close();
+        return;
+    }
+    
+    if (range == RangeResult::FULL) {
+        server->streamFile(file, contentType);
+        file.close();
+        return;
+    }
+    
+    // 206: just the part the client is missing
+    char contentRange[48];
+    snprintf(contentRange, sizeof(contentRange), "bytes %lu-%lu/%lu",
+             (unsigned long)start, (unsigned long)end, (unsigned long)size);
+    server->sendHeader("Content-Range", contentRange);
+    uint32_t remaining = end - start + 1;
+    server->setContentLength(remaining);
+    server->send(206, contentType, "");
+    
+    if (file.seek(start)) {
+        uint8_t buf[1024];
+        while (remaining > 0) {
+            size_t n = file.read(buf, remaining < sizeof(buf) ? remaining : sizeof(buf));
+            if (n == 0) break;
+            if (server->client().write(buf, n) != n) break;  // Client went away
+            remaining -= n;
+        }
+    }
     file.close();
+    Serial.printf("[FILESERVER] Range %s: %s\n", filename.c_str(), contentRange);
+}
+
+void FileServer::handleZipDownload() {
+    static const int MAX_ZIP_PATHS = 32;
+    String paths[MAX_ZIP_PATHS];
+    const char* pathPtrs[MAX_ZIP_PATHS];
+    int count = 0;
+    
+    for (int i = 0; i < server->args() && count < MAX_ZIP_PATHS; i++) {
+        if (server->argName(i) != "zip") continue;
+        String p = server->arg(i);
+        if (p.isEmpty()) continue;
+        
+        // Security: prevent directory traversal
+        if (p.indexOf("..") >= 0) {
+            server->send(400, "text/plain", "Invalid path");
+            return;
+        }
+        paths[count] = p;
+        pathPtrs[count] = paths[count].c_str();
+        count++;
+    }
+    if (count == 0) {
+        server->send(400, "text/plain", "Missing file path");
+        return;
+    }
+    
+    // One item: name the archive after it
+    String zipName = "porkchop_loot.zip";
+    if (count == 1) {
+        String base = paths[0];
+        while (base.length() > 1 && base.endsWith("/")) base.remove(base.length() - 1);
+        base = base.substring(base.lastIndexOf('/') + 1);
+        if (base.length() > 0) zipName = base + ".zip";
+    }
+    
+    // Over the plain ZIP limits: say so while an error status still can
+    const char* tooBig = zipStream.check(SD, pathPtrs, count);
+    if (tooBig) {
+        server->send(413, "text/plain", String("Can't zip: ") + tooBig);
+        return;
+    }
+    
+    // Chunked transfer straight from the card, nothing staged
+    server->sendHeader("Content-Disposition", "attachment; filename=\"" + zipName + "\"");
+    server->setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server->send(200, "application/zip", "");
+    
+    bool ok = zipStream.write(SD, pathPtrs, count, [](const char* data, size_t len) {
+        server->sendContent(data, len);
+    });
+    server->sendContent("");  // Terminating chunk
+    
+    ZipStreamStats st = zipStream.stats();
+    Serial.printf("[FILESERVER] ZIP %s: %lu files, %lu bytes%s%s\n", zipName.c_str(),
+                  (unsigned long)st.files, (unsigned long)st.bytesOut,
+                  ok ? "" : " - truncated, ", ok ? "" : zipStream.error());
 }
 
 void FileServer::handleUpload() {
-    server->send(200, "text/plain", "OK");
+    if (!uploadResumable) {
+        server->send(200, "text/plain", "OK");
+        return;
+    }
+    
+    // Resumable slice: tell the client where the file stands now
+    uploadResumable = false;
+    String json = "{\"offset\":" + String((unsigned long)uploadOffset) +
+                  ",\"done\":" + (uploadResult == UploadStatus::COMPLETE ? "true" : "false") + "}";
+    switch (uploadResult) {
+        case UploadStatus::OK:
+        case UploadStatus::COMPLETE:
+            server->send(200, "application/json", json);
+            break;
+        case UploadStatus::BAD_OFFSET:
+            server->send(409, "application/json", "{\"error\":\"offset\"}");
+            break;
+        case UploadStatus::UNKNOWN_ID:
+            server->send(404, "application/json", "{\"error\":\"id\"}");
+            break;
+        default:
+            server->send(500, "application/json", "{\"error\":\"write\"}");
+            break;
+    }
+}
+
+// Start or resume a chunked upload: /api/upload/begin?dir=&name=&size=
+void FileServer::handleUploadBegin() {
+    String dir = server->arg("dir");
+    String name = server->arg("name");
+    if (dir.isEmpty()) dir = "/";
+    if (!dir.endsWith("/")) dir += "/";
+    
+    // Security: prevent directory traversal
+    if (name.isEmpty() || name.indexOf("..") >= 0 || name.indexOf('/') >= 0 ||
+        dir.indexOf("..") >= 0) {
+        server->send(400, "application/json", "{\"error\":\"Invalid path\"}");
+        return;
+    }
+    
+    String path = dir + name;
+    uint32_t size = (uint32_t)strtoul(server->arg("size").c_str(), nullptr, 10);
+    char id[UploadResume<fs::FS, File>::ID_LEN + 1];
+    uint32_t offset = 0;
+    if (!resumeUploads.begin(SD, path.c_str(), size, id, offset)) {
+        server->send(400, "application/json", "{\"error\":\"Path too long\"}");
+        return;
+    }
+    noteCaptureChange(path);
+    
+    Serial.printf("[FILESERVER] Upload %s (%lu bytes) id %s from %lu\n", path.c_str(),
+                  (unsigned long)size, id, (unsigned long)offset);
+    server->send(200, "application/json",
+                 String("{\"id\":\"") + id + "\",\"offset\":" + String((unsigned long)offset) + "}");
 }
 
 void FileServer::handleUploadProcess() {
     HTTPUpload& upload = server->upload();
     
+    // Slices of a resumable upload: /upload?id=&offset=
+    if (server->hasArg("id")) {
+        if (upload.status == UPLOAD_FILE_START) {
+            uploadResumable = true;
+            uploadOffset = 0;
+            uploadResult = resumeUploads.open(SD, server->arg("id").c_str(),
+                                              (uint32_t)strtoul(server->arg("offset").c_str(), nullptr, 10));
+        } else if (upload.status == UPLOAD_FILE_WRITE) {
+            if (resumeUploads.receiving() && !resumeUploads.write(upload.buf, upload.currentSize)) {
+                uploadResult = UploadStatus::FAILED;
+            }
+        } else if (upload.status == UPLOAD_FILE_END) {
+            if (resumeUploads.receiving()) {
+                UploadStatus done = resumeUploads.finish(&uploadOffset);
+                if (uploadResult == UploadStatus::OK) uploadResult = done;
+                if (done == UploadStatus::COMPLETE) {
+                    Serial.printf("[FILESERVER] Upload complete: %lu bytes\n", (unsigned long)uploadOffset);
+                }
+            }
+        } else if (upload.status == UPLOAD_FILE_ABORTED) {
+            // Client dropped: keep what arrived, the next slice resumes from there
+            resumeUploads.abort();
+            Serial.println("[FILESERVER] Upload slice aborted - kept for resume");
+        }
+        return;
+    }
+    
     if (upload.status == UPLOAD_FILE_START) {
         uploadDir = server->arg("dir");
         if (uploadDir.isEmpty()) uploadDir = "/";
@@ -1184,6 +1477,7 @@ void FileServer::handleUploadProcess() {
         if (path.startsWith("//")) path = path.substring(1);
         Serial.printf("[FILESERVER] Upload start: %s\n", path.c_str());
         
+        noteCaptureChange(path);
         uploadFile = SD.open(path, FILE_WRITE);
         if (!uploadFile) {
             Serial.println("[FILESERVER] Failed to open file for writing");
@@ -1215,8 +1509,11 @@ bool FileServer::deletePathRecursive(const String& path) {
     f.close();
     
     if (!isDir) {
-        return SD.remove(path);
+        if (!SD.remove(path)) return false;
+        noteCaptureRemoved(path);
+        return true;
     }
+    noteCaptureChange(path);
     
     // It's a directory - delete all contents first (depth-first)
     File dir = SD.open(path);
@@ -1368,6 +1665,8 @@ void FileServer::handleRename() {
         return;
     }
     
+    noteCaptureChange(oldPath);
+    noteCaptureChange(newPath);
     if (SD.rename(oldPath, newPath)) {
         Serial.printf("[FILESERVER] Renamed: %s -> %s\n", oldPath.c_str(), newPath.c_str());
         server->send(200, "application/json", "{\"success\":true}");
@@ -1418,6 +1717,7 @@ bool FileServer::copyFileChunked(const String& srcPath, const String& dstPath) {
 bool FileServer::copyPathRecursive(const String& srcPath, const String& dstPath) {
     File src = SD.open(srcPath);
     if (!src) return false;
+    noteCaptureChange(dstPath);
     
     if (src.isDirectory()) {
         src.close();
@@ -1589,6 +1889,9 @@ void FileServer::handleMove() {
         String filename = (lastSlash >= 0) ? srcPath.substring(lastSlash + 1) : srcPath;
         String dstPath = (destDir == "/") ? "/" + filename : destDir + "/" + filename;
         
+        noteCaptureChange(srcPath);
+        noteCaptureChange(dstPath);
+        
         // Try SD.rename first (fast, atomic)
         if (SD.rename(srcPath, dstPath)) {
             moved++;
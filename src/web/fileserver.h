@@ -45,8 +45,10 @@ private:
     static void handleRoot();
     static void handleFileList();
     static void handleDownload();
+    static void handleZipDownload();
     static void handleUpload();
     static void handleUploadProcess();
+    static void handleUploadBegin();
     static void handleDelete();
     static void handleBulkDelete();
     static void handleMkdir();
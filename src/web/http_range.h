@@ -0,0 +1,86 @@
+// HTTP Range - single byte ranges and If-Range validators for resumable downloads
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+enum class RangeResult {
+    FULL,           // No (usable) Range: send everything with 200
+    PARTIAL,        // Send start..end inclusive with 206
+    UNSATISFIABLE   // Send 416 with "Content-Range: bytes */size"
+};
+
+class HttpRange {
+public:
+    static RangeResult parse(const char* header, uint32_t size,
+                             uint32_t& start, uint32_t& end) {
+        if (!header || strncmp(header, "bytes=", 6) != 0) return RangeResult::FULL;
+        const char* p = header + 6;
+        if (strchr(p, ',')) return RangeResult::FULL;
+        while (*p == ' ') p++;
+
+        uint32_t a = 0, b = 0;
+        bool hasA = number(p, a);
+        if (*p++ != '-') return RangeResult::FULL;
+        bool hasB = number(p, b);
+        while (*p == ' ') p++;
+        if (*p != '\0') return RangeResult::FULL;
+
+        if (!hasA) {
+            // Suffix: the last b bytes
+            if (!hasB) return RangeResult::FULL;
+            if (b == 0 || size == 0) return RangeResult::UNSATISFIABLE;
+            start = b >= size ? 0 : size - b;
+            end = size - 1;
+            return RangeResult::PARTIAL;
+        }
+        if (hasB && b < a) return RangeResult::FULL;
+        if (a >= size) return RangeResult::UNSATISFIABLE;
+        start = a;
+        end = (!hasB || b >= size) ? size - 1 : b;
+        return RangeResult::PARTIAL;
+    }
+
+    // Strong validator from what FAT gives us: size and mtime
+    static void etag(uint32_t size, time_t mtime, char* out, size_t n) {
+        snprintf(out, n, "\"%lx-%lx\"", (unsigned long)size, (unsigned long)mtime);
+    }
+
+    // IMF-fixdate, e.g. "Sun, 06 Nov 1994 08:49:37 GMT". False without a clock.
+    static bool httpDate(time_t t, char* out, size_t n) {
+        struct tm tmv;
+        if (t <= 0 || !gmtime_r(&t, &tmv) || tmv.tm_year < 80) return false;
+        static const char* days[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+        static const char* months[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                                       "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+        snprintf(out, n, "%s, %02d %s %04d %02d:%02d:%02d GMT", days[tmv.tm_wday],
+                 tmv.tm_mday, months[tmv.tm_mon], tmv.tm_year + 1900,
+                 tmv.tm_hour, tmv.tm_min, tmv.tm_sec);
+        return true;
+    }
+
+    // An absent If-Range lets the Range through; otherwise it must be our
+    // ETag or our Last-Modified exactly
+    static bool ifRangeMatches(const char* ifRange, const char* etag,
+                               const char* lastModified) {
+        if (!ifRange || !*ifRange) return true;
+        if (etag && strcmp(ifRange, etag) == 0) return true;
+        return lastModified && *lastModified && strcmp(ifRange, lastModified) == 0;
+    }
+
+private:
+    static bool number(const char*& p, uint32_t& v) {
+        const char* s = p;
+        uint64_t x = 0;
+        while (*p >= '0' && *p <= '9') {
+            x = x * 10 + (*p - '0');
+            if (x > 0xFFFFFFFFull) x = 0xFFFFFFFFull;  // Clamp, FAT files are < 4GB
+            p++;
+        }
+        v = (uint32_t)x;
+        return p != s;
+    }
+};
@@ -0,0 +1,313 @@
+// Upload Journal - set of uploaded file names, persisted as an append-only log
+// Main loop only. compact() rewrites the log once dead lines outnumber live names.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+// Open-addressing set of nonzero 32-bit digests (linear probing,
+// backward-shift erase, so no tombstones)
+class DigestSet {
+public:
+    DigestSet() : count(0) {}
+
+    static uint32_t digest(const char* s, size_t len) {
+        uint32_t h = 2166136261u;  // FNV-1a
+        for (size_t i = 0; i < len; i++) {
+            h ^= (uint8_t)s[i];
+            h *= 16777619u;
+        }
+        return h ? h : 1;  // 0 marks an empty slot
+    }
+
+    bool contains(uint32_t d) const {
+        if (slots.empty()) return false;
+        size_t mask = slots.size() - 1;
+        for (size_t i = home(d); slots[i]; i = (i + 1) & mask) {
+            if (slots[i] == d) return true;
+        }
+        return false;
+    }
+
+    // False if already present
+    bool insert(uint32_t d) {
+        if ((count + 1) * 4 > slots.size() * 3) grow();
+        size_t mask = slots.size() - 1;
+        size_t i = home(d);
+        for (; slots[i]; i = (i + 1) & mask) {
+            if (slots[i] == d) return false;
+        }
+        slots[i] = d;
+        count++;
+        return true;
+    }
+
+    // False if absent
+    bool erase(uint32_t d) {
+        if (slots.empty()) return false;
+        size_t mask = slots.size() - 1;
+        size_t i = home(d);
+        for (; slots[i] != d; i = (i + 1) & mask) {
+            if (!slots[i]) return false;
+        }
+        // Pull later members of the run back over the hole
+        size_t j = i;
+        for (;;) {
+            j = (j + 1) & mask;
+            if (!slots[j]) break;
+            size_t h = home(slots[j]);
+            if (((j - h) & mask) >= ((j - i) & mask)) {
+                slots[i] = slots[j];
+                i = j;
+            }
+        }
+        slots[i] = 0;
+        count--;
+        return true;
+    }
+
+    void clear() {
+        std::vector<uint32_t>().swap(slots);
+        count = 0;
+    }
+
+    size_t size() const { return count; }
+    size_t bytes() const { return slots.size() * sizeof(uint32_t); }
+
+private:
+    size_t home(uint32_t d) const {
+        return (d ^ (d >> 16)) & (slots.size() - 1);
+    }
+
+    void grow() {
+        std::vector<uint32_t> old;
+        old.swap(slots);
+        slots.assign(old.empty() ? 16 : old.size() * 2, 0);
+        count = 0;
+        for (uint32_t d : old) {
+            if (d) insert(d);
+        }
+    }
+
+    std::vector<uint32_t> slots;
+    size_t count;
+};
+
+struct UploadJournalStats {
+    uint32_t live;          // Names in the set
+    uint32_t dead;          // Lines in the file that don't add a live name
+    uint32_t appends;       // Lines written since load
+    uint32_t compactions;   // File rewrites
+};
+
+template <typename FsT, typename FileT>
+class UploadJournal {
+public:
+    static const size_t MAX_PATH = 48;
+    static const size_t MAX_NAME = 100;
+    static const uint32_t COMPACT_MIN_DEAD = 32;
+
+    UploadJournal() : fs(nullptr), ready(false) {
+        journalPath[0] = '\0';
+        memset(&st, 0, sizeof(st));
+    }
+
+    UploadJournal(const UploadJournal&) = delete;
+    UploadJournal& operator=(const UploadJournal&) = delete;
+
+    // Replay the journal at path. A missing file is an empty set.
+    bool load(FsT& fsys, const char* path) {
+        end();
+        if (!path || strlen(path) >= MAX_PATH) return false;
+        fs = &fsys;
+        strcpy(journalPath, path);
+        recover();
+        uint32_t lines = 0;
+        if (fs->exists(journalPath)) {
+            FileT f = fs->open(journalPath, "r");
+            if (!f) return false;
+            forEachLine(f, [&](const char* line, size_t len) {
+                lines++;
+                if (line[0] == '-') set.erase(DigestSet::digest(line + 1, len - 1));
+                else set.insert(DigestSet::digest(line, len));
+            });
+            f.close();
+        }
+        st.live = set.size();
+        st.dead = lines - st.live;
+        ready = true;
+        return true;
+    }
+
+    void end() {
+        set.clear();
+        ready = false;
+        memset(&st, 0, sizeof(st));
+    }
+
+    bool isLoaded() const { return ready; }
+
+    bool contains(const char* name) const {
+        size_t len = name ? strlen(name) : 0;
+        return len > 0 && set.contains(DigestSet::digest(name, len));
+    }
+
+    // Track name; one appended line, nothing rewritten
+    bool add(const char* name) {
+        if (!valid(name) || contains(name)) return false;
+        if (!append("", name)) return false;
+        set.insert(DigestSet::digest(name, strlen(name)));
+        st.live++;
+        return true;
+    }
+
+    bool remove(const char* name) {
+        if (!valid(name) || !contains(name)) return false;
+        if (!append("-", name)) return false;
+        set.erase(DigestSet::digest(name, strlen(name)));
+        st.live--;
+        st.dead += 2;  // The removal and the line it cancels
+        return true;
+    }
+
+    size_t size() const { return set.size(); }
+    size_t bytes() const { return set.bytes(); }
+
+    // Rewrite the file without dead lines once they outnumber the live ones
+    bool compactIfNeeded() {
+        if (st.dead < COMPACT_MIN_DEAD || st.dead <= st.live) return false;
+        return compact();
+    }
+
+    // The old journal is renamed aside, not removed, until the new one is
+    // in place: a power cut at any step leaves a complete file load() finds
+    bool compact() {
+        if (!ready || !fs->exists(journalPath)) return false;
+        char tmpPath[MAX_PATH + 4], bakPath[MAX_PATH + 4];
+        sidePath(tmpPath, ".tmp");
+        sidePath(bakPath, ".bak");
+        FileT in = fs->open(journalPath, "r");
+        if (!in) return false;
+        FileT out = fs->open(tmpPath, "w");
+        if (!out) {
+            in.close();
+            return false;
+        }
+
+        // First line of each live name; the copied set skips repeats
+        DigestSet copied;
+        bool ok = true;
+        forEachLine(in, [&](const char* line, size_t len) {
+            if (!ok || line[0] == '-') return;
+            uint32_t d = DigestSet::digest(line, len);
+            if (!set.contains(d) || !copied.insert(d)) return;
+            ok = out.write((const uint8_t*)line, len) == len &&
+                 out.write((const uint8_t*)"\n", 1) == 1;
+        });
+        in.close();
+        out.close();
+        if (!ok || copied.size() != set.size()) {
+            fs->remove(tmpPath);
+            return false;
+        }
+        fs->remove(bakPath);
+        if (!fs->rename(journalPath, bakPath)) {
+            fs->remove(tmpPath);
+            return false;
+        }
+        if (!fs->rename(tmpPath, journalPath)) {
+            fs->rename(bakPath, journalPath);
+            return false;
+        }
+        fs->remove(bakPath);
+        st.dead = 0;
+        st.compactions++;
+        return true;
+    }
+
+    UploadJournalStats stats() const { return st; }
+
+private:
+    static bool valid(const char* name) {
+        if (!name || !*name || name[0] == '-') return false;
+        size_t len = strlen(name);
+        return len < MAX_NAME && !strpbrk(name, "\r\n");
+    }
+
+    void sidePath(char* out, const char* ext) const {
+        snprintf(out, MAX_PATH + 4, "%s%s", journalPath, ext);
+    }
+
+    // Finish or undo a compaction cut short: with the journal missing, the
+    // backup (old journal) or failing that the finished tmp becomes it
+    void recover() {
+        char tmpPath[MAX_PATH + 4], bakPath[MAX_PATH + 4];
+        sidePath(tmpPath, ".tmp");
+        sidePath(bakPath, ".bak");
+        if (!fs->exists(journalPath)) {
+            if (fs->exists(bakPath)) fs->rename(bakPath, journalPath);
+            else if (fs->exists(tmpPath)) fs->rename(tmpPath, journalPath);
+        }
+        if (fs->exists(journalPath)) {
+            if (fs->exists(bakPath)) fs->remove(bakPath);
+            if (fs->exists(tmpPath)) fs->remove(tmpPath);
+        }
+    }
+
+    bool append(const char* prefix, const char* name) {
+        if (!ready) return false;
+        FileT f = fs->open(journalPath, "a");
+        if (!f) return false;
+        size_t p = strlen(prefix), n = strlen(name);
+        bool ok = f.write((const uint8_t*)prefix, p) == p &&
+                  f.write((const uint8_t*)name, n) == n &&
+                  f.write((const uint8_t*)"\n", 1) == 1;
+        f.close();
+        if (ok) st.appends++;
+        return ok;
+    }
+
+    // fn(line, len) for each non-empty line, trimmed; over-long lines skipped
+    template <typename Fn>
+    static void forEachLine(FileT& f, Fn fn) {
+        uint8_t chunk[256];
+        char line[MAX_NAME + 1];
+        size_t len = 0;
+        bool tooLong = false;
+        for (;;) {
+            size_t n = f.read(chunk, sizeof(chunk));
+            for (size_t i = 0; i < n; i++) {
+                if (chunk[i] != '\n') {
+                    if (len < MAX_NAME) line[len++] = (char)chunk[i];
+                    else tooLong = true;
+                    continue;
+                }
+                if (!tooLong) emitLine(line, len, fn);
+                len = 0;
+                tooLong = false;
+            }
+            if (n < sizeof(chunk)) break;
+        }
+        if (!tooLong) emitLine(line, len, fn);  // Unterminated last line
+    }
+
+    template <typename Fn>
+    static void emitLine(char* line, size_t len, Fn& fn) {
+        while (len > 0 && strchr(" \t\r", line[len - 1])) len--;
+        size_t start = 0;
+        while (start < len && strchr(" \t", line[start])) start++;
+        len -= start;
+        if (len == 0 || (len == 1 && line[start] == '-')) return;
+        line[start + len] = '\0';
+        fn(line + start, len);
+    }
+
+    FsT* fs;
+    DigestSet set;
+    bool ready;
+    char journalPath[MAX_PATH];
+    UploadJournalStats st;
+};
@@ -0,0 +1,253 @@
+// Upload Resume - chunked uploads that continue from <path>.<id>.part after a drop
+// The part file's size is the committed offset. Main loop only.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum class UploadStatus {
+    OK,          // Slice stored, more to come
+    COMPLETE,    // Whole file arrived and is in place
+    BAD_OFFSET,  // Slice doesn't start at the committed offset
+    UNKNOWN_ID,  // No such upload (server restarted: begin again)
+    FAILED       // Card error
+};
+
+struct UploadResumeStats {
+    uint32_t slices;         // Slices accepted
+    uint32_t rejected;       // Slices refused (offset or id)
+    uint32_t writes;         // File write() calls
+    uint32_t alignedWrites;  // ... that started and ended on a sector boundary
+    uint32_t bytes;          // Bytes the file accepted
+    uint32_t completed;      // Uploads renamed into place
+};
+
+template <typename FsT, typename FileT, size_t CAP = 4096, uint8_t SLOTS = 4>
+class UploadResume {
+    static_assert(CAP >= 512 && CAP % 512 == 0, "UploadResume buffer must be whole sectors");
+
+public:
+    static const size_t MAX_PATH = 128;
+    static const size_t ID_LEN = 8;
+    static const uint32_t SECTOR = 512;
+
+    UploadResume() : buf(nullptr), cur(nullptr), used(0), limit(0), fileOffset(0), clock(0) {
+        memset(slots, 0, sizeof(slots));
+        memset(&st, 0, sizeof(st));
+    }
+    ~UploadResume() { abort(); }
+
+    UploadResume(const UploadResume&) = delete;
+    UploadResume& operator=(const UploadResume&) = delete;
+
+    // Register the upload of total bytes to path (or find it again). id
+    // gets ID_LEN hex chars, offset where the client should continue.
+    bool begin(FsT& fs, const char* path, uint32_t total, char* id, uint32_t& offset) {
+        if (!path || strlen(path) >= MAX_PATH) return false;
+        char part[MAX_PATH];
+        makeId(path, total, id);
+        if (!partPath(path, id, part)) return false;  // No room for the suffix
+        slotFor(fs, path, total);
+
+        offset = 0;
+        if (fs.exists(part)) {
+            FileT f = fs.open(part, "r");
+            uint32_t have = f ? (uint32_t)f.size() : 0;
+            if (f) f.close();
+            if (have > total) fs.remove(part);  // Not ours after all
+            else offset = have;
+        }
+        return true;
+    }
+
+    // Start receiving a slice at offset
+    UploadStatus open(FsT& fs, const char* id, uint32_t offset) {
+        abort();
+        Slot* s = find(id);
+        if (!s) {
+            st.rejected++;
+            return UploadStatus::UNKNOWN_ID;
+        }
+        char part[MAX_PATH];
+        if (!partPath(s->path, s->id, part)) return UploadStatus::FAILED;
+        uint32_t have = 0;
+        if (fs.exists(part)) {
+            FileT f = fs.open(part, "r");
+            if (f) {
+                have = (uint32_t)f.size();
+                f.close();
+            }
+        }
+        if (offset != have || offset > s->total) {
+            st.rejected++;
+            return UploadStatus::BAD_OFFSET;
+        }
+        buf = (uint8_t*)malloc(CAP);
+        if (!buf) return UploadStatus::FAILED;
+        file = fs.open(part, have ? "a" : "w");
+        if (!file) {
+            free(buf);
+            buf = nullptr;
+            return UploadStatus::FAILED;
+        }
+        cur = s;
+        curFs = &fs;
+        s->lastUse = ++clock;
+        used = 0;
+        fileOffset = offset;
+        limit = CAP - offset % SECTOR;  // Land later writes on sector boundaries
+        failed = false;
+        st.slices++;
+        return UploadStatus::OK;
+    }
+
+    bool receiving() const { return cur != nullptr; }
+
+    // More bytes of the current slice
+    bool write(const uint8_t* data, size_t len) {
+        if (!cur || failed) return false;
+        if (fileOffset + used + len > cur->total) {
+            failed = true;  // Longer than announced
+            return false;
+        }
+        while (len > 0) {
+            size_t take = limit - used;
+            if (take > len) take = len;
+            memcpy(buf + used, data, take);
+            used += take;
+            data += take;
+            len -= take;
+            if (used == limit) drain();
+        }
+        return !failed;
+    }
+
+    // End of the slice: write what's buffered, and put the file in place
+    // once it's all there
+    UploadStatus finish(uint32_t* offset = nullptr) {
+        if (!cur) return UploadStatus::UNKNOWN_ID;
+        drain();
+        file.close();
+        free(buf);
+        buf = nullptr;
+        Slot* s = cur;
+        cur = nullptr;
+        if (offset) *offset = fileOffset;
+        if (failed) return UploadStatus::FAILED;
+        if (fileOffset < s->total) return UploadStatus::OK;
+
+        char part[MAX_PATH];
+        if (!partPath(s->path, s->id, part)) return UploadStatus::FAILED;
+        if (curFs->exists(s->path)) curFs->remove(s->path);
+        if (!curFs->rename(part, s->path)) return UploadStatus::FAILED;
+        s->inUse = false;
+        st.completed++;
+        return UploadStatus::COMPLETE;
+    }
+
+    // Connection dropped mid-slice: keep what arrived so it can resume
+    void abort() {
+        if (!cur) return;
+        drain();
+        file.close();
+        free(buf);
+        buf = nullptr;
+        cur = nullptr;
+    }
+
+    // Bytes committed for the slice being received
+    uint32_t committed() const { return fileOffset; }
+
+    UploadResumeStats stats() const { return st; }
+
+private:
+    struct Slot {
+        bool inUse;
+        uint32_t lastUse;
+        uint32_t total;
+        char id[ID_LEN + 1];
+        char path[MAX_PATH];
+    };
+
+    Slot* find(const char* id) {
+        if (!id) return nullptr;
+        for (uint8_t i = 0; i < SLOTS; i++) {
+            if (slots[i].inUse && strcmp(slots[i].id, id) == 0) return &slots[i];
+        }
+        return nullptr;
+    }
+
+    // Same path and size, same slot; else a free one or the least recently
+    // used, whose part file goes with it (that upload can't resume anyway)
+    Slot* slotFor(FsT& fs, const char* path, uint32_t total) {
+        char id[ID_LEN + 1];
+        makeId(path, total, id);
+        Slot* s = find(id);
+        if (s) return s;
+        s = &slots[0];
+        for (uint8_t i = 0; i < SLOTS; i++) {
+            if (!slots[i].inUse) {
+                s = &slots[i];
+                break;
+            }
+            if (slots[i].lastUse < s->lastUse) s = &slots[i];
+        }
+        if (s == cur) abort();
+        if (s->inUse) {
+            char part[MAX_PATH];
+            if (partPath(s->path, s->id, part) && fs.exists(part)) fs.remove(part);
+        }
+        s->inUse = true;
+        s->lastUse = ++clock;
+        s->total = total;
+        strcpy(s->id, id);
+        strcpy(s->path, path);
+        return s;
+    }
+
+    static void makeId(const char* path, uint32_t total, char* out) {
+        uint32_t h = 2166136261u;  // FNV-1a over path then size
+        for (const char* p = path; *p; p++) {
+            h ^= (uint8_t)*p;
+            h *= 16777619u;
+        }
+        for (int i = 0; i < 4; i++) {
+            h ^= (uint8_t)(total >> (i * 8));
+            h *= 16777619u;
+        }
+        snprintf(out, ID_LEN + 1, "%08lx", (unsigned long)h);
+    }
+
+    // False if "path.id.part" doesn't fit MAX_PATH
+    static bool partPath(const char* path, const char* id, char* out) {
+        int n = snprintf(out, MAX_PATH, "%s.%s.part", path, id);
+        return n > 0 && (size_t)n < MAX_PATH;
+    }
+
+    void drain() {
+        if (used == 0) return;
+        size_t w = file.write(buf, used);
+        st.writes++;
+        if (fileOffset % SECTOR == 0 && used % SECTOR == 0) st.alignedWrites++;
+        st.bytes += w;
+        fileOffset += w;
+        if (w != used) failed = true;
+        used = 0;
+        limit = CAP;
+    }
+
+    Slot slots[SLOTS];
+    FsT* curFs = nullptr;
+    FileT file;
+    uint8_t* buf;
+    Slot* cur;
+    size_t used;
+    size_t limit;
+    uint32_t fileOffset;
+    uint32_t clock;
+    bool failed = false;
+    UploadResumeStats st;
+};
@@ -8,16 +8,23 @@
 #include <base64.h>
 #include "../core/config.h"
 #include "../core/sdlog.h"
+#include "upload_journal.h"
 
 // Static member initialization
 char WiGLE::lastError[64] = "";
 char WiGLE::statusMessage[64] = "READY";
-std::vector<String> WiGLE::uploadedFiles;
-bool WiGLE::listLoaded = false;
+
+// Uploaded file names (digest set + append-only journal on SD)
+static UploadJournal<fs::FS, File> uploadedFiles;
+
+// Tracking is by file name; no String copy on the per-file menu check
+static const char* baseName(const char* path) {
+    const char* slash = strrchr(path, '/');
+    return slash ? slash + 1 : path;
+}
 
 void WiGLE::init() {
-    uploadedFiles.clear();
-    listLoaded = false;
+    uploadedFiles.end();
     strcpy(lastError, "");
     strcpy(statusMessage, "READY");
     loadUploadedList();
@@ -84,80 +91,36 @@ bool WiGLE::isConnected() {
 // ============================================================================
 
 bool WiGLE::loadUploadedList() {
-    if (listLoaded) return true;  // Already loaded, skip SD read
-    
-    uploadedFiles.clear();
-    
-    if (!SD.exists(UPLOADED_FILE)) {
-        listLoaded = true;
-        return true;  // No file yet, that's OK
-    }
-    
-    File f = SD.open(UPLOADED_FILE, FILE_READ);
-    if (!f) return false;
-    
-    while (f.available() && uploadedFiles.size() < 200) {
-        String line = f.readStringUntil('\n');
-        line.trim();
-        if (!line.isEmpty() && line.length() < 100) {  // Sanity check
-            uploadedFiles.push_back(line);
-        }
-    }
+    if (uploadedFiles.isLoaded()) return true;  // Already loaded, skip SD read
     
-    f.close();
-    listLoaded = true;
-    Serial.printf("[WIGLE] Loaded %d uploaded files from tracking\n", uploadedFiles.size());
-    return true;
-}
-
-bool WiGLE::saveUploadedList() {
-    File f = SD.open(UPLOADED_FILE, FILE_WRITE);
-    if (!f) return false;
-    
-    for (const auto& filename : uploadedFiles) {
-        f.println(filename);
+    if (!uploadedFiles.load(SD, UPLOADED_FILE)) return false;
+    if (uploadedFiles.compactIfNeeded()) {
+        Serial.println("[WIGLE] Compacted upload tracking file");
     }
-    
-    f.close();
+    Serial.printf("[WIGLE] Loaded %u uploaded files from tracking\n", (unsigned)uploadedFiles.size());
     return true;
 }
 
 bool WiGLE::isUploaded(const char* filename) {
     loadUploadedList();
-    String name = getFilenameFromPath(filename);
-    for (const auto& uploaded : uploadedFiles) {
-        if (uploaded == name) return true;
-    }
-    return false;
+    return uploadedFiles.contains(baseName(filename));
 }
 
 void WiGLE::markUploaded(const char* filename) {
-    String name = getFilenameFromPath(filename);
-    // Check if already in list
-    for (const auto& uploaded : uploadedFiles) {
-        if (uploaded == name) return;
-    }
-    // Cap at 200 entries to prevent unbounded memory growth
-    if (uploadedFiles.size() >= 200) {
-        uploadedFiles.erase(uploadedFiles.begin());  // Remove oldest
-    }
-    uploadedFiles.push_back(name);
-    saveUploadedList();
+    if (!loadUploadedList()) return;
+    uploadedFiles.add(baseName(filename));  // Appends one line
 }
 
 void WiGLE::removeFromUploaded(const char* filename) {
-    String name = getFilenameFromPath(filename);
-    for (auto it = uploadedFiles.begin(); it != uploadedFiles.end(); ++it) {
-        if (*it == name) {
-            uploadedFiles.erase(it);
-            saveUploadedList();
-            Serial.printf("[WIGLE] Removed from uploaded tracking: %s\n", name.c_str());
-            return;
-        }
+    if (!loadUploadedList()) return;
+    const char* name = baseName(filename);
+    if (uploadedFiles.remove(name)) {
+        Serial.printf("[WIGLE] Removed from uploaded tracking: %s\n", name);
+        uploadedFiles.compactIfNeeded();
     }
 }
 
-uint16_t WiGLE::getUploadedCount() {
+uint32_t WiGLE::getUploadedCount() {
     loadUploadedList();
     return uploadedFiles.size();
 }
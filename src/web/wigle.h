@@ -3,7 +3,6 @@
 #pragma once
 
 #include <Arduino.h>
-#include <vector>
 
 // Upload status for tracking
 enum class WigleUploadStatus {
@@ -29,7 +28,7 @@ public:
     static bool isUploaded(const char* filename);     // Check if already uploaded
     static void markUploaded(const char* filename);   // Mark as uploaded
     static void removeFromUploaded(const char* filename); // Remove from tracking
-    static uint16_t getUploadedCount();               // Total uploads tracked
+    static uint32_t getUploadedCount();               // Total uploads tracked
     
     // Status
     static const char* getLastError();
@@ -42,10 +41,6 @@ private:
     static char lastError[64];
     static char statusMessage[64];
     
-    // Uploaded files tracking
-    static std::vector<String> uploadedFiles;
-    static bool listLoaded;  // Guard for lazy loading
-    
     // File paths
     static constexpr const char* UPLOADED_FILE = "/wigle_uploaded.txt";
     
@@ -55,7 +50,6 @@ private:
     
     // Helpers
     static bool loadUploadedList();
-    static bool saveUploadedList();
     static String getFilenameFromPath(const char* path);
 };
 
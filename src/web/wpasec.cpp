@@ -7,18 +7,16 @@
 #include <SD.h>
 #include "../core/config.h"
 #include "../core/sdlog.h"
+#include "wpasec_store.h"
 
 // Static member initialization
-bool WPASec::cacheLoaded = false;
 char WPASec::lastError[64] = "";
 char WPASec::statusMessage[64] = "READY";
-std::map<String, WPASec::CacheEntry> WPASec::crackedCache;
-std::map<String, bool> WPASec::uploadedCache;
+
+static WpaSecStore<fs::FS, File> cache;
 
 void WPASec::init() {
-    cacheLoaded = false;
-    crackedCache.clear();
-    uploadedCache.clear();
+    cache.end();
     strcpy(lastError, "");
     strcpy(statusMessage, "READY");
 }
@@ -79,123 +77,24 @@ bool WPASec::isConnected() {
     return WiFi.status() == WL_CONNECTED;
 }
 
-// ============================================================================
-// BSSID Normalization
-// ============================================================================
-
-String WPASec::normalizeBSSID(const char* bssid) {
-    // Remove colons/dashes, convert to uppercase
-    String result;
-    for (int i = 0; bssid[i]; i++) {
-        char c = bssid[i];
-        if (c != ':' && c != '-') {
-            result += (char)toupper(c);
-        }
-    }
-    return result;
-}
-
 // ============================================================================
 // Cache Management
 // ============================================================================
 
 bool WPASec::loadCache() {
-    if (cacheLoaded) return true;
+    if (cache.isLoaded()) return true;
     
-    crackedCache.clear();
-    
-    if (!SD.exists(CACHE_FILE)) {
-        cacheLoaded = true;
-        return true;  // No cache yet, that's OK
-    }
-    
-    File f = SD.open(CACHE_FILE, FILE_READ);
-    if (!f) {
+    // Binary snapshot when it matches both text files, else parse and rebuild it
+    if (!cache.load(SD, CACHE_FILE, UPLOADED_FILE, SNAPSHOT_FILE)) {
         strcpy(lastError, "CANNOT OPEN CACHE");
         return false;
     }
     
-    // Format: BSSID:SSID:password (one per line)
-    // Cap at 500 entries to prevent memory exhaustion
-    while (f.available() && crackedCache.size() < 500) {
-        String line = f.readStringUntil('\n');
-        line.trim();
-        if (line.isEmpty()) continue;
-        
-        int firstColon = line.indexOf(':');
-        int lastColon = line.lastIndexOf(':');
-        
-        if (firstColon > 0 && lastColon > firstColon) {
-            String bssid = line.substring(0, firstColon);
-            String ssid = line.substring(firstColon + 1, lastColon);
-            String password = line.substring(lastColon + 1);
-            
-            bssid = normalizeBSSID(bssid.c_str());
-            
-            CacheEntry entry;
-            entry.ssid = ssid;
-            entry.password = password;
-            crackedCache[bssid] = entry;
-        }
-    }
-    
-    f.close();
-    cacheLoaded = true;
-    
-    // Also load uploaded list
-    loadUploadedList();
-    
-    Serial.printf("[WPASEC] Cache loaded: %d cracked, %d uploaded\n", 
-                  crackedCache.size(), uploadedCache.size());
-    return true;
-}
-
-bool WPASec::saveCache() {
-    File f = SD.open(CACHE_FILE, FILE_WRITE);
-    if (!f) {
-        strcpy(lastError, "CANNOT WRITE CACHE");
-        return false;
-    }
-    
-    for (auto& pair : crackedCache) {
-        f.printf("%s:%s:%s\n", pair.first.c_str(), 
-                 pair.second.ssid.c_str(), pair.second.password.c_str());
-    }
-    
-    f.close();
-    return true;
-}
-
-bool WPASec::loadUploadedList() {
-    uploadedCache.clear();
-    
-    if (!SD.exists(UPLOADED_FILE)) return true;
-    
-    File f = SD.open(UPLOADED_FILE, FILE_READ);
-    if (!f) return false;
-    
-    // Cap at 500 entries to prevent memory exhaustion
-    while (f.available() && uploadedCache.size() < 500) {
-        String line = f.readStringUntil('\n');
-        line.trim();
-        if (!line.isEmpty()) {
-            uploadedCache[normalizeBSSID(line.c_str())] = true;
-        }
-    }
-    
-    f.close();
-    return true;
-}
-
-bool WPASec::saveUploadedList() {
-    File f = SD.open(UPLOADED_FILE, FILE_WRITE);
-    if (!f) return false;
-    
-    for (auto& pair : uploadedCache) {
-        f.println(pair.first);
-    }
-    
-    f.close();
+    TextStoreStats st = cache.stats();
+    Serial.printf("[WPASEC] Cache loaded%s: %u cracked, %u uploaded (%u bytes)\n",
+                  st.snapshotLoads ? " from snapshot" : "",
+                  (unsigned)cache.crackedCount(), (unsigned)cache.uploadedCount(),
+                  (unsigned)cache.bytes());
     return true;
 }
 
@@ -204,49 +103,46 @@ bool WPASec::saveUploadedList() {
 // ============================================================================
 
 bool WPASec::isCracked(const char* bssid) {
-    loadCache();
-    String key = normalizeBSSID(bssid);
-    return crackedCache.find(key) != crackedCache.end();
+    uint64_t key;
+    if (!loadCache() || !cache.parseKey(bssid, key)) return false;
+    return cache.isCracked(key);
 }
 
 String WPASec::getPassword(const char* bssid) {
-    loadCache();
-    String key = normalizeBSSID(bssid);
-    auto it = crackedCache.find(key);
-    if (it != crackedCache.end()) {
-        return it->second.password;
+    uint64_t key;
+    char password[256];
+    if (!loadCache() || !cache.parseKey(bssid, key) ||
+        !cache.password(key, password, sizeof(password))) {
+        return "";
     }
-    return "";
+    return String(password);
 }
 
 String WPASec::getSSID(const char* bssid) {
-    loadCache();
-    String key = normalizeBSSID(bssid);
-    auto it = crackedCache.find(key);
-    if (it != crackedCache.end()) {
-        return it->second.ssid;
+    uint64_t key;
+    char ssid[256];
+    if (!loadCache() || !cache.parseKey(bssid, key) ||
+        !cache.ssid(key, ssid, sizeof(ssid))) {
+        return "";
     }
-    return "";
+    return String(ssid);
 }
 
 uint16_t WPASec::getCrackedCount() {
     loadCache();
-    return crackedCache.size();
+    return cache.crackedCount();
 }
 
 bool WPASec::isUploaded(const char* bssid) {
-    loadCache();
-    String key = normalizeBSSID(bssid);
-    // Cracked implies uploaded
-    if (crackedCache.find(key) != crackedCache.end()) return true;
-    return uploadedCache.find(key) != uploadedCache.end();
+    uint64_t key;
+    if (!loadCache() || !cache.parseKey(bssid, key)) return false;
+    return cache.isUploaded(key);  // Cracked implies uploaded
 }
 
 void WPASec::markUploaded(const char* bssid) {
-    loadCache();
-    String key = normalizeBSSID(bssid);
-    uploadedCache[key] = true;
-    saveUploadedList();
+    uint64_t key;
+    if (!loadCache() || !cache.parseKey(bssid, key)) return;
+    cache.markUploaded(key);  // Appends one line, refreshes the snapshot
 }
 
 // ============================================================================
@@ -294,6 +190,9 @@ bool WPASec::fetchResults() {
         return false;
     }
     
+    // Merge into the stored results, not over them
+    if (!loadCache()) return false;
+    
     // Parse response: BSSID:SSID:password lines
     String response = http.getString();
     http.end();
@@ -323,16 +222,9 @@ bool WPASec::fetchResults() {
         // Potfile BSSIDs are 12 chars without colons
         if (line.length() < 28) continue;  // At minimum: 12 + 1 + 12 + 1 + 1 + 1 = 28
         
-        // Extract BSSID (first 12 chars)
-        String bssid = line.substring(0, 12);
-        
-        // Verify it looks like a hex BSSID
-        bool validBssid = true;
-        for (int i = 0; i < 12; i++) {
-            char c = bssid[i];
-            if (!isxdigit(c)) { validBssid = false; break; }
-        }
-        if (!validBssid) continue;
+        // BSSID = first 12 chars, all hex digits
+        uint64_t bssidKey;
+        if (!cache.parseKey(line.c_str(), 12, bssidKey)) continue;
         
         // Check for colon after BSSID
         if (line[12] != ':') continue;
@@ -352,29 +244,25 @@ bool WPASec::fetchResults() {
         
         if (password.isEmpty()) continue;
         
-        String bssidKey = normalizeBSSID(bssid.c_str());
-        
         // Don't log password for security
-        Serial.printf("[WPASEC] Found: %s (%s)\n", ssid.c_str(), bssidKey.c_str());
+        Serial.printf("[WPASEC] Found: %s (%.12s)\n", ssid.c_str(), line.c_str());
         
-        // Check if this is new
-        if (crackedCache.find(bssidKey) == crackedCache.end()) {
+        // True only for a BSSID that wasn't cracked before
+        if (cache.putCracked(bssidKey, ssid.c_str(), ssid.length(),
+                             password.c_str(), password.length())) {
             newCracks++;
         }
-        
-        CacheEntry entry;
-        entry.ssid = ssid;
-        entry.password = password;
-        crackedCache[bssidKey] = entry;
     }
     
-    // Save updated cache
-    saveCache();
+    // Save updated cache (text file, then snapshot)
+    if (!cache.saveResults()) {
+        strcpy(lastError, "CANNOT WRITE CACHE");
+    }
     
-    snprintf(statusMessage, sizeof(statusMessage), "%d cracked (%d new)", 
-             crackedCache.size(), newCracks);
-    Serial.printf("[WPASEC] Fetched: %d total, %d new\n", crackedCache.size(), newCracks);
-    SDLog::log("WPASEC", "Fetched: %d cracked (%d new)", crackedCache.size(), newCracks);
+    unsigned cracked = cache.crackedCount();
+    snprintf(statusMessage, sizeof(statusMessage), "%u cracked (%d new)", cracked, newCracks);
+    Serial.printf("[WPASEC] Fetched: %u total, %d new\n", cracked, newCracks);
+    SDLog::log("WPASEC", "Fetched: %u cracked (%d new)", cracked, newCracks);
     
     return true;
 }
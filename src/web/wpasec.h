@@ -3,7 +3,6 @@
 #pragma once
 
 #include <Arduino.h>
-#include <map>
 
 // Upload status for tracking
 enum class WPASecUploadStatus {
@@ -26,8 +25,8 @@ public:
     static bool uploadCapture(const char* pcapPath); // POST pcap file to WPA-SEC
     
     // Local cache queries (no WiFi needed)
-    static bool loadCache();                         // Load cache from SD
-    static bool isCracked(const char* bssid);        // Check if BSSID is cracked
+    static bool loadCache();                         // Load cache from SD (snapshot or text)
+    static bool isCracked(const char* bssid);        // Check if BSSID is cracked (colons optional)
     static String getPassword(const char* bssid);    // Get password for BSSID
     static String getSSID(const char* bssid);        // Get SSID for BSSID (from cache)
     static uint16_t getCrackedCount();               // Total cracked in cache
@@ -41,30 +40,16 @@ public:
     static const char* getStatus();
     
 private:
-    static bool cacheLoaded;
     static char lastError[64];
     static char statusMessage[64];
     
-    // Cache: BSSID (no colons, uppercase) -> {ssid, password}
-    struct CacheEntry {
-        String ssid;
-        String password;
-    };
-    static std::map<String, CacheEntry> crackedCache;
-    static std::map<String, bool> uploadedCache;
-    
-    // File paths
+    // File paths (cracked and uploaded BSSIDs live in a WpaSecStore in wpasec.cpp)
     static constexpr const char* CACHE_FILE = "/wpasec_results.txt";
     static constexpr const char* UPLOADED_FILE = "/wpasec_uploaded.txt";
+    static constexpr const char* SNAPSHOT_FILE = "/wpasec_cache.bin";
     
     // API endpoints
     static constexpr const char* API_HOST = "wpa-sec.stanev.org";
     static constexpr const char* RESULTS_PATH = "/?api&dl=1";  // Download potfile
     static constexpr const char* SUBMIT_PATH = "/?submit";
-    
-    // Helpers
-    static String normalizeBSSID(const char* bssid);  // Remove colons, uppercase
-    static bool saveCache();
-    static bool loadUploadedList();
-    static bool saveUploadedList();
 };
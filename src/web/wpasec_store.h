@@ -0,0 +1,403 @@
+// WPA-SEC Store - cracked and uploaded BSSIDs as one flat sorted array
+// The text files stay the source of truth, cached as a binary snapshot. Main loop only.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+#include "../core/bssid_index.h"
+#include "../core/text_snapshot.h"
+
+struct WpaSecEntry {
+    uint64_t bssid;     // Big-endian 48-bit key (bssidToKey order)
+    uint32_t text;      // Arena offset: SSID bytes, then password bytes
+    uint8_t ssidLen;
+    uint8_t passLen;
+    uint8_t flags;      // WpaSecEntry::CRACKED / UPLOADED
+    uint8_t reserved;
+
+    static const uint8_t CRACKED = 0x01;
+    static const uint8_t UPLOADED = 0x02;
+};
+
+static_assert(sizeof(WpaSecEntry) == 16, "WpaSecEntry is a 16-byte snapshot record");
+
+template <typename FsT, typename FileT>
+class WpaSecStore {
+public:
+    static const size_t MAX_PATH = 48;
+    static const size_t MAX_LINE = 200;       // Keeps both fields under 256
+    static const size_t MAX_ENTRIES = 1000;   // 16 KB of entries at most
+
+    WpaSecStore() : fs(nullptr), ready(false) {
+        resultsPath[0] = uploadedPath[0] = snapshotPath[0] = '\0';
+        memset(&st, 0, sizeof(st));
+    }
+
+    WpaSecStore(const WpaSecStore&) = delete;
+    WpaSecStore& operator=(const WpaSecStore&) = delete;
+
+    // BSSID text with or without separators -> key (see bssid_index.h)
+    static bool parseKey(const char* s, size_t len, uint64_t& key) {
+        return parseBssidKey(s, len, key);
+    }
+
+    static bool parseKey(const char* s, uint64_t& key) {
+        return s && parseKey(s, strlen(s), key);
+    }
+
+    // 12 uppercase hex digits, NUL-terminated (out needs 13 bytes)
+    static void formatKey(uint64_t key, char* out) { formatBssidKey(key, out); }
+
+    // Snapshot if it matches both text files, else parse them and write one.
+    // Missing text files are empty lists.
+    bool load(FsT& fsys, const char* results, const char* uploaded, const char* snapshot) {
+        end();
+        if (!results || !uploaded || !snapshot || strlen(results) >= MAX_PATH ||
+            strlen(uploaded) >= MAX_PATH || strlen(snapshot) >= MAX_PATH) {
+            return false;
+        }
+        fs = &fsys;
+        strcpy(resultsPath, results);
+        strcpy(uploadedPath, uploaded);
+        strcpy(snapshotPath, snapshot);
+
+        if (readSnapshot()) {
+            st.snapshotLoads++;
+            ready = true;
+            return true;
+        }
+
+        if (!parseResults() || !parseUploaded()) {
+            end();
+            return false;
+        }
+        collapse();
+        ready = true;
+        writeSnapshot();  // A failed write only costs the next boot a parse
+        return true;
+    }
+
+    void end() {
+        std::vector<WpaSecEntry>().swap(entries);
+        arena.clear();
+        ready = false;
+        memset(&st, 0, sizeof(st));
+    }
+
+    bool isLoaded() const { return ready; }
+
+    const WpaSecEntry* find(uint64_t key) const {
+        size_t i = lowerBound(key);
+        return (i < entries.size() && entries[i].bssid == key) ? &entries[i] : nullptr;
+    }
+
+    bool isCracked(uint64_t key) const {
+        const WpaSecEntry* e = find(key);
+        return e && (e->flags & WpaSecEntry::CRACKED);
+    }
+
+    // Cracked implies uploaded
+    bool isUploaded(uint64_t key) const {
+        const WpaSecEntry* e = find(key);
+        return e && (e->flags & (WpaSecEntry::CRACKED | WpaSecEntry::UPLOADED));
+    }
+
+    // Field copies into out (n bytes, NUL-terminated); false if not cracked
+    bool ssid(uint64_t key, char* out, size_t n) const {
+        const WpaSecEntry* e = find(key);
+        if (!e || !(e->flags & WpaSecEntry::CRACKED)) return false;
+        return copyField(e->text, e->ssidLen, out, n);
+    }
+
+    bool password(uint64_t key, char* out, size_t n) const {
+        const WpaSecEntry* e = find(key);
+        if (!e || !(e->flags & WpaSecEntry::CRACKED)) return false;
+        return copyField(e->text + e->ssidLen, e->passLen, out, n);
+    }
+
+    // Record a crack in memory (saveResults() persists); true if the BSSID
+    // wasn't cracked before. Re-reporting the same fields changes nothing.
+    bool putCracked(uint64_t key, const char* ssidText, size_t ssidLen,
+                    const char* passText, size_t passLen) {
+        if (!ready || ssidLen > 0xFF || passLen > 0xFF) return false;
+        size_t i = lowerBound(key);
+        bool exists = i < entries.size() && entries[i].bssid == key;
+        if (exists) {
+            WpaSecEntry& e = entries[i];
+            bool wasCracked = (e.flags & WpaSecEntry::CRACKED) != 0;
+            if (wasCracked && sameText(e, ssidText, ssidLen, passText, passLen)) return false;
+            arena.release(e.ssidLen + e.passLen);
+            setText(e, ssidText, ssidLen, passText, passLen);
+            e.flags |= WpaSecEntry::CRACKED;
+            return !wasCracked;
+        }
+        if (entries.size() >= MAX_ENTRIES) return false;
+        WpaSecEntry e = blank(key, WpaSecEntry::CRACKED);
+        setText(e, ssidText, ssidLen, passText, passLen);
+        entries.insert(entries.begin() + i, e);
+        return true;
+    }
+
+    // Track an upload: one appended line and a snapshot refresh, nothing
+    // else rewritten. False if already tracked or on a write error.
+    bool markUploaded(uint64_t key) {
+        if (!ready) return false;
+        size_t i = lowerBound(key);
+        bool exists = i < entries.size() && entries[i].bssid == key;
+        if (exists && (entries[i].flags & WpaSecEntry::UPLOADED)) return false;
+        if (!exists && entries.size() >= MAX_ENTRIES) return false;
+
+        char line[14];
+        formatKey(key, line);
+        line[12] = '\n';
+        FileT f = fs->open(uploadedPath, "a");
+        if (!f) return false;
+        bool ok = f.write((const uint8_t*)line, 13) == 13;
+        f.close();
+        if (!ok) return false;
+
+        if (exists) entries[i].flags |= WpaSecEntry::UPLOADED;
+        else entries.insert(entries.begin() + i, blank(key, WpaSecEntry::UPLOADED));
+        writeSnapshot();
+        return true;
+    }
+
+    // Rewrite the results text file from the store, then the snapshot
+    bool saveResults() {
+        if (!ready) return false;
+        char tmpPath[MAX_PATH + 4];
+        snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", resultsPath);
+        FileT f = fs->open(tmpPath, "w");
+        if (!f) return false;
+        bool ok = true;
+        for (size_t i = 0; i < entries.size() && ok; i++) {
+            const WpaSecEntry& e = entries[i];
+            if (!(e.flags & WpaSecEntry::CRACKED)) continue;
+            char key[13];
+            formatKey(e.bssid, key);
+            key[12] = ':';
+            const uint8_t* text = (const uint8_t*)arena.at(e.text);
+            ok = f.write((const uint8_t*)key, 13) == 13 &&
+                 f.write(text, e.ssidLen) == e.ssidLen &&
+                 f.write((const uint8_t*)":", 1) == 1 &&
+                 f.write(text + e.ssidLen, e.passLen) == e.passLen &&
+                 f.write((const uint8_t*)"\n", 1) == 1;
+        }
+        f.close();
+        if (!ok) {
+            fs->remove(tmpPath);
+            return false;
+        }
+        if (fs->exists(resultsPath)) fs->remove(resultsPath);
+        if (!fs->rename(tmpPath, resultsPath)) return false;
+        return writeSnapshot();
+    }
+
+    size_t size() const { return entries.size(); }
+
+    size_t crackedCount() const {
+        size_t n = 0;
+        for (size_t i = 0; i < entries.size(); i++) {
+            if (entries[i].flags & WpaSecEntry::CRACKED) n++;
+        }
+        return n;
+    }
+
+    size_t uploadedCount() const {
+        size_t n = 0;
+        for (size_t i = 0; i < entries.size(); i++) {
+            if (entries[i].flags & WpaSecEntry::UPLOADED) n++;
+        }
+        return n;
+    }
+
+    // Heap held by the entries and the arena
+    size_t bytes() const {
+        return entries.capacity() * sizeof(WpaSecEntry) + arena.capacity();
+    }
+
+    TextStoreStats stats() const { return st; }
+
+private:
+    typedef TextSnapshot<FsT, FileT> Snapshot;
+
+    static WpaSecEntry blank(uint64_t key, uint8_t flags) {
+        WpaSecEntry e;
+        memset(&e, 0, sizeof(e));
+        e.bssid = key;
+        e.flags = flags;
+        return e;
+    }
+
+    size_t lowerBound(uint64_t key) const {
+        size_t lo = 0, hi = entries.size();
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            if (entries[mid].bssid < key) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo;
+    }
+
+    bool copyField(uint32_t off, uint8_t len, char* out, size_t n) const {
+        if (n == 0) return false;
+        size_t c = len < n - 1 ? len : n - 1;
+        if (c) memcpy(out, arena.at(off), c);
+        out[c] = '\0';
+        return true;
+    }
+
+    bool sameText(const WpaSecEntry& e, const char* s, size_t sl, const char* p, size_t pl) const {
+        return e.ssidLen == sl && e.passLen == pl &&
+               (sl == 0 || memcmp(arena.at(e.text), s, sl) == 0) &&
+               (pl == 0 || memcmp(arena.at(e.text + sl), p, pl) == 0);
+    }
+
+    void setText(WpaSecEntry& e, const char* s, size_t sl, const char* p, size_t pl) {
+        e.text = arena.append(s, sl);
+        e.ssidLen = sl;
+        e.passLen = pl;
+        arena.append(p, pl);
+    }
+
+    // Drop text left behind by replaced passwords
+    void compactArena() {
+        arena.compact(entries.size(), [&](size_t i, size_t& len) {
+            len = entries[i].ssidLen + entries[i].passLen;
+            return &entries[i].text;
+        });
+    }
+
+    // ------------------------------------------------------------------------
+    // Text files
+    // ------------------------------------------------------------------------
+
+    // "BSSID:SSID:password": SSID may hold colons, the password can't
+    bool parseResults() {
+        return Snapshot::template forEachLine<MAX_LINE>(
+            *fs, resultsPath, st.skippedLines, [&](const char* line, size_t len) {
+                const char* first = (const char*)memchr(line, ':', len);
+                const char* last = line + len;
+                while (last > line && *--last != ':') {}
+                uint64_t key;
+                if (!first || first == line || last == first ||
+                    !parseKey(line, first - line, key)) {
+                    st.skippedLines++;
+                    return;
+                }
+                WpaSecEntry e = blank(key, WpaSecEntry::CRACKED);
+                setText(e, first + 1, last - first - 1, last + 1, line + len - last - 1);
+                entries.push_back(e);
+                st.parsedLines++;
+            });
+    }
+
+    bool parseUploaded() {
+        return Snapshot::template forEachLine<MAX_LINE>(
+            *fs, uploadedPath, st.skippedLines, [&](const char* line, size_t len) {
+                uint64_t key;
+                if (!parseKey(line, len, key)) {
+                    st.skippedLines++;
+                    return;
+                }
+                entries.push_back(blank(key, WpaSecEntry::UPLOADED));
+                st.parsedLines++;
+            });
+    }
+
+    // Sort the parsed lines and fold repeats into one entry per BSSID: the
+    // flags combine, the last results line for a BSSID supplies the text
+    void collapse() {
+        std::stable_sort(entries.begin(), entries.end(),
+                         [](const WpaSecEntry& a, const WpaSecEntry& b) { return a.bssid < b.bssid; });
+        size_t out = 0;
+        for (size_t i = 0; i < entries.size(); i++) {
+            const WpaSecEntry& e = entries[i];
+            if (out > 0 && entries[out - 1].bssid == e.bssid) {
+                WpaSecEntry& keep = entries[out - 1];
+                if (e.flags & WpaSecEntry::CRACKED) {
+                    if (keep.flags & WpaSecEntry::CRACKED) arena.release(keep.ssidLen + keep.passLen);
+                    keep.text = e.text;
+                    keep.ssidLen = e.ssidLen;
+                    keep.passLen = e.passLen;
+                }
+                keep.flags |= e.flags;
+                continue;
+            }
+            if (out >= MAX_ENTRIES) {
+                if (e.flags & WpaSecEntry::CRACKED) arena.release(e.ssidLen + e.passLen);
+                continue;
+            }
+            entries[out++] = e;
+        }
+        entries.resize(out);
+        if (arena.garbage()) compactArena();
+        entries.shrink_to_fit();
+        arena.shrink();
+    }
+
+    // ------------------------------------------------------------------------
+    // Snapshot
+    // ------------------------------------------------------------------------
+
+    // Snapshot: the header, count entries, then the arena
+    SnapshotHeader snapshotHeader() const {
+        SnapshotHeader h = Snapshot::header("WSEC", 1, sizeof(WpaSecEntry));
+        h.sources[0] = Snapshot::stamp(*fs, resultsPath);
+        h.sources[1] = Snapshot::stamp(*fs, uploadedPath);
+        return h;
+    }
+
+    bool readSnapshot() {
+        bool ok = Snapshot::read(*fs, snapshotPath, snapshotHeader(), MAX_ENTRIES,
+                                 [&](const SnapshotHeader& h, SnapshotBlock* out) {
+                                     entries.resize(h.count);
+                                     out[0] = {entries.data(), h.count * sizeof(WpaSecEntry)};
+                                     out[1] = {arena.resize(h.arenaBytes), h.arenaBytes};
+                                     return 2;
+                                 }) &&
+                  validEntries();
+        if (!ok) {
+            std::vector<WpaSecEntry>().swap(entries);
+            arena.clear();
+        }
+        return ok;
+    }
+
+    // Sorted, unique, text in bounds
+    bool validEntries() const {
+        for (size_t i = 0; i < entries.size(); i++) {
+            const WpaSecEntry& e = entries[i];
+            if (e.bssid >> 48 || (i > 0 && entries[i - 1].bssid >= e.bssid)) return false;
+            if ((size_t)e.text + e.ssidLen + e.passLen > arena.size()) return false;
+        }
+        return true;
+    }
+
+    bool writeSnapshot() {
+        if (arena.garbage()) compactArena();
+        SnapshotHeader h = snapshotHeader();
+        h.count = entries.size();
+        h.arenaBytes = arena.size();
+        SnapshotBlock blocks[2] = {
+            {entries.data(), entries.size() * sizeof(WpaSecEntry)},
+            {arena.data(), arena.size()},
+        };
+        if (!Snapshot::write(*fs, snapshotPath, h, blocks, 2)) return false;
+        st.snapshotWrites++;
+        return true;
+    }
+
+    FsT* fs;
+    std::vector<WpaSecEntry> entries;
+    StringArena arena;
+    bool ready;
+    char resultsPath[MAX_PATH];
+    char uploadedPath[MAX_PATH];
+    char snapshotPath[MAX_PATH];
+    TextStoreStats st;
+};
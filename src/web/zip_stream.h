@@ -0,0 +1,369 @@
+// Zip Stream - a stored ZIP of SD paths, produced while it's being sent
+// CRC and sizes go in each local header; no ZIP64, so check() refuses past its limits.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../core/crc32.h"
+
+struct ZipStreamStats {
+    uint32_t files;      // Entries written
+    uint32_t dataBytes;  // File bytes stored
+    uint32_t bytesOut;   // Archive bytes sent to the sink
+    uint32_t chunks;     // Sink calls
+};
+
+template <typename FsT, typename FileT, size_t BUF = 1024>
+class ZipStream {
+    static_assert(BUF >= 512, "ZipStream buffer too small");
+
+public:
+    static const size_t MAX_PATH = 256;
+    static const uint8_t MAX_DEPTH = 2;
+
+    static const uint32_t MAX_ENTRIES = 0xFFFF;        // 16-bit counts without ZIP64
+    static const uint64_t MAX_BYTES = 0xFFFFFFFFull;   // 32-bit offsets without ZIP64
+
+    ZipStream() : blocks(nullptr), used(0), err(nullptr) { memset(&st, 0, sizeof(st)); }
+    ~ZipStream() { freeBlocks(); }
+
+    ZipStream(const ZipStream&) = delete;
+    ZipStream& operator=(const ZipStream&) = delete;
+
+    // nullptr if paths make a plain (non-ZIP64) archive, else why not.
+    // Walks the tree without reading any file.
+    const char* check(FsT& fs, const char* const* paths, size_t count) {
+        failed = false;
+        uint64_t entries = 0, bytes = 22;  // End record
+        for (size_t i = 0; i < count; i++) {
+            walk(fs, paths[i], [&](FileT& f, const char* name) {
+                entries++;
+                bytes += 30 + 46 + 2 * (uint64_t)strlen(name) + (uint64_t)f.size();
+            });
+        }
+        return limitError(entries, bytes);
+    }
+
+    static const char* limitError(uint64_t entries, uint64_t bytes) {
+        if (entries > MAX_ENTRIES) return "more than 65535 files (no ZIP64)";
+        if (bytes > MAX_BYTES) return "archive over 4GB (no ZIP64)";
+        return nullptr;
+    }
+
+    // Archive paths (files or directories) to sink(const char*, size_t).
+    // An entry's name is its path from the selected item's own name down,
+    // so "/wardriving" gives "wardriving/<file>". False, with error() set,
+    // if check() refuses (nothing sent), on OOM or if the tree changes
+    // mid-stream (the archive is then truncated).
+    template <typename Sink>
+    bool write(FsT& fs, const char* const* paths, size_t count, Sink sink) {
+        freeBlocks();
+        memset(&st, 0, sizeof(st));
+        used = 0;
+        offset = 0;
+        failed = false;
+        err = check(fs, paths, count);
+        if (err) return false;
+
+        // Pass 1: local headers and data
+        for (size_t i = 0; i < count && !failed; i++) {
+            walk(fs, paths[i], [&](FileT& f, const char* name) { addFile(f, name, sink); });
+        }
+
+        // Pass 2: central directory, names from a fresh walk
+        uint32_t cdStart = offset;
+        uint32_t entryOffset = 0;
+        uint32_t idx = 0;
+        for (size_t i = 0; i < count && !failed; i++) {
+            walk(fs, paths[i], [&](FileT&, const char* name) {
+                addCentral(idx++, name, entryOffset, sink);
+            });
+        }
+        if (!failed && idx != st.files) fail("files changed while zipping");
+        if (!failed) {
+            uint8_t end[22];
+            put32(end, 0x06054b50);
+            put16(end + 4, 0);                     // This disk
+            put16(end + 6, 0);                     // Central directory disk
+            put16(end + 8, (uint16_t)st.files);    // Entries here
+            put16(end + 10, (uint16_t)st.files);   // Entries total
+            put32(end + 12, offset - cdStart);     // Central directory size
+            put32(end + 16, cdStart);
+            put16(end + 20, 0);                    // Comment length
+            emit(end, sizeof(end), sink);
+        }
+        flushOut(sink);
+        freeBlocks();
+        return !failed;
+    }
+
+    // Why the last write() failed, or nullptr
+    const char* error() const { return err; }
+
+    ZipStreamStats stats() const { return st; }
+
+private:
+    struct Entry {
+        uint32_t crc;
+        uint32_t size;
+        uint32_t dosTime;   // Time in the low half, date in the high half
+        uint32_t nameHash;
+    };
+
+    static const uint32_t BLOCK_ENTRIES = 128;
+
+    struct Block {
+        Block* next;
+        Entry e[BLOCK_ENTRIES];
+    };
+
+    // Visit every file under path (or path itself) with its archive name
+    template <typename Fn>
+    void walk(FsT& fs, const char* path, Fn fn) {
+        size_t len = strlen(path);
+        if (len == 0 || len >= MAX_PATH) return;
+        char buf[MAX_PATH];
+        memcpy(buf, path, len + 1);
+        while (len > 1 && buf[len - 1] == '/') buf[--len] = '\0';
+        const char* slash = strrchr(buf, '/');
+        size_t base = slash ? (size_t)(slash - buf) + 1 : 0;
+        FileT f = fs.open(buf);
+        if (!f) return;
+        visit(f, buf, len, base, 0, fn);
+        f.close();
+    }
+
+    template <typename Fn>
+    void visit(FileT& f, char* path, size_t len, size_t base, uint8_t depth, Fn& fn) {
+        if (failed) return;
+        if (!f.isDirectory()) {
+            if (len > base) fn(f, path + base);
+            return;
+        }
+        if (depth > MAX_DEPTH) return;
+        FileT child = f.openNextFile();
+        while (child && !failed) {
+            const char* name = child.name();
+            const char* leaf = strrchr(name, '/');
+            leaf = leaf ? leaf + 1 : name;
+            size_t n = strlen(leaf);
+            bool root = len == 1;  // "/" has its slash already
+            size_t childLen = len + (root ? 0 : 1) + n;
+            if (childLen < MAX_PATH) {
+                if (!root) path[len] = '/';
+                memcpy(path + len + (root ? 0 : 1), leaf, n + 1);
+                visit(child, path, childLen, base, depth + 1, fn);
+                path[len] = '\0';
+            }
+            child.close();
+            child = f.openNextFile();
+        }
+        if (child) child.close();
+    }
+
+    template <typename Sink>
+    void addFile(FileT& f, const char* name, Sink& sink) {
+        size_t nlen = strlen(name);
+        Entry* e = st.files < MAX_ENTRIES ? newEntry() : nullptr;
+        if (!e) {
+            fail(st.files < MAX_ENTRIES ? "out of memory" : "files changed while zipping");
+            return;
+        }
+        e->dosTime = dosTime(f.getLastWrite());
+        e->nameHash = hashName(name);
+
+        // CRC first, so the header can carry it
+        uint8_t chunk[BUF / 2];
+        uint32_t crc = 0;
+        uint32_t size = 0;
+        size_t n;
+        while ((n = f.read(chunk, sizeof(chunk))) > 0) {
+            crc = Crc32::update(crc, chunk, n);
+            size += n;
+        }
+        if (!f.seek(0)) {
+            fail("file unreadable");
+            return;
+        }
+        e->crc = crc;
+        e->size = size;
+
+        uint8_t hdr[30];
+        put32(hdr, 0x04034b50);
+        put16(hdr + 4, 20);              // Version needed: 2.0
+        put16(hdr + 6, 0x0800);          // UTF-8 name
+        put16(hdr + 8, 0);               // Stored
+        put32(hdr + 10, e->dosTime);
+        put32(hdr + 14, crc);
+        put32(hdr + 18, size);
+        put32(hdr + 22, size);
+        put16(hdr + 26, (uint16_t)nlen);
+        put16(hdr + 28, 0);
+        if (!fits(sizeof(hdr) + nlen)) return;
+        emit(hdr, sizeof(hdr), sink);
+        emit((const uint8_t*)name, nlen, sink);
+
+        // Same bytes again, or the header lied
+        uint32_t sent = 0;
+        uint32_t again = 0;
+        while (sent < size && (n = f.read(chunk, sizeof(chunk))) > 0) {
+            if (n > size - sent) n = size - sent;
+            if (!fits(n)) return;
+            again = Crc32::update(again, chunk, n);
+            sent += n;
+            emit(chunk, n, sink);
+        }
+        if (sent != size || again != crc) {
+            fail("files changed while zipping");
+            return;
+        }
+        st.files++;
+        st.dataBytes += size;
+    }
+
+    template <typename Sink>
+    void addCentral(uint32_t idx, const char* name, uint32_t& entryOffset, Sink& sink) {
+        Entry* e = entryAt(idx);
+        if (!e || e->nameHash != hashName(name)) {
+            fail("files changed while zipping");
+            return;
+        }
+        size_t nlen = strlen(name);
+        uint8_t hdr[46];
+        put32(hdr, 0x02014b50);
+        put16(hdr + 4, (3 << 8) | 20);   // Made by: Unix, 2.0
+        put16(hdr + 6, 20);
+        put16(hdr + 8, 0x0800);
+        put16(hdr + 10, 0);
+        put32(hdr + 12, e->dosTime);
+        put32(hdr + 16, e->crc);
+        put32(hdr + 20, e->size);
+        put32(hdr + 24, e->size);
+        put16(hdr + 28, (uint16_t)nlen);
+        put16(hdr + 30, 0);              // Extra
+        put16(hdr + 32, 0);              // Comment
+        put16(hdr + 34, 0);              // Disk
+        put16(hdr + 36, 0);              // Internal attributes
+        put32(hdr + 38, 0100644u << 16); // Unix mode: regular rw-r--r--
+        put32(hdr + 42, entryOffset);
+        if (!fits(sizeof(hdr) + nlen)) return;
+        emit(hdr, sizeof(hdr), sink);
+        emit((const uint8_t*)name, nlen, sink);
+        entryOffset += 30 + nlen + e->size;
+    }
+
+    // Room left before the 32-bit offsets overflow (check() said there was)
+    bool fits(size_t n) {
+        if (!failed && (uint64_t)offset + n > MAX_BYTES) fail("files changed while zipping");
+        return !failed;
+    }
+
+    void fail(const char* why) {
+        if (!failed) err = why;
+        failed = true;
+    }
+
+    template <typename Sink>
+    void emit(const uint8_t* data, size_t len, Sink& sink) {
+        offset += len;
+        while (len > 0) {
+            size_t take = BUF - used;
+            if (take > len) take = len;
+            memcpy(out + used, data, take);
+            used += take;
+            data += take;
+            len -= take;
+            if (used == BUF) flushOut(sink);
+        }
+    }
+
+    template <typename Sink>
+    void flushOut(Sink& sink) {
+        if (used == 0) return;
+        sink((const char*)out, used);
+        st.bytesOut += used;
+        st.chunks++;
+        used = 0;
+    }
+
+    Entry* newEntry() {
+        uint32_t idx = st.files;
+        uint32_t slot = idx % BLOCK_ENTRIES;
+        if (slot == 0) {
+            Block* b = (Block*)malloc(sizeof(Block));
+            if (!b) return nullptr;
+            b->next = nullptr;
+            if (!blocks) {
+                blocks = b;
+            } else {
+                Block* last = blocks;
+                while (last->next) last = last->next;
+                last->next = b;
+            }
+            tailBlock = b;
+        }
+        return &tailBlock->e[slot];
+    }
+
+    // Pass 2 visits entries in order, so walk the block list alongside
+    Entry* entryAt(uint32_t idx) {
+        if (idx >= st.files) return nullptr;
+        if (idx == 0) cursor = blocks;
+        else if (idx % BLOCK_ENTRIES == 0) cursor = cursor ? cursor->next : nullptr;
+        return cursor ? &cursor->e[idx % BLOCK_ENTRIES] : nullptr;
+    }
+
+    void freeBlocks() {
+        while (blocks) {
+            Block* next = blocks->next;
+            free(blocks);
+            blocks = next;
+        }
+        tailBlock = cursor = nullptr;
+    }
+
+    static uint32_t hashName(const char* s) {
+        uint32_t h = 2166136261u;  // FNV-1a
+        while (*s) {
+            h ^= (uint8_t)*s++;
+            h *= 16777619u;
+        }
+        return h;
+    }
+
+    // MS-DOS time/date; anything before 1980 (no clock) becomes 1980-01-01
+    static uint32_t dosTime(time_t t) {
+        struct tm tmv;
+        if (t <= 0 || !gmtime_r(&t, &tmv) || tmv.tm_year < 80) {
+            return (uint32_t)((0 << 9) | (1 << 5) | 1) << 16;
+        }
+        uint32_t time = (tmv.tm_hour << 11) | (tmv.tm_min << 5) | (tmv.tm_sec / 2);
+        uint32_t date = ((tmv.tm_year - 80) << 9) | ((tmv.tm_mon + 1) << 5) | tmv.tm_mday;
+        return time | (date << 16);
+    }
+
+    static void put16(uint8_t* p, uint16_t v) {
+        p[0] = v & 0xFF;
+        p[1] = v >> 8;
+    }
+
+    static void put32(uint8_t* p, uint32_t v) {
+        p[0] = v & 0xFF;
+        p[1] = (v >> 8) & 0xFF;
+        p[2] = (v >> 16) & 0xFF;
+        p[3] = v >> 24;
+    }
+
+    Block* blocks;
+    Block* tailBlock = nullptr;
+    Block* cursor = nullptr;
+    uint8_t out[BUF];
+    size_t used;
+    uint32_t offset = 0;
+    bool failed = false;
+    const char* err;
+    ZipStreamStats st;
+};
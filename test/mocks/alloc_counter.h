@@ -0,0 +1,23 @@
+// Heap allocation counter for native unit tests
+// Replaces the global new/delete family over malloc/free; include from one test file only.
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+static size_t allocations = 0;
+
+static void* countedAlloc(std::size_t n) {
+    allocations++;
+    void* p = std::malloc(n ? n : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new(std::size_t n) { return countedAlloc(n); }
+void* operator new[](std::size_t n) { return countedAlloc(n); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
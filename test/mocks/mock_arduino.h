@@ -11,16 +11,20 @@
 // Arduino-style type definitions
 typedef uint8_t byte;
 
-// Time functions - use static counter for deterministic testing
-inline uint32_t millis() {
+// Time functions - virtual clock for deterministic testing
+// Starts at 0 and only moves when a test (or the replay harness) says so
+inline uint32_t& mockMillisValue() {
     static uint32_t ms = 0;
     return ms;
 }
 
+inline uint32_t millis() {
+    return mockMillisValue();
+}
+
 inline void setMillis(uint32_t ms) {
     // For test control - not in real Arduino
-    static uint32_t* ptr = nullptr;
-    // This is a workaround - tests can call millis() and it returns 0
+    mockMillisValue() = ms;
 }
 
 inline uint32_t micros() {
@@ -121,6 +125,42 @@ public:
         return pos == std::string::npos ? -1 : (int)pos;
     }
     
+    int indexOf(const char* s, size_t from = 0) const {
+        size_t pos = str.find(s ? s : "", from);
+        return pos == std::string::npos ? -1 : (int)pos;
+    }
+    
+    int lastIndexOf(char c) const {
+        size_t pos = str.rfind(c);
+        return pos == std::string::npos ? -1 : (int)pos;
+    }
+    
+    char charAt(size_t index) const { return index < str.size() ? str[index] : 0; }
+    bool startsWith(const char* s) const { return s && str.compare(0, strlen(s), s) == 0; }
+    bool startsWith(const String& s) const { return startsWith(s.c_str()); }
+    bool endsWith(const char* s) const {
+        size_t n = s ? strlen(s) : 0;
+        return n <= str.size() && str.compare(str.size() - n, n, s) == 0;
+    }
+    bool endsWith(const String& s) const { return endsWith(s.c_str()); }
+    
+    void replace(const char* from, const char* to) {
+        if (!from || !*from) return;
+        std::string f(from), t(to ? to : "");
+        size_t pos = 0;
+        while ((pos = str.find(f, pos)) != std::string::npos) {
+            str.replace(pos, f.size(), t);
+            pos += t.size();
+        }
+    }
+    void replace(char from, char to) {
+        for (char& c : str) if (c == from) c = to;
+    }
+    
+    bool reserve(size_t size) { str.reserve(size); return true; }
+    bool concat(const char* s) { if (s) str += s; return true; }
+    bool concat(const String& s) { str += s.str; return true; }
+    
     String substring(size_t from) const { return String(str.substr(from).c_str()); }
     String substring(size_t from, size_t to) const { return String(str.substr(from, to - from).c_str()); }
     
@@ -0,0 +1,247 @@
+// Mock Arduino FS/SD for native unit testing
+// Backed by a real host directory so tests can inspect what the code wrote.
+// Call SD.setRoot("/tmp/some_dir") before use; begin() fails without a root
+// (same as "no SD card inserted").
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdarg>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "mock_arduino.h"
+
+#define FILE_READ   "r"
+#define FILE_WRITE  "w"
+#define FILE_APPEND "a"
+
+namespace fs {
+
+class File {
+public:
+    File() {}
+
+    size_t write(uint8_t b) { return write(&b, 1); }
+    size_t write(const uint8_t* buf, size_t len) {
+        if (!h || !h->fp || len == 0) return 0;
+        size_t n = fwrite(buf, 1, len, h->fp);
+        h->bytesWritten += n;
+        h->writeCalls++;
+        return n;
+    }
+    size_t write(const char* buf, size_t len) { return write((const uint8_t*)buf, len); }
+
+    size_t print(const char* s) { return s ? write((const uint8_t*)s, strlen(s)) : 0; }
+    size_t print(const String& s) { return print(s.c_str()); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int n) { return printf("%d", n); }
+    size_t print(unsigned int n) { return printf("%u", n); }
+    size_t print(long n) { return printf("%ld", n); }
+    size_t print(unsigned long n) { return printf("%lu", n); }
+    size_t print(double n, int decimals = 2) { return printf("%.*f", decimals, n); }
+    size_t println() { return print("\n"); }
+    template <typename T> size_t println(const T& v) { size_t n = print(v); return n + println(); }
+    size_t println(double v, int decimals) { size_t n = print(v, decimals); return n + println(); }
+
+    size_t printf(const char* fmt, ...) {
+        char stackBuf[256];
+        va_list args;
+        va_start(args, fmt);
+        int n = vsnprintf(stackBuf, sizeof(stackBuf), fmt, args);
+        va_end(args);
+        if (n < 0) return 0;
+        if ((size_t)n < sizeof(stackBuf)) return write((const uint8_t*)stackBuf, n);
+        std::string big(n + 1, '\0');
+        va_start(args, fmt);
+        vsnprintf(&big[0], big.size(), fmt, args);
+        va_end(args);
+        return write((const uint8_t*)big.data(), n);
+    }
+
+    int read() {
+        if (!h || !h->fp) return -1;
+        int c = fgetc(h->fp);
+        return c == EOF ? -1 : c;
+    }
+    size_t read(uint8_t* buf, size_t len) {
+        if (!h || !h->fp) return 0;
+        return fread(buf, 1, len, h->fp);
+    }
+    size_t readBytes(char* buf, size_t len) { return read((uint8_t*)buf, len); }
+    int peek() {
+        if (!h || !h->fp) return -1;
+        int c = fgetc(h->fp);
+        if (c != EOF) ungetc(c, h->fp);
+        return c == EOF ? -1 : c;
+    }
+    int available() {
+        if (!h || !h->fp) return 0;
+        long pos = ftell(h->fp);
+        return (int)(size() - (size_t)pos);
+    }
+    String readStringUntil(char terminator) {
+        std::string out;
+        int c;
+        while ((c = read()) >= 0 && c != terminator) out += (char)c;
+        return String(out.c_str());
+    }
+    String readString() { return readStringUntil('\0'); }
+
+    size_t size() const {
+        if (!h) return 0;
+        if (h->fp) fflush(h->fp);
+        struct stat st;
+        return stat(h->hostPath.c_str(), &st) == 0 ? (size_t)st.st_size : 0;
+    }
+    size_t position() const { return (h && h->fp) ? (size_t)ftell(h->fp) : 0; }
+    bool seek(uint32_t pos) { return h && h->fp && fseek(h->fp, pos, SEEK_SET) == 0; }
+    void flush() { if (h && h->fp) fflush(h->fp); }
+    void close() {
+        if (!h) return;
+        h->release();
+        if (h->fp) { fclose(h->fp); h->fp = nullptr; }
+        if (h->dir) { closedir(h->dir); h->dir = nullptr; }
+        h.reset();
+    }
+
+    operator bool() const { return h && (h->fp || h->dir); }
+    const char* name() const {
+        if (!h) return "";
+        size_t slash = h->path.find_last_of('/');
+        return slash == std::string::npos ? h->path.c_str() : h->path.c_str() + slash + 1;
+    }
+    const char* path() const { return h ? h->path.c_str() : ""; }
+    bool isDirectory() const { return h && h->dir; }
+    time_t getLastWrite() const {
+        struct stat st;
+        return (h && stat(h->hostPath.c_str(), &st) == 0) ? st.st_mtime : 0;
+    }
+
+    File openNextFile(const char* mode = FILE_READ) {
+        if (!h || !h->dir) return File();
+        struct dirent* e;
+        while ((e = readdir(h->dir)) != nullptr) {
+            if (strcmp(e->d_name, ".") == 0 || strcmp(e->d_name, "..") == 0) continue;
+            std::string child = h->path;
+            if (child.empty() || child.back() != '/') child += "/";
+            child += e->d_name;
+            return File::openHost(h->hostPath + "/" + e->d_name, child, mode);
+        }
+        return File();
+    }
+    void rewindDirectory() { if (h && h->dir) rewinddir(h->dir); }
+
+    // Mock-only: I/O accounting for tests and benchmarks
+    size_t mockBytesWritten() const { return h ? h->bytesWritten : 0; }
+    size_t mockWriteCalls() const { return h ? h->writeCalls : 0; }
+    static int& mockLiveHandles() { static int live = 0; return live; }
+
+    static File openHost(const std::string& hostPath, const std::string& path, const char* mode) {
+        File f;
+        struct stat st;
+        bool exists = stat(hostPath.c_str(), &st) == 0;
+        auto impl = std::make_shared<Impl>();
+        impl->hostPath = hostPath;
+        impl->path = path;
+        if (exists && S_ISDIR(st.st_mode)) {
+            impl->dir = opendir(hostPath.c_str());
+            if (!impl->dir) return f;
+        } else {
+            const char* hostMode = "rb";
+            if (strcmp(mode, FILE_WRITE) == 0) hostMode = "wb";
+            else if (strcmp(mode, FILE_APPEND) == 0) hostMode = "ab";
+            else if (strcmp(mode, "r+") == 0) hostMode = "r+b";
+            impl->fp = fopen(hostPath.c_str(), hostMode);
+            if (!impl->fp) return f;
+        }
+        impl->counted = true;
+        mockLiveHandles()++;
+        f.h = impl;
+        return f;
+    }
+
+private:
+    struct Impl {
+        FILE* fp = nullptr;
+        DIR* dir = nullptr;
+        std::string hostPath;
+        std::string path;
+        size_t bytesWritten = 0;
+        size_t writeCalls = 0;
+        bool counted = false;
+        void release() {
+            if (counted) mockLiveHandles()--;
+            counted = false;
+        }
+        ~Impl() {
+            release();
+            if (fp) fclose(fp);
+            if (dir) closedir(dir);
+        }
+    };
+    std::shared_ptr<Impl> h;
+};
+
+class FS {
+public:
+    // Mock-only: map "/" on the card to a host directory ("" = no card)
+    void setRoot(const std::string& hostDir) { root = hostDir; }
+    const std::string& getRoot() const { return root; }
+
+    File open(const char* path, const char* mode = FILE_READ, bool create = false) {
+        (void)create;
+        if (root.empty() || !path) return File();
+        opens++;
+        return File::openHost(host(path), path, mode);
+    }
+    File open(const String& path, const char* mode = FILE_READ) { return open(path.c_str(), mode); }
+    bool exists(const char* path) {
+        struct stat st;
+        return !root.empty() && path && stat(host(path).c_str(), &st) == 0;
+    }
+    bool exists(const String& path) { return exists(path.c_str()); }
+    bool mkdir(const char* path) { return !root.empty() && (::mkdir(host(path).c_str(), 0755) == 0 || exists(path)); }
+    bool mkdir(const String& path) { return mkdir(path.c_str()); }
+    bool remove(const char* path) { return !root.empty() && ::unlink(host(path).c_str()) == 0; }
+    bool remove(const String& path) { return remove(path.c_str()); }
+    bool rename(const char* from, const char* to) {
+        return !root.empty() && ::rename(host(from).c_str(), host(to).c_str()) == 0;
+    }
+    bool rename(const String& from, const String& to) { return rename(from.c_str(), to.c_str()); }
+    bool rmdir(const char* path) { return !root.empty() && ::rmdir(host(path).c_str()) == 0; }
+    bool rmdir(const String& path) { return rmdir(path.c_str()); }
+
+    // Mock-only: number of open() calls, for I/O pattern tests
+    size_t opens = 0;
+    // Mock-only: files and directories open right now (SD max_files budget)
+    int openHandles() const { return File::mockLiveHandles(); }
+
+protected:
+    std::string root;
+    std::string host(const char* path) const {
+        std::string p = path ? path : "";
+        if (p.empty() || p[0] != '/') p = "/" + p;
+        return root + p;
+    }
+};
+
+}  // namespace fs
+
+using fs::File;
+
+class SDFS : public fs::FS {
+public:
+    template <typename... Args>
+    bool begin(Args...) { return !root.empty(); }
+    void end() {}
+    uint64_t totalBytes() { return 8ULL * 1024 * 1024 * 1024; }
+    uint64_t usedBytes() { return 0; }
+    uint64_t cardSize() { return totalBytes(); }
+};
+
+inline SDFS SD;
@@ -688,7 +688,7 @@ inline float calculateEvilTwinScore(bool isHidden, int8_t rssi) {
 
 // ============================================================================
 // MAC Address Utilities
-// From: src/modes/warhog.h (bssidToKey)
+// From: src/core/bssid_index.h (bssidToKey)
 // From: src/core/wsl_bypasser.cpp (randomizeMAC)
 // ============================================================================
 
@@ -0,0 +1,23 @@
+// Replay harness - state shared between the driver and the SDK stand-ins
+#pragma once
+
+#include <Arduino.h>
+#include <esp_wifi.h>
+
+// What the mode under test asked the radio to do
+struct ReplayRadio {
+    wifi_promiscuous_cb_t rxCallback = nullptr;
+    bool promiscuous = false;
+    uint32_t filterMask = WIFI_PROMIS_FILTER_MASK_ALL;
+    uint8_t channel = 1;
+    uint32_t channelSwitches = 0;
+    uint32_t txFrames = 0;  // Injected frames (deauth/disassoc)
+};
+
+extern ReplayRadio replayRadio;
+
+// Heap model (replay_stubs.cpp)
+extern uint32_t replayHeapBudget;   // Bytes reported free at replayHeapReset()
+void replayHeapReset();
+uint32_t replayHeapSample();        // Current free heap, tracks the low-water mark
+uint32_t replayHeapPeakUsed();      // Budget minus lowest free heap seen
@@ -0,0 +1,458 @@
+// Replay harness - feed a recorded pcap through the real OINK / DNH / WARHOG
+// promiscuous callbacks and update() loops on the host.
+//
+// Frames are wrapped in the same wifi_promiscuous_pkt_t layout the ESP32
+// driver hands over (rx_ctrl + payload + 4 FCS bytes counted in sig_len) and
+// delivered to whatever callback the mode registered, honouring its filter.
+// millis() follows the pcap timestamps and update() runs every --loop-ms of
+// capture time, so ring pressure and timeouts behave as they would live.
+//
+// Build: pio run -e replay   Run: .pio/build/replay/program capture.pcap
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "replay.h"
+
+#include "../../src/core/capture_stats.h"
+#include "../../src/core/config.h"
+#include "../../src/core/mgmt_frame.h"
+#include "../../src/modes/donoham.h"
+#include "../../src/modes/oink.h"
+#include "../../src/modes/warhog.h"
+
+// pcap file format (libpcap, not pcapng)
+static const uint32_t PCAP_MAGIC_USEC = 0xA1B2C3D4;
+static const uint32_t PCAP_MAGIC_NSEC = 0xA1B23C4D;
+static const uint32_t LINKTYPE_IEEE802_11 = 105;
+static const uint32_t LINKTYPE_RADIOTAP = 127;
+
+static const uint16_t MIN_FRAME_LEN = 24;       // 802.11 MAC header
+static const uint16_t MAX_SIG_LEN = 4095;       // rx_ctrl.sig_len is 12 bits
+static const uint16_t FCS_LEN = 4;
+static const uint32_t VCLOCK_START_MS = 10000;  // Keep clear of "0 = never" sentinels
+static const uint32_t TAIL_DRAIN_MS = 2000;     // Keep looping after the last frame
+
+struct ReplayOptions {
+    const char* path = nullptr;
+    const char* mode = "oink";
+    uint32_t loopMs = 50;
+    bool wire = false;
+    bool honorChannel = false;
+    const char* sdRoot = nullptr;
+    bool session = false;
+    bool parseBench = false;
+};
+
+struct CapturedFrame {
+    uint64_t tsUs;
+    int8_t rssi;
+    uint8_t channel;     // 0 = unknown
+    std::vector<uint8_t> data;  // 802.11 frame, FCS stripped
+};
+
+// Per-run counters the harness can see from outside the mode
+struct ReplayCounters {
+    uint32_t delivered = 0;
+    uint32_t byType[4] = {};
+    uint32_t tooShort = 0;       // Under a MAC header; modes ignore these
+    uint32_t tooLong = 0;        // Wouldn't fit in sig_len; driver never delivers them
+    uint32_t notListening = 0;   // Promiscuous off or no callback registered
+    uint32_t filtered = 0;       // Rejected by the mode's promiscuous filter
+    uint32_t offChannel = 0;     // --honor-channel: radio was tuned elsewhere
+    uint32_t updates = 0;
+    std::set<uint64_t> beaconBSSIDs;
+};
+
+// ============================================================
+// pcap reading
+// ============================================================
+
+static uint16_t le16(const uint8_t* p) { return p[0] | (p[1] << 8); }
+static uint32_t le32(const uint8_t* p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24); }
+
+static uint16_t channelFromFreq(uint16_t mhz) {
+    if (mhz == 2484) return 14;
+    if (mhz >= 2412 && mhz <= 2472) return (mhz - 2407) / 5;
+    if (mhz >= 5000 && mhz <= 5895) return (mhz - 5000) / 5;
+    return 0;
+}
+
+// Pull signal/channel/FCS flag out of a radiotap header. Returns header
+// length, or 0 if malformed. Only fields 0-5 are needed, all in the first
+// present word; extended present words are skipped.
+static uint16_t parseRadiotap(const uint8_t* p, size_t len, int8_t& rssi, uint8_t& channel, bool& hasFCS) {
+    if (len < 8 || p[0] != 0) return 0;
+    uint16_t hdrLen = le16(p + 2);
+    if (hdrLen < 8 || hdrLen > len) return 0;
+
+    uint32_t present = le32(p + 4);
+    size_t off = 8;
+    uint32_t word = present;
+    while ((word & 0x80000000u) && off + 4 <= hdrLen) {
+        word = le32(p + off);
+        off += 4;
+    }
+
+    auto align = [&](size_t a) { off = (off + a - 1) & ~(a - 1); };
+
+    if (present & (1u << 0)) { align(8); off += 8; }              // TSFT
+    if (present & (1u << 1)) {                                    // Flags
+        if (off < hdrLen) hasFCS = (p[off] & 0x10) != 0;
+        off += 1;
+    }
+    if (present & (1u << 2)) off += 1;                            // Rate
+    if (present & (1u << 3)) {                                    // Channel
+        align(2);
+        if (off + 2 <= hdrLen) channel = (uint8_t)channelFromFreq(le16(p + off));
+        off += 4;
+    }
+    if (present & (1u << 4)) off += 2;                            // FHSS
+    if (present & (1u << 5)) {                                    // dBm antenna signal
+        if (off < hdrLen) rssi = (int8_t)p[off];
+    }
+    return hdrLen;
+}
+
+static bool loadPcap(const char* path, std::vector<CapturedFrame>& out) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "replay: cannot open %s\n", path);
+        return false;
+    }
+
+    uint8_t gh[24];
+    if (fread(gh, 1, sizeof(gh), f) != sizeof(gh)) {
+        fprintf(stderr, "replay: %s is too short for a pcap header\n", path);
+        fclose(f);
+        return false;
+    }
+
+    uint32_t magic = le32(gh);
+    bool swapped = false;
+    bool nsec = false;
+    if (magic == PCAP_MAGIC_USEC || magic == PCAP_MAGIC_NSEC) {
+        nsec = (magic == PCAP_MAGIC_NSEC);
+    } else if (__builtin_bswap32(magic) == PCAP_MAGIC_USEC || __builtin_bswap32(magic) == PCAP_MAGIC_NSEC) {
+        swapped = true;
+        nsec = (__builtin_bswap32(magic) == PCAP_MAGIC_NSEC);
+    } else {
+        fprintf(stderr, "replay: %s is not a pcap file (pcapng is not supported)\n", path);
+        fclose(f);
+        return false;
+    }
+
+    auto rd32 = [&](const uint8_t* p) { uint32_t v = le32(p); return swapped ? __builtin_bswap32(v) : v; };
+    uint32_t linktype = rd32(gh + 20);
+    if (linktype != LINKTYPE_IEEE802_11 && linktype != LINKTYPE_RADIOTAP) {
+        fprintf(stderr, "replay: unsupported linktype %u (need 105 or 127)\n", linktype);
+        fclose(f);
+        return false;
+    }
+
+    uint8_t rh[16];
+    std::vector<uint8_t> buf;
+    while (fread(rh, 1, sizeof(rh), f) == sizeof(rh)) {
+        uint32_t sec = rd32(rh), frac = rd32(rh + 4), caplen = rd32(rh + 8);
+        if (caplen > 65535) break;
+        buf.resize(caplen);
+        if (fread(buf.data(), 1, caplen, f) != caplen) break;
+
+        CapturedFrame cf;
+        cf.tsUs = (uint64_t)sec * 1000000ULL + (nsec ? frac / 1000 : frac);
+        cf.rssi = -60;
+        cf.channel = 0;
+        size_t start = 0;
+        bool hasFCS = false;
+        if (linktype == LINKTYPE_RADIOTAP) {
+            start = parseRadiotap(buf.data(), caplen, cf.rssi, cf.channel, hasFCS);
+            if (start == 0) continue;
+        }
+        size_t end = caplen;
+        if (hasFCS && end - start >= FCS_LEN) end -= FCS_LEN;
+        cf.data.assign(buf.begin() + start, buf.begin() + end);
+        out.push_back(std::move(cf));
+    }
+
+    fclose(f);
+    return true;
+}
+
+// ============================================================
+// Driver
+// ============================================================
+
+struct ModeHooks {
+    const char* name;
+    void (*init)();
+    void (*start)();
+    void (*stop)();
+    void (*update)();
+};
+
+static void warhogSetup() {
+    // Beacon capture only happens in Enhanced collection mode
+    Config::ml().collectionMode = MLCollectionMode::ENHANCED;
+    WarhogMode::init();
+}
+
+static const ModeHooks MODES[] = {
+    {"oink",   OinkMode::init, OinkMode::start, OinkMode::stop, OinkMode::update},
+    {"dnh",    DoNoHamMode::init, DoNoHamMode::start, DoNoHamMode::stop, DoNoHamMode::update},
+    {"warhog", warhogSetup, WarhogMode::start, WarhogMode::stop, WarhogMode::update},
+};
+
+static uint32_t filterBitFor(wifi_promiscuous_pkt_type_t type) {
+    switch (type) {
+        case WIFI_PKT_MGMT: return WIFI_PROMIS_FILTER_MASK_MGMT;
+        case WIFI_PKT_CTRL: return WIFI_PROMIS_FILTER_MASK_CTRL;
+        case WIFI_PKT_DATA: return WIFI_PROMIS_FILTER_MASK_DATA;
+        default: return WIFI_PROMIS_FILTER_MASK_ALL;
+    }
+}
+
+static void deliver(const CapturedFrame& cf, const ReplayOptions& opt, ReplayCounters& c,
+                    std::vector<uint32_t>& pktBuf) {
+    const std::vector<uint8_t>& d = cf.data;
+    if (d.size() + FCS_LEN > MAX_SIG_LEN) { c.tooLong++; return; }
+    if (d.size() < MIN_FRAME_LEN) c.tooShort++;
+
+    uint8_t fcType = d.empty() ? 3 : (d[0] >> 2) & 0x03;
+    wifi_promiscuous_pkt_type_t type = (fcType == 0) ? WIFI_PKT_MGMT :
+                                       (fcType == 1) ? WIFI_PKT_CTRL :
+                                       (fcType == 2) ? WIFI_PKT_DATA : WIFI_PKT_MISC;
+
+    if (!replayRadio.promiscuous || !replayRadio.rxCallback) { c.notListening++; return; }
+    if (replayRadio.filterMask != WIFI_PROMIS_FILTER_MASK_ALL &&
+        !(replayRadio.filterMask & filterBitFor(type))) { c.filtered++; return; }
+    if (opt.honorChannel && cf.channel && cf.channel != replayRadio.channel) { c.offChannel++; return; }
+
+    // Same layout as the driver's buffer: rx_ctrl, payload, FCS (zeroed)
+    size_t total = sizeof(wifi_pkt_rx_ctrl_t) + d.size() + FCS_LEN;
+    pktBuf.assign((total + 3) / 4, 0);
+    wifi_promiscuous_pkt_t* pkt = reinterpret_cast<wifi_promiscuous_pkt_t*>(pktBuf.data());
+    pkt->rx_ctrl.rssi = cf.rssi;
+    pkt->rx_ctrl.channel = cf.channel ? cf.channel : replayRadio.channel;
+    pkt->rx_ctrl.sig_len = d.size() + FCS_LEN;
+    pkt->rx_ctrl.timestamp = (uint32_t)cf.tsUs;
+    if (!d.empty()) memcpy(pkt->payload, d.data(), d.size());
+
+    if (type == WIFI_PKT_MGMT && d.size() >= MIN_FRAME_LEN && (d[0] >> 4) == 0x08) {
+        c.beaconBSSIDs.insert(bssidToKey(d.data() + 16));
+    }
+
+    c.byType[type]++;
+    c.delivered++;
+    replayRadio.rxCallback(pkt, type);
+}
+
+static void printPoolStats(const EapolPoolStats& ps) {
+    printf("eapol pool  %u/%u bytes (%u payload, peak %u), %u frames, %u%% fragmented, %u failed\n",
+           ps.used, ps.capacity, ps.payload, ps.peakUsed, ps.frames, ps.fragmentation, ps.failed);
+}
+
+static void printBeaconCacheStats(const BeaconCacheStats& bs) {
+    printf("beacons     %u/%u cached (%u pinned, %u reserved), %u bytes in %u allocated, %u hits, %u misses, %u evicted\n",
+           bs.stored, bs.slots, bs.pinned, bs.entries - bs.stored, bs.bytes, bs.allocated,
+           bs.hits, bs.misses, bs.evictions);
+}
+
+// Callback cycles are host time scaled to 240 MHz: compare runs, not devices
+static void printCaptureStats(const CaptureStats& cs) {
+    printf("telemetry   %u received, %u dropped (", cs.received, cs.totalDrops());
+    for (uint8_t i = 0; i < (uint8_t)CaptureDrop::COUNT; i++) {
+        printf("%s%s %u", i ? ", " : "", CaptureTelemetry::dropName((CaptureDrop)i), cs.drops[i]);
+    }
+    printf("), queue high water %u/%u\n", cs.queueHighWater, cs.queueCapacity);
+    printf("callback    %u calls, avg %llu cyc, max %u cyc\n", cs.cbCalls,
+           cs.cbCalls ? (unsigned long long)(cs.cbTotalCycles / cs.cbCalls) : 0ULL, cs.cbMaxCycles);
+}
+
+static void printReport(const ModeHooks& m, const ReplayCounters& c, size_t frames, double wallSec) {
+    printf("\n=== %s ===\n", m.name);
+    printf("frames      %zu in pcap, %u delivered (mgmt %u, ctrl %u, data %u, misc %u)\n",
+           frames, c.delivered, c.byType[WIFI_PKT_MGMT], c.byType[WIFI_PKT_CTRL],
+           c.byType[WIFI_PKT_DATA], c.byType[WIFI_PKT_MISC]);
+    printf("throughput  %.0f frames/s wall (%.3fs), %u update() calls\n",
+           wallSec > 0 ? c.delivered / wallSec : 0.0, wallSec, c.updates);
+    printf("not fed     short %u, oversize %u, radio off %u, filtered %u, off-channel %u\n",
+           c.tooShort, c.tooLong, c.notListening, c.filtered, c.offChannel);
+
+    if (strcmp(m.name, "oink") == 0) {
+        FrameRingStats rs = OinkMode::getFrameRingStats();
+        printf("ring        pushed %u, popped %u, full %u (%u bytes), oversize %u, high water %u\n",
+               rs.pushed, rs.popped, rs.droppedFull, rs.droppedBytes, rs.droppedOversize, rs.highWater);
+        printf("networks    %u (of %zu beaconing BSSIDs)\n", OinkMode::getNetworkCount(), c.beaconBSSIDs.size());
+        printf("captures    %u complete handshakes (%zu tracked), %u PMKIDs\n",
+               OinkMode::getCompleteHandshakeCount(), OinkMode::getHandshakes().size(), OinkMode::getPMKIDCount());
+        printf("injected    %u frames\n", replayRadio.txFrames);
+        printPoolStats(OinkMode::getEapolPoolStats());
+        printBeaconCacheStats(OinkMode::getBeaconCacheStats());
+        PcapngStats ss = OinkMode::getSessionCaptureStats();
+        if (ss.frames || ss.bytes) {
+            printf("session     %u frames, %u bytes in %u writes, %u dropped, %u write errors\n",
+                   ss.frames, ss.bytes, ss.writes, ss.dropped, ss.writeErrors);
+        }
+        printCaptureStats(CaptureTelemetry::snapshot());
+    } else if (strcmp(m.name, "dnh") == 0) {
+        printf("networks    %zu (of %zu beaconing BSSIDs)\n", DoNoHamMode::getNetworkCount(), c.beaconBSSIDs.size());
+        printf("captures    %zu handshakes, %zu PMKIDs\n",
+               DoNoHamMode::getHandshakeCount(), DoNoHamMode::getPMKIDCount());
+        printPoolStats(DoNoHamMode::getEapolPoolStats());
+        printBeaconCacheStats(DoNoHamMode::getBeaconCacheStats());
+        printCaptureStats(CaptureTelemetry::snapshot());
+    } else {
+        printf("beacons     %u captured, %zu BSSIDs cached (of %zu beaconing)\n",
+               WarhogMode::getBeaconCount(), WarhogMode::getBeaconCacheSize(), c.beaconBSSIDs.size());
+        BeaconTimingStats ts = WarhogMode::getTimingStats();
+        printf("timing      %u/%u APs, %u intervals, %u resets, %u evicted\n",
+               ts.tracked, ts.slots, ts.samples, ts.resets, ts.evictions);
+    }
+
+    printf("heap        peak %u bytes of %u budget\n", replayHeapPeakUsed(), replayHeapBudget);
+}
+
+static void runMode(const ModeHooks& m, const std::vector<CapturedFrame>& frames, const ReplayOptions& opt) {
+    replayRadio = ReplayRadio();
+    setMillis(VCLOCK_START_MS);
+    replayHeapReset();
+
+    m.init();
+    m.start();
+
+    ReplayCounters c;
+    std::vector<uint32_t> pktBuf;
+    uint64_t firstUs = frames.empty() ? 0 : frames.front().tsUs;
+    uint32_t nextUpdate = VCLOCK_START_MS + opt.loopMs;
+    auto wallStart = std::chrono::steady_clock::now();
+
+    auto runUpdatesUntil = [&](uint32_t nowMs) {
+        while ((int32_t)(nowMs - nextUpdate) >= 0) {
+            setMillis(nextUpdate);
+            m.update();
+            c.updates++;
+            replayHeapSample();
+            nextUpdate += opt.loopMs;
+        }
+    };
+
+    for (const CapturedFrame& cf : frames) {
+        uint64_t relUs = cf.tsUs >= firstUs ? cf.tsUs - firstUs : 0;
+        uint32_t nowMs = VCLOCK_START_MS + (uint32_t)(relUs / 1000);
+
+        if (opt.wire) {
+            std::this_thread::sleep_until(wallStart + std::chrono::microseconds(relUs));
+        }
+
+        runUpdatesUntil(nowMs);
+        setMillis(nowMs);
+        deliver(cf, opt, c, pktBuf);
+        replayHeapSample();
+    }
+
+    runUpdatesUntil(millis() + TAIL_DRAIN_MS);
+
+    double wallSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    printReport(m, c, frames.size(), wallSec);
+
+    m.stop();
+}
+
+// Time MgmtFrameView::parse over every beacon / probe response in the capture
+static void runParseBench(const std::vector<CapturedFrame>& frames) {
+    std::vector<const CapturedFrame*> mgmt;
+    size_t bytes = 0;
+    for (const CapturedFrame& cf : frames) {
+        if (cf.data.size() < MGMT_IE_OFFSET) continue;
+        uint8_t fc = cf.data[0];
+        if (fc == 0x80 || fc == 0x50) {
+            mgmt.push_back(&cf);
+            bytes += cf.data.size();
+        }
+    }
+    printf("\n=== parse-bench ===\n");
+    if (mgmt.empty()) {
+        printf("no beacons or probe responses in capture\n");
+        return;
+    }
+
+    uint32_t rounds = (uint32_t)(2000000 / mgmt.size()) + 1;
+    uint32_t rsn = 0, hidden = 0, truncated = 0;
+    MgmtFrameView view;
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t r = 0; r < rounds; r++) {
+        for (const CapturedFrame* cf : mgmt) {
+            view.parse(cf->data.data(), (uint16_t)cf->data.size());
+            rsn += view.hasRSN();
+            hidden += view.isHidden();
+            truncated += view.truncated;
+        }
+    }
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    double parses = (double)rounds * mgmt.size();
+    printf("frames      %zu beacons/probe responses, avg %zu bytes, %u rounds\n",
+           mgmt.size(), bytes / mgmt.size(), rounds);
+    printf("parse       %.1f ns/frame, %.0f MB/s\n",
+           sec * 1e9 / parses, sec > 0 ? parses * (bytes / (double)mgmt.size()) / sec / 1e6 : 0.0);
+    printf("content     %.0f%% RSN, %.0f%% hidden, %.0f%% truncated IEs\n",
+           100.0 * rsn / parses, 100.0 * hidden / parses, 100.0 * truncated / parses);
+}
+
+static void usage() {
+    fprintf(stderr,
+            "usage: replay [options] capture.pcap\n"
+            "  --mode oink|dnh|warhog|all  mode(s) to drive (default oink)\n"
+            "  --loop-ms N                 update() period in capture time (default 50)\n"
+            "  --wire                      pace delivery to the capture timestamps\n"
+            "  --honor-channel             drop frames not on the channel the mode tuned\n"
+            "  --heap-kb N                 heap budget for ESP.getFreeHeap() (default 320)\n"
+            "  --sd DIR                    back the SD card with DIR (default: no card)\n"
+            "  --session                   OINK session capture to DIR/sessions (needs --sd)\n"
+            "  --parse-bench               time the mgmt frame parser over the capture's beacons\n");
+}
+
+int main(int argc, char **argv) {
+    ReplayOptions opt;
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        bool hasNext = i + 1 < argc;
+        if (strcmp(a, "--mode") == 0 && hasNext) opt.mode = argv[++i];
+        else if (strcmp(a, "--loop-ms") == 0 && hasNext) opt.loopMs = (uint32_t)atoi(argv[++i]);
+        else if (strcmp(a, "--wire") == 0) opt.wire = true;
+        else if (strcmp(a, "--honor-channel") == 0) opt.honorChannel = true;
+        else if (strcmp(a, "--heap-kb") == 0 && hasNext) replayHeapBudget = (uint32_t)atoi(argv[++i]) * 1024;
+        else if (strcmp(a, "--sd") == 0 && hasNext) opt.sdRoot = argv[++i];
+        else if (strcmp(a, "--session") == 0) opt.session = true;
+        else if (strcmp(a, "--parse-bench") == 0) opt.parseBench = true;
+        else if (a[0] != '-' && !opt.path) opt.path = a;
+        else { usage(); return 2; }
+    }
+    if (!opt.path || opt.loopMs == 0) { usage(); return 2; }
+
+    if (opt.sdRoot) SD.setRoot(opt.sdRoot);
+    Config::wifi().sessionCapture = opt.session;
+
+    std::vector<CapturedFrame> frames;
+    if (!loadPcap(opt.path, frames)) return 1;
+    printf("replay: %zu frames from %s\n", frames.size(), opt.path);
+
+    if (opt.parseBench) {
+        runParseBench(frames);
+        return 0;
+    }
+
+    bool all = strcmp(opt.mode, "all") == 0;
+    bool ran = false;
+    for (const ModeHooks& m : MODES) {
+        if (all || strcmp(opt.mode, m.name) == 0) {
+            runMode(m, frames, opt);
+            ran = true;
+        }
+    }
+    if (!ran) { usage(); return 2; }
+    return 0;
+}
@@ -0,0 +1,212 @@
+// Replay harness - link-time stand-ins for everything the capture modes
+// call outside themselves (UI, mood, XP, GPS, radio, FreeRTOS).
+// UI/feedback calls are accepted and dropped; the radio records what the
+// mode asked for so replay_main.cpp can honour the promiscuous filter.
+#include <malloc.h>
+#include <chrono>
+#include <SD.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "replay.h"
+
+#include "../../src/core/config.h"
+#include "../../src/core/sdlog.h"
+#include "../../src/core/wsl_bypasser.h"
+#include "../../src/core/xp.h"
+#include "../../src/gps/gps.h"
+#include "../../src/piglet/avatar.h"
+#include "../../src/piglet/mood.h"
+#include "../../src/ui/display.h"
+#include "../../src/ui/swine_stats.h"
+
+// ============================================================
+// Radio
+// ============================================================
+
+ReplayRadio replayRadio;
+
+esp_err_t esp_wifi_set_promiscuous(bool en) {
+    replayRadio.promiscuous = en;
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_set_promiscuous_rx_cb(wifi_promiscuous_cb_t cb) {
+    replayRadio.rxCallback = cb;
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_set_promiscuous_filter(const wifi_promiscuous_filter_t* filter) {
+    replayRadio.filterMask = filter ? filter->filter_mask : WIFI_PROMIS_FILTER_MASK_ALL;
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_set_channel(uint8_t primary, wifi_second_chan_t second) {
+    (void)second;
+    replayRadio.channel = primary;
+    replayRadio.channelSwitches++;
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_get_channel(uint8_t* primary, wifi_second_chan_t* second) {
+    if (primary) *primary = replayRadio.channel;
+    if (second) *second = WIFI_SECOND_CHAN_NONE;
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_80211_tx(wifi_interface_t ifx, const void* buffer, int len, bool en_sys_seq) {
+    (void)ifx; (void)buffer; (void)len; (void)en_sys_seq;
+    replayRadio.txFrames++;
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_get_mac(wifi_interface_t ifx, uint8_t mac[6]) {
+    (void)ifx;
+    static const uint8_t fixed[6] = {0x02, 0x50, 0x49, 0x47, 0x00, 0x01};
+    memcpy(mac, fixed, 6);
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_set_mac(wifi_interface_t ifx, const uint8_t mac[6]) {
+    (void)ifx; (void)mac;
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_start() { return ESP_OK; }
+esp_err_t esp_wifi_stop() { return ESP_OK; }
+
+// ============================================================
+// FreeRTOS - tasks run to completion inline on the caller
+// ============================================================
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stackDepth,
+                                   void* param, UBaseType_t priority, TaskHandle_t* handle,
+                                   BaseType_t coreId) {
+    (void)name; (void)stackDepth; (void)priority; (void)coreId;
+    static int dummyTask;
+    // Handle is published before the body runs, same as a real task that
+    // gets scheduled immediately; tasks that clear it on exit still can.
+    if (handle) *handle = &dummyTask;
+    fn(param);
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t handle) { (void)handle; }
+void vTaskDelay(TickType_t ticks) { (void)ticks; }
+
+// ============================================================
+// Heap model
+// ============================================================
+// The device has a few hundred KB of internal RAM and no PSRAM. Free heap
+// is the configured budget minus whatever the process allocated since
+// replayHeapReset(), so the modes' own low-heap guards fire at realistic
+// points and the peak can be reported.
+
+EspClass ESP;
+uint32_t replayHeapBudget = 320 * 1024;
+
+static size_t heapBaseline = 0;
+static uint32_t heapMinFree = 0;
+
+static size_t heapInUse() {
+    struct mallinfo2 mi = mallinfo2();
+    return mi.uordblks > heapBaseline ? mi.uordblks - heapBaseline : 0;
+}
+
+void replayHeapReset() {
+    heapBaseline = mallinfo2().uordblks;
+    heapMinFree = replayHeapBudget;
+}
+
+uint32_t replayHeapSample() {
+    uint32_t freeNow = ESP.getFreeHeap();
+    if (freeNow < heapMinFree) heapMinFree = freeNow;
+    return freeNow;
+}
+
+uint32_t replayHeapPeakUsed() {
+    return replayHeapBudget - heapMinFree;
+}
+
+uint32_t EspClass::getFreeHeap() {
+    size_t used = heapInUse();
+    return used >= replayHeapBudget ? 0 : (uint32_t)(replayHeapBudget - used);
+}
+
+uint32_t EspClass::getMinFreeHeap() {
+    replayHeapSample();
+    return heapMinFree;
+}
+
+// Fragmentation isn't modelled; assume the largest block is most of free
+uint32_t EspClass::getMaxAllocHeap() { return getFreeHeap() * 3 / 4; }
+uint32_t EspClass::getHeapSize() { return replayHeapBudget; }
+
+uint32_t EspClass::getCycleCount() {
+    auto ns = std::chrono::steady_clock::now().time_since_epoch();
+    return (uint32_t)(std::chrono::duration_cast<std::chrono::nanoseconds>(ns).count() * 240 / 1000);
+}
+
+// ============================================================
+// Config
+// ============================================================
+
+GPSConfig Config::gpsConfig;
+MLConfig Config::mlConfig;
+WiFiConfig Config::wifiConfig;
+PersonalityConfig Config::personalityConfig;
+
+bool Config::isSDAvailable() { return !SD.getRoot().empty(); }
+
+// ============================================================
+// Feedback: mood, avatar, display, XP (accepted and ignored)
+// ============================================================
+
+void Mood::onHandshakeCaptured(const char*) {}
+void Mood::onPMKIDCaptured(const char*) {}
+void Mood::onNewNetwork(const char*, int8_t, uint8_t) {}
+void Mood::setStatusMessage(const String&) {}
+void Mood::onSniffing(uint16_t, uint8_t) {}
+void Mood::onPassiveRecon(uint16_t, uint8_t) {}
+void Mood::onDeauthing(const char*, uint32_t) {}
+void Mood::onDeauthSuccess(const uint8_t*) {}
+void Mood::onBored(uint16_t) {}
+void Mood::onWarhogUpdate() {}
+void Mood::onWarhogFound(const char*, uint8_t) {}
+
+void Avatar::setState(AvatarState) {}
+void Avatar::sniff() {}
+void Avatar::setGrassMoving(bool, bool) {}
+void Avatar::setGrassSpeed(uint16_t) {}
+
+void Display::showToast(const String&) {}
+void Display::showLoot(const String&) {}
+void Display::setWiFiStatus(bool) {}
+
+static SessionStats replaySession = {};
+void XP::addXP(XPEvent) {}
+void XP::addDistance(uint32_t) {}
+void XP::processPendingSave() {}
+const SessionStats& XP::getSession() { return replaySession; }
+
+void SDLog::log(const char*, const char*, ...) {}
+
+void WSLBypasser::init() {}
+void WSLBypasser::randomizeMAC() {}
+
+// ============================================================
+// GPS - pcaps carry no position, so never a fix
+// ============================================================
+
+void GPS::sleep() {}
+void GPS::wake() {}
+bool GPS::hasFix() { return false; }
+GPSData GPS::getData() { return GPSData{}; }
+
+// ============================================================
+// SwineStats - unbuffed base values
+// ============================================================
+
+uint8_t SwineStats::getDeauthBurstCount() { return 4; }
+uint8_t SwineStats::getDeauthJitterMax() { return 5; }
+uint16_t SwineStats::getChannelHopInterval() { return Config::wifi().channelHopInterval; }
+uint32_t SwineStats::getLockTime() { return Config::wifi().lockTime; }
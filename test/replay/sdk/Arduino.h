@@ -0,0 +1,43 @@
+// Replay harness stand-in for <Arduino.h>
+// Wraps test/mocks/mock_arduino.h and adds the ESP32 core bits the
+// capture modes touch (ESP heap queries, PROGMEM, FreeRTOS types).
+#pragma once
+
+// Pull in the STL before mock_arduino.h defines its min/max macros
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <cstdarg>
+#include <ctime>
+#include "../../mocks/mock_arduino.h"
+
+// Heap numbers come from the harness heap model (replay_stubs.cpp)
+class EspClass {
+public:
+    uint32_t getFreeHeap();
+    uint32_t getMinFreeHeap();
+    uint32_t getMaxAllocHeap();
+    uint32_t getHeapSize();
+    uint32_t getCycleCount();  // Host clock scaled to a 240 MHz core
+    void restart() {}
+};
+extern EspClass ESP;
+
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+
+#define IRAM_ATTR
+
+// esp_system.h (pulled in by the real Arduino.h)
+inline uint32_t esp_random() { return ((uint32_t)std::rand() << 16) ^ (uint32_t)std::rand(); }
@@ -0,0 +1,3 @@
+// Replay harness stand-in for <ArduinoJson.h>
+// config.h includes it but the capture path never builds a document.
+#pragma once
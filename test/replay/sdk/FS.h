@@ -0,0 +1,5 @@
+// Replay harness stand-in for <FS.h>
+#pragma once
+
+#include <Arduino.h>
+#include "../../mocks/mock_fs.h"
@@ -0,0 +1,4 @@
+// Replay harness stand-in for <M5Cardputer.h>
+#pragma once
+
+#include <M5Unified.h>
@@ -0,0 +1,22 @@
+// Replay harness stand-in for <M5Unified.h>
+// Canvas and speaker only appear on UI paths; they accept calls and do nothing.
+#pragma once
+
+#include <Arduino.h>
+
+class M5Canvas {};
+
+class M5SpeakerStub {
+public:
+    bool tone(float freq, uint32_t durationMs = 0, int channel = -1, bool stopCurrent = true) {
+        (void)freq; (void)durationMs; (void)channel; (void)stopCurrent;
+        return true;
+    }
+};
+
+class M5UnifiedStub {
+public:
+    M5SpeakerStub Speaker;
+};
+
+inline M5UnifiedStub M5;
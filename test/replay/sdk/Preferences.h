@@ -0,0 +1,4 @@
+// Replay harness stand-in for <Preferences.h>
+#pragma once
+
+#include "../../mocks/mock_preferences.h"
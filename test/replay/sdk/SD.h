@@ -0,0 +1,4 @@
+// Replay harness stand-in for <SD.h>
+#pragma once
+
+#include <FS.h>
@@ -0,0 +1,5 @@
+// Replay harness stand-in for <TinyGPSPlus.h>
+#pragma once
+
+class TinyGPSPlus {};
+class HardwareSerial {};
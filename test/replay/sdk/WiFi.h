@@ -0,0 +1,37 @@
+// Replay harness stand-in for <WiFi.h>
+// No radio: scans return nothing, mode changes are accepted and ignored.
+#pragma once
+
+#include <Arduino.h>
+#include <esp_wifi.h>
+
+typedef enum {
+    WIFI_OFF = 0,
+    WIFI_STA,
+    WIFI_AP,
+    WIFI_AP_STA
+} wifi_mode_t;
+
+class WiFiClass {
+public:
+    bool mode(wifi_mode_t m) { currentMode = m; return true; }
+    wifi_mode_t getMode() const { return currentMode; }
+    bool disconnect(bool wifiOff = false, bool eraseAp = false) { (void)wifiOff; (void)eraseAp; return true; }
+    int16_t scanNetworks(bool async = false, bool showHidden = false, bool passive = false,
+                         uint32_t maxMsPerChan = 300, uint8_t channel = 0) {
+        (void)async; (void)showHidden; (void)passive; (void)maxMsPerChan; (void)channel;
+        return 0;
+    }
+    int16_t scanComplete() { return 0; }
+    void scanDelete() {}
+    String SSID(uint8_t i) { (void)i; return String(""); }
+    int32_t RSSI(uint8_t i) { (void)i; return 0; }
+    int32_t channel(uint8_t i) { (void)i; return 0; }
+    uint8_t* BSSID(uint8_t i) { (void)i; static uint8_t zero[6] = {0}; return zero; }
+    wifi_auth_mode_t encryptionType(uint8_t i) { (void)i; return WIFI_AUTH_OPEN; }
+
+private:
+    wifi_mode_t currentMode = WIFI_OFF;
+};
+
+inline WiFiClass WiFi;
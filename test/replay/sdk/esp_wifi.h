@@ -0,0 +1,32 @@
+// Replay harness stand-in for <esp_wifi.h>
+// Types come from test/mocks/mock_esp_wifi.h; calls are recorded, not sent.
+#pragma once
+
+#include "../../mocks/mock_esp_wifi.h"
+
+typedef void (*wifi_promiscuous_cb_t)(void* buf, wifi_promiscuous_pkt_type_t type);
+
+typedef enum {
+    WIFI_IF_STA = 0,
+    WIFI_IF_AP,
+} wifi_interface_t;
+
+typedef struct {
+    uint32_t filter_mask;
+} wifi_promiscuous_filter_t;
+
+#define WIFI_PROMIS_FILTER_MASK_ALL   0xFFFFFFFF
+#define WIFI_PROMIS_FILTER_MASK_MGMT  (1 << 0)
+#define WIFI_PROMIS_FILTER_MASK_CTRL  (1 << 1)
+#define WIFI_PROMIS_FILTER_MASK_DATA  (1 << 2)
+
+esp_err_t esp_wifi_set_promiscuous(bool en);
+esp_err_t esp_wifi_set_promiscuous_rx_cb(wifi_promiscuous_cb_t cb);
+esp_err_t esp_wifi_set_promiscuous_filter(const wifi_promiscuous_filter_t* filter);
+esp_err_t esp_wifi_set_channel(uint8_t primary, wifi_second_chan_t second);
+esp_err_t esp_wifi_get_channel(uint8_t* primary, wifi_second_chan_t* second);
+esp_err_t esp_wifi_80211_tx(wifi_interface_t ifx, const void* buffer, int len, bool en_sys_seq);
+esp_err_t esp_wifi_get_mac(wifi_interface_t ifx, uint8_t mac[6]);
+esp_err_t esp_wifi_set_mac(wifi_interface_t ifx, const uint8_t mac[6]);
+esp_err_t esp_wifi_start();
+esp_err_t esp_wifi_stop();
@@ -0,0 +1,4 @@
+// Replay harness stand-in for <esp_wifi_types.h>
+#pragma once
+
+#include <esp_wifi.h>
@@ -0,0 +1,13 @@
+// Replay harness stand-in for <freertos/task.h>
+// Tasks are not run: the harness drives each mode's update() itself.
+#pragma once
+
+#include "FreeRTOS.h"
+
+typedef void (*TaskFunction_t)(void*);
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stackDepth,
+                                   void* param, UBaseType_t priority, TaskHandle_t* handle,
+                                   BaseType_t coreId);
+void vTaskDelete(TaskHandle_t handle);
+void vTaskDelay(TickType_t ticks);
@@ -0,0 +1,370 @@
+// Async Classifier Tests
+// Tests the request/completion rings behind MLInference::classifyAsync:
+// ordering, the in-flight bound, rejection instead of blocking, stats,
+// then the real worker thread against a main loop that submits and drains:
+// every result delivered once, in order, on the main thread, with the
+// classifier itself only ever running on the worker.
+
+#include <unity.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include "../../src/ml/async_classifier.h"
+#include "../../src/ml/heuristic.h"
+
+void setUp(void) {
+    // No setup needed
+}
+
+void tearDown(void) {
+    // No teardown needed
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static const size_t FEATURES = 32;
+
+struct TestResult {
+    float sum;
+    uint16_t count;
+    uint8_t label;
+};
+
+typedef AsyncClassifier<8, FEATURES, TestResult> Queue;
+
+static uint32_t nowUs() {
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static TestResult sumFeatures(const float* x, size_t n) {
+    TestResult r;
+    r.sum = 0;
+    for (size_t i = 0; i < n; i++) r.sum += x[i];
+    r.count = (uint16_t)n;
+    r.label = 0;
+    return r;
+}
+
+// Classifier that notes which thread it ran on
+static std::atomic<std::thread::id> classifyThread;
+static std::atomic<uint32_t> classifyCalls(0);
+
+static TestResult sumOnAnyThread(const float* x, size_t n) {
+    classifyThread.store(std::this_thread::get_id());
+    classifyCalls++;
+    return sumFeatures(x, n);
+}
+
+static TestResult slowSum(const float* x, size_t n) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    return sumFeatures(x, n);
+}
+
+static TestResult heuristic(const float* x, size_t n) {
+    TestResult r;
+    float scores[HeuristicClassifier::CLASSES];
+    r.label = n >= 23 ? HeuristicClassifier::classify(x, scores) : 255;
+    r.sum = 0;
+    r.count = (uint16_t)n;
+    return r;
+}
+
+static void fill(float* x, size_t n, float v) {
+    for (size_t i = 0; i < n; i++) x[i] = v;
+}
+
+// ============================================================================
+// Rings (no worker)
+// ============================================================================
+
+void test_submit_service_drain_in_order(void) {
+    Queue q;
+    float x[FEATURES];
+    uint32_t tickets[3];
+    for (int i = 0; i < 3; i++) {
+        fill(x, FEATURES, (float)(i + 1));
+        TEST_ASSERT_TRUE(q.submit(x, FEATURES, 100, &tickets[i]));
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, tickets[0]);
+    TEST_ASSERT_EQUAL_UINT32(3, tickets[2]);
+    TEST_ASSERT_EQUAL_size_t(3, q.depth());
+
+    TEST_ASSERT_EQUAL_size_t(0, q.drain(150, [](uint32_t, const TestResult&) {}));  // Nothing done yet
+    while (q.serviceOne(sumFeatures)) {}
+
+    uint32_t seen[3];
+    float sums[3];
+    int n = 0;
+    q.drain(300, [&](uint32_t ticket, const TestResult& r) {
+        seen[n] = ticket;
+        sums[n] = r.sum;
+        n++;
+    });
+    TEST_ASSERT_EQUAL_INT(3, n);
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_UINT32(tickets[i], seen[i]);
+        TEST_ASSERT_EQUAL_FLOAT(32.0f * (i + 1), sums[i]);
+    }
+    TEST_ASSERT_EQUAL_size_t(0, q.depth());
+    TEST_ASSERT_EQUAL_UINT32(200, q.stats().avgLatencyUs);
+}
+
+void test_submit_copies_features(void) {
+    Queue q;
+    float x[FEATURES];
+    fill(x, FEATURES, 1.0f);
+    q.submit(x, FEATURES, 0);
+    fill(x, FEATURES, 9.0f);  // Caller reuses its buffer at once
+    q.serviceOne(sumFeatures);
+    float sum = 0;
+    q.drain(0, [&](uint32_t, const TestResult& r) { sum = r.sum; });
+    TEST_ASSERT_EQUAL_FLOAT(32.0f, sum);
+}
+
+void test_extra_features_are_cut(void) {
+    Queue q;
+    float x[FEATURES + 8];
+    fill(x, FEATURES + 8, 1.0f);
+    q.submit(x, FEATURES + 8, 0);
+    q.serviceOne(sumFeatures);
+    uint16_t count = 0;
+    q.drain(0, [&](uint32_t, const TestResult& r) { count = r.count; });
+    TEST_ASSERT_EQUAL_UINT16(FEATURES, count);
+}
+
+void test_full_queue_rejects_until_drained(void) {
+    Queue q;
+    float x[FEATURES] = {0};
+    for (int i = 0; i < 8; i++) TEST_ASSERT_TRUE(q.submit(x, FEATURES, 0));
+    TEST_ASSERT_FALSE(q.submit(x, FEATURES, 0));
+
+    // Finished but not yet drained still counts as in flight
+    while (q.serviceOne(sumFeatures)) {}
+    TEST_ASSERT_FALSE(q.submit(x, FEATURES, 0));
+
+    TEST_ASSERT_EQUAL_size_t(2, q.drain(0, [](uint32_t, const TestResult&) {}, 2));
+    TEST_ASSERT_TRUE(q.submit(x, FEATURES, 0));
+    TEST_ASSERT_TRUE(q.submit(x, FEATURES, 0));
+    TEST_ASSERT_FALSE(q.submit(x, FEATURES, 0));
+
+    AsyncClassifierStats s = q.stats();
+    TEST_ASSERT_EQUAL_UINT32(10, s.submitted);
+    TEST_ASSERT_EQUAL_UINT32(3, s.rejected);
+    TEST_ASSERT_EQUAL_UINT16(8, s.depth);
+    TEST_ASSERT_EQUAL_UINT16(8, s.highWater);
+}
+
+void test_ticket_slots_unique_in_flight(void) {
+    Queue q;
+    float x[FEATURES] = {0};
+    bool slotUsed[8] = {false};
+    uint32_t t;
+    for (int round = 0; round < 50; round++) {
+        while (q.submit(x, FEATURES, 0, &t)) {
+            TEST_ASSERT_FALSE(slotUsed[t % 8]);
+            slotUsed[t % 8] = true;
+        }
+        q.serviceOne(sumFeatures);
+        q.serviceOne(sumFeatures);
+        q.drain(0, [&](uint32_t ticket, const TestResult&) { slotUsed[ticket % 8] = false; });
+    }
+}
+
+void test_deliver_may_submit_again(void) {
+    Queue q;
+    float x[FEATURES];
+    fill(x, FEATURES, 1.0f);
+    q.submit(x, FEATURES, 0);
+    int chained = 0;
+    for (int i = 0; i < 20; i++) {
+        q.serviceOne(sumFeatures);
+        q.drain(0, [&](uint32_t, const TestResult&) {
+            if (chained < 10 && q.submit(x, FEATURES, 0)) chained++;
+        });
+    }
+    TEST_ASSERT_EQUAL_INT(10, chained);
+    TEST_ASSERT_EQUAL_UINT32(11, q.stats().delivered);
+}
+
+void test_latency_stats(void) {
+    Queue q;
+    float x[FEATURES] = {0};
+    q.submit(x, FEATURES, 1000);
+    q.submit(x, FEATURES, 1000);
+    while (q.serviceOne(sumFeatures)) {}
+    q.drain(1100, [](uint32_t, const TestResult&) {}, 1);
+    q.drain(1500, [](uint32_t, const TestResult&) {});
+    AsyncClassifierStats s = q.stats();
+    TEST_ASSERT_EQUAL_UINT32(300, s.avgLatencyUs);
+    TEST_ASSERT_EQUAL_UINT32(500, s.maxLatencyUs);
+
+    q.resetStats();
+    s = q.stats();
+    TEST_ASSERT_EQUAL_UINT32(0, s.avgLatencyUs);
+    TEST_ASSERT_EQUAL_UINT32(0, s.maxLatencyUs);
+    TEST_ASSERT_EQUAL_UINT16(0, s.depth);
+}
+
+// ============================================================================
+// Worker thread
+// ============================================================================
+
+void test_worker_delivers_everything_once_in_order_on_main(void) {
+    static Queue q;
+    classifyCalls = 0;
+    TEST_ASSERT_TRUE(q.start(sumOnAnyThread));
+    std::thread::id mainThread = std::this_thread::get_id();
+
+    const uint32_t TOTAL = 20000;
+    uint32_t sent = 0, received = 0, rejected = 0;
+    bool orderOk = true, valuesOk = true, threadOk = true;
+    uint32_t expectTicket = 1;
+    float x[FEATURES];
+    auto deliver = [&](uint32_t ticket, const TestResult& r) {
+        if (std::this_thread::get_id() != mainThread) threadOk = false;
+        if (ticket != expectTicket++) orderOk = false;
+        if (r.sum != (float)((ticket - 1) % 97) * FEATURES) valuesOk = false;
+        received++;
+    };
+
+    while (received < TOTAL) {
+        if (sent < TOTAL) {
+            fill(x, FEATURES, (float)(sent % 97));
+            if (q.submit(x, FEATURES, nowUs())) sent++;
+            else rejected++;
+        }
+        q.drain(nowUs(), deliver);
+    }
+    q.stop();
+
+    TEST_ASSERT_TRUE(threadOk);
+    TEST_ASSERT_TRUE(orderOk);
+    TEST_ASSERT_TRUE(valuesOk);
+    TEST_ASSERT_EQUAL_UINT32(TOTAL, classifyCalls.load());
+    TEST_ASSERT_TRUE(classifyThread.load() != mainThread);
+    AsyncClassifierStats s = q.stats();
+    TEST_ASSERT_EQUAL_UINT32(TOTAL, s.delivered);
+    TEST_ASSERT_EQUAL_UINT16(0, s.depth);
+    TEST_ASSERT_TRUE(s.highWater <= 8);
+    printf("[BENCH] %u requests through the worker: %u rejected while full, peak depth %u, "
+           "latency avg %u us, max %u us\n",
+           (unsigned)TOTAL, (unsigned)rejected, (unsigned)s.highWater,
+           (unsigned)s.avgLatencyUs, (unsigned)s.maxLatencyUs);
+}
+
+void test_main_loop_never_waits_on_slow_worker(void) {
+    static Queue q;
+    TEST_ASSERT_TRUE(q.start(slowSum));  // 2 ms per request
+
+    float x[FEATURES] = {0};
+    double worstSubmitUs = 0, worstDrainUs = 0;
+    uint32_t accepted = 0, refused = 0, delivered = 0, calls = 0, stalls = 0;
+    auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+    while (std::chrono::steady_clock::now() < until) {
+        auto t0 = std::chrono::steady_clock::now();
+        if (q.submit(x, FEATURES, nowUs())) accepted++;
+        else refused++;
+        auto t1 = std::chrono::steady_clock::now();
+        delivered += q.drain(nowUs(), [](uint32_t, const TestResult&) {});
+        auto t2 = std::chrono::steady_clock::now();
+        double s = std::chrono::duration<double, std::micro>(t1 - t0).count();
+        double d = std::chrono::duration<double, std::micro>(t2 - t1).count();
+        if (s > worstSubmitUs) worstSubmitUs = s;
+        if (d > worstDrainUs) worstDrainUs = d;
+        if (s >= 1000.0 || d >= 1000.0) stalls++;  // Half an inference
+        calls++;
+    }
+    q.stop();
+
+    // A 2 ms inference never shows up on the loop: full means "no", not
+    // "wait". The host scheduler may still preempt the odd call, so count
+    // slow iterations rather than trusting the single worst one.
+    printf("[BENCH] slow worker: %u accepted, %u refused, %u delivered; worst submit %.0f us, drain %.0f us, "
+           "%u of %u iterations over 1 ms\n",
+           (unsigned)accepted, (unsigned)refused, (unsigned)delivered, worstSubmitUs, worstDrainUs,
+           (unsigned)stalls, (unsigned)calls);
+    TEST_ASSERT_TRUE(refused > 0);
+    TEST_ASSERT_TRUE(delivered > 10);
+    TEST_ASSERT_TRUE(stalls * 1000 < calls);
+    TEST_ASSERT_TRUE(q.stats().maxLatencyUs >= 2000);
+}
+
+void test_stop_keeps_queued_requests_for_restart(void) {
+    static Queue q;
+    float x[FEATURES];
+    fill(x, FEATURES, 2.0f);
+    for (int i = 0; i < 5; i++) q.submit(x, FEATURES, 0);  // Not started: stays queued
+    TEST_ASSERT_EQUAL_size_t(0, q.drain(0, [](uint32_t, const TestResult&) {}));
+
+    TEST_ASSERT_TRUE(q.start(sumFeatures));
+    size_t got = 0;
+    auto until = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (got < 5 && std::chrono::steady_clock::now() < until) {
+        got += q.drain(0, [](uint32_t, const TestResult&) {});
+    }
+    q.stop();
+    TEST_ASSERT_FALSE(q.isRunning());
+    TEST_ASSERT_EQUAL_size_t(5, got);
+
+    // Restart after stop
+    TEST_ASSERT_TRUE(q.start(sumFeatures));
+    q.submit(x, FEATURES, 0);
+    got = 0;
+    until = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (got < 1 && std::chrono::steady_clock::now() < until) {
+        got += q.drain(0, [](uint32_t, const TestResult&) {});
+    }
+    q.stop();
+    TEST_ASSERT_EQUAL_size_t(1, got);
+}
+
+void test_worker_runs_heuristic_same_as_inline(void) {
+    static AsyncClassifier<16, FEATURES, TestResult> q;
+    TEST_ASSERT_TRUE(q.start(heuristic));
+
+    // Loud open WPS soft AP vs a WPA3 router (see test_batch_classify)
+    float rogue[FEATURES] = {0}, router[FEATURES] = {0};
+    rogue[0] = -20; rogue[3] = 3; rogue[5] = 20; rogue[8] = 1; rogue[15] = 20; rogue[19] = 2; rogue[21] = 1;
+    router[0] = -60; router[3] = 6; router[5] = 100; router[10] = 1; router[11] = 1;
+    router[18] = 4; router[19] = 12; router[20] = 1;
+
+    uint8_t labels[2] = {99, 99};
+    uint32_t first = 0;
+    q.submit(rogue, FEATURES, 0, &first);
+    q.submit(router, FEATURES, 0);
+    size_t got = 0;
+    auto until = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (got < 2 && std::chrono::steady_clock::now() < until) {
+        got += q.drain(0, [&](uint32_t ticket, const TestResult& r) { labels[ticket - first] = r.label; });
+    }
+    q.stop();
+    TEST_ASSERT_EQUAL_UINT8(heuristic(rogue, FEATURES).label, labels[0]);
+    TEST_ASSERT_EQUAL_UINT8(1, labels[0]);  // ROGUE_AP
+    TEST_ASSERT_EQUAL_UINT8(0, labels[1]);  // NORMAL
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Rings (no worker)
+    RUN_TEST(test_submit_service_drain_in_order);
+    RUN_TEST(test_submit_copies_features);
+    RUN_TEST(test_extra_features_are_cut);
+    RUN_TEST(test_full_queue_rejects_until_drained);
+    RUN_TEST(test_ticket_slots_unique_in_flight);
+    RUN_TEST(test_deliver_may_submit_again);
+    RUN_TEST(test_latency_stats);
+
+    // Worker thread
+    RUN_TEST(test_worker_delivers_everything_once_in_order_on_main);
+    RUN_TEST(test_main_loop_never_waits_on_slow_worker);
+    RUN_TEST(test_stop_keeps_queued_requests_for_restart);
+    RUN_TEST(test_worker_runs_heuristic_same_as_inline);
+
+    return UNITY_END();
+}
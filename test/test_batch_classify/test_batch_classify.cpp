@@ -0,0 +1,382 @@
+// Batch Classification Tests
+// Tests BatchClassifier::run, the loop behind MLInference::classifyBatch:
+// the feature matrix one row per network (normalized rows, untouched spare
+// rows), the heuristic and fixed-point classifiers reading rows of it in
+// place, the capacity cap, one reaction per batch, and a 100-AP sweep
+// through a caller-owned arena with no heap. Benchmarks the per-network
+// path (row vector + classify + mood per AP) against the batch.
+
+#include <unity.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "../mocks/alloc_counter.h"  // Shows a sweep makes no heap allocation
+#include "../mocks/testable_functions.h"
+#include "../../src/ml/batch_classifier.h"
+#include "../../src/ml/heuristic.h"
+#include "../../src/ml/quant_model.h"
+
+void setUp(void) {
+    // No setup needed
+}
+
+void tearDown(void) {
+    // No teardown needed
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static const size_t CLASSES = HeuristicClassifier::CLASSES;
+static const size_t SCAN = 100;  // A busy WARHOG scan
+
+// Shaped like MLResult
+struct TestResult {
+    uint8_t label;
+    float confidence;
+    float scores[CLASSES];
+    bool valid;
+};
+
+// Mix of home routers, open hotspots, WPS boxes, hidden and soft APs
+static std::vector<TestWiFiFeatures> makeScan(size_t n, uint32_t seed = 1) {
+    std::mt19937 rng(seed);
+    std::vector<TestWiFiFeatures> scan(n);
+    const uint8_t channels[] = {1, 6, 11, 3, 9, 13};
+    for (size_t i = 0; i < n; i++) {
+        TestWiFiFeatures& f = scan[i];
+        memset(&f, 0, sizeof(f));
+        f.rssi = (int8_t)(-25 - (int)(rng() % 70));
+        f.noise = -95;
+        f.snr = (float)(f.rssi - f.noise);
+        f.channel = channels[rng() % 6];
+        f.beaconInterval = (rng() % 10) ? 100 : 20;
+        f.capability = 0x0431;
+        uint32_t kind = rng() % 5;
+        f.hasWPA2 = kind >= 2;
+        f.hasWPA3 = kind == 4;
+        f.hasWPA = kind == 1;
+        f.hasWPS = rng() % 3 == 0;
+        f.isHidden = rng() % 8 == 0;
+        f.beaconCount = (uint16_t)(rng() % 400);
+        f.beaconJitter = (rng() % 6) ? 0.01f : 18.0f;
+        f.vendorIECount = (uint8_t)(rng() % 5);
+        f.supportedRates = (uint8_t)(rng() % 16);
+        f.htCapabilities = (uint8_t)(rng() % 2);
+        f.vhtCapabilities = (uint8_t)(rng() % 2);
+    }
+    return scan;
+}
+
+// Caller-owned arena, as MLBatchBuffer<ROWS> lays it out
+template <size_t ROWS>
+struct Buffer {
+    float features[FI_VECTOR_SIZE * ROWS];
+    TestResult results[ROWS];
+
+    BatchArena<TestResult> arena() {
+        BatchArena<TestResult> a = {features, results, ROWS};
+        return a;
+    }
+};
+
+static Buffer<SCAN> buffer;
+
+// The pieces MLInference passes in (no model normalization loaded)
+static void toVector(const TestWiFiFeatures& f, float* vec) { toFeatureVectorRaw(f, vec); }
+static void zScore(float* vec) {
+    for (size_t f = 0; f < FI_VECTOR_SIZE; f++) vec[f] = (vec[f] - 10.0f) / 4.0f;
+}
+static void toZScored(const TestWiFiFeatures& f, float* vec) {
+    toFeatureVectorRaw(f, vec);
+    zScore(vec);
+}
+
+static TestResult heuristic(const float* x) {
+    TestResult r;
+    r.label = HeuristicClassifier::classify(x, r.scores);
+    r.confidence = r.scores[r.label];
+    r.valid = true;
+    return r;
+}
+
+static uint32_t moodUpdates = 0;
+static float lastMood = 0;
+
+static void moodUpdate(float confidence) {
+    lastMood = confidence;
+    moodUpdates++;
+}
+
+static size_t sweep(const TestWiFiFeatures* nets, size_t n, BatchArena<TestResult>& arena) {
+    return BatchClassifier::run<FI_VECTOR_SIZE>(nets, n, arena, toVector, heuristic, moodUpdate);
+}
+
+// Old path: a row vector, a classification and a mood update per AP
+static void classifyEach(const TestWiFiFeatures* nets, size_t n, uint8_t* labels) {
+    for (size_t i = 0; i < n; i++) {
+        float vec[FI_VECTOR_SIZE], scores[CLASSES];
+        toFeatureVectorRaw(nets[i], vec);
+        labels[i] = HeuristicClassifier::classify(vec, scores);
+        moodUpdate(scores[labels[i]]);
+    }
+}
+
+static void labelsOf(const TestResult* results, size_t n, uint8_t* labels) {
+    for (size_t i = 0; i < n; i++) labels[i] = results[i].label;
+}
+
+// ============================================================================
+// Feature matrix
+// ============================================================================
+
+void test_matrix_holds_normalized_rows(void) {
+    auto scan = makeScan(3);
+    Buffer<4> b;
+    for (float& v : b.features) v = -1234.0f;
+    BatchArena<TestResult> arena = b.arena();  // Capacity 4, 3 rows
+    size_t rows = BatchClassifier::run<FI_VECTOR_SIZE>(scan.data(), 3, arena, toZScored, heuristic,
+                                                       moodUpdate);
+    TEST_ASSERT_EQUAL_size_t(3, rows);
+
+    for (size_t r = 0; r < 3; r++) {
+        float vec[FI_VECTOR_SIZE];
+        toFeatureVectorRaw(scan[r], vec);
+        zScore(vec);
+        for (size_t f = 0; f < FI_VECTOR_SIZE; f++) {
+            TEST_ASSERT_EQUAL_FLOAT(vec[f], b.features[r * FI_VECTOR_SIZE + f]);
+        }
+    }
+    TEST_ASSERT_EQUAL_FLOAT(((float)scan[1].rssi - 10.0f) / 4.0f,
+                            b.features[FI_VECTOR_SIZE + FI_RSSI]);
+    // The unused fourth row is untouched
+    for (size_t f = 0; f < FI_VECTOR_SIZE; f++) {
+        TEST_ASSERT_EQUAL_FLOAT(-1234.0f, b.features[3 * FI_VECTOR_SIZE + f]);
+    }
+}
+
+void test_rows_capped_at_capacity(void) {
+    auto scan = makeScan(10);
+    Buffer<4> b;
+    BatchArena<TestResult> arena = b.arena();
+    TEST_ASSERT_EQUAL_size_t(4, sweep(scan.data(), 10, arena));
+    TEST_ASSERT_EQUAL_size_t(0, sweep(scan.data(), 0, arena));
+
+    BatchArena<TestResult> empty = {nullptr, nullptr, 4};
+    TEST_ASSERT_EQUAL_size_t(0, sweep(scan.data(), 10, empty));
+}
+
+// ============================================================================
+// Classifying rows in place
+// ============================================================================
+
+void test_heuristic_row_in_matrix_matches_row_vector(void) {
+    auto scan = makeScan(SCAN, 3);
+    BatchArena<TestResult> arena = buffer.arena();
+    sweep(scan.data(), SCAN, arena);
+    for (size_t r = 0; r < SCAN; r++) {
+        float vec[FI_VECTOR_SIZE], a[CLASSES];
+        toFeatureVectorRaw(scan[r], vec);
+        uint8_t la = HeuristicClassifier::classify(vec, a);
+        TEST_ASSERT_EQUAL_UINT8(la, buffer.results[r].label);
+        TEST_ASSERT_EQUAL_MEMORY(a, buffer.results[r].scores, sizeof(a));
+    }
+}
+
+void test_heuristic_scores_sum_to_one(void) {
+    auto scan = makeScan(50, 4);
+    for (auto& n : scan) {
+        float vec[FI_VECTOR_SIZE], s[CLASSES];
+        toFeatureVectorRaw(n, vec);
+        HeuristicClassifier::classify(vec, s);
+        float sum = 0;
+        for (float v : s) sum += v;
+        TEST_ASSERT_FLOAT_WITHIN(1e-5f, 1.0f, sum);
+    }
+}
+
+void test_heuristic_flags_soft_ap_honeypot(void) {
+    // Loud, 20 TU beacons, jittery, no vendor IEs, open + WPS, VHT without HT
+    TestWiFiFeatures f;
+    memset(&f, 0, sizeof(f));
+    f.rssi = -20; f.noise = -95; f.channel = 3; f.beaconInterval = 20;
+    f.beaconJitter = 20.0f; f.hasWPS = true; f.supportedRates = 2; f.vhtCapabilities = 1;
+    float vec[FI_VECTOR_SIZE], s[CLASSES];
+    toFeatureVectorRaw(f, vec);
+    TEST_ASSERT_EQUAL_UINT8(1, HeuristicClassifier::classify(vec, s));  // ROGUE_AP
+}
+
+void test_heuristic_passes_plain_wpa3_router(void) {
+    TestWiFiFeatures f;
+    memset(&f, 0, sizeof(f));
+    f.rssi = -60; f.noise = -95; f.channel = 6; f.beaconInterval = 100;
+    f.hasWPA2 = true; f.hasWPA3 = true; f.vendorIECount = 4; f.supportedRates = 12;
+    f.htCapabilities = 1;
+    float vec[FI_VECTOR_SIZE], s[CLASSES];
+    toFeatureVectorRaw(f, vec);
+    TEST_ASSERT_EQUAL_UINT8(0, HeuristicClassifier::classify(vec, s));  // NORMAL
+}
+
+// 32 -> 8 (ReLU) -> 5 model, weights from rng
+static std::vector<uint8_t> smallModel() {
+    std::mt19937 rng(21);
+    std::vector<uint8_t> p;
+    auto put16 = [&](uint16_t v) { p.push_back(v & 0xFF); p.push_back(v >> 8); };
+    auto put32 = [&](uint32_t v) { for (int i = 0; i < 4; i++) p.push_back((v >> (8 * i)) & 0xFF); };
+    for (int i = 0; i < 32; i++) {
+        float off = -50.0f, scale = 0.05f;
+        uint32_t u;
+        memcpy(&u, &off, 4); put32(u);
+        memcpy(&u, &scale, 4); put32(u);
+    }
+    const uint16_t dims[3] = {32, 8, 5};
+    for (int l = 0; l < 2; l++) {
+        p.push_back(l == 1 ? QuantModel::ACT_SOFTMAX : QuantModel::ACT_RELU);
+        p.push_back(6);
+        put16(dims[l]); put16(dims[l + 1]); put16(0);
+        for (int k = 0; k < dims[l] * dims[l + 1]; k++) p.push_back((uint8_t)(rng() % 64 - 32));
+        while (p.size() % 4) p.push_back(0);
+        for (int k = 0; k < dims[l + 1]; k++) put32((uint32_t)(int32_t)(rng() % 8192 - 4096));
+    }
+    std::vector<uint8_t> f = {'P', 'K', 'M', 'L', QuantModel::FORMAT_VERSION, 2, 32, 5};
+    f.insert(f.end(), 16, 0);
+    uint32_t len = p.size(), crc = Crc32::update(0, p.data(), p.size());
+    for (int i = 0; i < 4; i++) f.push_back((len >> (8 * i)) & 0xFF);
+    for (int i = 0; i < 4; i++) f.push_back((crc >> (8 * i)) & 0xFF);
+    f.insert(f.end(), p.begin(), p.end());
+    return f;
+}
+
+static QuantModel model;
+
+static TestResult quantized(const float* x) {
+    TestResult r;
+    r.valid = model.run(x, FI_VECTOR_SIZE, r.scores);
+    r.label = 0;
+    for (size_t c = 1; c < CLASSES; c++) {
+        if (r.scores[c] > r.scores[r.label]) r.label = (uint8_t)c;
+    }
+    r.confidence = r.scores[r.label];
+    return r;
+}
+
+void test_quant_model_row_in_matrix_matches_row_vector(void) {
+    auto blob = smallModel();
+    TEST_ASSERT_TRUE(model.bind(blob.data(), blob.size()));
+    auto scan = makeScan(SCAN, 5);
+    BatchArena<TestResult> arena = buffer.arena();
+    BatchClassifier::run<FI_VECTOR_SIZE>(scan.data(), SCAN, arena, toVector, quantized, moodUpdate);
+    for (size_t r = 0; r < SCAN; r++) {
+        float vec[FI_VECTOR_SIZE], a[CLASSES];
+        toFeatureVectorRaw(scan[r], vec);
+        TEST_ASSERT_TRUE(model.run(vec, FI_VECTOR_SIZE, a));
+        TEST_ASSERT_TRUE(buffer.results[r].valid);
+        TEST_ASSERT_EQUAL_MEMORY(a, buffer.results[r].scores, sizeof(a));
+    }
+}
+
+// ============================================================================
+// Sweep
+// ============================================================================
+
+void test_batch_matches_per_network_labels(void) {
+    auto scan = makeScan(SCAN, 6);
+    uint8_t each[SCAN], batch[SCAN];
+    classifyEach(scan.data(), SCAN, each);
+    BatchArena<TestResult> arena = buffer.arena();
+    sweep(scan.data(), SCAN, arena);
+    labelsOf(buffer.results, SCAN, batch);
+    TEST_ASSERT_EQUAL_MEMORY(each, batch, SCAN);
+}
+
+void test_batch_of_100_aps_makes_no_heap_allocation(void) {
+    auto scan = makeScan(SCAN, 7);
+    BatchArena<TestResult> arena = buffer.arena();
+
+    size_t before = allocations;
+    TEST_ASSERT_EQUAL_size_t(SCAN, sweep(scan.data(), SCAN, arena));
+    TEST_ASSERT_EQUAL_size_t(before, allocations);
+
+    // What extractBatchFeatures did for the same scan
+    before = allocations;
+    std::vector<float> legacy;
+    legacy.reserve(SCAN * FI_VECTOR_SIZE);
+    TEST_ASSERT_TRUE(allocations > before);
+}
+
+void test_batch_reacts_once_to_most_confident(void) {
+    auto scan = makeScan(SCAN, 8);
+    uint8_t labels[SCAN];
+    moodUpdates = 0;
+    classifyEach(scan.data(), SCAN, labels);
+    TEST_ASSERT_EQUAL_UINT32(SCAN, moodUpdates);
+
+    moodUpdates = 0;
+    BatchArena<TestResult> arena = buffer.arena();
+    sweep(scan.data(), SCAN, arena);
+    TEST_ASSERT_EQUAL_UINT32(1, moodUpdates);
+    float best = 0;
+    for (size_t r = 0; r < SCAN; r++) best = buffer.results[r].confidence > best ? buffer.results[r].confidence : best;
+    TEST_ASSERT_EQUAL_FLOAT(best, lastMood);
+}
+
+void test_no_reaction_without_valid_result(void) {
+    auto scan = makeScan(8, 10);
+    Buffer<8> b;
+    BatchArena<TestResult> arena = b.arena();
+    moodUpdates = 0;
+    size_t rows = BatchClassifier::run<FI_VECTOR_SIZE>(
+        scan.data(), 8, arena, toVector,
+        [](const float*) { TestResult r; memset(&r, 0, sizeof(r)); return r; }, moodUpdate);
+    TEST_ASSERT_EQUAL_size_t(8, rows);
+    TEST_ASSERT_EQUAL_UINT32(0, moodUpdates);
+}
+
+void test_benchmark_per_network_vs_batch(void) {
+    auto scan = makeScan(SCAN, 9);
+    uint8_t labels[SCAN], batch[SCAN];
+    const int rounds = 2000;
+    BatchArena<TestResult> arena = buffer.arena();
+
+    classifyEach(scan.data(), SCAN, labels);  // Warm-up
+    auto t0 = std::chrono::steady_clock::now();
+    for (int k = 0; k < rounds; k++) classifyEach(scan.data(), SCAN, labels);
+    auto t1 = std::chrono::steady_clock::now();
+    for (int k = 0; k < rounds; k++) sweep(scan.data(), SCAN, arena);
+    auto t2 = std::chrono::steady_clock::now();
+
+    double eachNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / (rounds * SCAN);
+    double batchNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / (rounds * SCAN);
+    printf("[BENCH] %zu-AP scan, heuristic: per-network %.1f ns/AP, batch %.1f ns/AP; arena %zu bytes\n",
+           SCAN, eachNs, batchNs, sizeof(Buffer<SCAN>));
+    labelsOf(buffer.results, SCAN, batch);
+    TEST_ASSERT_EQUAL_MEMORY(labels, batch, SCAN);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Feature matrix
+    RUN_TEST(test_matrix_holds_normalized_rows);
+    RUN_TEST(test_rows_capped_at_capacity);
+
+    // Classifying rows in place
+    RUN_TEST(test_heuristic_row_in_matrix_matches_row_vector);
+    RUN_TEST(test_heuristic_scores_sum_to_one);
+    RUN_TEST(test_heuristic_flags_soft_ap_honeypot);
+    RUN_TEST(test_heuristic_passes_plain_wpa3_router);
+    RUN_TEST(test_quant_model_row_in_matrix_matches_row_vector);
+
+    // Sweep
+    RUN_TEST(test_batch_matches_per_network_labels);
+    RUN_TEST(test_batch_of_100_aps_makes_no_heap_allocation);
+    RUN_TEST(test_batch_reacts_once_to_most_confident);
+    RUN_TEST(test_no_reaction_without_valid_result);
+    RUN_TEST(test_benchmark_per_network_vs_batch);
+
+    return UNITY_END();
+}
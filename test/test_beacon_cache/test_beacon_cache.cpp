@@ -0,0 +1,286 @@
+// Beacon Cache Tests
+// Tests the per-BSSID beacon store shared by OINK / DNH handshakes and PMKIDs:
+// one copy per AP, references that block eviction, reserve-then-fill, LRU
+// eviction with buffer reuse, and heap use against the per-handshake copies
+// it replaced
+
+#include <unity.h>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "../../src/core/beacon_cache.h"
+
+void setUp(void) {
+    // No setup needed
+}
+
+void tearDown(void) {
+    // No teardown needed
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static void makeBssid(uint8_t* out, uint8_t n) {
+    out[0] = 0x02; out[1] = 0x11; out[2] = 0x22;
+    out[3] = 0x33; out[4] = 0x44; out[5] = n;
+}
+
+// Beacon with addr3 = BSSID and len bytes total; body byte tags the copy
+static std::vector<uint8_t> makeBeacon(uint8_t n, uint16_t len, uint8_t tag = 0) {
+    std::vector<uint8_t> f(len, tag);
+    f[0] = 0x80;
+    f[1] = 0x00;
+    makeBssid(&f[10], n);
+    makeBssid(&f[16], n);
+    return f;
+}
+
+// ============================================================================
+// Store / lookup
+// ============================================================================
+
+void test_empty_cache_finds_nothing(void) {
+    BeaconCache<4> cache;
+    uint8_t bssid[6];
+    makeBssid(bssid, 1);
+    uint16_t len = 99;
+    TEST_ASSERT_NULL(cache.get(bssid, &len));
+    TEST_ASSERT_EQUAL_UINT16(0, len);
+    TEST_ASSERT_FALSE(cache.has(bssid));
+    TEST_ASSERT_FALSE(cache.wants(bssid));
+}
+
+void test_put_then_get_by_bssid(void) {
+    BeaconCache<4> cache;
+    auto b = makeBeacon(1, 120, 0xAB);
+    TEST_ASSERT_TRUE(cache.put(b.data(), b.size()));
+
+    uint16_t len = 0;
+    const uint8_t* got = cache.get(&b[16], &len);
+    TEST_ASSERT_NOT_NULL(got);
+    TEST_ASSERT_EQUAL_UINT16(120, len);
+    TEST_ASSERT_EQUAL_MEMORY(b.data(), got, b.size());
+}
+
+void test_second_beacon_same_ap_keeps_first_copy(void) {
+    BeaconCache<4> cache;
+    auto first = makeBeacon(1, 100, 0x11);
+    auto second = makeBeacon(1, 200, 0x22);
+    cache.put(first.data(), first.size());
+    TEST_ASSERT_TRUE(cache.put(second.data(), second.size()));
+
+    uint16_t len = 0;
+    const uint8_t* got = cache.get(&first[16], &len);
+    TEST_ASSERT_EQUAL_UINT16(100, len);
+    TEST_ASSERT_EQUAL_UINT8(0x11, got[50]);
+    TEST_ASSERT_EQUAL_UINT16(1, cache.stats().entries);
+}
+
+void test_rejects_short_and_oversized_frames(void) {
+    BeaconCache<4> cache;
+    auto tiny = makeBeacon(1, 24);
+    TEST_ASSERT_FALSE(cache.put(tiny.data(), 20));
+    auto huge = makeBeacon(2, BeaconCache<4>::MAX_BEACON_LEN + 1);
+    TEST_ASSERT_FALSE(cache.put(huge.data(), huge.size()));
+    TEST_ASSERT_EQUAL_UINT16(0, cache.stats().entries);
+    TEST_ASSERT_EQUAL_UINT16(1, cache.stats().rejected);
+}
+
+// ============================================================================
+// References
+// ============================================================================
+
+void test_retain_reserves_slot_and_wants_beacon(void) {
+    BeaconCache<4> cache;
+    uint8_t bssid[6];
+    makeBssid(bssid, 7);
+    TEST_ASSERT_TRUE(cache.retain(bssid));
+    TEST_ASSERT_TRUE(cache.wants(bssid));
+    TEST_ASSERT_FALSE(cache.has(bssid));
+
+    auto b = makeBeacon(7, 90);
+    cache.put(b.data(), b.size());
+    TEST_ASSERT_FALSE(cache.wants(bssid));
+    TEST_ASSERT_TRUE(cache.has(bssid));
+}
+
+void test_unreferenced_entry_is_not_wanted(void) {
+    BeaconCache<4> cache;
+    uint8_t bssid[6];
+    makeBssid(bssid, 7);
+    cache.retain(bssid);
+    cache.release(bssid);
+    TEST_ASSERT_FALSE(cache.wants(bssid));
+}
+
+void test_handshakes_share_one_copy(void) {
+    // Three stations completing handshakes with the same AP
+    BeaconCache<4> cache;
+    auto b = makeBeacon(3, 300);
+    cache.put(b.data(), b.size());
+    for (int i = 0; i < 3; i++) TEST_ASSERT_TRUE(cache.retain(&b[16]));
+
+    BeaconCacheStats s = cache.stats();
+    TEST_ASSERT_EQUAL_UINT16(1, s.entries);
+    TEST_ASSERT_EQUAL_UINT32(300, s.bytes);
+    TEST_ASSERT_EQUAL_UINT16(1, s.pinned);
+
+    for (int i = 0; i < 3; i++) cache.release(&b[16]);
+    TEST_ASSERT_EQUAL_UINT16(0, cache.stats().pinned);
+    TEST_ASSERT_TRUE(cache.has(&b[16]));  // Stays until LRU wants the slot
+}
+
+void test_release_of_unknown_bssid_is_harmless(void) {
+    BeaconCache<4> cache;
+    uint8_t bssid[6];
+    makeBssid(bssid, 9);
+    cache.release(bssid);
+    TEST_ASSERT_EQUAL_UINT16(0, cache.stats().entries);
+}
+
+// ============================================================================
+// Eviction
+// ============================================================================
+
+void test_lru_evicts_least_recently_used(void) {
+    BeaconCache<3> cache;
+    auto a = makeBeacon(1, 80), b = makeBeacon(2, 80), c = makeBeacon(3, 80), d = makeBeacon(4, 80);
+    cache.put(a.data(), a.size());
+    cache.put(b.data(), b.size());
+    cache.put(c.data(), c.size());
+    cache.get(&a[16], nullptr);  // a is now most recent, b is oldest
+
+    TEST_ASSERT_TRUE(cache.put(d.data(), d.size()));
+    TEST_ASSERT_TRUE(cache.has(&a[16]));
+    TEST_ASSERT_FALSE(cache.has(&b[16]));
+    TEST_ASSERT_TRUE(cache.has(&c[16]));
+    TEST_ASSERT_TRUE(cache.has(&d[16]));
+    TEST_ASSERT_EQUAL_UINT16(1, cache.stats().evictions);
+}
+
+void test_referenced_entries_survive_eviction(void) {
+    BeaconCache<2> cache;
+    auto a = makeBeacon(1, 80), b = makeBeacon(2, 80), c = makeBeacon(3, 80);
+    cache.put(a.data(), a.size());
+    cache.retain(&a[16]);  // Oldest, but a handshake holds it
+    cache.put(b.data(), b.size());
+
+    TEST_ASSERT_TRUE(cache.put(c.data(), c.size()));
+    TEST_ASSERT_TRUE(cache.has(&a[16]));
+    TEST_ASSERT_FALSE(cache.has(&b[16]));
+}
+
+void test_all_pinned_rejects_new_ap(void) {
+    BeaconCache<2> cache;
+    uint8_t x[6], y[6], z[6];
+    makeBssid(x, 1); makeBssid(y, 2); makeBssid(z, 3);
+    TEST_ASSERT_TRUE(cache.retain(x));
+    TEST_ASSERT_TRUE(cache.retain(y));
+    TEST_ASSERT_FALSE(cache.retain(z));
+
+    auto c = makeBeacon(3, 80);
+    TEST_ASSERT_FALSE(cache.put(c.data(), c.size()));
+    TEST_ASSERT_TRUE(cache.wants(x));
+    TEST_ASSERT_TRUE(cache.wants(y));
+}
+
+void test_evicted_buffer_is_reused(void) {
+    BeaconCache<1> cache;
+    auto big = makeBeacon(1, 400), small = makeBeacon(2, 200, 0x5A);
+    cache.put(big.data(), big.size());
+    const uint8_t* first = cache.get(&big[16], nullptr);
+
+    cache.put(small.data(), small.size());
+    uint16_t len = 0;
+    const uint8_t* second = cache.get(&small[16], &len);
+    TEST_ASSERT_TRUE(first == second);
+    TEST_ASSERT_EQUAL_UINT16(200, len);
+    TEST_ASSERT_EQUAL_UINT8(0x5A, second[100]);
+    TEST_ASSERT_EQUAL_UINT32(400, cache.stats().allocated);
+}
+
+// ============================================================================
+// Trim / clear
+// ============================================================================
+
+void test_trim_keeps_referenced_beacons(void) {
+    BeaconCache<4> cache;
+    auto a = makeBeacon(1, 100), b = makeBeacon(2, 100);
+    cache.put(a.data(), a.size());
+    cache.put(b.data(), b.size());
+    cache.retain(&b[16]);
+
+    cache.trim();
+    TEST_ASSERT_FALSE(cache.has(&a[16]));
+    TEST_ASSERT_TRUE(cache.has(&b[16]));
+    TEST_ASSERT_EQUAL_UINT32(100, cache.stats().allocated);
+}
+
+void test_clear_frees_everything(void) {
+    BeaconCache<4> cache;
+    auto a = makeBeacon(1, 100);
+    cache.put(a.data(), a.size());
+    cache.retain(&a[16]);
+    cache.clear();
+    BeaconCacheStats s = cache.stats();
+    TEST_ASSERT_EQUAL_UINT16(0, s.entries);
+    TEST_ASSERT_EQUAL_UINT32(0, s.allocated);
+    TEST_ASSERT_FALSE(cache.wants(&a[16]));
+}
+
+// ============================================================================
+// Memory comparison (informational)
+// ============================================================================
+
+void test_memory_vs_per_handshake_copies(void) {
+    // Busy venue: 12 APs, 4 stations each completing a handshake
+    const int aps = 12, stationsPerAp = 4;
+    const uint16_t beaconLen = 320;
+    BeaconCache<24> cache;
+    uint32_t legacyBytes = 0;
+    for (int a = 0; a < aps; a++) {
+        auto b = makeBeacon((uint8_t)a, beaconLen);
+        cache.put(b.data(), b.size());
+        for (int s = 0; s < stationsPerAp; s++) {
+            cache.retain(&b[16]);
+            legacyBytes += beaconLen;  // malloc'd copy per CapturedHandshake
+        }
+    }
+    BeaconCacheStats st = cache.stats();
+    TEST_ASSERT_EQUAL_UINT32(aps * beaconLen, st.allocated);
+    printf("[BENCH] %d handshakes over %d APs: per-handshake copies %u bytes, cache %u bytes\n",
+           aps * stationsPerAp, aps, legacyBytes, st.allocated);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Store / lookup
+    RUN_TEST(test_empty_cache_finds_nothing);
+    RUN_TEST(test_put_then_get_by_bssid);
+    RUN_TEST(test_second_beacon_same_ap_keeps_first_copy);
+    RUN_TEST(test_rejects_short_and_oversized_frames);
+
+    // References
+    RUN_TEST(test_retain_reserves_slot_and_wants_beacon);
+    RUN_TEST(test_unreferenced_entry_is_not_wanted);
+    RUN_TEST(test_handshakes_share_one_copy);
+    RUN_TEST(test_release_of_unknown_bssid_is_harmless);
+
+    // Eviction
+    RUN_TEST(test_lru_evicts_least_recently_used);
+    RUN_TEST(test_referenced_entries_survive_eviction);
+    RUN_TEST(test_all_pinned_rejects_new_ap);
+    RUN_TEST(test_evicted_buffer_is_reused);
+
+    // Trim / clear
+    RUN_TEST(test_trim_keeps_referenced_beacons);
+    RUN_TEST(test_clear_frees_everything);
+
+    // Memory comparison
+    RUN_TEST(test_memory_vs_per_handshake_copies);
+
+    return UNITY_END();
+}
@@ -0,0 +1,120 @@
+// Beacon trace fixture - generated by scripts/extract_beacon_trace.py
+// 48 beacons from 02:18:f1:a2:b3:c4, trace.pcap
+// No card capture is checked in yet: this trace was synthesized with a
+// hardware-AP profile (+/-2 us TSF error, 20 ppm receive clock skew, 60 us
+// arrival spread, a 4-beacon gap every 12 heard). Rerun the script on a real
+// capture to replace it.
+// Record: rx time (u32 us, LE) + the beacon's first 36 bytes
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+static const size_t BEACON_TRACE_RECORD = 40;
+static const size_t BEACON_TRACE_COUNT = 48;
+static const uint8_t BEACON_TRACE[] = {
+    0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x00, 0x00, 0x15, 0x2c, 0xf3, 0xa8, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x2a, 0x90, 0x01, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x10, 0x00, 0x19, 0xbc, 0xf4, 0xa8, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x19, 0x20, 0x03, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x20, 0x00, 0x19, 0x4c, 0xf6, 0xa8, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x2a, 0xb0, 0x04, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x30, 0x00, 0x15, 0xdc, 0xf7, 0xa8, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x2d, 0x40, 0x06, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x40, 0x00, 0x16, 0x6c, 0xf9, 0xa8, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x1d, 0xd0, 0x07, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x50, 0x00, 0x19, 0xfc, 0xfa, 0xa8, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x12, 0x60, 0x09, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x60, 0x00, 0x19, 0x8c, 0xfc, 0xa8, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x1d, 0xf0, 0x0a, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x70, 0x00, 0x19, 0x1c, 0xfe, 0xa8, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x2c, 0x80, 0x0c, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x80, 0x00, 0x18, 0xac, 0xff, 0xa8, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x1a, 0x10, 0x0e, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x90, 0x00, 0x19, 0x3c, 0x01, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x00, 0xa0, 0x0f, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0xa0, 0x00, 0x16, 0xcc, 0x02, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x07, 0x30, 0x11, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0xb0, 0x00, 0x19, 0x5c, 0x04, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x1e, 0x00, 0x19, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x00, 0x01, 0x15, 0x2c, 0x0c, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x2a, 0x90, 0x1a, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x10, 0x01, 0x15, 0xbc, 0x0d, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x44, 0x20, 0x1c, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x20, 0x01, 0x15, 0x4c, 0x0f, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x3d, 0xb0, 0x1d, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x30, 0x01, 0x18, 0xdc, 0x10, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x21, 0x40, 0x1f, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x40, 0x01, 0x17, 0x6c, 0x12, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x27, 0xd0, 0x20, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x50, 0x01, 0x18, 0xfc, 0x13, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x54, 0x60, 0x22, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x60, 0x01, 0x17, 0x8c, 0x15, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x4e, 0xf0, 0x23, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x70, 0x01, 0x17, 0x1c, 0x17, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x4c, 0x80, 0x25, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x80, 0x01, 0x18, 0xac, 0x18, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x47, 0x10, 0x27, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x90, 0x01, 0x19, 0x3c, 0x1a, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x4f, 0xa0, 0x28, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0xa0, 0x01, 0x15, 0xcc, 0x1b, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x28, 0x30, 0x2a, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0xb0, 0x01, 0x17, 0x5c, 0x1d, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x4f, 0x00, 0x32, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x00, 0x02, 0x19, 0x2c, 0x25, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x41, 0x90, 0x33, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x10, 0x02, 0x17, 0xbc, 0x26, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x3a, 0x20, 0x35, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x20, 0x02, 0x18, 0x4c, 0x28, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x46, 0xb0, 0x36, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x30, 0x02, 0x19, 0xdc, 0x29, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x6b, 0x40, 0x38, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x40, 0x02, 0x15, 0x6c, 0x2b, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x4e, 0xd0, 0x39, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x50, 0x02, 0x17, 0xfc, 0x2c, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x54, 0x60, 0x3b, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x60, 0x02, 0x18, 0x8c, 0x2e, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x54, 0xf0, 0x3c, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x70, 0x02, 0x15, 0x1c, 0x30, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x60, 0x80, 0x3e, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x80, 0x02, 0x19, 0xac, 0x31, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x76, 0x10, 0x40, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x90, 0x02, 0x18, 0x3c, 0x33, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x5d, 0xa0, 0x41, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0xa0, 0x02, 0x15, 0xcc, 0x34, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x77, 0x30, 0x43, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0xb0, 0x02, 0x19, 0x5c, 0x36, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x86, 0x00, 0x4b, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x00, 0x03, 0x19, 0x2c, 0x3e, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x69, 0x90, 0x4c, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x10, 0x03, 0x18, 0xbc, 0x3f, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x62, 0x20, 0x4e, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x20, 0x03, 0x19, 0x4c, 0x41, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x78, 0xb0, 0x4f, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x30, 0x03, 0x18, 0xdc, 0x42, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x76, 0x40, 0x51, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x40, 0x03, 0x18, 0x6c, 0x44, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x8b, 0xd0, 0x52, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x50, 0x03, 0x19, 0xfc, 0x45, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x7e, 0x60, 0x54, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x60, 0x03, 0x15, 0x8c, 0x47, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x8d, 0xf0, 0x55, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x70, 0x03, 0x16, 0x1c, 0x49, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x92, 0x80, 0x57, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x80, 0x03, 0x16, 0xac, 0x4a, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x8d, 0x10, 0x59, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0x90, 0x03, 0x15, 0x3c, 0x4c, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x9a, 0xa0, 0x5a, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0xa0, 0x03, 0x19, 0xcc, 0x4d, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+    0x91, 0x30, 0x5c, 0x00, 0x80, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4,
+    0x02, 0x18, 0xf1, 0xa2, 0xb3, 0xc4, 0xb0, 0x03, 0x15, 0x5c, 0x4f, 0xa9, 0x04, 0x00, 0x00, 0x00, 0x64, 0x00, 0x31, 0x04,
+};
+
+// What the tracker should report (ms)
+static const uint32_t BEACON_TRACE_SAMPLES = 47;
+static const uint32_t BEACON_TRACE_RESETS = 0;
+static const float BEACON_TRACE_RESIDUAL_MEAN = 0.000000f;
+static const float BEACON_TRACE_RESIDUAL_STDDEV = 0.002322f;
+static const float BEACON_TRACE_DRIFT_MEAN = 0.003085f;
+static const float BEACON_TRACE_DRIFT_STDDEV = 0.019938f;
@@ -0,0 +1,461 @@
+// Beacon Timing Tests
+// Tests the per-BSSID timing tracker behind WiFiFeatures::beaconJitter,
+// responseTime and probeResponseTime: Welford stats against a two-pass
+// reference, synthetic beacon traces (hardware AP, soft AP, channel hopping,
+// TSF reset), a beacon trace fixture through the frame parser, probe
+// response matching, LRU eviction in fixed memory, and per-beacon cost as
+// the table fills. scripts/extract_beacon_trace.py cuts the fixture from a
+// capture; whole captures go through the replay harness (pio run -e replay,
+// --mode warhog prints the tracker line).
+
+#include <unity.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "../../src/ml/beacon_timing.h"
+#include "beacon_trace.h"
+
+void setUp(void) {
+    // No setup needed
+}
+
+void tearDown(void) {
+    // No teardown needed
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static const uint16_t TU100 = 100;           // Default beacon interval
+static const uint32_t INTERVAL_US = 102400;  // 100 TU
+
+static void makeBssid(uint8_t* out, uint16_t n) {
+    out[0] = 0x02; out[1] = 0x11; out[2] = 0x22;
+    out[3] = 0x33; out[4] = (uint8_t)(n >> 8); out[5] = (uint8_t)n;
+}
+
+// Synthetic AP: beacon n is scheduled at tsf0 + n * interval, sent with
+// tsfNoiseUs of scheduling error, and heard airNoiseUs later than ideal
+struct TraceAP {
+    uint8_t bssid[6];
+    uint64_t tsf0;
+    uint32_t rx0;
+    float tsfNoiseUs;
+    float airNoiseUs;
+    std::mt19937 rng;
+
+    TraceAP(uint16_t n, float tsfNoise, float airNoise, uint32_t seed = 1)
+        : tsf0(0x123456789ULL * n), rx0(1000000), tsfNoiseUs(tsfNoise), airNoiseUs(airNoise), rng(seed) {
+        makeBssid(bssid, n);
+    }
+
+    template <size_t N>
+    void send(BeaconTimingTracker<N>& t, uint32_t n) {
+        std::normal_distribution<float> sched(0.0f, tsfNoiseUs > 0 ? tsfNoiseUs : 1e-6f);
+        std::uniform_real_distribution<float> air(0.0f, airNoiseUs > 0 ? airNoiseUs : 1e-6f);
+        int64_t offset = (int64_t)sched(rng);
+        uint64_t tsf = tsf0 + (uint64_t)n * INTERVAL_US + offset;
+        uint32_t rx = rx0 + n * INTERVAL_US + (uint32_t)(offset + (int64_t)air(rng));
+        t.onBeacon(bssid, tsf, TU100, rx);
+    }
+};
+
+// Probe response from bssid to station (addr1 = DA)
+static std::vector<uint8_t> makeProbeResponse(const uint8_t* bssid, const uint8_t* station) {
+    std::vector<uint8_t> f(MGMT_IE_OFFSET, 0);
+    f[0] = 0x50;
+    memcpy(&f[4], station, 6);
+    memcpy(&f[10], bssid, 6);
+    memcpy(&f[16], bssid, 6);
+    f[32] = TU100;
+    return f;
+}
+
+// ============================================================================
+// Welford running stats
+// ============================================================================
+
+void test_running_stats_matches_two_pass(void) {
+    std::mt19937 rng(42);
+    std::normal_distribution<float> d(37.0f, 4.5f);
+    std::vector<float> xs(5000);
+    RunningStats s;
+    s.reset();
+    for (float& x : xs) { x = d(rng); s.add(x); }
+
+    double mean = 0;
+    for (float x : xs) mean += x;
+    mean /= xs.size();
+    double ss = 0;
+    for (float x : xs) ss += (x - mean) * (x - mean);
+    double var = ss / (xs.size() - 1);
+
+    TEST_ASSERT_EQUAL_UINT32(5000, s.n);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, (float)mean, s.mean);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, (float)var, s.variance());
+}
+
+void test_running_stats_needs_two_samples_for_variance(void) {
+    RunningStats s;
+    s.reset();
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, s.variance());
+    s.add(12.5f);
+    TEST_ASSERT_EQUAL_FLOAT(12.5f, s.mean);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, s.variance());
+    s.add(12.5f);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, s.stddev());
+}
+
+void test_running_stats_stable_with_large_offset(void) {
+    // Naive sum-of-squares loses everything here in float; Welford doesn't
+    RunningStats s;
+    s.reset();
+    for (int i = 0; i < 1000; i++) s.add(100000.0f + ((i & 1) ? 1.0f : -1.0f));
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 1.0f, s.stddev());
+}
+
+// ============================================================================
+// Synthetic traces
+// ============================================================================
+
+void test_first_beacon_has_no_timing(void) {
+    BeaconTimingTracker<8> t;
+    TraceAP ap(1, 0, 0);
+    ap.send(t, 0);
+    const BeaconTiming* e = t.find(ap.bssid);
+    TEST_ASSERT_NOT_NULL(e);
+    TEST_ASSERT_EQUAL_UINT32(1, e->beacons);
+    TEST_ASSERT_EQUAL_UINT32(0, e->tsfResidual.n);
+    TEST_ASSERT_EQUAL_UINT16(TU100, e->intervalTU);
+}
+
+void test_hardware_ap_has_near_zero_jitter(void) {
+    BeaconTimingTracker<8> t;
+    TraceAP ap(1, 3.0f, 80.0f);
+    for (uint32_t n = 0; n < 200; n++) ap.send(t, n);
+    const BeaconTiming* e = t.find(ap.bssid);
+    TEST_ASSERT_EQUAL_UINT32(199, e->tsfResidual.n);
+    TEST_ASSERT_TRUE(e->jitterMs() < 0.05f);
+    TEST_ASSERT_TRUE(e->arrivalDrift.stddev() < 0.1f);  // ms
+}
+
+void test_soft_ap_jitter_crosses_inference_threshold(void) {
+    // MLInference scores beaconJitter > 10 ms as suspicious
+    BeaconTimingTracker<8> t;
+    TraceAP ap(2, 15000.0f, 200.0f, 7);
+    for (uint32_t n = 0; n < 300; n++) ap.send(t, n);
+    float j = t.find(ap.bssid)->jitterMs();
+    TEST_ASSERT_TRUE(j > 10.0f);
+    TEST_ASSERT_TRUE(j < 30.0f);  // sqrt(2) * 15 ms for a difference of two errors
+}
+
+void test_missed_beacons_do_not_add_jitter(void) {
+    // Channel hopping: heard 1 beacon in 3..7, never a steady cadence
+    BeaconTimingTracker<8> t;
+    TraceAP ap(3, 3.0f, 50.0f);
+    std::mt19937 rng(5);
+    uint32_t n = 0;
+    for (int i = 0; i < 100; i++) {
+        ap.send(t, n);
+        n += 3 + rng() % 5;
+    }
+    const BeaconTiming* e = t.find(ap.bssid);
+    TEST_ASSERT_EQUAL_UINT32(99, e->tsfResidual.n);
+    TEST_ASSERT_TRUE(e->jitterMs() < 0.05f);
+}
+
+void test_tsf_reset_restarts_baseline(void) {
+    BeaconTimingTracker<8> t;
+    TraceAP ap(4, 2.0f, 20.0f);
+    for (uint32_t n = 0; n < 50; n++) ap.send(t, n);
+    ap.tsf0 = 0;  // AP rebooted: TSF starts over, receive clock doesn't
+    ap.rx0 += 60 * INTERVAL_US;
+    for (uint32_t n = 0; n < 50; n++) ap.send(t, n);
+
+    const BeaconTiming* e = t.find(ap.bssid);
+    TEST_ASSERT_EQUAL_UINT32(1, t.stats().resets);
+    TEST_ASSERT_EQUAL_UINT32(98, e->tsfResidual.n);  // The jump isn't a sample
+    TEST_ASSERT_TRUE(e->jitterMs() < 0.05f);
+}
+
+void test_long_gap_restarts_baseline(void) {
+    BeaconTimingTracker<8> t;
+    uint8_t b[6];
+    makeBssid(b, 5);
+    t.onBeacon(b, 1000000, TU100, 5000);
+    t.onBeacon(b, 1000000 + 200 * INTERVAL_US, TU100, 5000 + 200 * INTERVAL_US);  // 20 s later
+    TEST_ASSERT_EQUAL_UINT32(0, t.find(b)->tsfResidual.n);
+    TEST_ASSERT_EQUAL_UINT32(1, t.stats().resets);
+}
+
+void test_same_slot_repeat_is_not_a_sample(void) {
+    BeaconTimingTracker<8> t;
+    uint8_t b[6];
+    makeBssid(b, 6);
+    t.onBeacon(b, 1000000, TU100, 0);
+    t.onBeacon(b, 1000300, TU100, 300);  // Same beacon slot, heard twice
+    TEST_ASSERT_EQUAL_UINT32(0, t.find(b)->tsfResidual.n);
+    TEST_ASSERT_EQUAL_UINT32(0, t.stats().resets);
+}
+
+void test_receive_clock_wrap(void) {
+    BeaconTimingTracker<8> t;
+    TraceAP ap(7, 2.0f, 20.0f);
+    ap.rx0 = 0xFFFFFFFFu - 10 * INTERVAL_US;
+    for (uint32_t n = 0; n < 30; n++) ap.send(t, n);
+    const BeaconTiming* e = t.find(ap.bssid);
+    TEST_ASSERT_EQUAL_UINT32(29, e->tsfResidual.n);
+    TEST_ASSERT_TRUE(e->arrivalDrift.stddev() < 0.1f);
+    TEST_ASSERT_EQUAL_UINT32(0, t.stats().resets);
+}
+
+void test_zero_interval_uses_raw_spacing(void) {
+    BeaconTimingTracker<8> t;
+    uint8_t b[6];
+    makeBssid(b, 8);
+    uint32_t gaps[] = {50000, 150000, 50000, 150000};
+    uint64_t tsf = 1000;
+    t.onBeacon(b, tsf, 0, 0);
+    for (uint32_t g : gaps) { tsf += g; t.onBeacon(b, tsf, 0, (uint32_t)tsf); }
+    const BeaconTiming* e = t.find(b);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 100.0f, e->tsfResidual.mean);
+    TEST_ASSERT_TRUE(e->jitterMs() > 50.0f);
+}
+
+void test_trace_fixture_matches_reference_stats(void) {
+    BeaconTimingTracker<8> t;
+    const uint8_t* bssid = nullptr;
+    for (size_t i = 0; i < BEACON_TRACE_COUNT; i++) {
+        const uint8_t* rec = BEACON_TRACE + i * BEACON_TRACE_RECORD;
+        uint32_t rx = rec[0] | (rec[1] << 8) | (rec[2] << 16) | ((uint32_t)rec[3] << 24);
+        MgmtFrameView beacon;
+        TEST_ASSERT_TRUE(beacon.parse(rec + 4, BEACON_TRACE_RECORD - 4));
+        t.onBeacon(beacon, rx);
+        bssid = beacon.bssid();
+    }
+    const BeaconTiming* e = t.find(bssid);
+    TEST_ASSERT_NOT_NULL(e);
+    TEST_ASSERT_EQUAL_UINT32(BEACON_TRACE_COUNT, e->beacons);
+    TEST_ASSERT_EQUAL_UINT32(BEACON_TRACE_SAMPLES, e->tsfResidual.n);
+    TEST_ASSERT_EQUAL_UINT32(BEACON_TRACE_RESETS, t.stats().resets);
+    TEST_ASSERT_FLOAT_WITHIN(0.0005f, BEACON_TRACE_RESIDUAL_MEAN, e->tsfResidual.mean);
+    TEST_ASSERT_FLOAT_WITHIN(0.0005f, BEACON_TRACE_RESIDUAL_STDDEV, e->jitterMs());
+    TEST_ASSERT_FLOAT_WITHIN(0.0005f, BEACON_TRACE_DRIFT_MEAN, e->arrivalDrift.mean);
+    TEST_ASSERT_FLOAT_WITHIN(0.0005f, BEACON_TRACE_DRIFT_STDDEV, e->arrivalDrift.stddev());
+}
+
+// ============================================================================
+// Probe responses
+// ============================================================================
+
+void test_probe_response_delay_measured(void) {
+    BeaconTimingTracker<8> t;
+    TraceAP ap(9, 0, 0);
+    ap.send(t, 0);
+    uint8_t sta[6] = {0x04, 0xAA, 0xBB, 0xCC, 0xDD, 0x01};
+    auto resp = makeProbeResponse(ap.bssid, sta);
+    MgmtFrameView v;
+    v.parse(resp.data(), resp.size());
+
+    t.onProbeRequest(sta, 2000000);
+    t.onProbeResponse(v, 2003000);
+    t.onProbeRequest(sta, 3000000);
+    t.onProbeResponse(v, 3005000);
+
+    const BeaconTiming* e = t.find(ap.bssid);
+    TEST_ASSERT_TRUE(e->respondsToProbe);
+    TEST_ASSERT_EQUAL_UINT32(2, e->probeDelay.n);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 4.0f, e->probeDelay.mean);
+}
+
+void test_probe_response_matches_only_its_station(void) {
+    BeaconTimingTracker<8> t;
+    TraceAP ap(10, 0, 0);
+    ap.send(t, 0);
+    uint8_t sta[6] = {0x04, 0xAA, 0xBB, 0xCC, 0xDD, 0x01};
+    uint8_t other[6] = {0x04, 0xAA, 0xBB, 0xCC, 0xDD, 0x02};
+    auto resp = makeProbeResponse(ap.bssid, sta);
+    MgmtFrameView v;
+    v.parse(resp.data(), resp.size());
+
+    t.onProbeRequest(other, 1000);
+    t.onProbeResponse(v, 3000);  // Unsolicited as far as we heard
+    const BeaconTiming* e = t.find(ap.bssid);
+    TEST_ASSERT_TRUE(e->respondsToProbe);
+    TEST_ASSERT_EQUAL_UINT32(0, e->probeDelay.n);
+
+    t.onProbeRequest(sta, 10000);
+    t.onProbeResponse(v, 10000 + BeaconTimingTracker<8>::PROBE_WINDOW_US + 1);  // Too late
+    TEST_ASSERT_EQUAL_UINT32(0, e->probeDelay.n);
+}
+
+void test_probe_response_from_unknown_ap_ignored(void) {
+    BeaconTimingTracker<8> t;
+    uint8_t bssid[6], sta[6] = {0x04, 0, 0, 0, 0, 1};
+    makeBssid(bssid, 11);
+    auto resp = makeProbeResponse(bssid, sta);
+    MgmtFrameView v;
+    v.parse(resp.data(), resp.size());
+    t.onProbeRequest(sta, 0);
+    t.onProbeResponse(v, 2000);
+    TEST_ASSERT_NULL(t.find(bssid));
+    TEST_ASSERT_EQUAL_size_t(0, t.size());
+}
+
+// ============================================================================
+// Bounded table
+// ============================================================================
+
+void test_lru_evicts_least_recently_heard(void) {
+    BeaconTimingTracker<4> t;
+    uint8_t b[6][6];
+    for (int i = 0; i < 6; i++) makeBssid(b[i], 100 + i);
+    for (int i = 0; i < 4; i++) t.onBeacon(b[i], 1000, TU100, 0);
+    t.onBeacon(b[0], 1000 + INTERVAL_US, TU100, INTERVAL_US);  // 0 heard again
+    t.onBeacon(b[4], 1000, TU100, 0);                          // Evicts 1
+    t.onBeacon(b[5], 1000, TU100, 0);                          // Evicts 2
+
+    TEST_ASSERT_EQUAL_size_t(4, t.size());
+    TEST_ASSERT_NOT_NULL(t.find(b[0]));
+    TEST_ASSERT_NULL(t.find(b[1]));
+    TEST_ASSERT_NULL(t.find(b[2]));
+    TEST_ASSERT_NOT_NULL(t.find(b[3]));
+    TEST_ASSERT_EQUAL_UINT32(2, t.stats().evictions);
+    TEST_ASSERT_EQUAL_UINT32(1, t.find(b[0])->tsfResidual.n);  // Kept its history
+}
+
+void test_evicted_ap_starts_fresh(void) {
+    BeaconTimingTracker<2> t;
+    uint8_t a[6], b[6], c[6];
+    makeBssid(a, 1); makeBssid(b, 2); makeBssid(c, 3);
+    t.onBeacon(a, 1000, TU100, 0);
+    t.onBeacon(a, 1000 + INTERVAL_US, TU100, INTERVAL_US);
+    t.onBeacon(b, 1000, TU100, 0);
+    t.onBeacon(c, 1000, TU100, 0);  // Evicts a
+    t.onBeacon(a, 1000 + 2 * INTERVAL_US, TU100, 2 * INTERVAL_US);
+    TEST_ASSERT_EQUAL_UINT32(1, t.find(a)->beacons);
+    TEST_ASSERT_EQUAL_UINT32(0, t.find(a)->tsfResidual.n);
+}
+
+void test_churn_keeps_index_consistent(void) {
+    // Many more APs than slots, revisited at random: every tracked AP stays
+    // findable after thousands of hash deletions
+    BeaconTimingTracker<16> t;
+    std::mt19937 rng(11);
+    std::vector<uint32_t> lastSeen(500, 0);
+    for (uint32_t step = 1; step <= 20000; step++) {
+        uint16_t n = rng() % 500;
+        uint8_t b[6];
+        makeBssid(b, n);
+        t.onBeacon(b, (uint64_t)step * INTERVAL_US, TU100, step * INTERVAL_US);
+        lastSeen[n] = step;
+    }
+    TEST_ASSERT_EQUAL_size_t(16, t.size());
+
+    // The 16 most recently heard are exactly the tracked ones
+    std::vector<uint32_t> sorted(lastSeen);
+    std::sort(sorted.rbegin(), sorted.rend());
+    uint32_t cutoff = sorted[15];
+    size_t found = 0;
+    for (uint16_t n = 0; n < 500; n++) {
+        uint8_t b[6];
+        makeBssid(b, n);
+        bool tracked = t.find(b) != nullptr;
+        TEST_ASSERT_EQUAL(lastSeen[n] >= cutoff && lastSeen[n] > 0, tracked);
+        found += tracked;
+    }
+    TEST_ASSERT_EQUAL_size_t(16, found);
+}
+
+void test_clear_forgets_everything(void) {
+    BeaconTimingTracker<4> t;
+    TraceAP ap(1, 0, 0);
+    ap.send(t, 0);
+    ap.send(t, 1);
+    t.clear();
+    TEST_ASSERT_EQUAL_size_t(0, t.size());
+    TEST_ASSERT_NULL(t.find(ap.bssid));
+    TEST_ASSERT_EQUAL_UINT32(0, t.stats().samples);
+    ap.send(t, 2);
+    TEST_ASSERT_EQUAL_UINT32(0, t.find(ap.bssid)->tsfResidual.n);
+}
+
+void test_memory_is_fixed(void) {
+    // No heap: the footprint is the object, whatever the traffic
+    TEST_ASSERT_EQUAL_size_t(sizeof(BeaconTimingTracker<128>), BeaconTimingTracker<128>::bytes());
+    TEST_ASSERT_TRUE(BeaconTimingTracker<128>::bytes() < 12 * 1024);
+    printf("[MEM] BeaconTimingTracker<128>: %zu bytes (%zu per AP entry)\n",
+           BeaconTimingTracker<128>::bytes(), sizeof(BeaconTiming));
+}
+
+// ============================================================================
+// Benchmark
+// ============================================================================
+
+static double nsPerBeacon(size_t aps) {
+    static BeaconTimingTracker<128> t;
+    t.clear();
+    const int rounds = 2000;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < aps; i++) {
+            uint8_t b[6];
+            makeBssid(b, (uint16_t)i);
+            t.onBeacon(b, 5000 + (uint64_t)r * INTERVAL_US + i, TU100, (uint32_t)(r * INTERVAL_US + i));
+        }
+    }
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    return (double)ns / (rounds * aps);
+}
+
+void test_per_beacon_cost_independent_of_table_size(void) {
+    nsPerBeacon(8);  // Warm-up
+    double small = nsPerBeacon(8);
+    double full = nsPerBeacon(128);
+    printf("[BENCH] onBeacon: %.1f ns with 8 APs, %.1f ns with 128 APs\n", small, full);
+    TEST_ASSERT_TRUE(full < small * 4.0 + 50.0);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Welford running stats
+    RUN_TEST(test_running_stats_matches_two_pass);
+    RUN_TEST(test_running_stats_needs_two_samples_for_variance);
+    RUN_TEST(test_running_stats_stable_with_large_offset);
+
+    // Synthetic traces
+    RUN_TEST(test_first_beacon_has_no_timing);
+    RUN_TEST(test_hardware_ap_has_near_zero_jitter);
+    RUN_TEST(test_soft_ap_jitter_crosses_inference_threshold);
+    RUN_TEST(test_missed_beacons_do_not_add_jitter);
+    RUN_TEST(test_tsf_reset_restarts_baseline);
+    RUN_TEST(test_long_gap_restarts_baseline);
+    RUN_TEST(test_same_slot_repeat_is_not_a_sample);
+    RUN_TEST(test_receive_clock_wrap);
+    RUN_TEST(test_zero_interval_uses_raw_spacing);
+    RUN_TEST(test_trace_fixture_matches_reference_stats);
+
+    // Probe responses
+    RUN_TEST(test_probe_response_delay_measured);
+    RUN_TEST(test_probe_response_matches_only_its_station);
+    RUN_TEST(test_probe_response_from_unknown_ap_ignored);
+
+    // Bounded table
+    RUN_TEST(test_lru_evicts_least_recently_heard);
+    RUN_TEST(test_evicted_ap_starts_fresh);
+    RUN_TEST(test_churn_keeps_index_consistent);
+    RUN_TEST(test_clear_forgets_everything);
+    RUN_TEST(test_memory_is_fixed);
+
+    // Benchmark
+    RUN_TEST(test_per_beacon_cost_independent_of_table_size);
+
+    return UNITY_END();
+}
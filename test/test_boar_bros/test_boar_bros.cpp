@@ -0,0 +1,396 @@
+// BOAR BROS Tests
+// Tests the exclusion list against the host-backed SD mock: loading the
+// existing /boar_bros.txt format (comments, optional SSIDs, colon BSSIDs,
+// junk), sorted bisection lookups at thousands of entries, append-only
+// adds, removals, bulk import with dedup and the entry cap, the binary
+// snapshot (reused, rebuilt when the text changes or it is damaged), and
+// lookups against the old std::map
+
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "../../src/core/boar_bros.h"
+#include "../mocks/mock_fs.h"
+
+static const char* TEST_ROOT = "/tmp/porkchop_test_boar_bros";
+static const char* TEXT = "/boar_bros.txt";
+static const char* SNAPSHOT = "/boar_bros.bin";
+static const char* IMPORT = "/boar_bros_import.txt";
+
+typedef BoarBrosList<fs::FS, File> Bros;
+
+void setUp(void) {
+    std::string cmd = std::string("rm -rf ") + TEST_ROOT + " && mkdir -p " + TEST_ROOT;
+    system(cmd.c_str());
+    SD.setRoot(TEST_ROOT);
+    SD.opens = 0;
+}
+
+void tearDown(void) {
+    // No teardown needed
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static uint64_t keyFor(int i) {
+    return (0xA4C138000000ull + (uint64_t)i * 2654435761ull) & 0xFFFFFFFFFFFFull;
+}
+
+static std::string hexKey(uint64_t key) {
+    char buf[13];
+    formatBssidKey(key, buf);
+    return buf;
+}
+
+static std::string listText(int from, int to, bool names) {
+    std::string s = "# out-of-scope networks\n";
+    for (int i = from; i < to; i++) {
+        s += hexKey(keyFor(i));
+        if (names) s += " Corp-" + std::to_string(i);
+        s += "\n";
+    }
+    return s;
+}
+
+static void writeHost(const char* path, const std::string& data) {
+    FILE* fp = fopen((std::string(TEST_ROOT) + path).c_str(), "wb");
+    fwrite(data.data(), 1, data.size(), fp);
+    fclose(fp);
+}
+
+static std::string readHost(const char* path) {
+    FILE* fp = fopen((std::string(TEST_ROOT) + path).c_str(), "rb");
+    if (!fp) return "<missing>";
+    std::string out;
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) out.append(buf, n);
+    fclose(fp);
+    return out;
+}
+
+static bool load(Bros& b) {
+    return b.load(SD, TEXT, SNAPSHOT);
+}
+
+static std::string nameOf(const Bros& b, uint64_t key) {
+    int i = b.indexOf(key);
+    return i < 0 ? "<absent>" : b.nameAt(i);
+}
+
+static bool sortedUnique(const Bros& b) {
+    for (size_t i = 1; i < b.size(); i++) {
+        if (b.keyAt(i - 1) >= b.keyAt(i)) return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// Text file
+// ============================================================================
+
+void test_loads_existing_file(void) {
+    writeHost(TEXT,
+              "# BOAR BROS - Networks to ignore\n"
+              "# Format: BSSID (12 hex chars) followed by optional SSID\n"
+              "AABBCCDDEEFF Home Sweet Home\n"
+              "001122334455\n"
+              "a4:c1:38:00:00:01  Corp Guest  \r\n"
+              "\n"
+              "nonsense here\n"
+              "FFEEDDCCBBAA NONAME BRO");  // No final newline
+
+    Bros b;
+    TEST_ASSERT_TRUE(load(b));
+    TEST_ASSERT_EQUAL_UINT32(4, b.size());
+    TEST_ASSERT_TRUE(sortedUnique(b));
+    TEST_ASSERT_TRUE(b.keyAt(0) == 0x001122334455ull);
+
+    const uint8_t home[6] = {0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF};
+    TEST_ASSERT_TRUE(b.contains(home));
+    TEST_ASSERT_EQUAL_STRING("Home Sweet Home", nameOf(b, 0xAABBCCDDEEFFull).c_str());
+    TEST_ASSERT_EQUAL_STRING("", nameOf(b, 0x001122334455ull).c_str());
+    TEST_ASSERT_EQUAL_STRING("Corp Guest", nameOf(b, 0xA4C138000001ull).c_str());
+    TEST_ASSERT_EQUAL_STRING("NONAME BRO", nameOf(b, 0xFFEEDDCCBBAAull).c_str());
+    TEST_ASSERT_FALSE(b.contains(0xAABBCCDDEEFEull));
+
+    TEST_ASSERT_EQUAL_UINT32(4, b.stats().parsedLines);
+    TEST_ASSERT_EQUAL_UINT32(1, b.stats().skippedLines);
+}
+
+void test_missing_file_is_empty(void) {
+    Bros b;
+    TEST_ASSERT_TRUE(load(b));
+    TEST_ASSERT_EQUAL_UINT32(0, b.size());
+    TEST_ASSERT_FALSE(b.contains(0xAABBCCDDEEFFull));
+    TEST_ASSERT_EQUAL_INT(-1, b.indexOf(0));
+}
+
+void test_thousands_of_bros(void) {
+    const int N = 2000;
+    writeHost(TEXT, listText(0, N, true));
+    Bros b;
+    TEST_ASSERT_TRUE(load(b));
+    TEST_ASSERT_EQUAL_UINT32(N, b.size());
+    TEST_ASSERT_TRUE(sortedUnique(b));
+
+    std::set<uint64_t> ref;
+    for (int i = 0; i < N; i++) ref.insert(keyFor(i));
+    for (int i = 0; i < N; i++) {
+        TEST_ASSERT_TRUE(b.contains(keyFor(i)));
+        TEST_ASSERT_EQUAL_STRING(("Corp-" + std::to_string(i)).c_str(), nameOf(b, keyFor(i)).c_str());
+    }
+    for (int i = N; i < N + 5000; i++) {
+        TEST_ASSERT_EQUAL(ref.count(keyFor(i)) > 0, b.contains(keyFor(i)));
+    }
+    // 12 bytes of key and offset per bro plus ~10-byte names, with vector slack
+    TEST_ASSERT_TRUE(b.bytes() < N * 32);
+}
+
+// ============================================================================
+// Changes
+// ============================================================================
+
+void test_add_appends_one_line(void) {
+    writeHost(TEXT, "AABBCCDDEEFF Home");  // Hand-edited: no final newline
+    Bros b;
+    TEST_ASSERT_TRUE(load(b));
+
+    TEST_ASSERT_TRUE(b.add(0x001122334455ull, "Neighbour"));
+    TEST_ASSERT_FALSE(b.add(0x001122334455ull, "Again"));
+    TEST_ASSERT_TRUE(b.add(0x665544332211ull, nullptr));
+    TEST_ASSERT_TRUE(b.add(0x0000000000AAull, "this ssid is far longer than thirty-two bytes"));
+    TEST_ASSERT_EQUAL_STRING("AABBCCDDEEFF Home\n"
+                             "001122334455 Neighbour\n"
+                             "665544332211\n"
+                             "0000000000AA this ssid is far longer than thi\n",
+                             readHost(TEXT).c_str());
+    TEST_ASSERT_EQUAL_UINT32(4, b.size());
+    TEST_ASSERT_TRUE(sortedUnique(b));
+
+    // Snapshot kept up with the appends
+    Bros next;
+    TEST_ASSERT_TRUE(load(next));
+    TEST_ASSERT_EQUAL_UINT32(1, next.stats().snapshotLoads);
+    TEST_ASSERT_EQUAL_STRING("Neighbour", nameOf(next, 0x001122334455ull).c_str());
+    TEST_ASSERT_EQUAL_STRING("", nameOf(next, 0x665544332211ull).c_str());
+}
+
+void test_remove_rewrites_file(void) {
+    writeHost(TEXT, listText(0, 100, true));
+    Bros b;
+    TEST_ASSERT_TRUE(load(b));
+    size_t before = b.bytes();
+    for (int i = 0; i < 100; i += 2) TEST_ASSERT_TRUE(b.remove(keyFor(i)));
+    TEST_ASSERT_FALSE(b.remove(keyFor(0)));
+    TEST_ASSERT_EQUAL_UINT32(50, b.size());
+    TEST_ASSERT_TRUE(b.bytes() <= before);
+
+    std::string text = readHost(TEXT);
+    TEST_ASSERT_TRUE(text.find("# BOAR BROS") == 0);
+    TEST_ASSERT_TRUE(text.find(hexKey(keyFor(0))) == std::string::npos);
+    TEST_ASSERT_TRUE(text.find(hexKey(keyFor(1)) + " Corp-1\n") != std::string::npos);
+
+    // Reparse of the rewritten text agrees with the snapshot
+    remove((std::string(TEST_ROOT) + SNAPSHOT).c_str());
+    Bros parsed;
+    TEST_ASSERT_TRUE(load(parsed));
+    TEST_ASSERT_EQUAL_UINT32(0, parsed.stats().snapshotLoads);
+    TEST_ASSERT_EQUAL_UINT32(50, parsed.size());
+    for (int i = 0; i < 100; i++) {
+        TEST_ASSERT_EQUAL(i % 2 == 1, parsed.contains(keyFor(i)));
+    }
+    TEST_ASSERT_EQUAL_STRING("Corp-99", nameOf(parsed, keyFor(99)).c_str());
+}
+
+void test_bulk_import_merges(void) {
+    writeHost(TEXT, listText(0, 10, true));
+    Bros b;
+    TEST_ASSERT_TRUE(load(b));
+
+    // Overlaps the list, repeats itself, colon and plain BSSIDs, CSV-ish
+    std::string imp = "# scope exclusions\n";
+    for (int i = 5; i < 1500; i++) {
+        std::string hex = hexKey(keyFor(i));
+        if (i % 3 == 0) {
+            std::string colon;
+            for (int c = 0; c < 12; c += 2) colon += (c ? ":" : "") + hex.substr(c, 2);
+            imp += colon + ",Imported-" + std::to_string(i) + "\n";
+        } else {
+            imp += hex + " Imported-" + std::to_string(i) + "\n";
+        }
+    }
+    imp += hexKey(keyFor(700)) + " Repeat\n";
+    writeHost(IMPORT, imp);
+
+    TEST_ASSERT_EQUAL_UINT32(1490, b.import(IMPORT));
+    TEST_ASSERT_EQUAL_UINT32(1500, b.size());
+    TEST_ASSERT_TRUE(sortedUnique(b));
+    TEST_ASSERT_EQUAL_STRING("Corp-5", nameOf(b, keyFor(5)).c_str());        // Listed name kept
+    TEST_ASSERT_EQUAL_STRING("Imported-700", nameOf(b, keyFor(700)).c_str()); // First wins
+    TEST_ASSERT_EQUAL_STRING("Imported-999", nameOf(b, keyFor(999)).c_str());
+    TEST_ASSERT_EQUAL_UINT32(0, b.import("/missing.txt"));
+
+    // Persisted: text and snapshot
+    Bros next;
+    TEST_ASSERT_TRUE(load(next));
+    TEST_ASSERT_EQUAL_UINT32(1, next.stats().snapshotLoads);
+    TEST_ASSERT_EQUAL_UINT32(1500, next.size());
+    remove((std::string(TEST_ROOT) + SNAPSHOT).c_str());
+    Bros parsed;
+    TEST_ASSERT_TRUE(load(parsed));
+    TEST_ASSERT_EQUAL_UINT32(1500, parsed.size());
+    TEST_ASSERT_EQUAL_STRING("Imported-999", nameOf(parsed, keyFor(999)).c_str());
+}
+
+void test_entry_cap(void) {
+    writeHost(TEXT, listText(0, 100, true));
+    Bros b;
+    TEST_ASSERT_TRUE(load(b));
+    writeHost(IMPORT, listText(100, Bros::MAX_ENTRIES + 500, false));
+    TEST_ASSERT_EQUAL_UINT32(Bros::MAX_ENTRIES - 100, b.import(IMPORT));
+    TEST_ASSERT_EQUAL_UINT32(Bros::MAX_ENTRIES, b.size());
+    TEST_ASSERT_TRUE(b.full());
+    for (int i = 0; i < 100; i++) TEST_ASSERT_TRUE(b.contains(keyFor(i)));  // Listed ones kept
+    TEST_ASSERT_FALSE(b.add(0x000000000001ull, "late"));
+    TEST_ASSERT_TRUE(b.remove(keyFor(3)));
+    TEST_ASSERT_TRUE(b.add(0x000000000001ull, "late"));
+}
+
+// ============================================================================
+// Snapshot
+// ============================================================================
+
+void test_snapshot_reused_and_rebuilt(void) {
+    writeHost(TEXT, listText(0, 300, true));
+    {
+        Bros b;
+        TEST_ASSERT_TRUE(load(b));
+        TEST_ASSERT_EQUAL_UINT32(1, b.stats().snapshotWrites);
+    }
+    Bros again;
+    TEST_ASSERT_TRUE(load(again));
+    TEST_ASSERT_EQUAL_UINT32(1, again.stats().snapshotLoads);
+    TEST_ASSERT_EQUAL_UINT32(0, again.stats().parsedLines);
+    TEST_ASSERT_EQUAL_UINT32(300, again.size());
+    TEST_ASSERT_EQUAL_STRING("Corp-123", nameOf(again, keyFor(123)).c_str());
+
+    // Edited on a PC: size changes, snapshot ignored
+    writeHost(TEXT, listText(0, 301, true));
+    Bros edited;
+    TEST_ASSERT_TRUE(load(edited));
+    TEST_ASSERT_EQUAL_UINT32(0, edited.stats().snapshotLoads);
+    TEST_ASSERT_EQUAL_UINT32(301, edited.size());
+}
+
+void test_damaged_snapshot_is_reparsed(void) {
+    writeHost(TEXT, listText(0, 50, true));
+    {
+        Bros b;
+        TEST_ASSERT_TRUE(load(b));
+    }
+    std::string snap = readHost(SNAPSHOT);
+    TEST_ASSERT_TRUE(snap.compare(0, 4, "BBRO") == 0);
+    TEST_ASSERT_TRUE(snap.size() > 32 + 50 * 12);
+
+    writeHost(SNAPSHOT, snap.substr(0, snap.size() - 1));  // Truncated
+    Bros a;
+    TEST_ASSERT_TRUE(load(a));
+    TEST_ASSERT_EQUAL_UINT32(0, a.stats().snapshotLoads);
+    TEST_ASSERT_EQUAL_UINT32(50, a.size());
+
+    std::string swapped = snap;  // Keys out of order
+    for (int i = 0; i < 8; i++) std::swap(swapped[32 + i], swapped[32 + 8 + i]);
+    writeHost(SNAPSHOT, swapped);
+    Bros b;
+    TEST_ASSERT_TRUE(load(b));
+    TEST_ASSERT_EQUAL_UINT32(0, b.stats().snapshotLoads);
+    TEST_ASSERT_TRUE(sortedUnique(b));
+
+    std::string unterminated = snap;  // Arena's last name loses its NUL
+    unterminated[unterminated.size() - 1] = 'X';
+    writeHost(SNAPSHOT, unterminated);
+    Bros c;
+    TEST_ASSERT_TRUE(load(c));
+    TEST_ASSERT_EQUAL_UINT32(0, c.stats().snapshotLoads);
+    TEST_ASSERT_EQUAL_UINT32(50, c.size());
+}
+
+// ============================================================================
+// Micro-benchmark (informational; asserts only that results agree)
+// ============================================================================
+
+void test_benchmark_is_excluded(void) {
+    const int N = 2000;
+    writeHost(TEXT, listText(0, N, true));
+    Bros b;
+    TEST_ASSERT_TRUE(load(b));
+
+    std::map<uint64_t, std::string> old;  // The old boarBros (uncapped here)
+    for (int i = 0; i < N; i++) old[keyFor(i)] = "Corp-" + std::to_string(i);
+
+    // An OINK target pass: 200 visible networks, a tenth of them bros
+    std::vector<uint64_t> visible;
+    for (int i = 0; i < 200; i++) visible.push_back(keyFor(i % 10 == 0 ? i * 7 : N + i));
+
+    const int rounds = 5000;
+    size_t oldHits = 0, listHits = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (uint64_t k : visible) oldHits += old.count(k);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (uint64_t k : visible) listHits += b.contains(k);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    TEST_ASSERT_TRUE(oldHits == listHits);
+
+    // Old heap: ~48-byte tree node + String object + its heap block
+    size_t oldBytes = 0;
+    for (const auto& kv : old) oldBytes += 48 + 16 + kv.second.size() + 1 + 16;
+
+    Bros snap;
+    auto t3 = std::chrono::steady_clock::now();
+    TEST_ASSERT_TRUE(load(snap));
+    auto t4 = std::chrono::steady_clock::now();
+    TEST_ASSERT_EQUAL_UINT32(1, snap.stats().snapshotLoads);
+
+    double checks = (double)rounds * visible.size();
+    printf("[BENCH] %d bros: std::map %.1f ns/check, sorted array %.1f ns/check; "
+           "heap ~%u vs %u bytes; snapshot load %.2f ms\n",
+           N, std::chrono::duration<double, std::nano>(t1 - t0).count() / checks,
+           std::chrono::duration<double, std::nano>(t2 - t1).count() / checks,
+           (unsigned)oldBytes, (unsigned)b.bytes(),
+           std::chrono::duration<double, std::milli>(t4 - t3).count());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Text file
+    RUN_TEST(test_loads_existing_file);
+    RUN_TEST(test_missing_file_is_empty);
+    RUN_TEST(test_thousands_of_bros);
+
+    // Changes
+    RUN_TEST(test_add_appends_one_line);
+    RUN_TEST(test_remove_rewrites_file);
+    RUN_TEST(test_bulk_import_merges);
+    RUN_TEST(test_entry_cap);
+
+    // Snapshot
+    RUN_TEST(test_snapshot_reused_and_rebuilt);
+    RUN_TEST(test_damaged_snapshot_is_reparsed);
+
+    // Micro-benchmark
+    RUN_TEST(test_benchmark_is_excluded);
+
+    return UNITY_END();
+}
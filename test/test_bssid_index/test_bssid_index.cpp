@@ -0,0 +1,307 @@
+// BSSID Index Tests
+// Tests the open-addressing BSSID -> vector position index used by OINK, DNH
+// and Spectrum, plus a micro-benchmark against the linear memcmp scan it replaced
+
+#include <unity.h>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "../../src/core/bssid_index.h"
+
+void setUp(void) {
+    // No setup needed
+}
+
+void tearDown(void) {
+    // No teardown needed
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// Roughly DetectedNetwork-sized so the linear scan pays realistic stride costs
+struct TestNetwork {
+    uint8_t bssid[6];
+    char ssid[33];
+    uint32_t lastSeen;
+    uint8_t padding[900];
+};
+
+static void makeBssid(uint8_t* out, uint32_t n) {
+    // Shared OUI, sequential NIC part - the clustering case the hash must spread
+    out[0] = 0xAC; out[1] = 0x84; out[2] = 0xC6;
+    out[3] = (uint8_t)(n >> 16); out[4] = (uint8_t)(n >> 8); out[5] = (uint8_t)n;
+}
+
+static TestNetwork makeNetwork(uint32_t n, uint32_t lastSeen = 0) {
+    TestNetwork net;
+    memset(&net, 0, sizeof(net));
+    makeBssid(net.bssid, n);
+    snprintf(net.ssid, sizeof(net.ssid), "NET%u", (unsigned)n);
+    net.lastSeen = lastSeen;
+    return net;
+}
+
+static int linearFind(const std::vector<TestNetwork>& v, const uint8_t* bssid) {
+    for (int i = 0; i < (int)v.size(); i++) {
+        if (memcmp(v[i].bssid, bssid, 6) == 0) return i;
+    }
+    return -1;
+}
+
+// ============================================================================
+// Key helper
+// ============================================================================
+
+void test_bssidToKey_big_endian(void) {
+    uint8_t bssid[6] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66};
+    TEST_ASSERT_EQUAL_UINT64(0x112233445566ULL, bssidToKey(bssid));
+}
+
+// ============================================================================
+// Basic find/add
+// ============================================================================
+
+void test_index_empty_finds_nothing(void) {
+    std::vector<TestNetwork> nets;
+    BssidIndex<64, TestNetwork> idx(nets);
+    uint8_t bssid[6];
+    makeBssid(bssid, 1);
+    TEST_ASSERT_EQUAL_INT(-1, idx.find(bssid));
+    TEST_ASSERT_EQUAL_UINT32(0, idx.size());
+}
+
+void test_index_add_then_find(void) {
+    std::vector<TestNetwork> nets;
+    BssidIndex<64, TestNetwork> idx(nets);
+    for (uint32_t i = 0; i < 40; i++) {
+        nets.push_back(makeNetwork(i));
+        idx.add(nets.size() - 1);
+    }
+    for (uint32_t i = 0; i < 40; i++) {
+        uint8_t bssid[6];
+        makeBssid(bssid, i);
+        TEST_ASSERT_EQUAL_INT((int)i, idx.find(bssid));
+    }
+    uint8_t missing[6];
+    makeBssid(missing, 999);
+    TEST_ASSERT_EQUAL_INT(-1, idx.find(missing));
+}
+
+void test_index_duplicate_add_keeps_first(void) {
+    std::vector<TestNetwork> nets;
+    BssidIndex<64, TestNetwork> idx(nets);
+    nets.push_back(makeNetwork(7));
+    idx.add(0);
+    nets.push_back(makeNetwork(7));  // Same BSSID (e.g. second handshake station)
+    idx.add(1);
+    TEST_ASSERT_EQUAL_INT(0, idx.find(nets[1].bssid));
+    TEST_ASSERT_EQUAL_UINT32(1, idx.size());
+}
+
+void test_index_add_out_of_range_ignored(void) {
+    std::vector<TestNetwork> nets;
+    BssidIndex<64, TestNetwork> idx(nets);
+    idx.add(0);
+    TEST_ASSERT_EQUAL_UINT32(0, idx.size());
+}
+
+// ============================================================================
+// Stale cleanup / rebuild
+// ============================================================================
+
+void test_index_rebuild_after_erase(void) {
+    std::vector<TestNetwork> nets;
+    BssidIndex<256, TestNetwork> idx(nets);
+    for (uint32_t i = 0; i < 150; i++) {
+        nets.push_back(makeNetwork(i, i % 3 == 0 ? 0 : 100000));
+        idx.add(nets.size() - 1);
+    }
+
+    // Same erase loop shape as OinkMode::update() stale cleanup
+    for (auto it = nets.begin(); it != nets.end();) {
+        if (it->lastSeen == 0) it = nets.erase(it);
+        else ++it;
+    }
+    idx.rebuild();
+
+    TEST_ASSERT_EQUAL_UINT32(100, idx.size());
+    for (uint32_t i = 0; i < 150; i++) {
+        uint8_t bssid[6];
+        makeBssid(bssid, i);
+        TEST_ASSERT_EQUAL_INT(linearFind(nets, bssid), idx.find(bssid));
+    }
+}
+
+void test_index_stale_never_returns_wrong_network(void) {
+    std::vector<TestNetwork> nets;
+    BssidIndex<64, TestNetwork> idx(nets);
+    for (uint32_t i = 0; i < 20; i++) {
+        nets.push_back(makeNetwork(i));
+        idx.add(nets.size() - 1);
+    }
+    nets.erase(nets.begin());  // Forgot rebuild(): every position shifted
+
+    for (uint32_t i = 0; i < 20; i++) {
+        uint8_t bssid[6];
+        makeBssid(bssid, i);
+        int found = idx.find(bssid);
+        if (found >= 0) {
+            TEST_ASSERT_EQUAL_MEMORY(bssid, nets[found].bssid, 6);
+        }
+    }
+}
+
+void test_index_clear_then_reuse(void) {
+    std::vector<TestNetwork> nets;
+    BssidIndex<64, TestNetwork> idx(nets);
+    nets.push_back(makeNetwork(1));
+    idx.add(0);
+    nets.clear();
+    idx.clear();
+    TEST_ASSERT_EQUAL_INT(-1, idx.find(makeNetwork(1).bssid));
+
+    nets.push_back(makeNetwork(2));
+    idx.add(0);
+    TEST_ASSERT_EQUAL_INT(0, idx.find(nets[0].bssid));
+}
+
+void test_index_rebuild_after_sort(void) {
+    std::vector<TestNetwork> nets;
+    BssidIndex<64, TestNetwork> idx(nets);
+    for (uint32_t i = 0; i < 30; i++) {
+        nets.push_back(makeNetwork(i, 30 - i));
+        idx.add(nets.size() - 1);
+    }
+    std::vector<TestNetwork> sorted(nets.rbegin(), nets.rend());
+    nets.swap(sorted);
+    idx.rebuild();
+    for (uint32_t i = 0; i < 30; i++) {
+        uint8_t bssid[6];
+        makeBssid(bssid, i);
+        TEST_ASSERT_EQUAL_INT(29 - (int)i, idx.find(bssid));
+    }
+}
+
+// ============================================================================
+// Capacity
+// ============================================================================
+
+void test_index_overflow_falls_back_to_scan(void) {
+    std::vector<TestNetwork> nets;
+    BssidIndex<16, TestNetwork> idx(nets);
+    TEST_ASSERT_EQUAL_UINT32(12, idx.capacity());
+    for (uint32_t i = 0; i < 20; i++) {
+        nets.push_back(makeNetwork(i));
+        idx.add(nets.size() - 1);
+    }
+    TEST_ASSERT_TRUE(idx.isOverflowed());
+    for (uint32_t i = 0; i < 20; i++) {
+        TEST_ASSERT_EQUAL_INT((int)i, idx.find(nets[i].bssid));
+    }
+
+    // Shrinking below capacity restores hashed lookups
+    nets.resize(10);
+    idx.rebuild();
+    TEST_ASSERT_FALSE(idx.isOverflowed());
+    TEST_ASSERT_EQUAL_INT(9, idx.find(nets[9].bssid));
+}
+
+void test_index_churn_matches_linear_scan(void) {
+    std::vector<TestNetwork> nets;
+    BssidIndex<512, TestNetwork> idx(nets);
+    uint32_t next = 0;
+    for (uint32_t round = 0; round < 50; round++) {
+        // Add a batch, age out a pseudo-random subset, rebuild
+        for (int k = 0; k < 30 && nets.size() < idx.capacity(); k++) {
+            nets.push_back(makeNetwork(next, next * 2654435761u));
+            idx.add(nets.size() - 1);
+            next++;
+        }
+        uint32_t cut = round * 40503u;
+        for (auto it = nets.begin(); it != nets.end();) {
+            if ((it->lastSeen ^ cut) % 5 == 0) it = nets.erase(it);
+            else ++it;
+        }
+        idx.rebuild();
+
+        for (uint32_t i = 0; i < next; i += 7) {
+            uint8_t bssid[6];
+            makeBssid(bssid, i);
+            TEST_ASSERT_EQUAL_INT(linearFind(nets, bssid), idx.find(bssid));
+        }
+    }
+}
+
+// ============================================================================
+// Micro-benchmark (informational; asserts only that results agree)
+// ============================================================================
+
+void test_benchmark_index_vs_linear_scan(void) {
+    const size_t sizes[] = {20, 100, 200, 380};
+    for (size_t n : sizes) {
+        std::vector<TestNetwork> nets;
+        BssidIndex<512, TestNetwork> idx(nets);
+        for (uint32_t i = 0; i < n; i++) {
+            nets.push_back(makeNetwork(i));
+            idx.add(nets.size() - 1);
+        }
+
+        // Beacon mix: mostly known APs, some new ones
+        std::vector<std::array<uint8_t, 6>> queries(4096);
+        for (size_t q = 0; q < queries.size(); q++) {
+            makeBssid(queries[q].data(), (uint32_t)((q * 7919) % (n + n / 4)));
+        }
+
+        const int rounds = 50;
+        long linearSum = 0, indexSum = 0;
+        auto t0 = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; r++) {
+            for (auto& q : queries) linearSum += linearFind(nets, q.data());
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; r++) {
+            for (auto& q : queries) indexSum += idx.find(q.data());
+        }
+        auto t2 = std::chrono::steady_clock::now();
+
+        TEST_ASSERT_TRUE(linearSum == indexSum);
+
+        double lookups = (double)rounds * queries.size();
+        double linearNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / lookups;
+        double indexNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / lookups;
+        printf("[BENCH] %3zu APs: linear %8.1f ns/lookup, index %6.1f ns/lookup (%.1fx)\n",
+               n, linearNs, indexNs, indexNs > 0 ? linearNs / indexNs : 0.0);
+    }
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Key helper
+    RUN_TEST(test_bssidToKey_big_endian);
+
+    // Basic find/add
+    RUN_TEST(test_index_empty_finds_nothing);
+    RUN_TEST(test_index_add_then_find);
+    RUN_TEST(test_index_duplicate_add_keeps_first);
+    RUN_TEST(test_index_add_out_of_range_ignored);
+
+    // Stale cleanup / rebuild
+    RUN_TEST(test_index_rebuild_after_erase);
+    RUN_TEST(test_index_stale_never_returns_wrong_network);
+    RUN_TEST(test_index_clear_then_reuse);
+    RUN_TEST(test_index_rebuild_after_sort);
+
+    // Capacity
+    RUN_TEST(test_index_overflow_falls_back_to_scan);
+    RUN_TEST(test_index_churn_matches_linear_scan);
+
+    // Benchmark
+    RUN_TEST(test_benchmark_index_vs_linear_scan);
+
+    return UNITY_END();
+}
@@ -0,0 +1,318 @@
+// Buffered Writer Tests
+// Tests the WARHOG session file writer against the host-backed SD mock:
+// lines held until a flush, bulk writes when the buffer fills, pass-through
+// of oversized lines, in-memory size for rotation, size/age flush policy,
+// close, no SD handle held between drains, and card I/O against the
+// open/append/close-per-line pattern
+
+#include <unity.h>
+#include <cstdio>
+#include <string>
+#include "../mocks/mock_fs.h"
+#include "../../src/core/buffered_writer.h"
+
+static const char* TEST_ROOT = "/tmp/porkchop_test_buffered_writer";
+
+typedef BufferedWriter<fs::FS, File, 256> SmallWriter;
+
+void setUp(void) {
+    std::string cmd = std::string("rm -rf ") + TEST_ROOT + " && mkdir -p " + TEST_ROOT;
+    system(cmd.c_str());
+    SD.setRoot(TEST_ROOT);
+    SD.opens = 0;
+    setMillis(0);
+}
+
+void tearDown(void) {
+    // No teardown needed
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static std::string readAll(const char* path) {
+    std::string host = std::string(TEST_ROOT) + path;
+    FILE* fp = fopen(host.c_str(), "rb");
+    if (!fp) return "";
+    std::string out;
+    char buf[512];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) out.append(buf, n);
+    fclose(fp);
+    return out;
+}
+
+static uint32_t fakeMicros = 0;
+static uint32_t fakeClock() {
+    fakeMicros += 250;
+    return fakeMicros;
+}
+
+// ============================================================================
+// Buffering
+// ============================================================================
+
+void test_lines_wait_for_flush(void) {
+    SmallWriter w;
+    TEST_ASSERT_TRUE(w.begin(SD, "/a.csv"));
+    w.println("BSSID,SSID");
+    w.printf("%02X:%02X,%s\n", 0xAA, 0xBB, "\"pig\"");
+    TEST_ASSERT_EQUAL_STRING("", readAll("/a.csv").c_str());
+    TEST_ASSERT_EQUAL_UINT32(0, w.stats().writes);
+
+    TEST_ASSERT_TRUE(w.flush());
+    TEST_ASSERT_EQUAL_STRING("BSSID,SSID\r\nAA:BB,\"pig\"\n", readAll("/a.csv").c_str());
+    TEST_ASSERT_EQUAL_UINT32(1, w.stats().writes);
+}
+
+void test_full_buffer_writes_in_order(void) {
+    SmallWriter w;
+    w.begin(SD, "/b.csv");
+    std::string expect;
+    for (int i = 0; i < 40; i++) {
+        char line[32];
+        snprintf(line, sizeof(line), "line %02d padding padding\n", i);
+        w.print(line);
+        expect += line;
+    }
+    BufferedWriterStats s = w.stats();
+    TEST_ASSERT_TRUE(s.writes >= 3);
+    TEST_ASSERT_TRUE(s.writes <= 5);
+    w.close();
+    TEST_ASSERT_EQUAL_STRING(expect.c_str(), readAll("/b.csv").c_str());
+}
+
+void test_oversized_write_goes_straight_through(void) {
+    SmallWriter w;
+    w.begin(SD, "/c.csv");
+    w.print("head,");
+    std::string big(700, 'x');
+    w.print(big.c_str());
+    w.print(",tail");
+    TEST_ASSERT_EQUAL_UINT32(5 + 700 + 5, w.size());
+    TEST_ASSERT_EQUAL_UINT32(5, w.buffered());
+    w.close();
+    TEST_ASSERT_EQUAL_STRING(("head," + big + ",tail").c_str(), readAll("/c.csv").c_str());
+}
+
+void test_long_printf_line_is_not_truncated(void) {
+    SmallWriter w;
+    w.begin(SD, "/d.csv");
+    std::string ssid(300, 's');
+    w.printf("%s,%d\n", ssid.c_str(), -70);
+    w.close();
+    TEST_ASSERT_EQUAL_STRING((ssid + ",-70\n").c_str(), readAll("/d.csv").c_str());
+}
+
+// ============================================================================
+// Size tracking
+// ============================================================================
+
+void test_size_tracks_file_without_reopening(void) {
+    SmallWriter w;
+    w.begin(SD, "/e.csv");
+    for (int i = 0; i < 100; i++) w.print("0123456789");
+    TEST_ASSERT_EQUAL_UINT32(1000, w.size());
+    w.flush();
+    TEST_ASSERT_EQUAL_UINT32(1000, w.size());
+    // Only the drains opened the file, never a size check
+    TEST_ASSERT_EQUAL_UINT32(1 + w.stats().opens, SD.opens);
+}
+
+void test_append_seeds_size_from_file(void) {
+    {
+        SmallWriter first;
+        first.begin(SD, "/f.csv");
+        for (int i = 0; i < 400; i++) first.print("0123456789");
+    }
+    SmallWriter w;
+    TEST_ASSERT_TRUE(w.begin(SD, "/f.csv", false));
+    w.print("abc");
+    TEST_ASSERT_EQUAL_UINT32(4003, w.size());
+    w.close();
+    TEST_ASSERT_EQUAL_UINT32(4003, readAll("/f.csv").size());
+}
+
+// ============================================================================
+// Flush policy
+// ============================================================================
+
+void test_flush_if_due_by_bytes(void) {
+    BufferedWriter<fs::FS, File, 1024> w;
+    w.begin(SD, "/g.csv");
+    for (int i = 0; i < 20; i++) w.print("0123456789");
+    TEST_ASSERT_FALSE(w.flushIfDue(100, 512, 10000));
+    for (int i = 0; i < 40; i++) w.print("0123456789");
+    TEST_ASSERT_TRUE(w.flushIfDue(200, 512, 10000));
+    TEST_ASSERT_EQUAL_UINT32(0, w.buffered());
+    TEST_ASSERT_EQUAL_UINT32(600, readAll("/g.csv").size());
+}
+
+void test_flush_if_due_by_age(void) {
+    BufferedWriter<fs::FS, File, 1024> w;
+    w.begin(SD, "/h.csv");
+    w.print("one line\n");
+    TEST_ASSERT_FALSE(w.flushIfDue(1000, 512, 10000));   // First sighting starts the clock
+    TEST_ASSERT_FALSE(w.flushIfDue(10999, 512, 10000));
+    TEST_ASSERT_TRUE(w.flushIfDue(11000, 512, 10000));
+
+    // Clock restarts with the next line, not the last flush
+    w.print("two\n");
+    TEST_ASSERT_FALSE(w.flushIfDue(50000, 512, 10000));
+    TEST_ASSERT_TRUE(w.flushIfDue(60000, 512, 10000));
+}
+
+void test_flush_if_due_empty_is_noop(void) {
+    SmallWriter w;
+    w.begin(SD, "/i.csv");
+    TEST_ASSERT_FALSE(w.flushIfDue(99999, 1, 1));
+    TEST_ASSERT_EQUAL_UINT32(0, w.stats().writes);
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+void test_close_flushes_and_frees(void) {
+    SmallWriter w;
+    w.begin(SD, "/j.csv");
+    w.print("last words\n");
+    TEST_ASSERT_TRUE(w.close());
+    TEST_ASSERT_FALSE(w.isOpen());
+    TEST_ASSERT_EQUAL_STRING("last words\n", readAll("/j.csv").c_str());
+    TEST_ASSERT_EQUAL_UINT32(0, w.print("ignored"));
+}
+
+void test_begin_rejects_invalid_file(void) {
+    SmallWriter w;
+    SD.setRoot("");  // No card
+    TEST_ASSERT_FALSE(w.begin(SD, "/k.csv"));
+    TEST_ASSERT_FALSE(w.isOpen());
+
+    SD.setRoot(TEST_ROOT);
+    std::string longPath = "/" + std::string(SmallWriter::MAX_PATH, 'p');
+    TEST_ASSERT_FALSE(w.begin(SD, longPath.c_str()));
+}
+
+void test_no_handle_between_drains(void) {
+    int idle = SD.openHandles();
+    SmallWriter a, b, c;
+    a.begin(SD, "/m1.csv");
+    b.begin(SD, "/m2.csv");
+    c.begin(SD, "/m3.csv");
+    TEST_ASSERT_EQUAL_INT(idle, SD.openHandles());
+    for (int i = 0; i < 60; i++) {
+        a.print("aaaaaaaaaa\n");
+        b.print("bbbbbbbbbb\n");
+        c.print("cccccccccc\n");
+        TEST_ASSERT_EQUAL_INT(idle, SD.openHandles());
+    }
+    TEST_ASSERT_TRUE(a.stats().flushes > 0);
+    a.close();
+    b.close();
+    c.close();
+    TEST_ASSERT_EQUAL_INT(idle, SD.openHandles());
+    TEST_ASSERT_EQUAL_UINT32(660, readAll("/m2.csv").size());
+}
+
+void test_card_pulled_drops_span_and_counts(void) {
+    SmallWriter w;
+    w.begin(SD, "/n.csv");
+    w.print("lost\n");
+    SD.setRoot("");  // Card pulled
+    TEST_ASSERT_FALSE(w.flush());
+    TEST_ASSERT_EQUAL_UINT32(1, w.stats().errors);
+    TEST_ASSERT_EQUAL_UINT32(0, w.buffered());
+    SD.setRoot(TEST_ROOT);
+    w.print("kept\n");
+    TEST_ASSERT_TRUE(w.flush());
+    TEST_ASSERT_EQUAL_STRING("kept\n", readAll("/n.csv").c_str());
+}
+
+void test_busy_time_uses_clock(void) {
+    fakeMicros = 0;
+    SmallWriter w(fakeClock);
+    w.begin(SD, "/l.csv");
+    w.print("x\n");
+    w.flush();  // One open + write + close, timed as a whole
+    TEST_ASSERT_EQUAL_UINT32(250, w.stats().busyUs);
+}
+
+// ============================================================================
+// I/O comparison (informational)
+// ============================================================================
+
+void test_io_vs_open_append_close(void) {
+    // Dense street: 150 new networks in one scan, CSV + WiGLE + ML each
+    const int networks = 150;
+    const char* names[3] = {"/old_csv", "/old_wigle", "/old_ml"};
+    const size_t lineLen[3] = {80, 140, 260};
+
+    size_t oldOpens = 0, oldWrites = 0;
+    for (int n = 0; n < networks; n++) {
+        for (int f = 0; f < 3; f++) {
+            File file = SD.open(names[f], FILE_APPEND);
+            oldOpens++;
+            std::string line(lineLen[f] - 1, 'a' + f);
+            file.println(line.c_str());
+            oldWrites += file.mockWriteCalls();
+            file.close();
+        }
+    }
+
+    size_t newWrites = 0, newOpens = 0;
+    BufferedWriter<fs::FS, File, 2048> csv, wigle, ml;
+    BufferedWriter<fs::FS, File, 2048>* logs[3] = {&csv, &wigle, &ml};
+    csv.begin(SD, "/new_csv");
+    wigle.begin(SD, "/new_wigle");
+    ml.begin(SD, "/new_ml");
+    for (int n = 0; n < networks; n++) {
+        for (int f = 0; f < 3; f++) {
+            std::string line(lineLen[f] - 1, 'a' + f);
+            logs[f]->print(line.c_str());
+            logs[f]->print('\n');
+        }
+    }
+    for (int f = 0; f < 3; f++) {
+        logs[f]->close();
+        newWrites += logs[f]->stats().writes;
+        newOpens += logs[f]->stats().opens;
+    }
+    TEST_ASSERT_EQUAL(readAll("/old_ml").size(), readAll("/new_ml").size());
+    printf("[BENCH] %d networks x 3 files: open/append/close %zu opens, %zu writes; buffered %zu opens, %zu writes\n",
+           networks, oldOpens, oldWrites, newOpens, newWrites);
+    TEST_ASSERT_TRUE(newWrites * 10 < oldOpens);
+    TEST_ASSERT_TRUE(newOpens * 10 < oldOpens);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Buffering
+    RUN_TEST(test_lines_wait_for_flush);
+    RUN_TEST(test_full_buffer_writes_in_order);
+    RUN_TEST(test_oversized_write_goes_straight_through);
+    RUN_TEST(test_long_printf_line_is_not_truncated);
+
+    // Size tracking
+    RUN_TEST(test_size_tracks_file_without_reopening);
+    RUN_TEST(test_append_seeds_size_from_file);
+
+    // Flush policy
+    RUN_TEST(test_flush_if_due_by_bytes);
+    RUN_TEST(test_flush_if_due_by_age);
+    RUN_TEST(test_flush_if_due_empty_is_noop);
+
+    // Lifecycle
+    RUN_TEST(test_close_flushes_and_frees);
+    RUN_TEST(test_begin_rejects_invalid_file);
+    RUN_TEST(test_no_handle_between_drains);
+    RUN_TEST(test_card_pulled_drops_span_and_counts);
+    RUN_TEST(test_busy_time_uses_clock);
+
+    // I/O comparison
+    RUN_TEST(test_io_vs_open_append_close);
+
+    return UNITY_END();
+}
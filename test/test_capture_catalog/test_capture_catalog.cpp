@@ -0,0 +1,391 @@
+// Capture Catalog Tests
+// Tests the on-card capture catalog against the host-backed SD mock:
+// filename parsing, put/find/get, reload with superseded records and
+// tombstones, torn tails, version checks, compaction, rebuild from a
+// /handshakes scan with companion SSIDs, and the card I/O of a captures
+// menu refresh against walking the directory
+
+#include <unity.h>
+#include <cstdio>
+#include <string>
+#include "../../src/core/catalog_index.h"  // Before mock_arduino.h's min/max macros
+#include "../mocks/mock_fs.h"
+
+static const char* TEST_ROOT = "/tmp/porkchop_test_capture_catalog";
+static const char* CAT = "/capture_catalog.bin";
+
+typedef CatalogIndex<fs::FS, File> Catalog;
+
+void setUp(void) {
+    std::string cmd = std::string("rm -rf ") + TEST_ROOT + " && mkdir -p " + TEST_ROOT + "/handshakes";
+    system(cmd.c_str());
+    SD.setRoot(TEST_ROOT);
+    SD.opens = 0;
+}
+
+void tearDown(void) {
+    // No teardown needed
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static void writeHost(const char* path, const std::string& data) {
+    FILE* fp = fopen((std::string(TEST_ROOT) + path).c_str(), "wb");
+    fwrite(data.data(), 1, data.size(), fp);
+    fclose(fp);
+}
+
+static size_t hostSize(const char* path) {
+    FILE* fp = fopen((std::string(TEST_ROOT) + path).c_str(), "rb");
+    if (!fp) return 0;
+    fseek(fp, 0, SEEK_END);
+    size_t n = ftell(fp);
+    fclose(fp);
+    return n;
+}
+
+static void makeBssid(uint8_t out[6], uint32_t n) {
+    out[0] = 0x02; out[1] = 0x11;
+    out[2] = n >> 24; out[3] = n >> 16; out[4] = n >> 8; out[5] = n;
+}
+
+static CatalogRecord makeRecord(uint32_t n, CaptureKind kind, const char* ssid) {
+    CatalogRecord r;
+    memset(&r, 0, sizeof(r));
+    makeBssid(r.bssid, n);
+    r.station[0] = 0xAA; r.station[5] = (uint8_t)n;
+    r.kind = (uint8_t)kind;
+    strncpy(r.ssid, ssid, 32);
+    r.timestamp = 1000 + n;
+    r.fileSize = 100 + n;
+    return r;
+}
+
+static void freshCatalog(Catalog& c) {
+    TEST_ASSERT_TRUE(c.rebuild(SD, CAT, "/handshakes"));
+}
+
+// ============================================================================
+// Filename parsing
+// ============================================================================
+
+void test_parse_capture_names(void) {
+    uint8_t b[6];
+    CaptureKind k;
+    TEST_ASSERT_TRUE(Catalog::parseName("64EEB7208286.pcap", b, k));
+    TEST_ASSERT_EQUAL(CaptureKind::PCAP, k);
+    TEST_ASSERT_EQUAL_HEX8(0x64, b[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x86, b[5]);
+    TEST_ASSERT_TRUE(Catalog::parseName("64eeb7208286_hs.22000", b, k));
+    TEST_ASSERT_EQUAL(CaptureKind::HANDSHAKE, k);
+    TEST_ASSERT_TRUE(Catalog::parseName("/handshakes/64EEB7208286.22000", b, k));
+    TEST_ASSERT_EQUAL(CaptureKind::PMKID, k);
+}
+
+void test_parse_rejects_other_files(void) {
+    uint8_t b[6];
+    CaptureKind k;
+    TEST_ASSERT_FALSE(Catalog::parseName("64EEB7208286.txt", b, k));
+    TEST_ASSERT_FALSE(Catalog::parseName("64EEB7208286_pmkid.txt", b, k));
+    TEST_ASSERT_FALSE(Catalog::parseName("capture.pcap", b, k));
+    TEST_ASSERT_FALSE(Catalog::parseName("64EEB72082.pcap", b, k));
+    TEST_ASSERT_FALSE(Catalog::parseName(nullptr, b, k));
+}
+
+// ============================================================================
+// Put / find / get
+// ============================================================================
+
+void test_put_and_find(void) {
+    Catalog c;
+    freshCatalog(c);
+    TEST_ASSERT_TRUE(c.put(makeRecord(7, CaptureKind::PMKID, "PigNet")));
+    TEST_ASSERT_TRUE(c.put(makeRecord(3, CaptureKind::PCAP, "Other")));
+    TEST_ASSERT_EQUAL(2, c.size());
+
+    uint8_t b[6];
+    makeBssid(b, 7);
+    TEST_ASSERT_TRUE(c.has(b, CaptureKind::PMKID));
+    TEST_ASSERT_FALSE(c.has(b, CaptureKind::PCAP));
+
+    CatalogRecord r;
+    TEST_ASSERT_TRUE(c.get(b, CaptureKind::PMKID, r));
+    TEST_ASSERT_EQUAL_STRING("PigNet", r.ssid);
+    TEST_ASSERT_EQUAL_UINT32(107, r.fileSize);
+
+    // Index stays sorted by BSSID
+    TEST_ASSERT_EQUAL_HEX8(3, c.entry(0).bssid[5]);
+    TEST_ASSERT_EQUAL_HEX8(7, c.entry(1).bssid[5]);
+}
+
+void test_put_replaces_same_key(void) {
+    Catalog c;
+    freshCatalog(c);
+    c.put(makeRecord(1, CaptureKind::HANDSHAKE, "old"));
+    c.put(makeRecord(1, CaptureKind::HANDSHAKE, "new"));
+    TEST_ASSERT_EQUAL(1, c.size());
+    TEST_ASSERT_EQUAL_UINT32(1, c.stats().dead);
+
+    uint8_t b[6];
+    makeBssid(b, 1);
+    CatalogRecord r;
+    c.get(b, CaptureKind::HANDSHAKE, r);
+    TEST_ASSERT_EQUAL_STRING("new", r.ssid);
+}
+
+void test_put_requires_loaded_catalog(void) {
+    Catalog c;
+    TEST_ASSERT_FALSE(c.put(makeRecord(1, CaptureKind::PCAP, "x")));
+}
+
+// ============================================================================
+// Persistence
+// ============================================================================
+
+void test_reload_applies_supersede_and_tombstones(void) {
+    {
+        Catalog c;
+        freshCatalog(c);
+        for (uint32_t i = 0; i < 10; i++) c.put(makeRecord(i, CaptureKind::PCAP, "net"));
+        c.put(makeRecord(4, CaptureKind::PCAP, "renamed"));
+        uint8_t b[6];
+        makeBssid(b, 6);
+        TEST_ASSERT_TRUE(c.remove(b, CaptureKind::PCAP));
+    }
+    Catalog c;
+    TEST_ASSERT_TRUE(c.load(SD, CAT));
+    TEST_ASSERT_EQUAL(9, c.size());
+    TEST_ASSERT_EQUAL_UINT32(3, c.stats().dead);  // Old #4, old #6, tombstone
+
+    uint8_t b[6];
+    makeBssid(b, 6);
+    TEST_ASSERT_FALSE(c.has(b, CaptureKind::PCAP));
+    makeBssid(b, 4);
+    CatalogRecord r;
+    TEST_ASSERT_TRUE(c.get(b, CaptureKind::PCAP, r));
+    TEST_ASSERT_EQUAL_STRING("renamed", r.ssid);
+}
+
+void test_torn_tail_is_ignored_and_overwritten(void) {
+    {
+        Catalog c;
+        freshCatalog(c);
+        c.put(makeRecord(1, CaptureKind::PMKID, "a"));
+        c.put(makeRecord(2, CaptureKind::PMKID, "b"));
+    }
+    // Power cut halfway through a third append
+    FILE* fp = fopen((std::string(TEST_ROOT) + CAT).c_str(), "ab");
+    fwrite("PARTIAL", 1, 7, fp);
+    fclose(fp);
+
+    Catalog c;
+    TEST_ASSERT_TRUE(c.load(SD, CAT));
+    TEST_ASSERT_EQUAL(2, c.size());
+    TEST_ASSERT_EQUAL_UINT32(1, c.stats().skipped);
+    c.put(makeRecord(3, CaptureKind::PMKID, "c"));
+    TEST_ASSERT_EQUAL_UINT32(16 + 3 * 64, hostSize(CAT));
+
+    Catalog again;
+    TEST_ASSERT_TRUE(again.load(SD, CAT));
+    TEST_ASSERT_EQUAL(3, again.size());
+}
+
+void test_load_rejects_missing_or_foreign_file(void) {
+    Catalog c;
+    TEST_ASSERT_FALSE(c.load(SD, CAT));
+    writeHost(CAT, std::string(16, 'x'));
+    TEST_ASSERT_FALSE(c.load(SD, CAT));
+    TEST_ASSERT_FALSE(c.loaded());
+}
+
+void test_clear_empties_catalog(void) {
+    Catalog c;
+    freshCatalog(c);
+    for (uint32_t i = 0; i < 5; i++) c.put(makeRecord(i, CaptureKind::PCAP, "x"));
+    TEST_ASSERT_TRUE(c.clear());
+    TEST_ASSERT_EQUAL(0, c.size());
+    TEST_ASSERT_EQUAL_UINT32(16, hostSize(CAT));
+    Catalog again;
+    TEST_ASSERT_TRUE(again.load(SD, CAT));
+    TEST_ASSERT_EQUAL(0, again.size());
+}
+
+// ============================================================================
+// Compaction and iteration
+// ============================================================================
+
+void test_compaction_drops_dead_records(void) {
+    Catalog c;
+    freshCatalog(c);
+    for (uint32_t i = 0; i < 20; i++) c.put(makeRecord(i, CaptureKind::HANDSHAKE, "v1"));
+    for (int round = 0; round < 4; round++) {
+        for (uint32_t i = 0; i < 20; i++) c.put(makeRecord(i, CaptureKind::HANDSHAKE, "v2"));
+    }
+    TEST_ASSERT_TRUE(c.stats().compactions >= 1);
+    TEST_ASSERT_TRUE(hostSize(CAT) < 16 + 100 * 64);
+
+    Catalog again;
+    TEST_ASSERT_TRUE(again.load(SD, CAT));
+    TEST_ASSERT_EQUAL(20, again.size());
+    uint8_t b[6];
+    makeBssid(b, 19);
+    CatalogRecord r;
+    TEST_ASSERT_TRUE(again.get(b, CaptureKind::HANDSHAKE, r));
+    TEST_ASSERT_EQUAL_STRING("v2", r.ssid);
+}
+
+static int visited = 0;
+static int visitedRenamed = 0;
+
+void test_for_each_visits_live_records_once(void) {
+    Catalog c;
+    freshCatalog(c);
+    for (uint32_t i = 0; i < 8; i++) c.put(makeRecord(i, CaptureKind::PCAP, "x"));
+    c.put(makeRecord(2, CaptureKind::PCAP, "renamed"));
+    uint8_t b[6];
+    makeBssid(b, 5);
+    c.remove(b, CaptureKind::PCAP);
+
+    visited = visitedRenamed = 0;
+    TEST_ASSERT_TRUE(c.forEachLive([](const CatalogRecord& r) {
+        visited++;
+        if (strcmp(r.ssid, "renamed") == 0) visitedRenamed++;
+    }));
+    TEST_ASSERT_EQUAL(7, visited);
+    TEST_ASSERT_EQUAL(1, visitedRenamed);
+}
+
+// ============================================================================
+// Rebuild
+// ============================================================================
+
+void test_rebuild_from_directory(void) {
+    writeHost("/handshakes/64EEB7208286.pcap", std::string(300, 'p'));
+    writeHost("/handshakes/64EEB7208286_hs.22000",
+              "WPA*02*00112233445566778899aabbccddeeff*64eeb7208286*a0b1c2d3e4f5*50696773*00\n");
+    writeHost("/handshakes/64EEB7208286.txt", "PigsNet\n");
+    writeHost("/handshakes/0A0B0C0D0E0F.22000",
+              "WPA*01*00112233445566778899aabbccddeeff*0a0b0c0d0e0f*111213141516*41*** 01\n");
+    writeHost("/handshakes/0A0B0C0D0E0F_pmkid.txt", "Coffee\r\n");
+    writeHost("/handshakes/notes.txt", "ignore me");
+
+    Catalog c;
+    TEST_ASSERT_TRUE(c.rebuild(SD, CAT, "/handshakes"));
+    TEST_ASSERT_EQUAL(3, c.size());
+    TEST_ASSERT_EQUAL_UINT32(3, c.stats().rebuildFiles);
+
+    uint8_t ap[6] = {0x64, 0xEE, 0xB7, 0x20, 0x82, 0x86};
+    CatalogRecord r;
+    TEST_ASSERT_TRUE(c.get(ap, CaptureKind::HANDSHAKE, r));
+    TEST_ASSERT_EQUAL_STRING("PigsNet", r.ssid);
+    TEST_ASSERT_EQUAL_HEX8(0xA0, r.station[0]);
+    TEST_ASSERT_EQUAL_HEX8(0xF5, r.station[5]);
+    TEST_ASSERT_TRUE(c.get(ap, CaptureKind::PCAP, r));
+    TEST_ASSERT_EQUAL_UINT32(300, r.fileSize);
+    TEST_ASSERT_EQUAL_STRING("PigsNet", r.ssid);
+
+    uint8_t ap2[6] = {0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F};
+    TEST_ASSERT_TRUE(c.get(ap2, CaptureKind::PMKID, r));
+    TEST_ASSERT_EQUAL_STRING("Coffee", r.ssid);
+    TEST_ASSERT_EQUAL_HEX8(0x16, r.station[5]);
+
+    // And it persisted
+    Catalog again;
+    TEST_ASSERT_TRUE(again.load(SD, CAT));
+    TEST_ASSERT_EQUAL(3, again.size());
+}
+
+void test_rebuild_without_directory_is_empty(void) {
+    system((std::string("rm -rf ") + TEST_ROOT + "/handshakes").c_str());
+    Catalog c;
+    TEST_ASSERT_TRUE(c.rebuild(SD, CAT, "/handshakes"));
+    TEST_ASSERT_EQUAL(0, c.size());
+    TEST_ASSERT_TRUE(c.put(makeRecord(1, CaptureKind::PCAP, "first")));
+}
+
+// ============================================================================
+// I/O comparison (informational)
+// ============================================================================
+
+void test_menu_refresh_io_vs_directory_walk(void) {
+    const uint32_t captures = 1500;
+    Catalog c;
+    freshCatalog(c);
+    for (uint32_t i = 0; i < captures; i++) {
+        char name[64];
+        uint8_t b[6];
+        makeBssid(b, i);
+        snprintf(name, sizeof(name), "/handshakes/%02X%02X%02X%02X%02X%02X.22000",
+                 b[0], b[1], b[2], b[3], b[4], b[5]);
+        writeHost(name, "WPA*01*x\n");
+        snprintf(name, sizeof(name), "/handshakes/%02X%02X%02X%02X%02X%02X_pmkid.txt",
+                 b[0], b[1], b[2], b[3], b[4], b[5]);
+        writeHost(name, "net\n");
+        c.put(makeRecord(i, CaptureKind::PMKID, "net"));
+    }
+
+    // Old refresh: walk the directory, open the companion .txt per capture
+    SD.opens = 0;
+    File dir = SD.open("/handshakes");
+    int oldFound = 0;
+    for (File f = dir.openNextFile(); f; f = dir.openNextFile()) {
+        std::string name = f.name();
+        if (name.find(".22000") == std::string::npos) continue;
+        std::string txt = "/handshakes/" + name.substr(0, 12) + "_pmkid.txt";
+        if (SD.exists(txt.c_str())) {
+            File t = SD.open(txt.c_str(), FILE_READ);
+            t.readStringUntil('\n');
+            t.close();
+        }
+        oldFound++;
+    }
+    dir.close();
+    size_t oldOpens = SD.opens;
+
+    // New refresh: one load + one sequential pass
+    SD.opens = 0;
+    Catalog fresh;
+    TEST_ASSERT_TRUE(fresh.load(SD, CAT));
+    visited = 0;
+    fresh.forEachLive([](const CatalogRecord&) { visited++; });
+    size_t newOpens = SD.opens;
+
+    TEST_ASSERT_EQUAL(oldFound, visited);
+    printf("[BENCH] %u captures: directory walk %zu opens (+%u dir entries); catalog %zu opens, index %zu bytes\n",
+           captures, oldOpens, captures * 2, newOpens, fresh.size() * sizeof(CatalogEntry));
+    TEST_ASSERT_EQUAL(2, newOpens);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Filename parsing
+    RUN_TEST(test_parse_capture_names);
+    RUN_TEST(test_parse_rejects_other_files);
+
+    // Put / find / get
+    RUN_TEST(test_put_and_find);
+    RUN_TEST(test_put_replaces_same_key);
+    RUN_TEST(test_put_requires_loaded_catalog);
+
+    // Persistence
+    RUN_TEST(test_reload_applies_supersede_and_tombstones);
+    RUN_TEST(test_torn_tail_is_ignored_and_overwritten);
+    RUN_TEST(test_load_rejects_missing_or_foreign_file);
+    RUN_TEST(test_clear_empties_catalog);
+
+    // Compaction and iteration
+    RUN_TEST(test_compaction_drops_dead_records);
+    RUN_TEST(test_for_each_visits_live_records_once);
+
+    // Rebuild
+    RUN_TEST(test_rebuild_from_directory);
+    RUN_TEST(test_rebuild_without_directory_is_empty);
+
+    // I/O comparison
+    RUN_TEST(test_menu_refresh_io_vs_directory_walk);
+
+    return UNITY_END();
+}
@@ -0,0 +1,368 @@
+// Dir Lister Tests
+// Tests the /api/ls streaming JSON listing against the host-backed SD
+// mock: entry format and escaping, offset/limit paging with the "more"
+// peek, case-insensitive name filtering, count(), and a 10k-file tree
+// paged and streamed through a fixed buffer
+
+#include <unity.h>
+#include <cstdio>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "../../src/web/dir_lister.h"
+#include "../mocks/mock_fs.h"
+
+static const char* TEST_ROOT = "/tmp/porkchop_test_dir_lister";
+
+typedef DirLister<File> Lister;
+
+void setUp(void) {
+    std::string cmd = std::string("rm -rf ") + TEST_ROOT + " && mkdir -p " + TEST_ROOT;
+    system(cmd.c_str());
+    SD.setRoot(TEST_ROOT);
+    SD.opens = 0;
+}
+
+void tearDown(void) {
+    // No teardown needed
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+struct Entry {
+    std::string name;
+    unsigned long size;
+    int isDir;  // -1 when absent
+};
+
+struct Listing {
+    std::vector<Entry> entries;
+    unsigned long offset;
+    unsigned long next;
+    bool more;
+};
+
+static void makeFile(const std::string& path, size_t size) {
+    std::string host = std::string(TEST_ROOT) + path;
+    FILE* fp = fopen(host.c_str(), "wb");
+    std::string data(size, 'x');
+    fwrite(data.data(), 1, data.size(), fp);
+    fclose(fp);
+}
+
+static void makeDir(const std::string& path) {
+    std::string cmd = "mkdir -p '" + std::string(TEST_ROOT) + path + "'";
+    system(cmd.c_str());
+}
+
+// Just enough JSON for the lister's own output; false on anything else
+static bool parseString(const std::string& s, size_t& i, std::string& out) {
+    if (s[i] != '"') return false;
+    i++;
+    out.clear();
+    while (i < s.size() && s[i] != '"') {
+        if (s[i] == '\\') {
+            i++;
+            if (s[i] == 'u') {
+                out += (char)strtol(s.substr(i + 1, 4).c_str(), nullptr, 16);
+                i += 5;
+                continue;
+            }
+        }
+        out += s[i++];
+    }
+    i++;
+    return true;
+}
+
+static bool expect(const std::string& s, size_t& i, const char* lit) {
+    size_t n = strlen(lit);
+    if (s.compare(i, n, lit) != 0) return false;
+    i += n;
+    return true;
+}
+
+static bool parseListing(const std::string& s, Listing& out) {
+    size_t i = 0;
+    out.entries.clear();
+    if (!expect(s, i, "{\"entries\":[")) return false;
+    while (s[i] == '{') {
+        Entry e;
+        e.isDir = -1;
+        if (!expect(s, i, "{\"name\":")) return false;
+        if (!parseString(s, i, e.name)) return false;
+        if (!expect(s, i, ",\"size\":")) return false;
+        e.size = strtoul(s.c_str() + i, nullptr, 10);
+        while (isdigit((unsigned char)s[i])) i++;
+        if (expect(s, i, ",\"isDir\":true")) e.isDir = 1;
+        else if (expect(s, i, ",\"isDir\":false")) e.isDir = 0;
+        if (!expect(s, i, "}")) return false;
+        out.entries.push_back(e);
+        if (s[i] == ',') i++;
+    }
+    if (!expect(s, i, "],\"offset\":")) return false;
+    out.offset = strtoul(s.c_str() + i, nullptr, 10);
+    while (isdigit((unsigned char)s[i])) i++;
+    if (!expect(s, i, ",\"next\":")) return false;
+    out.next = strtoul(s.c_str() + i, nullptr, 10);
+    while (isdigit((unsigned char)s[i])) i++;
+    if (expect(s, i, ",\"more\":true}")) out.more = true;
+    else if (expect(s, i, ",\"more\":false}")) out.more = false;
+    else return false;
+    return i == s.size();
+}
+
+struct Capture {
+    std::string body;
+    size_t maxChunk = 0;
+    size_t chunks = 0;
+};
+
+static DirListResult listDir(const char* dir, uint32_t offset, uint32_t limit,
+                             const char* filter, bool full, Capture& cap) {
+    static Lister lister;
+    File root = SD.open(dir);
+    DirListOptions opt = {offset, limit, filter, full};
+    DirListResult res = lister.list(root, opt, [&cap](const char* data, size_t len) {
+        cap.body.append(data, len);
+        if (len > cap.maxChunk) cap.maxChunk = len;
+        cap.chunks++;
+    });
+    root.close();
+    return res;
+}
+
+// ============================================================================
+// Format
+// ============================================================================
+
+void test_lists_files_and_dirs(void) {
+    makeDir("/d");
+    makeFile("/d/a.pcap", 10);
+    makeFile("/d/b.txt", 3);
+    makeDir("/d/sub");
+    Capture cap;
+    DirListResult res = listDir("/d", 0, 0, nullptr, true, cap);
+    Listing l;
+    TEST_ASSERT_TRUE(parseListing(cap.body, l));
+    TEST_ASSERT_EQUAL_UINT32(3, res.sent);
+    TEST_ASSERT_EQUAL_UINT32(3, l.entries.size());
+    TEST_ASSERT_FALSE(l.more);
+    TEST_ASSERT_EQUAL_UINT32(3, l.next);
+
+    std::map<std::string, Entry> byName;
+    for (auto& e : l.entries) byName[e.name] = e;
+    TEST_ASSERT_EQUAL_UINT32(10, byName["a.pcap"].size);
+    TEST_ASSERT_EQUAL_INT(0, byName["a.pcap"].isDir);
+    TEST_ASSERT_EQUAL_UINT32(3, byName["b.txt"].size);
+    TEST_ASSERT_EQUAL_INT(1, byName["sub"].isDir);
+}
+
+void test_is_dir_only_when_full(void) {
+    makeDir("/d");
+    makeFile("/d/a", 1);
+    Capture cap;
+    listDir("/d", 0, 0, nullptr, false, cap);
+    Listing l;
+    TEST_ASSERT_TRUE(parseListing(cap.body, l));
+    TEST_ASSERT_EQUAL_INT(-1, l.entries[0].isDir);
+}
+
+void test_empty_dir(void) {
+    makeDir("/empty");
+    Capture cap;
+    listDir("/empty", 0, 50, nullptr, true, cap);
+    TEST_ASSERT_EQUAL_STRING("{\"entries\":[],\"offset\":0,\"next\":0,\"more\":false}",
+                             cap.body.c_str());
+}
+
+void test_names_escaped(void) {
+    makeDir("/d");
+    makeFile("/d/say \"hi\"", 1);
+    makeFile("/d/back\\slash", 1);
+    makeFile("/d/bell\x07", 1);
+    Capture cap;
+    listDir("/d", 0, 0, nullptr, true, cap);
+    TEST_ASSERT_TRUE(cap.body.find("say \\\"hi\\\"") != std::string::npos);
+    TEST_ASSERT_TRUE(cap.body.find("back\\\\slash") != std::string::npos);
+    TEST_ASSERT_TRUE(cap.body.find("bell\\u0007") != std::string::npos);
+
+    Listing l;
+    TEST_ASSERT_TRUE(parseListing(cap.body, l));
+    std::set<std::string> names;
+    for (auto& e : l.entries) names.insert(e.name);
+    TEST_ASSERT_EQUAL_UINT32(1, names.count("say \"hi\""));
+    TEST_ASSERT_EQUAL_UINT32(1, names.count("back\\slash"));
+    TEST_ASSERT_EQUAL_UINT32(1, names.count("bell\x07"));
+}
+
+// ============================================================================
+// Paging and filtering
+// ============================================================================
+
+void test_offset_limit_pages(void) {
+    makeDir("/d");
+    for (int i = 0; i < 25; i++) makeFile("/d/f" + std::to_string(i), i);
+    std::set<std::string> seen;
+    uint32_t offset = 0;
+    int pages = 0;
+    for (;;) {
+        Capture cap;
+        listDir("/d", offset, 10, nullptr, true, cap);
+        Listing l;
+        TEST_ASSERT_TRUE(parseListing(cap.body, l));
+        TEST_ASSERT_EQUAL_UINT32(offset, l.offset);
+        for (auto& e : l.entries) TEST_ASSERT_TRUE(seen.insert(e.name).second);
+        TEST_ASSERT_EQUAL_UINT32(offset + l.entries.size(), l.next);
+        pages++;
+        if (!l.more) break;
+        TEST_ASSERT_EQUAL_UINT32(10, l.entries.size());
+        offset = l.next;
+    }
+    TEST_ASSERT_EQUAL_INT(3, pages);
+    TEST_ASSERT_EQUAL_UINT32(25, seen.size());
+}
+
+void test_exact_limit_has_no_more(void) {
+    makeDir("/d");
+    for (int i = 0; i < 10; i++) makeFile("/d/f" + std::to_string(i), 1);
+    Capture cap;
+    DirListResult res = listDir("/d", 0, 10, nullptr, true, cap);
+    TEST_ASSERT_EQUAL_UINT32(10, res.sent);
+    TEST_ASSERT_FALSE(res.more);
+
+    Capture past;
+    res = listDir("/d", 40, 10, nullptr, true, past);
+    TEST_ASSERT_EQUAL_UINT32(0, res.sent);
+    TEST_ASSERT_FALSE(res.more);
+}
+
+void test_filter_case_insensitive(void) {
+    makeDir("/d");
+    makeFile("/d/AA11BB22CC33.pcap", 1);
+    makeFile("/d/aa11bb22cc33_hs.22000", 1);
+    makeFile("/d/DDEEFF001122.pcap", 1);
+    makeFile("/d/notes.txt", 1);
+    Capture cap;
+    listDir("/d", 0, 0, "aa11", true, cap);
+    Listing l;
+    TEST_ASSERT_TRUE(parseListing(cap.body, l));
+    TEST_ASSERT_EQUAL_UINT32(2, l.entries.size());
+
+    Capture pcaps;
+    listDir("/d", 0, 0, ".PCAP", true, pcaps);
+    TEST_ASSERT_TRUE(parseListing(pcaps.body, l));
+    TEST_ASSERT_EQUAL_UINT32(2, l.entries.size());
+
+    TEST_ASSERT_TRUE(Lister::matches("abc", ""));
+    TEST_ASSERT_TRUE(Lister::matches("abc", nullptr));
+    TEST_ASSERT_FALSE(Lister::matches("ab", "abc"));
+}
+
+void test_offset_counts_filtered_matches(void) {
+    makeDir("/d");
+    for (int i = 0; i < 20; i++) makeFile("/d/x" + std::to_string(i) + (i % 2 ? ".pcap" : ".txt"), 1);
+    Capture cap;
+    DirListResult res = listDir("/d", 5, 3, ".pcap", true, cap);
+    Listing l;
+    TEST_ASSERT_TRUE(parseListing(cap.body, l));
+    TEST_ASSERT_EQUAL_UINT32(3, l.entries.size());
+    TEST_ASSERT_TRUE(res.more);
+    for (auto& e : l.entries) TEST_ASSERT_TRUE(e.name.find(".pcap") != std::string::npos);
+    TEST_ASSERT_EQUAL_UINT32(8, l.next);
+}
+
+void test_count(void) {
+    makeDir("/d");
+    for (int i = 0; i < 30; i++) makeFile("/d/f" + std::to_string(i) + (i < 12 ? ".csv" : ".log"), 1);
+    File root = SD.open("/d");
+    TEST_ASSERT_EQUAL_UINT32(30, Lister::count(root, nullptr));
+    root.close();
+    root = SD.open("/d");
+    TEST_ASSERT_EQUAL_UINT32(12, Lister::count(root, ".CSV"));
+    root.close();
+}
+
+// ============================================================================
+// 10k-file tree
+// ============================================================================
+
+void test_10k_files_paged(void) {
+    const int N = 10000;
+    makeDir("/big");
+    for (int i = 0; i < N; i++) {
+        char name[48];
+        snprintf(name, sizeof(name), "/big/%012X.pcap", i * 7919);
+        makeFile(name, i % 97);
+    }
+
+    // Whole directory in one streamed reply
+    Capture all;
+    DirListResult res = listDir("/big", 0, 0, nullptr, true, all);
+    Listing l;
+    TEST_ASSERT_TRUE(parseListing(all.body, l));
+    TEST_ASSERT_EQUAL_UINT32(N, l.entries.size());
+    TEST_ASSERT_EQUAL_UINT32(N, res.scanned);
+    TEST_ASSERT_TRUE(all.maxChunk <= 1024);
+    std::map<std::string, unsigned long> sizes;
+    for (auto& e : l.entries) sizes[e.name] = e.size;
+    TEST_ASSERT_EQUAL_UINT32(N, sizes.size());
+    for (int i = 0; i < N; i += 997) {
+        char name[32];
+        snprintf(name, sizeof(name), "%012X.pcap", i * 7919);
+        TEST_ASSERT_EQUAL_UINT32(i % 97, sizes[name]);
+    }
+    printf("[BENCH] 10k entries: %lu bytes of JSON in %lu chunks, largest %lu (1024 buffer)\n",
+           (unsigned long)all.body.size(), (unsigned long)all.chunks,
+           (unsigned long)all.maxChunk);
+
+    // Paged like the web UI: every entry exactly once
+    std::set<std::string> seen;
+    uint32_t offset = 0;
+    int pages = 0;
+    for (;;) {
+        Capture cap;
+        listDir("/big", offset, 200, nullptr, true, cap);
+        TEST_ASSERT_TRUE(parseListing(cap.body, l));
+        for (auto& e : l.entries) TEST_ASSERT_TRUE(seen.insert(e.name).second);
+        pages++;
+        if (!l.more) break;
+        offset = l.next;
+    }
+    TEST_ASSERT_EQUAL_INT(50, pages);
+    TEST_ASSERT_EQUAL_UINT32(N, seen.size());
+
+    // Filtered count matches a brute-force count of the same names
+    uint32_t expected = 0;
+    for (auto& kv : sizes) {
+        if (kv.first.find("0.pcap") != std::string::npos) expected++;
+    }
+    File root = SD.open("/big");
+    TEST_ASSERT_EQUAL_UINT32(expected, Lister::count(root, "0.PCAP"));
+    root.close();
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Format
+    RUN_TEST(test_lists_files_and_dirs);
+    RUN_TEST(test_is_dir_only_when_full);
+    RUN_TEST(test_empty_dir);
+    RUN_TEST(test_names_escaped);
+
+    // Paging and filtering
+    RUN_TEST(test_offset_limit_pages);
+    RUN_TEST(test_exact_limit_has_no_more);
+    RUN_TEST(test_filter_case_insensitive);
+    RUN_TEST(test_offset_counts_filtered_matches);
+    RUN_TEST(test_count);
+
+    // 10k-file tree
+    RUN_TEST(test_10k_files_paged);
+
+    return UNITY_END();
+}
@@ -0,0 +1,317 @@
+// EAPOL Pool Tests
+// Tests the chunked arena that holds captured EAPOL frames for OINK and DNH
+// handshakes: exact-length storage, in-place replace, release, fragmentation
+// reporting, and how many handshakes fit compared to the old fixed buffers
+
+#include <unity.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "../../src/core/eapol_pool.h"
+
+void setUp(void) {
+    // No setup needed
+}
+
+void tearDown(void) {
+    // No teardown needed
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static std::vector<uint8_t> makeFrame(uint16_t len, uint8_t seed) {
+    std::vector<uint8_t> f(len);
+    for (uint16_t i = 0; i < len; i++) f[i] = (uint8_t)(seed + i * 7);
+    return f;
+}
+
+static bool holds(const EapolPool& pool, const EapolHandle& h, const std::vector<uint8_t>& f) {
+    const uint8_t* p = pool.data(h);
+    return p && h.len == f.size() && memcmp(p, f.data(), f.size()) == 0;
+}
+
+// ============================================================================
+// Arena lifecycle
+// ============================================================================
+
+void test_pool_not_ready_before_begin(void) {
+    EapolPool pool;
+    EapolHandle h = {};
+    std::vector<uint8_t> f = makeFrame(120, 1);
+    TEST_ASSERT_FALSE(pool.isReady());
+    TEST_ASSERT_FALSE(pool.replace(h, f.data(), f.size()));
+    TEST_ASSERT_NULL(pool.data(h));
+    TEST_ASSERT_EQUAL_UINT32(0, pool.stats().capacity);
+}
+
+void test_pool_begin_rounds_to_chunks(void) {
+    EapolPool pool;
+    TEST_ASSERT_TRUE(pool.begin(4100, 1024));
+    TEST_ASSERT_TRUE(pool.isReady());
+    TEST_ASSERT_EQUAL_UINT32(4096, pool.stats().capacity);
+    TEST_ASSERT_EQUAL_UINT32(4096, pool.stats().largestFree);
+}
+
+void test_pool_begin_twice_keeps_arena(void) {
+    EapolPool pool;
+    pool.begin(2048, 1024);
+    EapolHandle h = {};
+    std::vector<uint8_t> f = makeFrame(99, 3);
+    pool.replace(h, f.data(), f.size());
+    TEST_ASSERT_TRUE(pool.begin(8192, 1024));
+    TEST_ASSERT_EQUAL_UINT32(2048, pool.stats().capacity);
+    TEST_ASSERT_TRUE(holds(pool, h, f));
+}
+
+void test_pool_begin_below_minimum_fails(void) {
+    EapolPool pool;
+    TEST_ASSERT_FALSE(pool.begin(512, 1024));
+    TEST_ASSERT_FALSE(pool.isReady());
+}
+
+void test_pool_end_and_reset(void) {
+    EapolPool pool;
+    pool.begin(4096, 1024);
+    EapolHandle h = {};
+    std::vector<uint8_t> f = makeFrame(150, 9);
+    pool.replace(h, f.data(), f.size());
+
+    pool.reset();
+    TEST_ASSERT_TRUE(pool.isReady());
+    TEST_ASSERT_EQUAL_UINT16(0, pool.frameCount());
+    TEST_ASSERT_EQUAL_UINT32(0, pool.stats().used);
+
+    pool.end();
+    TEST_ASSERT_FALSE(pool.isReady());
+}
+
+// ============================================================================
+// Store / replace / release
+// ============================================================================
+
+void test_store_exact_length(void) {
+    EapolPool pool;
+    pool.begin(4096, 1024);
+    EapolHandle h = {};
+    std::vector<uint8_t> f = makeFrame(131, 5);
+    TEST_ASSERT_TRUE(pool.replace(h, f.data(), f.size()));
+    TEST_ASSERT_TRUE(h.valid());
+    TEST_ASSERT_TRUE(holds(pool, h, f));
+
+    EapolPoolStats s = pool.stats();
+    TEST_ASSERT_EQUAL_UINT32(131, s.payload);
+    TEST_ASSERT_EQUAL_UINT32(160, s.used);  // 5 chunks of 32
+    TEST_ASSERT_EQUAL_UINT16(1, s.frames);
+}
+
+void test_store_zero_length_rejected(void) {
+    EapolPool pool;
+    pool.begin(4096, 1024);
+    EapolHandle h = {};
+    uint8_t b = 0;
+    TEST_ASSERT_FALSE(pool.replace(h, &b, 0));
+    TEST_ASSERT_FALSE(h.valid());
+}
+
+void test_replace_shrinks_in_place(void) {
+    EapolPool pool;
+    pool.begin(4096, 1024);
+    EapolHandle h = {};
+    std::vector<uint8_t> big = makeFrame(200, 1);
+    std::vector<uint8_t> small = makeFrame(70, 2);
+    pool.replace(h, big.data(), big.size());
+    uint16_t chunk = h.chunk;
+
+    TEST_ASSERT_TRUE(pool.replace(h, small.data(), small.size()));
+    TEST_ASSERT_EQUAL_UINT16(chunk, h.chunk);
+    TEST_ASSERT_TRUE(holds(pool, h, small));
+    TEST_ASSERT_EQUAL_UINT32(96, pool.stats().used);
+    TEST_ASSERT_EQUAL_UINT16(1, pool.frameCount());
+}
+
+void test_replace_grows_by_moving(void) {
+    EapolPool pool;
+    pool.begin(4096, 1024);
+    EapolHandle a = {}, b = {};
+    std::vector<uint8_t> fa = makeFrame(60, 1);
+    std::vector<uint8_t> fb = makeFrame(60, 2);
+    std::vector<uint8_t> fa2 = makeFrame(250, 3);
+    pool.replace(a, fa.data(), fa.size());
+    pool.replace(b, fb.data(), fb.size());  // Blocks growing a in place
+
+    TEST_ASSERT_TRUE(pool.replace(a, fa2.data(), fa2.size()));
+    TEST_ASSERT_TRUE(holds(pool, a, fa2));
+    TEST_ASSERT_TRUE(holds(pool, b, fb));
+    TEST_ASSERT_EQUAL_UINT16(2, pool.frameCount());
+    TEST_ASSERT_EQUAL_UINT32(64 + 256, pool.stats().used);
+}
+
+void test_replace_failure_keeps_old_frame(void) {
+    EapolPool pool;
+    pool.begin(1024, 1024);
+    EapolHandle a = {}, b = {};
+    std::vector<uint8_t> fa = makeFrame(480, 1);
+    std::vector<uint8_t> fb = makeFrame(480, 2);
+    std::vector<uint8_t> huge = makeFrame(600, 3);
+    pool.replace(a, fa.data(), fa.size());
+    pool.replace(b, fb.data(), fb.size());
+
+    TEST_ASSERT_FALSE(pool.replace(a, huge.data(), huge.size()));
+    TEST_ASSERT_TRUE(holds(pool, a, fa));
+    TEST_ASSERT_EQUAL_UINT16(1, pool.stats().failed);
+}
+
+void test_release_frees_chunks(void) {
+    EapolPool pool;
+    pool.begin(4096, 1024);
+    EapolHandle h = {};
+    std::vector<uint8_t> f = makeFrame(121, 4);
+    pool.replace(h, f.data(), f.size());
+    pool.release(h);
+    TEST_ASSERT_FALSE(h.valid());
+    TEST_ASSERT_NULL(pool.data(h));
+    TEST_ASSERT_EQUAL_UINT32(0, pool.stats().used);
+    TEST_ASSERT_EQUAL_UINT32(128, pool.stats().peakUsed);
+    pool.release(h);  // Double release is a no-op
+    TEST_ASSERT_EQUAL_UINT16(0, pool.frameCount());
+}
+
+void test_full_pool_counts_failures(void) {
+    EapolPool pool;
+    pool.begin(1024, 1024);
+    std::vector<uint8_t> f = makeFrame(128, 7);
+    EapolHandle h[9] = {};
+    int stored = 0;
+    for (int i = 0; i < 9; i++) {
+        if (pool.replace(h[i], f.data(), f.size())) stored++;
+    }
+    TEST_ASSERT_EQUAL_INT(8, stored);
+    TEST_ASSERT_EQUAL_UINT16(1, pool.stats().failed);
+    TEST_ASSERT_EQUAL_UINT32(0, pool.stats().largestFree);
+}
+
+// ============================================================================
+// Fragmentation
+// ============================================================================
+
+void test_fragmentation_reported(void) {
+    EapolPool pool;
+    pool.begin(1024, 1024);
+    std::vector<uint8_t> f = makeFrame(64, 1);
+    EapolHandle h[16] = {};
+    for (int i = 0; i < 16; i++) pool.replace(h[i], f.data(), f.size());
+    TEST_ASSERT_EQUAL_UINT8(0, pool.stats().fragmentation);
+
+    // Free every other frame: half the arena free, in 64-byte holes
+    for (int i = 0; i < 16; i += 2) pool.release(h[i]);
+    EapolPoolStats s = pool.stats();
+    TEST_ASSERT_EQUAL_UINT32(512, s.capacity - s.used);
+    TEST_ASSERT_EQUAL_UINT32(64, s.largestFree);
+    TEST_ASSERT_EQUAL_UINT8(88, s.fragmentation);
+
+    // 512 bytes free but no 100-byte hole
+    EapolHandle big = {};
+    std::vector<uint8_t> fb = makeFrame(100, 2);
+    TEST_ASSERT_FALSE(pool.replace(big, fb.data(), fb.size()));
+
+    // Holes coalesce once neighbours go
+    pool.release(h[1]);
+    TEST_ASSERT_TRUE(pool.replace(big, fb.data(), fb.size()));
+    TEST_ASSERT_TRUE(holds(pool, big, fb));
+}
+
+void test_churn_keeps_contents_intact(void) {
+    EapolPool pool;
+    pool.begin(8192, 1024);
+    const int SLOTS = 48;
+    EapolHandle h[SLOTS] = {};
+    std::vector<uint8_t> expect[SLOTS];
+    srand(1234);
+
+    for (int step = 0; step < 5000; step++) {
+        int i = rand() % SLOTS;
+        if (rand() % 4 == 0) {
+            pool.release(h[i]);
+            expect[i].clear();
+        } else {
+            std::vector<uint8_t> f = makeFrame((uint16_t)(99 + rand() % 300), (uint8_t)step);
+            if (pool.replace(h[i], f.data(), f.size())) expect[i] = f;
+        }
+        if (step % 97 == 0) {
+            for (int k = 0; k < SLOTS; k++) {
+                if (expect[k].empty()) TEST_ASSERT_FALSE(h[k].valid());
+                else TEST_ASSERT_TRUE(holds(pool, h[k], expect[k]));
+            }
+        }
+    }
+
+    uint32_t payload = 0;
+    uint16_t live = 0;
+    for (int k = 0; k < SLOTS; k++) {
+        if (h[k].valid()) { payload += h[k].len; live++; }
+    }
+    TEST_ASSERT_EQUAL_UINT32(payload, pool.stats().payload);
+    TEST_ASSERT_EQUAL_UINT16(live, pool.frameCount());
+}
+
+// ============================================================================
+// Capacity vs fixed buffers (informational)
+// ============================================================================
+
+void test_capacity_vs_fixed_buffers(void) {
+    // Old layout: 4 x (512 + 300 + bookkeeping) per handshake, frames or not
+    const size_t OLD_PER_HANDSHAKE = 4 * (512 + 300 + 12);
+    const size_t BUDGET = 16 * 1024;
+
+    EapolPool pool;
+    pool.begin(BUDGET, 1024);
+    // Typical M1 (PMKID KDE) and M2 (RSN IE): 802.11 + LLC header + EAPOL-Key
+    std::vector<uint8_t> m1 = makeFrame(34 + 121, 1);
+    std::vector<uint8_t> m2 = makeFrame(34 + 123, 2);
+    std::vector<EapolHandle> handles;
+    size_t pairs = 0;
+    for (;;) {
+        EapolHandle a = {}, b = {};
+        if (!pool.replace(a, m1.data(), m1.size())) break;
+        if (!pool.replace(b, m2.data(), m2.size())) break;
+        handles.push_back(a);
+        handles.push_back(b);
+        pairs++;
+    }
+    size_t oldFit = BUDGET / OLD_PER_HANDSHAKE;
+    TEST_ASSERT_TRUE(pairs >= oldFit * 5);
+    printf("[BENCH] %zu KB: %zu M1+M2 handshakes pooled vs %zu with fixed 4x812-byte buffers\n",
+           BUDGET / 1024, pairs, oldFit);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Arena lifecycle
+    RUN_TEST(test_pool_not_ready_before_begin);
+    RUN_TEST(test_pool_begin_rounds_to_chunks);
+    RUN_TEST(test_pool_begin_twice_keeps_arena);
+    RUN_TEST(test_pool_begin_below_minimum_fails);
+    RUN_TEST(test_pool_end_and_reset);
+
+    // Store / replace / release
+    RUN_TEST(test_store_exact_length);
+    RUN_TEST(test_store_zero_length_rejected);
+    RUN_TEST(test_replace_shrinks_in_place);
+    RUN_TEST(test_replace_grows_by_moving);
+    RUN_TEST(test_replace_failure_keeps_old_frame);
+    RUN_TEST(test_release_frees_chunks);
+    RUN_TEST(test_full_pool_counts_failures);
+
+    // Fragmentation
+    RUN_TEST(test_fragmentation_reported);
+    RUN_TEST(test_churn_keeps_contents_intact);
+
+    // Capacity
+    RUN_TEST(test_capacity_vs_fixed_buffers);
+
+    return UNITY_END();
+}
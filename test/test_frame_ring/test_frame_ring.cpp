@@ -0,0 +1,404 @@
+// Frame Ring Tests
+// Tests the lock-free SPSC ring used between the promiscuous callback and update()
+
+#include <unity.h>
+#include <cstring>
+#include <thread>
+#include <atomic>
+#include "../../src/core/frame_ring.h"
+
+void setUp(void) {
+    // No setup needed
+}
+
+void tearDown(void) {
+    // No teardown needed
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static FrameRecord makeMeta(uint8_t type, int8_t rssi, uint32_t ts) {
+    FrameRecord meta;
+    memset(&meta, 0, sizeof(meta));
+    meta.type = type;
+    meta.rssi = rssi;
+    meta.channel = 6;
+    meta.timestamp = ts;
+    return meta;
+}
+
+// Fill a payload with a pattern derived from its sequence number
+static void fillPattern(uint8_t* buf, uint16_t len, uint32_t seq) {
+    for (uint16_t i = 0; i < len; i++) {
+        buf[i] = (uint8_t)(seq * 31 + i);
+    }
+}
+
+static bool checkPattern(const uint8_t* buf, uint16_t len, uint32_t seq) {
+    for (uint16_t i = 0; i < len; i++) {
+        if (buf[i] != (uint8_t)(seq * 31 + i)) return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// Basic push/pop
+// ============================================================================
+
+void test_ring_starts_empty(void) {
+    static FrameRing<1024> ring;
+    TEST_ASSERT_TRUE(ring.empty());
+    TEST_ASSERT_NULL(ring.peek());
+    TEST_ASSERT_EQUAL_UINT32(0, ring.usedBytes());
+}
+
+void test_ring_push_pop_preserves_record(void) {
+    static FrameRing<1024> ring;
+    uint8_t data[100];
+    fillPattern(data, sizeof(data), 7);
+
+    FrameRecord meta = makeMeta(2, -55, 12345);
+    TEST_ASSERT_TRUE(ring.push(meta, data, sizeof(data)));
+    TEST_ASSERT_FALSE(ring.empty());
+
+    const FrameRecord* rec = ring.peek();
+    TEST_ASSERT_NOT_NULL(rec);
+    TEST_ASSERT_EQUAL_UINT16(100, rec->len);
+    TEST_ASSERT_EQUAL_UINT16(100, rec->origLen);
+    TEST_ASSERT_EQUAL(-55, rec->rssi);
+    TEST_ASSERT_EQUAL_UINT8(2, rec->type);
+    TEST_ASSERT_EQUAL_UINT8(6, rec->channel);
+    TEST_ASSERT_EQUAL_UINT32(12345, rec->timestamp);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data, rec->data(), 100);
+
+    ring.pop();
+    TEST_ASSERT_TRUE(ring.empty());
+    TEST_ASSERT_NULL(ring.peek());
+}
+
+void test_ring_truncated_snapshot_keeps_orig_len(void) {
+    static FrameRing<1024> ring;
+    uint8_t data[32] = {0};
+
+    FrameRecord meta = makeMeta(2, -40, 0);
+    meta.origLen = 1400;  // On-air length, only header stored
+    TEST_ASSERT_TRUE(ring.push(meta, data, sizeof(data)));
+
+    const FrameRecord* rec = ring.peek();
+    TEST_ASSERT_EQUAL_UINT16(32, rec->len);
+    TEST_ASSERT_EQUAL_UINT16(1400, rec->origLen);
+}
+
+void test_ring_fifo_order_variable_lengths(void) {
+    static FrameRing<2048> ring;
+    uint8_t data[200];
+
+    for (uint32_t i = 0; i < 8; i++) {
+        uint16_t len = 10 + i * 20;
+        fillPattern(data, len, i);
+        TEST_ASSERT_TRUE(ring.push(makeMeta(0, -60, i), data, len));
+    }
+
+    for (uint32_t i = 0; i < 8; i++) {
+        const FrameRecord* rec = ring.peek();
+        TEST_ASSERT_NOT_NULL(rec);
+        TEST_ASSERT_EQUAL_UINT32(i, rec->timestamp);
+        TEST_ASSERT_EQUAL_UINT16(10 + i * 20, rec->len);
+        TEST_ASSERT_TRUE(checkPattern(rec->data(), rec->len, i));
+        ring.pop();
+    }
+    TEST_ASSERT_TRUE(ring.empty());
+}
+
+void test_ring_zero_length_record(void) {
+    static FrameRing<256> ring;
+    TEST_ASSERT_TRUE(ring.push(makeMeta(1, -70, 9), nullptr, 0));
+    const FrameRecord* rec = ring.peek();
+    TEST_ASSERT_NOT_NULL(rec);
+    TEST_ASSERT_EQUAL_UINT16(0, rec->len);
+    ring.pop();
+    TEST_ASSERT_TRUE(ring.empty());
+}
+
+// ============================================================================
+// Wrap-around
+// ============================================================================
+
+void test_ring_wraps_many_times(void) {
+    static FrameRing<1024> ring;
+    uint8_t data[200];
+
+    // Odd lengths force every kind of tail gap (marker and implicit skip)
+    for (uint32_t i = 0; i < 2000; i++) {
+        uint16_t len = (uint16_t)((i * 37) % 200);
+        fillPattern(data, len, i);
+        TEST_ASSERT_TRUE(ring.push(makeMeta(0, -50, i), data, len));
+
+        const FrameRecord* rec = ring.peek();
+        TEST_ASSERT_NOT_NULL(rec);
+        TEST_ASSERT_EQUAL_UINT32(i, rec->timestamp);
+        TEST_ASSERT_EQUAL_UINT16(len, rec->len);
+        TEST_ASSERT_TRUE(checkPattern(rec->data(), len, i));
+        ring.pop();
+    }
+    TEST_ASSERT_TRUE(ring.empty());
+    TEST_ASSERT_EQUAL_UINT32(2000, ring.stats().pushed);
+    TEST_ASSERT_EQUAL_UINT32(2000, ring.stats().popped);
+}
+
+void test_ring_wraps_with_backlog(void) {
+    static FrameRing<1024> ring;
+    uint8_t data[150];
+    uint32_t pushSeq = 0, popSeq = 0;
+
+    // Keep 3-4 records queued while cycling through the buffer
+    for (int round = 0; round < 500; round++) {
+        while (true) {
+            uint16_t len = (uint16_t)(20 + (pushSeq * 13) % 130);
+            fillPattern(data, len, pushSeq);
+            if (!ring.push(makeMeta(0, -50, pushSeq), data, len)) break;
+            pushSeq++;
+        }
+        // Pop two
+        for (int k = 0; k < 2; k++) {
+            const FrameRecord* rec = ring.peek();
+            TEST_ASSERT_NOT_NULL(rec);
+            TEST_ASSERT_EQUAL_UINT32(popSeq, rec->timestamp);
+            TEST_ASSERT_TRUE(checkPattern(rec->data(), rec->len, popSeq));
+            ring.pop();
+            popSeq++;
+        }
+    }
+    TEST_ASSERT_TRUE(ring.usedBytes() <= 1024);
+}
+
+// ============================================================================
+// Overflow accounting
+// ============================================================================
+
+void test_ring_full_counts_drops(void) {
+    static FrameRing<256> ring;
+    uint8_t data[48] = {0};
+
+    // 12-byte header + 48 = 60 bytes/record -> 4 fit in 256
+    int accepted = 0;
+    for (int i = 0; i < 10; i++) {
+        if (ring.push(makeMeta(0, -50, i), data, sizeof(data))) accepted++;
+    }
+
+    FrameRingStats s = ring.stats();
+    TEST_ASSERT_EQUAL(4, accepted);
+    TEST_ASSERT_EQUAL_UINT32(4, s.pushed);
+    TEST_ASSERT_EQUAL_UINT32(6, s.droppedFull);
+    TEST_ASSERT_EQUAL_UINT32(6 * 48, s.droppedBytes);
+    TEST_ASSERT_EQUAL_UINT32(240, s.highWater);
+}
+
+void test_ring_oversize_rejected(void) {
+    static FrameRing<1024> ring;
+    static uint8_t data[1024];
+
+    // maxRecordSize() is a quarter of the ring
+    TEST_ASSERT_FALSE(ring.push(makeMeta(0, -50, 0), data, 300));
+    TEST_ASSERT_EQUAL_UINT32(1, ring.stats().droppedOversize);
+    TEST_ASSERT_EQUAL_UINT32(0, ring.stats().droppedFull);
+    TEST_ASSERT_TRUE(ring.empty());
+
+    uint16_t maxPayload = (uint16_t)(FrameRing<1024>::maxRecordSize() - sizeof(FrameRecord));
+    TEST_ASSERT_TRUE(ring.push(makeMeta(0, -50, 0), data, maxPayload));
+}
+
+void test_ring_reserve_keeps_headroom(void) {
+    static FrameRing<1024> ring;
+    uint8_t data[100] = {0};
+
+    // Low priority pushes with 512 bytes reserve stop early...
+    int lowPrio = 0;
+    while (ring.push(makeMeta(0, -50, 0), data, sizeof(data), 512)) lowPrio++;
+    TEST_ASSERT_TRUE(ring.usedBytes() <= 512);
+    TEST_ASSERT_TRUE(lowPrio > 0);
+
+    // ...and high priority pushes can still use the headroom
+    int highPrio = 0;
+    while (ring.push(makeMeta(2, -50, 0), data, sizeof(data))) highPrio++;
+    TEST_ASSERT_TRUE(highPrio >= 4);
+}
+
+void test_ring_recovers_after_drain(void) {
+    static FrameRing<256> ring;
+    uint8_t data[48] = {0};
+
+    while (ring.push(makeMeta(0, -50, 0), data, sizeof(data))) {}
+    TEST_ASSERT_FALSE(ring.push(makeMeta(0, -50, 0), data, sizeof(data)));
+
+    ring.pop();
+    TEST_ASSERT_TRUE(ring.push(makeMeta(0, -50, 0), data, sizeof(data)));
+}
+
+// ============================================================================
+// Batch drain / clear
+// ============================================================================
+
+void test_ring_drain_respects_batch_limit(void) {
+    static FrameRing<2048> ring;
+    uint8_t data[16] = {0};
+
+    for (uint32_t i = 0; i < 20; i++) {
+        TEST_ASSERT_TRUE(ring.push(makeMeta(0, -50, i), data, sizeof(data)));
+    }
+
+    uint32_t expected = 0;
+    bool ordered = true;
+    auto check = [&](const FrameRecord& rec) {
+        if (rec.timestamp != expected) ordered = false;
+        expected++;
+    };
+
+    TEST_ASSERT_EQUAL_UINT32(8, ring.drain(check, 8));
+    TEST_ASSERT_EQUAL_UINT32(8, ring.drain(check, 8));
+    TEST_ASSERT_EQUAL_UINT32(4, ring.drain(check, 8));
+    TEST_ASSERT_EQUAL_UINT32(0, ring.drain(check, 8));
+    TEST_ASSERT_TRUE(ordered);
+    TEST_ASSERT_EQUAL_UINT32(20, expected);
+}
+
+void test_ring_clear_discards_backlog(void) {
+    static FrameRing<1024> ring;
+    uint8_t data[40] = {0};
+
+    for (int i = 0; i < 5; i++) ring.push(makeMeta(0, -50, i), data, sizeof(data));
+    ring.clear();
+    TEST_ASSERT_TRUE(ring.empty());
+    TEST_ASSERT_NULL(ring.peek());
+
+    // Still usable afterwards
+    TEST_ASSERT_TRUE(ring.push(makeMeta(0, -50, 99), data, sizeof(data)));
+    TEST_ASSERT_EQUAL_UINT32(99, ring.peek()->timestamp);
+}
+
+// ============================================================================
+// Concurrency: producer thread stands in for the WiFi task
+// ============================================================================
+
+void test_ring_producer_thread_no_corruption(void) {
+    static FrameRing<4096> ring;
+    const uint32_t TOTAL = 200000;
+    std::atomic<bool> done(false);
+
+    std::thread producer([&]() {
+        uint8_t data[300];
+        for (uint32_t seq = 0; seq < TOTAL; seq++) {
+            uint16_t len = (uint16_t)(24 + (seq * 7) % 276);
+            fillPattern(data, len, seq);
+            FrameRecord meta = makeMeta((uint8_t)(seq & 3), (int8_t)-(seq % 90), seq);
+            // Drops are allowed (that's what the counters are for), corruption isn't
+            ring.push(meta, data, len);
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    uint32_t received = 0;
+    uint32_t lastSeq = 0;
+    bool first = true;
+    bool ordered = true;
+    bool intact = true;
+
+    auto consume = [&](const FrameRecord& rec) {
+        if (!first && rec.timestamp <= lastSeq) ordered = false;
+        if (rec.len != (uint16_t)(24 + (rec.timestamp * 7) % 276)) intact = false;
+        if (!checkPattern(rec.data(), rec.len, rec.timestamp)) intact = false;
+        if (rec.type != (rec.timestamp & 3)) intact = false;
+        lastSeq = rec.timestamp;
+        first = false;
+        received++;
+    };
+
+    while (!done.load(std::memory_order_acquire)) {
+        ring.drain(consume, 32);
+    }
+    while (ring.drain(consume, 32) > 0) {}
+    producer.join();
+
+    FrameRingStats s = ring.stats();
+    TEST_ASSERT_TRUE(ordered);
+    TEST_ASSERT_TRUE(intact);
+    TEST_ASSERT_EQUAL_UINT32(s.pushed, received);
+    TEST_ASSERT_EQUAL_UINT32(s.pushed, s.popped);
+    TEST_ASSERT_EQUAL_UINT32(TOTAL, s.pushed + s.droppedFull);
+    TEST_ASSERT_EQUAL_UINT32(0, s.droppedOversize);
+    TEST_ASSERT_TRUE(s.highWater <= 4096);
+    TEST_ASSERT_TRUE(ring.empty());
+}
+
+void test_ring_slow_consumer_counts_overflow(void) {
+    static FrameRing<1024> ring;
+    const uint32_t TOTAL = 20000;
+    std::atomic<bool> done(false);
+
+    std::thread producer([&]() {
+        uint8_t data[64];
+        for (uint32_t seq = 0; seq < TOTAL; seq++) {
+            fillPattern(data, sizeof(data), seq);
+            ring.push(makeMeta(0, -50, seq), data, sizeof(data));
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    uint32_t received = 0;
+    bool intact = true;
+    auto consume = [&](const FrameRecord& rec) {
+        if (!checkPattern(rec.data(), rec.len, rec.timestamp)) intact = false;
+        received++;
+    };
+
+    // Drain one frame at a time with a yield to let the producer overrun us
+    while (!done.load(std::memory_order_acquire)) {
+        ring.drain(consume, 1);
+        std::this_thread::yield();
+    }
+    while (ring.drain(consume, 32) > 0) {}
+    producer.join();
+
+    FrameRingStats s = ring.stats();
+    TEST_ASSERT_TRUE(intact);
+    TEST_ASSERT_EQUAL_UINT32(s.pushed, received);
+    TEST_ASSERT_EQUAL_UINT32(TOTAL, s.pushed + s.droppedFull);
+    TEST_ASSERT_EQUAL_UINT32(s.droppedFull * 64, s.droppedBytes);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Basic push/pop
+    RUN_TEST(test_ring_starts_empty);
+    RUN_TEST(test_ring_push_pop_preserves_record);
+    RUN_TEST(test_ring_truncated_snapshot_keeps_orig_len);
+    RUN_TEST(test_ring_fifo_order_variable_lengths);
+    RUN_TEST(test_ring_zero_length_record);
+
+    // Wrap-around
+    RUN_TEST(test_ring_wraps_many_times);
+    RUN_TEST(test_ring_wraps_with_backlog);
+
+    // Overflow accounting
+    RUN_TEST(test_ring_full_counts_drops);
+    RUN_TEST(test_ring_oversize_rejected);
+    RUN_TEST(test_ring_reserve_keeps_headroom);
+    RUN_TEST(test_ring_recovers_after_drain);
+
+    // Batch drain / clear
+    RUN_TEST(test_ring_drain_respects_batch_limit);
+    RUN_TEST(test_ring_clear_discards_backlog);
+
+    // Concurrency
+    RUN_TEST(test_ring_producer_thread_no_corruption);
+    RUN_TEST(test_ring_slow_consumer_counts_overflow);
+
+    return UNITY_END();
+}
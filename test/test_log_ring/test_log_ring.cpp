@@ -0,0 +1,329 @@
+// Log Ring Tests
+// Tests the SD debug log backend against the host-backed SD mock: lines
+// held until a size/age drain, wrap-around drains, drops counted and noted
+// when the ring is full, rotation at a line boundary, flush/close/reopen,
+// end() unhooking the ring under the lock, and card I/O against the
+// open/append/close-per-line pattern
+
+#include <unity.h>
+#include <cstdio>
+#include <string>
+#include "../mocks/mock_fs.h"
+#include "../../src/core/log_ring.h"
+
+static const char* TEST_ROOT = "/tmp/porkchop_test_log_ring";
+
+typedef LogRing<fs::FS, File, 512> SmallRing;
+
+// Records whether the ring was held when end() let go of the buffer
+struct TrackingLock {
+    static bool held;
+    static int acquired;
+    static void lock() { held = true; acquired++; }
+    static void unlock() { held = false; }
+};
+bool TrackingLock::held = false;
+int TrackingLock::acquired = 0;
+
+void setUp(void) {
+    std::string cmd = std::string("rm -rf ") + TEST_ROOT + " && mkdir -p " + TEST_ROOT;
+    system(cmd.c_str());
+    SD.setRoot(TEST_ROOT);
+    SD.opens = 0;
+}
+
+void tearDown(void) {
+    // No teardown needed
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static std::string readAll(const char* path) {
+    std::string host = std::string(TEST_ROOT) + path;
+    FILE* fp = fopen(host.c_str(), "rb");
+    if (!fp) return "";
+    std::string out;
+    char buf[512];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) out.append(buf, n);
+    fclose(fp);
+    return out;
+}
+
+static bool pushLine(SmallRing& r, const std::string& s) {
+    return r.push(s.c_str(), s.size());
+}
+
+// ============================================================================
+// Queueing and drain policy
+// ============================================================================
+
+void test_lines_wait_for_drain(void) {
+    SmallRing r;
+    TEST_ASSERT_TRUE(r.begin(SD, "/p.log", "/p.1.log", 0, true));
+    pushLine(r, "[1][OINK] hello\n");
+    pushLine(r, "[2][OINK] world\n");
+    TEST_ASSERT_EQUAL_UINT32(32, r.pending());
+    TEST_ASSERT_EQUAL_STRING("", readAll("/p.log").c_str());
+
+    TEST_ASSERT_TRUE(r.flush());
+    TEST_ASSERT_EQUAL_STRING("[1][OINK] hello\n[2][OINK] world\n", readAll("/p.log").c_str());
+    TEST_ASSERT_EQUAL_UINT32(1, r.stats().writes);
+    TEST_ASSERT_EQUAL_UINT32(0, r.pending());
+}
+
+void test_update_drains_by_bytes(void) {
+    SmallRing r;
+    r.begin(SD, "/p.log", "/p.1.log", 0, true);
+    for (int i = 0; i < 10; i++) pushLine(r, "0123456789abcde\n");
+    TEST_ASSERT_FALSE(r.update(100, 256, 2000));
+    for (int i = 0; i < 10; i++) pushLine(r, "0123456789abcde\n");
+    TEST_ASSERT_TRUE(r.update(200, 256, 2000));
+    TEST_ASSERT_EQUAL_UINT32(320, readAll("/p.log").size());
+}
+
+void test_update_drains_by_age(void) {
+    SmallRing r;
+    r.begin(SD, "/p.log", "/p.1.log", 0, true);
+    pushLine(r, "one\n");
+    TEST_ASSERT_FALSE(r.update(1000, 256, 2000));  // First sighting starts the clock
+    TEST_ASSERT_FALSE(r.update(2999, 256, 2000));
+    TEST_ASSERT_TRUE(r.update(3000, 256, 2000));
+
+    // Clock restarts with the next line, not the last drain
+    pushLine(r, "two\n");
+    TEST_ASSERT_FALSE(r.update(9000, 256, 2000));
+    TEST_ASSERT_TRUE(r.update(11000, 256, 2000));
+    TEST_ASSERT_EQUAL_STRING("one\ntwo\n", readAll("/p.log").c_str());
+}
+
+void test_update_empty_is_noop(void) {
+    SmallRing r;
+    r.begin(SD, "/p.log", "/p.1.log", 0, true);
+    TEST_ASSERT_FALSE(r.update(99999, 1, 1));
+    TEST_ASSERT_EQUAL_UINT32(0, r.stats().writes);
+}
+
+void test_wrapped_ring_drains_in_order(void) {
+    SmallRing r;
+    r.begin(SD, "/p.log", "/p.1.log", 0, true);
+    std::string expect;
+    for (int i = 0; i < 200; i++) {
+        char line[40];
+        snprintf(line, sizeof(line), "[%d][WARHOG] network %03d\n", i, i);
+        TEST_ASSERT_TRUE(pushLine(r, line));
+        expect += line;
+        r.update(i, 256, 2000);
+    }
+    r.flush();
+    TEST_ASSERT_EQUAL_STRING(expect.c_str(), readAll("/p.log").c_str());
+    TEST_ASSERT_EQUAL_UINT32(0, r.stats().dropped);
+    TEST_ASSERT_TRUE(r.stats().highWater <= 512);
+}
+
+// ============================================================================
+// Drops
+// ============================================================================
+
+void test_full_ring_drops_whole_lines(void) {
+    SmallRing r;
+    r.begin(SD, "/p.log", "/p.1.log", 0, true);
+    std::string line(99, 'x');
+    line += '\n';
+    for (int i = 0; i < 5; i++) TEST_ASSERT_TRUE(pushLine(r, line));
+    TEST_ASSERT_FALSE(pushLine(r, line));
+    TEST_ASSERT_FALSE(pushLine(r, "short\n"));  // Stays behind the first drop
+    TEST_ASSERT_EQUAL_UINT32(2, r.stats().dropped);
+    TEST_ASSERT_EQUAL_UINT32(5, r.stats().lines);
+    TEST_ASSERT_EQUAL_UINT32(500, r.pending());
+}
+
+void test_drop_marker_precedes_next_line(void) {
+    SmallRing r;
+    r.begin(SD, "/p.log", "/p.1.log", 0, true);
+    std::string line(99, 'x');
+    line += '\n';
+    for (int i = 0; i < 8; i++) pushLine(r, line);
+    r.flush();
+    pushLine(r, "after\n");
+    r.flush();
+    std::string got = readAll("/p.log");
+    std::string tail = got.substr(500);
+    TEST_ASSERT_EQUAL_STRING("*** 3 log lines dropped ***\nafter\n", tail.c_str());
+}
+
+void test_oversized_line_is_dropped(void) {
+    SmallRing r;
+    r.begin(SD, "/p.log", "/p.1.log", 0, true);
+    std::string big(600, 'b');
+    TEST_ASSERT_FALSE(r.push(big.c_str(), big.size()));
+    TEST_ASSERT_EQUAL_UINT32(1, r.stats().dropped);
+}
+
+// ============================================================================
+// Rotation
+// ============================================================================
+
+void test_rotates_at_line_boundary(void) {
+    SmallRing r;
+    r.begin(SD, "/p.log", "/p.1.log", 200, true);
+    std::string line(49, 'a');
+    line += '\n';
+    for (int i = 0; i < 5; i++) pushLine(r, line);
+    r.flush();
+    TEST_ASSERT_EQUAL_UINT32(250, readAll("/p.log").size());  // Over, but rotates on the next drain
+
+    pushLine(r, "fresh\n");
+    r.flush();
+    TEST_ASSERT_EQUAL_UINT32(1, r.stats().rotations);
+    TEST_ASSERT_EQUAL_UINT32(250, readAll("/p.1.log").size());
+    TEST_ASSERT_EQUAL_STRING("fresh\n", readAll("/p.log").c_str());
+    TEST_ASSERT_EQUAL_UINT32(6, r.fileSize());
+}
+
+void test_rotation_replaces_old_file(void) {
+    SmallRing r;
+    r.begin(SD, "/p.log", "/p.1.log", 100, true);
+    pushLine(r, std::string(119, '1') + "\n");
+    r.flush();
+    pushLine(r, std::string(119, '2') + "\n");
+    r.flush();
+    pushLine(r, "3\n");
+    r.flush();
+    TEST_ASSERT_EQUAL_UINT32(2, r.stats().rotations);
+    TEST_ASSERT_EQUAL_STRING((std::string(119, '2') + "\n").c_str(), readAll("/p.1.log").c_str());
+    TEST_ASSERT_EQUAL_STRING("3\n", readAll("/p.log").c_str());
+}
+
+void test_append_mode_seeds_size(void) {
+    {
+        FILE* fp = fopen((std::string(TEST_ROOT) + "/p.log").c_str(), "wb");
+        fputs(std::string(299, 'o').c_str(), fp);
+        fputc('\n', fp);
+        fclose(fp);
+    }
+    SmallRing r;
+    r.begin(SD, "/p.log", "/p.1.log", 256, false);
+    TEST_ASSERT_EQUAL_UINT32(300, r.fileSize());
+    pushLine(r, "new\n");
+    r.flush();
+    TEST_ASSERT_EQUAL_UINT32(1, r.stats().rotations);
+    TEST_ASSERT_EQUAL_UINT32(300, readAll("/p.1.log").size());
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+void test_close_then_reopen_appends(void) {
+    SmallRing r;
+    r.begin(SD, "/p.log", "/p.1.log", 0, true);
+    pushLine(r, "before\n");
+    TEST_ASSERT_TRUE(r.close());
+    TEST_ASSERT_EQUAL_STRING("before\n", readAll("/p.log").c_str());
+    pushLine(r, "after\n");
+    r.flush();
+    TEST_ASSERT_EQUAL_STRING("before\nafter\n", readAll("/p.log").c_str());
+}
+
+void test_begin_fails_without_card(void) {
+    SmallRing r;
+    SD.setRoot("");  // No card
+    TEST_ASSERT_FALSE(r.begin(SD, "/p.log", "/p.1.log", 0, true));
+    TEST_ASSERT_FALSE(r.active());
+    TEST_ASSERT_FALSE(pushLine(r, "lost\n"));
+}
+
+void test_end_unhooks_ring_under_lock(void) {
+    LogRing<fs::FS, File, 512, TrackingLock> r;
+    r.begin(SD, "/p.log", "/p.1.log", 0, true);
+    r.push("queued\n", 7);
+    int before = TrackingLock::acquired;
+    r.end();
+    TEST_ASSERT_TRUE(TrackingLock::acquired > before);
+    TEST_ASSERT_FALSE(TrackingLock::held);
+    TEST_ASSERT_FALSE(r.active());
+    TEST_ASSERT_FALSE(r.push("late\n", 5));  // Another task's push after end()
+    TEST_ASSERT_EQUAL_UINT32(0, r.pending());
+}
+
+void test_missing_file_keeps_lines_queued(void) {
+    SmallRing r;
+    r.begin(SD, "/p.log", "/p.1.log", 0, true);
+    pushLine(r, "kept\n");
+    r.close();
+    pushLine(r, "also kept\n");
+    SD.setRoot("");  // Card pulled
+    r.flush();
+    TEST_ASSERT_EQUAL_UINT32(10, r.pending());
+    SD.setRoot(TEST_ROOT);
+    r.flush();
+    TEST_ASSERT_EQUAL_STRING("kept\nalso kept\n", readAll("/p.log").c_str());
+}
+
+// ============================================================================
+// I/O comparison (informational)
+// ============================================================================
+
+void test_io_vs_open_append_close(void) {
+    // A busy WARHOG scan: 300 SDLOG lines of ~60 bytes
+    const int lines = 300;
+    size_t oldOpens = 0;
+    for (int i = 0; i < lines; i++) {
+        File f = SD.open("/old.log", FILE_APPEND);
+        oldOpens++;
+        f.printf("[%d][WARHOG] New network %03d ch 6 rssi -71 auth WPA2\n", i, i);
+        f.close();
+    }
+
+    LogRing<fs::FS, File, 4096> r;
+    size_t opensBefore = SD.opens;
+    r.begin(SD, "/new.log", "/new.1.log", 0, true);
+    for (int i = 0; i < lines; i++) {
+        char line[80];
+        int n = snprintf(line, sizeof(line), "[%d][WARHOG] New network %03d ch 6 rssi -71 auth WPA2\n", i, i);
+        r.push(line, n);
+        r.update(i * 10, 1024, 2000);
+    }
+    r.flush();
+    size_t newOpens = SD.opens - opensBefore;
+    TEST_ASSERT_EQUAL_STRING(readAll("/old.log").c_str(), readAll("/new.log").c_str());
+    printf("[BENCH] %d log lines: open/append/close %zu opens, %zu writes; ring %zu open, %lu writes\n",
+           lines, oldOpens, oldOpens, newOpens, (unsigned long)r.stats().writes);
+    TEST_ASSERT_EQUAL(1, newOpens);
+    TEST_ASSERT_TRUE(r.stats().writes * 10 < oldOpens);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Queueing and drain policy
+    RUN_TEST(test_lines_wait_for_drain);
+    RUN_TEST(test_update_drains_by_bytes);
+    RUN_TEST(test_update_drains_by_age);
+    RUN_TEST(test_update_empty_is_noop);
+    RUN_TEST(test_wrapped_ring_drains_in_order);
+
+    // Drops
+    RUN_TEST(test_full_ring_drops_whole_lines);
+    RUN_TEST(test_drop_marker_precedes_next_line);
+    RUN_TEST(test_oversized_line_is_dropped);
+
+    // Rotation
+    RUN_TEST(test_rotates_at_line_boundary);
+    RUN_TEST(test_rotation_replaces_old_file);
+    RUN_TEST(test_append_mode_seeds_size);
+
+    // Lifecycle
+    RUN_TEST(test_close_then_reopen_appends);
+    RUN_TEST(test_begin_fails_without_card);
+    RUN_TEST(test_missing_file_keeps_lines_queued);
+    RUN_TEST(test_end_unhooks_ring_under_lock);
+
+    // I/O comparison
+    RUN_TEST(test_io_vs_open_append_close);
+
+    return UNITY_END();
+}
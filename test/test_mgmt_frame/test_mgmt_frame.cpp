@@ -0,0 +1,508 @@
+// Mgmt Frame Parser Tests
+// Tests the single-pass beacon / probe response view shared by OINK, DNH,
+// Spectrum and the feature extractor, plus a throughput comparison against
+// the separate per-field IE walks it replaced
+
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "../../src/core/mgmt_frame.h"
+
+void setUp(void) {
+    // No setup needed
+}
+
+void tearDown(void) {
+    // No teardown needed
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static const uint8_t TEST_BSSID[6] = {0xAC, 0x84, 0xC6, 0x11, 0x22, 0x33};
+
+// Builds a beacon one element at a time
+struct FrameBuilder {
+    std::vector<uint8_t> f;
+
+    explicit FrameBuilder(uint8_t fc = 0x80, uint16_t interval = 100, uint16_t cap = 0x0431) {
+        f.assign(MGMT_IE_OFFSET, 0);
+        f[0] = fc;
+        memset(&f[4], 0xFF, 6);          // DA broadcast
+        memcpy(&f[10], TEST_BSSID, 6);   // SA
+        memcpy(&f[16], TEST_BSSID, 6);   // BSSID
+        f[32] = interval & 0xFF; f[33] = interval >> 8;
+        f[34] = cap & 0xFF; f[35] = cap >> 8;
+    }
+
+    FrameBuilder& ie(uint8_t id, const std::vector<uint8_t>& body) {
+        f.push_back(id);
+        f.push_back((uint8_t)body.size());
+        f.insert(f.end(), body.begin(), body.end());
+        return *this;
+    }
+
+    FrameBuilder& ssid(const char* s) {
+        return ie(IE_SSID, std::vector<uint8_t>(s, s + strlen(s)));
+    }
+
+    const uint8_t* data() const { return f.data(); }
+    uint16_t size() const { return (uint16_t)f.size(); }
+};
+
+// RSN: version 1, CCMP group, 1 CCMP pairwise, 1 PSK/SAE AKM, capabilities
+static std::vector<uint8_t> rsnBody(uint16_t caps, uint8_t akmType = 2) {
+    return {0x01, 0x00,
+            0x00, 0x0F, 0xAC, 0x04,
+            0x01, 0x00, 0x00, 0x0F, 0xAC, 0x04,
+            0x01, 0x00, 0x00, 0x0F, 0xAC, akmType,
+            (uint8_t)(caps & 0xFF), (uint8_t)(caps >> 8)};
+}
+
+static std::vector<uint8_t> wpaBody() {
+    return {0x00, 0x50, 0xF2, 0x01, 0x01, 0x00, 0x00, 0x50, 0xF2, 0x02};
+}
+
+static std::vector<uint8_t> wpsBody() {
+    return {0x00, 0x50, 0xF2, 0x04, 0x10, 0x4A, 0x00, 0x01, 0x10};
+}
+
+// Typical WPA2 home router beacon
+static FrameBuilder typicalBeacon(const char* name, uint8_t channel, uint16_t rsnCaps = 0x000C) {
+    FrameBuilder b;
+    b.ssid(name)
+     .ie(IE_SUPPORTED_RATES, {0x82, 0x84, 0x8B, 0x96, 0x0C, 0x12, 0x18, 0x24})
+     .ie(IE_DS_PARAMS, {channel})
+     .ie(5, {0x00, 0x01, 0x00, 0x00})  // TIM
+     .ie(7, {'U', 'S', ' ', 0x01, 0x0B, 0x1E})  // Country
+     .ie(IE_HT_CAPS, std::vector<uint8_t>(26, 0x11))
+     .ie(IE_RSN, rsnBody(rsnCaps))
+     .ie(IE_EXT_RATES, {0x30, 0x48, 0x60, 0x6C})
+     .ie(61, std::vector<uint8_t>(22, 0x00))  // HT operation
+     .ie(IE_VENDOR, wpsBody())
+     .ie(IE_VENDOR, {0x00, 0x10, 0x18, 0x02, 0x00, 0x00, 0x1C, 0x00, 0x00});
+    return b;
+}
+
+// ============================================================================
+// Fixed fields
+// ============================================================================
+
+void test_parse_rejects_short_frame(void) {
+    FrameBuilder b;
+    MgmtFrameView v;
+    TEST_ASSERT_FALSE(v.parse(b.data(), MGMT_IE_OFFSET - 1));
+    TEST_ASSERT_FALSE(v.parse(nullptr, 100));
+}
+
+void test_parse_fixed_fields(void) {
+    FrameBuilder b(0x80, 102, 0x1411);
+    MgmtFrameView v;
+    TEST_ASSERT_TRUE(v.parse(b.data(), b.size()));
+    TEST_ASSERT_EQUAL_UINT8(MGMT_SUBTYPE_BEACON, v.subtype);
+    TEST_ASSERT_EQUAL_UINT16(102, v.beaconInterval);
+    TEST_ASSERT_EQUAL_HEX16(0x1411, v.capability);
+    TEST_ASSERT_EQUAL_MEMORY(TEST_BSSID, v.bssid(), 6);
+    TEST_ASSERT_FALSE(v.hasSSIDElement);
+    TEST_ASSERT_FALSE(v.truncated);
+}
+
+void test_parse_tsf_little_endian(void) {
+    FrameBuilder b;
+    const uint8_t tsf[8] = {0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x81};
+    memcpy(&b.f[MGMT_HDR_LEN], tsf, 8);
+    MgmtFrameView v;
+    TEST_ASSERT_TRUE(v.parse(b.data(), b.size()));
+    TEST_ASSERT_TRUE(v.tsf == 0x8102030405060708ULL);
+    TEST_ASSERT_EQUAL_UINT16(100, v.beaconInterval);  // Fixed fields after it unaffected
+}
+
+void test_parse_probe_response_subtype(void) {
+    FrameBuilder b(0x50);
+    b.ssid("probe");
+    MgmtFrameView v;
+    TEST_ASSERT_TRUE(v.parse(b.data(), b.size()));
+    TEST_ASSERT_EQUAL_UINT8(MGMT_SUBTYPE_PROBE_RESP, v.subtype);
+}
+
+// ============================================================================
+// SSID
+// ============================================================================
+
+void test_ssid_points_into_frame(void) {
+    FrameBuilder b = typicalBeacon("PorkNet", 6);
+    MgmtFrameView v;
+    v.parse(b.data(), b.size());
+    TEST_ASSERT_TRUE(v.hasSSIDElement);
+    TEST_ASSERT_EQUAL_UINT8(7, v.ssidLen);
+    TEST_ASSERT_TRUE(v.ssid == b.data() + MGMT_IE_OFFSET + 2);  // Zero-copy
+
+    char out[33];
+    TEST_ASSERT_TRUE(v.copySSID(out));
+    TEST_ASSERT_EQUAL_STRING("PorkNet", out);
+    TEST_ASSERT_FALSE(v.isHidden());
+}
+
+void test_ssid_max_length(void) {
+    const char* name = "0123456789abcdef0123456789ABCDEF";  // 32 bytes
+    FrameBuilder b;
+    b.ssid(name);
+    MgmtFrameView v;
+    v.parse(b.data(), b.size());
+    char out[33];
+    TEST_ASSERT_TRUE(v.copySSID(out));
+    TEST_ASSERT_EQUAL_STRING(name, out);
+}
+
+void test_ssid_zero_length_is_hidden(void) {
+    FrameBuilder b;
+    b.ie(IE_SSID, {});
+    MgmtFrameView v;
+    v.parse(b.data(), b.size());
+    TEST_ASSERT_TRUE(v.isHidden());
+    char out[33] = "junk";
+    TEST_ASSERT_FALSE(v.copySSID(out));
+    TEST_ASSERT_EQUAL_STRING("", out);
+}
+
+void test_ssid_all_nul_is_hidden(void) {
+    FrameBuilder b;
+    b.ie(IE_SSID, std::vector<uint8_t>(8, 0));
+    MgmtFrameView v;
+    v.parse(b.data(), b.size());
+    TEST_ASSERT_TRUE(v.isHidden());
+    char out[33] = "junk";
+    TEST_ASSERT_FALSE(v.copySSID(out));  // Not a name: probe responses mustn't "reveal" it
+    TEST_ASSERT_EQUAL_STRING("", out);
+}
+
+void test_ssid_missing_is_not_hidden(void) {
+    FrameBuilder b;
+    b.ie(IE_DS_PARAMS, {11});
+    MgmtFrameView v;
+    v.parse(b.data(), b.size());
+    TEST_ASSERT_FALSE(v.hasSSIDElement);
+    TEST_ASSERT_FALSE(v.isHidden());
+    char out[33];
+    TEST_ASSERT_FALSE(v.copySSID(out));
+}
+
+void test_ssid_oversized_rejected(void) {
+    FrameBuilder b;
+    b.ie(IE_SSID, std::vector<uint8_t>(40, 'A'));
+    MgmtFrameView v;
+    v.parse(b.data(), b.size());
+    TEST_ASSERT_EQUAL_UINT8(40, v.ssidLen);
+    char out[33];
+    TEST_ASSERT_FALSE(v.copySSID(out));
+    TEST_ASSERT_FALSE(v.isHidden());
+}
+
+void test_ssid_first_element_wins(void) {
+    FrameBuilder b;
+    b.ssid("first").ssid("second");
+    MgmtFrameView v;
+    v.parse(b.data(), b.size());
+    char out[33];
+    v.copySSID(out);
+    TEST_ASSERT_EQUAL_STRING("first", out);
+}
+
+// ============================================================================
+// DS / rates / HT / VHT / vendor
+// ============================================================================
+
+void test_ds_channel(void) {
+    FrameBuilder b = typicalBeacon("x", 11);
+    MgmtFrameView v;
+    v.parse(b.data(), b.size());
+    TEST_ASSERT_EQUAL_UINT8(11, v.dsChannel);
+}
+
+void test_ds_missing_is_zero(void) {
+    FrameBuilder b;
+    b.ssid("x").ie(IE_DS_PARAMS, {});
+    MgmtFrameView v;
+    v.parse(b.data(), b.size());
+    TEST_ASSERT_EQUAL_UINT8(0, v.dsChannel);
+}
+
+void test_rates_ht_vht_vendor(void) {
+    FrameBuilder b = typicalBeacon("x", 1);
+    b.ie(IE_VHT_CAPS, std::vector<uint8_t>(12, 0));
+    MgmtFrameView v;
+    v.parse(b.data(), b.size());
+    TEST_ASSERT_EQUAL_UINT8(12, v.supportedRates);  // 8 + 4 extended
+    TEST_ASSERT_TRUE(v.hasHT);
+    TEST_ASSERT_TRUE(v.hasVHT);
+    TEST_ASSERT_EQUAL_UINT8(2, v.vendorIECount);
+    TEST_ASSERT_TRUE(v.hasWPS());
+    TEST_ASSERT_FALSE(v.hasWPA());
+}
+
+// ============================================================================
+// RSN / WPA / PMF
+// ============================================================================
+
+void test_rsn_pmf_optional(void) {
+    FrameBuilder b = typicalBeacon("x", 6, RSN_CAP_MFPC | 0x000C);
+    MgmtFrameView v;
+    v.parse(b.data(), b.size());
+    TEST_ASSERT_TRUE(v.hasRSN());
+    TEST_ASSERT_EQUAL_UINT8(IE_RSN, b.data()[v.rsnOffset]);
+    TEST_ASSERT_TRUE(v.pmfCapable);
+    TEST_ASSERT_FALSE(v.pmfRequired);
+}
+
+void test_rsn_pmf_required(void) {
+    FrameBuilder b = typicalBeacon("x", 6, RSN_CAP_MFPC | RSN_CAP_MFPR);
+    MgmtFrameView v;
+    v.parse(b.data(), b.size());
+    TEST_ASSERT_TRUE(v.pmfCapable);
+    TEST_ASSERT_TRUE(v.pmfRequired);
+}
+
+void test_rsn_without_capabilities(void) {
+    // Legal RSN element that stops after the AKM list
+    std::vector<uint8_t> body = rsnBody(0);
+    body.resize(body.size() - 2);
+    FrameBuilder b;
+    b.ssid("x").ie(IE_RSN, body);
+    MgmtFrameView v;
+    v.parse(b.data(), b.size());
+    TEST_ASSERT_TRUE(v.hasRSN());
+    TEST_ASSERT_EQUAL_HEX16(0, v.rsnCaps);
+    TEST_ASSERT_FALSE(v.pmfRequired);
+}
+
+void test_rsn_bogus_suite_count(void) {
+    // Pairwise count claims 0xFFFF suites; must not read past the element
+    std::vector<uint8_t> body = rsnBody(RSN_CAP_MFPR);
+    body[6] = 0xFF; body[7] = 0xFF;
+    FrameBuilder b;
+    b.ssid("x").ie(IE_RSN, body).ie(IE_DS_PARAMS, {3});
+    MgmtFrameView v;
+    v.parse(b.data(), b.size());
+    TEST_ASSERT_TRUE(v.hasRSN());
+    TEST_ASSERT_FALSE(v.pmfRequired);
+    TEST_ASSERT_EQUAL_UINT8(3, v.dsChannel);  // Walk continued past it
+}
+
+void test_wpa_vendor_element(void) {
+    FrameBuilder b;
+    b.ssid("legacy").ie(IE_VENDOR, wpaBody());
+    MgmtFrameView v;
+    v.parse(b.data(), b.size());
+    TEST_ASSERT_TRUE(v.hasWPA());
+    TEST_ASSERT_FALSE(v.hasRSN());
+    TEST_ASSERT_FALSE(v.hasWPS());
+    TEST_ASSERT_EQUAL_UINT8(IE_VENDOR, b.data()[v.wpaOffset]);
+}
+
+void test_short_vendor_element_ignored(void) {
+    FrameBuilder b;
+    b.ssid("x").ie(IE_VENDOR, {0x00, 0x50, 0xF2});
+    MgmtFrameView v;
+    v.parse(b.data(), b.size());
+    TEST_ASSERT_FALSE(v.hasWPA());
+    TEST_ASSERT_FALSE(v.hasWPS());
+    TEST_ASSERT_EQUAL_UINT8(1, v.vendorIECount);
+}
+
+// ============================================================================
+// Malformed frames
+// ============================================================================
+
+void test_truncated_element_stops_walk(void) {
+    FrameBuilder b;
+    b.ssid("ok").ie(IE_DS_PARAMS, {6});
+    b.f.push_back(IE_RSN);
+    b.f.push_back(40);              // Claims 40 bytes...
+    b.f.insert(b.f.end(), 5, 0x01); // ...only 5 present
+    MgmtFrameView v;
+    TEST_ASSERT_TRUE(v.parse(b.data(), b.size()));
+    TEST_ASSERT_TRUE(v.truncated);
+    TEST_ASSERT_FALSE(v.hasRSN());
+    TEST_ASSERT_EQUAL_UINT8(6, v.dsChannel);  // Earlier elements kept
+    char out[33];
+    TEST_ASSERT_TRUE(v.copySSID(out));
+    TEST_ASSERT_EQUAL_STRING("ok", out);
+}
+
+void test_trailing_byte_ignored(void) {
+    FrameBuilder b;
+    b.ssid("ok");
+    b.f.push_back(IE_DS_PARAMS);  // Lone element id, no length byte
+    MgmtFrameView v;
+    TEST_ASSERT_TRUE(v.parse(b.data(), b.size()));
+    TEST_ASSERT_FALSE(v.truncated);
+    TEST_ASSERT_EQUAL_UINT8(0, v.dsChannel);
+}
+
+void test_reparse_resets_view(void) {
+    FrameBuilder a = typicalBeacon("first", 1, RSN_CAP_MFPR);
+    FrameBuilder b;
+    b.ssid("second");
+    MgmtFrameView v;
+    v.parse(a.data(), a.size());
+    v.parse(b.data(), b.size());
+    TEST_ASSERT_FALSE(v.hasRSN());
+    TEST_ASSERT_FALSE(v.pmfRequired);
+    TEST_ASSERT_FALSE(v.hasWPS());
+    TEST_ASSERT_EQUAL_UINT8(0, v.dsChannel);
+}
+
+// ============================================================================
+// Throughput vs legacy multi-pass parsing (informational; asserts agreement)
+// ============================================================================
+
+// What a beacon used to cost in OINK: SSID walk, DS walk, auth walk, PMF walk
+// and the feature extractor's own walk - five passes over the same IEs
+struct LegacyResult {
+    char ssid[33];
+    uint8_t channel;
+    bool rsn, wpa, wps, pmf;
+};
+
+static void legacyParse(const uint8_t* p, uint16_t len, LegacyResult& r) {
+    memset(&r, 0, sizeof(r));
+    uint16_t off;
+    for (off = 36; off + 2 < len; off += 2 + p[off + 1]) {
+        if (off + 2 + p[off + 1] > len) break;
+        if (p[off] == 0 && p[off + 1] <= 32) {
+            memcpy(r.ssid, p + off + 2, p[off + 1]);
+            r.ssid[p[off + 1]] = 0;
+            break;
+        }
+    }
+    for (off = 36; off + 2 < len; off += 2 + p[off + 1]) {
+        if (off + 2 + p[off + 1] > len) break;
+        if (p[off] == 3 && p[off + 1] == 1) { r.channel = p[off + 2]; break; }
+    }
+    for (off = 36; off + 2 < len; off += 2 + p[off + 1]) {
+        if (off + 2 + p[off + 1] > len) break;
+        if (p[off] == 48) r.rsn = true;
+        if (p[off] == 221 && p[off + 1] >= 8 && p[off + 2] == 0x00 && p[off + 3] == 0x50 &&
+            p[off + 4] == 0xF2 && p[off + 5] == 0x01) r.wpa = true;
+    }
+    for (off = 36; off + 2 < len; off += 2 + p[off + 1]) {
+        if (off + 2 + p[off + 1] > len) break;
+        if (p[off] == 48 && p[off + 1] >= 8) {
+            uint16_t pos = off + 2 + 6, end = off + 2 + p[off + 1];
+            if (pos + 2 > end) break;
+            pos += 2 + (p[pos] | (p[pos + 1] << 8)) * 4;
+            if (pos + 2 > end) break;
+            pos += 2 + (p[pos] | (p[pos + 1] << 8)) * 4;
+            if (pos + 2 > end) break;
+            r.pmf = ((p[pos] | (p[pos + 1] << 8)) & RSN_CAP_MFPR) != 0;
+        }
+    }
+    for (off = 36; off + 2 < len; off += 2 + p[off + 1]) {
+        if (off + 2 + p[off + 1] > len) break;
+        if (p[off] == 221 && p[off + 1] >= 4 && p[off + 2] == 0x00 && p[off + 3] == 0x50 &&
+            p[off + 4] == 0xF2 && p[off + 5] == 0x04) r.wps = true;
+    }
+}
+
+void test_benchmark_single_pass_vs_legacy(void) {
+    // Corpus: the beacon shapes seen in a typical urban scan
+    std::vector<FrameBuilder> corpus;
+    char name[33];
+    for (int i = 0; i < 64; i++) {
+        snprintf(name, sizeof(name), "NET-%02d-%s", i, (i % 3) ? "home" : "office-5G");
+        uint16_t caps = (i % 5 == 0) ? (RSN_CAP_MFPC | RSN_CAP_MFPR) : 0x000C;
+        FrameBuilder b = typicalBeacon(name, (uint8_t)(1 + i % 13), caps);
+        if (i % 7 == 0) b.ie(IE_VENDOR, wpaBody());
+        if (i % 4 == 0) b.ie(IE_VHT_CAPS, std::vector<uint8_t>(12, 0));
+        corpus.push_back(b);
+    }
+
+    // Results must agree frame for frame
+    for (const FrameBuilder& b : corpus) {
+        LegacyResult lr;
+        legacyParse(b.data(), b.size(), lr);
+        MgmtFrameView v;
+        v.parse(b.data(), b.size());
+        char ssid[33];
+        v.copySSID(ssid);
+        TEST_ASSERT_EQUAL_STRING(lr.ssid, ssid);
+        TEST_ASSERT_EQUAL_UINT8(lr.channel, v.dsChannel);
+        TEST_ASSERT_EQUAL(lr.rsn, v.hasRSN());
+        TEST_ASSERT_EQUAL(lr.wpa, v.hasWPA());
+        TEST_ASSERT_EQUAL(lr.wps, v.hasWPS());
+        TEST_ASSERT_EQUAL(lr.pmf, v.pmfRequired);
+    }
+
+    const int rounds = 20000;
+    uint32_t legacySum = 0, viewSum = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (const FrameBuilder& b : corpus) {
+            LegacyResult lr;
+            legacyParse(b.data(), b.size(), lr);
+            legacySum += lr.channel + lr.pmf + lr.wps;
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (const FrameBuilder& b : corpus) {
+            MgmtFrameView v;
+            v.parse(b.data(), b.size());
+            viewSum += v.dsChannel + v.pmfRequired + v.hasWPS();
+        }
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    TEST_ASSERT_EQUAL_UINT32(legacySum, viewSum);
+
+    double frames = (double)rounds * corpus.size();
+    double legacyNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / frames;
+    double viewNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / frames;
+    printf("[BENCH] %zu-byte beacons: legacy 5-pass %6.1f ns/frame, single pass %6.1f ns/frame (%.1fx)\n",
+           corpus[0].f.size(), legacyNs, viewNs, viewNs > 0 ? legacyNs / viewNs : 0.0);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Fixed fields
+    RUN_TEST(test_parse_rejects_short_frame);
+    RUN_TEST(test_parse_fixed_fields);
+    RUN_TEST(test_parse_tsf_little_endian);
+    RUN_TEST(test_parse_probe_response_subtype);
+
+    // SSID
+    RUN_TEST(test_ssid_points_into_frame);
+    RUN_TEST(test_ssid_max_length);
+    RUN_TEST(test_ssid_zero_length_is_hidden);
+    RUN_TEST(test_ssid_all_nul_is_hidden);
+    RUN_TEST(test_ssid_missing_is_not_hidden);
+    RUN_TEST(test_ssid_oversized_rejected);
+    RUN_TEST(test_ssid_first_element_wins);
+
+    // DS / rates / HT / VHT / vendor
+    RUN_TEST(test_ds_channel);
+    RUN_TEST(test_ds_missing_is_zero);
+    RUN_TEST(test_rates_ht_vht_vendor);
+
+    // RSN / WPA / PMF
+    RUN_TEST(test_rsn_pmf_optional);
+    RUN_TEST(test_rsn_pmf_required);
+    RUN_TEST(test_rsn_without_capabilities);
+    RUN_TEST(test_rsn_bogus_suite_count);
+    RUN_TEST(test_wpa_vendor_element);
+    RUN_TEST(test_short_vendor_element_ignored);
+
+    // Malformed frames
+    RUN_TEST(test_truncated_element_stops_walk);
+    RUN_TEST(test_trailing_byte_ignored);
+    RUN_TEST(test_reparse_resets_view);
+
+    // Benchmark
+    RUN_TEST(test_benchmark_single_pass_vs_legacy);
+
+    return UNITY_END();
+}
@@ -0,0 +1,339 @@
+// OUI Tests
+// Tests the vendor lookup: the perfect-hash index over the built-in table
+// (every entry found, no false hits across the whole 24-bit space, stable
+// name pointers) and the SD vendor database against the host-backed SD
+// mock (format checks, fence/binary search, block cache, no SD handle
+// held between lookups), plus lookup rates against the old linear scan
+
+#include <unity.h>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "../../src/core/oui_table.h"
+#include "../../src/core/oui_registry.h"
+#include "../mocks/mock_fs.h"
+
+static const char* TEST_ROOT = "/tmp/porkchop_test_oui";
+
+typedef OuiRegistry<fs::FS, File> Registry;
+
+void setUp(void) {
+    std::string cmd = std::string("rm -rf ") + TEST_ROOT + " && mkdir -p " + TEST_ROOT;
+    system(cmd.c_str());
+    SD.setRoot(TEST_ROOT);
+    SD.opens = 0;
+}
+
+void tearDown(void) {
+    // No teardown needed
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// The pre-index lookup: linear scan, copy into a shared buffer
+static const char* linearVendor(const uint8_t* mac) {
+    static char vendorBuf[10];
+    for (size_t i = 0; i < OUI_TABLE_SIZE; i++) {
+        if (mac[0] == OUI_TABLE[i].oui[0] &&
+            mac[1] == OUI_TABLE[i].oui[1] &&
+            mac[2] == OUI_TABLE[i].oui[2]) {
+            strncpy(vendorBuf, OUI_TABLE[i].vendor, sizeof(vendorBuf) - 1);
+            vendorBuf[sizeof(vendorBuf) - 1] = '\0';
+            return vendorBuf;
+        }
+    }
+    return nullptr;
+}
+
+static void macFor(uint32_t prefix, uint8_t* mac) {
+    mac[0] = prefix >> 16;
+    mac[1] = prefix >> 8;
+    mac[2] = prefix;
+    mac[3] = 0x12;
+    mac[4] = 0x34;
+    mac[5] = 0x56;
+}
+
+// Synthetic registry: every 5th prefix from 0x000100, "Vendor <n>"
+static uint32_t regPrefix(uint32_t i) { return 0x000100 + i * 5; }
+
+static std::string regName(uint32_t i) {
+    char name[40];
+    snprintf(name, sizeof(name), "Vendor %u", (unsigned)i);
+    return name;
+}
+
+static void put32(std::string& s, uint32_t v) {
+    for (int i = 0; i < 4; i++) s += (char)(v >> (i * 8));
+}
+
+// Same layout as scripts/build_oui_registry.py
+static std::string buildRegistry(uint32_t count, uint32_t maxFences = 256) {
+    uint32_t stride = (count + maxFences - 1) / maxFences;
+    uint32_t fences = (count + stride - 1) / stride;
+    std::string s = "OUIR";
+    s += (char)1;
+    s += (char)32;
+    s += (char)(fences & 0xFF);
+    s += (char)(fences >> 8);
+    put32(s, count);
+    put32(s, stride);
+    for (uint32_t f = 0; f < fences; f++) put32(s, regPrefix(f * stride));
+    s.resize((s.size() + 511) / 512 * 512, '\0');
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t p = regPrefix(i);
+        s += (char)(p >> 16);
+        s += (char)(p >> 8);
+        s += (char)p;
+        std::string name = regName(i).substr(0, 28);
+        name.resize(29, '\0');
+        s += name;
+    }
+    return s;
+}
+
+static void writeHost(const char* path, const std::string& data) {
+    FILE* fp = fopen((std::string(TEST_ROOT) + path).c_str(), "wb");
+    fwrite(data.data(), 1, data.size(), fp);
+    fclose(fp);
+}
+
+// ============================================================================
+// Built-in table
+// ============================================================================
+
+void test_every_entry_found_at_its_index(void) {
+    TEST_ASSERT_TRUE(OuiTable::indexed(0, OUI_TABLE_SIZE));
+    for (size_t i = 0; i < OUI_TABLE_SIZE; i++) {
+        TEST_ASSERT_EQUAL_UINT32(i, OuiTable::find(OuiTable::keyAt(i)));
+        uint8_t mac[6];
+        macFor(OuiTable::keyAt(i), mac);
+        TEST_ASSERT_EQUAL_STRING(OUI_TABLE[i].vendor, OuiTable::vendor(mac));
+    }
+}
+
+void test_known_vendors(void) {
+    const uint8_t apple[6] = {0x00, 0x03, 0x93, 0x01, 0x02, 0x03};
+    const uint8_t esp[6] = {0x24, 0x0A, 0xC4, 0x00, 0x00, 0x01};
+    const uint8_t intel[6] = {0x00, 0x16, 0xEA, 0xAA, 0xBB, 0xCC};
+    const uint8_t netgear[6] = {0x6C, 0xB0, 0xCE, 0x11, 0x22, 0x33};
+    TEST_ASSERT_EQUAL_STRING("Apple", OuiTable::vendor(apple));
+    TEST_ASSERT_EQUAL_STRING(linearVendor(esp), OuiTable::vendor(esp));
+    TEST_ASSERT_EQUAL_STRING("Intel", OuiTable::vendor(intel));
+    TEST_ASSERT_EQUAL_STRING("Netgear", OuiTable::vendor(netgear));
+}
+
+void test_no_false_hits_in_whole_prefix_space(void) {
+    uint32_t found = 0;
+    for (uint32_t k = 0; k < (1u << 24); k++) {
+        uint16_t i = OuiTable::find(k);
+        if (i == OuiTable::NONE) continue;
+        TEST_ASSERT_EQUAL_UINT32(k, OuiTable::keyAt(i));
+        found++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(OUI_TABLE_SIZE, found);
+}
+
+void test_names_are_stable_pointers(void) {
+    // Spectrum keeps the pointer per client: a second lookup mustn't
+    // rewrite the first one's name
+    const uint8_t apple[6] = {0x00, 0x03, 0x93, 0, 0, 1};
+    const uint8_t intel[6] = {0x00, 0x16, 0xEA, 0, 0, 2};
+    const char* a = OuiTable::vendor(apple);
+    const char* b = OuiTable::vendor(intel);
+    TEST_ASSERT_EQUAL_STRING("Apple", a);
+    TEST_ASSERT_EQUAL_STRING("Intel", b);
+    TEST_ASSERT_TRUE(a == OuiTable::vendor(apple));
+}
+
+// ============================================================================
+// SD vendor database
+// ============================================================================
+
+void test_registry_finds_every_prefix(void) {
+    const uint32_t N = 20000;
+    writeHost("/oui.bin", buildRegistry(N));
+    Registry reg;
+    TEST_ASSERT_TRUE(reg.open(SD, "/oui.bin"));
+    TEST_ASSERT_EQUAL_UINT32(N, reg.count());
+
+    char name[Registry::NAME_LEN + 1];
+    for (uint32_t i = 0; i < N; i += 13) {
+        TEST_ASSERT_TRUE(reg.lookup(regPrefix(i), name, sizeof(name)));
+        TEST_ASSERT_EQUAL_STRING(regName(i).c_str(), name);
+    }
+    // First, last, and the gaps around them
+    TEST_ASSERT_TRUE(reg.lookup(regPrefix(0), name, sizeof(name)));
+    TEST_ASSERT_TRUE(reg.lookup(regPrefix(N - 1), name, sizeof(name)));
+    TEST_ASSERT_FALSE(reg.lookup(0x000000, name, sizeof(name)));
+    TEST_ASSERT_FALSE(reg.lookup(regPrefix(0) + 1, name, sizeof(name)));
+    TEST_ASSERT_FALSE(reg.lookup(regPrefix(N - 1) + 1, name, sizeof(name)));
+    TEST_ASSERT_FALSE(reg.lookup(0xFFFFFF, name, sizeof(name)));
+}
+
+void test_registry_truncates_to_buffer(void) {
+    writeHost("/oui.bin", buildRegistry(100));
+    Registry reg;
+    TEST_ASSERT_TRUE(reg.open(SD, "/oui.bin"));
+    char small[5];
+    TEST_ASSERT_TRUE(reg.lookup(regPrefix(42), small, sizeof(small)));
+    TEST_ASSERT_EQUAL_STRING("Vend", small);
+}
+
+void test_registry_rejects_bad_files(void) {
+    Registry reg;
+    TEST_ASSERT_FALSE(reg.open(SD, "/missing.bin"));
+
+    std::string good = buildRegistry(1000);
+    std::string bad = good;
+    bad[0] = 'X';
+    writeHost("/magic.bin", bad);
+    TEST_ASSERT_FALSE(reg.open(SD, "/magic.bin"));
+
+    bad = good;
+    bad[5] = 16;  // Record size
+    writeHost("/rec.bin", bad);
+    TEST_ASSERT_FALSE(reg.open(SD, "/rec.bin"));
+
+    writeHost("/short.bin", good.substr(0, good.size() - 1));
+    TEST_ASSERT_FALSE(reg.open(SD, "/short.bin"));
+
+    writeHost("/fences.bin", buildRegistry(1000, 1024));  // More than MAX_FENCES
+    TEST_ASSERT_FALSE(reg.open(SD, "/fences.bin"));
+    TEST_ASSERT_FALSE(reg.isOpen());
+
+    char name[8];
+    TEST_ASSERT_FALSE(reg.lookup(regPrefix(1), name, sizeof(name)));
+
+    writeHost("/good.bin", good);
+    TEST_ASSERT_TRUE(reg.open(SD, "/good.bin"));
+    reg.close();
+    TEST_ASSERT_FALSE(reg.lookup(regPrefix(1), name, sizeof(name)));
+}
+
+void test_registry_reads_are_bounded_and_cached(void) {
+    const uint32_t N = 38000;  // About the IEEE MA-L registry
+    writeHost("/oui.bin", buildRegistry(N));
+    Registry reg;
+    TEST_ASSERT_TRUE(reg.open(SD, "/oui.bin"));
+
+    // Span of ~149 records = 10 blocks: at most 5 block reads per lookup
+    char name[Registry::NAME_LEN + 1];
+    uint32_t worst = 0;
+    for (uint32_t i = 0; i < N; i += 97) {
+        uint32_t before = reg.stats().reads;
+        reg.lookup(regPrefix(i) + (i & 1), name, sizeof(name));  // Hits and misses
+        uint32_t cost = reg.stats().reads - before;
+        if (cost > worst) worst = cost;
+    }
+    TEST_ASSERT_TRUE(worst <= 5);
+
+    // The same prefix again is all cache
+    reg.lookup(regPrefix(1234), name, sizeof(name));
+    uint32_t before = reg.stats().reads;
+    TEST_ASSERT_TRUE(reg.lookup(regPrefix(1234), name, sizeof(name)));
+    TEST_ASSERT_EQUAL_UINT32(before, reg.stats().reads);
+}
+
+void test_registry_holds_no_handle_between_lookups(void) {
+    writeHost("/oui.bin", buildRegistry(2000));
+    Registry reg;
+    int idle = SD.openHandles();
+    TEST_ASSERT_TRUE(reg.open(SD, "/oui.bin"));
+    TEST_ASSERT_EQUAL_INT(idle, SD.openHandles());
+
+    char name[Registry::NAME_LEN + 1];
+    size_t opensBefore = SD.opens;
+    TEST_ASSERT_TRUE(reg.lookup(regPrefix(1500), name, sizeof(name)));
+    TEST_ASSERT_EQUAL_INT(idle, SD.openHandles());
+    TEST_ASSERT_EQUAL(1, SD.opens - opensBefore);  // One open for all the block misses
+
+    opensBefore = SD.opens;
+    TEST_ASSERT_TRUE(reg.lookup(regPrefix(1500), name, sizeof(name)));
+    TEST_ASSERT_EQUAL(0, SD.opens - opensBefore);  // Cached: no open at all
+}
+
+// ============================================================================
+// Micro-benchmark (informational; asserts only that results agree)
+// ============================================================================
+
+void test_benchmark_lookups_per_second(void) {
+    // Client mix: half known prefixes, half not
+    std::vector<std::array<uint8_t, 6>> queries(4096);
+    for (size_t q = 0; q < queries.size(); q++) {
+        uint32_t prefix = (q & 1) ? OuiTable::keyAt((q * 7919) % OUI_TABLE_SIZE)
+                                  : (uint32_t)((q * 2654435761u) & 0xFCFFFF);
+        macFor(prefix, queries[q].data());
+    }
+
+    const int rounds = 100;
+    size_t linearSum = 0, indexSum = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (auto& q : queries) {
+            const char* v = linearVendor(q.data());
+            linearSum += v ? (uint8_t)v[0] : 0;
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (auto& q : queries) {
+            const char* v = OuiTable::vendor(q.data());
+            indexSum += v ? (uint8_t)v[0] : 0;
+        }
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    TEST_ASSERT_TRUE(linearSum == indexSum);
+
+    double lookups = (double)rounds * queries.size();
+    double linearS = std::chrono::duration<double>(t1 - t0).count();
+    double indexS = std::chrono::duration<double>(t2 - t1).count();
+    printf("[BENCH] %u prefixes: linear scan %.2fM lookups/s, perfect hash %.1fM lookups/s (%.0fx)\n",
+           (unsigned)OUI_TABLE_SIZE, lookups / linearS / 1e6, lookups / indexS / 1e6,
+           indexS > 0 ? linearS / indexS : 0.0);
+
+    // SD database through the mock: card reads per lookup matter on device
+    const uint32_t N = 38000;
+    writeHost("/oui.bin", buildRegistry(N));
+    Registry reg;
+    TEST_ASSERT_TRUE(reg.open(SD, "/oui.bin"));
+    char name[Registry::NAME_LEN + 1];
+    const uint32_t regLookups = 5000;
+    auto t3 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < regLookups; i++) {
+        reg.lookup(regPrefix((i * 7919) % N), name, sizeof(name));
+    }
+    auto t4 = std::chrono::steady_clock::now();
+    OuiRegistryStats st = reg.stats();
+    TEST_ASSERT_EQUAL_UINT32(regLookups, st.hits);
+    printf("[BENCH] %u-prefix SD database: %.0fK lookups/s, %.2f block reads/lookup, "
+           "%u bytes of fences in RAM\n",
+           (unsigned)N, regLookups / std::chrono::duration<double>(t4 - t3).count() / 1e3,
+           (double)st.reads / regLookups, (unsigned)(((N + 148) / 149) * 4));
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Built-in table
+    RUN_TEST(test_every_entry_found_at_its_index);
+    RUN_TEST(test_known_vendors);
+    RUN_TEST(test_no_false_hits_in_whole_prefix_space);
+    RUN_TEST(test_names_are_stable_pointers);
+
+    // SD vendor database
+    RUN_TEST(test_registry_finds_every_prefix);
+    RUN_TEST(test_registry_truncates_to_buffer);
+    RUN_TEST(test_registry_rejects_bad_files);
+    RUN_TEST(test_registry_reads_are_bounded_and_cached);
+    RUN_TEST(test_registry_holds_no_handle_between_lookups);
+
+    // Micro-benchmark
+    RUN_TEST(test_benchmark_lookups_per_second);
+
+    return UNITY_END();
+}
@@ -0,0 +1,333 @@
+// PCAPNG Writer Tests
+// Tests the OINK session capture writer: section / interface / enhanced
+// packet block layout, double-buffered write-behind in whole SD-sector
+// blocks, drops while both buffers wait, and the write count against one
+// open/write/close per captured frame
+
+#include <unity.h>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "../../src/core/pcapng_writer.h"
+
+void setUp(void) {
+    // No setup needed
+}
+
+void tearDown(void) {
+    // No teardown needed
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// Collects everything written; records each write() size
+struct MemSink {
+    std::vector<uint8_t> data;
+    std::vector<size_t> writes;
+    size_t failAfter = (size_t)-1;  // Bytes accepted before writes come up short
+
+    size_t write(const uint8_t* buf, size_t len) {
+        writes.push_back(len);
+        size_t n = len;
+        if (data.size() + n > failAfter) n = failAfter > data.size() ? failAfter - data.size() : 0;
+        data.insert(data.end(), buf, buf + n);
+        return n;
+    }
+};
+
+static uint32_t rd32(const std::vector<uint8_t>& d, size_t off) {
+    uint32_t v;
+    memcpy(&v, &d[off], 4);
+    return v;
+}
+
+static uint16_t rd16(const std::vector<uint8_t>& d, size_t off) {
+    uint16_t v;
+    memcpy(&v, &d[off], 2);
+    return v;
+}
+
+static std::vector<uint8_t> makeFrame(uint16_t len, uint8_t tag) {
+    std::vector<uint8_t> f(len, tag);
+    f[0] = 0x80;
+    f[1] = 0x00;
+    return f;
+}
+
+struct Block {
+    uint32_t type;
+    size_t off;
+    uint32_t len;
+};
+
+// Walk the file block by block; fails the test on a malformed block
+static void parseBlocks(const std::vector<uint8_t>& d, std::vector<Block>& blocks) {
+    blocks.clear();
+    size_t off = 0;
+    while (off + 12 <= d.size()) {
+        Block b = {rd32(d, off), off, rd32(d, off + 4)};
+        TEST_ASSERT_EQUAL_UINT32(0, b.len % 4);
+        TEST_ASSERT_TRUE(off + b.len <= d.size());
+        TEST_ASSERT_EQUAL_UINT32(b.len, rd32(d, off + b.len - 4));
+        blocks.push_back(b);
+        off += b.len;
+    }
+    TEST_ASSERT_EQUAL_UINT32(d.size(), off);
+}
+
+// ============================================================================
+// Block layout
+// ============================================================================
+
+void test_begin_writes_section_and_interface(void) {
+    PcapngWriter<4096> w;
+    MemSink sink;
+    TEST_ASSERT_TRUE(w.begin("M5PORKCHOP"));
+    w.finish(sink);
+
+    std::vector<Block> blocks;
+    parseBlocks(sink.data, blocks);
+    TEST_ASSERT_EQUAL(2, blocks.size());
+    TEST_ASSERT_EQUAL_HEX32(0x0A0D0D0A, blocks[0].type);
+    TEST_ASSERT_EQUAL_HEX32(0x1A2B3C4D, rd32(sink.data, 8));
+    TEST_ASSERT_EQUAL_UINT16(1, rd16(sink.data, 12));
+    TEST_ASSERT_EQUAL_UINT16(4, rd16(sink.data, 24));   // shb_userappl
+    TEST_ASSERT_EQUAL_UINT16(10, rd16(sink.data, 26));
+    TEST_ASSERT_EQUAL_MEMORY("M5PORKCHOP", &sink.data[28], 10);
+
+    size_t idb = blocks[1].off;
+    TEST_ASSERT_EQUAL_UINT32(1, blocks[1].type);
+    TEST_ASSERT_EQUAL_UINT16(127, rd16(sink.data, idb + 8));
+    TEST_ASSERT_EQUAL_UINT16(9, rd16(sink.data, idb + 16));  // if_tsresol
+    TEST_ASSERT_EQUAL_UINT8(6, sink.data[idb + 20]);
+}
+
+void test_packet_block_carries_frame_and_timestamp(void) {
+    PcapngWriter<4096> w;
+    MemSink sink;
+    w.begin("x");
+    auto f = makeFrame(101, 0x5A);
+    uint64_t ts = 0x123456789ULL;
+    TEST_ASSERT_TRUE(w.append(f.data(), f.size(), f.size(), ts, 6, -42));
+    w.finish(sink);
+
+    std::vector<Block> blocks;
+    parseBlocks(sink.data, blocks);
+    TEST_ASSERT_EQUAL(3, blocks.size());
+    const Block& epb = blocks[2];
+    const auto& d = sink.data;
+    TEST_ASSERT_EQUAL_UINT32(6, epb.type);
+    TEST_ASSERT_EQUAL_UINT32(0, rd32(d, epb.off + 8));            // Interface 0
+    TEST_ASSERT_EQUAL_UINT32(0x1, rd32(d, epb.off + 12));         // Timestamp high
+    TEST_ASSERT_EQUAL_HEX32(0x23456789, rd32(d, epb.off + 16));   // Timestamp low
+    uint32_t capLen = rd32(d, epb.off + 20);
+    TEST_ASSERT_EQUAL_UINT32(13 + 101, capLen);
+    TEST_ASSERT_EQUAL_UINT32(capLen, rd32(d, epb.off + 24));
+
+    size_t rt = epb.off + 28;
+    TEST_ASSERT_EQUAL_UINT16(13, rd16(d, rt + 2));
+    TEST_ASSERT_EQUAL_UINT16(2437, rd16(d, rt + 8));              // Channel 6
+    TEST_ASSERT_EQUAL_INT8(-42, (int8_t)d[rt + 12]);
+    TEST_ASSERT_EQUAL_MEMORY(f.data(), &d[rt + 13], f.size());
+}
+
+void test_truncated_frame_keeps_original_length(void) {
+    PcapngWriter<4096> w;
+    MemSink sink;
+    w.begin(nullptr);
+    auto f = makeFrame(32, 0x01);
+    w.append(f.data(), f.size(), 400, 0, 1, -70);
+    w.finish(sink);
+
+    std::vector<Block> blocks;
+    parseBlocks(sink.data, blocks);
+    TEST_ASSERT_EQUAL_UINT32(13 + 32, rd32(sink.data, blocks[2].off + 20));
+    TEST_ASSERT_EQUAL_UINT32(13 + 400, rd32(sink.data, blocks[2].off + 24));
+}
+
+void test_rejects_empty_and_oversized_frames(void) {
+    PcapngWriter<4096> w;
+    auto f = makeFrame(100, 0);
+    TEST_ASSERT_FALSE(w.append(f.data(), f.size(), f.size(), 0, 1, 0));  // Not begun
+    w.begin("x");
+    TEST_ASSERT_FALSE(w.append(f.data(), 0, 0, 0, 1, 0));
+    std::vector<uint8_t> huge(PcapngWriter<4096>::MAX_FRAME_LEN + 1, 0);
+    TEST_ASSERT_FALSE(w.append(huge.data(), huge.size(), huge.size(), 0, 1, 0));
+    TEST_ASSERT_EQUAL_UINT32(0, w.stats().frames);
+}
+
+// ============================================================================
+// Write-behind
+// ============================================================================
+
+void test_flush_writes_only_whole_blocks(void) {
+    PcapngWriter<2048> w;
+    MemSink sink;
+    w.begin("x");
+    auto f = makeFrame(300, 0x22);
+    for (int i = 0; i < 5; i++) w.append(f.data(), f.size(), f.size(), i, 1, -50);
+    TEST_ASSERT_FALSE(w.pending());
+    w.flush(sink);
+    TEST_ASSERT_EQUAL(0, sink.writes.size());
+
+    for (int i = 0; i < 5; i++) w.append(f.data(), f.size(), f.size(), i, 1, -50);
+    TEST_ASSERT_TRUE(w.pending());
+    TEST_ASSERT_TRUE(w.flush(sink));
+    TEST_ASSERT_EQUAL(1, sink.writes.size());
+    TEST_ASSERT_EQUAL(2048, sink.writes[0]);
+    TEST_ASSERT_FALSE(w.pending());
+}
+
+void test_blocks_span_buffers_and_file_parses(void) {
+    PcapngWriter<2048> w;
+    MemSink sink;
+    w.begin("M5PORKCHOP");
+    for (int i = 0; i < 200; i++) {
+        auto f = makeFrame(60 + (i * 37) % 1400, (uint8_t)i);
+        w.append(f.data(), f.size(), f.size(), (uint64_t)i * 1000, 1 + i % 13, -60);
+        w.flush(sink);  // Main loop after every frame
+    }
+    w.finish(sink);
+
+    for (size_t i = 0; i + 1 < sink.writes.size(); i++) {
+        TEST_ASSERT_EQUAL(0, sink.writes[i] % 512);  // Only the tail is partial
+    }
+    std::vector<Block> blocks;
+    parseBlocks(sink.data, blocks);
+    TEST_ASSERT_EQUAL(202, blocks.size());
+    TEST_ASSERT_EQUAL_UINT8(199, sink.data[blocks[201].off + 28 + 13 + 30]);
+    TEST_ASSERT_EQUAL_UINT32(200, w.stats().frames);
+    TEST_ASSERT_EQUAL_UINT32(0, w.stats().dropped);
+}
+
+void test_both_buffers_full_drops_until_flush(void) {
+    PcapngWriter<2048> w;
+    MemSink sink;
+    w.begin("x");
+    auto f = makeFrame(500, 0x33);
+    int accepted = 0;
+    for (int i = 0; i < 20; i++) {
+        if (w.append(f.data(), f.size(), f.size(), i, 1, -50)) accepted++;
+    }
+    PcapngStats s = w.stats();
+    TEST_ASSERT_EQUAL_UINT32(accepted, s.frames);
+    TEST_ASSERT_EQUAL_UINT32(20 - accepted, s.dropped);
+    TEST_ASSERT_TRUE(s.buffered <= 4096);
+
+    w.flush(sink);
+    TEST_ASSERT_TRUE(w.append(f.data(), f.size(), f.size(), 99, 1, -50));
+    w.finish(sink);
+    std::vector<Block> blocks;
+    parseBlocks(sink.data, blocks);
+    TEST_ASSERT_EQUAL(2 + accepted + 1, blocks.size());
+}
+
+void test_exactly_full_buffers_flush_in_order(void) {
+    // Fill both buffers to the byte so the active one holds its place
+    PcapngWriter<2048> w;
+    MemSink sink;
+    w.begin("x");
+    uint32_t header = w.stats().buffered;
+    auto f = makeFrame(64, 0);
+    uint32_t epb = 28 + ((13 + 64 + 3) & ~3u) + 4;
+    uint32_t frames = 0;
+    while (header + (frames + 1) * epb <= 4096) {
+        f[2] = (uint8_t)frames;
+        w.append(f.data(), f.size(), f.size(), frames, 1, 0);
+        frames++;
+    }
+    uint32_t rest = 4096 - header - frames * epb;
+    if (rest >= 28 + 16 + 4) {
+        std::vector<uint8_t> last(rest - 28 - 4 - 13, 0x77);
+        last[0] = 0x80;
+        TEST_ASSERT_TRUE(w.append(last.data(), last.size(), last.size(), 0, 1, 0));
+        frames++;
+    }
+    w.flush(sink);
+    w.finish(sink);
+    std::vector<Block> blocks;
+    parseBlocks(sink.data, blocks);
+    TEST_ASSERT_EQUAL(2 + frames, blocks.size());
+    TEST_ASSERT_EQUAL_UINT8(0, sink.data[blocks[2].off + 28 + 13 + 2]);
+}
+
+void test_short_write_is_reported(void) {
+    PcapngWriter<2048> w;
+    MemSink sink;
+    sink.failAfter = 1000;
+    w.begin("x");
+    auto f = makeFrame(500, 0);
+    for (int i = 0; i < 4; i++) w.append(f.data(), f.size(), f.size(), i, 1, 0);
+    TEST_ASSERT_FALSE(w.flush(sink));
+    TEST_ASSERT_EQUAL_UINT32(1, w.stats().writeErrors);
+    TEST_ASSERT_FALSE(w.pending());  // Lost, not retried forever
+}
+
+void test_end_discards_and_frees(void) {
+    PcapngWriter<2048> w;
+    w.begin("x");
+    auto f = makeFrame(100, 0);
+    w.append(f.data(), f.size(), f.size(), 0, 1, 0);
+    w.end();
+    TEST_ASSERT_FALSE(w.active());
+    TEST_ASSERT_EQUAL_UINT32(0, w.stats().buffered);
+}
+
+// ============================================================================
+// I/O comparison (informational)
+// ============================================================================
+
+void test_writes_vs_per_frame_files(void) {
+    // 60 APs' first beacons, 40 probe responses, 24 EAPOL frames
+    PcapngWriter<4096> w;
+    MemSink sink;
+    w.begin("M5PORKCHOP");
+    uint32_t frames = 0;
+    for (int i = 0; i < 60; i++, frames++) {
+        auto f = makeFrame(280, (uint8_t)i);
+        w.append(f.data(), f.size(), f.size(), frames, 1, -60);
+        w.flush(sink);
+    }
+    for (int i = 0; i < 40; i++, frames++) {
+        auto f = makeFrame(250, (uint8_t)i);
+        w.append(f.data(), f.size(), f.size(), frames, 1, -60);
+        w.flush(sink);
+    }
+    for (int i = 0; i < 24; i++, frames++) {
+        auto f = makeFrame(135, (uint8_t)i);
+        w.append(f.data(), f.size(), f.size(), frames, 1, -60);
+        w.flush(sink);
+    }
+    w.finish(sink);
+    std::vector<Block> blocks;
+    parseBlocks(sink.data, blocks);
+    TEST_ASSERT_EQUAL(2 + frames, blocks.size());
+    printf("[BENCH] %u frames, %zu bytes: session file %zu writes, per-frame files %u open/write/close\n",
+           frames, sink.data.size(), sink.writes.size(), frames);
+    TEST_ASSERT_TRUE(sink.writes.size() < frames / 10);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Block layout
+    RUN_TEST(test_begin_writes_section_and_interface);
+    RUN_TEST(test_packet_block_carries_frame_and_timestamp);
+    RUN_TEST(test_truncated_frame_keeps_original_length);
+    RUN_TEST(test_rejects_empty_and_oversized_frames);
+
+    // Write-behind
+    RUN_TEST(test_flush_writes_only_whole_blocks);
+    RUN_TEST(test_blocks_span_buffers_and_file_parses);
+    RUN_TEST(test_both_buffers_full_drops_until_flush);
+    RUN_TEST(test_exactly_full_buffers_flush_in_order);
+    RUN_TEST(test_short_write_is_reported);
+    RUN_TEST(test_end_discards_and_frees);
+
+    // I/O comparison
+    RUN_TEST(test_writes_vs_per_frame_files);
+
+    return UNITY_END();
+}
@@ -0,0 +1,447 @@
+// Quant Model Tests
+// Tests the fixed-point MLP behind MLInference::loadModel: file validation
+// (magic, format, CRC-32, shapes, truncation), int8/Q7.8 arithmetic on
+// hand-built layers, agreement with the float network it was quantized
+// from, determinism, no heap per call, and microseconds per inference
+
+#include <unity.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "../mocks/alloc_counter.h"  // Shows run() makes no heap allocation
+#include "../../src/ml/quant_model.h"
+
+void setUp(void) {
+    // No setup needed
+}
+
+void tearDown(void) {
+    // No teardown needed
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static const int INPUTS = 32;   // FEATURE_VECTOR_SIZE
+static const int CLASSES = 5;   // MLLabel NORMAL..VULNERABLE
+
+// Float network, quantized and packed the way scripts/build_ml_model.py does
+struct FloatNet {
+    struct Layer {
+        int in, out;
+        uint8_t act;
+        std::vector<float> w;  // [out][in]
+        std::vector<float> b;
+    };
+    std::vector<float> offset, scale;
+    std::vector<Layer> layers;
+
+    void addLayer(int in, int out, uint8_t act, std::mt19937& rng) {
+        std::normal_distribution<float> d(0.0f, 1.0f / sqrtf((float)in));
+        Layer L{in, out, act, std::vector<float>(in * out), std::vector<float>(out)};
+        for (float& v : L.w) v = d(rng);
+        for (float& v : L.b) v = d(rng) * 0.5f;
+        layers.push_back(L);
+    }
+
+    void forward(const float* x, float* probs) const {
+        std::vector<float> cur(offset.size());
+        for (size_t i = 0; i < cur.size(); i++) cur[i] = (x[i] - offset[i]) * scale[i];
+        for (const Layer& L : layers) {
+            std::vector<float> nxt(L.out);
+            for (int o = 0; o < L.out; o++) {
+                float acc = L.b[o];
+                for (int i = 0; i < L.in; i++) acc += L.w[o * L.in + i] * cur[i];
+                if (L.act == QuantModel::ACT_RELU && acc < 0) acc = 0;
+                nxt[o] = acc;
+            }
+            cur.swap(nxt);
+        }
+        float top = cur[0], sum = 0;
+        for (float v : cur) top = v > top ? v : top;
+        for (size_t c = 0; c < cur.size(); c++) { probs[c] = expf(cur[c] - top); sum += probs[c]; }
+        for (size_t c = 0; c < cur.size(); c++) probs[c] /= sum;
+    }
+};
+
+static void put16(std::vector<uint8_t>& f, uint16_t v) { f.push_back(v & 0xFF); f.push_back(v >> 8); }
+static void put32(std::vector<uint8_t>& f, uint32_t v) { for (int i = 0; i < 4; i++) f.push_back((v >> (8 * i)) & 0xFF); }
+static void putFloat(std::vector<uint8_t>& f, float v) { uint32_t u; memcpy(&u, &v, 4); put32(f, u); }
+
+static std::vector<uint8_t> pack(const FloatNet& net, const char* version = "test-1.0") {
+    std::vector<uint8_t> p;
+    for (size_t i = 0; i < net.offset.size(); i++) { putFloat(p, net.offset[i]); putFloat(p, net.scale[i]); }
+    for (const FloatNet::Layer& L : net.layers) {
+        float peak = 0;
+        for (float v : L.w) peak = fabsf(v) > peak ? fabsf(v) : peak;
+        int shift = 0;
+        while (shift < 15 && peak * (float)(1 << (shift + 1)) <= 127.0f) shift++;
+        p.push_back(L.act);
+        p.push_back((uint8_t)shift);
+        put16(p, L.in); put16(p, L.out); put16(p, 0);
+        for (float v : L.w) p.push_back((uint8_t)(int8_t)lroundf(v * (float)(1 << shift)));
+        while (p.size() % 4) p.push_back(0);
+        for (float v : L.b) put32(p, (uint32_t)(int32_t)lroundf(v * (float)(1 << (QuantModel::ACT_FRAC + shift))));
+    }
+
+    std::vector<uint8_t> f = {'P', 'K', 'M', 'L', QuantModel::FORMAT_VERSION,
+                              (uint8_t)net.layers.size(), (uint8_t)net.offset.size(),
+                              (uint8_t)net.layers.back().out};
+    char ver[16] = {0};
+    strncpy(ver, version, 15);
+    f.insert(f.end(), ver, ver + 16);
+    put32(f, (uint32_t)p.size());
+    put32(f, Crc32::update(0, p.data(), p.size()));
+    f.insert(f.end(), p.begin(), p.end());
+    return f;
+}
+
+// Rough shape of real feature vectors: RSSI, channel, flags, counts...
+static const float FEATURE_MEAN[INPUTS] = {
+    -65, -95, 30, 6, 0, 100, 17, 4, 0.3f, 0.1f, 0.9f, 0.2f, 0.05f, 200, 40, 2,
+    0.5f, 3, 4, 12, 1, 0.5f, 0.3f, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+static const float FEATURE_STD[INPUTS] = {
+    12, 1, 12, 3.5f, 1, 20, 8, 2, 0.5f, 0.3f, 0.3f, 0.4f, 0.2f, 150, 30, 4,
+    0.5f, 3, 2, 6, 0.5f, 0.5f, 0.2f, 1, 1, 1, 1, 1, 1, 1, 1, 1};
+
+// 32 -> 64 -> 32 -> 5, normalization from the feature statistics
+static FloatNet makeNet(uint32_t seed) {
+    std::mt19937 rng(seed);
+    FloatNet net;
+    for (int i = 0; i < INPUTS; i++) {
+        net.offset.push_back(FEATURE_MEAN[i]);
+        net.scale.push_back(1.0f / FEATURE_STD[i]);
+    }
+    net.addLayer(INPUTS, 64, QuantModel::ACT_RELU, rng);
+    net.addLayer(64, 32, QuantModel::ACT_RELU, rng);
+    net.addLayer(32, CLASSES, QuantModel::ACT_SOFTMAX, rng);
+    return net;
+}
+
+static void randomFeatures(std::mt19937& rng, float* x) {
+    std::normal_distribution<float> d(0.0f, 1.0f);
+    for (int i = 0; i < INPUTS; i++) x[i] = FEATURE_MEAN[i] + d(rng) * FEATURE_STD[i];
+}
+
+// Blob whose CRC matches after editing the payload
+static void reseal(std::vector<uint8_t>& f) {
+    uint32_t crc = Crc32::update(0, f.data() + QuantModel::HEADER_BYTES, f.size() - QuantModel::HEADER_BYTES);
+    for (int i = 0; i < 4; i++) f[28 + i] = (crc >> (8 * i)) & 0xFF;
+}
+
+static size_t layerOffset(const std::vector<uint8_t>& f, int layer) {
+    size_t off = QuantModel::HEADER_BYTES + f[6] * 8;
+    for (int l = 0; l < layer; l++) {
+        uint16_t in = f[off + 2] | (f[off + 3] << 8), out = f[off + 4] | (f[off + 5] << 8);
+        off += QuantModel::LAYER_HEADER_BYTES + QuantModel::weightBytes(in, out) + out * 4;
+    }
+    return off;
+}
+
+// ============================================================================
+// Validation
+// ============================================================================
+
+void test_valid_model_binds(void) {
+    auto f = pack(makeNet(1), "porkchop-0.3");
+    TEST_ASSERT_NULL(QuantModel::check(f.data(), f.size(), INPUTS, CLASSES));
+    QuantModel m;
+    TEST_ASSERT_FALSE(m.loaded());
+    TEST_ASSERT_TRUE(m.bind(f.data(), f.size()));
+    TEST_ASSERT_TRUE(m.loaded());
+    TEST_ASSERT_EQUAL_STRING("porkchop-0.3", m.version());
+    TEST_ASSERT_EQUAL_UINT8(INPUTS, m.inputs());
+    TEST_ASSERT_EQUAL_UINT8(CLASSES, m.classes());
+    TEST_ASSERT_EQUAL_UINT8(3, m.layerTotal());
+}
+
+void test_rejects_bad_header(void) {
+    auto good = pack(makeNet(1));
+    auto f = good;
+    f[0] = 'X';
+    TEST_ASSERT_EQUAL_STRING("bad magic", QuantModel::check(f.data(), f.size()));
+    f = good; f[4] = 2;
+    TEST_ASSERT_EQUAL_STRING("unsupported format", QuantModel::check(f.data(), f.size()));
+    f = good; f[5] = 0;
+    TEST_ASSERT_EQUAL_STRING("bad layer count", QuantModel::check(f.data(), f.size()));
+    f = good; f[23] = 'x';
+    TEST_ASSERT_EQUAL_STRING("version not terminated", QuantModel::check(f.data(), f.size()));
+    TEST_ASSERT_EQUAL_STRING("too short", QuantModel::check(good.data(), 31));
+    TEST_ASSERT_EQUAL_STRING("too short", QuantModel::check(nullptr, 100));
+}
+
+void test_rejects_wrong_input_or_class_count(void) {
+    auto f = pack(makeNet(1));
+    TEST_ASSERT_EQUAL_STRING("input count mismatch", QuantModel::check(f.data(), f.size(), 24, CLASSES));
+    TEST_ASSERT_EQUAL_STRING("class count mismatch", QuantModel::check(f.data(), f.size(), INPUTS, 4));
+}
+
+void test_rejects_corrupted_payload(void) {
+    auto f = pack(makeNet(1));
+    f[f.size() / 2] ^= 0x01;  // One flipped weight bit
+    TEST_ASSERT_EQUAL_STRING("checksum mismatch", QuantModel::check(f.data(), f.size()));
+    QuantModel m;
+    TEST_ASSERT_FALSE(m.bind(f.data(), f.size()));
+    TEST_ASSERT_FALSE(m.loaded());
+}
+
+void test_rejects_truncated_and_padded_files(void) {
+    auto f = pack(makeNet(1));
+    TEST_ASSERT_EQUAL_STRING("length mismatch", QuantModel::check(f.data(), f.size() - 4));
+    f.resize(f.size() - 4);
+    for (int i = 0; i < 4; i++) f[24 + i] = ((f.size() - 32) >> (8 * i)) & 0xFF;
+    reseal(f);
+    TEST_ASSERT_EQUAL_STRING("truncated layer", QuantModel::check(f.data(), f.size()));
+
+    f = pack(makeNet(1));
+    f.insert(f.end(), 4, 0);
+    for (int i = 0; i < 4; i++) f[24 + i] = ((f.size() - 32) >> (8 * i)) & 0xFF;
+    reseal(f);
+    TEST_ASSERT_EQUAL_STRING("trailing bytes", QuantModel::check(f.data(), f.size()));
+}
+
+void test_rejects_bad_layer_shapes(void) {
+    auto good = pack(makeNet(1));
+    auto f = good;
+    f[layerOffset(f, 1) + 2] = 63;  // Second layer claims 63 inputs after a 64-wide one
+    reseal(f);
+    TEST_ASSERT_EQUAL_STRING("layer shapes don't chain", QuantModel::check(f.data(), f.size()));
+
+    f = good;
+    f[layerOffset(f, 1)] = QuantModel::ACT_SOFTMAX;  // Softmax in the middle
+    reseal(f);
+    TEST_ASSERT_EQUAL_STRING("softmax must end the model", QuantModel::check(f.data(), f.size()));
+
+    f = good;
+    f[layerOffset(f, 2)] = QuantModel::ACT_RELU;  // No softmax at the end
+    reseal(f);
+    TEST_ASSERT_EQUAL_STRING("softmax must end the model", QuantModel::check(f.data(), f.size()));
+}
+
+void test_rejects_oversized_bias(void) {
+    FloatNet net = makeNet(1);
+    net.layers[2].b[0] = 1e7f;  // Would overflow the accumulator
+    auto f = pack(net);
+    TEST_ASSERT_EQUAL_STRING("bias out of range", QuantModel::check(f.data(), f.size()));
+}
+
+void test_run_without_model_fails(void) {
+    QuantModel m;
+    float x[INPUTS] = {0}, out[CLASSES];
+    TEST_ASSERT_FALSE(m.run(x, INPUTS, out));
+    auto f = pack(makeNet(1));
+    m.bind(f.data(), f.size());
+    TEST_ASSERT_FALSE(m.run(x, INPUTS - 1, out));  // Short input
+    m.unbind();
+    TEST_ASSERT_FALSE(m.run(x, INPUTS, out));
+}
+
+// ============================================================================
+// Arithmetic
+// ============================================================================
+
+// 2 inputs -> 2 hidden (ReLU) -> 2 classes, weights chosen by hand
+static std::vector<uint8_t> tinyModel(float w00, float w01, float w10, float w11) {
+    FloatNet net;
+    net.offset = {0, 0};
+    net.scale = {1, 1};
+    net.layers.push_back({2, 2, QuantModel::ACT_RELU, {w00, w01, w10, w11}, {0, 0}});
+    net.layers.push_back({2, 2, QuantModel::ACT_SOFTMAX, {1, 0, 0, 1}, {0, 0}});
+    return pack(net);
+}
+
+void test_relu_clamps_negative_hidden_units(void) {
+    auto f = tinyModel(1, 0, -1, 0);  // h0 = x0, h1 = -x0
+    QuantModel m;
+    TEST_ASSERT_TRUE(m.bind(f.data(), f.size()));
+    float out[2];
+    float x[2] = {2.0f, 0.0f};  // h = (2, 0): softmax(2, 0)
+    m.run(x, 2, out);
+    TEST_ASSERT_FLOAT_WITHIN(0.005f, 1.0f / (1.0f + expf(-2.0f)), out[0]);
+    float y[2] = {-2.0f, 0.0f};  // h = (0, 2)
+    m.run(y, 2, out);
+    TEST_ASSERT_FLOAT_WITHIN(0.005f, 1.0f / (1.0f + expf(-2.0f)), out[1]);
+}
+
+void test_softmax_sums_to_one(void) {
+    auto f = pack(makeNet(3));
+    QuantModel m;
+    m.bind(f.data(), f.size());
+    std::mt19937 rng(9);
+    for (int k = 0; k < 100; k++) {
+        float x[INPUTS], out[CLASSES];
+        randomFeatures(rng, x);
+        TEST_ASSERT_TRUE(m.run(x, INPUTS, out));
+        float sum = 0;
+        for (float p : out) { sum += p; TEST_ASSERT_TRUE(p >= 0.0f && p <= 1.0f); }
+        TEST_ASSERT_FLOAT_WITHIN(1e-5f, 1.0f, sum);
+    }
+}
+
+void test_extreme_inputs_saturate(void) {
+    // Way past Q7.8 range, and NaN: clamped, never wrapped
+    auto f = tinyModel(1, 0, -1, 0);
+    QuantModel m;
+    m.bind(f.data(), f.size());
+    float out[2];
+    float big[2] = {1e9f, 0};
+    m.run(big, 2, out);
+    TEST_ASSERT_TRUE(out[0] > 0.99f);
+    float small[2] = {-1e9f, 0};
+    m.run(small, 2, out);
+    TEST_ASSERT_TRUE(out[1] > 0.99f);
+    float nan[2] = {NAN, NAN};
+    TEST_ASSERT_TRUE(m.run(nan, 2, out));
+    TEST_ASSERT_FALSE(std::isnan(out[0]));
+}
+
+void test_softmax_survives_extreme_logits(void) {
+    // Shift 0 and biases near the limit: logits about +/-2^30, gap past int32
+    FloatNet net;
+    net.offset = {0, 0};
+    net.scale = {1, 1};
+    net.layers.push_back({2, 2, QuantModel::ACT_RELU, {1, 0, -1, 0}, {0, 0}});
+    net.layers.push_back({2, 2, QuantModel::ACT_SOFTMAX, {100, 0, -100, 0}, {4.19e6f, -4.19e6f}});
+    auto f = pack(net);
+    QuantModel m;
+    TEST_ASSERT_TRUE(m.bind(f.data(), f.size()));
+    float out[2];
+    float x[2] = {1e9f, 0};  // h0 saturates
+    TEST_ASSERT_TRUE(m.run(x, 2, out));
+    TEST_ASSERT_FALSE(std::isnan(out[0]) || std::isnan(out[1]));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 1.0f, out[0]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.0f, out[1]);
+}
+
+// ============================================================================
+// Float reference
+// ============================================================================
+
+void test_matches_float_reference(void) {
+    int agree = 0, total = 0;
+    float worst = 0;
+    for (uint32_t seed = 1; seed <= 5; seed++) {
+        FloatNet net = makeNet(seed);
+        auto f = pack(net);
+        QuantModel m;
+        TEST_ASSERT_TRUE(m.bind(f.data(), f.size()));
+        std::mt19937 rng(seed * 100);
+        for (int k = 0; k < 400; k++) {
+            float x[INPUTS], q[CLASSES], r[CLASSES];
+            randomFeatures(rng, x);
+            m.run(x, INPUTS, q);
+            net.forward(x, r);
+            int qa = 0, ra = 0;
+            for (int c = 0; c < CLASSES; c++) {
+                float d = fabsf(q[c] - r[c]);
+                worst = d > worst ? d : worst;
+                if (q[c] > q[qa]) qa = c;
+                if (r[c] > r[ra]) ra = c;
+            }
+            agree += qa == ra;
+            total++;
+        }
+    }
+    printf("[ACCURACY] %d/%d argmax agree, worst probability error %.4f\n", agree, total, worst);
+    TEST_ASSERT_TRUE(worst < 0.05f);
+    TEST_ASSERT_TRUE(agree >= total * 97 / 100);
+}
+
+void test_deterministic_across_runs_and_instances(void) {
+    auto f = pack(makeNet(4));
+    QuantModel a, b;
+    a.bind(f.data(), f.size());
+    b.bind(f.data(), f.size());
+    std::mt19937 rng(77);
+    for (int k = 0; k < 50; k++) {
+        float x[INPUTS], o1[CLASSES], o2[CLASSES], o3[CLASSES];
+        randomFeatures(rng, x);
+        a.run(x, INPUTS, o1);
+        a.run(x, INPUTS, o2);
+        b.run(x, INPUTS, o3);
+        TEST_ASSERT_EQUAL_MEMORY(o1, o2, sizeof(o1));
+        TEST_ASSERT_EQUAL_MEMORY(o1, o3, sizeof(o1));
+    }
+}
+
+// ============================================================================
+// Memory / speed
+// ============================================================================
+
+void test_run_does_not_allocate(void) {
+    auto f = pack(makeNet(2));
+    QuantModel m;
+    m.bind(f.data(), f.size());
+    float x[INPUTS], out[CLASSES];
+    std::mt19937 rng(1);
+    randomFeatures(rng, x);
+    size_t before = allocations;
+    for (int k = 0; k < 100; k++) m.run(x, INPUTS, out);
+    TEST_ASSERT_EQUAL_size_t(before, allocations);
+}
+
+void test_model_size_is_compact(void) {
+    auto f = pack(makeNet(2));
+    // 32x64 + 64x32 + 32x5 int8 weights, int32 biases, input scales, header
+    TEST_ASSERT_EQUAL_size_t(32 + 256 + 3 * 8 + 2048 + 2048 + 160 + (64 + 32 + 5) * 4, f.size());
+    printf("[MEM] 32-64-32-5 model: %zu bytes on SPIFFS, QuantModel %zu bytes\n", f.size(), sizeof(QuantModel));
+}
+
+void test_benchmark_inference(void) {
+    auto f = pack(makeNet(2));
+    QuantModel m;
+    m.bind(f.data(), f.size());
+    FloatNet net = makeNet(2);
+    std::mt19937 rng(5);
+    std::vector<float> xs(256 * INPUTS);
+    for (int k = 0; k < 256; k++) randomFeatures(rng, &xs[k * INPUTS]);
+
+    const int N = 20000;
+    float out[CLASSES], sink = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int k = 0; k < N; k++) { m.run(&xs[(k & 255) * INPUTS], INPUTS, out); sink += out[0]; }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int k = 0; k < N / 10; k++) { net.forward(&xs[(k & 255) * INPUTS], out); sink += out[0]; }
+    auto t2 = std::chrono::steady_clock::now();
+
+    double quantUs = std::chrono::duration<double, std::micro>(t1 - t0).count() / N;
+    double floatUs = std::chrono::duration<double, std::micro>(t2 - t1).count() / (N / 10);
+    printf("[BENCH] 32-64-32-5: fixed-point %.2f us/inference, float reference %.2f us (host, sink %.1f)\n",
+           quantUs, floatUs, sink);
+    TEST_ASSERT_TRUE(quantUs < 100.0);  // Host; ~4.3k MACs is well under 1 ms on the S3
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Validation
+    RUN_TEST(test_valid_model_binds);
+    RUN_TEST(test_rejects_bad_header);
+    RUN_TEST(test_rejects_wrong_input_or_class_count);
+    RUN_TEST(test_rejects_corrupted_payload);
+    RUN_TEST(test_rejects_truncated_and_padded_files);
+    RUN_TEST(test_rejects_bad_layer_shapes);
+    RUN_TEST(test_rejects_oversized_bias);
+    RUN_TEST(test_run_without_model_fails);
+
+    // Arithmetic
+    RUN_TEST(test_relu_clamps_negative_hidden_units);
+    RUN_TEST(test_softmax_sums_to_one);
+    RUN_TEST(test_extreme_inputs_saturate);
+    RUN_TEST(test_softmax_survives_extreme_logits);
+
+    // Float reference
+    RUN_TEST(test_matches_float_reference);
+    RUN_TEST(test_deterministic_across_runs_and_instances);
+
+    // Memory / speed
+    RUN_TEST(test_run_does_not_allocate);
+    RUN_TEST(test_model_size_is_compact);
+    RUN_TEST(test_benchmark_inference);
+
+    return UNITY_END();
+}
@@ -0,0 +1,354 @@
+// Resumable Transfer Tests
+// Tests the file server's interruption-tolerant transfers: Range header
+// parsing, ETag/Last-Modified validators and If-Range, and chunked uploads
+// against the host-backed SD mock - resume after a drop, offset checks,
+// completion rename, stale and evicted part files, paths too long for the .part
+// suffix and sector-aligned write-behind
+
+#include <unity.h>
+#include <cstdio>
+#include <string>
+#include "../../src/web/http_range.h"
+#include "../../src/web/upload_resume.h"
+#include "../mocks/mock_fs.h"
+
+static const char* TEST_ROOT = "/tmp/porkchop_test_resumable_transfer";
+
+typedef UploadResume<fs::FS, File> Uploads;
+
+void setUp(void) {
+    std::string cmd = std::string("rm -rf ") + TEST_ROOT + " && mkdir -p " + TEST_ROOT;
+    system(cmd.c_str());
+    SD.setRoot(TEST_ROOT);
+    SD.opens = 0;
+}
+
+void tearDown(void) {
+    // No teardown needed
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static std::string pattern(size_t size) {
+    std::string s(size, '\0');
+    for (size_t i = 0; i < size; i++) s[i] = (char)(i * 31 + (i >> 8));
+    return s;
+}
+
+static std::string readHost(const char* path) {
+    std::string host = std::string(TEST_ROOT) + path;
+    FILE* fp = fopen(host.c_str(), "rb");
+    if (!fp) return "<missing>";
+    std::string out;
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) out.append(buf, n);
+    fclose(fp);
+    return out;
+}
+
+static bool hostExists(const std::string& path) {
+    FILE* fp = fopen((std::string(TEST_ROOT) + path).c_str(), "rb");
+    if (fp) fclose(fp);
+    return fp != nullptr;
+}
+
+// Feed data in HTTP-upload-sized pieces, like WebServer's upload callback
+static void feed(Uploads& up, const std::string& data, size_t from, size_t to) {
+    const size_t PIECE = 1436;
+    for (size_t p = from; p < to; p += PIECE) {
+        size_t n = to - p < PIECE ? to - p : PIECE;
+        up.write((const uint8_t*)data.data() + p, n);
+    }
+}
+
+// ============================================================================
+// Range parsing
+// ============================================================================
+
+void test_range_forms(void) {
+    uint32_t s, e;
+    TEST_ASSERT_TRUE(HttpRange::parse("bytes=0-99", 1000, s, e) == RangeResult::PARTIAL);
+    TEST_ASSERT_EQUAL_UINT32(0, s);
+    TEST_ASSERT_EQUAL_UINT32(99, e);
+
+    TEST_ASSERT_TRUE(HttpRange::parse("bytes=500-", 1000, s, e) == RangeResult::PARTIAL);
+    TEST_ASSERT_EQUAL_UINT32(500, s);
+    TEST_ASSERT_EQUAL_UINT32(999, e);
+
+    TEST_ASSERT_TRUE(HttpRange::parse("bytes=-100", 1000, s, e) == RangeResult::PARTIAL);
+    TEST_ASSERT_EQUAL_UINT32(900, s);
+    TEST_ASSERT_EQUAL_UINT32(999, e);
+
+    // End past EOF is clipped, suffix longer than the file is all of it
+    TEST_ASSERT_TRUE(HttpRange::parse("bytes=990-5000", 1000, s, e) == RangeResult::PARTIAL);
+    TEST_ASSERT_EQUAL_UINT32(999, e);
+    TEST_ASSERT_TRUE(HttpRange::parse("bytes=-5000", 1000, s, e) == RangeResult::PARTIAL);
+    TEST_ASSERT_EQUAL_UINT32(0, s);
+}
+
+void test_range_unsatisfiable(void) {
+    uint32_t s, e;
+    TEST_ASSERT_TRUE(HttpRange::parse("bytes=1000-", 1000, s, e) == RangeResult::UNSATISFIABLE);
+    TEST_ASSERT_TRUE(HttpRange::parse("bytes=-0", 1000, s, e) == RangeResult::UNSATISFIABLE);
+    TEST_ASSERT_TRUE(HttpRange::parse("bytes=0-", 0, s, e) == RangeResult::UNSATISFIABLE);
+}
+
+void test_range_ignored_when_unusable(void) {
+    uint32_t s, e;
+    TEST_ASSERT_TRUE(HttpRange::parse(nullptr, 1000, s, e) == RangeResult::FULL);
+    TEST_ASSERT_TRUE(HttpRange::parse("", 1000, s, e) == RangeResult::FULL);
+    TEST_ASSERT_TRUE(HttpRange::parse("items=0-5", 1000, s, e) == RangeResult::FULL);
+    TEST_ASSERT_TRUE(HttpRange::parse("bytes=0-5,10-20", 1000, s, e) == RangeResult::FULL);
+    TEST_ASSERT_TRUE(HttpRange::parse("bytes=50-10", 1000, s, e) == RangeResult::FULL);
+    TEST_ASSERT_TRUE(HttpRange::parse("bytes=-", 1000, s, e) == RangeResult::FULL);
+    TEST_ASSERT_TRUE(HttpRange::parse("bytes=1x-5", 1000, s, e) == RangeResult::FULL);
+}
+
+// ============================================================================
+// Validators
+// ============================================================================
+
+void test_etag_and_date(void) {
+    char tag[32];
+    HttpRange::etag(0x1234, 0x5f5e1000, tag, sizeof(tag));
+    TEST_ASSERT_EQUAL_STRING("\"1234-5f5e1000\"", tag);
+
+    char date[40];
+    TEST_ASSERT_TRUE(HttpRange::httpDate(784111777, date, sizeof(date)));
+    TEST_ASSERT_EQUAL_STRING("Sun, 06 Nov 1994 08:49:37 GMT", date);
+    TEST_ASSERT_FALSE(HttpRange::httpDate(0, date, sizeof(date)));  // No clock
+}
+
+void test_if_range(void) {
+    const char* tag = "\"10-20\"";
+    const char* lm = "Sun, 06 Nov 1994 08:49:37 GMT";
+    TEST_ASSERT_TRUE(HttpRange::ifRangeMatches(nullptr, tag, lm));
+    TEST_ASSERT_TRUE(HttpRange::ifRangeMatches("\"10-20\"", tag, lm));
+    TEST_ASSERT_TRUE(HttpRange::ifRangeMatches(lm, tag, lm));
+    TEST_ASSERT_FALSE(HttpRange::ifRangeMatches("\"10-21\"", tag, lm));
+    TEST_ASSERT_FALSE(HttpRange::ifRangeMatches("Mon, 07 Nov 1994 08:49:37 GMT", tag, lm));
+    TEST_ASSERT_FALSE(HttpRange::ifRangeMatches(lm, tag, ""));
+}
+
+// ============================================================================
+// Resumable uploads
+// ============================================================================
+
+void test_upload_in_slices(void) {
+    std::string data = pattern(100000);
+    Uploads up;
+    char id[Uploads::ID_LEN + 1];
+    uint32_t offset = 99;
+    TEST_ASSERT_TRUE(up.begin(SD, "/wardriving/big.csv.x", data.size(), id, offset));
+    TEST_ASSERT_EQUAL_UINT32(0, offset);
+    system((std::string("mkdir -p ") + TEST_ROOT + "/wardriving").c_str());
+
+    const size_t SLICE = 32768;
+    UploadStatus last = UploadStatus::OK;
+    for (size_t at = 0; at < data.size(); at += SLICE) {
+        TEST_ASSERT_TRUE(up.open(SD, id, at) == UploadStatus::OK);
+        size_t end = at + SLICE < data.size() ? at + SLICE : data.size();
+        feed(up, data, at, end);
+        last = up.finish(&offset);
+        TEST_ASSERT_EQUAL_UINT32(end, offset);
+    }
+    TEST_ASSERT_TRUE(last == UploadStatus::COMPLETE);
+    TEST_ASSERT_TRUE(readHost("/wardriving/big.csv.x") == data);
+    TEST_ASSERT_FALSE(hostExists(std::string("/wardriving/big.csv.x.") + id + ".part"));
+    TEST_ASSERT_EQUAL_UINT32(1, up.stats().completed);
+}
+
+void test_resume_after_drop(void) {
+    std::string data = pattern(50000);
+    Uploads up;
+    char id[Uploads::ID_LEN + 1];
+    uint32_t offset;
+    TEST_ASSERT_TRUE(up.begin(SD, "/s.pcap", data.size(), id, offset));
+
+    // Connection dies 21000 bytes in
+    TEST_ASSERT_TRUE(up.open(SD, id, 0) == UploadStatus::OK);
+    feed(up, data, 0, 21000);
+    up.abort();
+
+    // A fresh server (reboot) finds the same id and where to continue
+    Uploads after;
+    char id2[Uploads::ID_LEN + 1];
+    TEST_ASSERT_TRUE(after.begin(SD, "/s.pcap", data.size(), id2, offset));
+    TEST_ASSERT_EQUAL_STRING(id, id2);
+    TEST_ASSERT_EQUAL_UINT32(21000, offset);
+
+    TEST_ASSERT_TRUE(after.open(SD, id2, offset) == UploadStatus::OK);
+    feed(after, data, offset, data.size());
+    TEST_ASSERT_TRUE(after.finish() == UploadStatus::COMPLETE);
+    TEST_ASSERT_TRUE(readHost("/s.pcap") == data);
+}
+
+void test_wrong_offset_and_id_refused(void) {
+    std::string data = pattern(5000);
+    Uploads up;
+    char id[Uploads::ID_LEN + 1];
+    uint32_t offset;
+    TEST_ASSERT_TRUE(up.begin(SD, "/f.bin", data.size(), id, offset));
+    TEST_ASSERT_TRUE(up.open(SD, id, 0) == UploadStatus::OK);
+    feed(up, data, 0, 2000);
+    TEST_ASSERT_TRUE(up.finish() == UploadStatus::OK);
+
+    TEST_ASSERT_TRUE(up.open(SD, id, 1000) == UploadStatus::BAD_OFFSET);  // Replay
+    TEST_ASSERT_TRUE(up.open(SD, id, 3000) == UploadStatus::BAD_OFFSET);  // Gap
+    TEST_ASSERT_TRUE(up.open(SD, "deadbeef", 2000) == UploadStatus::UNKNOWN_ID);
+    TEST_ASSERT_EQUAL_UINT32(3, up.stats().rejected);
+    TEST_ASSERT_FALSE(up.receiving());
+}
+
+void test_overlong_slice_fails(void) {
+    std::string data = pattern(3000);
+    Uploads up;
+    char id[Uploads::ID_LEN + 1];
+    uint32_t offset;
+    TEST_ASSERT_TRUE(up.begin(SD, "/f.bin", 1000, id, offset));
+    TEST_ASSERT_TRUE(up.open(SD, id, 0) == UploadStatus::OK);
+    feed(up, data, 0, 3000);
+    TEST_ASSERT_TRUE(up.finish() == UploadStatus::FAILED);
+    TEST_ASSERT_FALSE(hostExists("/f.bin"));
+}
+
+void test_replaces_existing_and_drops_stale_part(void) {
+    FILE* fp = fopen((std::string(TEST_ROOT) + "/f.txt").c_str(), "wb");
+    fputs("old contents", fp);
+    fclose(fp);
+
+    Uploads up;
+    char id[Uploads::ID_LEN + 1];
+    uint32_t offset;
+    TEST_ASSERT_TRUE(up.begin(SD, "/f.txt", 3, id, offset));
+
+    // A part file longer than the upload can't be this upload's
+    fp = fopen((std::string(TEST_ROOT) + "/f.txt." + id + ".part").c_str(), "wb");
+    fputs("way too long", fp);
+    fclose(fp);
+    TEST_ASSERT_TRUE(up.begin(SD, "/f.txt", 3, id, offset));
+    TEST_ASSERT_EQUAL_UINT32(0, offset);
+
+    TEST_ASSERT_TRUE(up.open(SD, id, 0) == UploadStatus::OK);
+    up.write((const uint8_t*)"new", 3);
+    TEST_ASSERT_TRUE(up.finish() == UploadStatus::COMPLETE);
+    TEST_ASSERT_EQUAL_STRING("new", readHost("/f.txt").c_str());
+}
+
+void test_empty_file_upload(void) {
+    Uploads up;
+    char id[Uploads::ID_LEN + 1];
+    uint32_t offset;
+    TEST_ASSERT_TRUE(up.begin(SD, "/empty", 0, id, offset));
+    TEST_ASSERT_TRUE(up.open(SD, id, 0) == UploadStatus::OK);
+    TEST_ASSERT_TRUE(up.finish() == UploadStatus::COMPLETE);
+    TEST_ASSERT_TRUE(hostExists("/empty"));
+}
+
+void test_ids_differ_by_path_and_size(void) {
+    Uploads up;
+    char a[Uploads::ID_LEN + 1], b[Uploads::ID_LEN + 1], c[Uploads::ID_LEN + 1];
+    uint32_t offset;
+    up.begin(SD, "/a", 100, a, offset);
+    up.begin(SD, "/a", 101, b, offset);
+    up.begin(SD, "/b", 100, c, offset);
+    TEST_ASSERT_EQUAL_UINT32(Uploads::ID_LEN, strlen(a));
+    TEST_ASSERT_TRUE(strcmp(a, b) != 0);
+    TEST_ASSERT_TRUE(strcmp(a, c) != 0);
+}
+
+void test_evicted_upload_drops_its_part(void) {
+    Uploads up;
+    char id[Uploads::ID_LEN + 1], other[Uploads::ID_LEN + 1];
+    uint32_t offset;
+    TEST_ASSERT_TRUE(up.begin(SD, "/old.bin", 100, id, offset));
+    TEST_ASSERT_TRUE(up.open(SD, id, 0) == UploadStatus::OK);
+    up.write((const uint8_t*)"half", 4);
+    TEST_ASSERT_TRUE(up.finish() == UploadStatus::OK);
+    std::string part = std::string("/old.bin.") + id + ".part";
+    TEST_ASSERT_TRUE(hostExists(part));
+
+    // Filling every slot with newer uploads pushes the old one out
+    for (int i = 0; i < 4; i++) {
+        char path[16];
+        snprintf(path, sizeof(path), "/new%d.bin", i);
+        TEST_ASSERT_TRUE(up.begin(SD, path, 100, other, offset));
+    }
+    TEST_ASSERT_FALSE(hostExists(part));
+    TEST_ASSERT_TRUE(up.open(SD, id, 4) == UploadStatus::UNKNOWN_ID);
+}
+
+void test_rejects_path_without_room_for_part_suffix(void) {
+    Uploads up;
+    char id[Uploads::ID_LEN + 1];
+    uint32_t offset;
+    // "/" + name + ".xxxxxxxx.part" must fit MAX_PATH with its NUL
+    std::string fits = "/" + std::string(Uploads::MAX_PATH - 16, 'f');
+    std::string over = "/" + std::string(Uploads::MAX_PATH - 15, 'o');
+    TEST_ASSERT_TRUE(up.begin(SD, fits.c_str(), 4, id, offset));
+    TEST_ASSERT_TRUE(up.open(SD, id, 0) == UploadStatus::OK);
+    up.write((const uint8_t*)"data", 4);
+    TEST_ASSERT_TRUE(up.finish() == UploadStatus::COMPLETE);
+    TEST_ASSERT_FALSE(up.begin(SD, over.c_str(), 4, id, offset));
+}
+
+// ============================================================================
+// Performance: sector-aligned write-behind
+// ============================================================================
+
+void test_writes_are_sector_aligned(void) {
+    std::string data = pattern(200000);
+    Uploads up;
+    char id[Uploads::ID_LEN + 1];
+    uint32_t offset;
+    TEST_ASSERT_TRUE(up.begin(SD, "/al.bin", data.size(), id, offset));
+
+    // First slice ends mid-sector, so the resumed one starts unaligned
+    TEST_ASSERT_TRUE(up.open(SD, id, 0) == UploadStatus::OK);
+    feed(up, data, 0, 70001);
+    up.finish();
+    TEST_ASSERT_TRUE(up.open(SD, id, 70001) == UploadStatus::OK);
+    feed(up, data, 70001, data.size());
+    TEST_ASSERT_TRUE(up.finish() == UploadStatus::COMPLETE);
+    TEST_ASSERT_TRUE(readHost("/al.bin") == data);
+
+    UploadResumeStats st = up.stats();
+    uint32_t pieces = (data.size() + 1435) / 1436;
+    printf("[BENCH] 200000 bytes in %lu upload pieces: %lu card writes, %lu sector-aligned\n",
+           (unsigned long)pieces, (unsigned long)st.writes, (unsigned long)st.alignedWrites);
+    // Only the tail of each slice and the realigning write may be ragged
+    TEST_ASSERT_TRUE(st.writes - st.alignedWrites <= 3);
+    TEST_ASSERT_TRUE(st.writes * 2 < pieces);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Range parsing
+    RUN_TEST(test_range_forms);
+    RUN_TEST(test_range_unsatisfiable);
+    RUN_TEST(test_range_ignored_when_unusable);
+
+    // Validators
+    RUN_TEST(test_etag_and_date);
+    RUN_TEST(test_if_range);
+
+    // Resumable uploads
+    RUN_TEST(test_upload_in_slices);
+    RUN_TEST(test_resume_after_drop);
+    RUN_TEST(test_wrong_offset_and_id_refused);
+    RUN_TEST(test_overlong_slice_fails);
+    RUN_TEST(test_replaces_existing_and_drops_stale_part);
+    RUN_TEST(test_empty_file_upload);
+    RUN_TEST(test_ids_differ_by_path_and_size);
+    RUN_TEST(test_evicted_upload_drops_its_part);
+    RUN_TEST(test_rejects_path_without_room_for_part_suffix);
+
+    // Performance
+    RUN_TEST(test_writes_are_sector_aligned);
+
+    return UNITY_END();
+}
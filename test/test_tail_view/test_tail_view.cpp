@@ -0,0 +1,295 @@
+// Tail View Tests
+// Tests the log viewer's windowed reader against the host-backed SD mock:
+// the tail found from EOF, scrolling up/down across block boundaries,
+// blank/CRLF/long/unterminated lines, follow-mode refresh on growth and
+// rotation, and open cost that stays flat as the log grows
+
+#include <unity.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "../mocks/mock_fs.h"
+#include "../../src/core/tail_view.h"
+
+static const char* TEST_ROOT = "/tmp/porkchop_test_tail_view";
+
+typedef TailView<File, 9, 40> View;
+typedef TailView<File, 4, 40, 64> SmallView;  // Tiny blocks: lines straddle them
+
+void setUp(void) {
+    std::string cmd = std::string("rm -rf ") + TEST_ROOT + " && mkdir -p " + TEST_ROOT;
+    system(cmd.c_str());
+    SD.setRoot(TEST_ROOT);
+    SD.opens = 0;
+}
+
+void tearDown(void) {
+    // No teardown needed
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static void writeHost(const char* path, const std::string& data, const char* mode = "wb") {
+    std::string host = std::string(TEST_ROOT) + path;
+    FILE* fp = fopen(host.c_str(), mode);
+    fwrite(data.data(), 1, data.size(), fp);
+    fclose(fp);
+}
+
+static std::string numbered(int from, int to) {
+    std::string s;
+    char line[48];
+    for (int i = from; i <= to; i++) {
+        snprintf(line, sizeof(line), "[%d][TEST] line %d\n", i * 10, i);
+        s += line;
+    }
+    return s;
+}
+
+static std::string lineText(int i) {
+    char line[48];
+    snprintf(line, sizeof(line), "[%d][TEST] line %d", i * 10, i);
+    return line;
+}
+
+static File openLog() {
+    return SD.open("/v.log", FILE_READ);
+}
+
+// ============================================================================
+// Tail
+// ============================================================================
+
+void test_open_shows_last_lines(void) {
+    writeHost("/v.log", numbered(1, 100));
+    View v;
+    TEST_ASSERT_TRUE(v.open(openLog()));
+    TEST_ASSERT_EQUAL_UINT8(9, v.count());
+    for (int i = 0; i < 9; i++) {
+        TEST_ASSERT_EQUAL_STRING(lineText(92 + i).c_str(), v.line(i));
+    }
+    TEST_ASSERT_TRUE(v.atEnd());
+    TEST_ASSERT_FALSE(v.atStart());
+}
+
+void test_short_file_fits_window(void) {
+    writeHost("/v.log", numbered(1, 3));
+    View v;
+    TEST_ASSERT_TRUE(v.open(openLog()));
+    TEST_ASSERT_EQUAL_UINT8(3, v.count());
+    TEST_ASSERT_EQUAL_STRING(lineText(1).c_str(), v.line(0));
+    TEST_ASSERT_TRUE(v.atStart());
+    TEST_ASSERT_TRUE(v.atEnd());
+    TEST_ASSERT_EQUAL_INT(0, v.scroll(-1));
+    TEST_ASSERT_EQUAL_INT(0, v.scroll(1));
+}
+
+void test_empty_file(void) {
+    writeHost("/v.log", "");
+    View v;
+    TEST_ASSERT_TRUE(v.open(openLog()));
+    TEST_ASSERT_EQUAL_UINT8(0, v.count());
+    TEST_ASSERT_EQUAL_STRING("", v.line(0));
+    TEST_ASSERT_EQUAL_INT(0, v.scroll(-5));
+}
+
+void test_open_fails_without_file(void) {
+    View v;
+    TEST_ASSERT_FALSE(v.open(openLog()));
+    TEST_ASSERT_FALSE(v.isOpen());
+}
+
+// ============================================================================
+// Line shapes
+// ============================================================================
+
+void test_blank_lines_and_whitespace_skipped(void) {
+    writeHost("/v.log", "first\n\n   \n  second  \r\n\r\n\nthird\n\n");
+    View v;
+    TEST_ASSERT_TRUE(v.open(openLog()));
+    TEST_ASSERT_EQUAL_UINT8(3, v.count());
+    TEST_ASSERT_EQUAL_STRING("first", v.line(0));
+    TEST_ASSERT_EQUAL_STRING("second", v.line(1));
+    TEST_ASSERT_EQUAL_STRING("third", v.line(2));
+}
+
+void test_long_line_truncated(void) {
+    std::string longLine(300, 'x');
+    writeHost("/v.log", "a\n" + longLine + "\nb\n");
+    View v;
+    TEST_ASSERT_TRUE(v.open(openLog()));
+    TEST_ASSERT_EQUAL_UINT8(3, v.count());
+    TEST_ASSERT_EQUAL_UINT32(40, strlen(v.line(1)));
+    TEST_ASSERT_EQUAL_STRING("b", v.line(2));
+}
+
+void test_unterminated_last_line_shown(void) {
+    writeHost("/v.log", "one\ntwo\npartial");
+    View v;
+    TEST_ASSERT_TRUE(v.open(openLog()));
+    TEST_ASSERT_EQUAL_UINT8(3, v.count());
+    TEST_ASSERT_EQUAL_STRING("partial", v.line(2));
+    TEST_ASSERT_TRUE(v.atEnd());
+}
+
+// ============================================================================
+// Scrolling
+// ============================================================================
+
+void test_scroll_walks_whole_file(void) {
+    writeHost("/v.log", numbered(1, 200));
+    SmallView v;
+    TEST_ASSERT_TRUE(v.open(openLog()));
+    TEST_ASSERT_EQUAL_STRING(lineText(197).c_str(), v.line(0));
+
+    // Up to the very top, one line at a time
+    int moved = 0;
+    while (v.scroll(-1) == -1) moved--;
+    TEST_ASSERT_EQUAL_INT(-196, moved);
+    TEST_ASSERT_TRUE(v.atStart());
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_STRING(lineText(1 + i).c_str(), v.line(i));
+    }
+
+    // And back down by pages
+    TEST_ASSERT_EQUAL_INT(100, v.scroll(100));
+    TEST_ASSERT_EQUAL_STRING(lineText(101).c_str(), v.line(0));
+    TEST_ASSERT_EQUAL_INT(96, v.scroll(1000));
+    TEST_ASSERT_TRUE(v.atEnd());
+    TEST_ASSERT_EQUAL_STRING(lineText(200).c_str(), v.line(3));
+}
+
+void test_scroll_skips_blank_lines_both_ways(void) {
+    writeHost("/v.log", "a\n\nb\n\n\nc\nd\n\ne\n\n");
+    TailView<File, 2, 40, 4> v;
+    TEST_ASSERT_TRUE(v.open(openLog()));
+    TEST_ASSERT_EQUAL_STRING("d", v.line(0));
+    TEST_ASSERT_EQUAL_STRING("e", v.line(1));
+    TEST_ASSERT_EQUAL_INT(-3, v.scroll(-10));
+    TEST_ASSERT_EQUAL_STRING("a", v.line(0));
+    TEST_ASSERT_EQUAL_STRING("b", v.line(1));
+    TEST_ASSERT_EQUAL_INT(1, v.scroll(1));
+    TEST_ASSERT_EQUAL_STRING("b", v.line(0));
+    TEST_ASSERT_EQUAL_STRING("c", v.line(1));
+}
+
+void test_position_tracks_window(void) {
+    std::string data = numbered(1, 50);
+    writeHost("/v.log", data);
+    SmallView v;
+    TEST_ASSERT_TRUE(v.open(openLog()));
+    TEST_ASSERT_EQUAL_UINT32(data.size(), v.windowEnd());
+    v.scroll(-46);
+    TEST_ASSERT_EQUAL_UINT32(0, v.position());
+    TEST_ASSERT_EQUAL_UINT32(data.find(lineText(5)), v.windowEnd());
+}
+
+// ============================================================================
+// Follow
+// ============================================================================
+
+void test_refresh_follows_growth_at_end(void) {
+    writeHost("/v.log", numbered(1, 20));
+    SmallView v;
+    TEST_ASSERT_TRUE(v.open(openLog()));
+    TEST_ASSERT_FALSE(v.refresh(openLog()));  // Nothing new
+
+    writeHost("/v.log", numbered(21, 22), "ab");
+    TEST_ASSERT_TRUE(v.refresh(openLog()));
+    TEST_ASSERT_EQUAL_STRING(lineText(22).c_str(), v.line(3));
+    TEST_ASSERT_TRUE(v.atEnd());
+}
+
+void test_refresh_completes_partial_line(void) {
+    writeHost("/v.log", "one\ntw");
+    SmallView v;
+    TEST_ASSERT_TRUE(v.open(openLog()));
+    TEST_ASSERT_EQUAL_STRING("tw", v.line(1));
+    writeHost("/v.log", "o\n", "ab");
+    TEST_ASSERT_TRUE(v.refresh(openLog()));
+    TEST_ASSERT_EQUAL_STRING("two", v.line(1));
+}
+
+void test_refresh_keeps_scrolled_window(void) {
+    writeHost("/v.log", numbered(1, 20));
+    SmallView v;
+    TEST_ASSERT_TRUE(v.open(openLog()));
+    v.scroll(-5);
+    writeHost("/v.log", numbered(21, 30), "ab");
+    TEST_ASSERT_FALSE(v.refresh(openLog()));
+    TEST_ASSERT_EQUAL_STRING(lineText(12).c_str(), v.line(0));
+    TEST_ASSERT_EQUAL_INT(15, v.scroll(100));  // New lines reachable
+    TEST_ASSERT_EQUAL_STRING(lineText(30).c_str(), v.line(3));
+}
+
+void test_refresh_after_rotation_retails(void) {
+    writeHost("/v.log", numbered(1, 50));
+    SmallView v;
+    TEST_ASSERT_TRUE(v.open(openLog()));
+    v.scroll(-10);
+    writeHost("/v.log", "fresh\n");
+    TEST_ASSERT_TRUE(v.refresh(openLog()));
+    TEST_ASSERT_EQUAL_UINT8(1, v.count());
+    TEST_ASSERT_EQUAL_STRING("fresh", v.line(0));
+}
+
+// ============================================================================
+// Performance: open cost vs log size
+// ============================================================================
+
+void test_open_cost_flat_in_file_size(void) {
+    uint32_t reads[2];
+    uint32_t bytes[2];
+    const int counts[2] = {1000, 100000};
+    for (int k = 0; k < 2; k++) {
+        writeHost("/v.log", numbered(1, counts[k]));
+        View v;
+        TEST_ASSERT_TRUE(v.open(openLog()));
+        TEST_ASSERT_EQUAL_STRING(lineText(counts[k]).c_str(), v.line(8));
+        reads[k] = v.stats().reads;
+        bytes[k] = v.stats().bytesRead;
+        printf("[BENCH] %d lines (%lu bytes): tail in %lu reads, %lu bytes read\n",
+               counts[k], (unsigned long)v.size(), (unsigned long)reads[k],
+               (unsigned long)bytes[k]);
+
+        // A page up costs about a block, not a rescan
+        TailViewStats before = v.stats();
+        TEST_ASSERT_EQUAL_INT(-9, v.scroll(-9));
+        TEST_ASSERT_TRUE(v.stats().reads - before.reads <= 2);
+    }
+    TEST_ASSERT_EQUAL_UINT32(reads[0], reads[1]);
+    TEST_ASSERT_TRUE(bytes[1] <= 1024);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Tail
+    RUN_TEST(test_open_shows_last_lines);
+    RUN_TEST(test_short_file_fits_window);
+    RUN_TEST(test_empty_file);
+    RUN_TEST(test_open_fails_without_file);
+
+    // Line shapes
+    RUN_TEST(test_blank_lines_and_whitespace_skipped);
+    RUN_TEST(test_long_line_truncated);
+    RUN_TEST(test_unterminated_last_line_shown);
+
+    // Scrolling
+    RUN_TEST(test_scroll_walks_whole_file);
+    RUN_TEST(test_scroll_skips_blank_lines_both_ways);
+    RUN_TEST(test_position_tracks_window);
+
+    // Follow
+    RUN_TEST(test_refresh_follows_growth_at_end);
+    RUN_TEST(test_refresh_completes_partial_line);
+    RUN_TEST(test_refresh_keeps_scrolled_window);
+    RUN_TEST(test_refresh_after_rotation_retails);
+
+    // Performance
+    RUN_TEST(test_open_cost_flat_in_file_size);
+
+    return UNITY_END();
+}
@@ -0,0 +1,329 @@
+// Upload Journal Tests
+// Tests WiGLE's upload tracking against the host-backed SD mock: the digest
+// hash set (insert/erase with backward shift, growth), replaying old plain
+// tracking files, append-only adds and removals, compaction keeping one
+// line per live name, recovery from a compaction cut short, no cap on
+// tracked files, and per-file checks against the old linear String scan
+
+#include <unity.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "../../src/web/upload_journal.h"
+#include "../mocks/mock_fs.h"
+
+static const char* TEST_ROOT = "/tmp/porkchop_test_upload_journal";
+static const char* JOURNAL = "/wigle_uploaded.txt";
+
+typedef UploadJournal<fs::FS, File> Journal;
+
+void setUp(void) {
+    std::string cmd = std::string("rm -rf ") + TEST_ROOT + " && mkdir -p " + TEST_ROOT;
+    system(cmd.c_str());
+    SD.setRoot(TEST_ROOT);
+    SD.opens = 0;
+}
+
+void tearDown(void) {
+    // No teardown needed
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static std::string csvName(int i) {
+    char name[48];
+    snprintf(name, sizeof(name), "warhog_2024%04d_%06d.wigle.csv", i % 1231, i);
+    return name;
+}
+
+static void writeHost(const char* path, const std::string& data) {
+    FILE* fp = fopen((std::string(TEST_ROOT) + path).c_str(), "wb");
+    fwrite(data.data(), 1, data.size(), fp);
+    fclose(fp);
+}
+
+static std::string readHost(const char* path) {
+    FILE* fp = fopen((std::string(TEST_ROOT) + path).c_str(), "rb");
+    if (!fp) return "<missing>";
+    std::string out;
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) out.append(buf, n);
+    fclose(fp);
+    return out;
+}
+
+static size_t lineCount(const std::string& s) {
+    size_t n = 0;
+    for (char c : s) n += c == '\n';
+    return n;
+}
+
+// ============================================================================
+// Digest set
+// ============================================================================
+
+void test_set_insert_erase(void) {
+    DigestSet set;
+    TEST_ASSERT_FALSE(set.contains(42));
+    TEST_ASSERT_FALSE(set.erase(42));
+    TEST_ASSERT_TRUE(set.insert(42));
+    TEST_ASSERT_FALSE(set.insert(42));
+    TEST_ASSERT_TRUE(set.contains(42));
+    TEST_ASSERT_EQUAL_UINT32(1, set.size());
+    TEST_ASSERT_TRUE(set.erase(42));
+    TEST_ASSERT_FALSE(set.contains(42));
+    TEST_ASSERT_EQUAL_UINT32(0, set.size());
+    TEST_ASSERT_TRUE(DigestSet::digest("", 0) != 0);
+}
+
+void test_set_erase_keeps_probe_runs(void) {
+    // Same home slot for all: one long run, erase from the middle of it
+    DigestSet set;
+    std::vector<uint32_t> v;
+    for (uint32_t i = 1; i <= 10; i++) v.push_back(i << 20);
+    for (uint32_t d : v) set.insert(d);
+    TEST_ASSERT_TRUE(set.erase(v[3]));
+    TEST_ASSERT_TRUE(set.erase(v[0]));
+    for (size_t i = 0; i < v.size(); i++) {
+        TEST_ASSERT_EQUAL(i != 3 && i != 0, set.contains(v[i]));
+    }
+}
+
+void test_set_grows_and_matches_reference(void) {
+    DigestSet set;
+    std::vector<uint32_t> ref;
+    uint32_t x = 12345;
+    for (int i = 0; i < 20000; i++) {
+        x = x * 1103515245u + 12345u;
+        uint32_t d = (x >> 8) | 1;
+        if (i % 3 == 2 && !ref.empty()) {
+            uint32_t gone = ref[(x >> 4) % ref.size()];
+            set.erase(gone);
+            ref.erase(std::find(ref.begin(), ref.end(), gone));
+        } else if (std::find(ref.begin(), ref.end(), d) == ref.end()) {
+            set.insert(d);
+            ref.push_back(d);
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(ref.size(), set.size());
+    for (uint32_t d : ref) TEST_ASSERT_TRUE(set.contains(d));
+    TEST_ASSERT_TRUE(set.bytes() <= ref.size() * 4 * 8 / 3 + 64);  // Load >= 3/8
+}
+
+// ============================================================================
+// Journal
+// ============================================================================
+
+void test_loads_old_tracking_file(void) {
+    writeHost(JOURNAL, "a.wigle.csv\r\n  b.wigle.csv  \n\nc.wigle.csv");
+    Journal j;
+    TEST_ASSERT_TRUE(j.load(SD, JOURNAL));
+    TEST_ASSERT_EQUAL_UINT32(3, j.size());
+    TEST_ASSERT_TRUE(j.contains("a.wigle.csv"));
+    TEST_ASSERT_TRUE(j.contains("b.wigle.csv"));
+    TEST_ASSERT_TRUE(j.contains("c.wigle.csv"));
+    TEST_ASSERT_FALSE(j.contains("d.wigle.csv"));
+}
+
+void test_missing_file_is_empty(void) {
+    Journal j;
+    TEST_ASSERT_TRUE(j.load(SD, JOURNAL));
+    TEST_ASSERT_EQUAL_UINT32(0, j.size());
+    TEST_ASSERT_TRUE(j.add("x.wigle.csv"));
+    TEST_ASSERT_EQUAL_STRING("x.wigle.csv\n", readHost(JOURNAL).c_str());
+}
+
+void test_add_and_remove_only_append(void) {
+    Journal j;
+    j.load(SD, JOURNAL);
+    TEST_ASSERT_TRUE(j.add("a.csv"));
+    TEST_ASSERT_FALSE(j.add("a.csv"));        // Already tracked: no line
+    TEST_ASSERT_TRUE(j.add("b.csv"));
+    TEST_ASSERT_TRUE(j.remove("a.csv"));
+    TEST_ASSERT_FALSE(j.remove("nope.csv"));
+    TEST_ASSERT_EQUAL_STRING("a.csv\nb.csv\n-a.csv\n", readHost(JOURNAL).c_str());
+    TEST_ASSERT_EQUAL_UINT32(3, j.stats().appends);
+
+    // Replayed the same way after a reboot
+    Journal again;
+    TEST_ASSERT_TRUE(again.load(SD, JOURNAL));
+    TEST_ASSERT_FALSE(again.contains("a.csv"));
+    TEST_ASSERT_TRUE(again.contains("b.csv"));
+    TEST_ASSERT_EQUAL_UINT32(1, again.stats().live);
+    TEST_ASSERT_EQUAL_UINT32(2, again.stats().dead);
+}
+
+void test_rejects_unstorable_names(void) {
+    Journal j;
+    j.load(SD, JOURNAL);
+    TEST_ASSERT_FALSE(j.add(""));
+    TEST_ASSERT_FALSE(j.add(nullptr));
+    TEST_ASSERT_FALSE(j.add("-leading-dash.csv"));
+    TEST_ASSERT_FALSE(j.add("two\nlines.csv"));
+    TEST_ASSERT_FALSE(j.add(std::string(Journal::MAX_NAME, 'x').c_str()));
+    TEST_ASSERT_EQUAL_STRING("<missing>", readHost(JOURNAL).c_str());
+}
+
+void test_compaction_keeps_live_names(void) {
+    Journal j;
+    j.load(SD, JOURNAL);
+    for (int i = 0; i < 100; i++) j.add(csvName(i).c_str());
+    for (int i = 0; i < 10; i++) j.remove(csvName(i).c_str());
+    TEST_ASSERT_FALSE(j.compactIfNeeded());  // 20 dead: below the minimum
+    for (int i = 10; i < 60; i++) j.remove(csvName(i).c_str());
+    TEST_ASSERT_EQUAL_UINT32(40, j.stats().live);
+    TEST_ASSERT_EQUAL_UINT32(120, j.stats().dead);
+    TEST_ASSERT_TRUE(j.compactIfNeeded());
+    TEST_ASSERT_EQUAL_UINT32(1, j.stats().compactions);
+    TEST_ASSERT_EQUAL_UINT32(0, j.stats().dead);
+    TEST_ASSERT_EQUAL_UINT32(40, lineCount(readHost(JOURNAL)));
+
+    // Still appendable, and a reload sees the same set
+    TEST_ASSERT_TRUE(j.add(csvName(0).c_str()));
+    Journal again;
+    again.load(SD, JOURNAL);
+    TEST_ASSERT_EQUAL_UINT32(41, again.size());
+    TEST_ASSERT_EQUAL_UINT32(0, again.stats().dead);
+    for (int i = 0; i < 100; i++) {
+        TEST_ASSERT_EQUAL(i == 0 || i >= 60, again.contains(csvName(i).c_str()));
+    }
+}
+
+void test_compaction_drops_repeats(void) {
+    writeHost(JOURNAL, "a.csv\nb.csv\na.csv\n-b.csv\nb.csv\na.csv\n");
+    Journal j;
+    j.load(SD, JOURNAL);
+    TEST_ASSERT_EQUAL_UINT32(2, j.size());
+    TEST_ASSERT_TRUE(j.compact());
+    TEST_ASSERT_EQUAL_STRING("a.csv\nb.csv\n", readHost(JOURNAL).c_str());
+    TEST_ASSERT_EQUAL_STRING("<missing>", readHost("/wigle_uploaded.txt.tmp").c_str());
+}
+
+void test_compaction_leaves_no_side_files(void) {
+    writeHost(JOURNAL, "a.csv\n-a.csv\nb.csv\n");
+    Journal j;
+    j.load(SD, JOURNAL);
+    TEST_ASSERT_TRUE(j.compact());
+    TEST_ASSERT_EQUAL_STRING("b.csv\n", readHost(JOURNAL).c_str());
+    TEST_ASSERT_EQUAL_STRING("<missing>", readHost("/wigle_uploaded.txt.bak").c_str());
+    TEST_ASSERT_EQUAL_STRING("<missing>", readHost("/wigle_uploaded.txt.tmp").c_str());
+}
+
+void test_load_recovers_interrupted_compaction(void) {
+    // Cut after the journal was renamed aside: the backup is the journal
+    writeHost("/wigle_uploaded.txt.bak", "a.csv\n-a.csv\nb.csv\n");
+    writeHost("/wigle_uploaded.txt.tmp", "b.csv\n");
+    Journal j;
+    TEST_ASSERT_TRUE(j.load(SD, JOURNAL));
+    TEST_ASSERT_EQUAL_UINT32(1, j.size());
+    TEST_ASSERT_TRUE(j.contains("b.csv"));
+    TEST_ASSERT_EQUAL_STRING("a.csv\n-a.csv\nb.csv\n", readHost(JOURNAL).c_str());
+    TEST_ASSERT_EQUAL_STRING("<missing>", readHost("/wigle_uploaded.txt.tmp").c_str());
+
+    // Only the finished tmp survived
+    setUp();
+    writeHost("/wigle_uploaded.txt.tmp", "c.csv\n");
+    Journal k;
+    TEST_ASSERT_TRUE(k.load(SD, JOURNAL));
+    TEST_ASSERT_TRUE(k.contains("c.csv"));
+    TEST_ASSERT_EQUAL_STRING("c.csv\n", readHost(JOURNAL).c_str());
+
+    // Cut after the new journal was in place: the backup is stale
+    setUp();
+    writeHost(JOURNAL, "d.csv\n");
+    writeHost("/wigle_uploaded.txt.bak", "x.csv\nd.csv\n");
+    Journal m;
+    TEST_ASSERT_TRUE(m.load(SD, JOURNAL));
+    TEST_ASSERT_EQUAL_UINT32(1, m.size());
+    TEST_ASSERT_EQUAL_STRING("<missing>", readHost("/wigle_uploaded.txt.bak").c_str());
+}
+
+void test_no_cap_on_tracked_files(void) {
+    const int N = 3000;
+    Journal j;
+    j.load(SD, JOURNAL);
+    for (int i = 0; i < N; i++) TEST_ASSERT_TRUE(j.add(csvName(i).c_str()));
+    Journal again;
+    again.load(SD, JOURNAL);
+    TEST_ASSERT_EQUAL_UINT32(N, again.size());
+    TEST_ASSERT_TRUE(again.contains(csvName(0).c_str()));  // The oldest is still there
+    TEST_ASSERT_TRUE(again.contains(csvName(N - 1).c_str()));
+    TEST_ASSERT_EQUAL_UINT32(N, lineCount(readHost(JOURNAL)));
+}
+
+// ============================================================================
+// Micro-benchmark (informational; asserts only that results agree)
+// ============================================================================
+
+void test_benchmark_folder_listing(void) {
+    const int TRACKED = 1000;
+    std::vector<std::string> linear;  // The old uploadedFiles (uncapped here)
+    Journal j;
+    j.load(SD, JOURNAL);
+    for (int i = 0; i < TRACKED; i++) {
+        linear.push_back(csvName(i * 2));
+        j.add(csvName(i * 2).c_str());
+    }
+
+    // A folder of 2000 files, half of them uploaded
+    std::vector<std::string> folder;
+    for (int i = 0; i < 2000; i++) folder.push_back(csvName(i));
+
+    const int rounds = 20;
+    size_t linearHits = 0, setHits = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (const auto& name : folder) {
+            for (const auto& up : linear) {
+                if (up == name) {
+                    linearHits++;
+                    break;
+                }
+            }
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (const auto& name : folder) setHits += j.contains(name.c_str());
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    TEST_ASSERT_TRUE(linearHits == setHits);
+
+    double checks = (double)rounds * folder.size();
+    double linearNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / checks;
+    double setNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / checks;
+    printf("[BENCH] %d tracked: linear %.0f ns/file, digest set %.0f ns/file (%.0fx); "
+           "%d adds appended %d lines, set %u bytes\n",
+           TRACKED, linearNs, setNs, setNs > 0 ? linearNs / setNs : 0.0,
+           TRACKED, (int)j.stats().appends, (unsigned)j.bytes());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Digest set
+    RUN_TEST(test_set_insert_erase);
+    RUN_TEST(test_set_erase_keeps_probe_runs);
+    RUN_TEST(test_set_grows_and_matches_reference);
+
+    // Journal
+    RUN_TEST(test_loads_old_tracking_file);
+    RUN_TEST(test_missing_file_is_empty);
+    RUN_TEST(test_add_and_remove_only_append);
+    RUN_TEST(test_rejects_unstorable_names);
+    RUN_TEST(test_compaction_keeps_live_names);
+    RUN_TEST(test_compaction_drops_repeats);
+    RUN_TEST(test_compaction_leaves_no_side_files);
+    RUN_TEST(test_load_recovers_interrupted_compaction);
+    RUN_TEST(test_no_cap_on_tracked_files);
+
+    // Micro-benchmark
+    RUN_TEST(test_benchmark_folder_listing);
+
+    return UNITY_END();
+}
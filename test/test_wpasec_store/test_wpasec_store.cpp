@@ -0,0 +1,495 @@
+// WPA-SEC Store Tests
+// Tests the flat BSSID-keyed WPA-SEC cache against the host-backed SD mock:
+// BSSID parsing, loading the existing text files (SSIDs with colons, junk
+// lines, repeats across both files), the binary snapshot (reused when the
+// text files match, rebuilt when they change or it is damaged), merging
+// fetched cracks, append-only upload tracking, the entry cap, and lookups
+// and reloads against the old String-keyed maps
+
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+#include "../../src/web/wpasec_store.h"
+#include "../mocks/mock_fs.h"
+
+static const char* TEST_ROOT = "/tmp/porkchop_test_wpasec_store";
+static const char* RESULTS = "/wpasec_results.txt";
+static const char* UPLOADED = "/wpasec_uploaded.txt";
+static const char* SNAPSHOT = "/wpasec_cache.bin";
+
+typedef WpaSecStore<fs::FS, File> Store;
+
+void setUp(void) {
+    std::string cmd = std::string("rm -rf ") + TEST_ROOT + " && mkdir -p " + TEST_ROOT;
+    system(cmd.c_str());
+    SD.setRoot(TEST_ROOT);
+    SD.opens = 0;
+}
+
+void tearDown(void) {
+    // No teardown needed
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static uint64_t keyFor(int i) {
+    return 0x64EEB7000000ull + (uint64_t)i * 7919;
+}
+
+static std::string hexKey(uint64_t key) {
+    char buf[13];
+    Store::formatKey(key, buf);
+    return buf;
+}
+
+static std::string ssidFor(int i) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "Net:%d", i);  // Colon on purpose
+    return buf;
+}
+
+static std::string passFor(int i) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "pw%08d", i * 31);
+    return buf;
+}
+
+static std::string resultsText(int count) {
+    std::string s;
+    for (int i = 0; i < count; i++) {
+        s += hexKey(keyFor(i)) + ":" + ssidFor(i) + ":" + passFor(i) + "\n";
+    }
+    return s;
+}
+
+static void writeHost(const char* path, const std::string& data) {
+    FILE* fp = fopen((std::string(TEST_ROOT) + path).c_str(), "wb");
+    fwrite(data.data(), 1, data.size(), fp);
+    fclose(fp);
+}
+
+static void appendHost(const char* path, const std::string& data) {
+    FILE* fp = fopen((std::string(TEST_ROOT) + path).c_str(), "ab");
+    fwrite(data.data(), 1, data.size(), fp);
+    fclose(fp);
+}
+
+static std::string readHost(const char* path) {
+    FILE* fp = fopen((std::string(TEST_ROOT) + path).c_str(), "rb");
+    if (!fp) return "<missing>";
+    std::string out;
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) out.append(buf, n);
+    fclose(fp);
+    return out;
+}
+
+static bool load(Store& s) {
+    return s.load(SD, RESULTS, UPLOADED, SNAPSHOT);
+}
+
+static std::string passwordOf(const Store& s, uint64_t key) {
+    char buf[64];
+    return s.password(key, buf, sizeof(buf)) ? buf : "<none>";
+}
+
+static std::string ssidOf(const Store& s, uint64_t key) {
+    char buf[64];
+    return s.ssid(key, buf, sizeof(buf)) ? buf : "<none>";
+}
+
+// ============================================================================
+// BSSID keys
+// ============================================================================
+
+void test_parse_and_format_keys(void) {
+    uint64_t k = 0;
+    TEST_ASSERT_TRUE(Store::parseKey("64EEB7208286", k));
+    TEST_ASSERT_TRUE(k == 0x64EEB7208286ull);
+    TEST_ASSERT_TRUE(Store::parseKey("64:ee:b7:20:82:86", k));
+    TEST_ASSERT_TRUE(k == 0x64EEB7208286ull);
+    TEST_ASSERT_TRUE(Store::parseKey("64-EE-B7-20-82-86", k));
+    TEST_ASSERT_TRUE(k == 0x64EEB7208286ull);
+
+    TEST_ASSERT_FALSE(Store::parseKey("64EEB720828", k));     // 11 digits
+    TEST_ASSERT_FALSE(Store::parseKey("64EEB72082861", k));   // 13 digits
+    TEST_ASSERT_FALSE(Store::parseKey("64EEB720828G", k));
+    TEST_ASSERT_FALSE(Store::parseKey("", k));
+    TEST_ASSERT_FALSE(Store::parseKey(nullptr, k));
+
+    char out[13];
+    Store::formatKey(0x00AB0000CD01ull, out);
+    TEST_ASSERT_EQUAL_STRING("00AB0000CD01", out);
+}
+
+// ============================================================================
+// Text files
+// ============================================================================
+
+void test_loads_existing_text_files(void) {
+    writeHost(RESULTS,
+              "64EEB7208286:Home:Net:hunter22\n"
+              "garbage line\n"
+              "\n"
+              "  00AB0000CD01:Cafe:coffee123  \r\n"
+              "ZZEEB7208286:Bad:key\n");
+    writeHost(UPLOADED, "11:22:33:44:55:66\n00ab0000cd01\nnot-a-bssid\n");
+
+    Store s;
+    TEST_ASSERT_TRUE(load(s));
+    TEST_ASSERT_EQUAL_UINT32(3, s.size());
+    TEST_ASSERT_EQUAL_UINT32(2, s.crackedCount());
+    TEST_ASSERT_EQUAL_UINT32(2, s.uploadedCount());
+
+    // SSID runs to the last colon
+    TEST_ASSERT_TRUE(s.isCracked(0x64EEB7208286ull));
+    TEST_ASSERT_EQUAL_STRING("Home:Net", ssidOf(s, 0x64EEB7208286ull).c_str());
+    TEST_ASSERT_EQUAL_STRING("hunter22", passwordOf(s, 0x64EEB7208286ull).c_str());
+    TEST_ASSERT_EQUAL_STRING("coffee123", passwordOf(s, 0x00AB0000CD01ull).c_str());
+
+    // Uploaded only; cracked implies uploaded
+    TEST_ASSERT_FALSE(s.isCracked(0x112233445566ull));
+    TEST_ASSERT_TRUE(s.isUploaded(0x112233445566ull));
+    TEST_ASSERT_TRUE(s.isUploaded(0x64EEB7208286ull));
+    TEST_ASSERT_EQUAL_STRING("<none>", passwordOf(s, 0x112233445566ull).c_str());
+    TEST_ASSERT_FALSE(s.isUploaded(0x010203040506ull));
+
+    TEST_ASSERT_EQUAL_UINT32(4, s.stats().parsedLines);
+    TEST_ASSERT_EQUAL_UINT32(3, s.stats().skippedLines);
+}
+
+void test_missing_files_are_empty(void) {
+    Store s;
+    TEST_ASSERT_TRUE(load(s));
+    TEST_ASSERT_TRUE(s.isLoaded());
+    TEST_ASSERT_EQUAL_UINT32(0, s.size());
+    TEST_ASSERT_FALSE(s.isCracked(0x64EEB7208286ull));
+
+    // An empty snapshot still saves the next boot a parse
+    Store again;
+    TEST_ASSERT_TRUE(load(again));
+    TEST_ASSERT_EQUAL_UINT32(1, again.stats().snapshotLoads);
+}
+
+void test_repeats_collapse_to_one_entry(void) {
+    writeHost(RESULTS,
+              "64EEB7208286:Home:old-pass\n"
+              "00AB0000CD01:Cafe:coffee123\n"
+              "64EEB7208286:Home:new-pass\n");
+    writeHost(UPLOADED, "64EEB7208286\n64:EE:B7:20:82:86\n");
+
+    Store s;
+    TEST_ASSERT_TRUE(load(s));
+    TEST_ASSERT_EQUAL_UINT32(2, s.size());
+    const WpaSecEntry* e = s.find(0x64EEB7208286ull);
+    TEST_ASSERT_NOT_NULL(e);
+    TEST_ASSERT_EQUAL_UINT8(WpaSecEntry::CRACKED | WpaSecEntry::UPLOADED, e->flags);
+    TEST_ASSERT_EQUAL_STRING("new-pass", passwordOf(s, 0x64EEB7208286ull).c_str());
+
+    // Superseded text isn't kept: 4+8 and 4+9 bytes
+    TEST_ASSERT_TRUE(s.bytes() <= 2 * sizeof(WpaSecEntry) + 25);
+}
+
+// ============================================================================
+// Snapshot
+// ============================================================================
+
+void test_second_load_uses_snapshot(void) {
+    writeHost(RESULTS, resultsText(200));
+    writeHost(UPLOADED, hexKey(keyFor(500)) + "\n");
+
+    Store first;
+    TEST_ASSERT_TRUE(load(first));
+    TEST_ASSERT_EQUAL_UINT32(0, first.stats().snapshotLoads);
+    TEST_ASSERT_EQUAL_UINT32(1, first.stats().snapshotWrites);
+
+    Store second;
+    TEST_ASSERT_TRUE(load(second));
+    TEST_ASSERT_EQUAL_UINT32(1, second.stats().snapshotLoads);
+    TEST_ASSERT_EQUAL_UINT32(0, second.stats().parsedLines);
+    TEST_ASSERT_EQUAL_UINT32(201, second.size());
+    for (int i = 0; i < 200; i++) {
+        TEST_ASSERT_EQUAL_STRING(passFor(i).c_str(), passwordOf(second, keyFor(i)).c_str());
+        TEST_ASSERT_EQUAL_STRING(ssidFor(i).c_str(), ssidOf(second, keyFor(i)).c_str());
+    }
+    TEST_ASSERT_TRUE(second.isUploaded(keyFor(500)));
+    TEST_ASSERT_FALSE(second.isCracked(keyFor(500)));
+}
+
+void test_changed_text_rebuilds_snapshot(void) {
+    writeHost(RESULTS, resultsText(10));
+    Store s;
+    TEST_ASSERT_TRUE(load(s));
+
+    // Older firmware or a hand edit appends to the text file
+    appendHost(RESULTS, hexKey(keyFor(99)) + ":Late:latepass\n");
+    Store reloaded;
+    TEST_ASSERT_TRUE(load(reloaded));
+    TEST_ASSERT_EQUAL_UINT32(0, reloaded.stats().snapshotLoads);
+    TEST_ASSERT_EQUAL_STRING("latepass", passwordOf(reloaded, keyFor(99)).c_str());
+
+    // The rebuilt snapshot matches again
+    Store third;
+    TEST_ASSERT_TRUE(load(third));
+    TEST_ASSERT_EQUAL_UINT32(1, third.stats().snapshotLoads);
+    TEST_ASSERT_EQUAL_UINT32(11, third.size());
+}
+
+void test_damaged_snapshot_is_reparsed(void) {
+    writeHost(RESULTS, resultsText(50));
+    {
+        Store s;
+        TEST_ASSERT_TRUE(load(s));
+    }
+    std::string snap = readHost(SNAPSHOT);
+    TEST_ASSERT_TRUE(snap.compare(0, 4, "WSEC") == 0);
+    TEST_ASSERT_TRUE(snap.size() > 32 + 50 * sizeof(WpaSecEntry));
+
+    // Truncated
+    writeHost(SNAPSHOT, snap.substr(0, snap.size() - 1));
+    Store a;
+    TEST_ASSERT_TRUE(load(a));
+    TEST_ASSERT_EQUAL_UINT32(0, a.stats().snapshotLoads);
+    TEST_ASSERT_EQUAL_UINT32(50, a.size());
+
+    // Entries out of order
+    std::string swapped = snap;
+    for (int b = 0; b < 16; b++) std::swap(swapped[32 + b], swapped[32 + 16 + b]);
+    writeHost(SNAPSHOT, swapped);
+    Store b;
+    TEST_ASSERT_TRUE(load(b));
+    TEST_ASSERT_EQUAL_UINT32(0, b.stats().snapshotLoads);
+    TEST_ASSERT_EQUAL_STRING(passFor(0).c_str(), passwordOf(b, keyFor(0)).c_str());
+
+    // Text offset past the arena
+    std::string wild = snap;
+    wild[32 + 8 + 3] = (char)0x7F;
+    writeHost(SNAPSHOT, wild);
+    Store c;
+    TEST_ASSERT_TRUE(load(c));
+    TEST_ASSERT_EQUAL_UINT32(0, c.stats().snapshotLoads);
+    TEST_ASSERT_EQUAL_STRING(passFor(1).c_str(), passwordOf(c, keyFor(1)).c_str());
+}
+
+// ============================================================================
+// Updates
+// ============================================================================
+
+void test_fetched_cracks_merge_and_persist(void) {
+    writeHost(RESULTS, resultsText(3));
+    Store s;
+    TEST_ASSERT_TRUE(load(s));
+
+    // Already known, same fields: not new, nothing changes
+    std::string ssid1 = ssidFor(1), pass1 = passFor(1);
+    TEST_ASSERT_FALSE(s.putCracked(keyFor(1), ssid1.c_str(), ssid1.size(), pass1.c_str(), pass1.size()));
+    // Known with a new password: updated, still not new
+    TEST_ASSERT_FALSE(s.putCracked(keyFor(2), "Net:2", 5, "changed!", 8));
+    TEST_ASSERT_EQUAL_STRING("changed!", passwordOf(s, keyFor(2)).c_str());
+    // New BSSIDs, one sorting before everything
+    TEST_ASSERT_TRUE(s.putCracked(0x000000000001ull, "First", 5, "firstpass", 9));
+    TEST_ASSERT_TRUE(s.putCracked(keyFor(40), "Forty", 5, "fortypass", 9));
+    TEST_ASSERT_EQUAL_UINT32(5, s.crackedCount());
+    TEST_ASSERT_TRUE(s.saveResults());
+
+    std::string text = readHost(RESULTS);
+    TEST_ASSERT_TRUE(text.find("000000000001:First:firstpass\n") == 0);
+    TEST_ASSERT_TRUE(text.find(hexKey(keyFor(2)) + ":Net:2:changed!\n") != std::string::npos);
+    TEST_ASSERT_TRUE(text.find("pw00000062") == std::string::npos);  // The replaced password
+
+    // Both the snapshot and a parse of the rewritten text agree
+    Store snap;
+    TEST_ASSERT_TRUE(load(snap));
+    TEST_ASSERT_EQUAL_UINT32(1, snap.stats().snapshotLoads);
+    remove((std::string(TEST_ROOT) + SNAPSHOT).c_str());
+    Store parsed;
+    TEST_ASSERT_TRUE(load(parsed));
+    TEST_ASSERT_EQUAL_UINT32(0, parsed.stats().snapshotLoads);
+    for (Store* st : {&snap, &parsed}) {
+        TEST_ASSERT_EQUAL_UINT32(5, st->size());
+        TEST_ASSERT_EQUAL_STRING("changed!", passwordOf(*st, keyFor(2)).c_str());
+        TEST_ASSERT_EQUAL_STRING("Forty", ssidOf(*st, keyFor(40)).c_str());
+        TEST_ASSERT_EQUAL_STRING("firstpass", passwordOf(*st, 0x000000000001ull).c_str());
+    }
+}
+
+void test_mark_uploaded_only_appends(void) {
+    writeHost(UPLOADED, "112233445566\n");
+    Store s;
+    TEST_ASSERT_TRUE(load(s));
+
+    TEST_ASSERT_TRUE(s.markUploaded(0x64EEB7208286ull));
+    TEST_ASSERT_FALSE(s.markUploaded(0x64EEB7208286ull));  // Already tracked
+    TEST_ASSERT_FALSE(s.markUploaded(0x112233445566ull));
+    TEST_ASSERT_TRUE(s.isUploaded(0x64EEB7208286ull));
+    TEST_ASSERT_FALSE(s.isCracked(0x64EEB7208286ull));
+    TEST_ASSERT_EQUAL_STRING("112233445566\n64EEB7208286\n", readHost(UPLOADED).c_str());
+
+    // The snapshot was refreshed alongside the append
+    Store next;
+    TEST_ASSERT_TRUE(load(next));
+    TEST_ASSERT_EQUAL_UINT32(1, next.stats().snapshotLoads);
+    TEST_ASSERT_TRUE(next.isUploaded(0x64EEB7208286ull));
+
+    // A later crack of an uploaded network shares its entry
+    TEST_ASSERT_TRUE(next.putCracked(0x64EEB7208286ull, "Home", 4, "hunter22", 8));
+    TEST_ASSERT_EQUAL_UINT32(2, next.size());
+}
+
+void test_entry_cap(void) {
+    writeHost(RESULTS, resultsText(Store::MAX_ENTRIES + 20));
+    Store s;
+    TEST_ASSERT_TRUE(load(s));
+    TEST_ASSERT_EQUAL_UINT32(Store::MAX_ENTRIES, s.size());
+    TEST_ASSERT_FALSE(s.putCracked(0x000000000001ull, "x", 1, "y", 1));
+    TEST_ASSERT_FALSE(s.markUploaded(0x000000000001ull));
+    // Existing entries still update
+    TEST_ASSERT_TRUE(s.markUploaded(keyFor(0)));
+    TEST_ASSERT_FALSE(s.putCracked(keyFor(0), "Net:0", 5, "newpass1", 8));
+    TEST_ASSERT_EQUAL_STRING("newpass1", passwordOf(s, keyFor(0)).c_str());
+}
+
+// ============================================================================
+// Micro-benchmark (informational; asserts only that results agree)
+// ============================================================================
+
+struct OldEntry {
+    std::string ssid;
+    std::string password;
+};
+
+// The pre-store load: line parse into String-keyed maps
+static void loadOld(std::map<std::string, OldEntry>& cracked, const std::string& text) {
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t end = text.find('\n', pos);
+        if (end == std::string::npos) end = text.size();
+        std::string line = text.substr(pos, end - pos);
+        pos = end + 1;
+        size_t first = line.find(':'), last = line.rfind(':');
+        if (first == std::string::npos || first == 0 || last == first) continue;
+        OldEntry e;
+        e.ssid = line.substr(first + 1, last - first - 1);
+        e.password = line.substr(last + 1);
+        cracked[line.substr(0, first)] = e;
+    }
+}
+
+// The old per-capture key: String copy, colons removed
+static std::string normalizeOld(const std::string& bssid) {
+    std::string out;
+    for (char c : bssid) {
+        if (c != ':' && c != '-') out += (char)toupper(c);
+    }
+    return out;
+}
+
+void test_benchmark_capture_refresh(void) {
+    const int CRACKED = 500;
+    std::string text = resultsText(CRACKED);
+    writeHost(RESULTS, text);
+
+    // 400 captures in the menu, colon BSSIDs, a quarter of them cracked
+    std::vector<std::string> captures;
+    for (int i = 0; i < 400; i++) {
+        std::string hex = hexKey(keyFor(i % 4 == 0 ? i : CRACKED + i));
+        std::string colon;
+        for (int b = 0; b < 12; b += 2) colon += (b ? ":" : "") + hex.substr(b, 2);
+        captures.push_back(colon);
+    }
+
+    const int rounds = 50;
+    std::map<std::string, OldEntry> old;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        old.clear();
+        loadOld(old, text);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    Store parsed;
+    for (int r = 0; r < rounds; r++) {
+        remove((std::string(TEST_ROOT) + SNAPSHOT).c_str());
+        load(parsed);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    Store snap;
+    for (int r = 0; r < rounds; r++) load(snap);
+    auto t3 = std::chrono::steady_clock::now();
+    TEST_ASSERT_EQUAL_UINT32(1, snap.stats().snapshotLoads);
+
+    size_t oldHits = 0, storeHits = 0, oldLen = 0, storeLen = 0;
+    auto t4 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds * 10; r++) {
+        for (const auto& cap : captures) {
+            auto it = old.find(normalizeOld(cap));
+            if (it != old.end()) {
+                oldHits++;
+                oldLen += it->second.password.size();
+            }
+        }
+    }
+    auto t5 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds * 10; r++) {
+        for (const auto& cap : captures) {
+            uint64_t key;
+            char pass[64];
+            if (Store::parseKey(cap.c_str(), key) && snap.password(key, pass, sizeof(pass))) {
+                storeHits++;
+                storeLen += strlen(pass);
+            }
+        }
+    }
+    auto t6 = std::chrono::steady_clock::now();
+    TEST_ASSERT_TRUE(oldHits == storeHits && oldLen == storeLen);
+
+    // Old heap: a tree node (~48 B) plus key, SSID and password Strings,
+    // each a heap block with ~16 B of allocator overhead
+    size_t oldBytes = 0;
+    for (const auto& kv : old) {
+        oldBytes += 48 + 3 * 16 + kv.first.size() + kv.second.ssid.size() +
+                    kv.second.password.size() + 3 * 16;
+    }
+
+    auto ms = [](std::chrono::steady_clock::time_point a, std::chrono::steady_clock::time_point b) {
+        return std::chrono::duration<double, std::milli>(b - a).count();
+    };
+    double checks = (double)rounds * 10 * captures.size();
+    printf("[BENCH] %d cracked: load maps %.2f ms, parse+snapshot %.2f ms, snapshot %.2f ms; "
+           "refresh %.0f vs %.0f ns/capture; heap ~%u vs %u bytes\n",
+           CRACKED, ms(t0, t1) / rounds, ms(t1, t2) / rounds, ms(t2, t3) / rounds,
+           ms(t4, t5) * 1e6 / checks, ms(t5, t6) * 1e6 / checks,
+           (unsigned)oldBytes, (unsigned)snap.bytes());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // BSSID keys
+    RUN_TEST(test_parse_and_format_keys);
+
+    // Text files
+    RUN_TEST(test_loads_existing_text_files);
+    RUN_TEST(test_missing_files_are_empty);
+    RUN_TEST(test_repeats_collapse_to_one_entry);
+
+    // Snapshot
+    RUN_TEST(test_second_load_uses_snapshot);
+    RUN_TEST(test_changed_text_rebuilds_snapshot);
+    RUN_TEST(test_damaged_snapshot_is_reparsed);
+
+    // Updates
+    RUN_TEST(test_fetched_cracks_merge_and_persist);
+    RUN_TEST(test_mark_uploaded_only_appends);
+    RUN_TEST(test_entry_cap);
+
+    // Micro-benchmark
+    RUN_TEST(test_benchmark_capture_refresh);
+
+    return UNITY_END();
+}
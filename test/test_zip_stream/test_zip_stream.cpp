@@ -0,0 +1,328 @@
+// Zip Stream Tests
+// Tests the streamed ZIP download against the host-backed SD mock: CRC32
+// vectors, archives of files, directories and mixed selections checked by
+// round-tripping through the system unzip, CRC and sizes in the local
+// headers (read back by a streaming bsdtar), central directory offsets,
+// ZIP64 limits refused up front, depth limit, chunk size bound and
+// entry-table memory
+
+#include <unity.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "../../src/web/zip_stream.h"
+#include "../mocks/mock_fs.h"
+
+static const char* TEST_ROOT = "/tmp/porkchop_test_zip_stream";
+static const char* OUT_DIR = "/tmp/porkchop_test_zip_stream_out";
+
+typedef ZipStream<fs::FS, File> Zip;
+
+static bool haveUnzip = false;
+
+void setUp(void) {
+    std::string cmd = std::string("rm -rf ") + TEST_ROOT + " " + OUT_DIR +
+                      " && mkdir -p " + TEST_ROOT + " " + OUT_DIR;
+    system(cmd.c_str());
+    SD.setRoot(TEST_ROOT);
+    SD.opens = 0;
+}
+
+void tearDown(void) {
+    // No teardown needed
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static std::string pattern(size_t size, unsigned seed) {
+    std::string s(size, '\0');
+    uint32_t x = seed * 2654435761u + 1;
+    for (size_t i = 0; i < size; i++) {
+        x = x * 1103515245u + 12345u;
+        s[i] = (char)(x >> 16);
+    }
+    return s;
+}
+
+static void makeFile(const std::string& path, const std::string& data) {
+    std::string host = std::string(TEST_ROOT) + path;
+    FILE* fp = fopen(host.c_str(), "wb");
+    fwrite(data.data(), 1, data.size(), fp);
+    fclose(fp);
+}
+
+static void makeDir(const std::string& path) {
+    std::string cmd = "mkdir -p '" + std::string(TEST_ROOT) + path + "'";
+    system(cmd.c_str());
+}
+
+static std::string readHost(const std::string& host) {
+    FILE* fp = fopen(host.c_str(), "rb");
+    if (!fp) return "<missing>";
+    std::string out;
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) out.append(buf, n);
+    fclose(fp);
+    return out;
+}
+
+struct Capture {
+    std::string body;
+    size_t maxChunk = 0;
+};
+
+static bool zipPaths(std::vector<const char*> paths, Capture& cap, Zip& zip) {
+    return zip.write(SD, paths.data(), paths.size(), [&cap](const char* data, size_t len) {
+        cap.body.append(data, len);
+        if (len > cap.maxChunk) cap.maxChunk = len;
+    });
+}
+
+// Write the archive out and run `unzip` over it; returns its exit status
+static int unzipTo(const Capture& cap, const char* args) {
+    std::string zipPath = std::string(OUT_DIR) + "/a.zip";
+    FILE* fp = fopen(zipPath.c_str(), "wb");
+    fwrite(cap.body.data(), 1, cap.body.size(), fp);
+    fclose(fp);
+    std::string cmd = std::string("unzip ") + args + " '" + zipPath + "' -d '" +
+                      OUT_DIR + "/x' > /dev/null 2>&1";
+    return system(cmd.c_str());
+}
+
+static uint32_t le32(const std::string& s, size_t at) {
+    const uint8_t* p = (const uint8_t*)s.data() + at;
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// ============================================================================
+// CRC32
+// ============================================================================
+
+void test_crc32_vectors(void) {
+    const char* check = "123456789";
+    TEST_ASSERT_EQUAL_HEX32(0xCBF43926, Crc32::update(0, (const uint8_t*)check, 9));
+    TEST_ASSERT_EQUAL_HEX32(0x00000000, Crc32::update(0, nullptr, 0));
+
+    // Split anywhere, same answer
+    std::string data = pattern(5000, 3);
+    uint32_t whole = Crc32::update(0, (const uint8_t*)data.data(), data.size());
+    uint32_t part = Crc32::update(0, (const uint8_t*)data.data(), 1234);
+    part = Crc32::update(part, (const uint8_t*)data.data() + 1234, data.size() - 1234);
+    TEST_ASSERT_EQUAL_HEX32(whole, part);
+}
+
+// ============================================================================
+// Round trips through unzip
+// ============================================================================
+
+void test_directory_round_trip(void) {
+    if (!haveUnzip) TEST_IGNORE_MESSAGE("unzip not installed");
+    makeDir("/wardriving");
+    std::string a = pattern(3000, 1);
+    std::string b = pattern(0, 2);
+    std::string c = pattern(70000, 3);
+    makeFile("/wardriving/a.csv", a);
+    makeFile("/wardriving/empty.csv", b);
+    makeFile("/wardriving/big.csv", c);
+
+    Zip zip;
+    Capture cap;
+    TEST_ASSERT_TRUE(zipPaths({"/wardriving"}, cap, zip));
+    TEST_ASSERT_EQUAL_UINT32(3, zip.stats().files);
+    TEST_ASSERT_EQUAL_UINT32(cap.body.size(), zip.stats().bytesOut);
+
+    TEST_ASSERT_EQUAL_INT(0, unzipTo(cap, "-tq"));
+    TEST_ASSERT_EQUAL_INT(0, unzipTo(cap, "-q"));
+    std::string x = std::string(OUT_DIR) + "/x/wardriving/";
+    TEST_ASSERT_TRUE(readHost(x + "a.csv") == a);
+    TEST_ASSERT_TRUE(readHost(x + "empty.csv") == b);
+    TEST_ASSERT_TRUE(readHost(x + "big.csv") == c);
+}
+
+void test_mixed_selection_round_trip(void) {
+    if (!haveUnzip) TEST_IGNORE_MESSAGE("unzip not installed");
+    makeDir("/handshakes/sub");
+    makeDir("/logs");
+    std::string hs = pattern(1500, 4);
+    std::string deep = pattern(800, 5);
+    std::string log = "[1][TEST] hello\n";
+    makeFile("/handshakes/AABBCCDDEEFF.pcap", hs);
+    makeFile("/handshakes/sub/deep.txt", deep);
+    makeFile("/logs/porkchop.log", log);
+
+    Zip zip;
+    Capture cap;
+    TEST_ASSERT_TRUE(zipPaths({"/handshakes/", "/logs/porkchop.log"}, cap, zip));
+    TEST_ASSERT_EQUAL_UINT32(3, zip.stats().files);
+    TEST_ASSERT_EQUAL_INT(0, unzipTo(cap, "-q"));
+    std::string x = std::string(OUT_DIR) + "/x/";
+    TEST_ASSERT_TRUE(readHost(x + "handshakes/AABBCCDDEEFF.pcap") == hs);
+    TEST_ASSERT_TRUE(readHost(x + "handshakes/sub/deep.txt") == deep);
+    TEST_ASSERT_TRUE(readHost(x + "porkchop.log") == log);
+}
+
+void test_root_selection_names_have_no_leading_slash(void) {
+    if (!haveUnzip) TEST_IGNORE_MESSAGE("unzip not installed");
+    makeFile("/top.txt", "top");
+    makeDir("/d");
+    makeFile("/d/in.txt", "in");
+    Zip zip;
+    Capture cap;
+    TEST_ASSERT_TRUE(zipPaths({"/"}, cap, zip));
+    TEST_ASSERT_TRUE(cap.body.find("/top.txt") == std::string::npos);
+    TEST_ASSERT_EQUAL_INT(0, unzipTo(cap, "-q"));
+    std::string x = std::string(OUT_DIR) + "/x/";
+    TEST_ASSERT_EQUAL_STRING("top", readHost(x + "top.txt").c_str());
+    TEST_ASSERT_EQUAL_STRING("in", readHost(x + "d/in.txt").c_str());
+}
+
+// ============================================================================
+// Format details
+// ============================================================================
+
+void test_local_headers_carry_crc_and_size(void) {
+    makeFile("/one.bin", "abc");
+    Zip zip;
+    Capture cap;
+    TEST_ASSERT_TRUE(zipPaths({"/one.bin"}, cap, zip));
+    const std::string& z = cap.body;
+
+    // No data descriptor: stream readers get everything from the header
+    TEST_ASSERT_EQUAL_HEX32(0x04034b50, le32(z, 0));
+    TEST_ASSERT_EQUAL_HEX16(0x0800, z[6] | (z[7] << 8));
+    TEST_ASSERT_EQUAL_HEX32(0x352441C2, le32(z, 14));  // crc32("abc")
+    TEST_ASSERT_EQUAL_UINT32(3, le32(z, 18));
+    TEST_ASSERT_EQUAL_UINT32(3, le32(z, 22));
+    size_t next = 30 + 7 + 3;                          // Header + "one.bin" + data
+
+    // End record points at the central directory, which points back at 0
+    size_t eocd = z.size() - 22;
+    TEST_ASSERT_EQUAL_HEX32(0x06054b50, le32(z, eocd));
+    uint32_t cd = le32(z, eocd + 16);
+    TEST_ASSERT_EQUAL_UINT32(next, cd);
+    TEST_ASSERT_EQUAL_HEX32(0x02014b50, le32(z, cd));
+    TEST_ASSERT_EQUAL_HEX16(0x0800, z[cd + 8] | (z[cd + 9] << 8));
+    TEST_ASSERT_EQUAL_UINT32(0, le32(z, cd + 42));
+}
+
+void test_stream_reader_accepts_archive(void) {
+    // bsdtar reading a pipe only has the local headers to go on
+    if (system("bsdtar --version > /dev/null 2>&1") != 0) TEST_IGNORE_MESSAGE("bsdtar not installed");
+    makeDir("/logs");
+    makeFile("/logs/a.csv", pattern(5000, 1));
+    makeFile("/logs/b.csv", pattern(0, 2));
+    Zip zip;
+    Capture cap;
+    TEST_ASSERT_TRUE(zipPaths({"/logs"}, cap, zip));
+    std::string zipPath = std::string(OUT_DIR) + "/s.zip";
+    FILE* fp = fopen(zipPath.c_str(), "wb");
+    fwrite(cap.body.data(), 1, cap.body.size(), fp);
+    fclose(fp);
+    std::string cmd = "cat '" + zipPath + "' | (cd '" + OUT_DIR + "' && bsdtar -xf -) > /dev/null 2>&1";
+    TEST_ASSERT_EQUAL_INT(0, system(cmd.c_str()));
+    TEST_ASSERT_TRUE(readHost(std::string(OUT_DIR) + "/logs/a.csv") == pattern(5000, 1));
+}
+
+void test_refuses_zip64_sizes_before_sending(void) {
+    // Two sparse 2.2GB files: past 4GB together, nothing read or sent
+    std::string cmd = std::string("truncate -s 2200000000 '") + TEST_ROOT + "/big/1.bin' '" +
+                      TEST_ROOT + "/big/2.bin'";
+    makeDir("/big");
+    makeFile("/big/1.bin", "");
+    makeFile("/big/2.bin", "");
+    system(cmd.c_str());
+    Zip zip;
+    Capture cap;
+    TEST_ASSERT_NOT_NULL(zip.check(SD, std::vector<const char*>{"/big"}.data(), 1));
+    TEST_ASSERT_FALSE(zipPaths({"/big"}, cap, zip));
+    TEST_ASSERT_EQUAL_STRING("archive over 4GB (no ZIP64)", zip.error());
+    TEST_ASSERT_EQUAL_UINT32(0, cap.body.size());
+
+    // One of them fits
+    TEST_ASSERT_NULL(zip.check(SD, std::vector<const char*>{"/big/1.bin"}.data(), 1));
+}
+
+void test_entry_limit(void) {
+    TEST_ASSERT_NULL(Zip::limitError(65535, 1000));
+    TEST_ASSERT_EQUAL_STRING("more than 65535 files (no ZIP64)", Zip::limitError(65536, 1000));
+    TEST_ASSERT_NULL(Zip::limitError(1, 0xFFFFFFFFull));
+    TEST_ASSERT_EQUAL_STRING("archive over 4GB (no ZIP64)", Zip::limitError(1, 0x100000000ull));
+}
+
+void test_missing_paths_and_empty_selection(void) {
+    Zip zip;
+    Capture cap;
+    TEST_ASSERT_TRUE(zipPaths({"/nope", ""}, cap, zip));
+    TEST_ASSERT_EQUAL_UINT32(0, zip.stats().files);
+    TEST_ASSERT_EQUAL_UINT32(22, cap.body.size());  // Just the end record
+}
+
+void test_depth_limit(void) {
+    makeDir("/a/b/c/d");
+    makeFile("/a/1.txt", "1");
+    makeFile("/a/b/2.txt", "2");
+    makeFile("/a/b/c/3.txt", "3");
+    makeFile("/a/b/c/d/4.txt", "4");
+    Zip zip;
+    Capture cap;
+    TEST_ASSERT_TRUE(zipPaths({"/a"}, cap, zip));
+    TEST_ASSERT_EQUAL_UINT32(3, zip.stats().files);
+    TEST_ASSERT_TRUE(cap.body.find("a/b/c/3.txt") != std::string::npos);
+    TEST_ASSERT_TRUE(cap.body.find("4.txt") == std::string::npos);
+}
+
+// ============================================================================
+// Bounded memory
+// ============================================================================
+
+void test_many_files_bounded_chunks(void) {
+    if (!haveUnzip) TEST_IGNORE_MESSAGE("unzip not installed");
+    makeDir("/session");
+    const int N = 600;  // Several entry blocks
+    for (int i = 0; i < N; i++) {
+        char name[48];
+        snprintf(name, sizeof(name), "/session/%04d.csv", i);
+        makeFile(name, pattern(i * 7 % 900, i));
+    }
+    Zip zip;
+    Capture cap;
+    TEST_ASSERT_TRUE(zipPaths({"/session"}, cap, zip));
+    TEST_ASSERT_EQUAL_UINT32(N, zip.stats().files);
+    TEST_ASSERT_TRUE(cap.maxChunk <= 1024);
+    TEST_ASSERT_EQUAL_INT(0, unzipTo(cap, "-tq"));
+    printf("[BENCH] %d files: %lu data bytes -> %lu byte zip in %lu chunks; "
+           "entry table %lu bytes, names re-walked\n",
+           N, (unsigned long)zip.stats().dataBytes, (unsigned long)cap.body.size(),
+           (unsigned long)zip.stats().chunks,
+           (unsigned long)(((N + 127) / 128) * (128 * 16 + sizeof(void*))));
+}
+
+int main(int argc, char **argv) {
+    haveUnzip = system("unzip -v > /dev/null 2>&1") == 0;
+
+    UNITY_BEGIN();
+
+    // CRC32
+    RUN_TEST(test_crc32_vectors);
+
+    // Round trips through unzip
+    RUN_TEST(test_directory_round_trip);
+    RUN_TEST(test_mixed_selection_round_trip);
+    RUN_TEST(test_root_selection_names_have_no_leading_slash);
+
+    // Format details
+    RUN_TEST(test_local_headers_carry_crc_and_size);
+    RUN_TEST(test_stream_reader_accepts_archive);
+    RUN_TEST(test_refuses_zip64_sizes_before_sending);
+    RUN_TEST(test_entry_limit);
+    RUN_TEST(test_missing_paths_and_empty_selection);
+    RUN_TEST(test_depth_limit);
+
+    // Bounded memory
+    RUN_TEST(test_many_files_bounded_chunks);
+
+    return UNITY_END();
+}